@@ -0,0 +1,205 @@
+/*+===================================================================
+  File:      BENCHMARKS.CPP
+
+  Summary:   Runs every benchmark of the library headless on the null
+             device, at the sizes the reference numbers were taken
+             at, and writes their results to the debug output. Run it
+             from Source/Game so the shaders and models are found.
+
+  Functions: main
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#include "Common.h"
+
+#include "Model/ModelBenchmark.h"
+#include "Platform/NullDevice.h"
+#include "Renderer/RenderBenchmark.h"
+#include "Scene/TerrainBenchmark.h"
+
+using namespace library;
+
+namespace
+{
+    // Size of the generated worlds
+    constexpr UINT WORLD_WIDTH = 1024u;
+    constexpr UINT WORLD_HEIGHT = 64u;
+    constexpr UINT WORLD_DEPTH = 1024u;
+
+    // Resolution of the software renderer
+    constexpr UINT RENDER_WIDTH = 1920u;
+    constexpr UINT RENDER_HEIGHT = 1080u;
+
+    // Model posed by the model benchmark
+    constexpr WCHAR MODEL_FILE_PATH[] = L"Content/BobLampClean/boblampclean.md5mesh";
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: reportFailure
+
+      Summary:  Reports a benchmark that could not run
+
+      Args:     PCWSTR pszName
+                  Name of the benchmark
+                HRESULT hr
+                  Status code it failed with
+    -----------------------------------------------------------------F-F*/
+    void reportFailure(_In_ PCWSTR pszName, _In_ HRESULT hr)
+    {
+        WCHAR szMessage[256];
+        swprintf_s(szMessage, L"%ls failed with 0x%08X\n", pszName, static_cast<UINT>(hr));
+        OutputDebugString(szMessage);
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: benchmarkTerrain
+
+      Summary:  Runs the benchmarks of the terrain generators, the
+                noise, the raycasts, the heightfield, erosion and the
+                voxel files
+
+      Returns:  BOOL
+                  TRUE if every benchmark ran
+    -----------------------------------------------------------------F-F*/
+    BOOL benchmarkTerrain()
+    {
+        BOOL bSucceeded = TRUE;
+        auto check = [&bSucceeded](PCWSTR pszName, HRESULT hr)
+        {
+            if (FAILED(hr))
+            {
+                reportFailure(pszName, hr);
+                bSucceeded = FALSE;
+            }
+        };
+
+        std::vector<NoiseBenchmarkResult> noiseResults;
+        check(L"BenchmarkNoise", BenchmarkNoise(1u << 20u, 10u, noiseResults));
+
+        std::vector<TerrainBenchmarkResult> terrainResults;
+        check(L"BenchmarkTerrainGenerator", BenchmarkTerrainGenerator(WORLD_WIDTH, WORLD_DEPTH, 5u, terrainResults));
+
+        std::vector<DensityBenchmarkResult> densityResults;
+        check(L"BenchmarkDensityTerrain", BenchmarkDensityTerrain(512u, WORLD_HEIGHT, 512u, 2u, densityResults));
+
+        TerrainGenerator generator(WORLD_WIDTH, WORLD_HEIGHT, WORLD_DEPTH);
+        generator.Generate();
+        Scene scene(generator.GetHeightMap());
+
+        std::vector<VoxelRaycastBenchmarkResult> raycastResults;
+        check(L"BenchmarkVoxelRaycasts", BenchmarkVoxelRaycasts(*scene.GetVoxelOccupancy(), 1u << 16u, 5u, raycastResults));
+
+        HeightfieldTerrain heightfield(*scene.GetVoxelStore());
+        HeightfieldBenchmarkResult heightfieldResult;
+        check(L"BenchmarkHeightfieldSelection", BenchmarkHeightfieldSelection(heightfield, 256u, 10u, heightfieldResult));
+
+        std::vector<ErosionBenchmarkResult> erosionResults;
+        check(L"BenchmarkTerrainErosion", BenchmarkTerrainErosion(WORLD_WIDTH, WORLD_DEPTH, 1u << 16u, 8u, 2u, erosionResults));
+
+        std::error_code error;
+        const std::filesystem::path directoryPath = std::filesystem::temp_directory_path(error) / L"Benchmarks";
+        std::vector<VoxelFileBenchmarkResult> fileResults;
+        check(L"BenchmarkVoxelFiles", BenchmarkVoxelFiles(directoryPath, WORLD_WIDTH, WORLD_DEPTH, 3u, fileResults));
+        std::filesystem::remove_all(directoryPath, error);
+
+        return bSucceeded;
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: benchmarkSoftwareRenderer
+
+      Summary:  Draws a generated voxel world with the software backend
+                on the null device
+
+      Args:     ID3D11Device* pDevice
+                ID3D11DeviceContext* pImmediateContext
+                  Null device and its immediate context
+
+      Returns:  BOOL
+                  TRUE if the benchmark ran
+    -----------------------------------------------------------------F-F*/
+    BOOL benchmarkSoftwareRenderer(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext)
+    {
+        TerrainGenerator generator(256u, WORLD_HEIGHT, 256u);
+        generator.Generate();
+
+        std::shared_ptr<Scene> scene = std::make_shared<Scene>(generator.GetHeightMap());
+        scene->AddVertexShader(L"VoxelShader", std::make_shared<VertexShader>(L"Shaders/VoxelShaders.fxh", "VSVoxel", "vs_5_0"));
+        scene->AddPixelShader(L"VoxelShader", std::make_shared<PixelShader>(L"Shaders/VoxelShaders.fxh", "PSVoxel", "ps_5_0"));
+        scene->SetVertexShaderOfVoxel(L"VoxelShader");
+        scene->SetPixelShaderOfVoxel(L"VoxelShader");
+        scene->AddPointLight(0u, std::make_shared<PointLight>(XMFLOAT4(0.0f, 64.0f, -16.0f, 1.0f), XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f), 256.0f));
+
+        std::shared_ptr<SoftwareRenderBackend> backend = std::make_shared<SoftwareRenderBackend>();
+        Renderer renderer;
+        renderer.SetRenderBackend(backend);
+        renderer.AddScene(L"Benchmark", scene);
+        renderer.SetMainScene(L"Benchmark");
+        renderer.SetShadowMapShaders(
+            std::make_shared<ShadowVertexShader>(L"Shaders/ShadowShaders.fxh", "VSShadow", "vs_5_0"),
+            std::make_shared<PixelShader>(L"Shaders/ShadowShaders.fxh", "PSShadow", "ps_5_0")
+        );
+
+        HRESULT hr = renderer.Initialize(pDevice, pImmediateContext, RENDER_WIDTH, RENDER_HEIGHT);
+        if (SUCCEEDED(hr))
+        {
+            std::vector<SoftwareRenderBenchmarkResult> results;
+            hr = BenchmarkSoftwareRenderer(renderer, *backend, 10u, results);
+        }
+        if (FAILED(hr))
+        {
+            reportFailure(L"BenchmarkSoftwareRenderer", hr);
+            return FALSE;
+        }
+
+        return TRUE;
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: benchmarkModelPoses
+
+      Summary:  Poses the reference model on the null device
+
+      Args:     ID3D11Device* pDevice
+                ID3D11DeviceContext* pImmediateContext
+                  Null device and its immediate context
+
+      Returns:  BOOL
+                  TRUE if the benchmark ran
+    -----------------------------------------------------------------F-F*/
+    BOOL benchmarkModelPoses(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext)
+    {
+        Model model(MODEL_FILE_PATH);
+        HRESULT hr = model.Initialize(pDevice, pImmediateContext);
+        if (SUCCEEDED(hr))
+        {
+            ModelPoseBenchmarkResult result;
+            hr = BenchmarkModelPoses(model, 10000u, result);
+        }
+        if (FAILED(hr))
+        {
+            reportFailure(L"BenchmarkModelPoses", hr);
+            return FALSE;
+        }
+
+        return TRUE;
+    }
+}
+
+int main()
+{
+    ComPtr<ID3D11Device> device;
+    ComPtr<ID3D11DeviceContext> immediateContext;
+    HRESULT hr = CreateNullDevice(device.GetAddressOf(), immediateContext.GetAddressOf());
+    if (FAILED(hr))
+    {
+        reportFailure(L"CreateNullDevice", hr);
+        return 1;
+    }
+
+    // Every benchmark runs even if one fails
+    BOOL bSucceeded = benchmarkTerrain();
+    bSucceeded = benchmarkSoftwareRenderer(device.Get(), immediateContext.Get()) && bSucceeded;
+    bSucceeded = benchmarkModelPoses(device.Get(), immediateContext.Get()) && bSucceeded;
+
+    return bSucceeded ? 0 : 1;
+}
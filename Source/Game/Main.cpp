@@ -19,6 +19,7 @@
 #include "Light/RotatingPointLight.h"
 #include "Model/Model.h"
 #include "Scene/Scene.h"
+#include "Scene/TerrainGenerator.h"
 #include "Scene/Voxel.h"
 #include "Cube/Cube.h"
 #include "Cube/RotatingCube.h"
@@ -52,163 +53,16 @@ INT WINAPI wWinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
 
     std::unique_ptr<library::Game> game = std::make_unique<library::Game>(L"Game Graphics Programming Lab 10: Shadow Mapping");
 
-    std::ofstream sceneFile;
-    sceneFile.open("HeightMap.txt");
     constexpr const UINT MAP_WIDTH = 0u;
     constexpr const UINT MAP_HEIGHT = 0u;
-    constexpr const UINT MAP_DEPTH = 0u; 
-    XMFLOAT4 aColors[] =
-    {
-        XMFLOAT4(0.0f,      0.666f, 0.0f,   1.0f),  // GRASSLAND
-        XMFLOAT4(1.0f,      1.0f,   1.0f,   1.0f),  // SNOW
-        XMFLOAT4(0.0f,      0.0f,   0.666f, 1.0f),  // OCEAN
-        XMFLOAT4(1.0f,      0.666f, 0.0f,   1.0f),  // SAND
-        XMFLOAT4(0.666f,    0.0f,   0.0f,   1.0f),  // SCORCHED
-        XMFLOAT4(0.956f,    0.643f, 0.376f, 1.0f),  // BARE
-        XMFLOAT4(0.941f,    0.0f,   1.0f,   1.0f),  // TUNDRA
-        XMFLOAT4(0.803f,    0.521f, 0.247f, 1.0f),  // TEMPERATE_DESERT
-        XMFLOAT4(0.42f,     0.556f, 0.137f, 1.0f),  // SHRUBLAND
-        XMFLOAT4(0.0f,      0.392f, 0.0f,   1.0f),  // TAIGA
-        XMFLOAT4(1.0f,      0.55f,  0.0f,   1.0f),  // TEMPERATE_DECIDUOUS_FOREST
-        XMFLOAT4(0.0f,      0.5f,   0.0f,   1.0f),  // TEMPERATE_RAIN_FOREST
-        XMFLOAT4(0.956f,    0.643f, 0.376f, 1.0f),  // SUBTROPICAL_DESERT
-        XMFLOAT4(0.133f,    0.545f, 0.133f, 1.0f),  // TROPICAL_SEASONAL_FOREST
-        XMFLOAT4(0.15f,     0.372f, 0.15f,  1.0f),  // TROPICAL_RAIN_FOREST
-    };
-
-    sceneFile << MAP_WIDTH << " " << MAP_HEIGHT << " " << MAP_DEPTH << ' ' << ARRAYSIZE(aColors) << '\n';
-
-    for (UINT colorIdx = 0; colorIdx < ARRAYSIZE(aColors); ++colorIdx)
-    {
-        sceneFile << aColors[colorIdx].x << ' ' <<
-            aColors[colorIdx].y << ' ' <<
-            aColors[colorIdx].z << '\n';
-    }
-
-    for (UINT z = 0u; z < MAP_DEPTH; ++z)
-    {
-        for (UINT x = 0u; x < MAP_WIDTH; ++x)
-        {
-            FLOAT height = 0.0f;
-
-            FLOAT frequencySum = 0.0f;
-            for (UINT i = 0; i < 4; ++i)
-            {
-                FLOAT frequency = pow(2.0f, static_cast<FLOAT>(i));
-                frequencySum += 1.0f / frequency;
-                height += library::Scene::GetPerlin2d(frequency * static_cast<FLOAT>(x), frequency * static_cast<FLOAT>(z), 0.1f, 4u) / frequency;
-            }
-            height /= frequencySum;
-            height = pow(height * 1.2f, 1.25f);
-
-            assert(height >= 0.0f);
-
-            FLOAT moisture = 0.0f;
-
-            frequencySum = 0.0f;
-            for (UINT i = 0; i < 4; ++i)
-            {
-                FLOAT frequency = pow(2.0f, static_cast<FLOAT>(i));
-                frequencySum += 1.0f / frequency;
-                moisture += library::Scene::GetPerlin2d(frequency * static_cast<FLOAT>(x), frequency * static_cast<FLOAT>(z), 0.1f, 4u) / frequency;
-            }
-            moisture /= frequencySum;
-            moisture = pow(moisture * 1.2f, 1.25f);
-
-            library::eBlockType blockType = library::eBlockType::GRASSLAND;
-
-            if (height < 0.1f)
-            {
-                blockType = library::eBlockType::OCEAN;
-            }
-            else if (height < 0.12f)
-            {
-                blockType = library::eBlockType::SAND;
-            }
-            else if (height > 0.8f)
-            {
-                if (moisture < 0.1f)
-                {
-                    blockType = library::eBlockType::SCORCHED;
-                }
-                else if (moisture < 0.2f)
-                {
-                    blockType = library::eBlockType::BARE;
-                }
-                else if (moisture < 0.5f)
-                {
-                    blockType = library::eBlockType::TUNDRA;
-                }
-                else
-                {
-                    blockType = library::eBlockType::SNOW;
-                }
-            }
-            else if (height > 0.6f)
-            {
-                if (moisture < 0.33f)
-                {
-                    blockType = library::eBlockType::TEMPERATE_DESERT;
-                }
-                else if (moisture < 0.66f)
-                {
-                    blockType = library::eBlockType::SHRUBLAND;
-                }
-                else
-                {
-                    blockType = library::eBlockType::TAIGA;
-                }
-            }
-            else if (height > 0.3f)
-            {
-                if (moisture < 0.16f)
-                {
-                    blockType = library::eBlockType::TEMPERATE_DESERT;
-                }
-                else if (moisture < 0.5f)
-                {
-                    blockType = library::eBlockType::GRASSLAND;
-                }
-                else if (moisture < 0.83f)
-                {
-                    blockType = library::eBlockType::TEMPERATE_DECIDUOUS_FOREST;
-                }
-                else
-                {
-                    blockType = library::eBlockType::TEMPERATE_RAIN_FOREST;
-                }
-            }
-            else
-            {
-
-                if (moisture < 0.16f)
-                {
-                    blockType = library::eBlockType::SUBTROPICAL_DESERT;
-                }
-                else if (moisture < 0.33f)
-                {
-                    blockType = library::eBlockType::GRASSLAND;
-                }
-                else if (moisture < 0.66f)
-                {
-                    blockType = library::eBlockType::TROPICAL_SEASONAL_FOREST;
-                }
-                else
-                {
-                    blockType = library::eBlockType::TROPICAL_RAIN_FOREST;
-                }
-            }
-
-            sceneFile << static_cast<CHAR>(blockType);
-
-            sceneFile << height << ' ';
-        }
-        sceneFile << '\n';
-    }
-    sceneFile << std::endl;
-    sceneFile.close();
-
-    std::shared_ptr<library::Scene> mainScene = std::make_shared<library::Scene>(L"HeightMap.txt");
+    constexpr const UINT MAP_DEPTH = 0u;
+    constexpr const UINT EROSION_DROPLETS = MAP_WIDTH * MAP_DEPTH;
+    constexpr const UINT THERMAL_EROSION_ITERATIONS = 32u;
+    library::TerrainGenerator terrainGenerator(MAP_WIDTH, MAP_HEIGHT, MAP_DEPTH);
+    terrainGenerator.Generate();
+    terrainGenerator.Erode(EROSION_DROPLETS, THERMAL_EROSION_ITERATIONS);
+
+    std::shared_ptr<library::Scene> mainScene = std::make_shared<library::Scene>(terrainGenerator.GetHeightMap());
 
  
     // Phong
@@ -11,30 +11,9 @@
 ===================================================================+*/
 #pragma once
 
-#ifndef  UNICODE
-#define UNICODE
-#endif // ! UNICODE
-
-#ifndef WIN32_LEAN_AND_MEAN
-#define WIN32_LEAN_AND_MEAN
-#endif // ! WIN32_LEAN_AND_MEAN
-
-#include <windows.h>
-#include <wincodec.h>
-#include <wrl.h>
-
-#pragma comment(lib, "d3d11.lib")
-#pragma comment(lib, "d3dcompiler.lib")
-#pragma comment(lib, "dxguid.lib")
-
-#include <d3d11_4.h>
-#include <d3dcompiler.h>
-#include <directxcolors.h>
-
-#define _CRTDBG_MAP_ALLOC
-#include <stdlib.h>
-#include <crtdbg.h>
+#include "Platform/Platform.h"
 
+#include <algorithm>
 #include <cassert>
 #include <filesystem>
 #include <memory>
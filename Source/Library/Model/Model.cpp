@@ -74,7 +74,8 @@ namespace library
                  m_skinningConstantBuffer, m_aVertices, m_aAnimationData,
                  m_aIndices, m_aBoneData, m_aBoneInfo, m_aTransforms,
                  m_aBoneInfo, m_aTransforms, m_boneNameToIndexMap,
-                 m_pScene, m_timeSinceLoaded, m_globalInverseTransform].
+                 m_aJoints, m_aGlobalTransforms, m_pScene,
+                 m_timeSinceLoaded, m_globalInverseTransform].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     Model::Model(_In_ const std::filesystem::path& filePath)
         : Renderable(XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f))
@@ -88,6 +89,8 @@ namespace library
         , m_aBoneInfo(std::vector<BoneInfo>())
         , m_aTransforms(std::vector<XMMATRIX>())
         , m_boneNameToIndexMap(std::unordered_map<std::string, UINT>())
+        , m_aJoints(std::vector<SkeletonJoint>())
+        , m_aGlobalTransforms(std::vector<XMMATRIX>())
         , m_pScene(nullptr)
         , m_timeSinceLoaded(0.0f)
         , m_globalInverseTransform(XMMatrixIdentity())
@@ -128,15 +131,19 @@ namespace library
             XMVECTOR det = XMMatrixDeterminant(m_world);
             m_globalInverseTransform = XMMatrixInverse(&det, m_world);
             hr = initFromScene(pDevice, pImmediateContext, m_pScene, m_filePath);
+            if (FAILED(hr))
+            {
+                return hr;
+            }
         }
         else
         {
-            hr = E_FAIL;
             OutputDebugString(L"Error parsing ");
-            OutputDebugString(m_filePath.c_str());
+            OutputDebugString(m_filePath.wstring().c_str());
             OutputDebugString(L": ");
             OutputDebugStringA(sm_pImporter->GetErrorString());
             OutputDebugString(L"\n");
+            return E_FAIL;
         }
 
         if (m_aAnimationData.size() != 0)
@@ -200,7 +207,7 @@ namespace library
       Args:     FLOAT deltaTime
                   Time difference of a frame
 
-      Modifies: [m_aTransforms].
+      Modifies: [m_timeSinceLoaded, m_aBoneInfo, m_aTransforms].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     void Model::Update(_In_ FLOAT deltaTime)
     {
@@ -211,9 +218,9 @@ namespace library
             FLOAT ticksPerSecond = static_cast<FLOAT>(m_pScene->mAnimations[0]->mTicksPerSecond != 0.0 ? m_pScene->mAnimations[0]->mTicksPerSecond : 25.0f);
             FLOAT timeInTicks = m_timeSinceLoaded * ticksPerSecond;
             FLOAT animationTimeTicks = fmod(timeInTicks, static_cast<FLOAT>(m_pScene->mAnimations[0]->mDuration));
-            if (m_pScene->mRootNode != nullptr)
+            if (!m_aJoints.empty())
             {
-                readNodeHierarchy(animationTimeTicks, m_pScene->mRootNode, XMMatrixIdentity());
+                poseSkeleton(animationTimeTicks);
                 m_aTransforms.resize(m_aBoneInfo.size());
                 for (UINT i = 0u; i < m_aTransforms.size(); ++i)
                 {
@@ -301,6 +308,61 @@ namespace library
         return m_boneNameToIndexMap;
     }
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::buildSkeleton
+
+      Summary:  Flatten the node hierarchy of the scene into joints,
+                parents first, and find the channel of the first
+                animation and the bone of each joint by name once so
+                posing a frame walks the joints in order
+
+      Args:     const aiScene* pScene
+                  Assimp scene whose bones are already initialized
+
+      Modifies: [m_aJoints, m_aGlobalTransforms].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Model::buildSkeleton(_In_ const aiScene* pScene)
+    {
+        m_aJoints.clear();
+        m_aGlobalTransforms.clear();
+
+        if (pScene->mRootNode == nullptr)
+        {
+            return;
+        }
+
+        const aiAnimation* pAnimation = pScene->HasAnimations() ? pScene->mAnimations[0] : nullptr;
+
+        // Depth first with the children pushed in reverse, so joints come
+        // out in the order the recursive walk used to visit them
+        std::vector<std::pair<const aiNode*, INT>> aStack;
+        aStack.emplace_back(pScene->mRootNode, -1);
+        while (!aStack.empty())
+        {
+            const auto [pNode, nParent] = aStack.back();
+            aStack.pop_back();
+
+            const auto it = m_boneNameToIndexMap.find(pNode->mName.C_Str());
+            m_aJoints.push_back(
+                SkeletonJoint
+                {
+                    .nParent = nParent,
+                    .uBone = it != m_boneNameToIndexMap.end() ? it->second : MODEL_NO_BONE,
+                    .pNodeAnim = pAnimation ? findNodeAnimOrNull(pAnimation, pNode->mName.C_Str()) : nullptr,
+                    .LocalTransform = ConvertMatrix(pNode->mTransformation)
+                }
+            );
+
+            const INT nIndex = static_cast<INT>(m_aJoints.size() - 1u);
+            for (UINT i = pNode->mNumChildren; i > 0u; --i)
+            {
+                aStack.emplace_back(pNode->mChildren[i - 1u], nIndex);
+            }
+        }
+
+        m_aGlobalTransforms.resize(m_aJoints.size());
+    }
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
         Method:   Model::countVerticesAndIndices
 
@@ -564,6 +626,8 @@ namespace library
 
         initAllMeshes(pScene);
 
+        buildSkeleton(pScene);
+
         hr = initMaterials(pDevice, pImmediateContext, pScene, filePath);
         if (FAILED(hr))
         {
@@ -894,14 +958,14 @@ namespace library
                 if (FAILED(hr))
                 {
                     OutputDebugString(L"Error loading diffuse texture \"");
-                    OutputDebugString(fullPath.c_str());
+                    OutputDebugString(fullPath.wstring().c_str());
                     OutputDebugString(L"\"\n");
 
                     return hr;
                 }
 
                 OutputDebugString(L"Loaded diffuse texture \"");
-                OutputDebugString(fullPath.c_str());
+                OutputDebugString(fullPath.wstring().c_str());
                 OutputDebugString(L"\"\n");
             }
         }
@@ -958,14 +1022,14 @@ namespace library
                 if (FAILED(hr))
                 {
                     OutputDebugString(L"Error loading specular texture \"");
-                    OutputDebugString(fullPath.c_str());
+                    OutputDebugString(fullPath.wstring().c_str());
                     OutputDebugString(L"\"\n");
 
                     return hr;
                 }
 
                 OutputDebugString(L"Loaded specular texture \"");
-                OutputDebugString(fullPath.c_str());
+                OutputDebugString(fullPath.wstring().c_str());
                 OutputDebugString(L"\"\n");
             }
         }
@@ -1015,14 +1079,14 @@ namespace library
                 if (FAILED(hr))
                 {
                     OutputDebugString(L"Error loading normal texture \"");
-                    OutputDebugString(fullPath.c_str());
+                    OutputDebugString(fullPath.wstring().c_str());
                     OutputDebugString(L"\"\n");
 
                     return hr;
                 }
 
                 OutputDebugString(L"Loaded normal texture \"");
-                OutputDebugString(fullPath.c_str());
+                OutputDebugString(fullPath.wstring().c_str());
                 OutputDebugString(L"\"\n");
             }
         }
@@ -1070,56 +1134,52 @@ namespace library
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-      Method:   Model::readNodeHierarchy
+      Method:   Model::poseSkeleton
 
-      Summary:  Calculate bone transformation of the given assimp node
+      Summary:  Calculate the bone transformations at the given time in
+                one pass over the joints, each animated joint from its
+                channel and the others from their node transform, every
+                parent done before its children
 
       Args:     FLOAT animationTimeTicks
                   Animation time
-               const aiNode* pNode
-                  Pointer to an assimp node object
-                const XMMATRIX& parentTransform
-                  Parent transform in hierarchy
+
+      Modifies: [m_aGlobalTransforms, m_aBoneInfo].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    void Model::readNodeHierarchy(_In_ FLOAT animationTimeTicks, _In_ const aiNode* pNode, _In_ const XMMATRIX& parentTransform)
+    void Model::poseSkeleton(_In_ FLOAT animationTimeTicks)
     {
-        PCSTR NodeName(pNode->mName.C_Str());
-        const aiAnimation* pAnimation = m_pScene->mAnimations[0];
-        XMMATRIX NodeTransform(ConvertMatrix(pNode->mTransformation));
-        const aiNodeAnim* pNodeAnim = findNodeAnimOrNull(pAnimation, pNode->mName.C_Str());
-
-        if (pNodeAnim)
+        for (size_t i = 0u; i < m_aJoints.size(); ++i)
         {
-            // Interpolate scaling and generate scaling transformation matrix
-            XMFLOAT3 scaling = XMFLOAT3();
-            interpolateScaling(scaling, animationTimeTicks, pNodeAnim);
-            XMMATRIX scalingM = XMMatrixScaling(scaling.x, scaling.y, scaling.z);
-
-            // Interpolate rotation and generate rotation transformation matrix
-            XMVECTOR rotation = XMVECTOR();
-            interpolateRotation(rotation, animationTimeTicks, pNodeAnim);
-            XMMATRIX rotationM = XMMatrixRotationQuaternion(rotation);
-
-            // Interpolate translation and generate translation transformation matrix
-            XMFLOAT3 translation = XMFLOAT3();
-            interpolatePosition(translation, animationTimeTicks, pNodeAnim);
-            XMMATRIX translationM = XMMatrixTranslation(translation.x, translation.y, translation.z);
-
-            // Combine the above transformations
-            NodeTransform = scalingM * rotationM * translationM;
-        }
+            const SkeletonJoint& joint = m_aJoints[i];
+            XMMATRIX NodeTransform = joint.LocalTransform;
 
-        XMMATRIX globalTransformation = NodeTransform * parentTransform;
+            if (joint.pNodeAnim)
+            {
+                // Interpolate scaling and generate scaling transformation matrix
+                XMFLOAT3 scaling = XMFLOAT3();
+                interpolateScaling(scaling, animationTimeTicks, joint.pNodeAnim);
+                XMMATRIX scalingM = XMMatrixScaling(scaling.x, scaling.y, scaling.z);
+
+                // Interpolate rotation and generate rotation transformation matrix
+                XMVECTOR rotation = XMVECTOR();
+                interpolateRotation(rotation, animationTimeTicks, joint.pNodeAnim);
+                XMMATRIX rotationM = XMMatrixRotationQuaternion(rotation);
+
+                // Interpolate translation and generate translation transformation matrix
+                XMFLOAT3 translation = XMFLOAT3();
+                interpolatePosition(translation, animationTimeTicks, joint.pNodeAnim);
+                XMMATRIX translationM = XMMatrixTranslation(translation.x, translation.y, translation.z);
+
+                // Combine the above transformations
+                NodeTransform = scalingM * rotationM * translationM;
+            }
 
-        if (m_boneNameToIndexMap.find(NodeName) != m_boneNameToIndexMap.end())
-        {
-            UINT uBoneIndex = m_boneNameToIndexMap[NodeName];
-            m_aBoneInfo[uBoneIndex].FinalTransformation = m_aBoneInfo[uBoneIndex].OffsetMatrix * globalTransformation * m_globalInverseTransform;
-        }
+            m_aGlobalTransforms[i] = joint.nParent < 0 ? NodeTransform : NodeTransform * m_aGlobalTransforms[joint.nParent];
 
-        for (UINT i = 0u; i < pNode->mNumChildren; ++i)
-        {
-            readNodeHierarchy(animationTimeTicks, pNode->mChildren[i], globalTransformation);
+            if (joint.uBone != MODEL_NO_BONE)
+            {
+                m_aBoneInfo[joint.uBone].FinalTransformation = m_aBoneInfo[joint.uBone].OffsetMatrix * m_aGlobalTransforms[i] * m_globalInverseTransform;
+            }
         }
     }
 
@@ -33,6 +33,9 @@ namespace Assimp
 
 namespace library
 {
+    // Bone index of a skeleton joint that drives no bone
+    constexpr UINT MODEL_NO_BONE = UINT_MAX;
+
     /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
       Class:    Model
 
@@ -129,6 +132,24 @@ namespace library
             XMMATRIX FinalTransformation;
         };
 
+        /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+          Struct:   SkeletonJoint
+
+          Summary:  Node of the scene hierarchy flattened at load. Joints
+                    are stored parents first, so a joint's parent always
+                    comes before it, and carry the channel animating them
+                    and the bone they drive so posing needs no name
+                    lookups
+        S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+        struct SkeletonJoint
+        {
+            INT nParent;
+            UINT uBone;
+            const aiNodeAnim* pNodeAnim;
+            XMMATRIX LocalTransform;
+        };
+
+        void buildSkeleton(_In_ const aiScene* pScene);
         void countVerticesAndIndices(_Inout_ UINT& uOutNumVertices, _Inout_ UINT& uOutNumIndices, _In_ const aiScene* pScene);
         const aiNodeAnim* findNodeAnimOrNull(_In_ const aiAnimation* pAnimation, _In_ PCSTR pszNodeName);
         UINT findPosition(_In_ FLOAT animationTimeTicks, _In_ const aiNodeAnim* pNodeAnim);
@@ -184,7 +205,7 @@ namespace library
             _In_ const aiMaterial* pMaterial,
             _In_ UINT uIndex
         );
-        void readNodeHierarchy(_In_ FLOAT animationTimeTicks, _In_ const aiNode* pNode, _In_ const XMMATRIX& parentTransform);
+        void poseSkeleton(_In_ FLOAT animationTimeTicks);
         void reserveSpace(_In_ UINT uNumVertices, _In_ UINT uNumIndices);
 
     protected:
@@ -203,6 +224,8 @@ namespace library
         std::vector<BoneInfo> m_aBoneInfo;
         std::vector<XMMATRIX> m_aTransforms;
         std::unordered_map<std::string, UINT> m_boneNameToIndexMap;
+        std::vector<SkeletonJoint> m_aJoints;
+        std::vector<XMMATRIX> m_aGlobalTransforms;
 
         const aiScene* m_pScene;
 
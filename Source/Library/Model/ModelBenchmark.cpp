@@ -0,0 +1,60 @@
+#include "Model/ModelBenchmark.h"
+
+#include "Platform/Benchmark.h"
+
+namespace library
+{
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: BenchmarkModelPoses
+
+      Summary:  Advances the animation of a model one frame at a time
+                and reports the poses per second to the debug output.
+                Initialize the model, Content/BobLampClean/
+                boblampclean.md5mesh for the reference numbers, before
+                calling this; the null device is enough. The model is
+                left posed at a later time
+
+      Args:     Model& model
+                  Initialized animated model
+                UINT uNumPoses
+                  Number of timed poses
+                ModelPoseBenchmarkResult& result
+                  Receives the throughput
+
+      Returns:  HRESULT
+                  Status code, E_INVALIDARG if the model has no bones to
+                  pose or no pose is requested
+    -----------------------------------------------------------------F-F*/
+    HRESULT BenchmarkModelPoses(_In_ Model& model, _In_ UINT uNumPoses, _Out_ ModelPoseBenchmarkResult& result)
+    {
+        result = {};
+
+        if (uNumPoses == 0u)
+        {
+            return E_INVALIDARG;
+        }
+
+        const FLOAT seconds = TimeBenchmarkRuns(uNumPoses, [&model]() { model.Update(1.0f / 60.0f); });
+        if (model.GetBoneTransforms().empty())
+        {
+            return E_INVALIDARG;
+        }
+
+        result =
+        {
+            .uNumBones = static_cast<UINT>(model.GetBoneTransforms().size()),
+            .uNumPoses = uNumPoses,
+            .PosesPerSecond = GetBenchmarkRate(static_cast<FLOAT>(uNumPoses), seconds),
+            .MicrosecondsPerPose = seconds * 1000000.0f / static_cast<FLOAT>(uNumPoses)
+        };
+
+        ReportBenchmark(
+            L"model poses  bones %3u  %10.0f poses/s  %8.2f us/pose\n",
+            result.uNumBones,
+            result.PosesPerSecond,
+            result.MicrosecondsPerPose
+        );
+
+        return S_OK;
+    }
+}
@@ -0,0 +1,36 @@
+/*+===================================================================
+  File:      MODELBENCHMARK.H
+
+  Summary:   ModelBenchmark header file contains declarations of the
+             function that measures how fast an animated model poses
+             its skeleton.
+
+  Classes: ModelPoseBenchmarkResult
+
+  Functions: BenchmarkModelPoses
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Model/Model.h"
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   ModelPoseBenchmarkResult
+
+      Summary:  Throughput of posing one animated model
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct ModelPoseBenchmarkResult
+    {
+        UINT uNumBones;
+        UINT uNumPoses;
+        FLOAT PosesPerSecond;
+        FLOAT MicrosecondsPerPose;
+    };
+
+    HRESULT BenchmarkModelPoses(_In_ Model& model, _In_ UINT uNumPoses, _Out_ ModelPoseBenchmarkResult& result);
+}
@@ -0,0 +1,125 @@
+#include "Platform/Benchmark.h"
+
+#include <chrono>
+#include <cstdarg>
+#include <cwchar>
+#include <thread>
+
+namespace library
+{
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: GetBenchmarkThreadCounts
+
+      Summary:  Returns the thread counts a benchmark runs with, 1, 2,
+                4... up to and including the number of hardware threads
+
+      Returns:  std::vector<UINT>
+                  Thread counts in increasing order
+    -----------------------------------------------------------------F-F*/
+    std::vector<UINT> GetBenchmarkThreadCounts()
+    {
+        const UINT uMaxThreads = std::max(std::thread::hardware_concurrency(), 1u);
+
+        std::vector<UINT> auThreadCounts;
+        for (UINT uNumThreads = 1u; uNumThreads < uMaxThreads; uNumThreads *= 2u)
+        {
+            auThreadCounts.push_back(uNumThreads);
+        }
+        auThreadCounts.push_back(uMaxThreads);
+
+        return auThreadCounts;
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: TimeBenchmarkRun
+
+      Summary:  Times one call on the steady clock, for benchmarks that
+                time the stages of a run apart
+
+      Args:     const std::function<void()>& run
+                  Work to time
+
+      Returns:  FLOAT
+                  Seconds the call took
+    -----------------------------------------------------------------F-F*/
+    FLOAT TimeBenchmarkRun(_In_ const std::function<void()>& run)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        run();
+        const std::chrono::duration<FLOAT> elapsed = std::chrono::steady_clock::now() - start;
+
+        return elapsed.count();
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: TimeBenchmarkRuns
+
+      Summary:  Calls the run once untimed to warm up the threads and
+                caches, then times the given number of runs back to
+                back
+
+      Args:     UINT uNumRuns
+                  Number of timed runs
+                const std::function<void()>& run
+                  Work of one run
+
+      Returns:  FLOAT
+                  Seconds the timed runs took together
+    -----------------------------------------------------------------F-F*/
+    FLOAT TimeBenchmarkRuns(_In_ UINT uNumRuns, _In_ const std::function<void()>& run)
+    {
+        run();
+
+        return TimeBenchmarkRun(
+            [uNumRuns, &run]()
+            {
+                for (UINT i = 0u; i < uNumRuns; ++i)
+                {
+                    run();
+                }
+            }
+        );
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: GetBenchmarkRate
+
+      Summary:  Divides what a benchmark did by the time it took
+
+      Args:     FLOAT count
+                  Number of items processed
+                FLOAT seconds
+                  Seconds they took
+
+      Returns:  FLOAT
+                  Items per second, 0 if the clock did not advance
+    -----------------------------------------------------------------F-F*/
+    FLOAT GetBenchmarkRate(_In_ FLOAT count, _In_ FLOAT seconds)
+    {
+        return seconds > 0.0f ? count / seconds : 0.0f;
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: ReportBenchmark
+
+      Summary:  Formats one line of benchmark results and writes it to
+                the debug output. Wide strings in the arguments take
+                %ls, which means the same on every platform
+
+      Args:     PCWSTR pszFormat
+                  printf style format of the line
+                ...
+                  Values of the format
+    -----------------------------------------------------------------F-F*/
+    void ReportBenchmark(_In_z_ PCWSTR pszFormat, ...)
+    {
+        WCHAR szMessage[256];
+
+        va_list args;
+        va_start(args, pszFormat);
+        std::vswprintf(szMessage, std::size(szMessage), pszFormat, args);
+        va_end(args);
+
+        OutputDebugString(szMessage);
+    }
+}
@@ -0,0 +1,27 @@
+/*+===================================================================
+  File:      BENCHMARK.H
+
+  Summary:   Benchmark header file contains declarations of the
+             helpers the benchmarks of the library share to pick
+             their thread counts, time their runs and report their
+             results.
+
+  Functions: GetBenchmarkThreadCounts, TimeBenchmarkRun,
+             TimeBenchmarkRuns, GetBenchmarkRate, ReportBenchmark
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include <functional>
+
+namespace library
+{
+    std::vector<UINT> GetBenchmarkThreadCounts();
+    FLOAT TimeBenchmarkRun(_In_ const std::function<void()>& run);
+    FLOAT TimeBenchmarkRuns(_In_ UINT uNumRuns, _In_ const std::function<void()>& run);
+    FLOAT GetBenchmarkRate(_In_ FLOAT count, _In_ FLOAT seconds);
+    void ReportBenchmark(_In_z_ PCWSTR pszFormat, ...);
+}
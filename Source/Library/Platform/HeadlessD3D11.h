@@ -0,0 +1,549 @@
+/*+===================================================================
+  File:      HEADLESSD3D11.H
+
+  Summary:   HeadlessD3D11 header file declares, for non-Windows
+             builds, the subset of the Direct3D 11 / DXGI / WRL API
+             surface the library codes against. Layouts and member
+             names follow the Windows SDK so the same sources compile
+             on both platforms; the only implementation is the null
+             device in Platform/NullDevice.h.
+
+  Classes: Microsoft::WRL::ComPtr<T>, IUnknown, ID3D10Blob,
+           ID3D11DeviceChild, ID3D11Resource, ID3D11Buffer,
+           ID3D11Texture2D, ID3D11View, ID3D11ShaderResourceView,
+           ID3D11RenderTargetView, ID3D11DepthStencilView,
+           ID3D11SamplerState, ID3D11InputLayout,
+           ID3D11VertexShader, ID3D11PixelShader,
+           ID3D11ClassLinkage, ID3D11ClassInstance, ID3D11Device,
+           ID3D11DeviceContext
+
+  Functions: D3DCreateBlob
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#if !defined(_WIN32)
+
+#include <utility>
+
+/*--------------------------------------------------------------------
+  Enumerations
+--------------------------------------------------------------------*/
+enum D3D_DRIVER_TYPE
+{
+    D3D_DRIVER_TYPE_UNKNOWN = 0,
+    D3D_DRIVER_TYPE_HARDWARE,
+    D3D_DRIVER_TYPE_REFERENCE,
+    D3D_DRIVER_TYPE_NULL,
+    D3D_DRIVER_TYPE_SOFTWARE,
+    D3D_DRIVER_TYPE_WARP,
+};
+
+enum D3D_FEATURE_LEVEL
+{
+    D3D_FEATURE_LEVEL_10_0 = 0xa000,
+    D3D_FEATURE_LEVEL_10_1 = 0xa100,
+    D3D_FEATURE_LEVEL_11_0 = 0xb000,
+    D3D_FEATURE_LEVEL_11_1 = 0xb100,
+};
+
+enum DXGI_FORMAT
+{
+    DXGI_FORMAT_UNKNOWN = 0,
+    DXGI_FORMAT_R32G32B32A32_FLOAT = 2,
+    DXGI_FORMAT_R32G32B32A32_UINT = 3,
+    DXGI_FORMAT_R32G32B32_FLOAT = 6,
+    DXGI_FORMAT_R16G16B16A16_UINT = 12,
+    DXGI_FORMAT_R16G16B16A16_SINT = 14,
+    DXGI_FORMAT_R32G32_FLOAT = 16,
+    DXGI_FORMAT_R32G32_UINT = 17,
+    DXGI_FORMAT_R8G8B8A8_UNORM = 28,
+    DXGI_FORMAT_R8G8B8A8_UINT = 30,
+    DXGI_FORMAT_D32_FLOAT = 40,
+    DXGI_FORMAT_R32_FLOAT = 41,
+    DXGI_FORMAT_R32_UINT = 42,
+    DXGI_FORMAT_D24_UNORM_S8_UINT = 45,
+    DXGI_FORMAT_R16_UINT = 57,
+    DXGI_FORMAT_B8G8R8A8_UNORM = 87,
+};
+
+enum D3D11_USAGE
+{
+    D3D11_USAGE_DEFAULT = 0,
+    D3D11_USAGE_IMMUTABLE = 1,
+    D3D11_USAGE_DYNAMIC = 2,
+    D3D11_USAGE_STAGING = 3,
+};
+
+enum D3D11_BIND_FLAG
+{
+    D3D11_BIND_VERTEX_BUFFER = 0x1L,
+    D3D11_BIND_INDEX_BUFFER = 0x2L,
+    D3D11_BIND_CONSTANT_BUFFER = 0x4L,
+    D3D11_BIND_SHADER_RESOURCE = 0x8L,
+    D3D11_BIND_RENDER_TARGET = 0x20L,
+    D3D11_BIND_DEPTH_STENCIL = 0x40L,
+};
+
+enum D3D11_CPU_ACCESS_FLAG
+{
+    D3D11_CPU_ACCESS_WRITE = 0x10000L,
+    D3D11_CPU_ACCESS_READ = 0x20000L,
+};
+
+enum D3D11_RESOURCE_MISC_FLAG
+{
+    D3D11_RESOURCE_MISC_GENERATE_MIPS = 0x1L,
+    D3D11_RESOURCE_MISC_TEXTURECUBE = 0x4L,
+};
+
+enum D3D11_MAP
+{
+    D3D11_MAP_READ = 1,
+    D3D11_MAP_WRITE = 2,
+    D3D11_MAP_READ_WRITE = 3,
+    D3D11_MAP_WRITE_DISCARD = 4,
+    D3D11_MAP_WRITE_NO_OVERWRITE = 5,
+};
+
+enum D3D11_CLEAR_FLAG
+{
+    D3D11_CLEAR_DEPTH = 0x1L,
+    D3D11_CLEAR_STENCIL = 0x2L,
+};
+
+enum D3D11_INPUT_CLASSIFICATION
+{
+    D3D11_INPUT_PER_VERTEX_DATA = 0,
+    D3D11_INPUT_PER_INSTANCE_DATA = 1,
+};
+
+enum D3D11_PRIMITIVE_TOPOLOGY
+{
+    D3D11_PRIMITIVE_TOPOLOGY_UNDEFINED = 0,
+    D3D11_PRIMITIVE_TOPOLOGY_POINTLIST = 1,
+    D3D11_PRIMITIVE_TOPOLOGY_LINELIST = 2,
+    D3D11_PRIMITIVE_TOPOLOGY_LINESTRIP = 3,
+    D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST = 4,
+    D3D11_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP = 5,
+};
+
+enum D3D11_FILTER
+{
+    D3D11_FILTER_MIN_MAG_MIP_POINT = 0,
+    D3D11_FILTER_MIN_MAG_MIP_LINEAR = 0x15,
+    D3D11_FILTER_ANISOTROPIC = 0x55,
+};
+
+enum D3D11_TEXTURE_ADDRESS_MODE
+{
+    D3D11_TEXTURE_ADDRESS_WRAP = 1,
+    D3D11_TEXTURE_ADDRESS_MIRROR = 2,
+    D3D11_TEXTURE_ADDRESS_CLAMP = 3,
+    D3D11_TEXTURE_ADDRESS_BORDER = 4,
+};
+
+enum D3D11_COMPARISON_FUNC
+{
+    D3D11_COMPARISON_NEVER = 1,
+    D3D11_COMPARISON_LESS = 2,
+    D3D11_COMPARISON_EQUAL = 3,
+    D3D11_COMPARISON_LESS_EQUAL = 4,
+    D3D11_COMPARISON_GREATER = 5,
+    D3D11_COMPARISON_NOT_EQUAL = 6,
+    D3D11_COMPARISON_GREATER_EQUAL = 7,
+    D3D11_COMPARISON_ALWAYS = 8,
+};
+
+enum D3D11_SRV_DIMENSION
+{
+    D3D11_SRV_DIMENSION_UNKNOWN = 0,
+    D3D11_SRV_DIMENSION_BUFFER = 1,
+    D3D11_SRV_DIMENSION_TEXTURE2D = 4,
+    D3D11_SRV_DIMENSION_TEXTURECUBE = 9,
+};
+
+enum D3D11_RTV_DIMENSION
+{
+    D3D11_RTV_DIMENSION_UNKNOWN = 0,
+    D3D11_RTV_DIMENSION_TEXTURE2D = 4,
+};
+
+enum D3D11_DSV_DIMENSION
+{
+    D3D11_DSV_DIMENSION_UNKNOWN = 0,
+    D3D11_DSV_DIMENSION_TEXTURE2D = 3,
+};
+
+#define D3D11_FLOAT32_MAX           (3.402823466e+38f)
+#define D3D11_APPEND_ALIGNED_ELEMENT (0xffffffff)
+
+/*--------------------------------------------------------------------
+  Descriptions
+--------------------------------------------------------------------*/
+struct DXGI_SAMPLE_DESC
+{
+    UINT Count;
+    UINT Quality;
+};
+
+struct D3D11_BUFFER_DESC
+{
+    UINT ByteWidth;
+    D3D11_USAGE Usage;
+    UINT BindFlags;
+    UINT CPUAccessFlags;
+    UINT MiscFlags;
+    UINT StructureByteStride;
+};
+
+struct D3D11_TEXTURE2D_DESC
+{
+    UINT Width;
+    UINT Height;
+    UINT MipLevels;
+    UINT ArraySize;
+    DXGI_FORMAT Format;
+    DXGI_SAMPLE_DESC SampleDesc;
+    D3D11_USAGE Usage;
+    UINT BindFlags;
+    UINT CPUAccessFlags;
+    UINT MiscFlags;
+};
+
+struct D3D11_SUBRESOURCE_DATA
+{
+    const void* pSysMem;
+    UINT SysMemPitch;
+    UINT SysMemSlicePitch;
+};
+
+struct D3D11_MAPPED_SUBRESOURCE
+{
+    void* pData;
+    UINT RowPitch;
+    UINT DepthPitch;
+};
+
+struct D3D11_BOX
+{
+    UINT left;
+    UINT top;
+    UINT front;
+    UINT right;
+    UINT bottom;
+    UINT back;
+};
+
+struct D3D11_BUFFER_SRV
+{
+    UINT FirstElement;
+    UINT NumElements;
+};
+
+struct D3D11_TEX2D_SRV
+{
+    UINT MostDetailedMip;
+    UINT MipLevels;
+};
+
+struct D3D11_TEXCUBE_SRV
+{
+    UINT MostDetailedMip;
+    UINT MipLevels;
+};
+
+struct D3D11_SHADER_RESOURCE_VIEW_DESC
+{
+    DXGI_FORMAT Format;
+    D3D11_SRV_DIMENSION ViewDimension;
+    union
+    {
+        D3D11_BUFFER_SRV Buffer;
+        D3D11_TEX2D_SRV Texture2D;
+        D3D11_TEXCUBE_SRV TextureCube;
+    };
+};
+
+struct D3D11_TEX2D_RTV
+{
+    UINT MipSlice;
+};
+
+struct D3D11_RENDER_TARGET_VIEW_DESC
+{
+    DXGI_FORMAT Format;
+    D3D11_RTV_DIMENSION ViewDimension;
+    union
+    {
+        D3D11_TEX2D_RTV Texture2D;
+    };
+};
+
+struct D3D11_TEX2D_DSV
+{
+    UINT MipSlice;
+};
+
+struct D3D11_DEPTH_STENCIL_VIEW_DESC
+{
+    DXGI_FORMAT Format;
+    D3D11_DSV_DIMENSION ViewDimension;
+    UINT Flags;
+    union
+    {
+        D3D11_TEX2D_DSV Texture2D;
+    };
+};
+
+struct D3D11_SAMPLER_DESC
+{
+    D3D11_FILTER Filter;
+    D3D11_TEXTURE_ADDRESS_MODE AddressU;
+    D3D11_TEXTURE_ADDRESS_MODE AddressV;
+    D3D11_TEXTURE_ADDRESS_MODE AddressW;
+    FLOAT MipLODBias;
+    UINT MaxAnisotropy;
+    D3D11_COMPARISON_FUNC ComparisonFunc;
+    FLOAT BorderColor[4];
+    FLOAT MinLOD;
+    FLOAT MaxLOD;
+};
+
+struct D3D11_INPUT_ELEMENT_DESC
+{
+    PCSTR SemanticName;
+    UINT SemanticIndex;
+    DXGI_FORMAT Format;
+    UINT InputSlot;
+    UINT AlignedByteOffset;
+    D3D11_INPUT_CLASSIFICATION InputSlotClass;
+    UINT InstanceDataStepRate;
+};
+
+struct D3D11_VIEWPORT
+{
+    FLOAT TopLeftX;
+    FLOAT TopLeftY;
+    FLOAT Width;
+    FLOAT Height;
+    FLOAT MinDepth;
+    FLOAT MaxDepth;
+};
+
+/*--------------------------------------------------------------------
+  Interfaces
+--------------------------------------------------------------------*/
+struct IUnknown
+{
+    virtual ULONG AddRef() = 0;
+    virtual ULONG Release() = 0;
+
+protected:
+    virtual ~IUnknown() = default;
+};
+
+struct ID3D10Blob : public IUnknown
+{
+    virtual LPVOID GetBufferPointer() = 0;
+    virtual SIZE_T GetBufferSize() = 0;
+};
+typedef ID3D10Blob ID3DBlob;
+
+struct ID3D11Device;
+
+struct ID3D11DeviceChild : public IUnknown
+{
+    virtual void GetDevice(_Outptr_ ID3D11Device** ppDevice) = 0;
+};
+
+struct ID3D11Resource : public ID3D11DeviceChild
+{
+};
+
+struct ID3D11Buffer : public ID3D11Resource
+{
+    virtual void GetDesc(_Out_ D3D11_BUFFER_DESC* pDesc) = 0;
+};
+
+struct ID3D11Texture2D : public ID3D11Resource
+{
+    virtual void GetDesc(_Out_ D3D11_TEXTURE2D_DESC* pDesc) = 0;
+};
+
+struct ID3D11View : public ID3D11DeviceChild
+{
+    virtual void GetResource(_Outptr_ ID3D11Resource** ppResource) = 0;
+};
+
+struct ID3D11ShaderResourceView : public ID3D11View
+{
+};
+
+struct ID3D11RenderTargetView : public ID3D11View
+{
+};
+
+struct ID3D11DepthStencilView : public ID3D11View
+{
+};
+
+struct ID3D11SamplerState : public ID3D11DeviceChild
+{
+    virtual void GetDesc(_Out_ D3D11_SAMPLER_DESC* pDesc) = 0;
+};
+
+struct ID3D11InputLayout : public ID3D11DeviceChild
+{
+};
+
+struct ID3D11VertexShader : public ID3D11DeviceChild
+{
+};
+
+struct ID3D11PixelShader : public ID3D11DeviceChild
+{
+};
+
+struct ID3D11ClassLinkage : public ID3D11DeviceChild
+{
+};
+
+struct ID3D11ClassInstance : public ID3D11DeviceChild
+{
+};
+
+struct ID3D11DeviceContext;
+
+struct ID3D11Device : public IUnknown
+{
+    virtual HRESULT CreateBuffer(_In_ const D3D11_BUFFER_DESC* pDesc, _In_opt_ const D3D11_SUBRESOURCE_DATA* pInitialData, _Outptr_opt_ ID3D11Buffer** ppBuffer) = 0;
+    virtual HRESULT CreateTexture2D(_In_ const D3D11_TEXTURE2D_DESC* pDesc, _In_opt_ const D3D11_SUBRESOURCE_DATA* pInitialData, _Outptr_opt_ ID3D11Texture2D** ppTexture2D) = 0;
+    virtual HRESULT CreateShaderResourceView(_In_ ID3D11Resource* pResource, _In_opt_ const D3D11_SHADER_RESOURCE_VIEW_DESC* pDesc, _Outptr_opt_ ID3D11ShaderResourceView** ppSRView) = 0;
+    virtual HRESULT CreateRenderTargetView(_In_ ID3D11Resource* pResource, _In_opt_ const D3D11_RENDER_TARGET_VIEW_DESC* pDesc, _Outptr_opt_ ID3D11RenderTargetView** ppRTView) = 0;
+    virtual HRESULT CreateDepthStencilView(_In_ ID3D11Resource* pResource, _In_opt_ const D3D11_DEPTH_STENCIL_VIEW_DESC* pDesc, _Outptr_opt_ ID3D11DepthStencilView** ppDepthStencilView) = 0;
+    virtual HRESULT CreateInputLayout(_In_reads_(NumElements) const D3D11_INPUT_ELEMENT_DESC* pInputElementDescs, _In_ UINT NumElements, _In_ const void* pShaderBytecodeWithInputSignature, _In_ SIZE_T BytecodeLength, _Outptr_opt_ ID3D11InputLayout** ppInputLayout) = 0;
+    virtual HRESULT CreateVertexShader(_In_ const void* pShaderBytecode, _In_ SIZE_T BytecodeLength, _In_opt_ ID3D11ClassLinkage* pClassLinkage, _Outptr_opt_ ID3D11VertexShader** ppVertexShader) = 0;
+    virtual HRESULT CreatePixelShader(_In_ const void* pShaderBytecode, _In_ SIZE_T BytecodeLength, _In_opt_ ID3D11ClassLinkage* pClassLinkage, _Outptr_opt_ ID3D11PixelShader** ppPixelShader) = 0;
+    virtual HRESULT CreateSamplerState(_In_ const D3D11_SAMPLER_DESC* pSamplerDesc, _Outptr_opt_ ID3D11SamplerState** ppSamplerState) = 0;
+    virtual void GetImmediateContext(_Outptr_ ID3D11DeviceContext** ppImmediateContext) = 0;
+};
+
+struct ID3D11DeviceContext : public ID3D11DeviceChild
+{
+    virtual void VSSetConstantBuffers(_In_ UINT StartSlot, _In_ UINT NumBuffers, _In_reads_opt_(NumBuffers) ID3D11Buffer* const* ppConstantBuffers) = 0;
+    virtual void PSSetShaderResources(_In_ UINT StartSlot, _In_ UINT NumViews, _In_reads_opt_(NumViews) ID3D11ShaderResourceView* const* ppShaderResourceViews) = 0;
+    virtual void PSSetShader(_In_opt_ ID3D11PixelShader* pPixelShader, _In_reads_opt_(NumClassInstances) ID3D11ClassInstance* const* ppClassInstances, UINT NumClassInstances) = 0;
+    virtual void PSSetSamplers(_In_ UINT StartSlot, _In_ UINT NumSamplers, _In_reads_opt_(NumSamplers) ID3D11SamplerState* const* ppSamplers) = 0;
+    virtual void VSSetShader(_In_opt_ ID3D11VertexShader* pVertexShader, _In_reads_opt_(NumClassInstances) ID3D11ClassInstance* const* ppClassInstances, UINT NumClassInstances) = 0;
+    virtual void DrawIndexed(_In_ UINT IndexCount, _In_ UINT StartIndexLocation, _In_ INT BaseVertexLocation) = 0;
+    virtual void Draw(_In_ UINT VertexCount, _In_ UINT StartVertexLocation) = 0;
+    virtual HRESULT Map(_In_ ID3D11Resource* pResource, _In_ UINT Subresource, _In_ D3D11_MAP MapType, _In_ UINT MapFlags, _Out_opt_ D3D11_MAPPED_SUBRESOURCE* pMappedResource) = 0;
+    virtual void Unmap(_In_ ID3D11Resource* pResource, _In_ UINT Subresource) = 0;
+    virtual void PSSetConstantBuffers(_In_ UINT StartSlot, _In_ UINT NumBuffers, _In_reads_opt_(NumBuffers) ID3D11Buffer* const* ppConstantBuffers) = 0;
+    virtual void IASetInputLayout(_In_opt_ ID3D11InputLayout* pInputLayout) = 0;
+    virtual void IASetVertexBuffers(_In_ UINT StartSlot, _In_ UINT NumBuffers, _In_reads_opt_(NumBuffers) ID3D11Buffer* const* ppVertexBuffers, _In_reads_opt_(NumBuffers) const UINT* pStrides, _In_reads_opt_(NumBuffers) const UINT* pOffsets) = 0;
+    virtual void IASetIndexBuffer(_In_opt_ ID3D11Buffer* pIndexBuffer, _In_ DXGI_FORMAT Format, _In_ UINT Offset) = 0;
+    virtual void DrawIndexedInstanced(_In_ UINT IndexCountPerInstance, _In_ UINT InstanceCount, _In_ UINT StartIndexLocation, _In_ INT BaseVertexLocation, _In_ UINT StartInstanceLocation) = 0;
+    virtual void DrawInstanced(_In_ UINT VertexCountPerInstance, _In_ UINT InstanceCount, _In_ UINT StartVertexLocation, _In_ UINT StartInstanceLocation) = 0;
+    virtual void IASetPrimitiveTopology(_In_ D3D11_PRIMITIVE_TOPOLOGY Topology) = 0;
+    virtual void OMSetRenderTargets(_In_ UINT NumViews, _In_reads_opt_(NumViews) ID3D11RenderTargetView* const* ppRenderTargetViews, _In_opt_ ID3D11DepthStencilView* pDepthStencilView) = 0;
+    virtual void RSSetViewports(_In_ UINT NumViewports, _In_reads_opt_(NumViewports) const D3D11_VIEWPORT* pViewports) = 0;
+    virtual void UpdateSubresource(_In_ ID3D11Resource* pDstResource, _In_ UINT DstSubresource, _In_opt_ const D3D11_BOX* pDstBox, _In_ const void* pSrcData, _In_ UINT SrcRowPitch, _In_ UINT SrcDepthPitch) = 0;
+    virtual void ClearRenderTargetView(_In_ ID3D11RenderTargetView* pRenderTargetView, _In_ const FLOAT ColorRGBA[4]) = 0;
+    virtual void ClearDepthStencilView(_In_ ID3D11DepthStencilView* pDepthStencilView, _In_ UINT ClearFlags, _In_ FLOAT Depth, _In_ UINT8 Stencil) = 0;
+    virtual void GenerateMips(_In_ ID3D11ShaderResourceView* pShaderResourceView) = 0;
+};
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: D3DCreateBlob
+
+  Summary:  Creates a buffer of the given size, defined with the null
+            device in Platform/NullDevice.cpp
+
+  Args:     SIZE_T Size
+              Number of bytes in the blob
+            ID3DBlob** ppBlob
+              Receives the blob
+
+  Returns:  HRESULT
+              Status code
+-----------------------------------------------------------------F-F*/
+HRESULT D3DCreateBlob(_In_ SIZE_T Size, _Outptr_ ID3DBlob** ppBlob);
+
+namespace Microsoft
+{
+    namespace WRL
+    {
+        /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+          Class:    ComPtr<T>
+
+          Summary:  Reference counting smart pointer with the part of the
+                    WRL ComPtr interface the library uses
+
+          Methods:  Get
+                      Returns the raw interface pointer
+                    GetAddressOf
+                      Returns the address of the raw interface pointer
+                    ReleaseAndGetAddressOf
+                      Releases the interface and returns its address
+                    Reset
+                      Releases the interface
+                    Attach
+                      Takes ownership of a raw pointer without AddRef
+                    Detach
+                      Gives up ownership without Release
+                    CopyTo
+                      AddRefs and copies the pointer out
+        C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+        template <typename T>
+        class ComPtr
+        {
+        public:
+            ComPtr() noexcept : m_ptr(nullptr) {}
+            ComPtr(std::nullptr_t) noexcept : m_ptr(nullptr) {}
+            ComPtr(T* ptr) noexcept : m_ptr(ptr) { internalAddRef(); }
+            ComPtr(const ComPtr& other) noexcept : m_ptr(other.m_ptr) { internalAddRef(); }
+            ComPtr(ComPtr&& other) noexcept : m_ptr(std::exchange(other.m_ptr, nullptr)) {}
+            template <typename U>
+            ComPtr(const ComPtr<U>& other) noexcept : m_ptr(other.Get()) { internalAddRef(); }
+            ~ComPtr() { internalRelease(); }
+
+            ComPtr& operator=(std::nullptr_t) noexcept { internalRelease(); return *this; }
+            ComPtr& operator=(T* ptr) noexcept { ComPtr(ptr).Swap(*this); return *this; }
+            ComPtr& operator=(const ComPtr& other) noexcept { ComPtr(other).Swap(*this); return *this; }
+            ComPtr& operator=(ComPtr&& other) noexcept { ComPtr(std::move(other)).Swap(*this); return *this; }
+
+            void Swap(ComPtr& other) noexcept { std::swap(m_ptr, other.m_ptr); }
+
+            T* Get() const noexcept { return m_ptr; }
+            T* operator->() const noexcept { return m_ptr; }
+            explicit operator bool() const noexcept { return m_ptr != nullptr; }
+
+            T* const* GetAddressOf() const noexcept { return &m_ptr; }
+            T** GetAddressOf() noexcept { return &m_ptr; }
+            T** ReleaseAndGetAddressOf() noexcept { internalRelease(); return &m_ptr; }
+            T** operator&() noexcept { return ReleaseAndGetAddressOf(); }
+
+            void Reset() noexcept { internalRelease(); }
+            void Attach(T* ptr) noexcept { internalRelease(); m_ptr = ptr; }
+            T* Detach() noexcept { return std::exchange(m_ptr, nullptr); }
+            HRESULT CopyTo(_Outptr_ T** ppOut) const noexcept { internalAddRef(); *ppOut = m_ptr; return S_OK; }
+
+        private:
+            void internalAddRef() const noexcept { if (m_ptr) { m_ptr->AddRef(); } }
+            void internalRelease() noexcept { if (T* ptr = std::exchange(m_ptr, nullptr)) { ptr->Release(); } }
+
+        private:
+            T* m_ptr;
+        };
+
+        template <typename T, typename U>
+        bool operator==(const ComPtr<T>& a, const ComPtr<U>& b) noexcept { return a.Get() == b.Get(); }
+        template <typename T>
+        bool operator==(const ComPtr<T>& a, std::nullptr_t) noexcept { return a.Get() == nullptr; }
+    }
+}
+
+#endif // !_WIN32
@@ -0,0 +1,173 @@
+#include "Platform/MappedFile.h"
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MappedFile::MappedFile
+
+      Summary:  Constructor, no file is mapped
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    MappedFile::MappedFile()
+#if defined(_WIN32)
+        : m_file(INVALID_HANDLE_VALUE)
+        , m_mapping(nullptr)
+#else
+        : m_nFile(-1)
+#endif
+        , m_pData(nullptr)
+        , m_uSize(0u)
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MappedFile::~MappedFile
+
+      Summary:  Destructor. Unmaps the file
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    MappedFile::~MappedFile()
+    {
+        Close();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MappedFile::Open
+
+      Summary:  Maps the whole of a file for reading. An empty file
+                opens with no view, as it cannot be mapped
+
+      Args:     const std::filesystem::path& filePath
+                  File to map
+
+      Modifies: [m_file, m_mapping, m_nFile, m_pData, m_uSize].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT MappedFile::Open(_In_ const std::filesystem::path& filePath)
+    {
+        Close();
+
+#if defined(_WIN32)
+        m_file = CreateFileW(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (m_file == INVALID_HANDLE_VALUE)
+        {
+            return HRESULT_FROM_WIN32(GetLastError());
+        }
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(m_file, &fileSize))
+        {
+            HRESULT hr = HRESULT_FROM_WIN32(GetLastError());
+            Close();
+            return hr;
+        }
+
+        m_uSize = static_cast<SIZE_T>(fileSize.QuadPart);
+        if (m_uSize == 0u)
+        {
+            return S_OK;
+        }
+
+        m_mapping = CreateFileMappingW(m_file, nullptr, PAGE_READONLY, 0u, 0u, nullptr);
+        if (!m_mapping)
+        {
+            HRESULT hr = HRESULT_FROM_WIN32(GetLastError());
+            Close();
+            return hr;
+        }
+
+        m_pData = static_cast<const BYTE*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0u, 0u, 0u));
+        if (!m_pData)
+        {
+            HRESULT hr = HRESULT_FROM_WIN32(GetLastError());
+            Close();
+            return hr;
+        }
+#else
+        m_nFile = open(filePath.c_str(), O_RDONLY);
+        if (m_nFile < 0)
+        {
+            return E_FAIL;
+        }
+
+        struct stat fileStatus;
+        if (fstat(m_nFile, &fileStatus) != 0)
+        {
+            Close();
+            return E_FAIL;
+        }
+
+        m_uSize = static_cast<SIZE_T>(fileStatus.st_size);
+        if (m_uSize == 0u)
+        {
+            return S_OK;
+        }
+
+        void* pView = mmap(nullptr, m_uSize, PROT_READ, MAP_PRIVATE, m_nFile, 0);
+        if (pView == MAP_FAILED)
+        {
+            Close();
+            return E_FAIL;
+        }
+        m_pData = static_cast<const BYTE*>(pView);
+#endif
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MappedFile::Close
+
+      Summary:  Unmaps the view and closes the file, if any
+
+      Modifies: [m_file, m_mapping, m_nFile, m_pData, m_uSize].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void MappedFile::Close()
+    {
+#if defined(_WIN32)
+        if (m_pData)
+        {
+            UnmapViewOfFile(m_pData);
+        }
+        if (m_mapping)
+        {
+            CloseHandle(m_mapping);
+            m_mapping = nullptr;
+        }
+        if (m_file != INVALID_HANDLE_VALUE)
+        {
+            CloseHandle(m_file);
+            m_file = INVALID_HANDLE_VALUE;
+        }
+#else
+        if (m_pData)
+        {
+            munmap(const_cast<BYTE*>(m_pData), m_uSize);
+        }
+        if (m_nFile >= 0)
+        {
+            close(m_nFile);
+            m_nFile = -1;
+        }
+#endif
+        m_pData = nullptr;
+        m_uSize = 0u;
+    }
+
+    const BYTE* MappedFile::GetData() const
+    {
+        return m_pData;
+    }
+
+    SIZE_T MappedFile::GetSize() const
+    {
+        return m_uSize;
+    }
+}
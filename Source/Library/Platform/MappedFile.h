@@ -0,0 +1,65 @@
+/*+===================================================================
+  File:      MAPPEDFILE.H
+
+  Summary:   MappedFile header file contains declarations of the
+             read-only view of a whole file mapped into memory, so
+             loaders read it in place instead of through a stream.
+
+  Classes: MappedFile
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    MappedFile
+
+      Summary:  Maps a file read-only with MapViewOfFile on Windows and
+                mmap elsewhere. Pages are read in by the OS as they are
+                touched, so threads reading different parts of the view
+                load them in parallel
+
+      Methods:  Open
+                  Maps a file, unmapping the previous one
+                Close
+                  Unmaps the file
+                GetData
+                  Returns the first byte of the view
+                GetSize
+                  Returns the size of the file in bytes
+                MappedFile
+                  Constructor.
+                ~MappedFile
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class MappedFile final
+    {
+    public:
+        MappedFile();
+        MappedFile(const MappedFile& other) = delete;
+        MappedFile(MappedFile&& other) = delete;
+        MappedFile& operator=(const MappedFile& other) = delete;
+        MappedFile& operator=(MappedFile&& other) = delete;
+        ~MappedFile();
+
+        HRESULT Open(_In_ const std::filesystem::path& filePath);
+        void Close();
+
+        const BYTE* GetData() const;
+        SIZE_T GetSize() const;
+
+    private:
+#if defined(_WIN32)
+        HANDLE m_file;
+        HANDLE m_mapping;
+#else
+        INT m_nFile;
+#endif
+        const BYTE* m_pData;
+        SIZE_T m_uSize;
+    };
+}
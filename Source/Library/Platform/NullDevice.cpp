@@ -0,0 +1,864 @@
+#include "Platform/NullDevice.h"
+
+#if !defined(_WIN32)
+
+namespace library
+{
+    namespace
+    {
+        /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+          Class:    NullObject<TInterface>
+
+          Summary:  Reference counted implementation of a device child
+                    that keeps its owning device alive
+        C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+        template <typename TInterface>
+        class NullObject : public TInterface
+        {
+        public:
+            explicit NullObject(_In_ ID3D11Device* pDevice)
+                : m_uRefCount(1u)
+                , m_device(pDevice)
+            {
+            }
+
+            ULONG AddRef() override
+            {
+                return ++m_uRefCount;
+            }
+
+            ULONG Release() override
+            {
+                ULONG uRefCount = --m_uRefCount;
+                if (uRefCount == 0u)
+                {
+                    delete this;
+                }
+                return uRefCount;
+            }
+
+            void GetDevice(_Outptr_ ID3D11Device** ppDevice) override
+            {
+                m_device.CopyTo(ppDevice);
+            }
+
+        protected:
+            std::atomic<ULONG> m_uRefCount;
+            ComPtr<ID3D11Device> m_device;
+        };
+
+        /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+          Class:    INullResource
+
+          Summary:  Gives the null context access to the system memory
+                    backing a resource
+        C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+        class INullResource
+        {
+        public:
+            virtual std::vector<BYTE>& GetData() = 0;
+            virtual UINT GetRowPitch() const = 0;
+
+        protected:
+            ~INullResource() = default;
+        };
+
+        class NullBuffer final : public NullObject<ID3D11Buffer>, public INullResource
+        {
+        public:
+            NullBuffer(_In_ ID3D11Device* pDevice, _In_ const D3D11_BUFFER_DESC& desc)
+                : NullObject<ID3D11Buffer>(pDevice)
+                , m_desc(desc)
+                , m_aData(desc.ByteWidth)
+            {
+            }
+
+            void GetDesc(_Out_ D3D11_BUFFER_DESC* pDesc) override
+            {
+                *pDesc = m_desc;
+            }
+
+            std::vector<BYTE>& GetData() override
+            {
+                return m_aData;
+            }
+
+            UINT GetRowPitch() const override
+            {
+                return m_desc.ByteWidth;
+            }
+
+        private:
+            D3D11_BUFFER_DESC m_desc;
+            std::vector<BYTE> m_aData;
+        };
+
+        /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+          Function: getBytesPerPixel
+
+          Summary:  Returns the size of a texel of the given format
+
+          Args:     DXGI_FORMAT format
+                      Texel format
+
+          Returns:  UINT
+                      Size in bytes, 4 for unknown formats
+        -----------------------------------------------------------------F-F*/
+        UINT getBytesPerPixel(_In_ DXGI_FORMAT format)
+        {
+            switch (format)
+            {
+            case DXGI_FORMAT_R32G32B32A32_FLOAT:
+            case DXGI_FORMAT_R32G32B32A32_UINT:
+                return 16u;
+            case DXGI_FORMAT_R32G32B32_FLOAT:
+                return 12u;
+            case DXGI_FORMAT_R16G16B16A16_UINT:
+            case DXGI_FORMAT_R32G32_FLOAT:
+            case DXGI_FORMAT_R32G32_UINT:
+                return 8u;
+            case DXGI_FORMAT_R16_UINT:
+                return 2u;
+            default:
+                return 4u;
+            }
+        }
+
+        class NullTexture2D final : public NullObject<ID3D11Texture2D>, public INullResource
+        {
+        public:
+            NullTexture2D(_In_ ID3D11Device* pDevice, _In_ const D3D11_TEXTURE2D_DESC& desc)
+                : NullObject<ID3D11Texture2D>(pDevice)
+                , m_desc(desc)
+                , m_aData(static_cast<size_t>(desc.Width) * desc.Height * std::max(desc.ArraySize, 1u) * getBytesPerPixel(desc.Format))
+            {
+            }
+
+            void GetDesc(_Out_ D3D11_TEXTURE2D_DESC* pDesc) override
+            {
+                *pDesc = m_desc;
+            }
+
+            std::vector<BYTE>& GetData() override
+            {
+                return m_aData;
+            }
+
+            UINT GetRowPitch() const override
+            {
+                return m_desc.Width * getBytesPerPixel(m_desc.Format);
+            }
+
+        private:
+            D3D11_TEXTURE2D_DESC m_desc;
+            std::vector<BYTE> m_aData;
+        };
+
+        template <typename TInterface>
+        class NullView final : public NullObject<TInterface>
+        {
+        public:
+            NullView(_In_ ID3D11Device* pDevice, _In_ ID3D11Resource* pResource)
+                : NullObject<TInterface>(pDevice)
+                , m_resource(pResource)
+            {
+            }
+
+            void GetResource(_Outptr_ ID3D11Resource** ppResource) override
+            {
+                m_resource.CopyTo(ppResource);
+            }
+
+        private:
+            ComPtr<ID3D11Resource> m_resource;
+        };
+
+        template <typename TInterface>
+        class NullState final : public NullObject<TInterface>
+        {
+        public:
+            using NullObject<TInterface>::NullObject;
+        };
+
+        class NullSamplerState final : public NullObject<ID3D11SamplerState>
+        {
+        public:
+            NullSamplerState(_In_ ID3D11Device* pDevice, _In_ const D3D11_SAMPLER_DESC& desc)
+                : NullObject<ID3D11SamplerState>(pDevice)
+                , m_desc(desc)
+            {
+            }
+
+            void GetDesc(_Out_ D3D11_SAMPLER_DESC* pDesc) override
+            {
+                *pDesc = m_desc;
+            }
+
+        private:
+            D3D11_SAMPLER_DESC m_desc;
+        };
+
+        /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+          Class:    INullShader
+
+          Summary:  Gives access to the bytecode a shader was created
+                    from
+        C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+        class INullShader
+        {
+        public:
+            virtual const std::vector<BYTE>& GetBytecode() const = 0;
+
+        protected:
+            ~INullShader() = default;
+        };
+
+        template <typename TInterface>
+        class NullShader final : public NullObject<TInterface>, public INullShader
+        {
+        public:
+            NullShader(_In_ ID3D11Device* pDevice, _In_ const void* pShaderBytecode, _In_ SIZE_T uBytecodeLength)
+                : NullObject<TInterface>(pDevice)
+                , m_aBytecode(static_cast<const BYTE*>(pShaderBytecode), static_cast<const BYTE*>(pShaderBytecode) + (pShaderBytecode ? uBytecodeLength : 0u))
+            {
+            }
+
+            const std::vector<BYTE>& GetBytecode() const override
+            {
+                return m_aBytecode;
+            }
+
+        private:
+            std::vector<BYTE> m_aBytecode;
+        };
+
+        class NullBlob final : public ID3DBlob
+        {
+        public:
+            explicit NullBlob(_In_ SIZE_T size)
+                : m_uRefCount(1u)
+                , m_aData(size)
+            {
+            }
+
+            ULONG AddRef() override
+            {
+                return ++m_uRefCount;
+            }
+
+            ULONG Release() override
+            {
+                ULONG uRefCount = --m_uRefCount;
+                if (uRefCount == 0u)
+                {
+                    delete this;
+                }
+                return uRefCount;
+            }
+
+            LPVOID GetBufferPointer() override
+            {
+                return m_aData.data();
+            }
+
+            SIZE_T GetBufferSize() override
+            {
+                return m_aData.size();
+            }
+
+        private:
+            std::atomic<ULONG> m_uRefCount;
+            std::vector<BYTE> m_aData;
+        };
+
+        template <typename TInterface, typename TObject>
+        HRESULT returnObject(_In_ TObject* pObject, _Outptr_opt_ TInterface** ppOut)
+        {
+            if (ppOut)
+            {
+                *ppOut = pObject;
+            }
+            else
+            {
+                pObject->Release();
+            }
+            return S_OK;
+        }
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullDevice::NullDevice
+
+      Summary:  Constructor
+
+      Modifies: [m_uRefCount, m_pImmediateContext, m_statistics].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    NullDevice::NullDevice()
+        : m_uRefCount(1u)
+        , m_pImmediateContext(nullptr)
+        , m_statistics()
+    {
+        m_pImmediateContext = new NullDeviceContext(this);
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullDevice::~NullDevice
+
+      Summary:  Destructor
+
+      Modifies: [m_pImmediateContext].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    NullDevice::~NullDevice()
+    {
+        delete m_pImmediateContext;
+    }
+
+
+    ULONG NullDevice::AddRef()
+    {
+        return ++m_uRefCount;
+    }
+
+
+    ULONG NullDevice::Release()
+    {
+        ULONG uRefCount = --m_uRefCount;
+        if (uRefCount == 0u)
+        {
+            delete this;
+        }
+        return uRefCount;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullDevice::CreateBuffer
+
+      Summary:  Creates a buffer in system memory
+
+      Args:     const D3D11_BUFFER_DESC* pDesc
+                  Description of the buffer
+                const D3D11_SUBRESOURCE_DATA* pInitialData
+                  Optional initial contents
+                ID3D11Buffer** ppBuffer
+                  Receives the buffer
+
+      Modifies: [m_statistics].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT NullDevice::CreateBuffer(_In_ const D3D11_BUFFER_DESC* pDesc, _In_opt_ const D3D11_SUBRESOURCE_DATA* pInitialData, _Outptr_opt_ ID3D11Buffer** ppBuffer)
+    {
+        if (!pDesc || pDesc->ByteWidth == 0u)
+        {
+            return E_INVALIDARG;
+        }
+
+        NullBuffer* pBuffer = new NullBuffer(this, *pDesc);
+        if (pInitialData && pInitialData->pSysMem)
+        {
+            memcpy(pBuffer->GetData().data(), pInitialData->pSysMem, pDesc->ByteWidth);
+        }
+
+        ++m_statistics.uNumBuffers;
+        m_statistics.uBufferBytes += pDesc->ByteWidth;
+
+        return returnObject(pBuffer, ppBuffer);
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullDevice::CreateTexture2D
+
+      Summary:  Creates a 2D texture in system memory. Only the top mip
+                of each array slice is stored
+
+      Args:     const D3D11_TEXTURE2D_DESC* pDesc
+                  Description of the texture
+                const D3D11_SUBRESOURCE_DATA* pInitialData
+                  Optional initial contents, one entry per subresource
+                ID3D11Texture2D** ppTexture2D
+                  Receives the texture
+
+      Modifies: [m_statistics].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT NullDevice::CreateTexture2D(_In_ const D3D11_TEXTURE2D_DESC* pDesc, _In_opt_ const D3D11_SUBRESOURCE_DATA* pInitialData, _Outptr_opt_ ID3D11Texture2D** ppTexture2D)
+    {
+        if (!pDesc || pDesc->Width == 0u || pDesc->Height == 0u)
+        {
+            return E_INVALIDARG;
+        }
+
+        NullTexture2D* pTexture = new NullTexture2D(this, *pDesc);
+        if (pInitialData)
+        {
+            const UINT uRowPitch = pTexture->GetRowPitch();
+            const UINT uMipLevels = std::max(pDesc->MipLevels, 1u);
+            for (UINT uSlice = 0u; uSlice < std::max(pDesc->ArraySize, 1u); ++uSlice)
+            {
+                const D3D11_SUBRESOURCE_DATA& data = pInitialData[uSlice * uMipLevels];
+                if (!data.pSysMem)
+                {
+                    continue;
+                }
+
+                const UINT uSrcPitch = data.SysMemPitch ? data.SysMemPitch : uRowPitch;
+                BYTE* pDst = pTexture->GetData().data() + static_cast<size_t>(uSlice) * uRowPitch * pDesc->Height;
+                for (UINT y = 0u; y < pDesc->Height; ++y)
+                {
+                    memcpy(pDst + static_cast<size_t>(y) * uRowPitch, static_cast<const BYTE*>(data.pSysMem) + static_cast<size_t>(y) * uSrcPitch, std::min(uRowPitch, uSrcPitch));
+                }
+            }
+        }
+
+        ++m_statistics.uNumTextures;
+        m_statistics.uTextureBytes += pTexture->GetData().size();
+
+        return returnObject(pTexture, ppTexture2D);
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullDevice::CreateShaderResourceView
+
+      Summary:  Creates a shader resource view of the resource
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT NullDevice::CreateShaderResourceView(_In_ ID3D11Resource* pResource, _In_opt_ const D3D11_SHADER_RESOURCE_VIEW_DESC* pDesc, _Outptr_opt_ ID3D11ShaderResourceView** ppSRView)
+    {
+        UNREFERENCED_PARAMETER(pDesc);
+
+        if (!pResource)
+        {
+            return E_INVALIDARG;
+        }
+
+        ++m_statistics.uNumViews;
+
+        return returnObject(new NullView<ID3D11ShaderResourceView>(this, pResource), ppSRView);
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullDevice::CreateRenderTargetView
+
+      Summary:  Creates a render target view of the resource
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT NullDevice::CreateRenderTargetView(_In_ ID3D11Resource* pResource, _In_opt_ const D3D11_RENDER_TARGET_VIEW_DESC* pDesc, _Outptr_opt_ ID3D11RenderTargetView** ppRTView)
+    {
+        UNREFERENCED_PARAMETER(pDesc);
+
+        if (!pResource)
+        {
+            return E_INVALIDARG;
+        }
+
+        ++m_statistics.uNumViews;
+
+        return returnObject(new NullView<ID3D11RenderTargetView>(this, pResource), ppRTView);
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullDevice::CreateDepthStencilView
+
+      Summary:  Creates a depth stencil view of the resource
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT NullDevice::CreateDepthStencilView(_In_ ID3D11Resource* pResource, _In_opt_ const D3D11_DEPTH_STENCIL_VIEW_DESC* pDesc, _Outptr_opt_ ID3D11DepthStencilView** ppDepthStencilView)
+    {
+        UNREFERENCED_PARAMETER(pDesc);
+
+        if (!pResource)
+        {
+            return E_INVALIDARG;
+        }
+
+        ++m_statistics.uNumViews;
+
+        return returnObject(new NullView<ID3D11DepthStencilView>(this, pResource), ppDepthStencilView);
+    }
+
+
+    HRESULT NullDevice::CreateInputLayout(_In_reads_(NumElements) const D3D11_INPUT_ELEMENT_DESC* pInputElementDescs, _In_ UINT NumElements, _In_ const void* pShaderBytecodeWithInputSignature, _In_ SIZE_T BytecodeLength, _Outptr_opt_ ID3D11InputLayout** ppInputLayout)
+    {
+        UNREFERENCED_PARAMETER(pShaderBytecodeWithInputSignature);
+        UNREFERENCED_PARAMETER(BytecodeLength);
+
+        if (!pInputElementDescs || NumElements == 0u)
+        {
+            return E_INVALIDARG;
+        }
+
+        return returnObject(new NullState<ID3D11InputLayout>(this), ppInputLayout);
+    }
+
+
+    HRESULT NullDevice::CreateVertexShader(_In_ const void* pShaderBytecode, _In_ SIZE_T BytecodeLength, _In_opt_ ID3D11ClassLinkage* pClassLinkage, _Outptr_opt_ ID3D11VertexShader** ppVertexShader)
+    {
+        UNREFERENCED_PARAMETER(pClassLinkage);
+
+        ++m_statistics.uNumShaders;
+
+        return returnObject(new NullShader<ID3D11VertexShader>(this, pShaderBytecode, BytecodeLength), ppVertexShader);
+    }
+
+
+    HRESULT NullDevice::CreatePixelShader(_In_ const void* pShaderBytecode, _In_ SIZE_T BytecodeLength, _In_opt_ ID3D11ClassLinkage* pClassLinkage, _Outptr_opt_ ID3D11PixelShader** ppPixelShader)
+    {
+        UNREFERENCED_PARAMETER(pClassLinkage);
+
+        ++m_statistics.uNumShaders;
+
+        return returnObject(new NullShader<ID3D11PixelShader>(this, pShaderBytecode, BytecodeLength), ppPixelShader);
+    }
+
+
+    HRESULT NullDevice::CreateSamplerState(_In_ const D3D11_SAMPLER_DESC* pSamplerDesc, _Outptr_opt_ ID3D11SamplerState** ppSamplerState)
+    {
+        if (!pSamplerDesc)
+        {
+            return E_INVALIDARG;
+        }
+
+        return returnObject(new NullSamplerState(this, *pSamplerDesc), ppSamplerState);
+    }
+
+
+    void NullDevice::GetImmediateContext(_Outptr_ ID3D11DeviceContext** ppImmediateContext)
+    {
+        m_pImmediateContext->AddRef();
+        *ppImmediateContext = m_pImmediateContext;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullDevice::GetStatistics
+
+      Summary:  Returns the resource counters
+
+      Returns:  const NullDeviceStatistics&
+                  Number and size of the created resources
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const NullDeviceStatistics& NullDevice::GetStatistics() const
+    {
+        return m_statistics;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullDeviceContext::NullDeviceContext
+
+      Summary:  Constructor
+
+      Args:     NullDevice* pDevice
+                  Owning device. The context shares its reference count
+
+      Modifies: [m_pDevice].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    NullDeviceContext::NullDeviceContext(_In_ NullDevice* pDevice)
+        : m_pDevice(pDevice)
+    {
+    }
+
+
+    ULONG NullDeviceContext::AddRef()
+    {
+        return m_pDevice->AddRef();
+    }
+
+
+    ULONG NullDeviceContext::Release()
+    {
+        return m_pDevice->Release();
+    }
+
+
+    void NullDeviceContext::GetDevice(_Outptr_ ID3D11Device** ppDevice)
+    {
+        m_pDevice->AddRef();
+        *ppDevice = m_pDevice;
+    }
+
+
+    void NullDeviceContext::VSSetConstantBuffers(_In_ UINT, _In_ UINT, _In_reads_opt_(NumBuffers) ID3D11Buffer* const*) {}
+    void NullDeviceContext::PSSetShaderResources(_In_ UINT, _In_ UINT, _In_reads_opt_(NumViews) ID3D11ShaderResourceView* const*) {}
+    void NullDeviceContext::PSSetShader(_In_opt_ ID3D11PixelShader*, _In_reads_opt_(NumClassInstances) ID3D11ClassInstance* const*, UINT) {}
+    void NullDeviceContext::PSSetSamplers(_In_ UINT, _In_ UINT, _In_reads_opt_(NumSamplers) ID3D11SamplerState* const*) {}
+    void NullDeviceContext::VSSetShader(_In_opt_ ID3D11VertexShader*, _In_reads_opt_(NumClassInstances) ID3D11ClassInstance* const*, UINT) {}
+    void NullDeviceContext::DrawIndexed(_In_ UINT, _In_ UINT, _In_ INT) {}
+    void NullDeviceContext::Draw(_In_ UINT, _In_ UINT) {}
+    void NullDeviceContext::PSSetConstantBuffers(_In_ UINT, _In_ UINT, _In_reads_opt_(NumBuffers) ID3D11Buffer* const*) {}
+    void NullDeviceContext::IASetInputLayout(_In_opt_ ID3D11InputLayout*) {}
+    void NullDeviceContext::IASetVertexBuffers(_In_ UINT, _In_ UINT, _In_reads_opt_(NumBuffers) ID3D11Buffer* const*, _In_reads_opt_(NumBuffers) const UINT*, _In_reads_opt_(NumBuffers) const UINT*) {}
+    void NullDeviceContext::IASetIndexBuffer(_In_opt_ ID3D11Buffer*, _In_ DXGI_FORMAT, _In_ UINT) {}
+    void NullDeviceContext::DrawIndexedInstanced(_In_ UINT, _In_ UINT, _In_ UINT, _In_ INT, _In_ UINT) {}
+    void NullDeviceContext::DrawInstanced(_In_ UINT, _In_ UINT, _In_ UINT, _In_ UINT) {}
+    void NullDeviceContext::IASetPrimitiveTopology(_In_ D3D11_PRIMITIVE_TOPOLOGY) {}
+    void NullDeviceContext::OMSetRenderTargets(_In_ UINT, _In_reads_opt_(NumViews) ID3D11RenderTargetView* const*, _In_opt_ ID3D11DepthStencilView*) {}
+    void NullDeviceContext::RSSetViewports(_In_ UINT, _In_reads_opt_(NumViewports) const D3D11_VIEWPORT*) {}
+    void NullDeviceContext::ClearRenderTargetView(_In_ ID3D11RenderTargetView*, _In_ const FLOAT[4]) {}
+    void NullDeviceContext::ClearDepthStencilView(_In_ ID3D11DepthStencilView*, _In_ UINT, _In_ FLOAT, _In_ UINT8) {}
+    void NullDeviceContext::GenerateMips(_In_ ID3D11ShaderResourceView*) {}
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullDeviceContext::Map
+
+      Summary:  Returns a pointer to the system memory of the resource
+
+      Args:     ID3D11Resource* pResource
+                  Buffer or texture created by the null device
+                UINT Subresource
+                  Ignored, the whole resource is mapped
+                D3D11_MAP MapType
+                  Ignored
+                UINT MapFlags
+                  Ignored
+                D3D11_MAPPED_SUBRESOURCE* pMappedResource
+                  Receives the pointer and row pitch
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT NullDeviceContext::Map(_In_ ID3D11Resource* pResource, _In_ UINT Subresource, _In_ D3D11_MAP MapType, _In_ UINT MapFlags, _Out_opt_ D3D11_MAPPED_SUBRESOURCE* pMappedResource)
+    {
+        UNREFERENCED_PARAMETER(Subresource);
+        UNREFERENCED_PARAMETER(MapType);
+        UNREFERENCED_PARAMETER(MapFlags);
+
+        INullResource* pNullResource = dynamic_cast<INullResource*>(pResource);
+        if (!pNullResource)
+        {
+            return E_INVALIDARG;
+        }
+
+        if (pMappedResource)
+        {
+            *pMappedResource =
+            {
+                .pData = pNullResource->GetData().data(),
+                .RowPitch = pNullResource->GetRowPitch(),
+                .DepthPitch = static_cast<UINT>(pNullResource->GetData().size())
+            };
+        }
+
+        return S_OK;
+    }
+
+
+    void NullDeviceContext::Unmap(_In_ ID3D11Resource*, _In_ UINT) {}
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullDeviceContext::UpdateSubresource
+
+      Summary:  Copies the data into the system memory of the resource
+
+      Args:     ID3D11Resource* pDstResource
+                  Buffer or texture created by the null device
+                UINT DstSubresource
+                  Ignored, the top level is updated
+                const D3D11_BOX* pDstBox
+                  Optional byte range for buffers (left, right)
+                const void* pSrcData
+                  Source data
+                UINT SrcRowPitch
+                UINT SrcDepthPitch
+                  Ignored for buffers
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void NullDeviceContext::UpdateSubresource(_In_ ID3D11Resource* pDstResource, _In_ UINT DstSubresource, _In_opt_ const D3D11_BOX* pDstBox, _In_ const void* pSrcData, _In_ UINT SrcRowPitch, _In_ UINT SrcDepthPitch)
+    {
+        UNREFERENCED_PARAMETER(DstSubresource);
+        UNREFERENCED_PARAMETER(SrcRowPitch);
+        UNREFERENCED_PARAMETER(SrcDepthPitch);
+
+        INullResource* pNullResource = dynamic_cast<INullResource*>(pDstResource);
+        if (!pNullResource || !pSrcData)
+        {
+            return;
+        }
+
+        std::vector<BYTE>& aData = pNullResource->GetData();
+        size_t uBegin = 0u;
+        size_t uEnd = aData.size();
+        if (pDstBox)
+        {
+            uBegin = std::min<size_t>(pDstBox->left, aData.size());
+            uEnd = std::min<size_t>(pDstBox->right, aData.size());
+        }
+        if (uEnd > uBegin)
+        {
+            memcpy(aData.data() + uBegin, pSrcData, uEnd - uBegin);
+        }
+    }
+}
+
+namespace library
+{
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: GetNullResourceData
+
+      Summary:  Returns the system memory backing a buffer or texture
+                created by the null device
+
+      Args:     ID3D11Resource* pResource
+                  Resource created by the null device
+                NullResourceData* pData
+                  Receives the memory and its layout
+
+      Returns:  HRESULT
+                  Status code, E_INVALIDARG if the resource was created
+                  by another device
+    -----------------------------------------------------------------F-F*/
+    HRESULT GetNullResourceData(_In_ ID3D11Resource* pResource, _Out_ NullResourceData* pData)
+    {
+        INullResource* pNullResource = dynamic_cast<INullResource*>(pResource);
+        if (!pNullResource || !pData)
+        {
+            return E_INVALIDARG;
+        }
+
+        *pData =
+        {
+            .pData = pNullResource->GetData().data(),
+            .uSize = pNullResource->GetData().size(),
+            .uRowPitch = pNullResource->GetRowPitch(),
+            .uWidth = pNullResource->GetRowPitch(),
+            .uHeight = 1u,
+            .uArraySize = 1u,
+            .Format = DXGI_FORMAT_UNKNOWN,
+            .uMiscFlags = 0u
+        };
+
+        if (ID3D11Texture2D* pTexture = dynamic_cast<ID3D11Texture2D*>(pResource))
+        {
+            D3D11_TEXTURE2D_DESC desc = {};
+            pTexture->GetDesc(&desc);
+
+            pData->uWidth = desc.Width;
+            pData->uHeight = desc.Height;
+            pData->uArraySize = std::max(desc.ArraySize, 1u);
+            pData->Format = desc.Format;
+            pData->uMiscFlags = desc.MiscFlags;
+        }
+
+        return S_OK;
+    }
+
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: GetNullShaderBytecode
+
+      Summary:  Returns the bytecode a vertex or pixel shader of the
+                null device was created from
+
+      Args:     ID3D11DeviceChild* pShader
+                  Shader created by the null device
+                const BYTE** ppBytecode
+                  Receives the bytecode
+                SIZE_T* puBytecodeLength
+                  Receives the size of the bytecode
+
+      Returns:  HRESULT
+                  Status code, E_INVALIDARG if the shader was created
+                  by another device
+    -----------------------------------------------------------------F-F*/
+    HRESULT GetNullShaderBytecode(_In_ ID3D11DeviceChild* pShader, _Outptr_ const BYTE** ppBytecode, _Out_ SIZE_T* puBytecodeLength)
+    {
+        const INullShader* pNullShader = dynamic_cast<const INullShader*>(pShader);
+        if (!pNullShader || !ppBytecode || !puBytecodeLength)
+        {
+            return E_INVALIDARG;
+        }
+
+        *ppBytecode = pNullShader->GetBytecode().data();
+        *puBytecodeLength = pNullShader->GetBytecode().size();
+
+        return S_OK;
+    }
+}
+
+HRESULT D3DCreateBlob(_In_ SIZE_T Size, _Outptr_ ID3DBlob** ppBlob)
+{
+    if (!ppBlob)
+    {
+        return E_INVALIDARG;
+    }
+
+    *ppBlob = new library::NullBlob(Size);
+    return S_OK;
+}
+#endif // !_WIN32
+
+namespace library
+{
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: CreateNullDevice
+
+      Summary:  Creates a device and immediate context that accept every
+                call without a GPU. On Windows this is the Direct3D null
+                reference driver, elsewhere the system memory NullDevice
+
+      Args:     ID3D11Device** ppDevice
+                  Receives the device
+                ID3D11DeviceContext** ppImmediateContext
+                  Receives the immediate context
+
+      Returns:  HRESULT
+                  Status code
+    -----------------------------------------------------------------F-F*/
+    HRESULT CreateNullDevice(_Outptr_ ID3D11Device** ppDevice, _Outptr_ ID3D11DeviceContext** ppImmediateContext)
+    {
+        if (!ppDevice || !ppImmediateContext)
+        {
+            return E_INVALIDARG;
+        }
+
+#if defined(_WIN32)
+        D3D_FEATURE_LEVEL featureLevel = D3D_FEATURE_LEVEL_11_0;
+        return D3D11CreateDevice(nullptr, D3D_DRIVER_TYPE_NULL, nullptr, 0u, &featureLevel, 1u,
+            D3D11_SDK_VERSION, ppDevice, nullptr, ppImmediateContext);
+#else
+        NullDevice* pDevice = new NullDevice();
+        pDevice->GetImmediateContext(ppImmediateContext);
+        *ppDevice = pDevice;
+        return S_OK;
+#endif
+    }
+
+
+#if defined(_WIN32)
+    HRESULT GetNullResourceData(_In_ ID3D11Resource* pResource, _Out_ NullResourceData* pData)
+    {
+        UNREFERENCED_PARAMETER(pResource);
+        UNREFERENCED_PARAMETER(pData);
+
+        // The Direct3D null driver keeps no resource memory
+        return E_NOTIMPL;
+    }
+
+
+    HRESULT GetNullShaderBytecode(_In_ ID3D11DeviceChild* pShader, _Outptr_ const BYTE** ppBytecode, _Out_ SIZE_T* puBytecodeLength)
+    {
+        UNREFERENCED_PARAMETER(pShader);
+        UNREFERENCED_PARAMETER(ppBytecode);
+        UNREFERENCED_PARAMETER(puBytecodeLength);
+
+        return E_NOTIMPL;
+    }
+#endif
+}
@@ -0,0 +1,188 @@
+/*+===================================================================
+  File:      NULLDEVICE.H
+
+  Summary:   NullDevice header file contains declarations of the null
+             Direct3D 11 device used to run the library without a
+             GPU. Resources are kept in system memory so buffer
+             contents written through the device or the immediate
+             context can be read back, while draw and bind calls are
+             accepted and discarded.
+
+  Classes: NullDevice, NullDeviceContext
+
+  Functions: CreateNullDevice, GetNullResourceData,
+             GetNullShaderBytecode
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include <atomic>
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   NullDeviceStatistics
+
+      Summary:  Number and size of the resources created on a null
+                device
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct NullDeviceStatistics
+    {
+        UINT uNumBuffers;
+        UINT uNumTextures;
+        UINT uNumViews;
+        UINT uNumShaders;
+        UINT64 uBufferBytes;
+        UINT64 uTextureBytes;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   NullResourceData
+
+      Summary:  System memory backing a buffer or texture of the null
+                device. Textures store the top mip of each array slice,
+                one slice after the other. Buffers report their byte
+                width, a height and array size of 1 and an unknown
+                format
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct NullResourceData
+    {
+        BYTE* pData;
+        SIZE_T uSize;
+        UINT uRowPitch;
+        UINT uWidth;
+        UINT uHeight;
+        UINT uArraySize;
+        DXGI_FORMAT Format;
+        UINT uMiscFlags;
+    };
+
+    HRESULT CreateNullDevice(_Outptr_ ID3D11Device** ppDevice, _Outptr_ ID3D11DeviceContext** ppImmediateContext);
+    HRESULT GetNullResourceData(_In_ ID3D11Resource* pResource, _Out_ NullResourceData* pData);
+    HRESULT GetNullShaderBytecode(_In_ ID3D11DeviceChild* pShader, _Outptr_ const BYTE** ppBytecode, _Out_ SIZE_T* puBytecodeLength);
+
+#if !defined(_WIN32)
+    class NullDeviceContext;
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    NullDevice
+
+      Summary:  ID3D11Device that allocates every resource in system
+                memory
+
+      Methods:  CreateBuffer
+                  Creates a buffer holding a copy of the initial data
+                CreateTexture2D
+                  Creates a texture holding a copy of the initial data
+                CreateShaderResourceView
+                CreateRenderTargetView
+                CreateDepthStencilView
+                  Create views referencing the given resource
+                CreateInputLayout
+                CreateSamplerState
+                  Create state objects
+                CreateVertexShader
+                CreatePixelShader
+                  Create shaders holding a copy of the bytecode
+                GetImmediateContext
+                  Returns the immediate context of the device
+                GetStatistics
+                  Returns the resource counters
+                NullDevice
+                  Constructor.
+                ~NullDevice
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class NullDevice final : public ID3D11Device
+    {
+    public:
+        NullDevice();
+        NullDevice(const NullDevice& other) = delete;
+        NullDevice(NullDevice&& other) = delete;
+        NullDevice& operator=(const NullDevice& other) = delete;
+        NullDevice& operator=(NullDevice&& other) = delete;
+
+        ULONG AddRef() override;
+        ULONG Release() override;
+
+        HRESULT CreateBuffer(_In_ const D3D11_BUFFER_DESC* pDesc, _In_opt_ const D3D11_SUBRESOURCE_DATA* pInitialData, _Outptr_opt_ ID3D11Buffer** ppBuffer) override;
+        HRESULT CreateTexture2D(_In_ const D3D11_TEXTURE2D_DESC* pDesc, _In_opt_ const D3D11_SUBRESOURCE_DATA* pInitialData, _Outptr_opt_ ID3D11Texture2D** ppTexture2D) override;
+        HRESULT CreateShaderResourceView(_In_ ID3D11Resource* pResource, _In_opt_ const D3D11_SHADER_RESOURCE_VIEW_DESC* pDesc, _Outptr_opt_ ID3D11ShaderResourceView** ppSRView) override;
+        HRESULT CreateRenderTargetView(_In_ ID3D11Resource* pResource, _In_opt_ const D3D11_RENDER_TARGET_VIEW_DESC* pDesc, _Outptr_opt_ ID3D11RenderTargetView** ppRTView) override;
+        HRESULT CreateDepthStencilView(_In_ ID3D11Resource* pResource, _In_opt_ const D3D11_DEPTH_STENCIL_VIEW_DESC* pDesc, _Outptr_opt_ ID3D11DepthStencilView** ppDepthStencilView) override;
+        HRESULT CreateInputLayout(_In_reads_(NumElements) const D3D11_INPUT_ELEMENT_DESC* pInputElementDescs, _In_ UINT NumElements, _In_ const void* pShaderBytecodeWithInputSignature, _In_ SIZE_T BytecodeLength, _Outptr_opt_ ID3D11InputLayout** ppInputLayout) override;
+        HRESULT CreateVertexShader(_In_ const void* pShaderBytecode, _In_ SIZE_T BytecodeLength, _In_opt_ ID3D11ClassLinkage* pClassLinkage, _Outptr_opt_ ID3D11VertexShader** ppVertexShader) override;
+        HRESULT CreatePixelShader(_In_ const void* pShaderBytecode, _In_ SIZE_T BytecodeLength, _In_opt_ ID3D11ClassLinkage* pClassLinkage, _Outptr_opt_ ID3D11PixelShader** ppPixelShader) override;
+        HRESULT CreateSamplerState(_In_ const D3D11_SAMPLER_DESC* pSamplerDesc, _Outptr_opt_ ID3D11SamplerState** ppSamplerState) override;
+        void GetImmediateContext(_Outptr_ ID3D11DeviceContext** ppImmediateContext) override;
+
+        const NullDeviceStatistics& GetStatistics() const;
+
+    private:
+        ~NullDevice() override;
+
+    private:
+        std::atomic<ULONG> m_uRefCount;
+        NullDeviceContext* m_pImmediateContext;
+        NullDeviceStatistics m_statistics;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    NullDeviceContext
+
+      Summary:  ID3D11DeviceContext that writes UpdateSubresource and
+                Map data into the system memory copy of the resource and
+                ignores every other call
+
+      Methods:  UpdateSubresource
+                  Copies the data into the resource
+                Map / Unmap
+                  Exposes the resource memory for writing
+                NullDeviceContext
+                  Constructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class NullDeviceContext final : public ID3D11DeviceContext
+    {
+    public:
+        explicit NullDeviceContext(_In_ NullDevice* pDevice);
+        NullDeviceContext(const NullDeviceContext& other) = delete;
+        NullDeviceContext(NullDeviceContext&& other) = delete;
+        NullDeviceContext& operator=(const NullDeviceContext& other) = delete;
+        NullDeviceContext& operator=(NullDeviceContext&& other) = delete;
+        ~NullDeviceContext() override = default;
+
+        ULONG AddRef() override;
+        ULONG Release() override;
+        void GetDevice(_Outptr_ ID3D11Device** ppDevice) override;
+
+        void VSSetConstantBuffers(_In_ UINT StartSlot, _In_ UINT NumBuffers, _In_reads_opt_(NumBuffers) ID3D11Buffer* const* ppConstantBuffers) override;
+        void PSSetShaderResources(_In_ UINT StartSlot, _In_ UINT NumViews, _In_reads_opt_(NumViews) ID3D11ShaderResourceView* const* ppShaderResourceViews) override;
+        void PSSetShader(_In_opt_ ID3D11PixelShader* pPixelShader, _In_reads_opt_(NumClassInstances) ID3D11ClassInstance* const* ppClassInstances, UINT NumClassInstances) override;
+        void PSSetSamplers(_In_ UINT StartSlot, _In_ UINT NumSamplers, _In_reads_opt_(NumSamplers) ID3D11SamplerState* const* ppSamplers) override;
+        void VSSetShader(_In_opt_ ID3D11VertexShader* pVertexShader, _In_reads_opt_(NumClassInstances) ID3D11ClassInstance* const* ppClassInstances, UINT NumClassInstances) override;
+        void DrawIndexed(_In_ UINT IndexCount, _In_ UINT StartIndexLocation, _In_ INT BaseVertexLocation) override;
+        void Draw(_In_ UINT VertexCount, _In_ UINT StartVertexLocation) override;
+        HRESULT Map(_In_ ID3D11Resource* pResource, _In_ UINT Subresource, _In_ D3D11_MAP MapType, _In_ UINT MapFlags, _Out_opt_ D3D11_MAPPED_SUBRESOURCE* pMappedResource) override;
+        void Unmap(_In_ ID3D11Resource* pResource, _In_ UINT Subresource) override;
+        void PSSetConstantBuffers(_In_ UINT StartSlot, _In_ UINT NumBuffers, _In_reads_opt_(NumBuffers) ID3D11Buffer* const* ppConstantBuffers) override;
+        void IASetInputLayout(_In_opt_ ID3D11InputLayout* pInputLayout) override;
+        void IASetVertexBuffers(_In_ UINT StartSlot, _In_ UINT NumBuffers, _In_reads_opt_(NumBuffers) ID3D11Buffer* const* ppVertexBuffers, _In_reads_opt_(NumBuffers) const UINT* pStrides, _In_reads_opt_(NumBuffers) const UINT* pOffsets) override;
+        void IASetIndexBuffer(_In_opt_ ID3D11Buffer* pIndexBuffer, _In_ DXGI_FORMAT Format, _In_ UINT Offset) override;
+        void DrawIndexedInstanced(_In_ UINT IndexCountPerInstance, _In_ UINT InstanceCount, _In_ UINT StartIndexLocation, _In_ INT BaseVertexLocation, _In_ UINT StartInstanceLocation) override;
+        void DrawInstanced(_In_ UINT VertexCountPerInstance, _In_ UINT InstanceCount, _In_ UINT StartVertexLocation, _In_ UINT StartInstanceLocation) override;
+        void IASetPrimitiveTopology(_In_ D3D11_PRIMITIVE_TOPOLOGY Topology) override;
+        void OMSetRenderTargets(_In_ UINT NumViews, _In_reads_opt_(NumViews) ID3D11RenderTargetView* const* ppRenderTargetViews, _In_opt_ ID3D11DepthStencilView* pDepthStencilView) override;
+        void RSSetViewports(_In_ UINT NumViewports, _In_reads_opt_(NumViewports) const D3D11_VIEWPORT* pViewports) override;
+        void UpdateSubresource(_In_ ID3D11Resource* pDstResource, _In_ UINT DstSubresource, _In_opt_ const D3D11_BOX* pDstBox, _In_ const void* pSrcData, _In_ UINT SrcRowPitch, _In_ UINT SrcDepthPitch) override;
+        void ClearRenderTargetView(_In_ ID3D11RenderTargetView* pRenderTargetView, _In_ const FLOAT ColorRGBA[4]) override;
+        void ClearDepthStencilView(_In_ ID3D11DepthStencilView* pDepthStencilView, _In_ UINT ClearFlags, _In_ FLOAT Depth, _In_ UINT8 Stencil) override;
+        void GenerateMips(_In_ ID3D11ShaderResourceView* pShaderResourceView) override;
+
+    private:
+        NullDevice* m_pDevice;
+    };
+#endif // !_WIN32
+}
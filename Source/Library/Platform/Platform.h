@@ -0,0 +1,239 @@
+/*+===================================================================
+  File:      PLATFORM.H
+
+  Summary:   Platform header file that isolates the operating system
+             and graphics SDK headers from the rest of the library.
+             On Windows it includes the Win32 and Direct3D 11 SDK.
+             Elsewhere it declares the subset of Win32 types, status
+             codes and helpers the library uses, so the CPU
+             subsystems (scene parsing, noise, model import and
+             animation, camera math) build and run headless.
+
+  Functions: OutputDebugStringA, OutputDebugStringW, MessageBoxW,
+             sprintf_s, swprintf_s
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#if defined(_WIN32)
+
+#ifndef  UNICODE
+#define UNICODE
+#endif // ! UNICODE
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif // ! WIN32_LEAN_AND_MEAN
+
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif // ! NOMINMAX
+
+#include <windows.h>
+#include <wincodec.h>
+#include <wrl.h>
+
+#pragma comment(lib, "d3d11.lib")
+#pragma comment(lib, "d3dcompiler.lib")
+#pragma comment(lib, "dxguid.lib")
+
+#include <d3d11_4.h>
+#include <d3dcompiler.h>
+#include <directxcolors.h>
+
+#define _CRTDBG_MAP_ALLOC
+#include <stdlib.h>
+#include <crtdbg.h>
+
+#else // _WIN32
+
+#include <cfloat>
+#include <cmath>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cwchar>
+
+/*--------------------------------------------------------------------
+  SAL annotations are only meaningful to the MSVC code analyzer
+--------------------------------------------------------------------*/
+#ifndef _In_
+#define _In_
+#endif
+#ifndef _In_opt_
+#define _In_opt_
+#endif
+#ifndef _In_z_
+#define _In_z_
+#endif
+#ifndef _In_reads_
+#define _In_reads_(size)
+#endif
+#ifndef _In_reads_bytes_
+#define _In_reads_bytes_(size)
+#endif
+#ifndef _In_reads_opt_
+#define _In_reads_opt_(size)
+#endif
+#ifndef _Out_
+#define _Out_
+#endif
+#ifndef _Out_opt_
+#define _Out_opt_
+#endif
+#ifndef _Out_writes_
+#define _Out_writes_(size)
+#endif
+#ifndef _Out_writes_bytes_
+#define _Out_writes_bytes_(size)
+#endif
+#ifndef _Outptr_
+#define _Outptr_
+#endif
+#ifndef _Outptr_opt_
+#define _Outptr_opt_
+#endif
+#ifndef _Outptr_result_maybenull_
+#define _Outptr_result_maybenull_
+#endif
+#ifndef _Inout_
+#define _Inout_
+#endif
+#ifndef _Inout_opt_
+#define _Inout_opt_
+#endif
+#ifndef _Inout_updates_
+#define _Inout_updates_(size)
+#endif
+#ifndef _Use_decl_annotations_
+#define _Use_decl_annotations_
+#endif
+
+typedef uint8_t BYTE;
+typedef char CHAR;
+typedef wchar_t WCHAR;
+typedef int16_t SHORT;
+typedef uint16_t WORD;
+typedef int32_t INT;
+typedef uint32_t UINT;
+typedef uint8_t UINT8;
+typedef uint16_t UINT16;
+typedef uint32_t UINT32;
+typedef uint64_t UINT64;
+typedef int64_t INT64;
+typedef int32_t LONG;
+typedef uint32_t ULONG;
+typedef uint32_t DWORD;
+typedef int32_t BOOL;
+typedef float FLOAT;
+typedef size_t SIZE_T;
+typedef int32_t HRESULT;
+typedef void* LPVOID;
+typedef const void* LPCVOID;
+typedef const char* PCSTR;
+typedef const char* LPCSTR;
+typedef const wchar_t* PCWSTR;
+typedef const wchar_t* LPCWSTR;
+typedef void* HWND;
+
+#ifndef TRUE
+#define TRUE 1
+#endif
+#ifndef FALSE
+#define FALSE 0
+#endif
+
+#define S_OK                        static_cast<HRESULT>(0x00000000L)
+#define S_FALSE                     static_cast<HRESULT>(0x00000001L)
+#define E_NOTIMPL                   static_cast<HRESULT>(0x80004001L)
+#define E_POINTER                   static_cast<HRESULT>(0x80004003L)
+#define E_FAIL                      static_cast<HRESULT>(0x80004005L)
+#define E_OUTOFMEMORY               static_cast<HRESULT>(0x8007000EL)
+#define E_INVALIDARG                static_cast<HRESULT>(0x80070057L)
+
+#define SUCCEEDED(hr)               (static_cast<HRESULT>(hr) >= 0)
+#define FAILED(hr)                  (static_cast<HRESULT>(hr) < 0)
+
+#ifndef ARRAYSIZE
+#define ARRAYSIZE(a)                (sizeof(a) / sizeof((a)[0]))
+#endif
+#define ZeroMemory(pDest, uLength)  std::memset((pDest), 0, (uLength))
+
+#define MB_OK                       0x00000000L
+
+#define UNREFERENCED_PARAMETER(P)   (void)(P)
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: OutputDebugStringA / OutputDebugStringW
+
+  Summary:  Headless builds have no debugger output window, so the
+            debug strings go to the standard error stream
+
+  Args:     PCSTR / PCWSTR pszOutputString
+              String to be displayed
+-----------------------------------------------------------------F-F*/
+inline void OutputDebugStringA(_In_opt_ PCSTR pszOutputString)
+{
+    if (pszOutputString)
+    {
+        std::fputs(pszOutputString, stderr);
+    }
+}
+
+inline void OutputDebugStringW(_In_opt_ PCWSTR pszOutputString)
+{
+    if (pszOutputString)
+    {
+        std::fprintf(stderr, "%ls", pszOutputString);
+    }
+}
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: MessageBoxW
+
+  Summary:  Headless builds cannot show a dialog; the caption and
+            text are written to the standard error stream instead
+
+  Returns:  INT
+              Always IDOK (1)
+-----------------------------------------------------------------F-F*/
+inline INT MessageBoxW(_In_opt_ HWND, _In_opt_ PCWSTR pszText, _In_opt_ PCWSTR pszCaption, _In_ UINT)
+{
+    std::fprintf(stderr, "[%ls] %ls\n", pszCaption ? pszCaption : L"", pszText ? pszText : L"");
+    return 1;
+}
+
+#define OutputDebugString OutputDebugStringW
+#define MessageBox MessageBoxW
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: sprintf_s / swprintf_s
+
+  Summary:  Array-size deducing overloads matching the secure CRT
+            templates that MSVC provides
+
+  Returns:  INT
+              Number of characters written
+-----------------------------------------------------------------F-F*/
+template <size_t N, typename... Args>
+inline INT sprintf_s(CHAR (&szBuffer)[N], _In_ PCSTR pszFormat, Args... args)
+{
+    return std::snprintf(szBuffer, N, pszFormat, args...);
+}
+
+template <size_t N, typename... Args>
+inline INT swprintf_s(WCHAR (&szBuffer)[N], _In_ PCWSTR pszFormat, Args... args)
+{
+    return std::swprintf(szBuffer, N, pszFormat, args...);
+}
+
+#include <DirectXMath.h>
+#include <DirectXColors.h>
+
+#include "Platform/HeadlessD3D11.h"
+
+#endif // _WIN32
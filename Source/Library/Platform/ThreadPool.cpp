@@ -0,0 +1,178 @@
+#include "Platform/ThreadPool.h"
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ThreadPool::ThreadPool
+
+      Summary:  Constructor. Starts the worker threads
+
+      Args:     UINT uNumThreads
+                  Number of threads working on a loop, including the
+                  calling thread. 0 uses one thread per hardware thread
+
+      Modifies: [m_workers, m_pFunction, m_uCount, m_uNextIndex,
+                  m_uNumBusyWorkers, m_uGeneration, m_bStop].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ThreadPool::ThreadPool(_In_ UINT uNumThreads)
+        : m_workers()
+        , m_mutex()
+        , m_wakeCondition()
+        , m_doneCondition()
+        , m_pFunction(nullptr)
+        , m_uCount(0u)
+        , m_uNextIndex(0u)
+        , m_uNumBusyWorkers(0u)
+        , m_uGeneration(0u)
+        , m_bStop(FALSE)
+    {
+        if (uNumThreads == 0u)
+        {
+            uNumThreads = std::max(std::thread::hardware_concurrency(), 1u);
+        }
+
+        m_workers.reserve(uNumThreads - 1u);
+        for (UINT i = 1u; i < uNumThreads; ++i)
+        {
+            m_workers.emplace_back(&ThreadPool::workerMain, this);
+        }
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ThreadPool::~ThreadPool
+
+      Summary:  Destructor. Stops and joins the worker threads
+
+      Modifies: [m_bStop, m_workers].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_bStop = TRUE;
+        }
+        m_wakeCondition.notify_all();
+
+        for (std::thread& worker : m_workers)
+        {
+            worker.join();
+        }
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ThreadPool::ParallelFor
+
+      Summary:  Calls the function once for every index in [0, uCount)
+                on the pool threads and the calling thread. Indices are
+                handed out one at a time, so each call should carry a
+                reasonable amount of work. Not reentrant
+
+      Args:     UINT uCount
+                  Number of iterations
+                const std::function<void(UINT)>& function
+                  Body of the loop, called with the iteration index
+
+      Modifies: [m_pFunction, m_uCount, m_uNextIndex, m_uNumBusyWorkers,
+                  m_uGeneration].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void ThreadPool::ParallelFor(_In_ UINT uCount, _In_ const std::function<void(UINT)>& function)
+    {
+        if (uCount == 0u)
+        {
+            return;
+        }
+
+        // Not worth waking anybody for a single iteration
+        if (uCount == 1u || m_workers.empty())
+        {
+            for (UINT i = 0u; i < uCount; ++i)
+            {
+                function(i);
+            }
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_pFunction = &function;
+            m_uCount = uCount;
+            m_uNextIndex.store(0u);
+            m_uNumBusyWorkers = static_cast<UINT>(m_workers.size());
+            ++m_uGeneration;
+        }
+        m_wakeCondition.notify_all();
+
+        runIterations();
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_doneCondition.wait(lock, [this] { return m_uNumBusyWorkers == 0u; });
+        m_pFunction = nullptr;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ThreadPool::GetNumThreads
+
+      Summary:  Returns the number of threads working on a loop
+
+      Returns:  UINT
+                  Number of workers plus the calling thread
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT ThreadPool::GetNumThreads() const
+    {
+        return static_cast<UINT>(m_workers.size()) + 1u;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ThreadPool::workerMain
+
+      Summary:  Body of a worker thread. Sleeps until a loop is started
+                or the pool is destroyed
+
+      Modifies: [m_uNumBusyWorkers].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void ThreadPool::workerMain()
+    {
+        UINT64 uSeenGeneration = 0u;
+
+        for (;;)
+        {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_wakeCondition.wait(lock, [this, uSeenGeneration] { return m_bStop || m_uGeneration != uSeenGeneration; });
+                if (m_bStop)
+                {
+                    return;
+                }
+                uSeenGeneration = m_uGeneration;
+            }
+
+            runIterations();
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                --m_uNumBusyWorkers;
+            }
+            m_doneCondition.notify_one();
+        }
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ThreadPool::runIterations
+
+      Summary:  Takes indices of the current loop until none are left
+
+      Modifies: [m_uNextIndex].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void ThreadPool::runIterations()
+    {
+        for (UINT uIndex = m_uNextIndex.fetch_add(1u); uIndex < m_uCount; uIndex = m_uNextIndex.fetch_add(1u))
+        {
+            (*m_pFunction)(uIndex);
+        }
+    }
+}
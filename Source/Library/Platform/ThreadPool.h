@@ -0,0 +1,70 @@
+/*+===================================================================
+  File:      THREADPOOL.H
+
+  Summary:   ThreadPool header file contains declarations of the pool
+             of worker threads the library uses to split frame work
+             across cores.
+
+  Classes: ThreadPool
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    ThreadPool
+
+      Summary:  Fixed set of worker threads that run the iterations of
+                a parallel loop. The calling thread works on the loop
+                too, so a pool of N threads starts N - 1 workers
+
+      Methods:  ParallelFor
+                  Calls the function for every index in [0, uCount)
+                  and returns when all calls have finished
+                GetNumThreads
+                  Returns the number of threads working on a loop
+                ThreadPool
+                  Constructor.
+                ~ThreadPool
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class ThreadPool final
+    {
+    public:
+        explicit ThreadPool(_In_ UINT uNumThreads = 0u);
+        ThreadPool(const ThreadPool& other) = delete;
+        ThreadPool(ThreadPool&& other) = delete;
+        ThreadPool& operator=(const ThreadPool& other) = delete;
+        ThreadPool& operator=(ThreadPool&& other) = delete;
+        ~ThreadPool();
+
+        void ParallelFor(_In_ UINT uCount, _In_ const std::function<void(UINT)>& function);
+        UINT GetNumThreads() const;
+
+    private:
+        void workerMain();
+        void runIterations();
+
+    private:
+        std::vector<std::thread> m_workers;
+        std::mutex m_mutex;
+        std::condition_variable m_wakeCondition;
+        std::condition_variable m_doneCondition;
+        const std::function<void(UINT)>* m_pFunction;
+        UINT m_uCount;
+        std::atomic<UINT> m_uNextIndex;
+        UINT m_uNumBusyWorkers;
+        UINT64 m_uGeneration;
+        BOOL m_bStop;
+    };
+}
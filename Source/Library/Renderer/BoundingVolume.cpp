@@ -0,0 +1,137 @@
+#include "Renderer/BoundingVolume.h"
+
+namespace library
+{
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: ComputeBoundingVolume
+
+      Summary:  Bounds the vertices a range of indices refers to, the
+                way DrawIndexed reads them
+
+      Args:     const SimpleVertex* aVertices
+                  Vertices of the object
+                UINT uBaseVertex
+                  Added to every index
+                const WORD* aIndices
+                  Indices of the object
+                UINT uBaseIndex
+                  First index of the range
+                UINT uNumIndices
+                  Number of indices in the range
+
+      Returns:  BoundingVolume
+                  Box and sphere of the range, empty at the origin if
+                  the range is empty
+    -----------------------------------------------------------------F-F*/
+    BoundingVolume ComputeBoundingVolume(
+        _In_ const SimpleVertex* aVertices,
+        _In_ UINT uBaseVertex,
+        _In_ const WORD* aIndices,
+        _In_ UINT uBaseIndex,
+        _In_ UINT uNumIndices
+    )
+    {
+        if (uNumIndices == 0u)
+        {
+            return BoundingVolume{ .Center = XMFLOAT3(0.0f, 0.0f, 0.0f), .Radius = 0.0f, .Extents = XMFLOAT3(0.0f, 0.0f, 0.0f) };
+        }
+
+        XMVECTOR minimum = XMLoadFloat3(&aVertices[uBaseVertex + aIndices[uBaseIndex]].Position);
+        XMVECTOR maximum = minimum;
+        for (UINT i = 1u; i < uNumIndices; ++i)
+        {
+            XMVECTOR position = XMLoadFloat3(&aVertices[uBaseVertex + aIndices[uBaseIndex + i]].Position);
+            minimum = XMVectorMin(minimum, position);
+            maximum = XMVectorMax(maximum, position);
+        }
+
+        XMVECTOR center = XMVectorScale(XMVectorAdd(minimum, maximum), 0.5f);
+
+        // The sphere around the box center is usually smaller than the
+        // one through the box corners
+        FLOAT radiusSquared = 0.0f;
+        for (UINT i = 0u; i < uNumIndices; ++i)
+        {
+            XMVECTOR position = XMLoadFloat3(&aVertices[uBaseVertex + aIndices[uBaseIndex + i]].Position);
+            radiusSquared = std::max(radiusSquared, XMVectorGetX(XMVector3LengthSq(XMVectorSubtract(position, center))));
+        }
+
+        BoundingVolume bounds;
+        XMStoreFloat3(&bounds.Center, center);
+        XMStoreFloat3(&bounds.Extents, XMVectorSubtract(maximum, center));
+        bounds.Radius = sqrtf(radiusSquared);
+
+        return bounds;
+    }
+
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: TransformBoundingVolume
+
+      Summary:  Bounds a volume moved by an affine transform. The box
+                grows to hold the rotated box, and the radius is scaled
+                by the largest scale of the transform
+
+      Args:     const BoundingVolume& bounds
+                  Volume to transform
+                const XMMATRIX& transform
+                  Row vector transform, like a world matrix
+
+      Returns:  BoundingVolume
+                  The transformed volume
+    -----------------------------------------------------------------F-F*/
+    BoundingVolume TransformBoundingVolume(_In_ const BoundingVolume& bounds, _In_ const XMMATRIX& transform)
+    {
+        XMVECTOR center = XMVector3Transform(XMLoadFloat3(&bounds.Center), transform);
+
+        XMVECTOR extents = XMVectorMultiply(XMVectorSplatX(XMLoadFloat3(&bounds.Extents)), XMVectorAbs(transform.r[0]));
+        extents = XMVectorMultiplyAdd(XMVectorSplatY(XMLoadFloat3(&bounds.Extents)), XMVectorAbs(transform.r[1]), extents);
+        extents = XMVectorMultiplyAdd(XMVectorSplatZ(XMLoadFloat3(&bounds.Extents)), XMVectorAbs(transform.r[2]), extents);
+
+        FLOAT scaleSquared = std::max(
+            XMVectorGetX(XMVector3LengthSq(transform.r[0])),
+            std::max(XMVectorGetX(XMVector3LengthSq(transform.r[1])), XMVectorGetX(XMVector3LengthSq(transform.r[2])))
+        );
+
+        BoundingVolume transformed;
+        XMStoreFloat3(&transformed.Center, center);
+        XMStoreFloat3(&transformed.Extents, extents);
+        transformed.Radius = bounds.Radius * sqrtf(scaleSquared);
+
+        return transformed;
+    }
+
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: MergeBoundingVolumes
+
+      Summary:  Bounds two volumes. The sphere is centered on the merged
+                box and reaches the far side of both spheres
+
+      Args:     const BoundingVolume& first
+                const BoundingVolume& second
+                  Volumes to merge
+
+      Returns:  BoundingVolume
+                  Volume holding both
+    -----------------------------------------------------------------F-F*/
+    BoundingVolume MergeBoundingVolumes(_In_ const BoundingVolume& first, _In_ const BoundingVolume& second)
+    {
+        XMVECTOR firstCenter = XMLoadFloat3(&first.Center);
+        XMVECTOR secondCenter = XMLoadFloat3(&second.Center);
+
+        XMVECTOR minimum = XMVectorMin(XMVectorSubtract(firstCenter, XMLoadFloat3(&first.Extents)), XMVectorSubtract(secondCenter, XMLoadFloat3(&second.Extents)));
+        XMVECTOR maximum = XMVectorMax(XMVectorAdd(firstCenter, XMLoadFloat3(&first.Extents)), XMVectorAdd(secondCenter, XMLoadFloat3(&second.Extents)));
+        XMVECTOR center = XMVectorScale(XMVectorAdd(minimum, maximum), 0.5f);
+
+        BoundingVolume merged;
+        XMStoreFloat3(&merged.Center, center);
+        XMStoreFloat3(&merged.Extents, XMVectorSubtract(maximum, center));
+        merged.Radius = std::max(
+            XMVectorGetX(XMVector3Length(XMVectorSubtract(firstCenter, center))) + first.Radius,
+            XMVectorGetX(XMVector3Length(XMVectorSubtract(secondCenter, center))) + second.Radius
+        );
+
+        return merged;
+    }
+}
@@ -0,0 +1,44 @@
+/*+===================================================================
+  File:      BOUNDINGVOLUME.H
+
+  Summary:   BoundingVolume header file contains declarations of the
+             axis-aligned box and sphere that bound a mesh, computed
+             once at load and tested against the view frustum every
+             frame.
+
+  Classes: BoundingVolume
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Renderer/DataTypes.h"
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   BoundingVolume
+
+      Summary:  Axis-aligned box given by its center and half extents,
+                and the sphere around the same center. Either one alone
+                bounds the geometry, so a test may use the tighter one
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct BoundingVolume
+    {
+        XMFLOAT3 Center;
+        FLOAT Radius;
+        XMFLOAT3 Extents;
+    };
+
+    BoundingVolume ComputeBoundingVolume(
+        _In_ const SimpleVertex* aVertices,
+        _In_ UINT uBaseVertex,
+        _In_ const WORD* aIndices,
+        _In_ UINT uBaseIndex,
+        _In_ UINT uNumIndices
+    );
+    BoundingVolume TransformBoundingVolume(_In_ const BoundingVolume& bounds, _In_ const XMMATRIX& transform);
+    BoundingVolume MergeBoundingVolumes(_In_ const BoundingVolume& first, _In_ const BoundingVolume& second);
+}
@@ -0,0 +1,356 @@
+#include "Renderer/ConstantBufferRing.h"
+
+namespace library
+{
+    namespace
+    {
+        UINT alignUp(_In_ UINT uValue, _In_ UINT uAlignment)
+        {
+            return (uValue + uAlignment - 1u) / uAlignment * uAlignment;
+        }
+
+        HRESULT createDynamicConstantBuffer(_In_ ID3D11Device* pDevice, _In_ UINT uSize, _Outptr_ ID3D11Buffer** ppBuffer)
+        {
+            D3D11_BUFFER_DESC bd =
+            {
+                .ByteWidth = uSize,
+                .Usage = D3D11_USAGE_DYNAMIC,
+                .BindFlags = D3D11_BIND_CONSTANT_BUFFER,
+                .CPUAccessFlags = D3D11_CPU_ACCESS_WRITE
+            };
+
+            return pDevice->CreateBuffer(&bd, nullptr, ppBuffer);
+        }
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ConstantBufferRing::ConstantBufferRing
+
+      Summary:  Constructor of a ring of CONSTANT_BUFFER_RING_SIZE bytes
+
+      Modifies: [m_device, m_buffer, m_staging, m_uSize, m_uHead,
+                  m_uFrameStart, m_uPendingStart, m_uPendingTailEnd,
+                  m_bFrameWrapped, m_bPendingWrapped, m_bUseOffsets,
+                  m_pools, m_poolUsage, m_pendingPoolWrites,
+                  m_uNumPendingPoolWrites, m_frameStatistics].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ConstantBufferRing::ConstantBufferRing()
+        : ConstantBufferRing(CONSTANT_BUFFER_RING_SIZE)
+    {
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ConstantBufferRing::ConstantBufferRing
+
+      Summary:  Constructor
+
+      Args:     UINT uSize
+                  Size of the ring in bytes, rounded up to a multiple of
+                  CONSTANT_BUFFER_RANGE_ALIGNMENT
+
+      Modifies: [m_device, m_buffer, m_staging, m_uSize, m_uHead,
+                  m_uFrameStart, m_uPendingStart, m_uPendingTailEnd,
+                  m_bFrameWrapped, m_bPendingWrapped, m_bUseOffsets,
+                  m_pools, m_poolUsage, m_pendingPoolWrites,
+                  m_uNumPendingPoolWrites, m_frameStatistics].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ConstantBufferRing::ConstantBufferRing(_In_ UINT uSize)
+        : m_device()
+        , m_buffer()
+        , m_staging()
+        , m_uSize(alignUp(std::max(uSize, CONSTANT_BUFFER_RANGE_ALIGNMENT), CONSTANT_BUFFER_RANGE_ALIGNMENT))
+        , m_uHead(0u)
+        , m_uFrameStart(0u)
+        , m_uPendingStart(0u)
+        , m_uPendingTailEnd(0u)
+        , m_bFrameWrapped(FALSE)
+        , m_bPendingWrapped(FALSE)
+        , m_bUseOffsets(FALSE)
+        , m_pools()
+        , m_poolUsage()
+        , m_pendingPoolWrites()
+        , m_uNumPendingPoolWrites(0u)
+        , m_frameStatistics()
+    {
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ConstantBufferRing::Initialize
+
+      Summary:  Keeps the device the ring and the fallback buffers are
+                created on. The ring is created at the first frame whose
+                backend binds from offsets
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device
+
+      Modifies: [m_device, m_buffer, m_pools].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void ConstantBufferRing::Initialize(_In_ ID3D11Device* pDevice)
+    {
+        m_device = pDevice;
+        m_buffer.Reset();
+        m_pools.clear();
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ConstantBufferRing::BeginFrame
+
+      Summary:  Starts the allocations of a frame. Buffers allocated in
+                the last frame must not be bound anymore
+
+      Args:     RenderBackend& backend
+                  Backend the frame is submitted through
+
+      Modifies: [m_buffer, m_staging, m_uFrameStart, m_uPendingStart,
+                  m_bFrameWrapped, m_bPendingWrapped, m_bUseOffsets,
+                  m_poolUsage, m_uNumPendingPoolWrites,
+                  m_frameStatistics].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void ConstantBufferRing::BeginFrame(_In_ RenderBackend& backend)
+    {
+        m_bUseOffsets = FALSE;
+        if (backend.SupportsConstantBufferOffsets() && m_device)
+        {
+            if (!m_buffer && SUCCEEDED(createDynamicConstantBuffer(m_device.Get(), m_uSize, m_buffer.ReleaseAndGetAddressOf())))
+            {
+                m_staging.resize(m_uSize);
+                m_uHead = 0u;
+            }
+            m_bUseOffsets = m_buffer != nullptr;
+        }
+
+        m_uFrameStart = m_uHead;
+        m_uPendingStart = m_uHead;
+        m_bFrameWrapped = FALSE;
+        m_bPendingWrapped = FALSE;
+
+        m_poolUsage.clear();
+        m_uNumPendingPoolWrites = 0u;
+        m_frameStatistics = {};
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ConstantBufferRing::Allocate
+
+      Summary:  Copies constants into the next range of the ring. The
+                range is only valid on the GPU after the next Flush and
+                until the end of the frame
+
+      Args:     const void* pData
+                  Constants of one draw
+                UINT uDataSize
+                  Size of the constants in bytes
+
+      Modifies: [m_staging, m_uHead, m_uPendingTailEnd, m_bFrameWrapped,
+                  m_bPendingWrapped, m_frameStatistics].
+
+      Returns:  ConstantBufferAllocation
+                  Range to bind, with a null buffer if no buffer could
+                  be created
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ConstantBufferAllocation ConstantBufferRing::Allocate(_In_reads_bytes_(uDataSize) const void* pData, _In_ UINT uDataSize)
+    {
+        ++m_frameStatistics.uNumAllocations;
+
+        const UINT uAlignedSize = alignUp(uDataSize, CONSTANT_BUFFER_RANGE_ALIGNMENT);
+        if (!m_bUseOffsets || uAlignedSize > m_uSize)
+        {
+            return allocateFromPool(pData, uDataSize);
+        }
+
+        // The ranges of this frame lie from m_uFrameStart to m_uHead,
+        // wrapping around the end of the ring at most once
+        UINT uOffset = m_uHead;
+        if (!m_bFrameWrapped)
+        {
+            if (m_uHead + uAlignedSize > m_uSize)
+            {
+                if (uAlignedSize > m_uFrameStart)
+                {
+                    return allocateFromPool(pData, uDataSize);
+                }
+
+                m_bFrameWrapped = TRUE;
+                m_bPendingWrapped = TRUE;
+                m_uPendingTailEnd = m_uHead;
+                uOffset = 0u;
+            }
+        }
+        else if (m_uHead + uAlignedSize > m_uFrameStart)
+        {
+            return allocateFromPool(pData, uDataSize);
+        }
+
+        memcpy(m_staging.data() + uOffset, pData, uDataSize);
+        m_uHead = uOffset + uAlignedSize;
+
+        return ConstantBufferAllocation
+        {
+            .pBuffer = m_buffer.Get(),
+            .uFirstConstant = uOffset / 16u,
+            .uNumConstants = uAlignedSize / 16u
+        };
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ConstantBufferRing::Flush
+
+      Summary:  Uploads the constants allocated since the last flush.
+                The ring is written with one map, or two when it wrapped:
+                the start with discard, then the tail behind the
+                renamed buffer. Each fallback buffer is mapped once
+
+      Args:     RenderBackend& backend
+                  Backend the frame is submitted through
+
+      Modifies: [m_uPendingStart, m_bPendingWrapped,
+                  m_uNumPendingPoolWrites, m_frameStatistics].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void ConstantBufferRing::Flush(_In_ RenderBackend& backend)
+    {
+        if (m_bPendingWrapped)
+        {
+            upload(backend, m_buffer.Get(), 0u, m_staging.data(), m_uHead, TRUE);
+            upload(backend, m_buffer.Get(), m_uPendingStart, m_staging.data() + m_uPendingStart, m_uPendingTailEnd - m_uPendingStart, FALSE);
+        }
+        else
+        {
+            upload(backend, m_buffer.Get(), m_uPendingStart, m_staging.data() + m_uPendingStart, m_uHead - m_uPendingStart, m_uPendingStart == 0u);
+        }
+        m_uPendingStart = m_uHead;
+        m_bPendingWrapped = FALSE;
+
+        for (UINT i = 0u; i < m_uNumPendingPoolWrites; ++i)
+        {
+            const std::vector<BYTE>& data = m_pendingPoolWrites[i].second;
+            upload(backend, m_pendingPoolWrites[i].first, 0u, data.data(), static_cast<UINT>(data.size()), TRUE);
+        }
+        m_uNumPendingPoolWrites = 0u;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ConstantBufferRing::GetFrameStatistics
+
+      Summary:  Returns the statistics of the frame so far
+
+      Returns:  const ConstantBufferRingStatistics&
+                  Allocations, maps and uploaded bytes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const ConstantBufferRingStatistics& ConstantBufferRing::GetFrameStatistics() const
+    {
+        return m_frameStatistics;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ConstantBufferRing::ReportStatistics
+
+      Summary:  Writes the statistics of the frame to the debug output
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void ConstantBufferRing::ReportStatistics() const
+    {
+        WCHAR szMessage[256];
+        swprintf_s(
+            szMessage,
+            L"constant buffers  allocations %u  fallback %u  maps %u  uploaded %llu bytes\n",
+            m_frameStatistics.uNumAllocations,
+            m_frameStatistics.uNumFallbackAllocations,
+            m_frameStatistics.uNumMaps,
+            static_cast<unsigned long long>(m_frameStatistics.uUploadBytes)
+        );
+        OutputDebugString(szMessage);
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ConstantBufferRing::allocateFromPool
+
+      Summary:  Takes a dynamic buffer of the rounded size that is not
+                used yet this frame, creating one if needed, and queues
+                the constants to be written into it at Flush
+
+      Args:     const void* pData
+                  Constants of one draw
+                UINT uDataSize
+                  Size of the constants in bytes
+
+      Modifies: [m_pools, m_poolUsage, m_pendingPoolWrites,
+                  m_uNumPendingPoolWrites, m_frameStatistics].
+
+      Returns:  ConstantBufferAllocation
+                  The whole buffer, or a null buffer if it could not be
+                  created
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ConstantBufferAllocation ConstantBufferRing::allocateFromPool(_In_reads_bytes_(uDataSize) const void* pData, _In_ UINT uDataSize)
+    {
+        ++m_frameStatistics.uNumFallbackAllocations;
+
+        const UINT uAlignedSize = alignUp(uDataSize, 16u);
+        std::vector<ComPtr<ID3D11Buffer>>& pool = m_pools[uAlignedSize];
+        UINT& uNumUsed = m_poolUsage[uAlignedSize];
+        if (uNumUsed == pool.size())
+        {
+            ComPtr<ID3D11Buffer> buffer;
+            if (!m_device || FAILED(createDynamicConstantBuffer(m_device.Get(), uAlignedSize, buffer.GetAddressOf())))
+            {
+                return ConstantBufferAllocation{};
+            }
+            pool.push_back(buffer);
+        }
+        ID3D11Buffer* pBuffer = pool[uNumUsed++].Get();
+
+        if (m_uNumPendingPoolWrites == m_pendingPoolWrites.size())
+        {
+            m_pendingPoolWrites.emplace_back();
+        }
+        std::pair<ID3D11Buffer*, std::vector<BYTE>>& write = m_pendingPoolWrites[m_uNumPendingPoolWrites++];
+        write.first = pBuffer;
+        write.second.assign(static_cast<const BYTE*>(pData), static_cast<const BYTE*>(pData) + uDataSize);
+
+        return ConstantBufferAllocation
+        {
+            .pBuffer = pBuffer,
+            .uFirstConstant = 0u,
+            .uNumConstants = uAlignedSize / 16u
+        };
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ConstantBufferRing::upload
+
+      Summary:  Maps a range of a buffer and counts it, skipping empty
+                ranges
+
+      Args:     RenderBackend& backend
+                  Backend the frame is submitted through
+                ID3D11Buffer* pBuffer
+                UINT uOffset
+                const BYTE* pData
+                UINT uDataSize
+                BOOL bDiscard
+                  Arguments of WriteDynamicBuffer
+
+      Modifies: [m_frameStatistics].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void ConstantBufferRing::upload(_In_ RenderBackend& backend, _In_ ID3D11Buffer* pBuffer, _In_ UINT uOffset, _In_reads_bytes_(uDataSize) const BYTE* pData, _In_ UINT uDataSize, _In_ BOOL bDiscard)
+    {
+        if (!pBuffer || uDataSize == 0u)
+        {
+            return;
+        }
+
+        backend.WriteDynamicBuffer(pBuffer, uOffset, pData, uDataSize, bDiscard);
+
+        ++m_frameStatistics.uNumMaps;
+        m_frameStatistics.uUploadBytes += uDataSize;
+    }
+}
@@ -0,0 +1,134 @@
+/*+===================================================================
+  File:      CONSTANTBUFFERRING.H
+
+  Summary:   ConstantBufferRing header file contains declarations of
+             the frame scoped allocator per-draw constants are written
+             into, so a frame uploads them in a few large maps instead
+             of one copy per object.
+
+  Classes: ConstantBufferAllocation, ConstantBufferRingStatistics,
+           ConstantBufferRing
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include <map>
+
+#include "Renderer/RenderBackend.h"
+
+namespace library
+{
+    constexpr UINT CONSTANT_BUFFER_RING_SIZE = 4u * 1024u * 1024u;
+
+    // Offsets and sizes of bound ranges are multiples of 16 constants
+    constexpr UINT CONSTANT_BUFFER_RANGE_ALIGNMENT = 256u;
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   ConstantBufferAllocation
+
+      Summary:  Range of constants allocated for one draw, in 16-byte
+                constants as SetVSConstantBufferRanges takes them
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct ConstantBufferAllocation
+    {
+        ID3D11Buffer* pBuffer;
+        UINT uFirstConstant;
+        UINT uNumConstants;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   ConstantBufferRingStatistics
+
+      Summary:  Allocations of the last frame, the allocations that did
+                not fit in the ring or could not be bound from offsets,
+                the maps issued to upload them and the bytes uploaded
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct ConstantBufferRingStatistics
+    {
+        UINT uNumAllocations;
+        UINT uNumFallbackAllocations;
+        UINT uNumMaps;
+        UINT64 uUploadBytes;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    ConstantBufferRing
+
+      Summary:  Per-draw constants are copied linearly into a system
+                memory mirror of one large dynamic constant buffer and
+                bound from offsets. Flush uploads everything allocated
+                since the last flush with one non-overwriting map, or a
+                discarding one when the ring wraps, so it must be called
+                after the allocations of a pass and before its draws.
+                The ring should hold several frames, so the GPU is done
+                with a range before it is written again. When the
+                backend cannot bind from offsets, or a frame outgrows
+                the ring, allocations fall back to a pool of small
+                dynamic buffers that are each mapped with discard once
+                per frame, still batched at Flush
+
+      Methods:  Initialize
+                  Keeps the device the buffers are created on
+                BeginFrame
+                  Starts the allocations of a frame
+                Allocate
+                  Copies constants into the frame
+                Flush
+                  Uploads the pending allocations
+                GetFrameStatistics
+                  Returns the statistics of the frame
+                ReportStatistics
+                  Writes the statistics of the frame to the debug
+                  output
+                ConstantBufferRing
+                  Constructor.
+                ~ConstantBufferRing
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class ConstantBufferRing
+    {
+    public:
+        ConstantBufferRing();
+        explicit ConstantBufferRing(_In_ UINT uSize);
+        ConstantBufferRing(const ConstantBufferRing& other) = delete;
+        ConstantBufferRing(ConstantBufferRing&& other) = delete;
+        ConstantBufferRing& operator=(const ConstantBufferRing& other) = delete;
+        ConstantBufferRing& operator=(ConstantBufferRing&& other) = delete;
+        ~ConstantBufferRing() = default;
+
+        void Initialize(_In_ ID3D11Device* pDevice);
+        void BeginFrame(_In_ RenderBackend& backend);
+        ConstantBufferAllocation Allocate(_In_reads_bytes_(uDataSize) const void* pData, _In_ UINT uDataSize);
+        void Flush(_In_ RenderBackend& backend);
+
+        const ConstantBufferRingStatistics& GetFrameStatistics() const;
+        void ReportStatistics() const;
+
+    private:
+        ConstantBufferAllocation allocateFromPool(_In_reads_bytes_(uDataSize) const void* pData, _In_ UINT uDataSize);
+        void upload(_In_ RenderBackend& backend, _In_ ID3D11Buffer* pBuffer, _In_ UINT uOffset, _In_reads_bytes_(uDataSize) const BYTE* pData, _In_ UINT uDataSize, _In_ BOOL bDiscard);
+
+    private:
+        ComPtr<ID3D11Device> m_device;
+        ComPtr<ID3D11Buffer> m_buffer;
+        std::vector<BYTE> m_staging;
+        UINT m_uSize;
+        UINT m_uHead;
+        UINT m_uFrameStart;
+        UINT m_uPendingStart;
+        UINT m_uPendingTailEnd;
+        BOOL m_bFrameWrapped;
+        BOOL m_bPendingWrapped;
+        BOOL m_bUseOffsets;
+
+        std::map<UINT, std::vector<ComPtr<ID3D11Buffer>>> m_pools;
+        std::map<UINT, UINT> m_poolUsage;
+        std::vector<std::pair<ID3D11Buffer*, std::vector<BYTE>>> m_pendingPoolWrites;
+        UINT m_uNumPendingPoolWrites;
+
+        ConstantBufferRingStatistics m_frameStatistics;
+    };
+}
@@ -0,0 +1,522 @@
+#include "Renderer/D3D11RenderBackend.h"
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderBackend::D3D11RenderBackend
+
+      Summary:  Constructor. Checks whether the context can bind
+                constant buffers from offsets
+
+      Args:     ID3D11DeviceContext* pImmediateContext
+                  The Direct3D context to send the commands to
+
+      Modifies: [m_immediateContext, m_immediateContext1,
+                  m_bConstantBufferOffsets].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    D3D11RenderBackend::D3D11RenderBackend(_In_ ID3D11DeviceContext* pImmediateContext)
+        : m_immediateContext(pImmediateContext)
+#if defined(_WIN32)
+        , m_immediateContext1()
+#endif
+        , m_bConstantBufferOffsets(FALSE)
+    {
+#if defined(_WIN32)
+        if (SUCCEEDED(m_immediateContext.As(&m_immediateContext1)))
+        {
+            ComPtr<ID3D11Device> device;
+            m_immediateContext->GetDevice(device.GetAddressOf());
+
+            D3D11_FEATURE_DATA_D3D11_OPTIONS options = {};
+            if (SUCCEEDED(device->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &options, sizeof(options))))
+            {
+                m_bConstantBufferOffsets = options.ConstantBufferOffsetting && options.MapNoOverwriteOnDynamicConstantBuffer;
+            }
+        }
+#endif
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderBackend::GetDeviceContext
+
+      Summary:  Returns the device context commands are sent to
+
+      Returns:  ComPtr<ID3D11DeviceContext>&
+                  The Direct3D context
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ComPtr<ID3D11DeviceContext>& D3D11RenderBackend::GetDeviceContext()
+    {
+        return m_immediateContext;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderBackend::BeginFrame
+
+      Summary:  Does nothing, Direct3D needs no frame boundaries
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderBackend::BeginFrame()
+    {
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderBackend::EndFrame
+
+      Summary:  Does nothing, the swap chain presents the frame
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderBackend::EndFrame()
+    {
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderBackend::BeginPass
+
+      Summary:  Does nothing, passes are only named for other backends
+
+      Args:     PCWSTR pszPassName
+                  Name of the pass
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderBackend::BeginPass(_In_ PCWSTR pszPassName)
+    {
+        UNREFERENCED_PARAMETER(pszPassName);
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderBackend::EndPass
+
+      Summary:  Does nothing
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderBackend::EndPass()
+    {
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderBackend::SetRenderTargets
+
+      Summary:  Binds the render targets and depth stencil to the
+                output merger
+
+      Args:     UINT uNumViews
+                  Number of render target views
+                ID3D11RenderTargetView* const* ppRenderTargetViews
+                  Render target views
+                ID3D11DepthStencilView* pDepthStencilView
+                  Depth stencil view
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderBackend::SetRenderTargets(_In_ UINT uNumViews, _In_reads_opt_(uNumViews) ID3D11RenderTargetView* const* ppRenderTargetViews, _In_opt_ ID3D11DepthStencilView* pDepthStencilView)
+    {
+        m_immediateContext->OMSetRenderTargets(uNumViews, ppRenderTargetViews, pDepthStencilView);
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderBackend::SetViewports
+
+      Summary:  Sets the viewports of the rasterizer
+
+      Args:     UINT uNumViewports
+                  Number of viewports
+                const D3D11_VIEWPORT* pViewports
+                  Viewports
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderBackend::SetViewports(_In_ UINT uNumViewports, _In_reads_(uNumViewports) const D3D11_VIEWPORT* pViewports)
+    {
+        m_immediateContext->RSSetViewports(uNumViewports, pViewports);
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderBackend::ClearRenderTargetView
+
+      Summary:  Clears a render target to a color
+
+      Args:     ID3D11RenderTargetView* pRenderTargetView
+                  Render target to clear
+                const FLOAT aColorRGBA[4]
+                  Clear color
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderBackend::ClearRenderTargetView(_In_ ID3D11RenderTargetView* pRenderTargetView, _In_ const FLOAT aColorRGBA[4])
+    {
+        m_immediateContext->ClearRenderTargetView(pRenderTargetView, aColorRGBA);
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderBackend::ClearDepthStencilView
+
+      Summary:  Clears the depth and stencil of a depth stencil view
+
+      Args:     ID3D11DepthStencilView* pDepthStencilView
+                  Depth stencil to clear
+                UINT uClearFlags
+                  D3D11_CLEAR_DEPTH, D3D11_CLEAR_STENCIL or both
+                FLOAT depth
+                  Depth to clear to
+                UINT8 stencil
+                  Stencil to clear to
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderBackend::ClearDepthStencilView(_In_ ID3D11DepthStencilView* pDepthStencilView, _In_ UINT uClearFlags, _In_ FLOAT depth, _In_ UINT8 stencil)
+    {
+        m_immediateContext->ClearDepthStencilView(pDepthStencilView, uClearFlags, depth, stencil);
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderBackend::UpdateBuffer
+
+      Summary:  Replaces the whole contents of a default usage buffer
+                with UpdateSubresource. The size is implied by the buffer
+
+      Args:     ID3D11Buffer* pBuffer
+                  Buffer to update
+                const void* pData
+                  New contents
+                UINT uDataSize
+                  Size of the new contents in bytes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderBackend::UpdateBuffer(_In_ ID3D11Buffer* pBuffer, _In_reads_bytes_(uDataSize) const void* pData, _In_ UINT uDataSize)
+    {
+        UNREFERENCED_PARAMETER(uDataSize);
+
+        m_immediateContext->UpdateSubresource(pBuffer, 0u, nullptr, pData, 0u, 0u);
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderBackend::WriteDynamicBuffer
+
+      Summary:  Maps a dynamic buffer and copies bytes to an offset
+                in it. Maps with D3D11_MAP_WRITE_DISCARD when bDiscard
+                is set, which hands back fresh memory so the first write
+                of a frame never waits for the GPU, and with
+                D3D11_MAP_WRITE_NO_OVERWRITE otherwise, for appending
+                after earlier writes the GPU may still be reading. The
+                caller must not write over a range it already used since
+                the last discard. If the map fails the write is dropped
+
+      Args:     ID3D11Buffer* pBuffer
+                  Dynamic buffer with CPU write access
+                UINT uOffset
+                  Byte offset to write to
+                const void* pData
+                  Bytes to write
+                UINT uDataSize
+                  Number of bytes to write
+                BOOL bDiscard
+                  Whether to discard the previous contents
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderBackend::WriteDynamicBuffer(_In_ ID3D11Buffer* pBuffer, _In_ UINT uOffset, _In_reads_bytes_(uDataSize) const void* pData, _In_ UINT uDataSize, _In_ BOOL bDiscard)
+    {
+        D3D11_MAPPED_SUBRESOURCE mappedResource = {};
+        if (SUCCEEDED(m_immediateContext->Map(pBuffer, 0u, bDiscard ? D3D11_MAP_WRITE_DISCARD : D3D11_MAP_WRITE_NO_OVERWRITE, 0u, &mappedResource)))
+        {
+            memcpy(static_cast<BYTE*>(mappedResource.pData) + uOffset, pData, uDataSize);
+            m_immediateContext->Unmap(pBuffer, 0u);
+        }
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderBackend::SupportsConstantBufferOffsets
+
+      Summary:  Returns whether SetVSConstantBufferRanges and
+                SetPSConstantBufferRanges bind the given ranges
+
+      Returns:  BOOL
+                  TRUE on Windows if the context is an
+                  ID3D11DeviceContext1 and the device supports constant
+                  buffer offsetting and no overwrite maps of dynamic
+                  constant buffers
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL D3D11RenderBackend::SupportsConstantBufferOffsets() const
+    {
+        return m_bConstantBufferOffsets;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderBackend::SetVertexBuffers
+
+      Summary:  Binds vertex buffers to the input assembler
+
+      Args:     UINT uStartSlot
+                  First slot to bind
+                UINT uNumBuffers
+                  Number of buffers
+                ID3D11Buffer* const* ppVertexBuffers
+                  Vertex buffers
+                const UINT* puStrides
+                  Stride of each buffer
+                const UINT* puOffsets
+                  Byte offset into each buffer
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderBackend::SetVertexBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppVertexBuffers, _In_reads_opt_(uNumBuffers) const UINT* puStrides, _In_reads_opt_(uNumBuffers) const UINT* puOffsets)
+    {
+        m_immediateContext->IASetVertexBuffers(uStartSlot, uNumBuffers, ppVertexBuffers, puStrides, puOffsets);
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderBackend::SetIndexBuffer
+
+      Summary:  Binds the index buffer to the input assembler
+
+      Args:     ID3D11Buffer* pIndexBuffer
+                  Index buffer
+                DXGI_FORMAT format
+                  Format of the indices
+                UINT uOffset
+                  Byte offset of the first index
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderBackend::SetIndexBuffer(_In_opt_ ID3D11Buffer* pIndexBuffer, _In_ DXGI_FORMAT format, _In_ UINT uOffset)
+    {
+        m_immediateContext->IASetIndexBuffer(pIndexBuffer, format, uOffset);
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderBackend::SetInputLayout
+
+      Summary:  Binds the input layout to the input assembler
+
+      Args:     ID3D11InputLayout* pInputLayout
+                  Input layout
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderBackend::SetInputLayout(_In_opt_ ID3D11InputLayout* pInputLayout)
+    {
+        m_immediateContext->IASetInputLayout(pInputLayout);
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderBackend::SetPrimitiveTopology
+
+      Summary:  Sets the primitive topology of the input assembler
+
+      Args:     D3D11_PRIMITIVE_TOPOLOGY topology
+                  Primitive topology
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderBackend::SetPrimitiveTopology(_In_ D3D11_PRIMITIVE_TOPOLOGY topology)
+    {
+        m_immediateContext->IASetPrimitiveTopology(topology);
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderBackend::SetVertexShader
+
+      Summary:  Binds the vertex shader, without class instances
+
+      Args:     ID3D11VertexShader* pVertexShader
+                  Vertex shader
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderBackend::SetVertexShader(_In_opt_ ID3D11VertexShader* pVertexShader)
+    {
+        m_immediateContext->VSSetShader(pVertexShader, nullptr, 0u);
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderBackend::SetVSConstantBuffers
+
+      Summary:  Binds whole constant buffers to the vertex shader
+
+      Args:     UINT uStartSlot
+                  First slot to bind
+                UINT uNumBuffers
+                  Number of buffers
+                ID3D11Buffer* const* ppConstantBuffers
+                  Constant buffers
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderBackend::SetVSConstantBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers)
+    {
+        m_immediateContext->VSSetConstantBuffers(uStartSlot, uNumBuffers, ppConstantBuffers);
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderBackend::SetVSConstantBufferRanges
+
+      Summary:  Binds ranges of constant buffers to the vertex
+                shader with VSSetConstantBuffers1 when
+                SupportsConstantBufferOffsets is TRUE. Otherwise binds
+                the buffers whole, which is only right for ranges that
+                start at the beginning of their buffer
+
+      Args:     UINT uStartSlot
+                  First slot to bind
+                UINT uNumBuffers
+                  Number of buffers
+                ID3D11Buffer* const* ppConstantBuffers
+                  Constant buffers
+                const UINT* puFirstConstants
+                  First 16 byte constant of each range, a multiple of 16
+                const UINT* puNumConstants
+                  Number of 16 byte constants of each range, a multiple
+                  of 16
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderBackend::SetVSConstantBufferRanges(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers, _In_reads_(uNumBuffers) const UINT* puFirstConstants, _In_reads_(uNumBuffers) const UINT* puNumConstants)
+    {
+#if defined(_WIN32)
+        if (m_bConstantBufferOffsets)
+        {
+            m_immediateContext1->VSSetConstantBuffers1(uStartSlot, uNumBuffers, ppConstantBuffers, puFirstConstants, puNumConstants);
+            return;
+        }
+#endif
+        // Without offsetting only ranges that start at the beginning of
+        // the buffer can be bound, and they are bound whole
+        UNREFERENCED_PARAMETER(puFirstConstants);
+        UNREFERENCED_PARAMETER(puNumConstants);
+
+        m_immediateContext->VSSetConstantBuffers(uStartSlot, uNumBuffers, ppConstantBuffers);
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderBackend::SetPixelShader
+
+      Summary:  Binds the pixel shader, without class instances
+
+      Args:     ID3D11PixelShader* pPixelShader
+                  Pixel shader
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderBackend::SetPixelShader(_In_opt_ ID3D11PixelShader* pPixelShader)
+    {
+        m_immediateContext->PSSetShader(pPixelShader, nullptr, 0u);
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderBackend::SetPSConstantBuffers
+
+      Summary:  Binds whole constant buffers to the pixel shader
+
+      Args:     UINT uStartSlot
+                  First slot to bind
+                UINT uNumBuffers
+                  Number of buffers
+                ID3D11Buffer* const* ppConstantBuffers
+                  Constant buffers
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderBackend::SetPSConstantBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers)
+    {
+        m_immediateContext->PSSetConstantBuffers(uStartSlot, uNumBuffers, ppConstantBuffers);
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderBackend::SetPSConstantBufferRanges
+
+      Summary:  Binds ranges of constant buffers to the pixel shader
+                with PSSetConstantBuffers1 when
+                SupportsConstantBufferOffsets is TRUE. Otherwise binds
+                the buffers whole, as SetVSConstantBufferRanges does
+
+      Args:     UINT uStartSlot
+                  First slot to bind
+                UINT uNumBuffers
+                  Number of buffers
+                ID3D11Buffer* const* ppConstantBuffers
+                  Constant buffers
+                const UINT* puFirstConstants
+                  First 16 byte constant of each range
+                const UINT* puNumConstants
+                  Number of 16 byte constants of each range
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderBackend::SetPSConstantBufferRanges(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers, _In_reads_(uNumBuffers) const UINT* puFirstConstants, _In_reads_(uNumBuffers) const UINT* puNumConstants)
+    {
+#if defined(_WIN32)
+        if (m_bConstantBufferOffsets)
+        {
+            m_immediateContext1->PSSetConstantBuffers1(uStartSlot, uNumBuffers, ppConstantBuffers, puFirstConstants, puNumConstants);
+            return;
+        }
+#endif
+        UNREFERENCED_PARAMETER(puFirstConstants);
+        UNREFERENCED_PARAMETER(puNumConstants);
+
+        m_immediateContext->PSSetConstantBuffers(uStartSlot, uNumBuffers, ppConstantBuffers);
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderBackend::SetPSShaderResources
+
+      Summary:  Binds shader resource views to the pixel shader
+
+      Args:     UINT uStartSlot
+                  First slot to bind
+                UINT uNumViews
+                  Number of views
+                ID3D11ShaderResourceView* const* ppShaderResourceViews
+                  Shader resource views
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderBackend::SetPSShaderResources(_In_ UINT uStartSlot, _In_ UINT uNumViews, _In_reads_opt_(uNumViews) ID3D11ShaderResourceView* const* ppShaderResourceViews)
+    {
+        m_immediateContext->PSSetShaderResources(uStartSlot, uNumViews, ppShaderResourceViews);
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderBackend::SetPSSamplers
+
+      Summary:  Binds sampler states to the pixel shader
+
+      Args:     UINT uStartSlot
+                  First slot to bind
+                UINT uNumSamplers
+                  Number of samplers
+                ID3D11SamplerState* const* ppSamplers
+                  Sampler states
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderBackend::SetPSSamplers(_In_ UINT uStartSlot, _In_ UINT uNumSamplers, _In_reads_opt_(uNumSamplers) ID3D11SamplerState* const* ppSamplers)
+    {
+        m_immediateContext->PSSetSamplers(uStartSlot, uNumSamplers, ppSamplers);
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderBackend::DrawIndexed
+
+      Summary:  Draws indexed primitives
+
+      Args:     UINT uIndexCount
+                  Number of indices
+                UINT uStartIndexLocation
+                  First index
+                INT nBaseVertexLocation
+                  Value added to each index
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderBackend::DrawIndexed(_In_ UINT uIndexCount, _In_ UINT uStartIndexLocation, _In_ INT nBaseVertexLocation)
+    {
+        m_immediateContext->DrawIndexed(uIndexCount, uStartIndexLocation, nBaseVertexLocation);
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderBackend::DrawIndexedInstanced
+
+      Summary:  Draws instances of indexed primitives
+
+      Args:     UINT uIndexCountPerInstance
+                  Number of indices of each instance
+                UINT uInstanceCount
+                  Number of instances
+                UINT uStartIndexLocation
+                  First index
+                INT nBaseVertexLocation
+                  Value added to each index
+                UINT uStartInstanceLocation
+                  Value added to each instance index
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderBackend::DrawIndexedInstanced(_In_ UINT uIndexCountPerInstance, _In_ UINT uInstanceCount, _In_ UINT uStartIndexLocation, _In_ INT nBaseVertexLocation, _In_ UINT uStartInstanceLocation)
+    {
+        m_immediateContext->DrawIndexedInstanced(uIndexCountPerInstance, uInstanceCount, uStartIndexLocation, nBaseVertexLocation, uStartInstanceLocation);
+    }
+}
@@ -0,0 +1,87 @@
+/*+===================================================================
+  File:      D3D11RENDERBACKEND.H
+
+  Summary:   D3D11RenderBackend header file contains declarations of
+             the RenderBackend that forwards every command to a
+             Direct3D 11 device context.
+
+  Classes: D3D11RenderBackend
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Renderer/RenderBackend.h"
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    D3D11RenderBackend
+
+      Summary:  RenderBackend implementation on top of an
+                ID3D11DeviceContext. Constant buffers are bound from
+                offsets through ID3D11DeviceContext1 when the driver
+                supports constant buffer offsetting and non-overwriting
+                maps of dynamic constant buffers
+
+      Methods:  GetDeviceContext
+                  Returns the device context commands are sent to
+                D3D11RenderBackend
+                  Constructor.
+                ~D3D11RenderBackend
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class D3D11RenderBackend final : public RenderBackend
+    {
+    public:
+        D3D11RenderBackend() = delete;
+        explicit D3D11RenderBackend(_In_ ID3D11DeviceContext* pImmediateContext);
+        D3D11RenderBackend(const D3D11RenderBackend& other) = delete;
+        D3D11RenderBackend(D3D11RenderBackend&& other) = delete;
+        D3D11RenderBackend& operator=(const D3D11RenderBackend& other) = delete;
+        D3D11RenderBackend& operator=(D3D11RenderBackend&& other) = delete;
+        ~D3D11RenderBackend() override = default;
+
+        ComPtr<ID3D11DeviceContext>& GetDeviceContext();
+
+        void BeginFrame() override;
+        void EndFrame() override;
+        void BeginPass(_In_ PCWSTR pszPassName) override;
+        void EndPass() override;
+
+        void SetRenderTargets(_In_ UINT uNumViews, _In_reads_opt_(uNumViews) ID3D11RenderTargetView* const* ppRenderTargetViews, _In_opt_ ID3D11DepthStencilView* pDepthStencilView) override;
+        void SetViewports(_In_ UINT uNumViewports, _In_reads_(uNumViewports) const D3D11_VIEWPORT* pViewports) override;
+        void ClearRenderTargetView(_In_ ID3D11RenderTargetView* pRenderTargetView, _In_ const FLOAT aColorRGBA[4]) override;
+        void ClearDepthStencilView(_In_ ID3D11DepthStencilView* pDepthStencilView, _In_ UINT uClearFlags, _In_ FLOAT depth, _In_ UINT8 stencil) override;
+
+        void UpdateBuffer(_In_ ID3D11Buffer* pBuffer, _In_reads_bytes_(uDataSize) const void* pData, _In_ UINT uDataSize) override;
+        void WriteDynamicBuffer(_In_ ID3D11Buffer* pBuffer, _In_ UINT uOffset, _In_reads_bytes_(uDataSize) const void* pData, _In_ UINT uDataSize, _In_ BOOL bDiscard) override;
+        BOOL SupportsConstantBufferOffsets() const override;
+
+        void SetVertexBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppVertexBuffers, _In_reads_opt_(uNumBuffers) const UINT* puStrides, _In_reads_opt_(uNumBuffers) const UINT* puOffsets) override;
+        void SetIndexBuffer(_In_opt_ ID3D11Buffer* pIndexBuffer, _In_ DXGI_FORMAT format, _In_ UINT uOffset) override;
+        void SetInputLayout(_In_opt_ ID3D11InputLayout* pInputLayout) override;
+        void SetPrimitiveTopology(_In_ D3D11_PRIMITIVE_TOPOLOGY topology) override;
+
+        void SetVertexShader(_In_opt_ ID3D11VertexShader* pVertexShader) override;
+        void SetVSConstantBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers) override;
+        void SetVSConstantBufferRanges(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers, _In_reads_(uNumBuffers) const UINT* puFirstConstants, _In_reads_(uNumBuffers) const UINT* puNumConstants) override;
+        void SetPixelShader(_In_opt_ ID3D11PixelShader* pPixelShader) override;
+        void SetPSConstantBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers) override;
+        void SetPSConstantBufferRanges(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers, _In_reads_(uNumBuffers) const UINT* puFirstConstants, _In_reads_(uNumBuffers) const UINT* puNumConstants) override;
+        void SetPSShaderResources(_In_ UINT uStartSlot, _In_ UINT uNumViews, _In_reads_opt_(uNumViews) ID3D11ShaderResourceView* const* ppShaderResourceViews) override;
+        void SetPSSamplers(_In_ UINT uStartSlot, _In_ UINT uNumSamplers, _In_reads_opt_(uNumSamplers) ID3D11SamplerState* const* ppSamplers) override;
+
+        void DrawIndexed(_In_ UINT uIndexCount, _In_ UINT uStartIndexLocation, _In_ INT nBaseVertexLocation) override;
+        void DrawIndexedInstanced(_In_ UINT uIndexCountPerInstance, _In_ UINT uInstanceCount, _In_ UINT uStartIndexLocation, _In_ INT nBaseVertexLocation, _In_ UINT uStartInstanceLocation) override;
+
+    private:
+        ComPtr<ID3D11DeviceContext> m_immediateContext;
+#if defined(_WIN32)
+        ComPtr<ID3D11DeviceContext1> m_immediateContext1;
+#endif
+        BOOL m_bConstantBufferOffsets;
+    };
+}
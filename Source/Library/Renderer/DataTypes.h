@@ -7,6 +7,7 @@ namespace library
 #define NUM_LIGHTS (1)
 #define MAX_NUM_BONES (256)
 #define MAX_NUM_BONES_PER_VERTEX (16)
+#define INSTANCE_CELL_SIZE (2.0f)
 
     struct SimpleVertex
     {
@@ -15,11 +16,44 @@ namespace library
         XMFLOAT3 Normal;
     };
 
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   InstanceData
+
+      Summary:  Packed voxel instance, the grid cell of the cube as
+                16-bit integers and its block type, 8 bytes in place of
+                a 64-byte matrix. The vertex shaders move the cube by
+                INSTANCE_CELL_SIZE per cell, and the world matrix of the
+                voxel places the grid
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
     struct InstanceData
     {
-        XMMATRIX Transformation;
+        SHORT anCell[3];
+        SHORT nBlockType;
     };
 
+    static_assert(sizeof(InstanceData) == 8u);
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: GetInstanceTransform
+
+      Summary:  Returns the translation the vertex shaders decode an
+                instance into
+
+      Args:     const InstanceData& instance
+                  Instance to decode
+
+      Returns:  XMMATRIX
+                  Translation to the cell of the instance
+    -----------------------------------------------------------------F-F*/
+    inline XMMATRIX GetInstanceTransform(_In_ const InstanceData& instance)
+    {
+        return XMMatrixTranslation(
+            INSTANCE_CELL_SIZE * static_cast<FLOAT>(instance.anCell[0]),
+            INSTANCE_CELL_SIZE * static_cast<FLOAT>(instance.anCell[1]),
+            INSTANCE_CELL_SIZE * static_cast<FLOAT>(instance.anCell[2])
+        );
+    }
+
     struct AnimationData
     {
         XMUINT4 aBoneIndices;
@@ -0,0 +1,282 @@
+#include "Renderer/DrawList.h"
+
+namespace library
+{
+    namespace
+    {
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: getId
+
+          Summary:  Returns the number of a pair of objects, numbering it
+                    if it is new. Numbers are never taken back during a
+                    frame, so draws already in the list keep theirs
+
+          Args:     std::map<std::pair<const void*, const void*>, UINT>& ids
+                      Numbers given so far
+                    const void* pFirst
+                    const void* pSecond
+                      The pair
+
+          Returns:  UINT
+                      Number of the pair
+        -----------------------------------------------------------------F-F*/
+        UINT getId(_Inout_ std::map<std::pair<const void*, const void*>, UINT>& ids, _In_opt_ const void* pFirst, _In_opt_ const void* pSecond)
+        {
+            auto found = ids.find(std::make_pair(pFirst, pSecond));
+            if (found != ids.end())
+            {
+                return found->second;
+            }
+
+            UINT uId = static_cast<UINT>(ids.size());
+            ids.emplace(std::make_pair(pFirst, pSecond), uId);
+
+            return uId;
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: resetIdsIfNearlyFull
+
+          Summary:  Forgets the numbers of every pair once they fill half
+                    of their key field, so the next frame has the other
+                    half to number new pairs in before they wrap. This
+                    also drops the pairs of objects released since the
+                    last reset, whose addresses a new object may reuse
+
+          Args:     std::map<std::pair<const void*, const void*>, UINT>& ids
+                      Numbers given so far
+                    UINT uNumBits
+                      Width of the key field
+        -----------------------------------------------------------------F-F*/
+        void resetIdsIfNearlyFull(_Inout_ std::map<std::pair<const void*, const void*>, UINT>& ids, _In_ UINT uNumBits)
+        {
+            if (ids.size() >= (static_cast<SIZE_T>(1u) << (uNumBits - 1u)))
+            {
+                ids.clear();
+            }
+        }
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DrawList::DrawList
+
+      Summary:  Constructor
+
+      Modifies: [m_items, m_entries, m_scratch, m_programIds,
+                  m_materialIds].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    DrawList::DrawList()
+        : m_items()
+        , m_entries()
+        , m_scratch()
+        , m_programIds()
+        , m_materialIds()
+    {
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DrawList::Clear
+
+      Summary:  Removes the draws at the start of a frame. Program and
+                material numbers are kept, unless so many have been
+                given that they are renumbered from zero. That is only
+                done here, before any key of the frame holds them
+
+      Modifies: [m_items, m_entries, m_programIds, m_materialIds].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void DrawList::Clear()
+    {
+        m_items.clear();
+        m_entries.clear();
+
+        resetIdsIfNearlyFull(m_programIds, NUM_PROGRAM_BITS);
+        resetIdsIfNearlyFull(m_materialIds, NUM_MATERIAL_BITS);
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DrawList::Add
+
+      Summary:  Adds a draw
+
+      Args:     UINT64 uKey
+                  Sort key made with MakeSortKey
+                const DrawItem& item
+                  The draw
+
+      Modifies: [m_items, m_entries].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void DrawList::Add(_In_ UINT64 uKey, _In_ const DrawItem& item)
+    {
+        m_entries.push_back(DrawSortEntry{ .uKey = uKey, .uItem = static_cast<UINT>(m_items.size()) });
+        m_items.push_back(item);
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DrawList::Sort
+
+      Summary:  Sorts the draws by key with a least significant digit
+                radix sort over the eight bytes of the keys. The sort is
+                stable, so draws with equal keys keep the order they
+                were added in. Bytes that are the same in every key,
+                like the unused low bits, are skipped
+
+      Modifies: [m_entries, m_scratch].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void DrawList::Sort()
+    {
+        constexpr UINT NUM_BYTES = sizeof(UINT64);
+        constexpr UINT NUM_BUCKETS = 256u;
+
+        const SIZE_T uNumEntries = m_entries.size();
+        if (uNumEntries < 2u)
+        {
+            return;
+        }
+
+        // Count every byte of every key in one sweep
+        UINT aauCounts[NUM_BYTES][NUM_BUCKETS] = {};
+        for (const DrawSortEntry& entry : m_entries)
+        {
+            for (UINT uByte = 0u; uByte < NUM_BYTES; ++uByte)
+            {
+                ++aauCounts[uByte][(entry.uKey >> (8u * uByte)) & 0xFFu];
+            }
+        }
+
+        m_scratch.resize(uNumEntries);
+        for (UINT uByte = 0u; uByte < NUM_BYTES; ++uByte)
+        {
+            UINT* auCounts = aauCounts[uByte];
+            if (auCounts[(m_entries[0].uKey >> (8u * uByte)) & 0xFFu] == uNumEntries)
+            {
+                continue;
+            }
+
+            UINT uOffset = 0u;
+            for (UINT uBucket = 0u; uBucket < NUM_BUCKETS; ++uBucket)
+            {
+                UINT uCount = auCounts[uBucket];
+                auCounts[uBucket] = uOffset;
+                uOffset += uCount;
+            }
+
+            for (const DrawSortEntry& entry : m_entries)
+            {
+                m_scratch[auCounts[(entry.uKey >> (8u * uByte)) & 0xFFu]++] = entry;
+            }
+            m_entries.swap(m_scratch);
+        }
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DrawList::GetNumDraws
+
+      Summary:  Returns the number of draws
+
+      Returns:  UINT
+                  Number of draws
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT DrawList::GetNumDraws() const
+    {
+        return static_cast<UINT>(m_entries.size());
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DrawList::GetDraw
+
+      Summary:  Returns a draw in key order once the list is sorted
+
+      Args:     UINT uIndex
+                  Position of the draw
+
+      Returns:  const DrawItem&
+                  The draw
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const DrawItem& DrawList::GetDraw(_In_ UINT uIndex) const
+    {
+        return m_items[m_entries[uIndex].uItem];
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DrawList::GetProgramId
+
+      Summary:  Returns the number of a vertex and pixel shader pair
+
+      Args:     ID3D11VertexShader* pVertexShader
+                ID3D11PixelShader* pPixelShader
+                  Shaders of a draw
+
+      Modifies: [m_programIds].
+
+      Returns:  UINT
+                  Number of the pair
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT DrawList::GetProgramId(_In_opt_ ID3D11VertexShader* pVertexShader, _In_opt_ ID3D11PixelShader* pPixelShader)
+    {
+        return getId(m_programIds, pVertexShader, pPixelShader);
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DrawList::GetMaterialId
+
+      Summary:  Returns the number of a diffuse and normal texture pair
+
+      Args:     ID3D11ShaderResourceView* pDiffuse
+                ID3D11ShaderResourceView* pNormal
+                  Textures of a draw, nullptr if the material has none
+
+      Modifies: [m_materialIds].
+
+      Returns:  UINT
+                  Number of the pair
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT DrawList::GetMaterialId(_In_opt_ ID3D11ShaderResourceView* pDiffuse, _In_opt_ ID3D11ShaderResourceView* pNormal)
+    {
+        return getId(m_materialIds, pDiffuse, pNormal);
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DrawList::MakeSortKey
+
+      Summary:  Packs the fields of a sort key. The low bits below the
+                depth are left zero
+
+      Args:     eDrawPass pass
+                  Bucket of the draw
+                UINT uProgram
+                  Number from GetProgramId
+                UINT uMaterial
+                  Number from GetMaterialId
+                FLOAT normalizedDepth
+                  View depth divided by the far plane, clamped to [0, 1]
+
+      Returns:  UINT64
+                  The sort key
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT64 DrawList::MakeSortKey(_In_ eDrawPass pass, _In_ UINT uProgram, _In_ UINT uMaterial, _In_ FLOAT normalizedDepth)
+    {
+        constexpr UINT DEPTH_SHIFT = 64u - NUM_PASS_BITS - NUM_PROGRAM_BITS - NUM_MATERIAL_BITS - NUM_DEPTH_BITS;
+        constexpr UINT MATERIAL_SHIFT = DEPTH_SHIFT + NUM_DEPTH_BITS;
+        constexpr UINT PROGRAM_SHIFT = MATERIAL_SHIFT + NUM_MATERIAL_BITS;
+        constexpr UINT PASS_SHIFT = PROGRAM_SHIFT + NUM_PROGRAM_BITS;
+        constexpr UINT MAX_DEPTH = (1u << NUM_DEPTH_BITS) - 1u;
+
+        // NaN compares false and lands at the front
+        FLOAT clampedDepth = normalizedDepth > 0.0f ? std::min(normalizedDepth, 1.0f) : 0.0f;
+        UINT64 uDepth = static_cast<UINT64>(clampedDepth * static_cast<FLOAT>(MAX_DEPTH));
+
+        return (static_cast<UINT64>(pass) << PASS_SHIFT)
+            | (static_cast<UINT64>(uProgram & ((1u << NUM_PROGRAM_BITS) - 1u)) << PROGRAM_SHIFT)
+            | (static_cast<UINT64>(uMaterial & ((1u << NUM_MATERIAL_BITS) - 1u)) << MATERIAL_SHIFT)
+            | (std::min(uDepth, static_cast<UINT64>(MAX_DEPTH)) << DEPTH_SHIFT);
+    }
+}
@@ -0,0 +1,152 @@
+/*+===================================================================
+  File:      DRAWLIST.H
+
+  Summary:   DrawList header file contains declarations of the list of
+             draws of a render pass, ordered by 64-bit sort keys so the
+             pass switches shaders and materials as rarely as possible
+             and draws opaque geometry front to back.
+
+  Classes: DrawItem, DrawSortEntry, DrawList
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include <map>
+
+#include "Renderer/ConstantBufferRing.h"
+#include "Renderer/Renderable.h"
+
+namespace library
+{
+    /*E+E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E
+      Enum:     eDrawPass
+
+      Summary:  Bucket of the main pass a draw belongs to, in the order
+                the buckets are drawn
+    E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E-E*/
+    enum class eDrawPass : UINT
+    {
+        OPAQUE_GEOMETRY,
+        SKY,
+        COUNT,
+    };
+
+    /*E+E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E
+      Enum:     eDrawSource
+
+      Summary:  Kind of object a draw comes from, which decides the
+                vertex buffers and constant buffers it binds
+    E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E-E*/
+    enum class eDrawSource : UINT
+    {
+        RENDERABLE,
+        VOXEL,
+        MODEL,
+        SKYBOX,
+        COUNT,
+    };
+
+    // Mesh index of a draw that covers every index of an untextured object
+    constexpr UINT DRAW_WHOLE_RENDERABLE = UINT_MAX;
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   DrawItem
+
+      Summary:  One BasicMeshEntry of an object, or the whole object if
+                it has no textures, with the constants of the object and
+                the skinning constants of a model
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct DrawItem
+    {
+        Renderable* pRenderable;
+        eDrawSource Source;
+        UINT uMesh;
+        ConstantBufferAllocation Constants;
+        ConstantBufferAllocation Skinning;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   DrawSortEntry
+
+      Summary:  Sort key of a draw and the index of its item
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct DrawSortEntry
+    {
+        UINT64 uKey;
+        UINT uItem;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    DrawList
+
+      Summary:  Draws of a pass with their sort keys. From the most to
+                the least significant bits a key holds the pass bucket,
+                the shader program, the material and the view depth
+                quantized to 24 bits, so draws are grouped by state and
+                front to back inside a group. Programs and materials are
+                numbered in the order they are first seen, and keep
+                their numbers across frames so the order is stable.
+                Once the numbers fill half of their field, Clear
+                renumbers them at the start of the next frame
+
+      Methods:  Clear
+                  Removes the draws, keeping the program and material
+                  numbers unless they are nearly full
+                Add
+                  Adds a draw with its key
+                Sort
+                  Radix sorts the draws by key
+                GetNumDraws
+                  Returns the number of draws
+                GetDraw
+                  Returns a draw in sorted order
+                GetProgramId
+                  Returns the number of a shader pair
+                GetMaterialId
+                  Returns the number of a texture pair
+                MakeSortKey
+                  Packs the fields of a sort key
+                DrawList
+                  Constructor.
+                ~DrawList
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class DrawList
+    {
+    public:
+        static constexpr UINT NUM_PASS_BITS = 2u;
+        static constexpr UINT NUM_PROGRAM_BITS = 12u;
+        static constexpr UINT NUM_MATERIAL_BITS = 16u;
+        static constexpr UINT NUM_DEPTH_BITS = 24u;
+
+    public:
+        DrawList();
+        DrawList(const DrawList& other) = delete;
+        DrawList(DrawList&& other) = delete;
+        DrawList& operator=(const DrawList& other) = delete;
+        DrawList& operator=(DrawList&& other) = delete;
+        ~DrawList() = default;
+
+        void Clear();
+        void Add(_In_ UINT64 uKey, _In_ const DrawItem& item);
+        void Sort();
+
+        UINT GetNumDraws() const;
+        const DrawItem& GetDraw(_In_ UINT uIndex) const;
+
+        UINT GetProgramId(_In_opt_ ID3D11VertexShader* pVertexShader, _In_opt_ ID3D11PixelShader* pPixelShader);
+        UINT GetMaterialId(_In_opt_ ID3D11ShaderResourceView* pDiffuse, _In_opt_ ID3D11ShaderResourceView* pNormal);
+
+        static UINT64 MakeSortKey(_In_ eDrawPass pass, _In_ UINT uProgram, _In_ UINT uMaterial, _In_ FLOAT normalizedDepth);
+
+    private:
+        std::vector<DrawItem> m_items;
+        std::vector<DrawSortEntry> m_entries;
+        std::vector<DrawSortEntry> m_scratch;
+        std::map<std::pair<const void*, const void*>, UINT> m_programIds;
+        std::map<std::pair<const void*, const void*>, UINT> m_materialIds;
+    };
+}
@@ -0,0 +1,405 @@
+#include "Renderer/FrustumCuller.h"
+
+namespace library
+{
+    namespace
+    {
+        constexpr UINT CULL_GROUP_SIZE = 4u;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   FrustumCuller::FrustumCuller
+
+      Summary:  Constructor
+
+      Modifies: [m_aPlanes, m_aCenterX, m_aCenterY, m_aCenterZ,
+                  m_aExtentX, m_aExtentY, m_aExtentZ, m_aRadius,
+                  m_uNumBounds, m_aVisible, m_aVisibleList,
+                  m_aaChunkVisibleLists].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FrustumCuller::FrustumCuller()
+        : m_aPlanes()
+        , m_aCenterX()
+        , m_aCenterY()
+        , m_aCenterZ()
+        , m_aExtentX()
+        , m_aExtentY()
+        , m_aExtentZ()
+        , m_aRadius()
+        , m_uNumBounds(0u)
+        , m_aVisible()
+        , m_aVisibleList()
+        , m_aaChunkVisibleLists()
+    {
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   FrustumCuller::SetFrustum
+
+      Summary:  Extracts the left, right, bottom, top, near and far
+                planes from the columns of a view projection matrix.
+                The normals point into the frustum and are normalized,
+                so a plane gives the distance of a point to it
+
+      Args:     const XMMATRIX& viewProjection
+                  View matrix times projection matrix, with the depth
+                  range from 0 to 1 of Direct3D
+
+      Modifies: [m_aPlanes].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void FrustumCuller::SetFrustum(_In_ const XMMATRIX& viewProjection)
+    {
+        const XMMATRIX columns = XMMatrixTranspose(viewProjection);
+
+        XMStoreFloat4(&m_aPlanes[0], XMPlaneNormalize(XMVectorAdd(columns.r[3], columns.r[0])));
+        XMStoreFloat4(&m_aPlanes[1], XMPlaneNormalize(XMVectorSubtract(columns.r[3], columns.r[0])));
+        XMStoreFloat4(&m_aPlanes[2], XMPlaneNormalize(XMVectorAdd(columns.r[3], columns.r[1])));
+        XMStoreFloat4(&m_aPlanes[3], XMPlaneNormalize(XMVectorSubtract(columns.r[3], columns.r[1])));
+        XMStoreFloat4(&m_aPlanes[4], XMPlaneNormalize(columns.r[2]));
+        XMStoreFloat4(&m_aPlanes[5], XMPlaneNormalize(XMVectorSubtract(columns.r[3], columns.r[2])));
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   FrustumCuller::Clear
+
+      Summary:  Removes the volumes and the result of the last cull
+
+      Modifies: [m_aCenterX, m_aCenterY, m_aCenterZ, m_aExtentX,
+                  m_aExtentY, m_aExtentZ, m_aRadius, m_uNumBounds,
+                  m_aVisible, m_aVisibleList].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void FrustumCuller::Clear()
+    {
+        m_aCenterX.clear();
+        m_aCenterY.clear();
+        m_aCenterZ.clear();
+        m_aExtentX.clear();
+        m_aExtentY.clear();
+        m_aExtentZ.clear();
+        m_aRadius.clear();
+        m_uNumBounds = 0u;
+
+        m_aVisible.clear();
+        m_aVisibleList.clear();
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   FrustumCuller::AddBounds
+
+      Summary:  Adds a volume moved by a transform. The arrays grow a
+                group of four at a time, so the lanes past the last
+                volume hold empty volumes at the origin that Cull tests
+                along with the rest and ignores
+
+      Args:     const BoundingVolume& bounds
+                  Volume in object space
+                const XMMATRIX& world
+                  World matrix of the object, or the transform into
+                  the space the planes are in
+
+      Modifies: [m_aCenterX, m_aCenterY, m_aCenterZ, m_aExtentX,
+                  m_aExtentY, m_aExtentZ, m_aRadius, m_uNumBounds].
+
+      Returns:  UINT
+                  Number of the volume
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT FrustumCuller::AddBounds(_In_ const BoundingVolume& bounds, _In_ const XMMATRIX& world)
+    {
+        if (m_uNumBounds % CULL_GROUP_SIZE == 0u)
+        {
+            const SIZE_T uSize = static_cast<SIZE_T>(m_uNumBounds) + CULL_GROUP_SIZE;
+            m_aCenterX.resize(uSize, 0.0f);
+            m_aCenterY.resize(uSize, 0.0f);
+            m_aCenterZ.resize(uSize, 0.0f);
+            m_aExtentX.resize(uSize, 0.0f);
+            m_aExtentY.resize(uSize, 0.0f);
+            m_aExtentZ.resize(uSize, 0.0f);
+            m_aRadius.resize(uSize, 0.0f);
+        }
+
+        const BoundingVolume worldBounds = TransformBoundingVolume(bounds, world);
+        m_aCenterX[m_uNumBounds] = worldBounds.Center.x;
+        m_aCenterY[m_uNumBounds] = worldBounds.Center.y;
+        m_aCenterZ[m_uNumBounds] = worldBounds.Center.z;
+        m_aExtentX[m_uNumBounds] = worldBounds.Extents.x;
+        m_aExtentY[m_uNumBounds] = worldBounds.Extents.y;
+        m_aExtentZ[m_uNumBounds] = worldBounds.Extents.z;
+        m_aRadius[m_uNumBounds] = worldBounds.Radius;
+
+        return m_uNumBounds++;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   FrustumCuller::Cull
+
+      Summary:  Tests the volumes against the planes. With a thread
+                pool, chunks of FRUSTUM_CULL_CHUNK_SIZE volumes are
+                culled in parallel into lists of their own, which are
+                joined in chunk order so the visible list keeps the
+                order the volumes were added in
+
+      Args:     ThreadPool* pThreadPool
+                  Pool to split the volumes across, or nullptr to cull
+                  them on the calling thread
+
+      Modifies: [m_aVisible, m_aVisibleList, m_aaChunkVisibleLists].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void FrustumCuller::Cull(_In_opt_ ThreadPool* pThreadPool)
+    {
+        m_aVisible.assign(m_uNumBounds, FALSE);
+        m_aVisibleList.clear();
+
+        const UINT uNumChunks = (m_uNumBounds + FRUSTUM_CULL_CHUNK_SIZE - 1u) / FRUSTUM_CULL_CHUNK_SIZE;
+        if (pThreadPool == nullptr || uNumChunks < 2u)
+        {
+            cullChunk(0u, m_uNumBounds, m_aVisibleList);
+            return;
+        }
+
+        if (m_aaChunkVisibleLists.size() < uNumChunks)
+        {
+            m_aaChunkVisibleLists.resize(uNumChunks);
+        }
+
+        pThreadPool->ParallelFor(uNumChunks, [&](UINT uChunk)
+        {
+            std::vector<UINT>& aChunkVisibleList = m_aaChunkVisibleLists[uChunk];
+            aChunkVisibleList.clear();
+
+            const UINT uFirst = uChunk * FRUSTUM_CULL_CHUNK_SIZE;
+            cullChunk(uFirst, std::min(uFirst + FRUSTUM_CULL_CHUNK_SIZE, m_uNumBounds), aChunkVisibleList);
+        });
+
+        for (UINT uChunk = 0u; uChunk < uNumChunks; ++uChunk)
+        {
+            m_aVisibleList.insert(m_aVisibleList.end(), m_aaChunkVisibleLists[uChunk].begin(), m_aaChunkVisibleLists[uChunk].end());
+        }
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   FrustumCuller::cullChunk
+
+      Summary:  Tests a range of volumes against the planes, four at a
+                time. A volume is outside a plane when its center is
+                further behind the plane than the volume reaches, where
+                the box reaches the sum of its extents times the
+                absolute plane normal and the sphere reaches its radius.
+                A volume outside any plane is culled. Volumes crossing
+                the corner of two planes outside the frustum are kept,
+                which only costs a draw
+
+      Args:     UINT uFirst
+                  First volume, a multiple of four
+                UINT uEnd
+                  One past the last volume
+                std::vector<UINT>& aVisibleList
+                  List the visible volumes are appended to
+
+      Modifies: [m_aVisible].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void FrustumCuller::cullChunk(_In_ UINT uFirst, _In_ UINT uEnd, _Inout_ std::vector<UINT>& aVisibleList)
+    {
+        // Splat every plane and its absolute normal once
+        XMVECTOR aNormalX[NUM_FRUSTUM_PLANES];
+        XMVECTOR aNormalY[NUM_FRUSTUM_PLANES];
+        XMVECTOR aNormalZ[NUM_FRUSTUM_PLANES];
+        XMVECTOR aDistance[NUM_FRUSTUM_PLANES];
+        XMVECTOR aAbsNormalX[NUM_FRUSTUM_PLANES];
+        XMVECTOR aAbsNormalY[NUM_FRUSTUM_PLANES];
+        XMVECTOR aAbsNormalZ[NUM_FRUSTUM_PLANES];
+        for (UINT uPlane = 0u; uPlane < NUM_FRUSTUM_PLANES; ++uPlane)
+        {
+            aNormalX[uPlane] = XMVectorReplicate(m_aPlanes[uPlane].x);
+            aNormalY[uPlane] = XMVectorReplicate(m_aPlanes[uPlane].y);
+            aNormalZ[uPlane] = XMVectorReplicate(m_aPlanes[uPlane].z);
+            aDistance[uPlane] = XMVectorReplicate(m_aPlanes[uPlane].w);
+            aAbsNormalX[uPlane] = XMVectorReplicate(fabsf(m_aPlanes[uPlane].x));
+            aAbsNormalY[uPlane] = XMVectorReplicate(fabsf(m_aPlanes[uPlane].y));
+            aAbsNormalZ[uPlane] = XMVectorReplicate(fabsf(m_aPlanes[uPlane].z));
+        }
+
+        const XMVECTOR zero = XMVectorZero();
+        for (UINT uGroup = uFirst; uGroup < uEnd; uGroup += CULL_GROUP_SIZE)
+        {
+            const XMVECTOR centerX = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_aCenterX[uGroup]));
+            const XMVECTOR centerY = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_aCenterY[uGroup]));
+            const XMVECTOR centerZ = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_aCenterZ[uGroup]));
+            const XMVECTOR extentX = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_aExtentX[uGroup]));
+            const XMVECTOR extentY = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_aExtentY[uGroup]));
+            const XMVECTOR extentZ = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_aExtentZ[uGroup]));
+            const XMVECTOR radius = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_aRadius[uGroup]));
+
+            XMVECTOR outside = zero;
+            for (UINT uPlane = 0u; uPlane < NUM_FRUSTUM_PLANES; ++uPlane)
+            {
+                XMVECTOR distance = XMVectorMultiplyAdd(centerX, aNormalX[uPlane], aDistance[uPlane]);
+                distance = XMVectorMultiplyAdd(centerY, aNormalY[uPlane], distance);
+                distance = XMVectorMultiplyAdd(centerZ, aNormalZ[uPlane], distance);
+
+                XMVECTOR reach = XMVectorMultiply(extentX, aAbsNormalX[uPlane]);
+                reach = XMVectorMultiplyAdd(extentY, aAbsNormalY[uPlane], reach);
+                reach = XMVectorMultiplyAdd(extentZ, aAbsNormalZ[uPlane], reach);
+                reach = XMVectorMin(reach, radius);
+
+                outside = XMVectorOrInt(outside, XMVectorLess(XMVectorAdd(distance, reach), zero));
+            }
+
+            UINT auOutside[CULL_GROUP_SIZE];
+            XMStoreInt4(reinterpret_cast<uint32_t*>(auOutside), outside);
+
+            const UINT uGroupEnd = std::min(uGroup + CULL_GROUP_SIZE, uEnd);
+            for (UINT uIndex = uGroup; uIndex < uGroupEnd; ++uIndex)
+            {
+                if (auOutside[uIndex - uGroup] == 0u)
+                {
+                    m_aVisible[uIndex] = TRUE;
+                    aVisibleList.push_back(uIndex);
+                }
+            }
+        }
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   FrustumCuller::IsBoxVisible
+
+      Summary:  Tests a box against the planes of the last SetFrustum
+                without adding it. Only the planes in the mask are
+                tested, and the planes the box is wholly in front of
+                are cleared from it, so the boxes inside it need not
+                test them again
+
+      Args:     const XMFLOAT3& center
+                const XMFLOAT3& extents
+                  Center and half extents of the box, in the space of
+                  the planes
+                UINT& uPlaneMask
+                  Planes to test, one bit each, FRUSTUM_ALL_PLANES for
+                  a box whose parent was not tested
+
+      Returns:  BOOL
+                  TRUE if the box is at least partly in the frustum
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL FrustumCuller::IsBoxVisible(_In_ const XMFLOAT3& center, _In_ const XMFLOAT3& extents, _Inout_ UINT& uPlaneMask) const
+    {
+        for (UINT uPlane = 0u; uPlane < NUM_FRUSTUM_PLANES; ++uPlane)
+        {
+            if ((uPlaneMask & (1u << uPlane)) == 0u)
+            {
+                continue;
+            }
+
+            const XMFLOAT4& plane = m_aPlanes[uPlane];
+            const FLOAT distance = center.x * plane.x + center.y * plane.y + center.z * plane.z + plane.w;
+            const FLOAT reach = extents.x * fabsf(plane.x) + extents.y * fabsf(plane.y) + extents.z * fabsf(plane.z);
+            if (distance + reach < 0.0f)
+            {
+                return FALSE;
+            }
+            if (distance - reach >= 0.0f)
+            {
+                uPlaneMask &= ~(1u << uPlane);
+            }
+        }
+
+        return TRUE;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   FrustumCuller::IsVisible
+
+      Summary:  Returns whether a volume passed the last cull
+
+      Args:     UINT uIndex
+                  Number of the volume
+
+      Returns:  BOOL
+                  TRUE if the volume is at least partly in the frustum
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL FrustumCuller::IsVisible(_In_ UINT uIndex) const
+    {
+        return m_aVisible[uIndex];
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   FrustumCuller::IsAnyVisible
+
+      Summary:  Returns whether any of a range of volumes passed the
+                last cull
+
+      Args:     UINT uFirst
+                  Number of the first volume
+                UINT uCount
+                  Number of volumes in the range
+
+      Returns:  BOOL
+                  TRUE if a volume of the range is visible
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL FrustumCuller::IsAnyVisible(_In_ UINT uFirst, _In_ UINT uCount) const
+    {
+        for (UINT uIndex = uFirst; uIndex < uFirst + uCount; ++uIndex)
+        {
+            if (m_aVisible[uIndex])
+            {
+                return TRUE;
+            }
+        }
+
+        return FALSE;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   FrustumCuller::GetCenter
+
+      Summary:  Returns the center of a volume, in the space of the
+                transform it was added with
+
+      Args:     UINT uIndex
+                  Number of the volume
+
+      Returns:  XMVECTOR
+                  Center of the volume, w is 1
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    XMVECTOR FrustumCuller::GetCenter(_In_ UINT uIndex) const
+    {
+        return XMVectorSet(m_aCenterX[uIndex], m_aCenterY[uIndex], m_aCenterZ[uIndex], 1.0f);
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   FrustumCuller::GetNumBounds
+
+      Summary:  Returns the number of volumes added since Clear
+
+      Returns:  UINT
+                  Number of volumes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT FrustumCuller::GetNumBounds() const
+    {
+        return m_uNumBounds;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   FrustumCuller::GetVisibleList
+
+      Summary:  Returns the volumes that passed the last cull
+
+      Returns:  const std::vector<UINT>&
+                  Numbers of the visible volumes in the order they were
+                  added
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const std::vector<UINT>& FrustumCuller::GetVisibleList() const
+    {
+        return m_aVisibleList;
+    }
+}
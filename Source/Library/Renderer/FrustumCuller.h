@@ -0,0 +1,112 @@
+/*+===================================================================
+  File:      FRUSTUMCULLER.H
+
+  Summary:   FrustumCuller header file contains declarations of the
+             culler that tests the bounding volumes of the draws of a
+             pass against the frustum of its camera, four volumes at a
+             time.
+
+  Classes: FrustumCuller
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Platform/ThreadPool.h"
+#include "Renderer/BoundingVolume.h"
+
+namespace library
+{
+    constexpr UINT NUM_FRUSTUM_PLANES = 6u;
+
+    // Plane mask of a box no plane has been ruled out for yet
+    constexpr UINT FRUSTUM_ALL_PLANES = (1u << NUM_FRUSTUM_PLANES) - 1u;
+
+    // Volumes one thread culls at a time, a multiple of four
+    constexpr UINT FRUSTUM_CULL_CHUNK_SIZE = 4096u;
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    FrustumCuller
+
+      Summary:  Holds the volumes added for a pass in
+                structure of arrays form and culls them against the six
+                planes of a view projection matrix. Each plane is tested
+                against four volumes in one vector, with the box or the
+                sphere of each volume, whichever reaches less far toward
+                the plane. Volumes are numbered in the order they are
+                added, and the visible ones are listed in that order.
+                Volumes kept in object space are culled with the planes
+                of world times view projection, which gives the planes
+                in object space
+
+      Methods:  SetFrustum
+                  Extracts the planes of a view projection matrix
+                Clear
+                  Removes the volumes
+                AddBounds
+                  Adds a volume moved by a transform
+                Cull
+                  Tests every volume against the planes, optionally
+                  split across the threads of a pool
+                IsBoxVisible
+                  Tests one box against the planes right away, for
+                  hierarchies that cull top down
+                IsVisible
+                  Returns whether a volume passed the last cull
+                IsAnyVisible
+                  Returns whether any of a range of volumes passed
+                GetCenter
+                  Returns the world space center of a volume
+                GetNumBounds
+                  Returns the number of volumes
+                GetVisibleList
+                  Returns the volumes that passed the last cull
+                FrustumCuller
+                  Constructor.
+                ~FrustumCuller
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class FrustumCuller
+    {
+    public:
+        FrustumCuller();
+        FrustumCuller(const FrustumCuller& other) = delete;
+        FrustumCuller(FrustumCuller&& other) = delete;
+        FrustumCuller& operator=(const FrustumCuller& other) = delete;
+        FrustumCuller& operator=(FrustumCuller&& other) = delete;
+        ~FrustumCuller() = default;
+
+        void SetFrustum(_In_ const XMMATRIX& viewProjection);
+        void Clear();
+        UINT AddBounds(_In_ const BoundingVolume& bounds, _In_ const XMMATRIX& world);
+        void Cull(_In_opt_ ThreadPool* pThreadPool = nullptr);
+        BOOL IsBoxVisible(_In_ const XMFLOAT3& center, _In_ const XMFLOAT3& extents, _Inout_ UINT& uPlaneMask) const;
+
+        BOOL IsVisible(_In_ UINT uIndex) const;
+        BOOL IsAnyVisible(_In_ UINT uFirst, _In_ UINT uCount) const;
+        XMVECTOR GetCenter(_In_ UINT uIndex) const;
+        UINT GetNumBounds() const;
+        const std::vector<UINT>& GetVisibleList() const;
+
+    private:
+        void cullChunk(_In_ UINT uFirst, _In_ UINT uEnd, _Inout_ std::vector<UINT>& aVisibleList);
+
+    private:
+        XMFLOAT4 m_aPlanes[NUM_FRUSTUM_PLANES];
+
+        std::vector<FLOAT> m_aCenterX;
+        std::vector<FLOAT> m_aCenterY;
+        std::vector<FLOAT> m_aCenterZ;
+        std::vector<FLOAT> m_aExtentX;
+        std::vector<FLOAT> m_aExtentY;
+        std::vector<FLOAT> m_aExtentZ;
+        std::vector<FLOAT> m_aRadius;
+        UINT m_uNumBounds;
+
+        std::vector<BYTE> m_aVisible;
+        std::vector<UINT> m_aVisibleList;
+        std::vector<std::vector<UINT>> m_aaChunkVisibleLists;
+    };
+}
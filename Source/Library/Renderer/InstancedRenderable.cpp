@@ -1,5 +1,7 @@
 #include "Renderer/InstancedRenderable.h"
 
+#include <numeric>
+
 namespace library
 {
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -14,6 +16,10 @@ namespace library
         : Renderable(outputColor)
         , m_instanceBuffer(nullptr)
         , m_aInstanceData(std::vector<InstanceData>())
+        , m_aVisibleInstanceData(std::vector<InstanceData>())
+        , m_auVisibleInstances(std::vector<UINT>())
+        , m_instanceCuller()
+        , m_bVisibleInstancesChanged(FALSE)
         , m_padding()
     {
     }
@@ -28,12 +34,18 @@ namespace library
                 const XMFLOAT4& outputColor
                   Default color of the renderable
 
-      Modifies: [m_instanceBuffer, m_aInstanceData].
+      Modifies: [m_instanceBuffer, m_aInstanceData, m_aVisibleInstanceData,
+                 m_auVisibleInstances, m_instanceCuller,
+                 m_bVisibleInstancesChanged].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     InstancedRenderable::InstancedRenderable(_In_ std::vector<InstanceData>&& aInstanceData, _In_ const XMFLOAT4& outputColor)
         : Renderable(outputColor)
         , m_instanceBuffer(nullptr)
         , m_aInstanceData(std::move(aInstanceData))
+        , m_aVisibleInstanceData(std::vector<InstanceData>())
+        , m_auVisibleInstances(std::vector<UINT>())
+        , m_instanceCuller()
+        , m_bVisibleInstancesChanged(FALSE)
         , m_padding()
     {}
 
@@ -80,15 +92,144 @@ namespace library
         return static_cast<UINT>(m_aInstanceData.size());
     }
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstancedRenderable::HasInstancesToCull
+
+      Summary:  Returns whether instances are culled one by one. A
+                single instance is already culled with the whole object,
+                so its instance buffer is immutable and never rewritten
+
+      Returns:  BOOL
+                  TRUE if there is more than one instance
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL InstancedRenderable::HasInstancesToCull() const
+    {
+        return m_aInstanceData.size() > 1u;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstancedRenderable::CullInstances
+
+      Summary:  Culls every instance against a view frustum and copies
+                the visible ones, in their original order, into the
+                visible instance data. The planes of the world matrix
+                times the view projection are in object space, where
+                the instances were bounded, so the instances are never
+                transformed. Both the cull and the copy are split into
+                chunks across the thread pool. When the same instances
+                pass as in the last cull nothing is copied, and the
+                instance buffer already holds them
+
+      Args:     const XMMATRIX& viewProjection
+                  View matrix times projection matrix of the camera
+                ThreadPool* pThreadPool
+                  Pool to split the work across, or nullptr to do it on
+                  the calling thread
+
+      Modifies: [m_instanceCuller, m_aVisibleInstanceData,
+                 m_auVisibleInstances, m_bVisibleInstancesChanged].
+
+      Returns:  UINT
+                  Number of visible instances
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT InstancedRenderable::CullInstances(_In_ const XMMATRIX& viewProjection, _In_opt_ ThreadPool* pThreadPool)
+    {
+        m_instanceCuller.SetFrustum(m_world * viewProjection);
+        m_instanceCuller.Cull(pThreadPool);
+
+        const std::vector<UINT>& aVisibleList = m_instanceCuller.GetVisibleList();
+        const UINT uNumVisible = static_cast<UINT>(aVisibleList.size());
+        m_bVisibleInstancesChanged = aVisibleList != m_auVisibleInstances;
+        if (!m_bVisibleInstancesChanged)
+        {
+            return uNumVisible;
+        }
+        m_auVisibleInstances = aVisibleList;
+        m_aVisibleInstanceData.resize(uNumVisible);
+
+        const UINT uNumChunks = (uNumVisible + FRUSTUM_CULL_CHUNK_SIZE - 1u) / FRUSTUM_CULL_CHUNK_SIZE;
+        auto compactChunk = [&](UINT uChunk)
+        {
+            const UINT uEnd = std::min((uChunk + 1u) * FRUSTUM_CULL_CHUNK_SIZE, uNumVisible);
+            for (UINT i = uChunk * FRUSTUM_CULL_CHUNK_SIZE; i < uEnd; ++i)
+            {
+                m_aVisibleInstanceData[i] = m_aInstanceData[aVisibleList[i]];
+            }
+        };
+
+        if (pThreadPool != nullptr && uNumChunks > 1u)
+        {
+            pThreadPool->ParallelFor(uNumChunks, compactChunk);
+        }
+        else
+        {
+            for (UINT uChunk = 0u; uChunk < uNumChunks; ++uChunk)
+            {
+                compactChunk(uChunk);
+            }
+        }
+
+        return uNumVisible;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstancedRenderable::HaveVisibleInstancesChanged
+
+      Summary:  Returns whether the last cull let through different
+                instances than the one before, so the visible instances
+                have to be written to the instance buffer again
+
+      Returns:  BOOL
+                  TRUE if the visible instances changed
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL InstancedRenderable::HaveVisibleInstancesChanged() const
+    {
+        return m_bVisibleInstancesChanged;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstancedRenderable::GetVisibleInstanceData
+
+      Summary:  Returns the instances that passed the last cull, to be
+                written to the front of the instance buffer
+
+      Returns:  const InstanceData*
+                  Visible instances
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const InstanceData* InstancedRenderable::GetVisibleInstanceData() const
+    {
+        return m_aVisibleInstanceData.data();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstancedRenderable::GetNumVisibleInstances
+
+      Summary:  Returns the number of instances that passed the last
+                cull
+
+      Returns:  UINT
+                  Number of visible instances
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT InstancedRenderable::GetNumVisibleInstances() const
+    {
+        return static_cast<UINT>(m_aVisibleInstanceData.size());
+    }
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   InstancedRenderable::initializeInstance
 
-      Summary:  Creates an instance buffer
+      Summary:  Creates an instance buffer and bounds the instances.
+                With more than one instance the buffer is dynamic, so
+                the instances that pass a cull can be written to its
+                front, otherwise it is immutable. Until the first cull
+                it holds every instance
 
       Args:     ID3D11Device* pDevice
                   Pointer to a Direct3D 11 device
 
-      Modifies: [m_instanceBuffer].
+      Modifies: [m_instanceBuffer, m_aVisibleInstanceData,
+                 m_auVisibleInstances, m_aMeshBounds, m_bounds,
+                 m_instanceCuller].
 
       Returns:  HRESULT
                   Status code
@@ -96,13 +237,15 @@ namespace library
 
     HRESULT InstancedRenderable::initializeInstance(_In_ ID3D11Device* pDevice)
     {
+        calculateInstanceBounds();
+
         D3D11_BUFFER_DESC bd =
         {
             //(size of the instanced data) * (number of instances)
             .ByteWidth = static_cast<UINT>(sizeof(InstanceData) * GetNumInstances()),
-            .Usage = D3D11_USAGE_DEFAULT,
+            .Usage = HasInstancesToCull() ? D3D11_USAGE_DYNAMIC : D3D11_USAGE_IMMUTABLE,
             .BindFlags = D3D11_BIND_VERTEX_BUFFER,
-            .CPUAccessFlags = 0
+            .CPUAccessFlags = HasInstancesToCull() ? D3D11_CPU_ACCESS_WRITE : 0u
         };
 
         D3D11_SUBRESOURCE_DATA initData =
@@ -114,6 +257,53 @@ namespace library
         if (FAILED(hr))
             return hr;
 
+        m_aVisibleInstanceData = m_aInstanceData;
+        m_auVisibleInstances.resize(m_aInstanceData.size());
+        std::iota(m_auVisibleInstances.begin(), m_auVisibleInstances.end(), 0u);
+
         return S_OK;
     }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstancedRenderable::calculateInstanceBounds
+
+      Summary:  Every mesh is drawn once per instance, so the bounds of
+                a mesh become the bounds of all of its instances, and
+                the whole object is bounded the same way. Each instance
+                is also bounded on its own, in object space, for
+                CullInstances. The bounds of the meshes must already be
+                calculated
+
+      Modifies: [m_aMeshBounds, m_bounds, m_instanceCuller].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void InstancedRenderable::calculateInstanceBounds()
+    {
+        m_instanceCuller.Clear();
+        for (const InstanceData& instance : m_aInstanceData)
+        {
+            m_instanceCuller.AddBounds(m_bounds, GetInstanceTransform(instance));
+        }
+
+        if (m_aInstanceData.empty())
+        {
+            return;
+        }
+
+        for (BoundingVolume& meshBounds : m_aMeshBounds)
+        {
+            const BoundingVolume bounds = meshBounds;
+            meshBounds = TransformBoundingVolume(bounds, GetInstanceTransform(m_aInstanceData[0]));
+            for (SIZE_T i = 1u; i < m_aInstanceData.size(); ++i)
+            {
+                meshBounds = MergeBoundingVolumes(meshBounds, TransformBoundingVolume(bounds, GetInstanceTransform(m_aInstanceData[i])));
+            }
+        }
+
+        const BoundingVolume bounds = m_bounds;
+        m_bounds = TransformBoundingVolume(bounds, GetInstanceTransform(m_aInstanceData[0]));
+        for (SIZE_T i = 1u; i < m_aInstanceData.size(); ++i)
+        {
+            m_bounds = MergeBoundingVolumes(m_bounds, TransformBoundingVolume(bounds, GetInstanceTransform(m_aInstanceData[i])));
+        }
+    }
 }
\ No newline at end of file
@@ -13,7 +13,9 @@
 
 #include "Common.h"
 
+#include "Platform/ThreadPool.h"
 #include "Renderer/DataTypes.h"
+#include "Renderer/FrustumCuller.h"
 #include "Renderer/Renderable.h"
 
 namespace library
@@ -29,8 +31,23 @@ namespace library
                   Returns a instance buffer
                 GetNumInstances
                   Returns the number of instance data
+                HasInstancesToCull
+                  Returns whether instances are culled one by one
+                CullInstances
+                  Culls every instance against a view frustum and
+                  compacts the visible ones
+                HaveVisibleInstancesChanged
+                  Returns whether the last cull changed the visible
+                  instances
+                GetVisibleInstanceData
+                  Returns the instances that passed the last cull
+                GetNumVisibleInstances
+                  Returns the number of instances that passed the last
+                  cull
                 initializeInstance
                   Initialize the instance buffer
+                calculateInstanceBounds
+                  Bounds every instance of the meshes
                 InstancedRenderable
                   Constructor.
                 ~InstancedRenderable
@@ -55,6 +72,12 @@ namespace library
         virtual ComPtr<ID3D11Buffer>& GetInstanceBuffer();
         virtual UINT GetNumInstances() const;
 
+        BOOL HasInstancesToCull() const;
+        UINT CullInstances(_In_ const XMMATRIX& viewProjection, _In_opt_ ThreadPool* pThreadPool);
+        BOOL HaveVisibleInstancesChanged() const;
+        const InstanceData* GetVisibleInstanceData() const;
+        UINT GetNumVisibleInstances() const;
+
         UINT GetNumVertices() const override = 0;
         UINT GetNumIndices() const override = 0;
 
@@ -63,10 +86,15 @@ namespace library
         const WORD* getIndices() const override = 0;
 
         virtual HRESULT initializeInstance(_In_ ID3D11Device* pDevice);
+        void calculateInstanceBounds();
 
     protected:
         ComPtr<ID3D11Buffer> m_instanceBuffer;
         std::vector<InstanceData> m_aInstanceData;
+        std::vector<InstanceData> m_aVisibleInstanceData;
+        std::vector<UINT> m_auVisibleInstances;
+        FrustumCuller m_instanceCuller;
+        BOOL m_bVisibleInstancesChanged;
 
     private:
         BYTE m_padding[8];
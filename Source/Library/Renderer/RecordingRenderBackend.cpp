@@ -0,0 +1,779 @@
+#include "Renderer/RecordingRenderBackend.h"
+
+#include <bit>
+
+namespace library
+{
+    namespace
+    {
+        template <class T>
+        T* const* objectsAs(_In_ const std::vector<void*>& objects, _In_ UINT uFirst)
+        {
+            return reinterpret_cast<T* const*>(objects.data() + uFirst);
+        }
+
+        template <class T>
+        T* objectAs(_In_ const std::vector<void*>& objects, _In_ UINT uFirst)
+        {
+            return static_cast<T*>(objects[uFirst]);
+        }
+
+        FLOAT valueAsFloat(_In_ const std::vector<UINT>& values, _In_ UINT uIndex)
+        {
+            return std::bit_cast<FLOAT>(values[uIndex]);
+        }
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RecordingRenderBackend::RecordingRenderBackend
+
+      Summary:  Constructor of a recorder that does not forward the
+                commands anywhere
+
+      Modifies: [m_next, m_commands, m_objects, m_values, m_uploads,
+                  m_passStatistics, m_uCurrentPass, m_uNumFrames].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    RecordingRenderBackend::RecordingRenderBackend()
+        : RecordingRenderBackend(nullptr)
+    {
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RecordingRenderBackend::RecordingRenderBackend
+
+      Summary:  Constructor
+
+      Args:     std::shared_ptr<RenderBackend> next
+                  Backend every command is forwarded to after it is
+                  recorded, or nullptr
+
+      Modifies: [m_next, m_commands, m_objects, m_values, m_uploads,
+                  m_passStatistics, m_uCurrentPass, m_uNumFrames].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    RecordingRenderBackend::RecordingRenderBackend(_In_ std::shared_ptr<RenderBackend> next)
+        : m_next(std::move(next))
+        , m_commands()
+        , m_objects()
+        , m_values()
+        , m_uploads()
+        , m_passStatistics()
+        , m_uCurrentPass(0u)
+        , m_uNumFrames(0u)
+    {
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RecordingRenderBackend::GetCommands
+
+      Summary:  Returns the commands of the last frame
+
+      Returns:  const std::vector<RecordedCommand>&
+                  Recorded commands in submission order
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const std::vector<RecordedCommand>& RecordingRenderBackend::GetCommands() const
+    {
+        return m_commands;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RecordingRenderBackend::GetPassStatistics
+
+      Summary:  Returns the statistics of every pass of the last frame.
+                The first entry holds the commands submitted outside of
+                any pass
+
+      Returns:  const std::vector<RenderPassStatistics>&
+                  Statistics in the order the passes began
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const std::vector<RenderPassStatistics>& RecordingRenderBackend::GetPassStatistics() const
+    {
+        return m_passStatistics;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RecordingRenderBackend::GetFrameStatistics
+
+      Summary:  Returns the statistics of all passes of the last frame
+                added together
+
+      Returns:  RenderPassStatistics
+                  Statistics of the frame
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    RenderPassStatistics RecordingRenderBackend::GetFrameStatistics() const
+    {
+        RenderPassStatistics frame = { .Name = L"Total" };
+        for (const RenderPassStatistics& pass : m_passStatistics)
+        {
+            frame.uNumCommands += pass.uNumCommands;
+            frame.uNumDrawCalls += pass.uNumDrawCalls;
+            frame.uNumStateChanges += pass.uNumStateChanges;
+            frame.uNumClears += pass.uNumClears;
+            frame.uNumUploads += pass.uNumUploads;
+            frame.uUploadBytes += pass.uUploadBytes;
+            frame.uNumIndices += pass.uNumIndices;
+            frame.uNumInstances += pass.uNumInstances;
+        }
+
+        return frame;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RecordingRenderBackend::GetNumFrames
+
+      Summary:  Returns the number of frames recorded so far
+
+      Returns:  UINT64
+                  Number of BeginFrame calls
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT64 RecordingRenderBackend::GetNumFrames() const
+    {
+        return m_uNumFrames;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RecordingRenderBackend::Replay
+
+      Summary:  Submits the recorded frame to another backend, e.g. a
+                D3D11RenderBackend, in the order it was recorded
+
+      Args:     RenderBackend& target
+                  Backend to submit the commands to
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void RecordingRenderBackend::Replay(_In_ RenderBackend& target) const
+    {
+        target.BeginFrame();
+
+        for (const RecordedCommand& command : m_commands)
+        {
+            const UINT uObject = command.uFirstObject;
+            const UINT uValue = command.uFirstValue;
+
+            switch (command.Type)
+            {
+            case eRenderCommand::BEGIN_PASS:
+                target.BeginPass(m_passStatistics[command.uPass].Name.c_str());
+                break;
+            case eRenderCommand::END_PASS:
+                target.EndPass();
+                break;
+            case eRenderCommand::SET_RENDER_TARGETS:
+                target.SetRenderTargets(command.uCount, objectsAs<ID3D11RenderTargetView>(m_objects, uObject), objectAs<ID3D11DepthStencilView>(m_objects, uObject + command.uCount));
+                break;
+            case eRenderCommand::SET_VIEWPORTS:
+            {
+                // Direct3D 11 binds at most 16 viewports
+                D3D11_VIEWPORT aViewports[16] = {};
+                const UINT uNumViewports = std::min(command.uCount, static_cast<UINT>(ARRAYSIZE(aViewports)));
+                for (UINT i = 0u; i < uNumViewports; ++i)
+                {
+                    const UINT uBase = uValue + i * 6u;
+                    aViewports[i] =
+                    {
+                        .TopLeftX = valueAsFloat(m_values, uBase),
+                        .TopLeftY = valueAsFloat(m_values, uBase + 1u),
+                        .Width = valueAsFloat(m_values, uBase + 2u),
+                        .Height = valueAsFloat(m_values, uBase + 3u),
+                        .MinDepth = valueAsFloat(m_values, uBase + 4u),
+                        .MaxDepth = valueAsFloat(m_values, uBase + 5u),
+                    };
+                }
+                target.SetViewports(uNumViewports, aViewports);
+                break;
+            }
+            case eRenderCommand::CLEAR_RENDER_TARGET_VIEW:
+            {
+                const FLOAT aColor[4] =
+                {
+                    valueAsFloat(m_values, uValue),
+                    valueAsFloat(m_values, uValue + 1u),
+                    valueAsFloat(m_values, uValue + 2u),
+                    valueAsFloat(m_values, uValue + 3u),
+                };
+                target.ClearRenderTargetView(objectAs<ID3D11RenderTargetView>(m_objects, uObject), aColor);
+                break;
+            }
+            case eRenderCommand::CLEAR_DEPTH_STENCIL_VIEW:
+                target.ClearDepthStencilView(objectAs<ID3D11DepthStencilView>(m_objects, uObject), m_values[uValue], valueAsFloat(m_values, uValue + 1u), static_cast<UINT8>(m_values[uValue + 2u]));
+                break;
+            case eRenderCommand::UPDATE_BUFFER:
+                target.UpdateBuffer(objectAs<ID3D11Buffer>(m_objects, uObject), m_uploads.data() + command.uFirstByte, command.uNumBytes);
+                break;
+            case eRenderCommand::WRITE_DYNAMIC_BUFFER:
+                target.WriteDynamicBuffer(objectAs<ID3D11Buffer>(m_objects, uObject), m_values[uValue], m_uploads.data() + command.uFirstByte, command.uNumBytes, static_cast<BOOL>(m_values[uValue + 1u]));
+                break;
+            case eRenderCommand::SET_VERTEX_BUFFERS:
+                target.SetVertexBuffers(command.uSlot, command.uCount, objectsAs<ID3D11Buffer>(m_objects, uObject), m_values.data() + uValue, m_values.data() + uValue + command.uCount);
+                break;
+            case eRenderCommand::SET_INDEX_BUFFER:
+                target.SetIndexBuffer(objectAs<ID3D11Buffer>(m_objects, uObject), static_cast<DXGI_FORMAT>(m_values[uValue]), m_values[uValue + 1u]);
+                break;
+            case eRenderCommand::SET_INPUT_LAYOUT:
+                target.SetInputLayout(objectAs<ID3D11InputLayout>(m_objects, uObject));
+                break;
+            case eRenderCommand::SET_PRIMITIVE_TOPOLOGY:
+                target.SetPrimitiveTopology(static_cast<D3D11_PRIMITIVE_TOPOLOGY>(m_values[uValue]));
+                break;
+            case eRenderCommand::SET_VERTEX_SHADER:
+                target.SetVertexShader(objectAs<ID3D11VertexShader>(m_objects, uObject));
+                break;
+            case eRenderCommand::SET_VS_CONSTANT_BUFFERS:
+                target.SetVSConstantBuffers(command.uSlot, command.uCount, objectsAs<ID3D11Buffer>(m_objects, uObject));
+                break;
+            case eRenderCommand::SET_VS_CONSTANT_BUFFER_RANGES:
+                target.SetVSConstantBufferRanges(command.uSlot, command.uCount, objectsAs<ID3D11Buffer>(m_objects, uObject), m_values.data() + uValue, m_values.data() + uValue + command.uCount);
+                break;
+            case eRenderCommand::SET_PIXEL_SHADER:
+                target.SetPixelShader(objectAs<ID3D11PixelShader>(m_objects, uObject));
+                break;
+            case eRenderCommand::SET_PS_CONSTANT_BUFFERS:
+                target.SetPSConstantBuffers(command.uSlot, command.uCount, objectsAs<ID3D11Buffer>(m_objects, uObject));
+                break;
+            case eRenderCommand::SET_PS_CONSTANT_BUFFER_RANGES:
+                target.SetPSConstantBufferRanges(command.uSlot, command.uCount, objectsAs<ID3D11Buffer>(m_objects, uObject), m_values.data() + uValue, m_values.data() + uValue + command.uCount);
+                break;
+            case eRenderCommand::SET_PS_SHADER_RESOURCES:
+                target.SetPSShaderResources(command.uSlot, command.uCount, objectsAs<ID3D11ShaderResourceView>(m_objects, uObject));
+                break;
+            case eRenderCommand::SET_PS_SAMPLERS:
+                target.SetPSSamplers(command.uSlot, command.uCount, objectsAs<ID3D11SamplerState>(m_objects, uObject));
+                break;
+            case eRenderCommand::DRAW_INDEXED:
+                target.DrawIndexed(m_values[uValue], m_values[uValue + 1u], static_cast<INT>(m_values[uValue + 2u]));
+                break;
+            case eRenderCommand::DRAW_INDEXED_INSTANCED:
+                target.DrawIndexedInstanced(m_values[uValue], m_values[uValue + 1u], m_values[uValue + 2u], static_cast<INT>(m_values[uValue + 3u]), m_values[uValue + 4u]);
+                break;
+            default:
+                break;
+            }
+        }
+
+        target.EndFrame();
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RecordingRenderBackend::ReportStatistics
+
+      Summary:  Writes one line per pass of the last frame and one line
+                for the whole frame to the debug output
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void RecordingRenderBackend::ReportStatistics() const
+    {
+        const auto report = [](_In_ const RenderPassStatistics& pass)
+        {
+            WCHAR szMessage[256];
+            swprintf_s(
+                szMessage,
+                L"%-8ls commands %6u  draws %5u  state changes %6u  clears %2u  uploads %5u (%llu bytes)  indices %llu  instances %llu\n",
+                pass.Name.c_str(),
+                pass.uNumCommands,
+                pass.uNumDrawCalls,
+                pass.uNumStateChanges,
+                pass.uNumClears,
+                pass.uNumUploads,
+                static_cast<unsigned long long>(pass.uUploadBytes),
+                static_cast<unsigned long long>(pass.uNumIndices),
+                static_cast<unsigned long long>(pass.uNumInstances)
+            );
+            OutputDebugString(szMessage);
+        };
+
+        for (const RenderPassStatistics& pass : m_passStatistics)
+        {
+            if (pass.uNumCommands > 0u)
+            {
+                report(pass);
+            }
+        }
+        report(GetFrameStatistics());
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RecordingRenderBackend::BeginFrame
+
+      Summary:  Discards the previous frame and starts recording
+
+      Modifies: [m_commands, m_objects, m_values, m_uploads,
+                  m_passStatistics, m_uCurrentPass, m_uNumFrames].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void RecordingRenderBackend::BeginFrame()
+    {
+        // Keep the capacity, a frame usually records as much as the last
+        m_commands.clear();
+        m_objects.clear();
+        m_values.clear();
+        m_uploads.clear();
+        m_passStatistics.clear();
+
+        m_passStatistics.push_back({ .Name = L"Frame" });
+        m_uCurrentPass = 0u;
+        ++m_uNumFrames;
+
+        if (m_next)
+        {
+            m_next->BeginFrame();
+        }
+    }
+
+
+    void RecordingRenderBackend::EndFrame()
+    {
+        if (m_next)
+        {
+            m_next->EndFrame();
+        }
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RecordingRenderBackend::BeginPass
+
+      Summary:  Starts counting the following commands into a new pass
+
+      Args:     PCWSTR pszPassName
+                  Name of the pass
+
+      Modifies: [m_passStatistics, m_uCurrentPass, m_commands].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void RecordingRenderBackend::BeginPass(_In_ PCWSTR pszPassName)
+    {
+        if (m_passStatistics.empty())
+        {
+            m_passStatistics.push_back({ .Name = L"Frame" });
+        }
+        m_uCurrentPass = static_cast<UINT>(m_passStatistics.size());
+        m_passStatistics.push_back({ .Name = pszPassName });
+        record(eRenderCommand::BEGIN_PASS, 0u, 0u);
+
+        if (m_next)
+        {
+            m_next->BeginPass(pszPassName);
+        }
+    }
+
+
+    void RecordingRenderBackend::EndPass()
+    {
+        record(eRenderCommand::END_PASS, 0u, 0u);
+        m_uCurrentPass = 0u;
+
+        if (m_next)
+        {
+            m_next->EndPass();
+        }
+    }
+
+
+    void RecordingRenderBackend::SetRenderTargets(_In_ UINT uNumViews, _In_reads_opt_(uNumViews) ID3D11RenderTargetView* const* ppRenderTargetViews, _In_opt_ ID3D11DepthStencilView* pDepthStencilView)
+    {
+        record(eRenderCommand::SET_RENDER_TARGETS, 0u, uNumViews);
+        recordObjects(uNumViews, reinterpret_cast<const void* const*>(ppRenderTargetViews));
+        m_objects.push_back(pDepthStencilView);
+
+        if (m_next)
+        {
+            m_next->SetRenderTargets(uNumViews, ppRenderTargetViews, pDepthStencilView);
+        }
+    }
+
+
+    void RecordingRenderBackend::SetViewports(_In_ UINT uNumViewports, _In_reads_(uNumViewports) const D3D11_VIEWPORT* pViewports)
+    {
+        record(eRenderCommand::SET_VIEWPORTS, 0u, uNumViewports);
+        for (UINT i = 0u; i < uNumViewports; ++i)
+        {
+            recordValue(pViewports[i].TopLeftX);
+            recordValue(pViewports[i].TopLeftY);
+            recordValue(pViewports[i].Width);
+            recordValue(pViewports[i].Height);
+            recordValue(pViewports[i].MinDepth);
+            recordValue(pViewports[i].MaxDepth);
+        }
+
+        if (m_next)
+        {
+            m_next->SetViewports(uNumViewports, pViewports);
+        }
+    }
+
+
+    void RecordingRenderBackend::ClearRenderTargetView(_In_ ID3D11RenderTargetView* pRenderTargetView, _In_ const FLOAT aColorRGBA[4])
+    {
+        record(eRenderCommand::CLEAR_RENDER_TARGET_VIEW, 0u, 1u);
+        m_objects.push_back(pRenderTargetView);
+        for (UINT i = 0u; i < 4u; ++i)
+        {
+            recordValue(aColorRGBA[i]);
+        }
+
+        if (m_next)
+        {
+            m_next->ClearRenderTargetView(pRenderTargetView, aColorRGBA);
+        }
+    }
+
+
+    void RecordingRenderBackend::ClearDepthStencilView(_In_ ID3D11DepthStencilView* pDepthStencilView, _In_ UINT uClearFlags, _In_ FLOAT depth, _In_ UINT8 stencil)
+    {
+        record(eRenderCommand::CLEAR_DEPTH_STENCIL_VIEW, 0u, 1u);
+        m_objects.push_back(pDepthStencilView);
+        recordValue(uClearFlags);
+        recordValue(depth);
+        recordValue(static_cast<UINT>(stencil));
+
+        if (m_next)
+        {
+            m_next->ClearDepthStencilView(pDepthStencilView, uClearFlags, depth, stencil);
+        }
+    }
+
+
+    void RecordingRenderBackend::UpdateBuffer(_In_ ID3D11Buffer* pBuffer, _In_reads_bytes_(uDataSize) const void* pData, _In_ UINT uDataSize)
+    {
+        RecordedCommand& command = record(eRenderCommand::UPDATE_BUFFER, 0u, 1u);
+        command.uNumBytes = uDataSize;
+        m_objects.push_back(pBuffer);
+
+        const BYTE* pBytes = static_cast<const BYTE*>(pData);
+        m_uploads.insert(m_uploads.end(), pBytes, pBytes + uDataSize);
+
+        m_passStatistics[m_uCurrentPass].uUploadBytes += uDataSize;
+
+        if (m_next)
+        {
+            m_next->UpdateBuffer(pBuffer, pData, uDataSize);
+        }
+    }
+
+
+    void RecordingRenderBackend::WriteDynamicBuffer(_In_ ID3D11Buffer* pBuffer, _In_ UINT uOffset, _In_reads_bytes_(uDataSize) const void* pData, _In_ UINT uDataSize, _In_ BOOL bDiscard)
+    {
+        RecordedCommand& command = record(eRenderCommand::WRITE_DYNAMIC_BUFFER, 0u, 1u);
+        command.uNumBytes = uDataSize;
+        m_objects.push_back(pBuffer);
+        recordValue(uOffset);
+        recordValue(static_cast<UINT>(bDiscard));
+
+        const BYTE* pBytes = static_cast<const BYTE*>(pData);
+        m_uploads.insert(m_uploads.end(), pBytes, pBytes + uDataSize);
+
+        m_passStatistics[m_uCurrentPass].uUploadBytes += uDataSize;
+
+        if (m_next)
+        {
+            m_next->WriteDynamicBuffer(pBuffer, uOffset, pData, uDataSize, bDiscard);
+        }
+    }
+
+
+    BOOL RecordingRenderBackend::SupportsConstantBufferOffsets() const
+    {
+        // Alone the recorder can capture any range
+        return m_next ? m_next->SupportsConstantBufferOffsets() : TRUE;
+    }
+
+
+    void RecordingRenderBackend::SetVertexBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppVertexBuffers, _In_reads_opt_(uNumBuffers) const UINT* puStrides, _In_reads_opt_(uNumBuffers) const UINT* puOffsets)
+    {
+        record(eRenderCommand::SET_VERTEX_BUFFERS, uStartSlot, uNumBuffers);
+        recordObjects(uNumBuffers, reinterpret_cast<const void* const*>(ppVertexBuffers));
+        for (UINT i = 0u; i < uNumBuffers; ++i)
+        {
+            recordValue(puStrides ? puStrides[i] : 0u);
+        }
+        for (UINT i = 0u; i < uNumBuffers; ++i)
+        {
+            recordValue(puOffsets ? puOffsets[i] : 0u);
+        }
+
+        if (m_next)
+        {
+            m_next->SetVertexBuffers(uStartSlot, uNumBuffers, ppVertexBuffers, puStrides, puOffsets);
+        }
+    }
+
+
+    void RecordingRenderBackend::SetIndexBuffer(_In_opt_ ID3D11Buffer* pIndexBuffer, _In_ DXGI_FORMAT format, _In_ UINT uOffset)
+    {
+        record(eRenderCommand::SET_INDEX_BUFFER, 0u, 1u);
+        m_objects.push_back(pIndexBuffer);
+        recordValue(static_cast<UINT>(format));
+        recordValue(uOffset);
+
+        if (m_next)
+        {
+            m_next->SetIndexBuffer(pIndexBuffer, format, uOffset);
+        }
+    }
+
+
+    void RecordingRenderBackend::SetInputLayout(_In_opt_ ID3D11InputLayout* pInputLayout)
+    {
+        record(eRenderCommand::SET_INPUT_LAYOUT, 0u, 1u);
+        m_objects.push_back(pInputLayout);
+
+        if (m_next)
+        {
+            m_next->SetInputLayout(pInputLayout);
+        }
+    }
+
+
+    void RecordingRenderBackend::SetPrimitiveTopology(_In_ D3D11_PRIMITIVE_TOPOLOGY topology)
+    {
+        record(eRenderCommand::SET_PRIMITIVE_TOPOLOGY, 0u, 1u);
+        recordValue(static_cast<UINT>(topology));
+
+        if (m_next)
+        {
+            m_next->SetPrimitiveTopology(topology);
+        }
+    }
+
+
+    void RecordingRenderBackend::SetVertexShader(_In_opt_ ID3D11VertexShader* pVertexShader)
+    {
+        record(eRenderCommand::SET_VERTEX_SHADER, 0u, 1u);
+        m_objects.push_back(pVertexShader);
+
+        if (m_next)
+        {
+            m_next->SetVertexShader(pVertexShader);
+        }
+    }
+
+
+    void RecordingRenderBackend::SetVSConstantBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers)
+    {
+        record(eRenderCommand::SET_VS_CONSTANT_BUFFERS, uStartSlot, uNumBuffers);
+        recordObjects(uNumBuffers, reinterpret_cast<const void* const*>(ppConstantBuffers));
+
+        if (m_next)
+        {
+            m_next->SetVSConstantBuffers(uStartSlot, uNumBuffers, ppConstantBuffers);
+        }
+    }
+
+
+    void RecordingRenderBackend::SetVSConstantBufferRanges(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers, _In_reads_(uNumBuffers) const UINT* puFirstConstants, _In_reads_(uNumBuffers) const UINT* puNumConstants)
+    {
+        record(eRenderCommand::SET_VS_CONSTANT_BUFFER_RANGES, uStartSlot, uNumBuffers);
+        recordObjects(uNumBuffers, reinterpret_cast<const void* const*>(ppConstantBuffers));
+        m_values.insert(m_values.end(), puFirstConstants, puFirstConstants + uNumBuffers);
+        m_values.insert(m_values.end(), puNumConstants, puNumConstants + uNumBuffers);
+
+        if (m_next)
+        {
+            m_next->SetVSConstantBufferRanges(uStartSlot, uNumBuffers, ppConstantBuffers, puFirstConstants, puNumConstants);
+        }
+    }
+
+
+    void RecordingRenderBackend::SetPixelShader(_In_opt_ ID3D11PixelShader* pPixelShader)
+    {
+        record(eRenderCommand::SET_PIXEL_SHADER, 0u, 1u);
+        m_objects.push_back(pPixelShader);
+
+        if (m_next)
+        {
+            m_next->SetPixelShader(pPixelShader);
+        }
+    }
+
+
+    void RecordingRenderBackend::SetPSConstantBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers)
+    {
+        record(eRenderCommand::SET_PS_CONSTANT_BUFFERS, uStartSlot, uNumBuffers);
+        recordObjects(uNumBuffers, reinterpret_cast<const void* const*>(ppConstantBuffers));
+
+        if (m_next)
+        {
+            m_next->SetPSConstantBuffers(uStartSlot, uNumBuffers, ppConstantBuffers);
+        }
+    }
+
+
+    void RecordingRenderBackend::SetPSConstantBufferRanges(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers, _In_reads_(uNumBuffers) const UINT* puFirstConstants, _In_reads_(uNumBuffers) const UINT* puNumConstants)
+    {
+        record(eRenderCommand::SET_PS_CONSTANT_BUFFER_RANGES, uStartSlot, uNumBuffers);
+        recordObjects(uNumBuffers, reinterpret_cast<const void* const*>(ppConstantBuffers));
+        m_values.insert(m_values.end(), puFirstConstants, puFirstConstants + uNumBuffers);
+        m_values.insert(m_values.end(), puNumConstants, puNumConstants + uNumBuffers);
+
+        if (m_next)
+        {
+            m_next->SetPSConstantBufferRanges(uStartSlot, uNumBuffers, ppConstantBuffers, puFirstConstants, puNumConstants);
+        }
+    }
+
+
+    void RecordingRenderBackend::SetPSShaderResources(_In_ UINT uStartSlot, _In_ UINT uNumViews, _In_reads_opt_(uNumViews) ID3D11ShaderResourceView* const* ppShaderResourceViews)
+    {
+        record(eRenderCommand::SET_PS_SHADER_RESOURCES, uStartSlot, uNumViews);
+        recordObjects(uNumViews, reinterpret_cast<const void* const*>(ppShaderResourceViews));
+
+        if (m_next)
+        {
+            m_next->SetPSShaderResources(uStartSlot, uNumViews, ppShaderResourceViews);
+        }
+    }
+
+
+    void RecordingRenderBackend::SetPSSamplers(_In_ UINT uStartSlot, _In_ UINT uNumSamplers, _In_reads_opt_(uNumSamplers) ID3D11SamplerState* const* ppSamplers)
+    {
+        record(eRenderCommand::SET_PS_SAMPLERS, uStartSlot, uNumSamplers);
+        recordObjects(uNumSamplers, reinterpret_cast<const void* const*>(ppSamplers));
+
+        if (m_next)
+        {
+            m_next->SetPSSamplers(uStartSlot, uNumSamplers, ppSamplers);
+        }
+    }
+
+
+    void RecordingRenderBackend::DrawIndexed(_In_ UINT uIndexCount, _In_ UINT uStartIndexLocation, _In_ INT nBaseVertexLocation)
+    {
+        record(eRenderCommand::DRAW_INDEXED, 0u, 1u);
+        recordValue(uIndexCount);
+        recordValue(uStartIndexLocation);
+        recordValue(static_cast<UINT>(nBaseVertexLocation));
+
+        m_passStatistics[m_uCurrentPass].uNumIndices += uIndexCount;
+        m_passStatistics[m_uCurrentPass].uNumInstances += 1u;
+
+        if (m_next)
+        {
+            m_next->DrawIndexed(uIndexCount, uStartIndexLocation, nBaseVertexLocation);
+        }
+    }
+
+
+    void RecordingRenderBackend::DrawIndexedInstanced(_In_ UINT uIndexCountPerInstance, _In_ UINT uInstanceCount, _In_ UINT uStartIndexLocation, _In_ INT nBaseVertexLocation, _In_ UINT uStartInstanceLocation)
+    {
+        record(eRenderCommand::DRAW_INDEXED_INSTANCED, 0u, 1u);
+        recordValue(uIndexCountPerInstance);
+        recordValue(uInstanceCount);
+        recordValue(uStartIndexLocation);
+        recordValue(static_cast<UINT>(nBaseVertexLocation));
+        recordValue(uStartInstanceLocation);
+
+        m_passStatistics[m_uCurrentPass].uNumIndices += static_cast<UINT64>(uIndexCountPerInstance) * uInstanceCount;
+        m_passStatistics[m_uCurrentPass].uNumInstances += uInstanceCount;
+
+        if (m_next)
+        {
+            m_next->DrawIndexedInstanced(uIndexCountPerInstance, uInstanceCount, uStartIndexLocation, nBaseVertexLocation, uStartInstanceLocation);
+        }
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RecordingRenderBackend::record
+
+      Summary:  Appends a command whose arguments start at the current
+                end of the argument arrays, and counts it into the
+                current pass
+
+      Args:     eRenderCommand type
+                  Type of the command
+                UINT uSlot
+                  First slot the command binds to
+                UINT uCount
+                  Number of objects the command binds
+
+      Modifies: [m_commands, m_passStatistics].
+
+      Returns:  RecordedCommand&
+                  The new command
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    RecordedCommand& RecordingRenderBackend::record(_In_ eRenderCommand type, _In_ UINT uSlot, _In_ UINT uCount)
+    {
+        // Commands issued before the first BeginFrame still need a pass
+        if (m_passStatistics.empty())
+        {
+            m_passStatistics.push_back({ .Name = L"Frame" });
+        }
+
+        RenderPassStatistics& pass = m_passStatistics[m_uCurrentPass];
+        switch (type)
+        {
+        case eRenderCommand::BEGIN_PASS:
+        case eRenderCommand::END_PASS:
+            break;
+        case eRenderCommand::CLEAR_RENDER_TARGET_VIEW:
+        case eRenderCommand::CLEAR_DEPTH_STENCIL_VIEW:
+            ++pass.uNumClears;
+            break;
+        case eRenderCommand::UPDATE_BUFFER:
+        case eRenderCommand::WRITE_DYNAMIC_BUFFER:
+            ++pass.uNumUploads;
+            break;
+        case eRenderCommand::DRAW_INDEXED:
+        case eRenderCommand::DRAW_INDEXED_INSTANCED:
+            ++pass.uNumDrawCalls;
+            break;
+        default:
+            ++pass.uNumStateChanges;
+            break;
+        }
+        ++pass.uNumCommands;
+
+        m_commands.push_back(
+            {
+                .Type = type,
+                .uPass = m_uCurrentPass,
+                .uSlot = uSlot,
+                .uCount = uCount,
+                .uFirstObject = static_cast<UINT>(m_objects.size()),
+                .uFirstValue = static_cast<UINT>(m_values.size()),
+                .uFirstByte = static_cast<UINT>(m_uploads.size()),
+                .uNumBytes = 0u
+            }
+        );
+
+        return m_commands.back();
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RecordingRenderBackend::recordObjects
+
+      Summary:  Appends the given objects, or uCount null objects when
+                the array is null, to the object array
+
+      Args:     UINT uCount
+                  Number of objects
+                const void* const* ppObjects
+                  Objects to append
+
+      Modifies: [m_objects].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void RecordingRenderBackend::recordObjects(_In_ UINT uCount, _In_reads_opt_(uCount) const void* const* ppObjects)
+    {
+        for (UINT i = 0u; i < uCount; ++i)
+        {
+            m_objects.push_back(ppObjects ? const_cast<void*>(ppObjects[i]) : nullptr);
+        }
+    }
+
+
+    void RecordingRenderBackend::recordValue(_In_ UINT uValue)
+    {
+        m_values.push_back(uValue);
+    }
+
+
+    void RecordingRenderBackend::recordValue(_In_ FLOAT value)
+    {
+        m_values.push_back(std::bit_cast<UINT>(value));
+    }
+}
@@ -0,0 +1,187 @@
+/*+===================================================================
+  File:      RECORDINGRENDERBACKEND.H
+
+  Summary:   RecordingRenderBackend header file contains declarations
+             of the RenderBackend that captures the command stream of
+             a frame and measures its submission cost per render pass.
+
+  Classes: RecordingRenderBackend
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Renderer/RenderBackend.h"
+
+namespace library
+{
+    /*E+E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E
+      Enum:     eRenderCommand
+
+      Summary:  Type of a command recorded by RecordingRenderBackend,
+                one for every RenderBackend call
+    E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E-E*/
+    enum class eRenderCommand : UINT
+    {
+        BEGIN_PASS,
+        END_PASS,
+        SET_RENDER_TARGETS,
+        SET_VIEWPORTS,
+        CLEAR_RENDER_TARGET_VIEW,
+        CLEAR_DEPTH_STENCIL_VIEW,
+        UPDATE_BUFFER,
+        WRITE_DYNAMIC_BUFFER,
+        SET_VERTEX_BUFFERS,
+        SET_INDEX_BUFFER,
+        SET_INPUT_LAYOUT,
+        SET_PRIMITIVE_TOPOLOGY,
+        SET_VERTEX_SHADER,
+        SET_VS_CONSTANT_BUFFERS,
+        SET_VS_CONSTANT_BUFFER_RANGES,
+        SET_PIXEL_SHADER,
+        SET_PS_CONSTANT_BUFFERS,
+        SET_PS_CONSTANT_BUFFER_RANGES,
+        SET_PS_SHADER_RESOURCES,
+        SET_PS_SAMPLERS,
+        DRAW_INDEXED,
+        DRAW_INDEXED_INSTANCED,
+        COUNT,
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   RecordedCommand
+
+      Summary:  One recorded command. Its arguments live in the object,
+                value and upload arrays of the recording backend,
+                starting at the given indices
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct RecordedCommand
+    {
+        eRenderCommand Type;
+        UINT uPass;
+        UINT uSlot;
+        UINT uCount;
+        UINT uFirstObject;
+        UINT uFirstValue;
+        UINT uFirstByte;
+        UINT uNumBytes;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   RenderPassStatistics
+
+      Summary:  Submission cost of one render pass of the last recorded
+                frame. State changes count every bind, viewport and
+                render target call, uploads every UpdateBuffer and
+                WriteDynamicBuffer call
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct RenderPassStatistics
+    {
+        std::wstring Name;
+        UINT uNumCommands;
+        UINT uNumDrawCalls;
+        UINT uNumStateChanges;
+        UINT uNumClears;
+        UINT uNumUploads;
+        UINT64 uUploadBytes;
+        UINT64 uNumIndices;
+        UINT64 uNumInstances;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    RecordingRenderBackend
+
+      Summary:  RenderBackend that records every command of a frame and
+                counts draws, state changes and uploaded bytes per pass.
+                Commands are optionally forwarded to another backend as
+                they are recorded, so the recorder can be put in front
+                of D3D11RenderBackend or used alone without a GPU.
+                Recorded objects are not referenced; a recorded frame
+                can only be replayed while its resources are alive
+
+      Methods:  GetCommands
+                  Returns the commands of the last frame
+                GetPassStatistics
+                  Returns the statistics of every pass of the last frame
+                GetFrameStatistics
+                  Returns the statistics of the whole last frame
+                GetNumFrames
+                  Returns the number of frames recorded so far
+                Replay
+                  Submits the recorded frame to another backend
+                ReportStatistics
+                  Writes the statistics of the last frame to the debug
+                  output
+                RecordingRenderBackend
+                  Constructor.
+                ~RecordingRenderBackend
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class RecordingRenderBackend final : public RenderBackend
+    {
+    public:
+        RecordingRenderBackend();
+        explicit RecordingRenderBackend(_In_ std::shared_ptr<RenderBackend> next);
+        RecordingRenderBackend(const RecordingRenderBackend& other) = delete;
+        RecordingRenderBackend(RecordingRenderBackend&& other) = delete;
+        RecordingRenderBackend& operator=(const RecordingRenderBackend& other) = delete;
+        RecordingRenderBackend& operator=(RecordingRenderBackend&& other) = delete;
+        ~RecordingRenderBackend() override = default;
+
+        const std::vector<RecordedCommand>& GetCommands() const;
+        const std::vector<RenderPassStatistics>& GetPassStatistics() const;
+        RenderPassStatistics GetFrameStatistics() const;
+        UINT64 GetNumFrames() const;
+        void Replay(_In_ RenderBackend& target) const;
+        void ReportStatistics() const;
+
+        void BeginFrame() override;
+        void EndFrame() override;
+        void BeginPass(_In_ PCWSTR pszPassName) override;
+        void EndPass() override;
+
+        void SetRenderTargets(_In_ UINT uNumViews, _In_reads_opt_(uNumViews) ID3D11RenderTargetView* const* ppRenderTargetViews, _In_opt_ ID3D11DepthStencilView* pDepthStencilView) override;
+        void SetViewports(_In_ UINT uNumViewports, _In_reads_(uNumViewports) const D3D11_VIEWPORT* pViewports) override;
+        void ClearRenderTargetView(_In_ ID3D11RenderTargetView* pRenderTargetView, _In_ const FLOAT aColorRGBA[4]) override;
+        void ClearDepthStencilView(_In_ ID3D11DepthStencilView* pDepthStencilView, _In_ UINT uClearFlags, _In_ FLOAT depth, _In_ UINT8 stencil) override;
+
+        void UpdateBuffer(_In_ ID3D11Buffer* pBuffer, _In_reads_bytes_(uDataSize) const void* pData, _In_ UINT uDataSize) override;
+        void WriteDynamicBuffer(_In_ ID3D11Buffer* pBuffer, _In_ UINT uOffset, _In_reads_bytes_(uDataSize) const void* pData, _In_ UINT uDataSize, _In_ BOOL bDiscard) override;
+        BOOL SupportsConstantBufferOffsets() const override;
+
+        void SetVertexBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppVertexBuffers, _In_reads_opt_(uNumBuffers) const UINT* puStrides, _In_reads_opt_(uNumBuffers) const UINT* puOffsets) override;
+        void SetIndexBuffer(_In_opt_ ID3D11Buffer* pIndexBuffer, _In_ DXGI_FORMAT format, _In_ UINT uOffset) override;
+        void SetInputLayout(_In_opt_ ID3D11InputLayout* pInputLayout) override;
+        void SetPrimitiveTopology(_In_ D3D11_PRIMITIVE_TOPOLOGY topology) override;
+
+        void SetVertexShader(_In_opt_ ID3D11VertexShader* pVertexShader) override;
+        void SetVSConstantBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers) override;
+        void SetVSConstantBufferRanges(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers, _In_reads_(uNumBuffers) const UINT* puFirstConstants, _In_reads_(uNumBuffers) const UINT* puNumConstants) override;
+        void SetPixelShader(_In_opt_ ID3D11PixelShader* pPixelShader) override;
+        void SetPSConstantBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers) override;
+        void SetPSConstantBufferRanges(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers, _In_reads_(uNumBuffers) const UINT* puFirstConstants, _In_reads_(uNumBuffers) const UINT* puNumConstants) override;
+        void SetPSShaderResources(_In_ UINT uStartSlot, _In_ UINT uNumViews, _In_reads_opt_(uNumViews) ID3D11ShaderResourceView* const* ppShaderResourceViews) override;
+        void SetPSSamplers(_In_ UINT uStartSlot, _In_ UINT uNumSamplers, _In_reads_opt_(uNumSamplers) ID3D11SamplerState* const* ppSamplers) override;
+
+        void DrawIndexed(_In_ UINT uIndexCount, _In_ UINT uStartIndexLocation, _In_ INT nBaseVertexLocation) override;
+        void DrawIndexedInstanced(_In_ UINT uIndexCountPerInstance, _In_ UINT uInstanceCount, _In_ UINT uStartIndexLocation, _In_ INT nBaseVertexLocation, _In_ UINT uStartInstanceLocation) override;
+
+    private:
+        RecordedCommand& record(_In_ eRenderCommand type, _In_ UINT uSlot, _In_ UINT uCount);
+        void recordObjects(_In_ UINT uCount, _In_reads_opt_(uCount) const void* const* ppObjects);
+        void recordValue(_In_ UINT uValue);
+        void recordValue(_In_ FLOAT value);
+
+    private:
+        std::shared_ptr<RenderBackend> m_next;
+        std::vector<RecordedCommand> m_commands;
+        std::vector<void*> m_objects;
+        std::vector<UINT> m_values;
+        std::vector<BYTE> m_uploads;
+        std::vector<RenderPassStatistics> m_passStatistics;
+        UINT m_uCurrentPass;
+        UINT64 m_uNumFrames;
+    };
+}
@@ -0,0 +1,104 @@
+/*+===================================================================
+  File:      RENDERBACKEND.H
+
+  Summary:   RenderBackend header file contains the declaration of the
+             interface Renderer submits its per-frame command stream
+             through. Resources are still Direct3D 11 objects created
+             on the device; the backend decides what to do with the
+             binds, uploads and draws that reference them.
+
+  Classes: RenderBackend
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    RenderBackend
+
+      Summary:  Abstract command submission interface between Renderer
+                and the graphics API
+
+      Methods:  BeginFrame / EndFrame
+                  Bracket the commands of one frame
+                BeginPass / EndPass
+                  Bracket the commands of one render pass
+                SetRenderTargets
+                SetViewports
+                ClearRenderTargetView
+                ClearDepthStencilView
+                  Output merger and rasterizer state
+                UpdateBuffer
+                  Uploads the given bytes into a buffer
+                WriteDynamicBuffer
+                  Writes bytes into a range of a dynamic buffer through
+                  a discarding or non-overwriting map
+                SupportsConstantBufferOffsets
+                  Returns whether constant buffers can be bound from an
+                  offset into a larger buffer
+                SetVertexBuffers
+                SetIndexBuffer
+                SetInputLayout
+                SetPrimitiveTopology
+                  Input assembler state
+                SetVertexShader
+                SetVSConstantBuffers
+                SetVSConstantBufferRanges
+                SetPixelShader
+                SetPSConstantBuffers
+                SetPSConstantBufferRanges
+                SetPSShaderResources
+                SetPSSamplers
+                  Shader stage state
+                DrawIndexed
+                DrawIndexedInstanced
+                  Issue draws
+                ~RenderBackend
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class RenderBackend
+    {
+    public:
+        RenderBackend() = default;
+        RenderBackend(const RenderBackend& other) = delete;
+        RenderBackend(RenderBackend&& other) = delete;
+        RenderBackend& operator=(const RenderBackend& other) = delete;
+        RenderBackend& operator=(RenderBackend&& other) = delete;
+        virtual ~RenderBackend() = default;
+
+        virtual void BeginFrame() = 0;
+        virtual void EndFrame() = 0;
+        virtual void BeginPass(_In_ PCWSTR pszPassName) = 0;
+        virtual void EndPass() = 0;
+
+        virtual void SetRenderTargets(_In_ UINT uNumViews, _In_reads_opt_(uNumViews) ID3D11RenderTargetView* const* ppRenderTargetViews, _In_opt_ ID3D11DepthStencilView* pDepthStencilView) = 0;
+        virtual void SetViewports(_In_ UINT uNumViewports, _In_reads_(uNumViewports) const D3D11_VIEWPORT* pViewports) = 0;
+        virtual void ClearRenderTargetView(_In_ ID3D11RenderTargetView* pRenderTargetView, _In_ const FLOAT aColorRGBA[4]) = 0;
+        virtual void ClearDepthStencilView(_In_ ID3D11DepthStencilView* pDepthStencilView, _In_ UINT uClearFlags, _In_ FLOAT depth, _In_ UINT8 stencil) = 0;
+
+        virtual void UpdateBuffer(_In_ ID3D11Buffer* pBuffer, _In_reads_bytes_(uDataSize) const void* pData, _In_ UINT uDataSize) = 0;
+        virtual void WriteDynamicBuffer(_In_ ID3D11Buffer* pBuffer, _In_ UINT uOffset, _In_reads_bytes_(uDataSize) const void* pData, _In_ UINT uDataSize, _In_ BOOL bDiscard) = 0;
+        virtual BOOL SupportsConstantBufferOffsets() const = 0;
+
+        virtual void SetVertexBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppVertexBuffers, _In_reads_opt_(uNumBuffers) const UINT* puStrides, _In_reads_opt_(uNumBuffers) const UINT* puOffsets) = 0;
+        virtual void SetIndexBuffer(_In_opt_ ID3D11Buffer* pIndexBuffer, _In_ DXGI_FORMAT format, _In_ UINT uOffset) = 0;
+        virtual void SetInputLayout(_In_opt_ ID3D11InputLayout* pInputLayout) = 0;
+        virtual void SetPrimitiveTopology(_In_ D3D11_PRIMITIVE_TOPOLOGY topology) = 0;
+
+        virtual void SetVertexShader(_In_opt_ ID3D11VertexShader* pVertexShader) = 0;
+        virtual void SetVSConstantBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers) = 0;
+        virtual void SetVSConstantBufferRanges(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers, _In_reads_(uNumBuffers) const UINT* puFirstConstants, _In_reads_(uNumBuffers) const UINT* puNumConstants) = 0;
+        virtual void SetPixelShader(_In_opt_ ID3D11PixelShader* pPixelShader) = 0;
+        virtual void SetPSConstantBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers) = 0;
+        virtual void SetPSConstantBufferRanges(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers, _In_reads_(uNumBuffers) const UINT* puFirstConstants, _In_reads_(uNumBuffers) const UINT* puNumConstants) = 0;
+        virtual void SetPSShaderResources(_In_ UINT uStartSlot, _In_ UINT uNumViews, _In_reads_opt_(uNumViews) ID3D11ShaderResourceView* const* ppShaderResourceViews) = 0;
+        virtual void SetPSSamplers(_In_ UINT uStartSlot, _In_ UINT uNumSamplers, _In_reads_opt_(uNumSamplers) ID3D11SamplerState* const* ppSamplers) = 0;
+
+        virtual void DrawIndexed(_In_ UINT uIndexCount, _In_ UINT uStartIndexLocation, _In_ INT nBaseVertexLocation) = 0;
+        virtual void DrawIndexedInstanced(_In_ UINT uIndexCountPerInstance, _In_ UINT uInstanceCount, _In_ UINT uStartIndexLocation, _In_ INT nBaseVertexLocation, _In_ UINT uStartInstanceLocation) = 0;
+    };
+}
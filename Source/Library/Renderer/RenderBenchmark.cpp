@@ -0,0 +1,78 @@
+#include "Renderer/RenderBenchmark.h"
+
+#include "Platform/Benchmark.h"
+
+namespace library
+{
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: BenchmarkSoftwareRenderer
+
+      Summary:  Renders frames with the software backend on 1, 2, 4...
+                threads up to the number of hardware threads and reports
+                the frames per second of each run to the debug output.
+                Initialize the renderer on the null device at the
+                resolution to measure, 1920x1080 for the reference
+                numbers, before calling this. The renderer must draw
+                through the given backend, and the backend keeps the
+                last thread count
+
+      Args:     Renderer& renderer
+                  Initialized renderer drawing through the backend
+                SoftwareRenderBackend& backend
+                  Backend under test
+                UINT uNumFrames
+                  Number of timed frames per thread count
+                std::vector<SoftwareRenderBenchmarkResult>& results
+                  Receives one result per thread count
+
+      Returns:  HRESULT
+                  Status code, E_INVALIDARG if the renderer does not use
+                  the backend or no frame is requested
+    -----------------------------------------------------------------F-F*/
+    HRESULT BenchmarkSoftwareRenderer(_In_ Renderer& renderer, _In_ SoftwareRenderBackend& backend, _In_ UINT uNumFrames, _Out_ std::vector<SoftwareRenderBenchmarkResult>& results)
+    {
+        results.clear();
+
+        if (renderer.GetRenderBackend().get() != &backend || uNumFrames == 0u)
+        {
+            return E_INVALIDARG;
+        }
+
+        for (UINT uNumThreads : GetBenchmarkThreadCounts())
+        {
+            backend.SetNumThreads(uNumThreads);
+
+            const FLOAT seconds = TimeBenchmarkRuns(
+                uNumFrames,
+                [&renderer]()
+                {
+                    renderer.Update(1.0f / 60.0f);
+                    renderer.Render();
+                }
+            );
+
+            SoftwareRenderBenchmarkResult result =
+            {
+                .uNumThreads = backend.GetNumThreads(),
+                .uNumFrames = uNumFrames,
+                .FramesPerSecond = GetBenchmarkRate(static_cast<FLOAT>(uNumFrames), seconds),
+                .MillisecondsPerFrame = seconds * 1000.0f / static_cast<FLOAT>(uNumFrames)
+            };
+            results.push_back(result);
+
+            const SoftwareRenderStatistics& statistics = backend.GetFrameStatistics();
+            ReportBenchmark(
+                L"software renderer  threads %2u  %8.2f fps  %8.2f ms/frame  draws %llu  triangles %llu  culled %llu  pixels %llu\n",
+                result.uNumThreads,
+                result.FramesPerSecond,
+                result.MillisecondsPerFrame,
+                static_cast<unsigned long long>(statistics.uNumDrawCalls),
+                static_cast<unsigned long long>(statistics.uNumTriangles),
+                static_cast<unsigned long long>(statistics.uNumCulledTriangles),
+                static_cast<unsigned long long>(statistics.uNumPixelsShaded)
+            );
+        }
+
+        return S_OK;
+    }
+}
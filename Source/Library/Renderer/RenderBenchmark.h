@@ -0,0 +1,38 @@
+/*+===================================================================
+  File:      RENDERBENCHMARK.H
+
+  Summary:   RenderBenchmark header file contains declarations of the
+             functions that measure how fast the software render
+             backend draws frames as the number of threads grows.
+
+  Classes: SoftwareRenderBenchmarkResult
+
+  Functions: BenchmarkSoftwareRenderer
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Renderer/Renderer.h"
+#include "Renderer/SoftwareRenderBackend.h"
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   SoftwareRenderBenchmarkResult
+
+      Summary:  Throughput of the software backend with one thread
+                count
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct SoftwareRenderBenchmarkResult
+    {
+        UINT uNumThreads;
+        UINT uNumFrames;
+        FLOAT FramesPerSecond;
+        FLOAT MillisecondsPerFrame;
+    };
+
+    HRESULT BenchmarkSoftwareRenderer(_In_ Renderer& renderer, _In_ SoftwareRenderBackend& backend, _In_ UINT uNumFrames, _Out_ std::vector<SoftwareRenderBenchmarkResult>& results);
+}
@@ -17,7 +17,8 @@ namespace library
                   Default color to shader the renderable
 
       Modifies: [m_vertexBuffer, m_indexBuffer, m_constantBuffer,
-                 m_normalBuffer, m_aMeshes, m_aMaterials, m_vertexShader,
+                 m_normalBuffer, m_aMeshes, m_aMeshBounds, m_bounds,
+                 m_aMaterials, m_vertexShader,
                  m_pixelShader, m_outputColor, m_world, m_bHasNormalMap
                  m_aNormalData].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
@@ -27,6 +28,8 @@ namespace library
         , m_constantBuffer(nullptr)
         , m_normalBuffer(nullptr)
         , m_aMeshes(std::vector<BasicMeshEntry>())
+        , m_aMeshBounds(std::vector<BoundingVolume>())
+        , m_bounds()
         , m_aMaterials(std::vector<std::shared_ptr<Material>>())
         , m_aNormalData(std::vector<NormalData>())
         , m_vertexShader(nullptr)
@@ -52,7 +55,7 @@ namespace library
                   File name of the texture to usen
 
       Modifies: [m_vertexBuffer, m_normalBuffer, m_indexBuffer
-                 m_constantBuffer].
+                 m_constantBuffer, m_aMeshBounds, m_bounds].
 
       Returns:  HRESULT
                   Status code
@@ -62,6 +65,8 @@ namespace library
         UNREFERENCED_PARAMETER(pImmediateContext);
         HRESULT hr = S_OK;
 
+        calculateBounds();
+
         // Create vertex buffer
         D3D11_BUFFER_DESC vBufferDesc =
         {
@@ -189,6 +194,42 @@ namespace library
         return hr;
     }
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderable::calculateBounds
+
+      Summary:  Bounds every basic mesh entry and the whole object from
+                the vertices their indices refer to. Skinned meshes are
+                bounded in their bind pose
+
+      Modifies: [m_aMeshBounds, m_bounds].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderable::calculateBounds()
+    {
+        const SimpleVertex* aVertices = getVertices();
+        const WORD* aIndices = getIndices();
+
+        m_aMeshBounds.clear();
+        m_aMeshBounds.reserve(m_aMeshes.size());
+        for (const BasicMeshEntry& mesh : m_aMeshes)
+        {
+            m_aMeshBounds.push_back(ComputeBoundingVolume(aVertices, mesh.uBaseVertex, aIndices, mesh.uBaseIndex, mesh.uNumIndices));
+        }
+
+        // Indices of a mesh are relative to its base vertex, so the
+        // object is bounded by its meshes when it has any
+        if (m_aMeshBounds.empty())
+        {
+            m_bounds = ComputeBoundingVolume(aVertices, 0u, aIndices, 0u, GetNumIndices());
+            return;
+        }
+
+        m_bounds = m_aMeshBounds[0];
+        for (SIZE_T i = 1u; i < m_aMeshBounds.size(); ++i)
+        {
+            m_bounds = MergeBoundingVolumes(m_bounds, m_aMeshBounds[i]);
+        }
+    }
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Renderable::calculateNormalMapVectors
 
@@ -541,6 +582,39 @@ namespace library
         return m_aMeshes[uIndex];
     }
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderable::GetBounds
+
+      Summary:  Returns the bounding volume of every index of the object
+                in object space
+
+      Returns:  const BoundingVolume&
+                  Bounding volume of the object
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const BoundingVolume& Renderable::GetBounds() const
+    {
+        return m_bounds;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderable::GetMeshBounds
+
+      Summary:  Returns the bounding volume of a basic mesh entry in
+                object space
+
+      Args:     UINT uIndex
+                  Index of the mesh
+
+      Returns:  const BoundingVolume&
+                  Bounding volume of the mesh
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const BoundingVolume& Renderable::GetMeshBounds(_In_ UINT uIndex) const
+    {
+        assert(uIndex < m_aMeshBounds.size());
+
+        return m_aMeshBounds[uIndex];
+    }
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Renderable::RotateX
 
@@ -13,6 +13,7 @@
 
 #include "Common.h"
 
+#include "Renderer/BoundingVolume.h"
 #include "Renderer/DataTypes.h"
 #include "Shader/PixelShader.h"
 #include "Shader/VertexShader.h"
@@ -39,6 +40,10 @@ namespace library
                   Returns the constant buffer
                 GetWorldMatrix
                   Returns the world matrix
+                GetBounds
+                  Returns the bounding volume of the whole object
+                GetMeshBounds
+                  Returns the bounding volume of a mesh
                 GetNumVertices
                   Pure virtual function that returns the number of
                   vertices
@@ -102,6 +107,8 @@ namespace library
         BOOL HasTexture() const;
         const std::shared_ptr<Material>& GetMaterial(UINT uIndex) const;
         const BasicMeshEntry& GetMesh(UINT uIndex) const;
+        const BoundingVolume& GetBounds() const;
+        const BoundingVolume& GetMeshBounds(_In_ UINT uIndex) const;
 
         void RotateX(_In_ FLOAT angle);
         void RotateY(_In_ FLOAT angle);
@@ -125,6 +132,7 @@ namespace library
             _In_ ID3D11DeviceContext* pImmediateContext
         );
 
+        void calculateBounds();
         void calculateNormalMapVectors();
         void calculateTangentBitangent(_In_ const SimpleVertex& v1, _In_ const SimpleVertex& v2, _In_ const SimpleVertex& v3, _Out_ XMFLOAT3& tangent, _Out_ XMFLOAT3& bitangent);
 
@@ -135,6 +143,8 @@ namespace library
         ComPtr<ID3D11Buffer> m_normalBuffer;
 
         std::vector<BasicMeshEntry> m_aMeshes;
+        std::vector<BoundingVolume> m_aMeshBounds;
+        BoundingVolume m_bounds;
         std::vector<std::shared_ptr<Material>> m_aMaterials;
         std::vector<NormalData> m_aNormalData;
 
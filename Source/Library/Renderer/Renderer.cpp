@@ -2,6 +2,32 @@
 
 namespace library
 {
+    namespace
+    {
+        constexpr FLOAT NEAR_PLANE = 0.01f;
+        constexpr FLOAT FAR_PLANE = 1000.0f;
+
+        // First bounds of an object the main pass draws without culling
+        constexpr UINT DRAW_UNCULLED = UINT_MAX;
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: getNumDraws
+
+          Summary:  Returns the number of draws the main pass makes of an
+                    object, one per mesh, or one for an untextured object
+
+          Args:     const Renderable& renderable
+                      The object
+
+          Returns:  UINT
+                      Number of draws
+        -----------------------------------------------------------------F-F*/
+        UINT getNumDraws(_In_ const Renderable& renderable)
+        {
+            return renderable.HasTexture() ? renderable.GetNumMeshes() : 1u;
+        }
+    }
+
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Renderer::Renderer
@@ -17,11 +43,13 @@ namespace library
         : m_driverType(D3D_DRIVER_TYPE_NULL)
         , m_featureLevel(D3D_FEATURE_LEVEL_11_0)
         , m_d3dDevice()
-        , m_d3dDevice1()
         , m_immediateContext()
+#if defined(_WIN32)
+        , m_d3dDevice1()
         , m_immediateContext1()
         , m_swapChain()
         , m_swapChain1()
+#endif
         , m_renderTargetView()
         , m_depthStencil()
         , m_depthStencilView()
@@ -32,11 +60,19 @@ namespace library
         , m_projection()
         , m_scenes()
         , m_invalidTexture(std::make_shared<Texture>(L"Content/Common/InvalidTexture.png"))
-        , m_cbShadowMatrix()
+        , m_viewport()
+        , m_backend()
+        , m_drawList()
+        , m_mainCuller()
+        , m_shadowCuller()
+        , m_threadPool(std::make_unique<ThreadPool>())
+        , m_constantBufferRing()
+        , m_shadowConstants()
     {
     }
 
 
+#if defined(_WIN32)
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Renderer::Initialize
 
@@ -193,6 +229,96 @@ namespace library
             return hr;
         }
 
+        return initializeResources(uWidth, uHeight);
+    }
+#endif
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::Initialize
+
+      Summary:  Uses the given device and renders into an offscreen
+                render target instead of a swap chain. This is how the
+                renderer runs headless, e.g. with CreateNullDevice
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the resources
+                ID3D11DeviceContext* pImmediateContext
+                  The Direct3D context to render with
+                UINT uWidth
+                UINT uHeight
+                  Size of the offscreen render target
+
+      Modifies: [m_d3dDevice, m_immediateContext, m_renderTargetView].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Renderer::Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext, _In_ UINT uWidth, _In_ UINT uHeight)
+    {
+        HRESULT hr = S_OK;
+
+        if (!pDevice || !pImmediateContext || uWidth == 0u || uHeight == 0u)
+        {
+            return E_INVALIDARG;
+        }
+
+        m_d3dDevice = pDevice;
+        m_immediateContext = pImmediateContext;
+
+        // Create the offscreen color buffer in place of the back buffer
+        D3D11_TEXTURE2D_DESC descColor =
+        {
+            .Width = uWidth,
+            .Height = uHeight,
+            .MipLevels = 1u,
+            .ArraySize = 1u,
+            .Format = DXGI_FORMAT_R8G8B8A8_UNORM,
+            .SampleDesc = {.Count = 1u, .Quality = 0u },
+            .Usage = D3D11_USAGE_DEFAULT,
+            .BindFlags = D3D11_BIND_RENDER_TARGET | D3D11_BIND_SHADER_RESOURCE,
+            .CPUAccessFlags = 0u,
+            .MiscFlags = 0u
+        };
+        ComPtr<ID3D11Texture2D> pColorBuffer;
+        hr = m_d3dDevice->CreateTexture2D(&descColor, nullptr, pColorBuffer.GetAddressOf());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        hr = m_d3dDevice->CreateRenderTargetView(pColorBuffer.Get(), nullptr, m_renderTargetView.GetAddressOf());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        return initializeResources(uWidth, uHeight);
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::initializeResources
+
+      Summary:  Creates the depth buffer, viewport, constant buffers and
+                shadow map, then initializes the main scene. Shared by
+                both Initialize overloads once a render target exists
+
+      Args:     UINT uWidth
+                UINT uHeight
+                  Size of the render target
+
+      Modifies: [m_depthStencil, m_depthStencilView, m_backend,
+                  m_viewport, m_cbChangeOnResize, m_projection, m_cbLights,
+                  m_constantBufferRing, m_shadowMapTexture].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Renderer::initializeResources(_In_ UINT uWidth, _In_ UINT uHeight)
+    {
+        HRESULT hr = S_OK;
+
         // Create depth stencil texture
         D3D11_TEXTURE2D_DESC descDepth =
         {
@@ -226,10 +352,17 @@ namespace library
             return hr;
         }
 
+        // Submit to the immediate context through a state cache unless a
+        // backend was set
+        if (!m_backend)
+        {
+            m_backend = std::make_shared<StateCacheRenderBackend>(std::make_shared<D3D11RenderBackend>(m_immediateContext.Get()));
+        }
+
         m_immediateContext->OMSetRenderTargets(1, m_renderTargetView.GetAddressOf(), m_depthStencilView.Get());
 
         // Setup the viewport
-        D3D11_VIEWPORT vp =
+        m_viewport =
         {
             .TopLeftX = 0.0f,
             .TopLeftY = 0.0f,
@@ -238,7 +371,7 @@ namespace library
             .MinDepth = 0.0f,
             .MaxDepth = 1.0f,
         };
-        m_immediateContext->RSSetViewports(1, &vp);
+        m_immediateContext->RSSetViewports(1, &m_viewport);
 
         // Set primitive topology
         m_immediateContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
@@ -258,7 +391,7 @@ namespace library
         }
 
         // Initialize the projection matrix
-        m_projection = XMMatrixPerspectiveFovLH(XM_PIDIV4, static_cast<FLOAT>(uWidth) / static_cast<FLOAT>(uHeight), 0.01f, 1000.0f);
+        m_projection = XMMatrixPerspectiveFovLH(XM_PIDIV4, static_cast<FLOAT>(uWidth) / static_cast<FLOAT>(uHeight), NEAR_PLANE, FAR_PLANE);
 
         // Update Projection Constant Buffer
         CBChangeOnResize cbChangesOnResize =
@@ -279,19 +412,9 @@ namespace library
         }
         m_camera.Initialize(m_d3dDevice.Get());
 
-        // Create the m_cbShadowMatrix constant buffers
-        bd =
-        {
-            .ByteWidth = sizeof(CBShadowMatrix),
-            .Usage = D3D11_USAGE_DEFAULT,
-            .BindFlags = D3D11_BIND_CONSTANT_BUFFER,
-            .CPUAccessFlags = 0
-        };
-        hr = m_d3dDevice->CreateBuffer(&bd, nullptr, m_cbShadowMatrix.GetAddressOf());
-        if (FAILED(hr))
-        {
-            return hr;
-        }
+        // Per-draw constants of both passes are allocated from the ring
+        m_constantBufferRing.Initialize(m_d3dDevice.Get());
+
         // Initialize m_shadowMapTexture variable using make_shared
         m_shadowMapTexture = std::make_shared<library::RenderTexture>(uWidth, uHeight);
 
@@ -316,6 +439,15 @@ namespace library
             return hr;
         }
 
+        // The first frame waits for the chunks around the camera
+        XMFLOAT3 eye;
+        XMStoreFloat3(&eye, m_camera.GetEye());
+        hr = m_scenes[m_pszMainSceneName]->StreamVoxels(m_d3dDevice.Get(), m_immediateContext.Get(), eye, TRUE);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
         hr = m_invalidTexture->Initialize(m_d3dDevice.Get(), m_immediateContext.Get());
         if (FAILED(hr))
         {
@@ -444,6 +576,14 @@ namespace library
         m_scenes[m_pszMainSceneName]->Update(deltaTime);
 
         m_camera.Update(deltaTime);
+
+        XMFLOAT3 eye;
+        XMStoreFloat3(&eye, m_camera.GetEye());
+        if (FAILED(m_scenes[m_pszMainSceneName]->StreamVoxels(m_d3dDevice.Get(), m_immediateContext.Get(), eye, FALSE)))
+        {
+            // The failed columns are requested again on a later frame
+            OutputDebugString(L"Renderer: could not create the buffers of streamed voxel chunks\n");
+        }
     }
 
 
@@ -454,14 +594,20 @@ namespace library
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     void Renderer::Render()
     {
+        m_backend->BeginFrame();
+        m_backend->SetViewports(1u, &m_viewport);
+        m_constantBufferRing.BeginFrame(*m_backend);
+
         // Before real rendering, render the scene from light's viewport
         RenderSceneToTexture();
 
+        m_backend->BeginPass(L"Main");
+
         // Clear the back buffer
-        m_immediateContext->ClearRenderTargetView(m_renderTargetView.Get(), Colors::MidnightBlue);
+        m_backend->ClearRenderTargetView(m_renderTargetView.Get(), Colors::MidnightBlue);
 
         // Clear the depth buffer to 1.0 (max depth)
-        m_immediateContext->ClearDepthStencilView(m_depthStencilView.Get(), D3D11_CLEAR_DEPTH, 1.0f, 0u);
+        m_backend->ClearDepthStencilView(m_depthStencilView.Get(), D3D11_CLEAR_DEPTH, 1.0f, 0u);
 
         // Update camera constant buffer
         CBChangeOnCameraMovement cbChangeOnCameraMovement =
@@ -469,7 +615,7 @@ namespace library
             .View = XMMatrixTranspose(m_camera.GetView()),
         };
         XMStoreFloat4(&cbChangeOnCameraMovement.CameraPosition, m_camera.GetEye());
-        m_immediateContext->UpdateSubresource(m_camera.GetConstantBuffer().Get(), 0u, nullptr, &cbChangeOnCameraMovement, 0u, 0u);
+        m_backend->UpdateBuffer(m_camera.GetConstantBuffer().Get(), &cbChangeOnCameraMovement, sizeof(cbChangeOnCameraMovement));
 
 
         // Update lights constant buffer
@@ -490,30 +636,83 @@ namespace library
             cbLights.LightViews[i] = XMMatrixTranspose(m_scenes[m_pszMainSceneName]->GetPointLight(i)->GetViewMatrix());
             cbLights.LightProjections[i] = XMMatrixTranspose(m_scenes[m_pszMainSceneName]->GetPointLight(i)->GetProjectionMatrix());
         }
-        m_immediateContext->UpdateSubresource(m_cbLights.Get(), 0u, nullptr, &cbLights, 0u, 0u);
+        m_backend->UpdateBuffer(m_cbLights.Get(), &cbLights, sizeof(cbLights));
+
+        // Bind the topology and the constant buffers every object of the
+        // pass shares once
+        m_backend->SetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+        m_backend->SetVSConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
+        m_backend->SetVSConstantBuffers(1u, 1u, m_cbChangeOnResize.GetAddressOf());
+        m_backend->SetVSConstantBuffers(3u, 1u, m_cbLights.GetAddressOf());
+        m_backend->SetPSConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
+        m_backend->SetPSConstantBuffers(1u, 1u, m_cbChangeOnResize.GetAddressOf());
+        m_backend->SetPSConstantBuffers(3u, 1u, m_cbLights.GetAddressOf());
+
+        // The shaders read the shadow map from slot 2 or slot 4, so bind
+        // it to both once for the whole pass
+        if (m_shadowMapTexture != nullptr)
+        {
+            m_backend->SetPSShaderResources(2u, 1u, m_shadowMapTexture->GetShaderResourceView().GetAddressOf());
+            m_backend->SetPSSamplers(2u, 1u, m_shadowMapTexture->GetSamplerState().GetAddressOf());
+            m_backend->SetPSShaderResources(4u, 1u, m_shadowMapTexture->GetShaderResourceView().GetAddressOf());
+            m_backend->SetPSSamplers(4u, 1u, m_shadowMapTexture->GetSamplerState().GetAddressOf());
+        }
 
+        // Cull every draw against the camera frustum first, so objects
+        // out of view write no constants. The bounds are added in the
+        // order the objects are visited below
+        const XMMATRIX viewProjection = m_camera.GetView() * m_projection;
+        m_mainCuller.Clear();
+        m_mainCuller.SetFrustum(viewProjection);
 
-        // For all renderables
-        std::unordered_map<std::wstring, std::shared_ptr<Renderable>>::iterator renderable;
-        for (renderable = m_scenes[m_pszMainSceneName]->GetRenderables().begin(); renderable != m_scenes[m_pszMainSceneName]->GetRenderables().end(); ++renderable)
-        {
-            // Set the vertex buffer
-            UINT uStride = sizeof(SimpleVertex);
-            UINT uOffset = 0u;
-            m_immediateContext->IASetVertexBuffers(0u, 1u, renderable->second->GetVertexBuffer().GetAddressOf(), &uStride, &uOffset);
+        XMFLOAT3 eye;
+        XMStoreFloat3(&eye, m_camera.GetEye());
 
-            // Set the normal buffer
-            uStride = sizeof(NormalData);
-            m_immediateContext->IASetVertexBuffers(1u, 1u, renderable->second->GetNormalBuffer().GetAddressOf(), &uStride, &uOffset);
+        // Chunks hidden behind solid cells are left out before any
+        // bounds are added, in the bounds and in the draws alike
+        m_scenes[m_pszMainSceneName]->CullOccludedVoxels(eye, m_mainCuller);
 
-            // Set the index buffer
-            m_immediateContext->IASetIndexBuffer(renderable->second->GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0u);
+        // The nodes of the heightfield in view are its meshes, so they
+        // are selected for the camera before its bounds are added. If
+        // its vertices cannot be written it has no meshes to draw
+        if (m_scenes[m_pszMainSceneName]->GetHeightfield() != nullptr)
+        {
+            HeightfieldTerrain* pHeightfield = m_scenes[m_pszMainSceneName]->GetHeightfield().get();
+            pHeightfield->SelectNodes(eye, m_mainCuller);
+            pHeightfield->BuildVertices();
+            pHeightfield->Upload(m_d3dDevice.Get(), *m_backend);
+        }
 
-            // Set primitive topology
-            m_immediateContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+        for (const auto& renderablePair : m_scenes[m_pszMainSceneName]->GetRenderables())
+        {
+            addDrawBounds(renderablePair.second.get());
+        }
+        for (const std::shared_ptr<Voxel>& voxelPtr : m_scenes[m_pszMainSceneName]->GetVoxels())
+        {
+            if (!voxelPtr->IsOccluded())
+            {
+                addDrawBounds(voxelPtr.get());
+            }
+        }
+        for (const auto& modelPair : m_scenes[m_pszMainSceneName]->GetModels())
+        {
+            addDrawBounds(modelPair.second.get());
+        }
+        m_mainCuller.Cull();
 
-            // Set the input layout
-            m_immediateContext->IASetInputLayout(renderable->second->GetVertexLayout().Get());
+        m_drawList.Clear();
+        UINT uBounds = 0u;
+
+        // For all renderables
+        std::unordered_map<std::wstring, std::shared_ptr<Renderable>>::iterator renderable;
+        for (renderable = m_scenes[m_pszMainSceneName]->GetRenderables().begin(); renderable != m_scenes[m_pszMainSceneName]->GetRenderables().end(); ++renderable)
+        {
+            const UINT uFirstBounds = uBounds;
+            uBounds += getNumDraws(*renderable->second);
+            if (!m_mainCuller.IsAnyVisible(uFirstBounds, uBounds - uFirstBounds))
+            {
+                continue;
+            }
 
             // Update renderable constant buffer
             CBChangesEveryFrame cbChangesEveryFrame =
@@ -522,93 +721,42 @@ namespace library
                 .OutputColor = renderable->second->GetOutputColor(),
                 .HasNormalMap = renderable->second->HasNormalMap()
             };
-            m_immediateContext->UpdateSubresource(renderable->second->GetConstantBuffer().Get(), 0u, nullptr, &cbChangesEveryFrame, 0u, 0u);
-
-            // Set the vertex shader and constant buffers
-            m_immediateContext->VSSetShader(renderable->second->GetVertexShader().Get(), nullptr, 0u);
-            m_immediateContext->VSSetConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
-            m_immediateContext->VSSetConstantBuffers(1u, 1u, m_cbChangeOnResize.GetAddressOf());
-            m_immediateContext->VSSetConstantBuffers(2u, 1u, renderable->second->GetConstantBuffer().GetAddressOf());
-            m_immediateContext->VSSetConstantBuffers(3u, 1u, m_cbLights.GetAddressOf());
-
+            const ConstantBufferAllocation constants = m_constantBufferRing.Allocate(&cbChangesEveryFrame, sizeof(cbChangesEveryFrame));
 
-            // Set the pixel shader and constant buffers
-            m_immediateContext->PSSetShader(renderable->second->GetPixelShader().Get(), nullptr, 0u);
-            m_immediateContext->PSSetConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
-            m_immediateContext->PSSetConstantBuffers(2u, 1u, renderable->second->GetConstantBuffer().GetAddressOf());
-            m_immediateContext->PSSetConstantBuffers(3u, 1u, m_cbLights.GetAddressOf());
-
-            if (renderable->second->HasTexture())
-            {
-                for (UINT i = 0u; i < renderable->second->GetNumMeshes(); ++i)
-                {
-                    const UINT materialIndex = renderable->second->GetMesh(i).uMaterialIndex;
-                    if (renderable->second->GetMaterial(materialIndex)->pDiffuse)
-                    {
-                        // Set texture resource view of the renderable into the pixel shader
-                        m_immediateContext->PSSetShaderResources(0u, 1u, renderable->second->GetMaterial(materialIndex)->pDiffuse->GetTextureResourceView().GetAddressOf());
-
-                        // Set sampler state of the renderable into the pixel shader
-                        eTextureSamplerType textureSamplerType = renderable->second->GetMaterial(materialIndex)->pDiffuse->GetSamplerType();
-                        m_immediateContext->PSSetSamplers(0u, 1u,
-                            Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
-                    }
-                    if (renderable->second->GetMaterial(materialIndex)->pNormal)
-                    {
-                        // Set texture resource view of the renderable into the pixel shader
-                        m_immediateContext->PSSetShaderResources(1u, 1u, renderable->second->GetMaterial(materialIndex)->pNormal->GetTextureResourceView().GetAddressOf());
-
-                        // Set sampler state of the renderable into the pixel shader
-                        eTextureSamplerType textureSamplerType = renderable->second->GetMaterial(materialIndex)->pDiffuse->GetSamplerType();
-                        m_immediateContext->PSSetSamplers(1u, 1u,
-                            Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
-                    }
-
-                    if (m_shadowMapTexture != nullptr)
-                    {
-                        m_immediateContext->PSSetShaderResources(4u, 1u, m_shadowMapTexture->GetShaderResourceView().GetAddressOf());
-                        m_immediateContext->PSSetSamplers(4u, 1u, m_shadowMapTexture->GetSamplerState().GetAddressOf());
-                    }
-                    // Bind texture and sampler state of the shadow map m_shadowMapTexture
-
-                    // Render the triangles
-                    m_immediateContext->DrawIndexed(renderable->second->GetMesh(i).uNumIndices,
-                        renderable->second->GetMesh(i).uBaseIndex,
-                        renderable->second->GetMesh(i).uBaseVertex);
-                }
-            }
-            else
-            {
-                // Render the triangles
-                m_immediateContext->DrawIndexed(renderable->second->GetNumIndices(), 0u, 0);
-            }
+            addDraws(renderable->second.get(), eDrawSource::RENDERABLE, eDrawPass::OPAQUE_GEOMETRY, uFirstBounds, constants, ConstantBufferAllocation{});
         }
 
         // For all voxels in main scene
         std::vector<std::shared_ptr<Voxel>>::iterator voxel;
         for (voxel = m_scenes[m_pszMainSceneName]->GetVoxels().begin(); voxel != m_scenes[m_pszMainSceneName]->GetVoxels().end(); ++voxel)
         {
-            // Set the vertex buffer
-            UINT uStride = sizeof(SimpleVertex);
-            UINT uOffset = 0u;
-            m_immediateContext->IASetVertexBuffers(0u, 1u, voxel->get()->GetVertexBuffer().GetAddressOf(), &uStride, &uOffset);
-
-            // Set the normal buffer
-            uStride = sizeof(NormalData);
-            m_immediateContext->IASetVertexBuffers(1u, 1u, voxel->get()->GetNormalBuffer().GetAddressOf(), &uStride, &uOffset);
-
-            // Set the instance buffer
-            uStride = sizeof(InstanceData);
-            m_immediateContext->IASetVertexBuffers(2u, 1u, voxel->get()->GetInstanceBuffer().GetAddressOf(), &uStride, &uOffset);
-
-            // Set the index buffer
-            m_immediateContext->IASetIndexBuffer(voxel->get()->GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0u);
+            if (voxel->get()->IsOccluded())
+            {
+                continue;
+            }
 
-            // Set primitive topology
-            m_immediateContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+            const UINT uFirstBounds = uBounds;
+            uBounds += getNumDraws(**voxel);
+            if (!m_mainCuller.IsAnyVisible(uFirstBounds, uBounds - uFirstBounds))
+            {
+                continue;
+            }
 
-            // Set the input layout
-            m_immediateContext->IASetInputLayout(voxel->get()->GetVertexLayout().Get());
+            // Write the instances in view to the front of the instance
+            // buffer, the draw instances only those. A voxel of one
+            // instance, like a chunk, was culled whole above
+            if (voxel->get()->HasInstancesToCull())
+            {
+                const UINT uNumVisibleInstances = voxel->get()->CullInstances(viewProjection, m_threadPool.get());
+                if (uNumVisibleInstances == 0u)
+                {
+                    continue;
+                }
+                if (voxel->get()->HaveVisibleInstancesChanged())
+                {
+                    m_backend->WriteDynamicBuffer(voxel->get()->GetInstanceBuffer().Get(), 0u, voxel->get()->GetVisibleInstanceData(), uNumVisibleInstances * static_cast<UINT>(sizeof(InstanceData)), TRUE);
+                }
+            }
 
             // Update voxel constant buffer
             CBChangesEveryFrame cbChangesEveryFrame =
@@ -617,93 +765,21 @@ namespace library
                 .OutputColor = voxel->get()->GetOutputColor(),
                 .HasNormalMap = voxel->get()->HasNormalMap()
             };
-            m_immediateContext->UpdateSubresource(voxel->get()->GetConstantBuffer().Get(), 0u, nullptr, &cbChangesEveryFrame, 0u, 0u);
-
-            // Set the vertex shader and constant buffers
-            m_immediateContext->VSSetShader(voxel->get()->GetVertexShader().Get(), nullptr, 0u);
-            m_immediateContext->VSSetConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
-            m_immediateContext->VSSetConstantBuffers(1u, 1u, m_cbChangeOnResize.GetAddressOf());
-            m_immediateContext->VSSetConstantBuffers(2u, 1u, voxel->get()->GetConstantBuffer().GetAddressOf());
+            const ConstantBufferAllocation constants = m_constantBufferRing.Allocate(&cbChangesEveryFrame, sizeof(cbChangesEveryFrame));
 
-            // Set the pixel shader and constant buffers
-            m_immediateContext->PSSetShader(voxel->get()->GetPixelShader().Get(), nullptr, 0u);
-            m_immediateContext->PSSetConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
-            m_immediateContext->PSSetConstantBuffers(2u, 1u, voxel->get()->GetConstantBuffer().GetAddressOf());
-            m_immediateContext->PSSetConstantBuffers(3u, 1u, m_cbLights.GetAddressOf());
-
-          
-
-            if (voxel->get()->HasTexture())
-            {
-                for (UINT i = 0u; i < voxel->get()->GetNumMeshes(); ++i)
-                {
-                    const UINT materialIndex = voxel->get()->GetMesh(i).uMaterialIndex;
-                    if (voxel->get()->GetMaterial(materialIndex)->pDiffuse)
-                    {
-                        // Set texture resource view of the renderable into the pixel shader
-                        m_immediateContext->PSSetShaderResources(0u, 1u, voxel->get()->GetMaterial(materialIndex)->pDiffuse->GetTextureResourceView().GetAddressOf());
-
-                        // Set sampler state of the renderable into the pixel shader
-                        eTextureSamplerType textureSamplerType = voxel->get()->GetMaterial(materialIndex)->pDiffuse->GetSamplerType();
-                        m_immediateContext->PSSetSamplers(0u, 1u,
-                            Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
-                    }
-                    if (voxel->get()->GetMaterial(materialIndex)->pNormal)
-                    {
-                        // Set texture resource view of the renderable into the pixel shader
-                        m_immediateContext->PSSetShaderResources(1u, 1u, voxel->get()->GetMaterial(materialIndex)->pNormal->GetTextureResourceView().GetAddressOf());
-
-                        // Set sampler state of the renderable into the pixel shader
-                        eTextureSamplerType textureSamplerType = voxel->get()->GetMaterial(materialIndex)->pDiffuse->GetSamplerType();
-                        m_immediateContext->PSSetSamplers(1u, 1u,
-                            Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
-                    }
-
-                    if (m_shadowMapTexture != nullptr)
-                    {
-                        m_immediateContext->PSSetShaderResources(2u, 1u, m_shadowMapTexture->GetShaderResourceView().GetAddressOf());
-                        m_immediateContext->PSSetSamplers(2u, 1u, m_shadowMapTexture->GetSamplerState().GetAddressOf());
-                    }
-                    // Render the triangles
-                    m_immediateContext->DrawIndexedInstanced(voxel->get()->GetMesh(i).uNumIndices,
-                        voxel->get()->GetNumInstances(),
-                        voxel->get()->GetMesh(i).uBaseIndex,
-                        voxel->get()->GetMesh(i).uBaseVertex,
-                        0u);
-                }
-            }
-            else
-            {
-                // Render the triangles
-                m_immediateContext->DrawIndexedInstanced(voxel->get()->GetNumIndices(), voxel->get()->GetNumInstances(), 0u, 0, 0u);
-            }
+            addDraws(voxel->get(), eDrawSource::VOXEL, eDrawPass::OPAQUE_GEOMETRY, uFirstBounds, constants, ConstantBufferAllocation{});
         }
 
         // For all models
         std::unordered_map<std::wstring, std::shared_ptr<Model>>::iterator model;
         for (model = m_scenes[m_pszMainSceneName]->GetModels().begin(); model != m_scenes[m_pszMainSceneName]->GetModels().end(); ++model)
         {
-            // Set the vertex buffer
-            UINT uStride = sizeof(SimpleVertex);
-            UINT uOffset = 0u;
-            m_immediateContext->IASetVertexBuffers(0u, 1u, model->second->GetVertexBuffer().GetAddressOf(), &uStride, &uOffset);
-
-            // Set the normal buffer
-            uStride = sizeof(NormalData);
-            m_immediateContext->IASetVertexBuffers(1u, 1u, model->second->GetNormalBuffer().GetAddressOf(), &uStride, &uOffset);
-
-            // Set the animation buffer
-            uStride = sizeof(AnimationData);
-            m_immediateContext->IASetVertexBuffers(3u, 1u, model->second->GetAnimationBuffer().GetAddressOf(), &uStride, &uOffset);
-
-            // Set the index buffer
-            m_immediateContext->IASetIndexBuffer(model->second->GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0u);
-
-            // Set primitive topology
-            m_immediateContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-
-            // Set the input layout
-            m_immediateContext->IASetInputLayout(model->second->GetVertexLayout().Get());
+            const UINT uFirstBounds = uBounds;
+            uBounds += getNumDraws(*model->second);
+            if (!m_mainCuller.IsAnyVisible(uFirstBounds, uBounds - uFirstBounds))
+            {
+                continue;
+            }
 
             // Update renderable constant buffer
             CBChangesEveryFrame cbChangesEveryFrame =
@@ -712,7 +788,7 @@ namespace library
                 .OutputColor = model->second->GetOutputColor(),
                 .HasNormalMap = model->second->HasNormalMap()
             };
-            m_immediateContext->UpdateSubresource(model->second->GetConstantBuffer().Get(), 0u, nullptr, &cbChangesEveryFrame, 0u, 0u);
+            const ConstantBufferAllocation constants = m_constantBufferRing.Allocate(&cbChangesEveryFrame, sizeof(cbChangesEveryFrame));
 
             // Update skinning constant buffer
             CBSkinning cbSkinning = {};
@@ -720,78 +796,15 @@ namespace library
             {
                 cbSkinning.BoneTransforms[i] = XMMatrixTranspose(model->second->GetBoneTransforms()[i]);
             }
-            m_immediateContext->UpdateSubresource(model->second->GetSkinningConstantBuffer().Get(), 0u, nullptr, &cbSkinning, 0u, 0u);
-
-            // Set the vertex shader and constant buffers
-            m_immediateContext->VSSetShader(model->second->GetVertexShader().Get(), nullptr, 0u);
-            m_immediateContext->VSSetConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
-            m_immediateContext->VSSetConstantBuffers(1u, 1u, m_cbChangeOnResize.GetAddressOf());
-            m_immediateContext->VSSetConstantBuffers(2u, 1u, model->second->GetConstantBuffer().GetAddressOf());
-            m_immediateContext->VSSetConstantBuffers(4u, 1u, model->second->GetSkinningConstantBuffer().GetAddressOf());
-
-            // Set the pixel shader and constant buffers
-            m_immediateContext->PSSetShader(model->second->GetPixelShader().Get(), nullptr, 0u);
-            m_immediateContext->PSSetConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
-            m_immediateContext->PSSetConstantBuffers(2u, 1u, model->second->GetConstantBuffer().GetAddressOf());
-            m_immediateContext->PSSetConstantBuffers(3u, 1u, m_cbLights.GetAddressOf());
-
-            if (model->second->HasTexture())
-            {
-                for (UINT i = 0u; i < model->second->GetNumMeshes(); ++i)
-                {
-                    const UINT materialIndex = model->second->GetMesh(i).uMaterialIndex;
-                    if (model->second->GetMaterial(materialIndex)->pDiffuse)
-                    {
-                        // Set texture resource view of the renderable into the pixel shader
-                        m_immediateContext->PSSetShaderResources(0u, 1u, model->second->GetMaterial(materialIndex)->pDiffuse->GetTextureResourceView().GetAddressOf());
-
-                        // Set sampler state of the renderable into the pixel shader
-                        eTextureSamplerType textureSamplerType = model->second->GetMaterial(materialIndex)->pDiffuse->GetSamplerType();
-                        m_immediateContext->PSSetSamplers(0u, 1u,
-                            Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
-                    }
-                    if (model->second->GetMaterial(materialIndex)->pNormal)
-                    {
-                        // Set texture resource view of the renderable into the pixel shader
-                        m_immediateContext->PSSetShaderResources(1u, 1u, model->second->GetMaterial(materialIndex)->pNormal->GetTextureResourceView().GetAddressOf());
-
-                        // Set sampler state of the renderable into the pixel shader
-                        eTextureSamplerType textureSamplerType = model->second->GetMaterial(materialIndex)->pDiffuse->GetSamplerType();
-                        m_immediateContext->PSSetSamplers(1u, 1u,
-                            Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
-                    }
-                    if (m_shadowMapTexture != nullptr)
-                    {
-                        m_immediateContext->PSSetShaderResources(2u, 1u, m_shadowMapTexture->GetShaderResourceView().GetAddressOf());
-                        m_immediateContext->PSSetSamplers(2u, 1u, m_shadowMapTexture->GetSamplerState().GetAddressOf());
-                    }
-                    // Render the triangles
-                    m_immediateContext->DrawIndexed(model->second->GetMesh(i).uNumIndices,
-                        model->second->GetMesh(i).uBaseIndex,
-                        model->second->GetMesh(i).uBaseVertex);
-                }
-            }
+            const ConstantBufferAllocation skinning = m_constantBufferRing.Allocate(&cbSkinning, sizeof(cbSkinning));
 
-            else
-            {
-                // Render the triangles
-                m_immediateContext->DrawIndexed(model->second->GetNumIndices(), 0u, 0);
-            }
+            addDraws(model->second.get(), eDrawSource::MODEL, eDrawPass::OPAQUE_GEOMETRY, uFirstBounds, constants, skinning);
         }
 
-
-        // To render a skybox
+        // To render a skybox, which surrounds the camera and is never
+        // culled
         if (m_scenes[m_pszMainSceneName]->GetSkyBox() != nullptr)
         {
-            // Set the vertex buffer
-            UINT uStride = sizeof(SimpleVertex);
-            UINT uOffset = 0u;
-            m_immediateContext->IASetVertexBuffers(0u, 1u, m_scenes[m_pszMainSceneName]->GetSkyBox()->GetVertexBuffer().GetAddressOf(), &uStride, &uOffset);
-            // Set the index buffer
-            m_immediateContext->IASetIndexBuffer(m_scenes[m_pszMainSceneName]->GetSkyBox()->GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0u);
-            // Set the input layout
-            m_immediateContext->IASetInputLayout(m_scenes[m_pszMainSceneName]->GetSkyBox()->GetVertexLayout().Get());
-
             XMMATRIX cameraPosition = XMMatrixTranslation(XMVectorGetX(m_camera.GetEye()), XMVectorGetY(m_camera.GetEye()), XMVectorGetZ(m_camera.GetEye()));
             // Update renderable constant buffer
             CBChangesEveryFrame cbChangesEveryFrame =
@@ -801,64 +814,312 @@ namespace library
                 .OutputColor = m_scenes[m_pszMainSceneName]->GetSkyBox()->GetOutputColor(),
                 .HasNormalMap = m_scenes[m_pszMainSceneName]->GetSkyBox()->HasNormalMap()
             };
-            m_immediateContext->UpdateSubresource(m_scenes[m_pszMainSceneName]->GetSkyBox()->GetConstantBuffer().Get(), 0u, nullptr, &cbChangesEveryFrame, 0u, 0u);
-
-            // Set the shaders and their corresponding constant buffers
-            // Set the vertex shader and constant buffers
-            m_immediateContext->VSSetShader(m_scenes[m_pszMainSceneName]->GetSkyBox()->GetVertexShader().Get(), nullptr, 0u);
-            m_immediateContext->VSSetConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
-            m_immediateContext->VSSetConstantBuffers(1u, 1u, m_cbChangeOnResize.GetAddressOf());
-            m_immediateContext->VSSetConstantBuffers(2u, 1u, m_scenes[m_pszMainSceneName]->GetSkyBox()->GetConstantBuffer().GetAddressOf());
-
-            // Set the pixel shader and constant buffers
-            m_immediateContext->PSSetShader(m_scenes[m_pszMainSceneName]->GetSkyBox()->GetPixelShader().Get(), nullptr, 0u);
-            m_immediateContext->PSSetConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
-            m_immediateContext->PSSetConstantBuffers(1u, 1u, m_cbChangeOnResize.GetAddressOf());
-            m_immediateContext->PSSetConstantBuffers(2u, 1u, m_scenes[m_pszMainSceneName]->GetSkyBox()->GetConstantBuffer().GetAddressOf());
-
-            if (m_scenes[m_pszMainSceneName]->GetSkyBox()->HasTexture())
+            const ConstantBufferAllocation constants = m_constantBufferRing.Allocate(&cbChangesEveryFrame, sizeof(cbChangesEveryFrame));
+
+            addDraws(m_scenes[m_pszMainSceneName]->GetSkyBox().get(), eDrawSource::SKYBOX, eDrawPass::SKY, DRAW_UNCULLED, constants, ConstantBufferAllocation{});
+        }
+
+        // Upload the constants of every draw before the first one
+        m_constantBufferRing.Flush(*m_backend);
+
+        // Draw grouped by shaders and materials, front to back inside a
+        // group, and the sky last
+        m_drawList.Sort();
+        for (UINT i = 0u; i < m_drawList.GetNumDraws(); ++i)
+        {
+            submitDraw(m_drawList.GetDraw(i));
+        }
+
+        m_backend->EndPass();
+        m_backend->EndFrame();
+
+#if defined(_WIN32)
+        // Present the information rendered to the back buffer to the front buffer
+        if (m_swapChain)
+        {
+            m_swapChain->Present(0u, 0u);
+        }
+#endif
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::addDrawBounds
+
+      Summary:  Adds the bounds of every draw addDraws makes of the
+                object to the main pass culler, in world space
+
+      Args:     Renderable* pRenderable
+                  Object to cull
+
+      Modifies: [m_mainCuller].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::addDrawBounds(_In_ Renderable* pRenderable)
+    {
+        if (!pRenderable->HasTexture())
+        {
+            m_mainCuller.AddBounds(pRenderable->GetBounds(), pRenderable->GetWorldMatrix());
+            return;
+        }
+
+        for (UINT i = 0u; i < pRenderable->GetNumMeshes(); ++i)
+        {
+            m_mainCuller.AddBounds(pRenderable->GetMeshBounds(i), pRenderable->GetWorldMatrix());
+        }
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::getNormalizedDepth
+
+      Summary:  Returns the view depth of the center of the world
+                bounds of a draw, divided by the far plane and clamped
+                to [0, 1]. The bounds of a culled draw are already in
+                the main pass culler, those of an unculled one are
+                moved into the world here
+
+      Args:     const Renderable* pRenderable
+                  Object the draw comes from
+                UINT uFirstBounds
+                  Number of the bounds of the first draw of the object
+                  in the main pass culler, or DRAW_UNCULLED
+                UINT uMesh
+                  Mesh of the draw, or DRAW_WHOLE_RENDERABLE
+
+      Returns:  FLOAT
+                  Depth for DrawList::MakeSortKey
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT Renderer::getNormalizedDepth(_In_ const Renderable* pRenderable, _In_ UINT uFirstBounds, _In_ UINT uMesh) const
+    {
+        XMVECTOR worldCenter;
+        if (uFirstBounds != DRAW_UNCULLED)
+        {
+            worldCenter = m_mainCuller.GetCenter(uFirstBounds + (uMesh == DRAW_WHOLE_RENDERABLE ? 0u : uMesh));
+        }
+        else
+        {
+            const BoundingVolume& bounds = uMesh == DRAW_WHOLE_RENDERABLE ? pRenderable->GetBounds() : pRenderable->GetMeshBounds(uMesh);
+            const BoundingVolume worldBounds = TransformBoundingVolume(bounds, pRenderable->GetWorldMatrix());
+            worldCenter = XMLoadFloat3(&worldBounds.Center);
+        }
+
+        const FLOAT normalizedDepth = XMVectorGetZ(XMVector3TransformCoord(worldCenter, m_camera.GetView())) / FAR_PLANE;
+
+        // NaN fails both comparisons and MakeSortKey puts it in front
+        return std::clamp(normalizedDepth, 0.0f, 1.0f);
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::addDraws
+
+      Summary:  Adds a draw for every visible mesh of the object to the
+                draw list, or one draw for the whole object if it has no
+                textures. The keys hold the pass, the shaders, the
+                textures of the mesh and the view depth of the center
+                of the mesh, so the meshes of a large model, and the
+                chunks of the terrain whose vertices are already in
+                world space, are ordered front to back among themselves
+
+      Args:     Renderable* pRenderable
+                  Object to draw, of the type the source names
+                eDrawSource source
+                  Kind of the object
+                eDrawPass pass
+                  Bucket of the main pass to draw in
+                UINT uFirstBounds
+                  Number of the bounds of the first draw of the object
+                  in the main pass culler, or DRAW_UNCULLED
+                const ConstantBufferAllocation& constants
+                  Constants of the object
+                const ConstantBufferAllocation& skinning
+                  Skinning constants of a model
+
+      Modifies: [m_drawList].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::addDraws(_In_ Renderable* pRenderable, _In_ eDrawSource source, _In_ eDrawPass pass, _In_ UINT uFirstBounds, _In_ const ConstantBufferAllocation& constants, _In_ const ConstantBufferAllocation& skinning)
+    {
+        const UINT uProgram = m_drawList.GetProgramId(pRenderable->GetVertexShader().Get(), pRenderable->GetPixelShader().Get());
+
+        if (!pRenderable->HasTexture())
+        {
+            const UINT uMaterial = m_drawList.GetMaterialId(nullptr, nullptr);
+            m_drawList.Add(
+                DrawList::MakeSortKey(pass, uProgram, uMaterial, getNormalizedDepth(pRenderable, uFirstBounds, DRAW_WHOLE_RENDERABLE)),
+                DrawItem{ .pRenderable = pRenderable, .Source = source, .uMesh = DRAW_WHOLE_RENDERABLE, .Constants = constants, .Skinning = skinning }
+            );
+            return;
+        }
+
+        for (UINT i = 0u; i < pRenderable->GetNumMeshes(); ++i)
+        {
+            if (uFirstBounds != DRAW_UNCULLED && !m_mainCuller.IsVisible(uFirstBounds + i))
             {
-                for (UINT i = 0u; i < m_scenes[m_pszMainSceneName]->GetSkyBox()->GetNumMeshes(); ++i)
-                {
-                    const UINT materialIndex = m_scenes[m_pszMainSceneName]->GetSkyBox()->GetMesh(i).uMaterialIndex;
-                    if (m_scenes[m_pszMainSceneName]->GetSkyBox()->GetMaterial(materialIndex)->pDiffuse)
-                    {
-                        // Set texture resource view of the renderable into the pixel shader
-                        m_immediateContext->PSSetShaderResources(0u, 1u, m_scenes[m_pszMainSceneName]->GetSkyBox()->GetMaterial(materialIndex)->pDiffuse->GetTextureResourceView().GetAddressOf());
-
-                        // Set sampler state of the renderable into the pixel shader
-                        eTextureSamplerType textureSamplerType = m_scenes[m_pszMainSceneName]->GetSkyBox()->GetMaterial(materialIndex)->pDiffuse->GetSamplerType();
-                        m_immediateContext->PSSetSamplers(0u, 1u,
-                            Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
-                    }
-                    if (m_scenes[m_pszMainSceneName]->GetSkyBox()->GetMaterial(materialIndex)->pNormal)
-                    {
-                        // Set texture resource view of the renderable into the pixel shader
-                        m_immediateContext->PSSetShaderResources(1u, 1u, m_scenes[m_pszMainSceneName]->GetSkyBox()->GetMaterial(materialIndex)->pNormal->GetTextureResourceView().GetAddressOf());
-
-                        // Set sampler state of the renderable into the pixel shader
-                        eTextureSamplerType textureSamplerType = m_scenes[m_pszMainSceneName]->GetSkyBox()->GetMaterial(materialIndex)->pDiffuse->GetSamplerType();
-                        m_immediateContext->PSSetSamplers(1u, 1u,
-                            Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
-                    }
-
-                    // Render the triangles
-                    m_immediateContext->DrawIndexed(m_scenes[m_pszMainSceneName]->GetSkyBox()->GetMesh(i).uNumIndices,
-                        m_scenes[m_pszMainSceneName]->GetSkyBox()->GetMesh(i).uBaseIndex,
-                        m_scenes[m_pszMainSceneName]->GetSkyBox()->GetMesh(i).uBaseVertex);
-                }
+                continue;
+            }
+
+            const UINT materialIndex = pRenderable->GetMesh(i).uMaterialIndex;
+            ID3D11ShaderResourceView* pDiffuse = pRenderable->GetMaterial(materialIndex)->pDiffuse ? pRenderable->GetMaterial(materialIndex)->pDiffuse->GetTextureResourceView().Get() : nullptr;
+            ID3D11ShaderResourceView* pNormal = pRenderable->GetMaterial(materialIndex)->pNormal ? pRenderable->GetMaterial(materialIndex)->pNormal->GetTextureResourceView().Get() : nullptr;
+
+            const UINT uMaterial = m_drawList.GetMaterialId(pDiffuse, pNormal);
+            m_drawList.Add(
+                DrawList::MakeSortKey(pass, uProgram, uMaterial, getNormalizedDepth(pRenderable, uFirstBounds, i)),
+                DrawItem{ .pRenderable = pRenderable, .Source = source, .uMesh = i, .Constants = constants, .Skinning = skinning }
+            );
+        }
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::submitDraw
+
+      Summary:  Binds the state of a draw and draws it. Every bind is
+                issued and the state cache drops those that repeat the
+                previous draw, which the sort order makes common. The
+                constants of the draw must already be flushed
+
+      Args:     const DrawItem& item
+                  The draw
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::submitDraw(_In_ const DrawItem& item)
+    {
+        Renderable* pRenderable = item.pRenderable;
+
+        // Set the vertex buffer
+        UINT uStride = sizeof(SimpleVertex);
+        UINT uOffset = 0u;
+        m_backend->SetVertexBuffers(0u, 1u, pRenderable->GetVertexBuffer().GetAddressOf(), &uStride, &uOffset);
+
+        if (item.Source != eDrawSource::SKYBOX)
+        {
+            // Set the normal buffer
+            uStride = sizeof(NormalData);
+            m_backend->SetVertexBuffers(1u, 1u, pRenderable->GetNormalBuffer().GetAddressOf(), &uStride, &uOffset);
+        }
+
+        if (item.Source == eDrawSource::VOXEL)
+        {
+            // Set the instance buffer
+            uStride = sizeof(InstanceData);
+            m_backend->SetVertexBuffers(2u, 1u, static_cast<Voxel*>(pRenderable)->GetInstanceBuffer().GetAddressOf(), &uStride, &uOffset);
+        }
+        else if (item.Source == eDrawSource::MODEL)
+        {
+            // Set the animation buffer
+            uStride = sizeof(AnimationData);
+            m_backend->SetVertexBuffers(3u, 1u, static_cast<Model*>(pRenderable)->GetAnimationBuffer().GetAddressOf(), &uStride, &uOffset);
+        }
+
+        // Set the index buffer
+        m_backend->SetIndexBuffer(pRenderable->GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0u);
+
+        // Set the input layout
+        m_backend->SetInputLayout(pRenderable->GetVertexLayout().Get());
+
+        // Set the vertex shader and constant buffers
+        m_backend->SetVertexShader(pRenderable->GetVertexShader().Get());
+        m_backend->SetVSConstantBufferRanges(2u, 1u, &item.Constants.pBuffer, &item.Constants.uFirstConstant, &item.Constants.uNumConstants);
+        if (item.Source == eDrawSource::MODEL)
+        {
+            m_backend->SetVSConstantBufferRanges(4u, 1u, &item.Skinning.pBuffer, &item.Skinning.uFirstConstant, &item.Skinning.uNumConstants);
+        }
+
+        // Set the pixel shader and constant buffers
+        m_backend->SetPixelShader(pRenderable->GetPixelShader().Get());
+        m_backend->SetPSConstantBufferRanges(2u, 1u, &item.Constants.pBuffer, &item.Constants.uFirstConstant, &item.Constants.uNumConstants);
+
+        UINT uNumIndices = pRenderable->GetNumIndices();
+        UINT uBaseIndex = 0u;
+        INT nBaseVertex = 0;
+        if (item.uMesh != DRAW_WHOLE_RENDERABLE)
+        {
+            const UINT materialIndex = pRenderable->GetMesh(item.uMesh).uMaterialIndex;
+            if (pRenderable->GetMaterial(materialIndex)->pDiffuse)
+            {
+                // Set texture resource view of the renderable into the pixel shader
+                m_backend->SetPSShaderResources(0u, 1u, pRenderable->GetMaterial(materialIndex)->pDiffuse->GetTextureResourceView().GetAddressOf());
+
+                // Set sampler state of the renderable into the pixel shader
+                eTextureSamplerType textureSamplerType = pRenderable->GetMaterial(materialIndex)->pDiffuse->GetSamplerType();
+                m_backend->SetPSSamplers(0u, 1u,
+                    Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
             }
-            else
+            if (pRenderable->GetMaterial(materialIndex)->pNormal)
             {
-                // Render the triangles
-                m_immediateContext->DrawIndexed(m_scenes[m_pszMainSceneName]->GetSkyBox()->GetNumIndices(), 0u, 0);
+                // Set texture resource view of the renderable into the pixel shader
+                m_backend->SetPSShaderResources(1u, 1u, pRenderable->GetMaterial(materialIndex)->pNormal->GetTextureResourceView().GetAddressOf());
+
+                // Set sampler state of the renderable into the pixel shader
+                eTextureSamplerType textureSamplerType = pRenderable->GetMaterial(materialIndex)->pDiffuse->GetSamplerType();
+                m_backend->SetPSSamplers(1u, 1u,
+                    Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
             }
+
+            uNumIndices = pRenderable->GetMesh(item.uMesh).uNumIndices;
+            uBaseIndex = pRenderable->GetMesh(item.uMesh).uBaseIndex;
+            nBaseVertex = static_cast<INT>(pRenderable->GetMesh(item.uMesh).uBaseVertex);
         }
 
-        // Present the information rendered to the back buffer to the front buffer
-        m_swapChain->Present(0u, 0u);
+        // Render the triangles
+        if (item.Source == eDrawSource::VOXEL)
+        {
+            m_backend->DrawIndexedInstanced(uNumIndices, static_cast<Voxel*>(pRenderable)->GetNumVisibleInstances(), uBaseIndex, nBaseVertex, 0u);
+        }
+        else
+        {
+            m_backend->DrawIndexed(uNumIndices, uBaseIndex, nBaseVertex);
+        }
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::SetRenderBackend
+
+      Summary:  Set the backend the frame is submitted through. Must be
+                called before Initialize, otherwise Initialize creates a
+                D3D11RenderBackend on the immediate context behind a
+                StateCacheRenderBackend
+
+      Args:     std::shared_ptr<RenderBackend> backend
+                  The render backend
+
+      Modifies: [m_backend].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::SetRenderBackend(_In_ std::shared_ptr<RenderBackend> backend)
+    {
+        m_backend = std::move(backend);
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::GetRenderBackend
+
+      Summary:  Returns the backend the frame is submitted through
+
+      Returns:  const std::shared_ptr<RenderBackend>&
+                  The render backend
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const std::shared_ptr<RenderBackend>& Renderer::GetRenderBackend() const
+    {
+        return m_backend;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::GetConstantBufferStatistics
+
+      Summary:  Returns the per-draw constants allocated and uploaded in
+                the last frame
+
+      Returns:  const ConstantBufferRingStatistics&
+                  Allocations, maps and uploaded bytes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const ConstantBufferRingStatistics& Renderer::GetConstantBufferStatistics() const
+    {
+        return m_constantBufferRing.GetFrameStatistics();
     }
 
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Renderer::GetDriverType
 
@@ -894,98 +1155,191 @@ namespace library
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Renderer::RenderSceneToTexture
 
-      Summary:  Render scene to the texture
+      Summary:  Render scene to the texture. Does nothing before
+                Initialize has created the shadow map, and Render then
+                binds no shadow map either
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     /*--------------------------------------------------------------------
       TODO: Renderer::RenderSceneToTexture definition (remove the comment)
     --------------------------------------------------------------------*/
     void Renderer::RenderSceneToTexture()
     {
+        if (m_shadowMapTexture == nullptr)
+        {
+            return;
+        }
+
+        m_backend->BeginPass(L"Shadow");
+
         //Unbind current pixel shader resources
         ID3D11ShaderResourceView* const pSRV[2] = { NULL, NULL };
-        m_immediateContext->PSSetShaderResources(0, 2, pSRV);
-        m_immediateContext->PSSetShaderResources(2, 1, pSRV);
+        m_backend->SetPSShaderResources(0, 2, pSRV);
+        m_backend->SetPSShaderResources(2, 1, pSRV);
 
         //Change render target to the shadow map texture
         // Now scene will be rendered onto this Render - To - Texture object
             //Clear render target view with white color
             //Clear depth stencil view
-        m_immediateContext->OMSetRenderTargets(1, m_shadowMapTexture->GetRenderTargetView().GetAddressOf(), m_depthStencilView.Get());
-        m_immediateContext->ClearRenderTargetView(m_shadowMapTexture->GetRenderTargetView().Get(), Colors::White);
-        m_immediateContext->ClearDepthStencilView(m_depthStencilView.Get(), D3D11_CLEAR_DEPTH, 1.0f, 0);
+        m_backend->SetRenderTargets(1, m_shadowMapTexture->GetRenderTargetView().GetAddressOf(), m_depthStencilView.Get());
+        m_backend->ClearRenderTargetView(m_shadowMapTexture->GetRenderTargetView().Get(), Colors::White);
+        m_backend->ClearDepthStencilView(m_depthStencilView.Get(), D3D11_CLEAR_DEPTH, 1.0f, 0);
+
+        // Bind the shadow map shaders once
+        m_backend->SetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+        m_backend->SetVertexShader(m_shadowVertexShader->GetVertexShader().Get());
+        m_backend->SetPixelShader(m_shadowPixelShader->GetPixelShader().Get());
+
+        // Write the CBShadowMatrix constants of every object before the
+        // first draw. View and projection matrices are of the point
+        // light to render scene from the point light's viewport
+        const XMMATRIX lightView = XMMatrixTranspose(m_scenes[m_pszMainSceneName]->GetPointLight(0)->GetViewMatrix());
+        const XMMATRIX lightProjection = XMMatrixTranspose(m_scenes[m_pszMainSceneName]->GetPointLight(0)->GetProjectionMatrix());
+
+        // Cull every mesh against the frustum of the light. The pass has
+        // its own list, since what the light sees is not what the
+        // camera sees. The bounds are added in the order the objects
+        // are visited below
+        m_shadowCuller.Clear();
+        m_shadowCuller.SetFrustum(m_scenes[m_pszMainSceneName]->GetPointLight(0)->GetViewMatrix() * m_scenes[m_pszMainSceneName]->GetPointLight(0)->GetProjectionMatrix());
+        for (const auto& renderablePair : m_scenes[m_pszMainSceneName]->GetRenderables())
+        {
+            for (UINT i = 0; i < renderablePair.second->GetNumMeshes(); ++i)
+            {
+                m_shadowCuller.AddBounds(renderablePair.second->GetMeshBounds(i), renderablePair.second->GetWorldMatrix());
+            }
+        }
+        for (const auto& modelPair : m_scenes[m_pszMainSceneName]->GetModels())
+        {
+            for (UINT i = 0; i < modelPair.second->GetNumMeshes(); ++i)
+            {
+                m_shadowCuller.AddBounds(modelPair.second->GetMeshBounds(i), modelPair.second->GetWorldMatrix());
+            }
+        }
+        m_shadowCuller.Cull();
 
-        //Render renderables/voxels/models with shadow map shaders
-        //Bind vertex buffer, index buffer, input layout
+        // Objects with no mesh in view get no constants
+        m_shadowConstants.clear();
+        UINT uBounds = 0u;
         std::unordered_map<std::wstring, std::shared_ptr<Renderable>>::iterator renderable;
         for (renderable = m_scenes[m_pszMainSceneName]->GetRenderables().begin(); renderable != m_scenes[m_pszMainSceneName]->GetRenderables().end(); ++renderable)
         {
-            // Bind vertex shader and pixel shader
-            UINT uStride = sizeof(SimpleVertex);
-            UINT uOffset = 0;
-            m_immediateContext->IASetVertexBuffers(0u, 1u, renderable->second->GetVertexBuffer().GetAddressOf(), &uStride, &uOffset);
-            m_immediateContext->IASetIndexBuffer(renderable->second->GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0);
-            // Set the input layout
-            m_immediateContext->IASetInputLayout(renderable->second->GetVertexLayout().Get());
+            const UINT uFirstBounds = uBounds;
+            uBounds += renderable->second->GetNumMeshes();
+            if (!m_shadowCuller.IsAnyVisible(uFirstBounds, renderable->second->GetNumMeshes()))
+            {
+                m_shadowConstants.push_back(ConstantBufferAllocation{});
+                continue;
+            }
 
-            //Update and bind CBShadowMatrix constant buffer
-                //View and projection matrices are of the point light to render scene from the point light’s viewport
             CBShadowMatrix cbShadowMatrix =
             {
                 .World = XMMatrixTranspose(renderable->second->GetWorldMatrix()),
-                .View = XMMatrixTranspose(m_scenes[m_pszMainSceneName]->GetPointLight(0)->GetViewMatrix()),
-                .Projection = XMMatrixTranspose(m_scenes[m_pszMainSceneName]->GetPointLight(0)->GetProjectionMatrix()),
+                .View = lightView,
+                .Projection = lightProjection,
                 .IsVoxel = false
             };
-            m_immediateContext->UpdateSubresource(m_cbShadowMatrix.Get(), 0u, nullptr, &cbShadowMatrix, 0u, 0u);
+            m_shadowConstants.push_back(m_constantBufferRing.Allocate(&cbShadowMatrix, sizeof(cbShadowMatrix)));
+        }
+        for (auto model : m_scenes[m_pszMainSceneName]->GetModels())
+        {
+            const UINT uFirstBounds = uBounds;
+            uBounds += model.second->GetNumMeshes();
+            if (!m_shadowCuller.IsAnyVisible(uFirstBounds, model.second->GetNumMeshes()))
+            {
+                m_shadowConstants.push_back(ConstantBufferAllocation{});
+                continue;
+            }
+
+            CBShadowMatrix cbShadowMatrix =
+            {
+                .World = XMMatrixTranspose(model.second->GetWorldMatrix()),
+                .View = lightView,
+                .Projection = lightProjection,
+                .IsVoxel = FALSE
+            };
+            m_shadowConstants.push_back(m_constantBufferRing.Allocate(&cbShadowMatrix, sizeof(cbShadowMatrix)));
+        }
+        m_constantBufferRing.Flush(*m_backend);
+
+        //Render renderables/voxels/models with shadow map shaders
+        //Bind vertex buffer, index buffer, input layout
+        UINT uObject = 0u;
+        uBounds = 0u;
+        for (renderable = m_scenes[m_pszMainSceneName]->GetRenderables().begin(); renderable != m_scenes[m_pszMainSceneName]->GetRenderables().end(); ++renderable, ++uObject)
+        {
+            const UINT uFirstBounds = uBounds;
+            uBounds += renderable->second->GetNumMeshes();
+            if (!m_shadowCuller.IsAnyVisible(uFirstBounds, renderable->second->GetNumMeshes()))
+            {
+                continue;
+            }
 
             // Bind vertex shader and pixel shader
-            m_immediateContext->VSSetShader(m_shadowVertexShader->GetVertexShader().Get(), nullptr, 0u);
-            m_immediateContext->VSSetConstantBuffers(0u, 1u, m_cbShadowMatrix.GetAddressOf());
+            UINT uStride = sizeof(SimpleVertex);
+            UINT uOffset = 0;
+            m_backend->SetVertexBuffers(0u, 1u, renderable->second->GetVertexBuffer().GetAddressOf(), &uStride, &uOffset);
+            m_backend->SetIndexBuffer(renderable->second->GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0);
+            // Set the input layout
+            m_backend->SetInputLayout(renderable->second->GetVertexLayout().Get());
 
-            m_immediateContext->PSSetShader(m_shadowPixelShader->GetPixelShader().Get(), nullptr, 0u);
-            m_immediateContext->PSSetConstantBuffers(0u, 1u, m_cbShadowMatrix.GetAddressOf());
+            // Bind the CBShadowMatrix constants of the object
+            const ConstantBufferAllocation& constants = m_shadowConstants[uObject];
+            m_backend->SetVSConstantBufferRanges(0u, 1u, &constants.pBuffer, &constants.uFirstConstant, &constants.uNumConstants);
+            m_backend->SetPSConstantBufferRanges(0u, 1u, &constants.pBuffer, &constants.uFirstConstant, &constants.uNumConstants);
 
             for (UINT i = 0; i < renderable->second->GetNumMeshes(); ++i)
             {
-                m_immediateContext->DrawIndexed(renderable->second->GetMesh(i).uNumIndices, renderable->second->GetMesh(i).uBaseIndex, static_cast<INT>(renderable->second->GetMesh(i).uBaseVertex));
+                if (!m_shadowCuller.IsVisible(uFirstBounds + i))
+                {
+                    continue;
+                }
+
+                m_backend->DrawIndexed(renderable->second->GetMesh(i).uNumIndices, renderable->second->GetMesh(i).uBaseIndex, static_cast<INT>(renderable->second->GetMesh(i).uBaseVertex));
             }
         }
 
         for (auto model : m_scenes[m_pszMainSceneName]->GetModels())
         {
+            const UINT uFirstBounds = uBounds;
+            uBounds += model.second->GetNumMeshes();
+            if (!m_shadowCuller.IsAnyVisible(uFirstBounds, model.second->GetNumMeshes()))
+            {
+                ++uObject;
+                continue;
+            }
+
             // Set the vertex buffer
             UINT stride0 = sizeof(SimpleVertex);
             UINT offset0 = 0;
 
-            m_immediateContext->IASetVertexBuffers(0u, 1u, model.second->GetVertexBuffer().GetAddressOf(), &stride0, &offset0);
+            m_backend->SetVertexBuffers(0u, 1u, model.second->GetVertexBuffer().GetAddressOf(), &stride0, &offset0);
 
             // Set the index buffer
-            m_immediateContext->IASetIndexBuffer(model.second->GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0);
+            m_backend->SetIndexBuffer(model.second->GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0);
 
             // Set the input layout
-            m_immediateContext->IASetInputLayout(m_shadowVertexShader->GetVertexLayout().Get());
+            m_backend->SetInputLayout(m_shadowVertexShader->GetVertexLayout().Get());
 
             // Shadow constant buffer
-            CBShadowMatrix cbShadowMatrix =
-            {
-                .World = XMMatrixTranspose(model.second->GetWorldMatrix()),
-                .View = XMMatrixTranspose(m_scenes[m_pszMainSceneName]->GetPointLight(0)->GetViewMatrix()),
-                .Projection = XMMatrixTranspose(m_scenes[m_pszMainSceneName]->GetPointLight(0)->GetProjectionMatrix()),
-                .IsVoxel = FALSE
-            };
-
-            m_immediateContext->UpdateSubresource(m_cbShadowMatrix.Get(), 0u, nullptr, &cbShadowMatrix, 0u, 0u);
-
-            m_immediateContext->VSSetConstantBuffers(0u, 1u, m_cbShadowMatrix.GetAddressOf());
+            const ConstantBufferAllocation& constants = m_shadowConstants[uObject++];
+            m_backend->SetVSConstantBufferRanges(0u, 1u, &constants.pBuffer, &constants.uFirstConstant, &constants.uNumConstants);
+            m_backend->SetPSConstantBufferRanges(0u, 1u, &constants.pBuffer, &constants.uFirstConstant, &constants.uNumConstants);
 
             for (UINT i = 0; i < model.second->GetNumMeshes(); ++i)
             {
-                m_immediateContext->DrawIndexed(model.second->GetMesh(i).uNumIndices, model.second->GetMesh(i).uBaseIndex, static_cast<INT>(model.second->GetMesh(i).uBaseVertex));
+                if (!m_shadowCuller.IsVisible(uFirstBounds + i))
+                {
+                    continue;
+                }
+
+                m_backend->DrawIndexed(model.second->GetMesh(i).uNumIndices, model.second->GetMesh(i).uBaseIndex, static_cast<INT>(model.second->GetMesh(i).uBaseVertex));
             }
         }
 
         // After rendering the scene, reset the render target back to the original back buffer
-        m_immediateContext->OMSetRenderTargets(1, m_renderTargetView.GetAddressOf(), m_depthStencilView.Get());
+        m_backend->SetRenderTargets(1, m_renderTargetView.GetAddressOf(), m_depthStencilView.Get());
+
+        m_backend->EndPass();
     }
 
 
@@ -16,12 +16,16 @@
 #include "Camera/Camera.h"
 #include "Light/PointLight.h"
 #include "Model/Model.h"
+#include "Renderer/D3D11RenderBackend.h"
+#include "Renderer/ConstantBufferRing.h"
 #include "Renderer/DataTypes.h"
+#include "Renderer/DrawList.h"
+#include "Renderer/FrustumCuller.h"
 #include "Renderer/Renderable.h"
+#include "Renderer/StateCacheRenderBackend.h"
 #include "Scene/Scene.h"
 #include "Shader/PixelShader.h"
 #include "Shader/VertexShader.h"
-#include "Window/MainWindow.h"
 #include "Texture/RenderTexture.h"
 #include "Shader/ShadowVertexShader.h"
 
@@ -34,13 +38,20 @@ namespace library
                 data onto the screen
 
       Methods:  Initialize
-                  Creates Direct3D device and swap chain
+                  Creates Direct3D device and swap chain, or uses the
+                  given device and renders into an offscreen target
                 AddRenderable
                   Add a renderable object and initialize the object
                 Update
                   Update the renderables each frame
                 Render
                   Renders the frame
+                SetRenderBackend / GetRenderBackend
+                  Set or return the backend the frame is submitted
+                  through
+                GetConstantBufferStatistics
+                  Returns the per-draw constants uploaded in the last
+                  frame
                 GetDriverType
                   Returns the Direct3D driver type
                 Renderer
@@ -58,7 +69,10 @@ namespace library
         Renderer& operator=(Renderer&& other) = delete;
         ~Renderer() = default;
 
+#if defined(_WIN32)
         HRESULT Initialize(_In_ HWND hWnd);
+#endif
+        HRESULT Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext, _In_ UINT uWidth, _In_ UINT uHeight);
 
         HRESULT AddScene(_In_ PCWSTR pszSceneName, _In_ const std::shared_ptr<Scene>& scene);
         std::shared_ptr<Scene> GetSceneOrNull(_In_ PCWSTR pszSceneName);
@@ -70,23 +84,35 @@ namespace library
         void Render();
         void RenderSceneToTexture();
 
+        void SetRenderBackend(_In_ std::shared_ptr<RenderBackend> backend);
+        const std::shared_ptr<RenderBackend>& GetRenderBackend() const;
+        const ConstantBufferRingStatistics& GetConstantBufferStatistics() const;
+
         D3D_DRIVER_TYPE GetDriverType() const;
 
+    private:
+        HRESULT initializeResources(_In_ UINT uWidth, _In_ UINT uHeight);
+        void addDrawBounds(_In_ Renderable* pRenderable);
+        FLOAT getNormalizedDepth(_In_ const Renderable* pRenderable, _In_ UINT uFirstBounds, _In_ UINT uMesh) const;
+        void addDraws(_In_ Renderable* pRenderable, _In_ eDrawSource source, _In_ eDrawPass pass, _In_ UINT uFirstBounds, _In_ const ConstantBufferAllocation& constants, _In_ const ConstantBufferAllocation& skinning);
+        void submitDraw(_In_ const DrawItem& item);
+
     private:
         D3D_DRIVER_TYPE m_driverType;
         D3D_FEATURE_LEVEL m_featureLevel;
         ComPtr<ID3D11Device> m_d3dDevice;
-        ComPtr<ID3D11Device1> m_d3dDevice1;
         ComPtr<ID3D11DeviceContext> m_immediateContext;
+#if defined(_WIN32)
+        ComPtr<ID3D11Device1> m_d3dDevice1;
         ComPtr<ID3D11DeviceContext1> m_immediateContext1;
         ComPtr<IDXGISwapChain> m_swapChain;
         ComPtr<IDXGISwapChain1> m_swapChain1;
+#endif
         ComPtr<ID3D11RenderTargetView> m_renderTargetView;
         ComPtr<ID3D11Texture2D> m_depthStencil;
         ComPtr<ID3D11DepthStencilView> m_depthStencilView;
         ComPtr<ID3D11Buffer> m_cbChangeOnResize;
         ComPtr<ID3D11Buffer> m_cbLights;
-        ComPtr<ID3D11Buffer> m_cbShadowMatrix;
         PCWSTR m_pszMainSceneName;
         BYTE m_padding[8];
         Camera m_camera;
@@ -97,5 +123,13 @@ namespace library
         std::shared_ptr<RenderTexture> m_shadowMapTexture;
         std::shared_ptr<ShadowVertexShader> m_shadowVertexShader;
         std::shared_ptr<PixelShader> m_shadowPixelShader;
+        D3D11_VIEWPORT m_viewport;
+        std::shared_ptr<RenderBackend> m_backend;
+        DrawList m_drawList;
+        FrustumCuller m_mainCuller;
+        FrustumCuller m_shadowCuller;
+        std::unique_ptr<ThreadPool> m_threadPool;
+        ConstantBufferRing m_constantBufferRing;
+        std::vector<ConstantBufferAllocation> m_shadowConstants;
     };
 }
\ No newline at end of file
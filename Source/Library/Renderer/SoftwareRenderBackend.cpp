@@ -0,0 +1,1317 @@
+#include "Renderer/SoftwareRenderBackend.h"
+
+#include <atomic>
+#include <fstream>
+#include <string_view>
+
+namespace library
+{
+    namespace
+    {
+        constexpr UINT NO_CONSTANT_BUFFER = UINT_MAX;
+        constexpr UINT NUM_LANES = 4u;
+
+        // Read in place of unbound constant buffers and vertex elements
+        alignas(16) const BYTE s_aZeros[65536] = {};
+
+        /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+          Function: getViewData
+
+          Summary:  Returns the memory of the resource a view of the null
+                    device references
+
+          Args:     ID3D11View* pView
+                      View to resolve
+                    NullResourceData* pData
+                      Receives the memory, cleared on failure
+
+          Returns:  HRESULT
+                      Status code
+        -----------------------------------------------------------------F-F*/
+        HRESULT getViewData(_In_opt_ ID3D11View* pView, _Out_ NullResourceData* pData)
+        {
+            *pData = {};
+            if (!pView)
+            {
+                return E_INVALIDARG;
+            }
+
+            ComPtr<ID3D11Resource> resource;
+            pView->GetResource(resource.GetAddressOf());
+
+            HRESULT hr = GetNullResourceData(resource.Get(), pData);
+            if (FAILED(hr))
+            {
+                *pData = {};
+            }
+
+            return hr;
+        }
+
+        NullResourceData getBufferData(_In_opt_ ID3D11Buffer* pBuffer)
+        {
+            NullResourceData data = {};
+            if (!pBuffer || FAILED(GetNullResourceData(pBuffer, &data)))
+            {
+                return {};
+            }
+
+            return data;
+        }
+
+        NullResourceData getBufferRangeData(_In_opt_ ID3D11Buffer* pBuffer, _In_ UINT uFirstConstant, _In_ UINT uNumConstants)
+        {
+            // Constants are 16 bytes, as in Direct3D
+            NullResourceData data = getBufferData(pBuffer);
+            const SIZE_T uOffset = static_cast<SIZE_T>(uFirstConstant) * 16u;
+            if (!data.pData || uOffset >= data.uSize)
+            {
+                return {};
+            }
+
+            data.pData += uOffset;
+            data.uSize = std::min(static_cast<SIZE_T>(uNumConstants) * 16u, data.uSize - uOffset);
+
+            return data;
+        }
+
+        std::string_view getShaderName(_In_opt_ ID3D11DeviceChild* pShader)
+        {
+            const BYTE* pBytecode = nullptr;
+            SIZE_T uBytecodeLength = 0u;
+            if (!pShader || FAILED(GetNullShaderBytecode(pShader, &pBytecode, &uBytecodeLength)))
+            {
+                return std::string_view();
+            }
+
+            std::string_view name(reinterpret_cast<PCSTR>(pBytecode), uBytecodeLength);
+            while (!name.empty() && name.back() == '\0')
+            {
+                name.remove_suffix(1u);
+            }
+
+            return name;
+        }
+
+        /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+          Function: encodeTexel
+
+          Summary:  Converts a color to the texel format of a render
+                    target
+
+          Args:     FXMVECTOR color
+                      RGBA color
+                    DXGI_FORMAT format
+                      Format of the texel
+                    BYTE* pTexel
+                      Receives the texel, 16 bytes at most
+
+          Returns:  UINT
+                      Size of the texel, 0 for unsupported formats
+        -----------------------------------------------------------------F-F*/
+        UINT encodeTexel(_In_ FXMVECTOR color, _In_ DXGI_FORMAT format, _Out_writes_bytes_(16) BYTE* pTexel)
+        {
+            switch (format)
+            {
+            case DXGI_FORMAT_R8G8B8A8_UNORM:
+            case DXGI_FORMAT_B8G8R8A8_UNORM:
+            {
+                XMFLOAT4 scaled;
+                XMStoreFloat4(&scaled, XMVectorSaturate(color) * 255.0f + XMVectorReplicate(0.5f));
+
+                BYTE r = static_cast<BYTE>(scaled.x);
+                BYTE b = static_cast<BYTE>(scaled.z);
+                pTexel[0] = format == DXGI_FORMAT_R8G8B8A8_UNORM ? r : b;
+                pTexel[1] = static_cast<BYTE>(scaled.y);
+                pTexel[2] = format == DXGI_FORMAT_R8G8B8A8_UNORM ? b : r;
+                pTexel[3] = static_cast<BYTE>(scaled.w);
+                return 4u;
+            }
+            case DXGI_FORMAT_R32G32B32A32_FLOAT:
+            {
+                XMFLOAT4 stored;
+                XMStoreFloat4(&stored, color);
+                memcpy(pTexel, &stored, sizeof(stored));
+                return 16u;
+            }
+            case DXGI_FORMAT_R32_FLOAT:
+            {
+                FLOAT red = XMVectorGetX(color);
+                memcpy(pTexel, &red, sizeof(red));
+                return 4u;
+            }
+            default:
+                return 0u;
+            }
+        }
+
+        void putLittleEndian(_Inout_ std::vector<BYTE>& bytes, _In_ UINT uValue, _In_ UINT uNumBytes)
+        {
+            for (UINT i = 0u; i < uNumBytes; ++i)
+            {
+                bytes.push_back(static_cast<BYTE>(uValue >> (8u * i)));
+            }
+        }
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   SoftwareRenderBackend::SoftwareRenderBackend
+
+      Summary:  Constructor
+
+      Args:     UINT uNumThreads
+                  Number of threads tiles are rasterized on, 0 for one
+                  per hardware thread
+
+      Modifies: [m_threadPool, m_statistics, m_renderTarget,
+                  m_depthStencil, m_renderTargetView,
+                  m_frameRenderTargetView, m_viewport, m_uTargetWidth,
+                  m_uTargetHeight, m_aVertexBuffers, m_auVertexStrides,
+                  m_auVertexOffsets, m_indexBuffer, m_indexFormat,
+                  m_uIndexOffset, m_topology, m_pVertexShader,
+                  m_pPixelShader, m_aVSConstantBuffers,
+                  m_aPSConstantBuffers, m_aTextures, m_aSamplers,
+                  m_indices, m_shadedVertices, m_draws, m_constants,
+                  m_triangles, m_attributes, m_aTileBins,
+                  m_occupiedTiles, m_uNumTilesX, m_uNumTilesY].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    SoftwareRenderBackend::SoftwareRenderBackend(_In_ UINT uNumThreads)
+        : m_threadPool(std::make_unique<ThreadPool>(uNumThreads))
+        , m_statistics()
+        , m_renderTarget()
+        , m_depthStencil()
+        , m_renderTargetView()
+        , m_frameRenderTargetView()
+        , m_viewport()
+        , m_uTargetWidth(0u)
+        , m_uTargetHeight(0u)
+        , m_aVertexBuffers()
+        , m_auVertexStrides()
+        , m_auVertexOffsets()
+        , m_indexBuffer()
+        , m_indexFormat(DXGI_FORMAT_R16_UINT)
+        , m_uIndexOffset(0u)
+        , m_topology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST)
+        , m_pVertexShader(nullptr)
+        , m_pPixelShader(nullptr)
+        , m_aVSConstantBuffers()
+        , m_aPSConstantBuffers()
+        , m_aTextures()
+        , m_aSamplers()
+        , m_indices()
+        , m_shadedVertices()
+        , m_draws()
+        , m_constants()
+        , m_triangles()
+        , m_attributes()
+        , m_aTileBins()
+        , m_occupiedTiles()
+        , m_uNumTilesX(0u)
+        , m_uNumTilesY(0u)
+    {
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   SoftwareRenderBackend::SetNumThreads
+
+      Summary:  Replaces the thread pool. Pending tiles are rasterized
+                first
+
+      Args:     UINT uNumThreads
+                  Number of threads, 0 for one per hardware thread
+
+      Modifies: [m_threadPool].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void SoftwareRenderBackend::SetNumThreads(_In_ UINT uNumThreads)
+    {
+        flush();
+
+        m_threadPool.reset();
+        m_threadPool = std::make_unique<ThreadPool>(uNumThreads);
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   SoftwareRenderBackend::GetNumThreads
+
+      Summary:  Returns the number of threads tiles are rasterized on
+
+      Returns:  UINT
+                  Number of threads
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT SoftwareRenderBackend::GetNumThreads() const
+    {
+        return m_threadPool->GetNumThreads();
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   SoftwareRenderBackend::GetFrameStatistics
+
+      Summary:  Returns the work done since the last BeginFrame
+
+      Returns:  const SoftwareRenderStatistics&
+                  Counters of the frame
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const SoftwareRenderStatistics& SoftwareRenderBackend::GetFrameStatistics() const
+    {
+        return m_statistics;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   SoftwareRenderBackend::SaveFrame
+
+      Summary:  Writes the render target bound when the last frame ended
+                to a bitmap file
+
+      Args:     PCWSTR pszFileName
+                  Path of the file to write
+
+      Returns:  HRESULT
+                  Status code, E_FAIL if no frame was rendered
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT SoftwareRenderBackend::SaveFrame(_In_ PCWSTR pszFileName)
+    {
+        if (!m_frameRenderTargetView)
+        {
+            return E_FAIL;
+        }
+
+        return SaveRenderTarget(m_frameRenderTargetView.Get(), pszFileName);
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   SoftwareRenderBackend::SaveRenderTarget
+
+      Summary:  Writes a render target to a 24-bit bitmap file
+
+      Args:     ID3D11RenderTargetView* pRenderTargetView
+                  Render target of the null device
+                PCWSTR pszFileName
+                  Path of the file to write
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT SoftwareRenderBackend::SaveRenderTarget(_In_ ID3D11RenderTargetView* pRenderTargetView, _In_ PCWSTR pszFileName)
+    {
+        flush();
+
+        NullResourceData target;
+        HRESULT hr = getViewData(pRenderTargetView, &target);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        SoftwareTexture texture =
+        {
+            .pData = target.pData,
+            .uWidth = target.uWidth,
+            .uHeight = target.uHeight,
+            .uRowPitch = target.uRowPitch,
+            .uArraySize = 1u,
+            .Format = target.Format
+        };
+        const SoftwareSampler pointSampler = { .bPoint = TRUE, .bClamp = TRUE };
+
+        // Rows are stored bottom up and padded to 4 bytes
+        const UINT uPaddedRowSize = (target.uWidth * 3u + 3u) & ~3u;
+        const UINT uPixelBytes = uPaddedRowSize * target.uHeight;
+
+        std::vector<BYTE> file;
+        file.reserve(54u + uPixelBytes);
+        file.push_back('B');
+        file.push_back('M');
+        putLittleEndian(file, 54u + uPixelBytes, 4u);
+        putLittleEndian(file, 0u, 4u);
+        putLittleEndian(file, 54u, 4u);
+        putLittleEndian(file, 40u, 4u);
+        putLittleEndian(file, target.uWidth, 4u);
+        putLittleEndian(file, target.uHeight, 4u);
+        putLittleEndian(file, 1u, 2u);
+        putLittleEndian(file, 24u, 2u);
+        putLittleEndian(file, 0u, 4u);
+        putLittleEndian(file, uPixelBytes, 4u);
+        putLittleEndian(file, 2835u, 4u);
+        putLittleEndian(file, 2835u, 4u);
+        putLittleEndian(file, 0u, 4u);
+        putLittleEndian(file, 0u, 4u);
+
+        for (UINT y = target.uHeight; y-- > 0u;)
+        {
+            for (UINT x = 0u; x < target.uWidth; ++x)
+            {
+                // Point sampling at the texel center decodes any sampled format
+                XMVECTOR color = SampleTexture(texture, pointSampler, (x + 0.5f) / target.uWidth, (y + 0.5f) / target.uHeight);
+                if (target.Format == DXGI_FORMAT_R32_FLOAT)
+                {
+                    color = XMVectorSplatX(color);
+                }
+
+                XMFLOAT4 scaled;
+                XMStoreFloat4(&scaled, XMVectorSaturate(color) * 255.0f + XMVectorReplicate(0.5f));
+                file.push_back(static_cast<BYTE>(scaled.z));
+                file.push_back(static_cast<BYTE>(scaled.y));
+                file.push_back(static_cast<BYTE>(scaled.x));
+            }
+            file.resize(file.size() + uPaddedRowSize - target.uWidth * 3u, 0u);
+        }
+
+        std::ofstream stream(std::filesystem::path(pszFileName), std::ios::binary);
+        if (!stream)
+        {
+            return E_FAIL;
+        }
+
+        stream.write(reinterpret_cast<const char*>(file.data()), static_cast<std::streamsize>(file.size()));
+
+        return stream ? S_OK : E_FAIL;
+    }
+
+
+    void SoftwareRenderBackend::BeginFrame()
+    {
+        m_statistics = {};
+    }
+
+
+    void SoftwareRenderBackend::EndFrame()
+    {
+        flush();
+
+        m_frameRenderTargetView = m_renderTargetView;
+    }
+
+
+    void SoftwareRenderBackend::BeginPass(_In_ PCWSTR pszPassName)
+    {
+        UNREFERENCED_PARAMETER(pszPassName);
+    }
+
+
+    void SoftwareRenderBackend::EndPass()
+    {
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   SoftwareRenderBackend::SetRenderTargets
+
+      Summary:  Rasterizes the pending tiles into the old targets and
+                binds the first render target and the depth buffer.
+                The tile grid covers the area both targets share
+
+      Args:     UINT uNumViews
+                  Number of render target views
+                ID3D11RenderTargetView* const* ppRenderTargetViews
+                  Render targets; only the first one is drawn to
+                ID3D11DepthStencilView* pDepthStencilView
+                  Depth buffer
+
+      Modifies: [m_renderTarget, m_depthStencil, m_renderTargetView,
+                  m_uTargetWidth, m_uTargetHeight, m_aTileBins,
+                  m_uNumTilesX, m_uNumTilesY].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void SoftwareRenderBackend::SetRenderTargets(_In_ UINT uNumViews, _In_reads_opt_(uNumViews) ID3D11RenderTargetView* const* ppRenderTargetViews, _In_opt_ ID3D11DepthStencilView* pDepthStencilView)
+    {
+        flush();
+
+        m_renderTargetView.Reset();
+        m_renderTarget = {};
+        if (uNumViews > 0u && ppRenderTargetViews && SUCCEEDED(getViewData(ppRenderTargetViews[0], &m_renderTarget)))
+        {
+            m_renderTargetView = ppRenderTargetViews[0];
+        }
+        getViewData(pDepthStencilView, &m_depthStencil);
+
+        m_uTargetWidth = UINT_MAX;
+        m_uTargetHeight = UINT_MAX;
+        for (const NullResourceData* pTarget : { &m_renderTarget, &m_depthStencil })
+        {
+            if (pTarget->pData)
+            {
+                m_uTargetWidth = std::min(m_uTargetWidth, pTarget->uWidth);
+                m_uTargetHeight = std::min(m_uTargetHeight, pTarget->uHeight);
+            }
+        }
+        if (m_uTargetWidth == UINT_MAX)
+        {
+            m_uTargetWidth = 0u;
+            m_uTargetHeight = 0u;
+        }
+
+        m_uNumTilesX = (m_uTargetWidth + SOFTWARE_TILE_SIZE - 1u) / SOFTWARE_TILE_SIZE;
+        m_uNumTilesY = (m_uTargetHeight + SOFTWARE_TILE_SIZE - 1u) / SOFTWARE_TILE_SIZE;
+        if (m_aTileBins.size() < static_cast<SIZE_T>(m_uNumTilesX) * m_uNumTilesY)
+        {
+            m_aTileBins.resize(static_cast<SIZE_T>(m_uNumTilesX) * m_uNumTilesY);
+        }
+    }
+
+
+    void SoftwareRenderBackend::SetViewports(_In_ UINT uNumViewports, _In_reads_(uNumViewports) const D3D11_VIEWPORT* pViewports)
+    {
+        // Triangles are binned in screen space, so pending ones keep
+        // the viewport they were drawn with
+        if (uNumViewports > 0u)
+        {
+            m_viewport = pViewports[0];
+        }
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   SoftwareRenderBackend::ClearRenderTargetView
+
+      Summary:  Rasterizes the pending tiles, then fills the render
+                target with the color, one band of rows per thread
+
+      Args:     ID3D11RenderTargetView* pRenderTargetView
+                  Render target to clear
+                const FLOAT aColorRGBA[4]
+                  Clear color
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void SoftwareRenderBackend::ClearRenderTargetView(_In_ ID3D11RenderTargetView* pRenderTargetView, _In_ const FLOAT aColorRGBA[4])
+    {
+        flush();
+
+        NullResourceData target;
+        if (FAILED(getViewData(pRenderTargetView, &target)))
+        {
+            return;
+        }
+
+        BYTE aTexel[16];
+        UINT uTexelSize = encodeTexel(XMVectorSet(aColorRGBA[0], aColorRGBA[1], aColorRGBA[2], aColorRGBA[3]), target.Format, aTexel);
+        if (uTexelSize == 0u)
+        {
+            return;
+        }
+
+        m_threadPool->ParallelFor((target.uHeight + SOFTWARE_TILE_SIZE - 1u) / SOFTWARE_TILE_SIZE, [&](UINT uBand)
+        {
+            UINT uLastRow = std::min((uBand + 1u) * SOFTWARE_TILE_SIZE, target.uHeight);
+            for (UINT y = uBand * SOFTWARE_TILE_SIZE; y < uLastRow; ++y)
+            {
+                BYTE* pRow = target.pData + static_cast<SIZE_T>(y) * target.uRowPitch;
+                for (UINT x = 0u; x < target.uWidth; ++x)
+                {
+                    memcpy(pRow + x * uTexelSize, aTexel, uTexelSize);
+                }
+            }
+        });
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   SoftwareRenderBackend::ClearDepthStencilView
+
+      Summary:  Rasterizes the pending tiles, then fills the depth
+                buffer. Stencil is not emulated
+
+      Args:     ID3D11DepthStencilView* pDepthStencilView
+                  Depth buffer to clear
+                UINT uClearFlags
+                  D3D11_CLEAR_DEPTH to clear depth
+                FLOAT depth
+                  Depth to clear to
+                UINT8 stencil
+                  Ignored
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void SoftwareRenderBackend::ClearDepthStencilView(_In_ ID3D11DepthStencilView* pDepthStencilView, _In_ UINT uClearFlags, _In_ FLOAT depth, _In_ UINT8 stencil)
+    {
+        UNREFERENCED_PARAMETER(stencil);
+
+        flush();
+
+        NullResourceData target;
+        if (!(uClearFlags & D3D11_CLEAR_DEPTH) || FAILED(getViewData(pDepthStencilView, &target)))
+        {
+            return;
+        }
+
+        m_threadPool->ParallelFor((target.uHeight + SOFTWARE_TILE_SIZE - 1u) / SOFTWARE_TILE_SIZE, [&](UINT uBand)
+        {
+            UINT uLastRow = std::min((uBand + 1u) * SOFTWARE_TILE_SIZE, target.uHeight);
+            for (UINT y = uBand * SOFTWARE_TILE_SIZE; y < uLastRow; ++y)
+            {
+                FLOAT* pRow = reinterpret_cast<FLOAT*>(target.pData + static_cast<SIZE_T>(y) * target.uRowPitch);
+                std::fill(pRow, pRow + target.uWidth, depth);
+            }
+        });
+    }
+
+
+    void SoftwareRenderBackend::UpdateBuffer(_In_ ID3D11Buffer* pBuffer, _In_reads_bytes_(uDataSize) const void* pData, _In_ UINT uDataSize)
+    {
+        // Pending pixels read copies of their constant buffers, so the
+        // bins do not need to be flushed
+        NullResourceData buffer = getBufferData(pBuffer);
+        if (buffer.pData)
+        {
+            memcpy(buffer.pData, pData, std::min(static_cast<SIZE_T>(uDataSize), buffer.uSize));
+        }
+    }
+
+
+    void SoftwareRenderBackend::WriteDynamicBuffer(_In_ ID3D11Buffer* pBuffer, _In_ UINT uOffset, _In_reads_bytes_(uDataSize) const void* pData, _In_ UINT uDataSize, _In_ BOOL bDiscard)
+    {
+        // Draws read constants when they are issued, so ranges written
+        // later never race them and discarding needs no renaming
+        UNREFERENCED_PARAMETER(bDiscard);
+
+        NullResourceData buffer = getBufferData(pBuffer);
+        if (buffer.pData && uOffset < buffer.uSize)
+        {
+            memcpy(buffer.pData + uOffset, pData, std::min(static_cast<SIZE_T>(uDataSize), buffer.uSize - uOffset));
+        }
+    }
+
+
+    BOOL SoftwareRenderBackend::SupportsConstantBufferOffsets() const
+    {
+        return TRUE;
+    }
+
+
+    void SoftwareRenderBackend::SetVertexBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppVertexBuffers, _In_reads_opt_(uNumBuffers) const UINT* puStrides, _In_reads_opt_(uNumBuffers) const UINT* puOffsets)
+    {
+        for (UINT i = 0u; i < uNumBuffers && uStartSlot + i < SOFTWARE_MAX_VERTEX_BUFFERS; ++i)
+        {
+            m_aVertexBuffers[uStartSlot + i] = getBufferData(ppVertexBuffers ? ppVertexBuffers[i] : nullptr);
+            m_auVertexStrides[uStartSlot + i] = puStrides ? puStrides[i] : 0u;
+            m_auVertexOffsets[uStartSlot + i] = puOffsets ? puOffsets[i] : 0u;
+        }
+    }
+
+
+    void SoftwareRenderBackend::SetIndexBuffer(_In_opt_ ID3D11Buffer* pIndexBuffer, _In_ DXGI_FORMAT format, _In_ UINT uOffset)
+    {
+        m_indexBuffer = getBufferData(pIndexBuffer);
+        m_indexFormat = format;
+        m_uIndexOffset = uOffset;
+    }
+
+
+    void SoftwareRenderBackend::SetInputLayout(_In_opt_ ID3D11InputLayout* pInputLayout)
+    {
+        // The shader ports read the vertex structures of the renderer
+        // directly, so the layout is not needed
+        UNREFERENCED_PARAMETER(pInputLayout);
+    }
+
+
+    void SoftwareRenderBackend::SetPrimitiveTopology(_In_ D3D11_PRIMITIVE_TOPOLOGY topology)
+    {
+        m_topology = topology;
+    }
+
+
+    void SoftwareRenderBackend::SetVertexShader(_In_opt_ ID3D11VertexShader* pVertexShader)
+    {
+        m_pVertexShader = FindSoftwareVertexShader(getShaderName(pVertexShader));
+    }
+
+
+    void SoftwareRenderBackend::SetVSConstantBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers)
+    {
+        for (UINT i = 0u; i < uNumBuffers && uStartSlot + i < SOFTWARE_MAX_CONSTANT_BUFFERS; ++i)
+        {
+            m_aVSConstantBuffers[uStartSlot + i] = getBufferData(ppConstantBuffers ? ppConstantBuffers[i] : nullptr);
+        }
+    }
+
+
+    void SoftwareRenderBackend::SetVSConstantBufferRanges(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers, _In_reads_(uNumBuffers) const UINT* puFirstConstants, _In_reads_(uNumBuffers) const UINT* puNumConstants)
+    {
+        for (UINT i = 0u; i < uNumBuffers && uStartSlot + i < SOFTWARE_MAX_CONSTANT_BUFFERS; ++i)
+        {
+            m_aVSConstantBuffers[uStartSlot + i] = getBufferRangeData(ppConstantBuffers ? ppConstantBuffers[i] : nullptr, puFirstConstants[i], puNumConstants[i]);
+        }
+    }
+
+
+    void SoftwareRenderBackend::SetPixelShader(_In_opt_ ID3D11PixelShader* pPixelShader)
+    {
+        m_pPixelShader = FindSoftwarePixelShader(getShaderName(pPixelShader));
+    }
+
+
+    void SoftwareRenderBackend::SetPSConstantBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers)
+    {
+        for (UINT i = 0u; i < uNumBuffers && uStartSlot + i < SOFTWARE_MAX_CONSTANT_BUFFERS; ++i)
+        {
+            m_aPSConstantBuffers[uStartSlot + i] = getBufferData(ppConstantBuffers ? ppConstantBuffers[i] : nullptr);
+        }
+    }
+
+
+    void SoftwareRenderBackend::SetPSConstantBufferRanges(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers, _In_reads_(uNumBuffers) const UINT* puFirstConstants, _In_reads_(uNumBuffers) const UINT* puNumConstants)
+    {
+        for (UINT i = 0u; i < uNumBuffers && uStartSlot + i < SOFTWARE_MAX_CONSTANT_BUFFERS; ++i)
+        {
+            m_aPSConstantBuffers[uStartSlot + i] = getBufferRangeData(ppConstantBuffers ? ppConstantBuffers[i] : nullptr, puFirstConstants[i], puNumConstants[i]);
+        }
+    }
+
+
+    void SoftwareRenderBackend::SetPSShaderResources(_In_ UINT uStartSlot, _In_ UINT uNumViews, _In_reads_opt_(uNumViews) ID3D11ShaderResourceView* const* ppShaderResourceViews)
+    {
+        for (UINT i = 0u; i < uNumViews && uStartSlot + i < SOFTWARE_MAX_SHADER_RESOURCES; ++i)
+        {
+            NullResourceData data;
+            getViewData(ppShaderResourceViews ? ppShaderResourceViews[i] : nullptr, &data);
+
+            m_aTextures[uStartSlot + i] =
+            {
+                .pData = data.pData,
+                .uWidth = data.uWidth,
+                .uHeight = data.uHeight,
+                .uRowPitch = data.uRowPitch,
+                .uArraySize = data.uArraySize,
+                .Format = data.Format
+            };
+        }
+    }
+
+
+    void SoftwareRenderBackend::SetPSSamplers(_In_ UINT uStartSlot, _In_ UINT uNumSamplers, _In_reads_opt_(uNumSamplers) ID3D11SamplerState* const* ppSamplers)
+    {
+        for (UINT i = 0u; i < uNumSamplers && uStartSlot + i < SOFTWARE_MAX_SHADER_RESOURCES; ++i)
+        {
+            // The default sampler is linear and clamped
+            D3D11_SAMPLER_DESC desc =
+            {
+                .Filter = D3D11_FILTER_MIN_MAG_MIP_LINEAR,
+                .AddressU = D3D11_TEXTURE_ADDRESS_CLAMP
+            };
+            if (ppSamplers && ppSamplers[i])
+            {
+                ppSamplers[i]->GetDesc(&desc);
+            }
+
+            m_aSamplers[uStartSlot + i] =
+            {
+                .bPoint = desc.Filter == D3D11_FILTER_MIN_MAG_MIP_POINT,
+                .bClamp = desc.AddressU == D3D11_TEXTURE_ADDRESS_CLAMP || desc.AddressU == D3D11_TEXTURE_ADDRESS_BORDER
+            };
+        }
+    }
+
+
+    void SoftwareRenderBackend::DrawIndexed(_In_ UINT uIndexCount, _In_ UINT uStartIndexLocation, _In_ INT nBaseVertexLocation)
+    {
+        DrawIndexedInstanced(uIndexCount, 1u, uStartIndexLocation, nBaseVertexLocation, 0u);
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   SoftwareRenderBackend::DrawIndexedInstanced
+
+      Summary:  Shades the vertices the indices reference once per
+                instance, then sets up and bins every triangle. The
+                pixel stage state is saved for the flush
+
+      Args:     UINT uIndexCountPerInstance
+                UINT uInstanceCount
+                UINT uStartIndexLocation
+                INT nBaseVertexLocation
+                UINT uStartInstanceLocation
+                  As ID3D11DeviceContext::DrawIndexedInstanced
+
+      Modifies: [m_statistics, m_indices, m_draws, m_constants].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void SoftwareRenderBackend::DrawIndexedInstanced(_In_ UINT uIndexCountPerInstance, _In_ UINT uInstanceCount, _In_ UINT uStartIndexLocation, _In_ INT nBaseVertexLocation, _In_ UINT uStartInstanceLocation)
+    {
+        ++m_statistics.uNumDrawCalls;
+
+        const UINT uIndexSize = m_indexFormat == DXGI_FORMAT_R32_UINT ? 4u : 2u;
+        const SIZE_T uFirstIndexByte = m_uIndexOffset + static_cast<SIZE_T>(uStartIndexLocation) * uIndexSize;
+        if (!m_pVertexShader || !m_pPixelShader || m_uTargetWidth == 0u || m_topology != D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST
+            || !m_indexBuffer.pData || uFirstIndexByte + static_cast<SIZE_T>(uIndexCountPerInstance) * uIndexSize > m_indexBuffer.uSize)
+        {
+            ++m_statistics.uNumUnsupportedDrawCalls;
+            return;
+        }
+
+        uIndexCountPerInstance -= uIndexCountPerInstance % 3u;
+        if (uIndexCountPerInstance == 0u || uInstanceCount == 0u)
+        {
+            return;
+        }
+
+        m_indices.resize(uIndexCountPerInstance);
+        UINT uMinIndex = UINT_MAX;
+        UINT uMaxIndex = 0u;
+        for (UINT i = 0u; i < uIndexCountPerInstance; ++i)
+        {
+            const BYTE* pIndex = m_indexBuffer.pData + uFirstIndexByte + static_cast<SIZE_T>(i) * uIndexSize;
+            UINT uIndex = 0u;
+            if (uIndexSize == 2u)
+            {
+                UINT16 uShortIndex;
+                memcpy(&uShortIndex, pIndex, sizeof(uShortIndex));
+                uIndex = uShortIndex;
+            }
+            else
+            {
+                memcpy(&uIndex, pIndex, sizeof(uIndex));
+            }
+
+            m_indices[i] = uIndex;
+            uMinIndex = std::min(uMinIndex, uIndex);
+            uMaxIndex = std::max(uMaxIndex, uIndex);
+        }
+
+        const UINT uNumVertices = uMaxIndex - uMinIndex + 1u;
+        const UINT uNumVaryings = m_pVertexShader->uNumVaryings;
+        const UINT uVertexSize = 4u + uNumVaryings;
+
+        shadeVertices(uMinIndex, uNumVertices, uInstanceCount, nBaseVertexLocation, uStartInstanceLocation);
+
+        // Snapshot the pixel stage state
+        SoftwareDraw draw =
+        {
+            .pPixelShader = m_pPixelShader,
+            .uNumVaryings = uNumVaryings,
+            .auConstantOffsets = {},
+            .Resources = {}
+        };
+        for (UINT i = 0u; i < SOFTWARE_MAX_CONSTANT_BUFFERS; ++i)
+        {
+            draw.auConstantOffsets[i] = NO_CONSTANT_BUFFER;
+            if (m_aPSConstantBuffers[i].pData)
+            {
+                SIZE_T uOffset = (m_constants.size() + 15u) & ~static_cast<SIZE_T>(15u);
+                m_constants.resize(uOffset + m_aPSConstantBuffers[i].uSize);
+                memcpy(m_constants.data() + uOffset, m_aPSConstantBuffers[i].pData, m_aPSConstantBuffers[i].uSize);
+                draw.auConstantOffsets[i] = static_cast<UINT>(uOffset);
+            }
+        }
+        std::copy(std::begin(m_aTextures), std::end(m_aTextures), draw.Resources.aTextures);
+        std::copy(std::begin(m_aSamplers), std::end(m_aSamplers), draw.Resources.aSamplers);
+        m_draws.push_back(draw);
+
+        for (UINT uInstance = 0u; uInstance < uInstanceCount; ++uInstance)
+        {
+            const FLOAT* pInstanceVertices = m_shadedVertices.data() + static_cast<SIZE_T>(uInstance) * uNumVertices * uVertexSize;
+            for (UINT i = 0u; i < uIndexCountPerInstance; i += 3u)
+            {
+                const FLOAT* apVertices[3] =
+                {
+                    pInstanceVertices + static_cast<SIZE_T>(m_indices[i] - uMinIndex) * uVertexSize,
+                    pInstanceVertices + static_cast<SIZE_T>(m_indices[i + 1u] - uMinIndex) * uVertexSize,
+                    pInstanceVertices + static_cast<SIZE_T>(m_indices[i + 2u] - uMinIndex) * uVertexSize
+                };
+                setupTriangle(apVertices, uNumVaryings);
+            }
+        }
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   SoftwareRenderBackend::shadeVertices
+
+      Summary:  Runs the vertex shader on every vertex in the index
+                range for every instance, in parallel for large draws.
+                Each shaded vertex is the clip space position followed
+                by the varyings. Vertex buffer slots that cannot hold
+                the range read as zero
+
+      Args:     UINT uMinIndex
+                  Smallest index of the draw
+                UINT uNumVertices
+                  Number of vertices from the smallest index on
+                UINT uInstanceCount
+                  Number of instances
+                INT nBaseVertexLocation
+                  Added to every index
+                UINT uStartInstanceLocation
+                  First element of the instance slot
+
+      Modifies: [m_shadedVertices, m_statistics].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void SoftwareRenderBackend::shadeVertices(_In_ UINT uMinIndex, _In_ UINT uNumVertices, _In_ UINT uInstanceCount, _In_ INT nBaseVertexLocation, _In_ UINT uStartInstanceLocation)
+    {
+        constexpr UINT VERTICES_PER_JOB = 256u;
+
+        const INT64 nFirstVertex = static_cast<INT64>(uMinIndex) + nBaseVertexLocation;
+        const BYTE* apBases[SOFTWARE_MAX_VERTEX_BUFFERS];
+        SIZE_T auStrides[SOFTWARE_MAX_VERTEX_BUFFERS];
+        for (UINT uSlot = 0u; uSlot < SOFTWARE_MAX_VERTEX_BUFFERS; ++uSlot)
+        {
+            const NullResourceData& buffer = m_aVertexBuffers[uSlot];
+            SIZE_T uStride = m_auVertexStrides[uSlot];
+            INT64 nFirst = uSlot == SOFTWARE_INSTANCE_SLOT ? static_cast<INT64>(uStartInstanceLocation) : nFirstVertex;
+            INT64 nCount = uSlot == SOFTWARE_INSTANCE_SLOT ? static_cast<INT64>(uInstanceCount) : static_cast<INT64>(uNumVertices);
+
+            if (buffer.pData && uStride > 0u && nFirst >= 0
+                && m_auVertexOffsets[uSlot] + static_cast<SIZE_T>(nFirst + nCount) * uStride <= buffer.uSize)
+            {
+                apBases[uSlot] = buffer.pData + m_auVertexOffsets[uSlot] + static_cast<SIZE_T>(nFirst) * uStride;
+                auStrides[uSlot] = uStride;
+            }
+            else
+            {
+                apBases[uSlot] = s_aZeros;
+                auStrides[uSlot] = 0u;
+            }
+        }
+
+        SoftwareShaderResources resources = {};
+        for (UINT i = 0u; i < SOFTWARE_MAX_CONSTANT_BUFFERS; ++i)
+        {
+            resources.apConstantBuffers[i] = m_aVSConstantBuffers[i].pData ? m_aVSConstantBuffers[i].pData : s_aZeros;
+        }
+        std::copy(std::begin(m_aTextures), std::end(m_aTextures), resources.aTextures);
+        std::copy(std::begin(m_aSamplers), std::end(m_aSamplers), resources.aSamplers);
+
+        const SoftwareVertexShaderFunction pFunction = m_pVertexShader->pFunction;
+        const UINT uVertexSize = 4u + m_pVertexShader->uNumVaryings;
+        m_shadedVertices.resize(static_cast<SIZE_T>(uInstanceCount) * uNumVertices * uVertexSize);
+        m_statistics.uNumVertices += static_cast<UINT64>(uInstanceCount) * uNumVertices;
+
+        const UINT uJobsPerInstance = (uNumVertices + VERTICES_PER_JOB - 1u) / VERTICES_PER_JOB;
+        auto shadeJob = [&](UINT uJob)
+        {
+            UINT uInstance = uJob / uJobsPerInstance;
+            UINT uFirst = (uJob % uJobsPerInstance) * VERTICES_PER_JOB;
+            UINT uLast = std::min(uFirst + VERTICES_PER_JOB, uNumVertices);
+
+            SoftwareVertexInput input;
+            SoftwareVertexOutput output = {};
+            for (UINT uSlot = 0u; uSlot < SOFTWARE_MAX_VERTEX_BUFFERS; ++uSlot)
+            {
+                input.apElements[uSlot] = apBases[uSlot];
+            }
+            input.apElements[SOFTWARE_INSTANCE_SLOT] = apBases[SOFTWARE_INSTANCE_SLOT] + uInstance * auStrides[SOFTWARE_INSTANCE_SLOT];
+
+            FLOAT* pShaded = m_shadedVertices.data() + (static_cast<SIZE_T>(uInstance) * uNumVertices + uFirst) * uVertexSize;
+            for (UINT uVertex = uFirst; uVertex < uLast; ++uVertex)
+            {
+                for (UINT uSlot = 0u; uSlot < SOFTWARE_MAX_VERTEX_BUFFERS; ++uSlot)
+                {
+                    if (uSlot != SOFTWARE_INSTANCE_SLOT)
+                    {
+                        input.apElements[uSlot] = apBases[uSlot] + uVertex * auStrides[uSlot];
+                    }
+                }
+
+                pFunction(resources, input, output);
+
+                memcpy(pShaded, &output, uVertexSize * sizeof(FLOAT));
+                pShaded += uVertexSize;
+            }
+        };
+
+        const UINT uNumJobs = uJobsPerInstance * uInstanceCount;
+        if (static_cast<UINT64>(uInstanceCount) * uNumVertices < 2u * VERTICES_PER_JOB)
+        {
+            for (UINT uJob = 0u; uJob < uNumJobs; ++uJob)
+            {
+                shadeJob(uJob);
+            }
+        }
+        else
+        {
+            m_threadPool->ParallelFor(uNumJobs, shadeJob);
+        }
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   SoftwareRenderBackend::setupTriangle
+
+      Summary:  Rejects a triangle outside the view volume and clips it
+                against the near plane, z = 0, before binning. The other
+                planes are left to the viewport and depth tests
+
+      Args:     const FLOAT* const* ppVertices
+                  The three shaded vertices
+                UINT uNumVaryings
+                  Number of varyings after each position
+
+      Modifies: [m_statistics].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void SoftwareRenderBackend::setupTriangle(_In_reads_(3) const FLOAT* const* ppVertices, _In_ UINT uNumVaryings)
+    {
+        ++m_statistics.uNumTriangles;
+
+        // Outcodes of the six clip planes
+        UINT uOutsideAll = 0x3Fu;
+        UINT uOutsideAny = 0u;
+        for (UINT i = 0u; i < 3u; ++i)
+        {
+            const FLOAT* p = ppVertices[i];
+            UINT uOutcode = (p[0] < -p[3] ? 0x01u : 0u) | (p[0] > p[3] ? 0x02u : 0u)
+                | (p[1] < -p[3] ? 0x04u : 0u) | (p[1] > p[3] ? 0x08u : 0u)
+                | (p[2] < 0.0f ? 0x10u : 0u) | (p[2] > p[3] ? 0x20u : 0u);
+            uOutsideAll &= uOutcode;
+            uOutsideAny |= uOutcode;
+        }
+
+        if (uOutsideAll != 0u)
+        {
+            ++m_statistics.uNumCulledTriangles;
+            return;
+        }
+
+        if (!(uOutsideAny & 0x10u))
+        {
+            if (!binTriangle(ppVertices, uNumVaryings))
+            {
+                ++m_statistics.uNumCulledTriangles;
+            }
+            return;
+        }
+
+        // Sutherland-Hodgman against z >= 0 leaves at most four vertices
+        const UINT uVertexSize = 4u + uNumVaryings;
+        FLOAT aaClipped[4][4u + SOFTWARE_MAX_VARYINGS];
+        UINT uNumClipped = 0u;
+        for (UINT i = 0u; i < 3u; ++i)
+        {
+            const FLOAT* pA = ppVertices[i];
+            const FLOAT* pB = ppVertices[(i + 1u) % 3u];
+            if (pA[2] >= 0.0f)
+            {
+                memcpy(aaClipped[uNumClipped++], pA, uVertexSize * sizeof(FLOAT));
+            }
+            if ((pA[2] >= 0.0f) != (pB[2] >= 0.0f))
+            {
+                FLOAT t = pA[2] / (pA[2] - pB[2]);
+                for (UINT j = 0u; j < uVertexSize; ++j)
+                {
+                    aaClipped[uNumClipped][j] = pA[j] + t * (pB[j] - pA[j]);
+                }
+                ++uNumClipped;
+            }
+        }
+
+        BOOL bBinned = FALSE;
+        for (UINT i = 1u; i + 1u < uNumClipped; ++i)
+        {
+            const FLOAT* apFan[3] = { aaClipped[0], aaClipped[i], aaClipped[i + 1u] };
+            bBinned |= binTriangle(apFan, uNumVaryings);
+        }
+
+        if (!bBinned)
+        {
+            ++m_statistics.uNumCulledTriangles;
+        }
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   SoftwareRenderBackend::binTriangle
+
+      Summary:  Projects a clipped triangle to the viewport, culls it
+                if it is back facing or covers no pixel center, sets up
+                its edge functions and attribute planes and adds it to
+                the bin of every tile its bounds overlap
+
+      Args:     const FLOAT* const* ppVertices
+                  The three clip space vertices
+                UINT uNumVaryings
+                  Number of varyings after each position
+
+      Modifies: [m_triangles, m_attributes, m_aTileBins,
+                  m_occupiedTiles].
+
+      Returns:  BOOL
+                  TRUE if the triangle was binned
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL SoftwareRenderBackend::binTriangle(_In_reads_(3) const FLOAT* const* ppVertices, _In_ UINT uNumVaryings)
+    {
+        FLOAT aX[3], aY[3], aZ[3], aInvW[3];
+        for (UINT i = 0u; i < 3u; ++i)
+        {
+            const FLOAT* p = ppVertices[i];
+            if (!(p[3] > 0.0f))
+            {
+                return FALSE;
+            }
+
+            aInvW[i] = 1.0f / p[3];
+            aX[i] = (p[0] * aInvW[i] * 0.5f + 0.5f) * m_viewport.Width + m_viewport.TopLeftX;
+            aY[i] = (0.5f - p[1] * aInvW[i] * 0.5f) * m_viewport.Height + m_viewport.TopLeftY;
+            aZ[i] = m_viewport.MinDepth + p[2] * aInvW[i] * (m_viewport.MaxDepth - m_viewport.MinDepth);
+        }
+
+        // Clockwise triangles face the viewer; y points down on screen
+        FLOAT area = (aX[1] - aX[0]) * (aY[2] - aY[0]) - (aX[2] - aX[0]) * (aY[1] - aY[0]);
+        if (!(area > 0.0f))
+        {
+            return FALSE;
+        }
+
+        // Pixels whose centers can lie inside, clamped to the viewport
+        INT nLeft = std::max(static_cast<INT>(std::floor(m_viewport.TopLeftX)), 0);
+        INT nTop = std::max(static_cast<INT>(std::floor(m_viewport.TopLeftY)), 0);
+        INT nRight = std::min(static_cast<INT>(std::ceil(m_viewport.TopLeftX + m_viewport.Width)), static_cast<INT>(m_uTargetWidth)) - 1;
+        INT nBottom = std::min(static_cast<INT>(std::ceil(m_viewport.TopLeftY + m_viewport.Height)), static_cast<INT>(m_uTargetHeight)) - 1;
+
+        FLOAT minX = std::max(std::ceil(std::min({ aX[0], aX[1], aX[2] }) - 0.5f), static_cast<FLOAT>(nLeft));
+        FLOAT minY = std::max(std::ceil(std::min({ aY[0], aY[1], aY[2] }) - 0.5f), static_cast<FLOAT>(nTop));
+        FLOAT maxX = std::min(std::floor(std::max({ aX[0], aX[1], aX[2] }) - 0.5f), static_cast<FLOAT>(nRight));
+        FLOAT maxY = std::min(std::floor(std::max({ aY[0], aY[1], aY[2] }) - 0.5f), static_cast<FLOAT>(nBottom));
+        if (minX > maxX || minY > maxY)
+        {
+            return FALSE;
+        }
+
+        SoftwareTriangle triangle =
+        {
+            .OriginX = aX[0],
+            .OriginY = aY[0],
+            .nMinX = static_cast<INT>(minX),
+            .nMinY = static_cast<INT>(minY),
+            .nMaxX = static_cast<INT>(maxX),
+            .nMaxY = static_cast<INT>(maxY),
+            .uDraw = static_cast<UINT>(m_draws.size() - 1u),
+            .uFirstAttribute = static_cast<UINT>(m_attributes.size())
+        };
+
+        // Edge k is opposite vertex k, so it evaluates to its barycentric
+        const FLOAT invArea = 1.0f / area;
+        for (UINT k = 0u; k < 3u; ++k)
+        {
+            UINT a = (k + 1u) % 3u;
+            UINT b = (k + 2u) % 3u;
+            FLOAT edgeA = aY[a] - aY[b];
+            FLOAT edgeB = aX[b] - aX[a];
+
+            triangle.aEdgeA[k] = edgeA * invArea;
+            triangle.aEdgeB[k] = edgeB * invArea;
+            triangle.aEdgeC[k] = -(edgeA * (aX[a] - aX[0]) + edgeB * (aY[a] - aY[0])) * invArea;
+            triangle.abTopLeft[k] = edgeA > 0.0f || (edgeA == 0.0f && edgeB > 0.0f);
+        }
+
+        // Planes of depth, 1/w and the perspective divided varyings
+        auto addPlane = [this](FLOAT value0, FLOAT value1, FLOAT value2)
+        {
+            m_attributes.push_back(value0);
+            m_attributes.push_back(value1 - value0);
+            m_attributes.push_back(value2 - value0);
+        };
+        addPlane(aZ[0], aZ[1], aZ[2]);
+        addPlane(aInvW[0], aInvW[1], aInvW[2]);
+        for (UINT i = 0u; i < uNumVaryings; ++i)
+        {
+            addPlane(ppVertices[0][4u + i] * aInvW[0], ppVertices[1][4u + i] * aInvW[1], ppVertices[2][4u + i] * aInvW[2]);
+        }
+
+        const UINT uTriangle = static_cast<UINT>(m_triangles.size());
+        m_triangles.push_back(triangle);
+
+        for (UINT uTileY = triangle.nMinY / SOFTWARE_TILE_SIZE; uTileY <= triangle.nMaxY / SOFTWARE_TILE_SIZE; ++uTileY)
+        {
+            for (UINT uTileX = triangle.nMinX / SOFTWARE_TILE_SIZE; uTileX <= triangle.nMaxX / SOFTWARE_TILE_SIZE; ++uTileX)
+            {
+                UINT uTile = uTileY * m_uNumTilesX + uTileX;
+                if (m_aTileBins[uTile].empty())
+                {
+                    m_occupiedTiles.push_back(uTile);
+                }
+                m_aTileBins[uTile].push_back(uTriangle);
+            }
+        }
+
+        return TRUE;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   SoftwareRenderBackend::rasterizeTile
+
+      Summary:  Rasterizes the triangles of one tile in the order they
+                were drawn. Coverage, depth and the interpolation of the
+                varyings are computed four pixels at a time; the pixel
+                shader then runs once per covered pixel that passes the
+                depth test
+
+      Args:     UINT uTile
+                  Index of the tile, row major
+
+      Returns:  UINT64
+                  Number of pixels shaded
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT64 SoftwareRenderBackend::rasterizeTile(_In_ UINT uTile)
+    {
+        static const XMVECTORU32 s_aLaneMasks[NUM_LANES + 1u] =
+        {
+            { { { 0u, 0u, 0u, 0u } } },
+            { { { 0xFFFFFFFFu, 0u, 0u, 0u } } },
+            { { { 0xFFFFFFFFu, 0xFFFFFFFFu, 0u, 0u } } },
+            { { { 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0u } } },
+            { { { 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu } } },
+        };
+        static const XMVECTORU32 s_allOnes = { { { 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu } } };
+
+        const INT nTileMinX = static_cast<INT>((uTile % m_uNumTilesX) * SOFTWARE_TILE_SIZE);
+        const INT nTileMinY = static_cast<INT>((uTile / m_uNumTilesX) * SOFTWARE_TILE_SIZE);
+        const INT nTileMaxX = nTileMinX + static_cast<INT>(SOFTWARE_TILE_SIZE) - 1;
+        const INT nTileMaxY = nTileMinY + static_cast<INT>(SOFTWARE_TILE_SIZE) - 1;
+
+        const BOOL bHasDepth = m_depthStencil.pData != nullptr;
+        BYTE aTexel[16];
+        const UINT uTexelSize = encodeTexel(XMVectorZero(), m_renderTarget.Format, aTexel);
+        const XMVECTOR laneOffsets = XMVectorSet(0.5f, 1.5f, 2.5f, 3.5f);
+        const XMVECTOR zero = XMVectorZero();
+        const XMVECTOR maxDepth = XMVectorReplicate(std::max(m_viewport.MinDepth, m_viewport.MaxDepth));
+
+        UINT64 uNumPixelsShaded = 0u;
+        FLOAT aaLaneVaryings[NUM_LANES][SOFTWARE_MAX_VARYINGS];
+
+        for (UINT uTriangle : m_aTileBins[uTile])
+        {
+            const SoftwareTriangle& triangle = m_triangles[uTriangle];
+            const SoftwareDraw& draw = m_draws[triangle.uDraw];
+            const FLOAT* pPlanes = m_attributes.data() + triangle.uFirstAttribute;
+            const UINT uNumVaryings = draw.uNumVaryings;
+
+            const INT nMinX = std::max(triangle.nMinX, nTileMinX);
+            const INT nMinY = std::max(triangle.nMinY, nTileMinY);
+            const INT nMaxX = std::min(triangle.nMaxX, nTileMaxX);
+            const INT nMaxY = std::min(triangle.nMaxY, nTileMaxY);
+
+            XMVECTOR aEdgeA[3], aEdgeB[3], aEdgeC[3], aTopLeft[3];
+            for (UINT k = 0u; k < 3u; ++k)
+            {
+                aEdgeA[k] = XMVectorReplicate(triangle.aEdgeA[k]);
+                aEdgeB[k] = XMVectorReplicate(triangle.aEdgeB[k]);
+                aEdgeC[k] = XMVectorReplicate(triangle.aEdgeC[k]);
+                aTopLeft[k] = triangle.abTopLeft[k] ? XMVECTOR(s_allOnes) : zero;
+            }
+
+            for (INT y = nMinY; y <= nMaxY; ++y)
+            {
+                const XMVECTOR dy = XMVectorReplicate(static_cast<FLOAT>(y) + 0.5f - triangle.OriginY);
+                BYTE* pColorRow = m_renderTarget.pData ? m_renderTarget.pData + static_cast<SIZE_T>(y) * m_renderTarget.uRowPitch : nullptr;
+                FLOAT* pDepthRow = bHasDepth ? reinterpret_cast<FLOAT*>(m_depthStencil.pData + static_cast<SIZE_T>(y) * m_depthStencil.uRowPitch) : nullptr;
+
+                for (INT x = nMinX; x <= nMaxX; x += static_cast<INT>(NUM_LANES))
+                {
+                    const UINT uNumLanes = static_cast<UINT>(std::min(nMaxX - x + 1, static_cast<INT>(NUM_LANES)));
+                    const XMVECTOR dx = XMVectorReplicate(static_cast<FLOAT>(x) - triangle.OriginX) + laneOffsets;
+
+                    // Barycentrics of the four pixel centers and the top-left fill rule
+                    XMVECTOR aBarycentrics[3];
+                    XMVECTOR mask = s_aLaneMasks[uNumLanes];
+                    for (UINT k = 0u; k < 3u; ++k)
+                    {
+                        aBarycentrics[k] = XMVectorMultiplyAdd(aEdgeA[k], dx, XMVectorMultiplyAdd(aEdgeB[k], dy, aEdgeC[k]));
+                        XMVECTOR inside = XMVectorOrInt(XMVectorGreater(aBarycentrics[k], zero), XMVectorAndInt(XMVectorEqual(aBarycentrics[k], zero), aTopLeft[k]));
+                        mask = XMVectorAndInt(mask, inside);
+                    }
+
+                    const XMVECTOR b1 = aBarycentrics[1];
+                    const XMVECTOR b2 = aBarycentrics[2];
+                    auto interpolate = [&](const FLOAT* pPlane)
+                    {
+                        return XMVectorMultiplyAdd(b2, XMVectorReplicate(pPlane[2]), XMVectorMultiplyAdd(b1, XMVectorReplicate(pPlane[1]), XMVectorReplicate(pPlane[0])));
+                    };
+
+                    const XMVECTOR depth = interpolate(pPlanes);
+                    mask = XMVectorAndInt(mask, XMVectorAndInt(XMVectorGreaterOrEqual(depth, zero), XMVectorLessOrEqual(depth, maxDepth)));
+
+                    XMFLOAT4 storedDepth(1.0f, 1.0f, 1.0f, 1.0f);
+                    if (bHasDepth)
+                    {
+                        memcpy(&storedDepth, pDepthRow + x, uNumLanes * sizeof(FLOAT));
+                        mask = XMVectorAndInt(mask, XMVectorLess(depth, XMLoadFloat4(&storedDepth)));
+                    }
+
+                    uint32_t auMask[NUM_LANES];
+                    XMStoreInt4(auMask, mask);
+                    if (!(auMask[0] | auMask[1] | auMask[2] | auMask[3]))
+                    {
+                        continue;
+                    }
+
+                    if (bHasDepth)
+                    {
+                        XMStoreFloat4(&storedDepth, XMVectorSelect(XMLoadFloat4(&storedDepth), depth, mask));
+                        memcpy(pDepthRow + x, &storedDepth, uNumLanes * sizeof(FLOAT));
+                    }
+
+                    if (!pColorRow || uTexelSize == 0u)
+                    {
+                        continue;
+                    }
+
+                    // Perspective correct varyings of all four lanes
+                    const XMVECTOR w = XMVectorReciprocal(interpolate(pPlanes + 3u));
+                    for (UINT i = 0u; i < uNumVaryings; ++i)
+                    {
+                        XMFLOAT4 varying;
+                        XMStoreFloat4(&varying, interpolate(pPlanes + 6u + 3u * i) * w);
+                        aaLaneVaryings[0][i] = varying.x;
+                        aaLaneVaryings[1][i] = varying.y;
+                        aaLaneVaryings[2][i] = varying.z;
+                        aaLaneVaryings[3][i] = varying.w;
+                    }
+
+                    for (UINT uLane = 0u; uLane < uNumLanes; ++uLane)
+                    {
+                        if (auMask[uLane])
+                        {
+                            XMVECTOR color = draw.pPixelShader->pFunction(draw.Resources, aaLaneVaryings[uLane]);
+                            encodeTexel(color, m_renderTarget.Format, pColorRow + static_cast<SIZE_T>(x + uLane) * uTexelSize);
+                            ++uNumPixelsShaded;
+                        }
+                    }
+                }
+            }
+        }
+
+        return uNumPixelsShaded;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   SoftwareRenderBackend::flush
+
+      Summary:  Rasterizes every occupied tile, one tile per task on the
+                thread pool, and empties the bins
+
+      Modifies: [m_draws, m_constants, m_triangles, m_attributes,
+                  m_aTileBins, m_occupiedTiles, m_statistics].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void SoftwareRenderBackend::flush()
+    {
+        if (!m_occupiedTiles.empty())
+        {
+            for (SoftwareDraw& draw : m_draws)
+            {
+                for (UINT i = 0u; i < SOFTWARE_MAX_CONSTANT_BUFFERS; ++i)
+                {
+                    draw.Resources.apConstantBuffers[i] = draw.auConstantOffsets[i] == NO_CONSTANT_BUFFER ? s_aZeros : m_constants.data() + draw.auConstantOffsets[i];
+                }
+            }
+
+            std::atomic<UINT64> uNumPixelsShaded = 0u;
+            m_threadPool->ParallelFor(static_cast<UINT>(m_occupiedTiles.size()), [&](UINT i)
+            {
+                uNumPixelsShaded += rasterizeTile(m_occupiedTiles[i]);
+            });
+            m_statistics.uNumPixelsShaded += uNumPixelsShaded.load();
+
+            for (UINT uTile : m_occupiedTiles)
+            {
+                m_aTileBins[uTile].clear();
+            }
+        }
+
+        m_occupiedTiles.clear();
+        m_triangles.clear();
+        m_attributes.clear();
+        m_draws.clear();
+        m_constants.clear();
+    }
+}
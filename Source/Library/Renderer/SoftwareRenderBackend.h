@@ -0,0 +1,208 @@
+/*+===================================================================
+  File:      SOFTWARERENDERBACKEND.H
+
+  Summary:   SoftwareRenderBackend header file contains declarations
+             of the RenderBackend that rasterizes the frame on the CPU
+             into the system memory resources of the null device, so
+             scenes can be rendered to image files without a GPU.
+
+  Classes: SoftwareRenderBackend
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Platform/NullDevice.h"
+#include "Platform/ThreadPool.h"
+#include "Renderer/RenderBackend.h"
+#include "Shader/SoftwareShaders.h"
+
+namespace library
+{
+    constexpr UINT SOFTWARE_TILE_SIZE = 64u;
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   SoftwareRenderStatistics
+
+      Summary:  Work done by the software backend during the last
+                frame. Unsupported draws reference a shader without a
+                C++ port or resources of another device and are skipped
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct SoftwareRenderStatistics
+    {
+        UINT64 uNumDrawCalls;
+        UINT64 uNumUnsupportedDrawCalls;
+        UINT64 uNumVertices;
+        UINT64 uNumTriangles;
+        UINT64 uNumCulledTriangles;
+        UINT64 uNumPixelsShaded;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   SoftwareTriangle
+
+      Summary:  Set up triangle waiting in the tile bins. The edge
+                functions are scaled by the inverse area so they
+                evaluate to the barycentric coordinates of a pixel, and
+                are relative to the first vertex to keep precision.
+                Depth, 1/w and the varyings divided by w follow as
+                planes in the attribute array of the backend
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct SoftwareTriangle
+    {
+        FLOAT aEdgeA[3];
+        FLOAT aEdgeB[3];
+        FLOAT aEdgeC[3];
+        BOOL abTopLeft[3];
+        FLOAT OriginX;
+        FLOAT OriginY;
+        INT nMinX;
+        INT nMinY;
+        INT nMaxX;
+        INT nMaxY;
+        UINT uDraw;
+        UINT uFirstAttribute;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   SoftwareDraw
+
+      Summary:  Pixel stage state of a draw whose triangles wait in the
+                tile bins. Constant buffers are copied when the draw is
+                issued, since the renderer overwrites them before the
+                bins are flushed
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct SoftwareDraw
+    {
+        const SoftwarePixelShader* pPixelShader;
+        UINT uNumVaryings;
+        UINT auConstantOffsets[SOFTWARE_MAX_CONSTANT_BUFFERS];
+        SoftwareShaderResources Resources;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    SoftwareRenderBackend
+
+      Summary:  RenderBackend that runs the C++ ports of the game
+                shaders. Vertices are shaded when a draw is issued,
+                triangles are clipped, culled and binned into screen
+                tiles, and the tiles are rasterized in parallel when
+                the render target changes, is cleared or the frame
+                ends. Pixels are tested four at a time with DirectXMath
+                vectors. Only triangle lists with the default
+                rasterizer and depth state are drawn: back faces are
+                culled and depth passes when it is less than the depth
+                buffer, which keeps 32-bit float depth in its texels.
+                Resources must come from the null device
+
+      Methods:  SetNumThreads
+                  Sets the number of threads tiles are rasterized on
+                GetNumThreads
+                  Returns the number of threads
+                GetFrameStatistics
+                  Returns the work done during the last frame
+                SaveFrame
+                  Writes the render target of the last frame to a
+                  bitmap file
+                SaveRenderTarget
+                  Writes a render target to a bitmap file
+                SoftwareRenderBackend
+                  Constructor.
+                ~SoftwareRenderBackend
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class SoftwareRenderBackend final : public RenderBackend
+    {
+    public:
+        explicit SoftwareRenderBackend(_In_ UINT uNumThreads = 0u);
+        SoftwareRenderBackend(const SoftwareRenderBackend& other) = delete;
+        SoftwareRenderBackend(SoftwareRenderBackend&& other) = delete;
+        SoftwareRenderBackend& operator=(const SoftwareRenderBackend& other) = delete;
+        SoftwareRenderBackend& operator=(SoftwareRenderBackend&& other) = delete;
+        ~SoftwareRenderBackend() override = default;
+
+        void SetNumThreads(_In_ UINT uNumThreads);
+        UINT GetNumThreads() const;
+        const SoftwareRenderStatistics& GetFrameStatistics() const;
+        HRESULT SaveFrame(_In_ PCWSTR pszFileName);
+        HRESULT SaveRenderTarget(_In_ ID3D11RenderTargetView* pRenderTargetView, _In_ PCWSTR pszFileName);
+
+        void BeginFrame() override;
+        void EndFrame() override;
+        void BeginPass(_In_ PCWSTR pszPassName) override;
+        void EndPass() override;
+
+        void SetRenderTargets(_In_ UINT uNumViews, _In_reads_opt_(uNumViews) ID3D11RenderTargetView* const* ppRenderTargetViews, _In_opt_ ID3D11DepthStencilView* pDepthStencilView) override;
+        void SetViewports(_In_ UINT uNumViewports, _In_reads_(uNumViewports) const D3D11_VIEWPORT* pViewports) override;
+        void ClearRenderTargetView(_In_ ID3D11RenderTargetView* pRenderTargetView, _In_ const FLOAT aColorRGBA[4]) override;
+        void ClearDepthStencilView(_In_ ID3D11DepthStencilView* pDepthStencilView, _In_ UINT uClearFlags, _In_ FLOAT depth, _In_ UINT8 stencil) override;
+
+        void UpdateBuffer(_In_ ID3D11Buffer* pBuffer, _In_reads_bytes_(uDataSize) const void* pData, _In_ UINT uDataSize) override;
+        void WriteDynamicBuffer(_In_ ID3D11Buffer* pBuffer, _In_ UINT uOffset, _In_reads_bytes_(uDataSize) const void* pData, _In_ UINT uDataSize, _In_ BOOL bDiscard) override;
+        BOOL SupportsConstantBufferOffsets() const override;
+
+        void SetVertexBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppVertexBuffers, _In_reads_opt_(uNumBuffers) const UINT* puStrides, _In_reads_opt_(uNumBuffers) const UINT* puOffsets) override;
+        void SetIndexBuffer(_In_opt_ ID3D11Buffer* pIndexBuffer, _In_ DXGI_FORMAT format, _In_ UINT uOffset) override;
+        void SetInputLayout(_In_opt_ ID3D11InputLayout* pInputLayout) override;
+        void SetPrimitiveTopology(_In_ D3D11_PRIMITIVE_TOPOLOGY topology) override;
+
+        void SetVertexShader(_In_opt_ ID3D11VertexShader* pVertexShader) override;
+        void SetVSConstantBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers) override;
+        void SetVSConstantBufferRanges(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers, _In_reads_(uNumBuffers) const UINT* puFirstConstants, _In_reads_(uNumBuffers) const UINT* puNumConstants) override;
+        void SetPixelShader(_In_opt_ ID3D11PixelShader* pPixelShader) override;
+        void SetPSConstantBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers) override;
+        void SetPSConstantBufferRanges(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers, _In_reads_(uNumBuffers) const UINT* puFirstConstants, _In_reads_(uNumBuffers) const UINT* puNumConstants) override;
+        void SetPSShaderResources(_In_ UINT uStartSlot, _In_ UINT uNumViews, _In_reads_opt_(uNumViews) ID3D11ShaderResourceView* const* ppShaderResourceViews) override;
+        void SetPSSamplers(_In_ UINT uStartSlot, _In_ UINT uNumSamplers, _In_reads_opt_(uNumSamplers) ID3D11SamplerState* const* ppSamplers) override;
+
+        void DrawIndexed(_In_ UINT uIndexCount, _In_ UINT uStartIndexLocation, _In_ INT nBaseVertexLocation) override;
+        void DrawIndexedInstanced(_In_ UINT uIndexCountPerInstance, _In_ UINT uInstanceCount, _In_ UINT uStartIndexLocation, _In_ INT nBaseVertexLocation, _In_ UINT uStartInstanceLocation) override;
+
+    private:
+        void shadeVertices(_In_ UINT uMinIndex, _In_ UINT uNumVertices, _In_ UINT uInstanceCount, _In_ INT nBaseVertexLocation, _In_ UINT uStartInstanceLocation);
+        void setupTriangle(_In_reads_(3) const FLOAT* const* ppVertices, _In_ UINT uNumVaryings);
+        BOOL binTriangle(_In_reads_(3) const FLOAT* const* ppVertices, _In_ UINT uNumVaryings);
+        UINT64 rasterizeTile(_In_ UINT uTile);
+        void flush();
+
+    private:
+        std::unique_ptr<ThreadPool> m_threadPool;
+        SoftwareRenderStatistics m_statistics;
+
+        NullResourceData m_renderTarget;
+        NullResourceData m_depthStencil;
+        ComPtr<ID3D11RenderTargetView> m_renderTargetView;
+        ComPtr<ID3D11RenderTargetView> m_frameRenderTargetView;
+        D3D11_VIEWPORT m_viewport;
+        UINT m_uTargetWidth;
+        UINT m_uTargetHeight;
+
+        NullResourceData m_aVertexBuffers[SOFTWARE_MAX_VERTEX_BUFFERS];
+        UINT m_auVertexStrides[SOFTWARE_MAX_VERTEX_BUFFERS];
+        UINT m_auVertexOffsets[SOFTWARE_MAX_VERTEX_BUFFERS];
+        NullResourceData m_indexBuffer;
+        DXGI_FORMAT m_indexFormat;
+        UINT m_uIndexOffset;
+        D3D11_PRIMITIVE_TOPOLOGY m_topology;
+
+        const SoftwareVertexShader* m_pVertexShader;
+        const SoftwarePixelShader* m_pPixelShader;
+        NullResourceData m_aVSConstantBuffers[SOFTWARE_MAX_CONSTANT_BUFFERS];
+        NullResourceData m_aPSConstantBuffers[SOFTWARE_MAX_CONSTANT_BUFFERS];
+        SoftwareTexture m_aTextures[SOFTWARE_MAX_SHADER_RESOURCES];
+        SoftwareSampler m_aSamplers[SOFTWARE_MAX_SHADER_RESOURCES];
+
+        std::vector<UINT> m_indices;
+        std::vector<FLOAT> m_shadedVertices;
+        std::vector<SoftwareDraw> m_draws;
+        std::vector<BYTE> m_constants;
+        std::vector<SoftwareTriangle> m_triangles;
+        std::vector<FLOAT> m_attributes;
+        std::vector<std::vector<UINT>> m_aTileBins;
+        std::vector<UINT> m_occupiedTiles;
+        UINT m_uNumTilesX;
+        UINT m_uNumTilesY;
+    };
+}
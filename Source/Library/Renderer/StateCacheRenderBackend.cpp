@@ -0,0 +1,845 @@
+#include "Renderer/StateCacheRenderBackend.h"
+
+namespace library
+{
+    namespace
+    {
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: updateSlots
+
+          Summary:  Stores the objects bound to a range of slots in the
+                    cache. Slots past the end of the cache are not
+                    tracked and always count as a change
+
+          Args:     T** apCache
+                      Cached object of every slot
+                    BOOL* abValid
+                      Whether the cached object of a slot is known
+                    UINT uCapacity
+                      Number of cached slots
+                    UINT uStartSlot
+                    UINT uNumObjects
+                    T* const* ppObjects
+                      Arguments of the bind call
+
+          Returns:  BOOL
+                      TRUE if any slot changes
+        -----------------------------------------------------------------F-F*/
+        template <class T>
+        BOOL updateSlots(_Inout_updates_(uCapacity) T** apCache, _Inout_updates_(uCapacity) BOOL* abValid, _In_ UINT uCapacity, _In_ UINT uStartSlot, _In_ UINT uNumObjects, _In_reads_opt_(uNumObjects) T* const* ppObjects)
+        {
+            BOOL bChanged = uStartSlot + uNumObjects > uCapacity;
+
+            for (UINT i = 0u; i < uNumObjects && uStartSlot + i < uCapacity; ++i)
+            {
+                T* pObject = ppObjects ? ppObjects[i] : nullptr;
+                if (!abValid[uStartSlot + i] || apCache[uStartSlot + i] != pObject)
+                {
+                    apCache[uStartSlot + i] = pObject;
+                    abValid[uStartSlot + i] = TRUE;
+                    bChanged = TRUE;
+                }
+            }
+
+            return bChanged;
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: updateConstantBufferSlots
+
+          Summary:  Stores the constant buffers and ranges bound to a
+                    range of slots in the cache. Slots past the end of
+                    the cache are not tracked and always count as a
+                    change
+
+          Args:     CachedConstantBuffer* aCache
+                      Cached binding of every slot
+                    BOOL* abValid
+                      Whether the cached binding of a slot is known
+                    UINT uStartSlot
+                    UINT uNumBuffers
+                    ID3D11Buffer* const* ppConstantBuffers
+                    const UINT* puFirstConstants
+                    const UINT* puNumConstants
+                      Arguments of the bind call, null ranges for
+                      buffers bound whole
+
+          Returns:  BOOL
+                      TRUE if any slot changes
+        -----------------------------------------------------------------F-F*/
+        BOOL updateConstantBufferSlots(_Inout_updates_(STATE_CACHE_MAX_CONSTANT_BUFFERS) CachedConstantBuffer* aCache, _Inout_updates_(STATE_CACHE_MAX_CONSTANT_BUFFERS) BOOL* abValid, _In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers, _In_reads_opt_(uNumBuffers) const UINT* puFirstConstants, _In_reads_opt_(uNumBuffers) const UINT* puNumConstants)
+        {
+            BOOL bChanged = uStartSlot + uNumBuffers > STATE_CACHE_MAX_CONSTANT_BUFFERS;
+
+            for (UINT i = 0u; i < uNumBuffers && uStartSlot + i < STATE_CACHE_MAX_CONSTANT_BUFFERS; ++i)
+            {
+                const CachedConstantBuffer constantBuffer =
+                {
+                    .pBuffer = ppConstantBuffers ? ppConstantBuffers[i] : nullptr,
+                    .uFirstConstant = puFirstConstants ? puFirstConstants[i] : 0u,
+                    .uNumConstants = puNumConstants ? puNumConstants[i] : 0u
+                };
+
+                CachedConstantBuffer& cached = aCache[uStartSlot + i];
+                if (!abValid[uStartSlot + i] || cached.pBuffer != constantBuffer.pBuffer || cached.uFirstConstant != constantBuffer.uFirstConstant || cached.uNumConstants != constantBuffer.uNumConstants)
+                {
+                    cached = constantBuffer;
+                    abValid[uStartSlot + i] = TRUE;
+                    bChanged = TRUE;
+                }
+            }
+
+            return bChanged;
+        }
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateCacheRenderBackend::StateCacheRenderBackend
+
+      Summary:  Constructor
+
+      Args:     std::shared_ptr<RenderBackend> next
+                  Backend the calls that change state are forwarded to
+
+      Modifies: [m_next, m_frameStatistics, every cached binding].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    StateCacheRenderBackend::StateCacheRenderBackend(_In_ std::shared_ptr<RenderBackend> next)
+        : m_next(std::move(next))
+        , m_frameStatistics()
+        , m_apRenderTargetViews()
+        , m_pDepthStencilView(nullptr)
+        , m_uNumRenderTargetViews(0u)
+        , m_bRenderTargetsValid(FALSE)
+        , m_viewport()
+        , m_bViewportValid(FALSE)
+        , m_aVertexBuffers()
+        , m_abVertexBuffersValid()
+        , m_pIndexBuffer(nullptr)
+        , m_indexFormat(DXGI_FORMAT_UNKNOWN)
+        , m_uIndexOffset(0u)
+        , m_bIndexBufferValid(FALSE)
+        , m_pInputLayout(nullptr)
+        , m_bInputLayoutValid(FALSE)
+        , m_topology()
+        , m_bTopologyValid(FALSE)
+        , m_pVertexShader(nullptr)
+        , m_bVertexShaderValid(FALSE)
+        , m_pPixelShader(nullptr)
+        , m_bPixelShaderValid(FALSE)
+        , m_aVSConstantBuffers()
+        , m_abVSConstantBuffersValid()
+        , m_aPSConstantBuffers()
+        , m_abPSConstantBuffersValid()
+        , m_apShaderResourceViews()
+        , m_abShaderResourceViewsValid()
+        , m_apSamplers()
+        , m_abSamplersValid()
+    {
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateCacheRenderBackend::GetFrameStatistics
+
+      Summary:  Returns the state calls of the current or last frame
+
+      Returns:  const StateCacheStatistics&
+                  Issued and filtered calls
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const StateCacheStatistics& StateCacheRenderBackend::GetFrameStatistics() const
+    {
+        return m_frameStatistics;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateCacheRenderBackend::GetNext
+
+      Summary:  Returns the backend the commands are forwarded to
+
+      Returns:  const std::shared_ptr<RenderBackend>&
+                  The next backend
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const std::shared_ptr<RenderBackend>& StateCacheRenderBackend::GetNext() const
+    {
+        return m_next;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateCacheRenderBackend::Invalidate
+
+      Summary:  Forgets the cached state, so the next bind of every slot
+                is forwarded
+
+      Modifies: [every cached binding].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void StateCacheRenderBackend::Invalidate()
+    {
+        m_bRenderTargetsValid = FALSE;
+        m_bViewportValid = FALSE;
+        std::fill(std::begin(m_abVertexBuffersValid), std::end(m_abVertexBuffersValid), FALSE);
+        m_bIndexBufferValid = FALSE;
+        m_bInputLayoutValid = FALSE;
+        m_bTopologyValid = FALSE;
+        m_bVertexShaderValid = FALSE;
+        m_bPixelShaderValid = FALSE;
+        std::fill(std::begin(m_abVSConstantBuffersValid), std::end(m_abVSConstantBuffersValid), FALSE);
+        std::fill(std::begin(m_abPSConstantBuffersValid), std::end(m_abPSConstantBuffersValid), FALSE);
+        std::fill(std::begin(m_abShaderResourceViewsValid), std::end(m_abShaderResourceViewsValid), FALSE);
+        std::fill(std::begin(m_abSamplersValid), std::end(m_abSamplersValid), FALSE);
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateCacheRenderBackend::ReportStatistics
+
+      Summary:  Writes the issued and filtered state calls of the frame
+                to the debug output
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void StateCacheRenderBackend::ReportStatistics() const
+    {
+        const UINT64 uNumCalls = m_frameStatistics.uNumIssuedCalls + m_frameStatistics.uNumFilteredCalls;
+
+        WCHAR szMessage[256];
+        swprintf_s(
+            szMessage,
+            L"state cache  calls %llu  issued %llu  filtered %llu (%.1f%%)\n",
+            static_cast<unsigned long long>(uNumCalls),
+            static_cast<unsigned long long>(m_frameStatistics.uNumIssuedCalls),
+            static_cast<unsigned long long>(m_frameStatistics.uNumFilteredCalls),
+            uNumCalls > 0u ? 100.0 * static_cast<double>(m_frameStatistics.uNumFilteredCalls) / static_cast<double>(uNumCalls) : 0.0
+        );
+        OutputDebugString(szMessage);
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateCacheRenderBackend::BeginFrame
+
+      Summary:  Forgets the cached state, since objects may have been
+                released and their addresses reused since the last frame,
+                and starts counting the calls of the new frame
+
+      Modifies: [m_frameStatistics, every cached binding].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void StateCacheRenderBackend::BeginFrame()
+    {
+        // Objects may have been released since the last frame
+        Invalidate();
+        m_frameStatistics = {};
+
+        m_next->BeginFrame();
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateCacheRenderBackend::EndFrame
+
+      Summary:  Forwards the end of the frame
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void StateCacheRenderBackend::EndFrame()
+    {
+        m_next->EndFrame();
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateCacheRenderBackend::BeginPass
+
+      Summary:  Forwards the start of a pass
+
+      Args:     PCWSTR pszPassName
+                  Name of the pass
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void StateCacheRenderBackend::BeginPass(_In_ PCWSTR pszPassName)
+    {
+        m_next->BeginPass(pszPassName);
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateCacheRenderBackend::EndPass
+
+      Summary:  Forwards the end of a pass
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void StateCacheRenderBackend::EndPass()
+    {
+        m_next->EndPass();
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateCacheRenderBackend::SetRenderTargets
+
+      Summary:  Forwards the render targets unless they are the bound
+                ones. Binding new targets also forgets the cached shader
+                resources, as Direct3D unbinds those that alias a target.
+                More targets than the cache holds are always forwarded
+
+      Args:     UINT uNumViews
+                  Number of render target views
+                ID3D11RenderTargetView* const* ppRenderTargetViews
+                  Render target views
+                ID3D11DepthStencilView* pDepthStencilView
+                  Depth stencil view
+
+      Modifies: [m_apRenderTargetViews, m_uNumRenderTargetViews,
+                 m_pDepthStencilView, m_bRenderTargetsValid,
+                 m_abShaderResourceViewsValid,
+                 m_frameStatistics].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void StateCacheRenderBackend::SetRenderTargets(_In_ UINT uNumViews, _In_reads_opt_(uNumViews) ID3D11RenderTargetView* const* ppRenderTargetViews, _In_opt_ ID3D11DepthStencilView* pDepthStencilView)
+    {
+        BOOL bChanged = !m_bRenderTargetsValid || uNumViews != m_uNumRenderTargetViews || pDepthStencilView != m_pDepthStencilView || uNumViews > STATE_CACHE_MAX_RENDER_TARGETS;
+        for (UINT i = 0u; i < uNumViews && i < STATE_CACHE_MAX_RENDER_TARGETS; ++i)
+        {
+            ID3D11RenderTargetView* pView = ppRenderTargetViews ? ppRenderTargetViews[i] : nullptr;
+            bChanged |= m_apRenderTargetViews[i] != pView;
+            m_apRenderTargetViews[i] = pView;
+        }
+        m_uNumRenderTargetViews = uNumViews;
+        m_pDepthStencilView = pDepthStencilView;
+        m_bRenderTargetsValid = uNumViews <= STATE_CACHE_MAX_RENDER_TARGETS;
+
+        if (filter(bChanged))
+        {
+            // Direct3D unbinds shader resources that alias the new targets
+            std::fill(std::begin(m_abShaderResourceViewsValid), std::end(m_abShaderResourceViewsValid), FALSE);
+
+            m_next->SetRenderTargets(uNumViews, ppRenderTargetViews, pDepthStencilView);
+        }
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateCacheRenderBackend::SetViewports
+
+      Summary:  Forwards the viewports unless they are the bound one.
+                Only a single viewport is cached, more are always
+                forwarded
+
+      Args:     UINT uNumViewports
+                  Number of viewports
+                const D3D11_VIEWPORT* pViewports
+                  Viewports
+
+      Modifies: [m_viewport, m_bViewportValid,
+                 m_frameStatistics].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void StateCacheRenderBackend::SetViewports(_In_ UINT uNumViewports, _In_reads_(uNumViewports) const D3D11_VIEWPORT* pViewports)
+    {
+        BOOL bChanged = uNumViewports != 1u || !m_bViewportValid || memcmp(&m_viewport, pViewports, sizeof(m_viewport)) != 0;
+        m_bViewportValid = uNumViewports == 1u;
+        if (m_bViewportValid)
+        {
+            m_viewport = pViewports[0];
+        }
+
+        if (filter(bChanged))
+        {
+            m_next->SetViewports(uNumViewports, pViewports);
+        }
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateCacheRenderBackend::ClearRenderTargetView
+
+      Summary:  Forwards the clear, which changes no bound state
+
+      Args:     ID3D11RenderTargetView* pRenderTargetView
+                  Render target to clear
+                const FLOAT aColorRGBA[4]
+                  Clear color
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void StateCacheRenderBackend::ClearRenderTargetView(_In_ ID3D11RenderTargetView* pRenderTargetView, _In_ const FLOAT aColorRGBA[4])
+    {
+        m_next->ClearRenderTargetView(pRenderTargetView, aColorRGBA);
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateCacheRenderBackend::ClearDepthStencilView
+
+      Summary:  Forwards the clear, which changes no bound state
+
+      Args:     ID3D11DepthStencilView* pDepthStencilView
+                  Depth stencil to clear
+                UINT uClearFlags
+                  D3D11_CLEAR_DEPTH, D3D11_CLEAR_STENCIL or both
+                FLOAT depth
+                  Depth to clear to
+                UINT8 stencil
+                  Stencil to clear to
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void StateCacheRenderBackend::ClearDepthStencilView(_In_ ID3D11DepthStencilView* pDepthStencilView, _In_ UINT uClearFlags, _In_ FLOAT depth, _In_ UINT8 stencil)
+    {
+        m_next->ClearDepthStencilView(pDepthStencilView, uClearFlags, depth, stencil);
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateCacheRenderBackend::UpdateBuffer
+
+      Summary:  Forwards the update. The bindings stay valid, since
+                the buffer is the same object
+
+      Args:     ID3D11Buffer* pBuffer
+                  Buffer to update
+                const void* pData
+                  New contents
+                UINT uDataSize
+                  Size of the new contents in bytes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void StateCacheRenderBackend::UpdateBuffer(_In_ ID3D11Buffer* pBuffer, _In_reads_bytes_(uDataSize) const void* pData, _In_ UINT uDataSize)
+    {
+        m_next->UpdateBuffer(pBuffer, pData, uDataSize);
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateCacheRenderBackend::WriteDynamicBuffer
+
+      Summary:  Forwards the write with its map mode unchanged. A
+                discard gives the buffer new memory but keeps the object,
+                so the cached bindings of the buffer stay valid
+
+      Args:     ID3D11Buffer* pBuffer
+                  Dynamic buffer with CPU write access
+                UINT uOffset
+                  Byte offset to write to
+                const void* pData
+                  Bytes to write
+                UINT uDataSize
+                  Number of bytes to write
+                BOOL bDiscard
+                  Whether to discard the previous contents
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void StateCacheRenderBackend::WriteDynamicBuffer(_In_ ID3D11Buffer* pBuffer, _In_ UINT uOffset, _In_reads_bytes_(uDataSize) const void* pData, _In_ UINT uDataSize, _In_ BOOL bDiscard)
+    {
+        m_next->WriteDynamicBuffer(pBuffer, uOffset, pData, uDataSize, bDiscard);
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateCacheRenderBackend::SupportsConstantBufferOffsets
+
+      Summary:  Returns whether the next backend binds constant buffer
+                ranges
+
+      Returns:  BOOL
+                  What the next backend returns
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL StateCacheRenderBackend::SupportsConstantBufferOffsets() const
+    {
+        return m_next->SupportsConstantBufferOffsets();
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateCacheRenderBackend::SetVertexBuffers
+
+      Summary:  Forwards the vertex buffers unless every slot already
+                holds the same buffer, stride and offset. Slots beyond
+                the cache are always forwarded
+
+      Args:     UINT uStartSlot
+                  First slot to bind
+                UINT uNumBuffers
+                  Number of buffers
+                ID3D11Buffer* const* ppVertexBuffers
+                  Vertex buffers
+                const UINT* puStrides
+                  Stride of each buffer
+                const UINT* puOffsets
+                  Byte offset into each buffer
+
+      Modifies: [m_aVertexBuffers, m_abVertexBuffersValid,
+                 m_frameStatistics].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void StateCacheRenderBackend::SetVertexBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppVertexBuffers, _In_reads_opt_(uNumBuffers) const UINT* puStrides, _In_reads_opt_(uNumBuffers) const UINT* puOffsets)
+    {
+        BOOL bChanged = uStartSlot + uNumBuffers > STATE_CACHE_MAX_VERTEX_BUFFERS;
+        for (UINT i = 0u; i < uNumBuffers && uStartSlot + i < STATE_CACHE_MAX_VERTEX_BUFFERS; ++i)
+        {
+            CachedVertexBuffer vertexBuffer =
+            {
+                .pBuffer = ppVertexBuffers ? ppVertexBuffers[i] : nullptr,
+                .uStride = puStrides ? puStrides[i] : 0u,
+                .uOffset = puOffsets ? puOffsets[i] : 0u
+            };
+
+            CachedVertexBuffer& cached = m_aVertexBuffers[uStartSlot + i];
+            if (!m_abVertexBuffersValid[uStartSlot + i] || cached.pBuffer != vertexBuffer.pBuffer || cached.uStride != vertexBuffer.uStride || cached.uOffset != vertexBuffer.uOffset)
+            {
+                cached = vertexBuffer;
+                m_abVertexBuffersValid[uStartSlot + i] = TRUE;
+                bChanged = TRUE;
+            }
+        }
+
+        if (filter(bChanged))
+        {
+            m_next->SetVertexBuffers(uStartSlot, uNumBuffers, ppVertexBuffers, puStrides, puOffsets);
+        }
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateCacheRenderBackend::SetIndexBuffer
+
+      Summary:  Forwards the index buffer unless it is bound with the
+                same format and offset
+
+      Args:     ID3D11Buffer* pIndexBuffer
+                  Index buffer
+                DXGI_FORMAT format
+                  Format of the indices
+                UINT uOffset
+                  Byte offset of the first index
+
+      Modifies: [m_pIndexBuffer, m_indexFormat, m_uIndexOffset,
+                 m_bIndexBufferValid,
+                 m_frameStatistics].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void StateCacheRenderBackend::SetIndexBuffer(_In_opt_ ID3D11Buffer* pIndexBuffer, _In_ DXGI_FORMAT format, _In_ UINT uOffset)
+    {
+        BOOL bChanged = !m_bIndexBufferValid || m_pIndexBuffer != pIndexBuffer || m_indexFormat != format || m_uIndexOffset != uOffset;
+        m_pIndexBuffer = pIndexBuffer;
+        m_indexFormat = format;
+        m_uIndexOffset = uOffset;
+        m_bIndexBufferValid = TRUE;
+
+        if (filter(bChanged))
+        {
+            m_next->SetIndexBuffer(pIndexBuffer, format, uOffset);
+        }
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateCacheRenderBackend::SetInputLayout
+
+      Summary:  Forwards the input layout unless it is the bound one
+
+      Args:     ID3D11InputLayout* pInputLayout
+                  Input layout
+
+      Modifies: [m_pInputLayout, m_bInputLayoutValid,
+                 m_frameStatistics].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void StateCacheRenderBackend::SetInputLayout(_In_opt_ ID3D11InputLayout* pInputLayout)
+    {
+        BOOL bChanged = !m_bInputLayoutValid || m_pInputLayout != pInputLayout;
+        m_pInputLayout = pInputLayout;
+        m_bInputLayoutValid = TRUE;
+
+        if (filter(bChanged))
+        {
+            m_next->SetInputLayout(pInputLayout);
+        }
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateCacheRenderBackend::SetPrimitiveTopology
+
+      Summary:  Forwards the topology unless it is the current one
+
+      Args:     D3D11_PRIMITIVE_TOPOLOGY topology
+                  Primitive topology
+
+      Modifies: [m_topology, m_bTopologyValid,
+                 m_frameStatistics].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void StateCacheRenderBackend::SetPrimitiveTopology(_In_ D3D11_PRIMITIVE_TOPOLOGY topology)
+    {
+        BOOL bChanged = !m_bTopologyValid || m_topology != topology;
+        m_topology = topology;
+        m_bTopologyValid = TRUE;
+
+        if (filter(bChanged))
+        {
+            m_next->SetPrimitiveTopology(topology);
+        }
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateCacheRenderBackend::SetVertexShader
+
+      Summary:  Forwards the vertex shader unless it is the bound one
+
+      Args:     ID3D11VertexShader* pVertexShader
+                  Vertex shader
+
+      Modifies: [m_pVertexShader, m_bVertexShaderValid,
+                 m_frameStatistics].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void StateCacheRenderBackend::SetVertexShader(_In_opt_ ID3D11VertexShader* pVertexShader)
+    {
+        BOOL bChanged = !m_bVertexShaderValid || m_pVertexShader != pVertexShader;
+        m_pVertexShader = pVertexShader;
+        m_bVertexShaderValid = TRUE;
+
+        if (filter(bChanged))
+        {
+            m_next->SetVertexShader(pVertexShader);
+        }
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateCacheRenderBackend::SetVSConstantBuffers
+
+      Summary:  Forwards whole constant buffers of the vertex shader
+                unless every slot already holds the whole buffer
+
+      Args:     UINT uStartSlot
+                  First slot to bind
+                UINT uNumBuffers
+                  Number of buffers
+                ID3D11Buffer* const* ppConstantBuffers
+                  Constant buffers
+
+      Modifies: [m_aVSConstantBuffers, m_abVSConstantBuffersValid,
+                 m_frameStatistics].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void StateCacheRenderBackend::SetVSConstantBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers)
+    {
+        if (filter(updateConstantBufferSlots(m_aVSConstantBuffers, m_abVSConstantBuffersValid, uStartSlot, uNumBuffers, ppConstantBuffers, nullptr, nullptr)))
+        {
+            m_next->SetVSConstantBuffers(uStartSlot, uNumBuffers, ppConstantBuffers);
+        }
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateCacheRenderBackend::SetVSConstantBufferRanges
+
+      Summary:  Forwards constant buffer ranges of the vertex shader
+                unless every slot already holds the same buffer and
+                range. A whole buffer and a range of it are different
+                bindings, so switching between them is forwarded
+
+      Args:     UINT uStartSlot
+                  First slot to bind
+                UINT uNumBuffers
+                  Number of buffers
+                ID3D11Buffer* const* ppConstantBuffers
+                  Constant buffers
+                const UINT* puFirstConstants
+                  First 16 byte constant of each range
+                const UINT* puNumConstants
+                  Number of 16 byte constants of each range
+
+      Modifies: [m_aVSConstantBuffers, m_abVSConstantBuffersValid,
+                 m_frameStatistics].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void StateCacheRenderBackend::SetVSConstantBufferRanges(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers, _In_reads_(uNumBuffers) const UINT* puFirstConstants, _In_reads_(uNumBuffers) const UINT* puNumConstants)
+    {
+        if (filter(updateConstantBufferSlots(m_aVSConstantBuffers, m_abVSConstantBuffersValid, uStartSlot, uNumBuffers, ppConstantBuffers, puFirstConstants, puNumConstants)))
+        {
+            m_next->SetVSConstantBufferRanges(uStartSlot, uNumBuffers, ppConstantBuffers, puFirstConstants, puNumConstants);
+        }
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateCacheRenderBackend::SetPixelShader
+
+      Summary:  Forwards the pixel shader unless it is the bound one
+
+      Args:     ID3D11PixelShader* pPixelShader
+                  Pixel shader
+
+      Modifies: [m_pPixelShader, m_bPixelShaderValid,
+                 m_frameStatistics].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void StateCacheRenderBackend::SetPixelShader(_In_opt_ ID3D11PixelShader* pPixelShader)
+    {
+        BOOL bChanged = !m_bPixelShaderValid || m_pPixelShader != pPixelShader;
+        m_pPixelShader = pPixelShader;
+        m_bPixelShaderValid = TRUE;
+
+        if (filter(bChanged))
+        {
+            m_next->SetPixelShader(pPixelShader);
+        }
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateCacheRenderBackend::SetPSConstantBuffers
+
+      Summary:  Forwards whole constant buffers of the pixel shader
+                unless every slot already holds the whole buffer
+
+      Args:     UINT uStartSlot
+                  First slot to bind
+                UINT uNumBuffers
+                  Number of buffers
+                ID3D11Buffer* const* ppConstantBuffers
+                  Constant buffers
+
+      Modifies: [m_aPSConstantBuffers, m_abPSConstantBuffersValid,
+                 m_frameStatistics].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void StateCacheRenderBackend::SetPSConstantBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers)
+    {
+        if (filter(updateConstantBufferSlots(m_aPSConstantBuffers, m_abPSConstantBuffersValid, uStartSlot, uNumBuffers, ppConstantBuffers, nullptr, nullptr)))
+        {
+            m_next->SetPSConstantBuffers(uStartSlot, uNumBuffers, ppConstantBuffers);
+        }
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateCacheRenderBackend::SetPSConstantBufferRanges
+
+      Summary:  Forwards constant buffer ranges of the pixel shader
+                unless every slot already holds the same buffer and
+                range
+
+      Args:     UINT uStartSlot
+                  First slot to bind
+                UINT uNumBuffers
+                  Number of buffers
+                ID3D11Buffer* const* ppConstantBuffers
+                  Constant buffers
+                const UINT* puFirstConstants
+                  First 16 byte constant of each range
+                const UINT* puNumConstants
+                  Number of 16 byte constants of each range
+
+      Modifies: [m_aPSConstantBuffers, m_abPSConstantBuffersValid,
+                 m_frameStatistics].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void StateCacheRenderBackend::SetPSConstantBufferRanges(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers, _In_reads_(uNumBuffers) const UINT* puFirstConstants, _In_reads_(uNumBuffers) const UINT* puNumConstants)
+    {
+        if (filter(updateConstantBufferSlots(m_aPSConstantBuffers, m_abPSConstantBuffersValid, uStartSlot, uNumBuffers, ppConstantBuffers, puFirstConstants, puNumConstants)))
+        {
+            m_next->SetPSConstantBufferRanges(uStartSlot, uNumBuffers, ppConstantBuffers, puFirstConstants, puNumConstants);
+        }
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateCacheRenderBackend::SetPSShaderResources
+
+      Summary:  Forwards the shader resource views of the pixel shader
+                unless every slot already holds the same view
+
+      Args:     UINT uStartSlot
+                  First slot to bind
+                UINT uNumViews
+                  Number of views
+                ID3D11ShaderResourceView* const* ppShaderResourceViews
+                  Shader resource views
+
+      Modifies: [m_apShaderResourceViews, m_abShaderResourceViewsValid,
+                 m_frameStatistics].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void StateCacheRenderBackend::SetPSShaderResources(_In_ UINT uStartSlot, _In_ UINT uNumViews, _In_reads_opt_(uNumViews) ID3D11ShaderResourceView* const* ppShaderResourceViews)
+    {
+        if (filter(updateSlots(m_apShaderResourceViews, m_abShaderResourceViewsValid, STATE_CACHE_MAX_SHADER_RESOURCES, uStartSlot, uNumViews, ppShaderResourceViews)))
+        {
+            m_next->SetPSShaderResources(uStartSlot, uNumViews, ppShaderResourceViews);
+        }
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateCacheRenderBackend::SetPSSamplers
+
+      Summary:  Forwards the samplers of the pixel shader unless every
+                slot already holds the same sampler
+
+      Args:     UINT uStartSlot
+                  First slot to bind
+                UINT uNumSamplers
+                  Number of samplers
+                ID3D11SamplerState* const* ppSamplers
+                  Sampler states
+
+      Modifies: [m_apSamplers, m_abSamplersValid,
+                 m_frameStatistics].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void StateCacheRenderBackend::SetPSSamplers(_In_ UINT uStartSlot, _In_ UINT uNumSamplers, _In_reads_opt_(uNumSamplers) ID3D11SamplerState* const* ppSamplers)
+    {
+        if (filter(updateSlots(m_apSamplers, m_abSamplersValid, STATE_CACHE_MAX_SAMPLERS, uStartSlot, uNumSamplers, ppSamplers)))
+        {
+            m_next->SetPSSamplers(uStartSlot, uNumSamplers, ppSamplers);
+        }
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateCacheRenderBackend::DrawIndexed
+
+      Summary:  Forwards the draw
+
+      Args:     UINT uIndexCount
+                  Number of indices
+                UINT uStartIndexLocation
+                  First index
+                INT nBaseVertexLocation
+                  Value added to each index
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void StateCacheRenderBackend::DrawIndexed(_In_ UINT uIndexCount, _In_ UINT uStartIndexLocation, _In_ INT nBaseVertexLocation)
+    {
+        m_next->DrawIndexed(uIndexCount, uStartIndexLocation, nBaseVertexLocation);
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateCacheRenderBackend::DrawIndexedInstanced
+
+      Summary:  Forwards the draw
+
+      Args:     UINT uIndexCountPerInstance
+                  Number of indices of each instance
+                UINT uInstanceCount
+                  Number of instances
+                UINT uStartIndexLocation
+                  First index
+                INT nBaseVertexLocation
+                  Value added to each index
+                UINT uStartInstanceLocation
+                  Value added to each instance index
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void StateCacheRenderBackend::DrawIndexedInstanced(_In_ UINT uIndexCountPerInstance, _In_ UINT uInstanceCount, _In_ UINT uStartIndexLocation, _In_ INT nBaseVertexLocation, _In_ UINT uStartInstanceLocation)
+    {
+        m_next->DrawIndexedInstanced(uIndexCountPerInstance, uInstanceCount, uStartIndexLocation, nBaseVertexLocation, uStartInstanceLocation);
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateCacheRenderBackend::filter
+
+      Summary:  Counts a state call as issued or filtered
+
+      Args:     BOOL bChanged
+                  Whether the call changes the cached state
+
+      Modifies: [m_frameStatistics].
+
+      Returns:  BOOL
+                  TRUE if the call must be forwarded
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL StateCacheRenderBackend::filter(_In_ BOOL bChanged)
+    {
+        if (bChanged)
+        {
+            ++m_frameStatistics.uNumIssuedCalls;
+        }
+        else
+        {
+            ++m_frameStatistics.uNumFilteredCalls;
+        }
+
+        return bChanged;
+    }
+}
@@ -0,0 +1,177 @@
+/*+===================================================================
+  File:      STATECACHERENDERBACKEND.H
+
+  Summary:   StateCacheRenderBackend header file contains declarations
+             of the RenderBackend that shadows the pipeline state and
+             drops binds that would not change it.
+
+  Classes: StateCacheStatistics, StateCacheRenderBackend
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Renderer/RenderBackend.h"
+
+namespace library
+{
+    constexpr UINT STATE_CACHE_MAX_RENDER_TARGETS = 8u;
+    constexpr UINT STATE_CACHE_MAX_VERTEX_BUFFERS = 16u;
+    constexpr UINT STATE_CACHE_MAX_CONSTANT_BUFFERS = 14u;
+    constexpr UINT STATE_CACHE_MAX_SHADER_RESOURCES = 16u;
+    constexpr UINT STATE_CACHE_MAX_SAMPLERS = 16u;
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   StateCacheStatistics
+
+      Summary:  State calls of the last frame that were forwarded to the
+                next backend and that were dropped as redundant. Draws,
+                clears and uploads are always forwarded and not counted
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct StateCacheStatistics
+    {
+        UINT64 uNumIssuedCalls;
+        UINT64 uNumFilteredCalls;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   CachedVertexBuffer
+
+      Summary:  Vertex buffer bound to one input assembler slot
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct CachedVertexBuffer
+    {
+        ID3D11Buffer* pBuffer;
+        UINT uStride;
+        UINT uOffset;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   CachedConstantBuffer
+
+      Summary:  Constant buffer bound to one shader slot. A buffer bound
+                whole has zero constants
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct CachedConstantBuffer
+    {
+        ID3D11Buffer* pBuffer;
+        UINT uFirstConstant;
+        UINT uNumConstants;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    StateCacheRenderBackend
+
+      Summary:  RenderBackend that remembers what is bound to every
+                input assembler, shader and output merger slot and only
+                forwards the state calls that change it. A call binding
+                several slots is forwarded whole if any of them changes.
+                Objects are compared by address and not referenced, so
+                the cache is forgotten at the start of every frame and
+                must be invalidated if the context is changed behind
+                its back. Setting render targets forgets the bound
+                shader resources, since Direct3D unbinds the inputs that
+                alias the new outputs
+
+      Methods:  GetFrameStatistics
+                  Returns the issued and filtered calls of the frame
+                GetNext
+                  Returns the backend the commands are forwarded to
+                Invalidate
+                  Forgets the cached state
+                ReportStatistics
+                  Writes the statistics of the frame to the debug
+                  output
+                StateCacheRenderBackend
+                  Constructor.
+                ~StateCacheRenderBackend
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class StateCacheRenderBackend final : public RenderBackend
+    {
+    public:
+        StateCacheRenderBackend() = delete;
+        explicit StateCacheRenderBackend(_In_ std::shared_ptr<RenderBackend> next);
+        StateCacheRenderBackend(const StateCacheRenderBackend& other) = delete;
+        StateCacheRenderBackend(StateCacheRenderBackend&& other) = delete;
+        StateCacheRenderBackend& operator=(const StateCacheRenderBackend& other) = delete;
+        StateCacheRenderBackend& operator=(StateCacheRenderBackend&& other) = delete;
+        ~StateCacheRenderBackend() override = default;
+
+        const StateCacheStatistics& GetFrameStatistics() const;
+        const std::shared_ptr<RenderBackend>& GetNext() const;
+        void Invalidate();
+        void ReportStatistics() const;
+
+        void BeginFrame() override;
+        void EndFrame() override;
+        void BeginPass(_In_ PCWSTR pszPassName) override;
+        void EndPass() override;
+
+        void SetRenderTargets(_In_ UINT uNumViews, _In_reads_opt_(uNumViews) ID3D11RenderTargetView* const* ppRenderTargetViews, _In_opt_ ID3D11DepthStencilView* pDepthStencilView) override;
+        void SetViewports(_In_ UINT uNumViewports, _In_reads_(uNumViewports) const D3D11_VIEWPORT* pViewports) override;
+        void ClearRenderTargetView(_In_ ID3D11RenderTargetView* pRenderTargetView, _In_ const FLOAT aColorRGBA[4]) override;
+        void ClearDepthStencilView(_In_ ID3D11DepthStencilView* pDepthStencilView, _In_ UINT uClearFlags, _In_ FLOAT depth, _In_ UINT8 stencil) override;
+
+        void UpdateBuffer(_In_ ID3D11Buffer* pBuffer, _In_reads_bytes_(uDataSize) const void* pData, _In_ UINT uDataSize) override;
+        void WriteDynamicBuffer(_In_ ID3D11Buffer* pBuffer, _In_ UINT uOffset, _In_reads_bytes_(uDataSize) const void* pData, _In_ UINT uDataSize, _In_ BOOL bDiscard) override;
+        BOOL SupportsConstantBufferOffsets() const override;
+
+        void SetVertexBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppVertexBuffers, _In_reads_opt_(uNumBuffers) const UINT* puStrides, _In_reads_opt_(uNumBuffers) const UINT* puOffsets) override;
+        void SetIndexBuffer(_In_opt_ ID3D11Buffer* pIndexBuffer, _In_ DXGI_FORMAT format, _In_ UINT uOffset) override;
+        void SetInputLayout(_In_opt_ ID3D11InputLayout* pInputLayout) override;
+        void SetPrimitiveTopology(_In_ D3D11_PRIMITIVE_TOPOLOGY topology) override;
+
+        void SetVertexShader(_In_opt_ ID3D11VertexShader* pVertexShader) override;
+        void SetVSConstantBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers) override;
+        void SetVSConstantBufferRanges(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers, _In_reads_(uNumBuffers) const UINT* puFirstConstants, _In_reads_(uNumBuffers) const UINT* puNumConstants) override;
+        void SetPixelShader(_In_opt_ ID3D11PixelShader* pPixelShader) override;
+        void SetPSConstantBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers) override;
+        void SetPSConstantBufferRanges(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_opt_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers, _In_reads_(uNumBuffers) const UINT* puFirstConstants, _In_reads_(uNumBuffers) const UINT* puNumConstants) override;
+        void SetPSShaderResources(_In_ UINT uStartSlot, _In_ UINT uNumViews, _In_reads_opt_(uNumViews) ID3D11ShaderResourceView* const* ppShaderResourceViews) override;
+        void SetPSSamplers(_In_ UINT uStartSlot, _In_ UINT uNumSamplers, _In_reads_opt_(uNumSamplers) ID3D11SamplerState* const* ppSamplers) override;
+
+        void DrawIndexed(_In_ UINT uIndexCount, _In_ UINT uStartIndexLocation, _In_ INT nBaseVertexLocation) override;
+        void DrawIndexedInstanced(_In_ UINT uIndexCountPerInstance, _In_ UINT uInstanceCount, _In_ UINT uStartIndexLocation, _In_ INT nBaseVertexLocation, _In_ UINT uStartInstanceLocation) override;
+
+    private:
+        BOOL filter(_In_ BOOL bChanged);
+
+    private:
+        std::shared_ptr<RenderBackend> m_next;
+        StateCacheStatistics m_frameStatistics;
+
+        ID3D11RenderTargetView* m_apRenderTargetViews[STATE_CACHE_MAX_RENDER_TARGETS];
+        ID3D11DepthStencilView* m_pDepthStencilView;
+        UINT m_uNumRenderTargetViews;
+        BOOL m_bRenderTargetsValid;
+        D3D11_VIEWPORT m_viewport;
+        BOOL m_bViewportValid;
+
+        CachedVertexBuffer m_aVertexBuffers[STATE_CACHE_MAX_VERTEX_BUFFERS];
+        BOOL m_abVertexBuffersValid[STATE_CACHE_MAX_VERTEX_BUFFERS];
+        ID3D11Buffer* m_pIndexBuffer;
+        DXGI_FORMAT m_indexFormat;
+        UINT m_uIndexOffset;
+        BOOL m_bIndexBufferValid;
+        ID3D11InputLayout* m_pInputLayout;
+        BOOL m_bInputLayoutValid;
+        D3D11_PRIMITIVE_TOPOLOGY m_topology;
+        BOOL m_bTopologyValid;
+
+        ID3D11VertexShader* m_pVertexShader;
+        BOOL m_bVertexShaderValid;
+        ID3D11PixelShader* m_pPixelShader;
+        BOOL m_bPixelShaderValid;
+        CachedConstantBuffer m_aVSConstantBuffers[STATE_CACHE_MAX_CONSTANT_BUFFERS];
+        BOOL m_abVSConstantBuffersValid[STATE_CACHE_MAX_CONSTANT_BUFFERS];
+        CachedConstantBuffer m_aPSConstantBuffers[STATE_CACHE_MAX_CONSTANT_BUFFERS];
+        BOOL m_abPSConstantBuffersValid[STATE_CACHE_MAX_CONSTANT_BUFFERS];
+        ID3D11ShaderResourceView* m_apShaderResourceViews[STATE_CACHE_MAX_SHADER_RESOURCES];
+        BOOL m_abShaderResourceViewsValid[STATE_CACHE_MAX_SHADER_RESOURCES];
+        ID3D11SamplerState* m_apSamplers[STATE_CACHE_MAX_SAMPLERS];
+        BOOL m_abSamplersValid[STATE_CACHE_MAX_SAMPLERS];
+    };
+}
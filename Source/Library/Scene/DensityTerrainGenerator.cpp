@@ -0,0 +1,215 @@
+#include "Scene/DensityTerrainGenerator.h"
+
+#include "Scene/Noise.h"
+#include "Scene/TerrainGenerator.h"
+
+namespace library
+{
+    namespace
+    {
+        // Frequency and octaves of the 2D noise the surface rolls with
+        constexpr FLOAT SURFACE_FREQUENCY = 0.01f;
+        constexpr UINT SURFACE_OCTAVES = 4u;
+
+        // Fractions of the height of the world the surface stays between
+        constexpr FLOAT SURFACE_BASE = 0.15f;
+        constexpr FLOAT SURFACE_RANGE = 0.6f;
+
+        // Frequency and octaves of the 3D noise that bends the surface,
+        // and the cells of density change one unit of the noise makes,
+        // which is how far overhangs reach out of the surface
+        constexpr FLOAT OVERHANG_FREQUENCY = 0.04f;
+        constexpr UINT OVERHANG_OCTAVES = 3u;
+        constexpr FLOAT OVERHANG_REACH = 24.0f;
+
+        // Frequency and octaves of the 3D noise caves follow, and how
+        // far from its midpoint the noise is still carved out
+        constexpr FLOAT CAVE_FREQUENCY = 0.05f;
+        constexpr UINT CAVE_OCTAVES = 2u;
+        constexpr FLOAT CAVE_RADIUS = 0.02f;
+
+        // Solid cells below the surface cell of a column, where the
+        // biome gives way to bare rock
+        constexpr UINT TOPSOIL_DEPTH = 3u;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DensityTerrainGenerator::DensityTerrainGenerator
+
+      Summary:  Constructor
+
+      Args:     UINT uNumThreads
+                  Number of threads, 0 for one per hardware thread
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    DensityTerrainGenerator::DensityTerrainGenerator(_In_ UINT uNumThreads)
+        : m_threadPool(std::make_unique<ThreadPool>(uNumThreads))
+        , m_storeMutex()
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DensityTerrainGenerator::Generate
+
+      Summary:  Replaces every column of a store, one chunk column of
+                DENSITY_COLUMNS_PER_TASK x DENSITY_COLUMNS_PER_TASK
+                columns per task in parallel
+
+      Args:     VoxelColumnStore& store
+                  Store to fill, its size is the size of the world
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void DensityTerrainGenerator::Generate(_Inout_ VoxelColumnStore& store)
+    {
+        const UINT uTasksX = (store.GetWidth() + DENSITY_COLUMNS_PER_TASK - 1u) / DENSITY_COLUMNS_PER_TASK;
+        const UINT uTasksZ = (store.GetDepth() + DENSITY_COLUMNS_PER_TASK - 1u) / DENSITY_COLUMNS_PER_TASK;
+        m_threadPool->ParallelFor(uTasksX * uTasksZ, [this, &store, uTasksX](UINT uTask)
+        {
+            generateColumns(store, (uTask % uTasksX) * DENSITY_COLUMNS_PER_TASK, (uTask / uTasksX) * DENSITY_COLUMNS_PER_TASK);
+        });
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DensityTerrainGenerator::SetNumThreads
+
+      Summary:  Replaces the thread pool
+
+      Args:     UINT uNumThreads
+                  Number of threads, 0 for one per hardware thread
+
+      Modifies: [m_threadPool].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void DensityTerrainGenerator::SetNumThreads(_In_ UINT uNumThreads)
+    {
+        m_threadPool.reset();
+        m_threadPool = std::make_unique<ThreadPool>(uNumThreads);
+    }
+
+    UINT DensityTerrainGenerator::GetNumThreads() const
+    {
+        return m_threadPool->GetNumThreads();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DensityTerrainGenerator::generateColumns
+
+      Summary:  Samples the surface of a chunk column in one batch and
+                the overhang and cave noise of all its cells in another
+                two, laid out y fastest so a column is contiguous. The
+                columns are then walked top down, the solid cells just
+                under air taking the biome of the surface of the column
+                and the cells deeper down bare rock, and written into
+                the store as runs under the lock, as a column that
+                outgrows its slot moves the runs of the store
+
+      Args:     VoxelColumnStore& store
+                  Store to write the columns into
+                UINT uFirstX
+                UINT uFirstZ
+                  First column of the chunk column
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void DensityTerrainGenerator::generateColumns(_Inout_ VoxelColumnStore& store, _In_ UINT uFirstX, _In_ UINT uFirstZ)
+    {
+        const UINT uWidth = std::min(DENSITY_COLUMNS_PER_TASK, store.GetWidth() - uFirstX);
+        const UINT uDepth = std::min(DENSITY_COLUMNS_PER_TASK, store.GetDepth() - uFirstZ);
+        const UINT uHeight = store.GetHeight();
+        const UINT uNumColumns = uWidth * uDepth;
+        const UINT uNumCells = uNumColumns * uHeight;
+        const eNoiseLanes lanes = GetMaxNoiseLanes();
+
+        std::vector<FLOAT> aX(uNumCells);
+        std::vector<FLOAT> aY(uNumCells);
+        std::vector<FLOAT> aZ(uNumCells);
+        std::vector<FLOAT> aSurfaces(uNumColumns);
+        std::vector<FLOAT> aOverhangs(uNumCells);
+        std::vector<FLOAT> aCaves(uNumCells);
+
+        for (UINT k = 0u; k < uDepth; ++k)
+        {
+            for (UINT i = 0u; i < uWidth; ++i)
+            {
+                const UINT uColumn = k * uWidth + i;
+                aX[uColumn] = static_cast<FLOAT>(uFirstX + i);
+                aZ[uColumn] = static_cast<FLOAT>(uFirstZ + k);
+            }
+        }
+        SamplePerlin2dBatch(aX.data(), aZ.data(), uNumColumns, SURFACE_FREQUENCY, SURFACE_OCTAVES, aSurfaces.data(), lanes);
+
+        for (UINT k = 0u; k < uDepth; ++k)
+        {
+            for (UINT i = 0u; i < uWidth; ++i)
+            {
+                FLOAT* pX = aX.data() + (k * uWidth + i) * uHeight;
+                FLOAT* pY = aY.data() + (k * uWidth + i) * uHeight;
+                FLOAT* pZ = aZ.data() + (k * uWidth + i) * uHeight;
+                for (UINT y = 0u; y < uHeight; ++y)
+                {
+                    pX[y] = static_cast<FLOAT>(uFirstX + i);
+                    pY[y] = static_cast<FLOAT>(y);
+                    pZ[y] = static_cast<FLOAT>(uFirstZ + k);
+                }
+            }
+        }
+        SamplePerlin3dBatch(aX.data(), aY.data(), aZ.data(), uNumCells, OVERHANG_FREQUENCY, OVERHANG_OCTAVES, aOverhangs.data(), lanes);
+        SamplePerlin3dBatch(aX.data(), aY.data(), aZ.data(), uNumCells, CAVE_FREQUENCY, CAVE_OCTAVES, aCaves.data(), lanes);
+
+        std::vector<BYTE> aBlocks(uHeight);
+        std::vector<VoxelRun> aRuns;
+        std::vector<VoxelRun> aColumnRuns;
+        std::vector<UINT> auNumRuns(uNumColumns);
+        for (UINT uColumn = 0u; uColumn < uNumColumns; ++uColumn)
+        {
+            const FLOAT surface = SURFACE_BASE + SURFACE_RANGE * aSurfaces[uColumn];
+            const FLOAT surfaceY = surface * static_cast<FLOAT>(uHeight);
+            const FLOAT* pOverhangs = aOverhangs.data() + uColumn * uHeight;
+            const FLOAT* pCaves = aCaves.data() + uColumn * uHeight;
+
+            const eBlockType surfaceBlock = TerrainGenerator::ClassifyBiome(surface, aSurfaces[uColumn]);
+            UINT uDepthBelowAir = 0u;
+            for (UINT y = uHeight; y-- > 0u;)
+            {
+                const FLOAT density = (surfaceY - static_cast<FLOAT>(y)) / OVERHANG_REACH + (pOverhangs[y] - 0.5f) * 2.0f;
+                const BOOL bCave = y > 0u && std::abs(pCaves[y] - 0.5f) < CAVE_RADIUS;
+                if (density <= 0.0f || bCave)
+                {
+                    aBlocks[y] = EMPTY_BLOCK;
+                    uDepthBelowAir = 0u;
+                    continue;
+                }
+
+                aBlocks[y] = static_cast<BYTE>(uDepthBelowAir <= TOPSOIL_DEPTH ? surfaceBlock : eBlockType::BARE);
+                ++uDepthBelowAir;
+            }
+
+            aColumnRuns.clear();
+            for (UINT y = 0u; y < uHeight; ++y)
+            {
+                if (!aColumnRuns.empty() && aColumnRuns.back().Block == aBlocks[y])
+                {
+                    aColumnRuns.back().uEnd = static_cast<WORD>(y + 1u);
+                }
+                else
+                {
+                    aColumnRuns.push_back(VoxelRun{ .uEnd = static_cast<WORD>(y + 1u), .Block = aBlocks[y], .Reserved = 0u });
+                }
+            }
+            if (!aColumnRuns.empty() && aColumnRuns.back().Block == EMPTY_BLOCK)
+            {
+                aColumnRuns.pop_back();
+            }
+
+            auNumRuns[uColumn] = static_cast<UINT>(aColumnRuns.size());
+            aRuns.insert(aRuns.end(), aColumnRuns.begin(), aColumnRuns.end());
+        }
+
+        std::lock_guard<std::mutex> lock(m_storeMutex);
+        const VoxelRun* pRuns = aRuns.data();
+        for (UINT k = 0u; k < uDepth; ++k)
+        {
+            for (UINT i = 0u; i < uWidth; ++i)
+            {
+                const UINT uNumRuns = auNumRuns[k * uWidth + i];
+                store.SetColumn(uFirstX + i, uFirstZ + k, pRuns, uNumRuns);
+                pRuns += uNumRuns;
+            }
+        }
+    }
+}
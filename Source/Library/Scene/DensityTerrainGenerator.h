@@ -0,0 +1,75 @@
+/*+===================================================================
+  File:      DENSITYTERRAINGENERATOR.H
+
+  Summary:   DensityTerrainGenerator header file contains declarations
+             of the generator that fills a voxel store from a 3D
+             density field, which unlike a height map can hold caves
+             and overhangs.
+
+  Classes: DensityTerrainGenerator
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Platform/ThreadPool.h"
+#include "Scene/VoxelChunk.h"
+#include "Scene/VoxelColumnStore.h"
+
+#include <mutex>
+
+namespace library
+{
+    // Columns along x and z generated by one task, the columns of one
+    // chunk column of the streamer
+    constexpr UINT DENSITY_COLUMNS_PER_TASK = VOXEL_CHUNK_SIZE;
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    DensityTerrainGenerator
+
+      Summary:  A cell is solid where its density is positive. The
+                density falls off above a rolling surface sampled from
+                2D noise and is perturbed by 3D noise so the ground
+                leans out into overhangs. Cells where a second 3D noise
+                is near its midpoint are carved out as winding caves,
+                except for the floor of the world. Each task samples
+                the noise of every cell of a chunk column in vector
+                batches, turns its columns into runs and writes them
+                into the store
+
+      Methods:  Generate
+                  Fills a store
+                SetNumThreads
+                  Replaces the thread pool
+                GetNumThreads
+                  Returns the number of threads generating columns
+                DensityTerrainGenerator
+                  Constructor.
+                ~DensityTerrainGenerator
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class DensityTerrainGenerator final
+    {
+    public:
+        DensityTerrainGenerator(_In_ UINT uNumThreads = 0u);
+        DensityTerrainGenerator(const DensityTerrainGenerator& other) = delete;
+        DensityTerrainGenerator(DensityTerrainGenerator&& other) = delete;
+        DensityTerrainGenerator& operator=(const DensityTerrainGenerator& other) = delete;
+        DensityTerrainGenerator& operator=(DensityTerrainGenerator&& other) = delete;
+        ~DensityTerrainGenerator() = default;
+
+        void Generate(_Inout_ VoxelColumnStore& store);
+
+        void SetNumThreads(_In_ UINT uNumThreads);
+        UINT GetNumThreads() const;
+
+    private:
+        void generateColumns(_Inout_ VoxelColumnStore& store, _In_ UINT uFirstX, _In_ UINT uFirstZ);
+
+    private:
+        std::unique_ptr<ThreadPool> m_threadPool;
+        std::mutex m_storeMutex;
+    };
+}
@@ -0,0 +1,483 @@
+#include "Scene/HeightMapFile.h"
+
+#include <charconv>
+#include <fstream>
+
+#include "Platform/MappedFile.h"
+#include "Scene/VoxelColumnStore.h"
+#include "Scene/VoxelGrid.h"
+
+namespace library
+{
+    namespace
+    {
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: isSpace
+
+          Summary:  Returns whether a character is white space in the
+                    classic locale, which is what the stream extraction
+                    the text format was written for skips
+        -----------------------------------------------------------------F-F*/
+        BOOL isSpace(_In_ CHAR c)
+        {
+            return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+        }
+
+        /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+          Class:    TextCursor
+
+          Summary:  Reads tokens out of the text in place with
+                    std::from_chars, recovering from bad tokens the way
+                    the stream extraction did: a failed read skips the
+                    next run of non-space characters, and running out
+                    of text ends the read
+        C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+        class TextCursor final
+        {
+        public:
+            TextCursor(_In_reads_bytes_(uSize) const CHAR* pText, _In_ SIZE_T uSize)
+                : m_pCurrent(pText)
+                , m_pEnd(pText + uSize)
+            {
+            }
+
+            // Skips white space and returns whether any text is left
+            BOOL SkipSpace()
+            {
+                while (m_pCurrent < m_pEnd && isSpace(*m_pCurrent))
+                {
+                    ++m_pCurrent;
+                }
+                return m_pCurrent < m_pEnd;
+            }
+
+            void SkipToken()
+            {
+                SkipSpace();
+                while (m_pCurrent < m_pEnd && !isSpace(*m_pCurrent))
+                {
+                    ++m_pCurrent;
+                }
+            }
+
+            CHAR ReadChar()
+            {
+                return *m_pCurrent++;
+            }
+
+            template <typename T>
+            BOOL ReadNumber(_Out_ T& value)
+            {
+                // from_chars takes no leading plus sign, the stream did
+                const CHAR* pFirst = m_pCurrent;
+                if (*pFirst == '+' && pFirst + 1 < m_pEnd && *(pFirst + 1) != '-')
+                {
+                    ++pFirst;
+                }
+
+                std::from_chars_result result = std::from_chars(pFirst, m_pEnd, value);
+                if (result.ec != std::errc())
+                {
+                    return FALSE;
+                }
+                m_pCurrent = result.ptr;
+                return TRUE;
+            }
+
+        private:
+            const CHAR* m_pCurrent;
+            const CHAR* m_pEnd;
+        };
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: QuantizeColumnHeight
+
+      Summary:  Returns the number of cubes a column of the given
+                height is stacked from
+
+      Args:     UINT uHeight
+                  Height of the map, the cubes of a column of height 1
+                FLOAT height
+                  Height of the column between 0 and 1
+
+      Returns:  WORD
+                  Number of cubes
+    -----------------------------------------------------------------F-F*/
+    WORD QuantizeColumnHeight(_In_ UINT uHeight, _In_ FLOAT height)
+    {
+        return static_cast<WORD>(std::clamp(static_cast<FLOAT>(uHeight) * height, 0.0f, 65535.0f));
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: IsBinaryHeightMap
+
+      Summary:  Returns whether the data starts like a binary height
+                map
+
+      Args:     const BYTE* pData
+                SIZE_T uSize
+                  Contents of the file
+
+      Returns:  BOOL
+                  TRUE if the data starts with HEIGHT_MAP_MAGIC
+    -----------------------------------------------------------------F-F*/
+    BOOL IsBinaryHeightMap(_In_reads_bytes_(uSize) const BYTE* pData, _In_ SIZE_T uSize)
+    {
+        UINT uMagic = 0u;
+        if (uSize < sizeof(uMagic))
+        {
+            return FALSE;
+        }
+        memcpy(&uMagic, pData, sizeof(uMagic));
+        return uMagic == HEIGHT_MAP_MAGIC;
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: MapBinaryHeightMap
+
+      Summary:  Points a view at the arrays of a binary height map
+                without copying them, after checking that the data
+                holds all of them, that every column is empty or of a
+                known block type, as the text form requires, and that
+                the columns fit a voxel store
+
+      Args:     const BYTE* pData
+                SIZE_T uSize
+                  Contents of the file, aligned to four bytes
+                HeightMapView& view
+                  Receives the height map
+
+      Returns:  HRESULT
+                  Status code, E_FAIL if the data is not a binary height
+                  map of this version, is cut short, holds an unknown
+                  block or is too tall
+    -----------------------------------------------------------------F-F*/
+    HRESULT MapBinaryHeightMap(_In_reads_bytes_(uSize) const BYTE* pData, _In_ SIZE_T uSize, _Out_ HeightMapView& view)
+    {
+        view = {};
+
+        if (uSize < sizeof(HeightMapHeader) || !IsBinaryHeightMap(pData, uSize))
+        {
+            return E_FAIL;
+        }
+
+        const HeightMapHeader* pHeader = reinterpret_cast<const HeightMapHeader*>(pData);
+        if (pHeader->uVersion != HEIGHT_MAP_VERSION || pHeader->uMaxColumnHeight > VOXEL_COLUMN_MAX_HEIGHT)
+        {
+            return E_FAIL;
+        }
+
+        // Sizes are summed in 64 bits so a corrupt header cannot wrap
+        // them around
+        UINT64 uNumColumns = static_cast<UINT64>(pHeader->uWidth) * pHeader->uDepth;
+        UINT64 uColorsOffset = sizeof(HeightMapHeader);
+        UINT64 uBlocksOffset = uColorsOffset + static_cast<UINT64>(pHeader->uNumColors) * sizeof(XMFLOAT3);
+        UINT64 uHeightsOffset = (uBlocksOffset + uNumColumns + 1u) & ~1ull;
+        UINT64 uEnd = uHeightsOffset + uNumColumns * sizeof(WORD);
+        if (uEnd > uSize)
+        {
+            return E_FAIL;
+        }
+
+        const BYTE* pColumnBlocks = pData + uBlocksOffset;
+        const BOOL bKnownBlocks = std::all_of(pColumnBlocks, pColumnBlocks + uNumColumns, [](BYTE block)
+            {
+                return block == EMPTY_BLOCK
+                    || (static_cast<BYTE>(eBlockType::GRASSLAND) <= block && block < static_cast<BYTE>(eBlockType::COUNT));
+            }
+        );
+        if (!bKnownBlocks)
+        {
+            return E_FAIL;
+        }
+
+        view = {
+            .uWidth = pHeader->uWidth,
+            .uHeight = pHeader->uHeight,
+            .uDepth = pHeader->uDepth,
+            .uMaxColumnHeight = pHeader->uMaxColumnHeight,
+            .uNumColors = pHeader->uNumColors,
+            .pColors = reinterpret_cast<const XMFLOAT3*>(pData + uColorsOffset),
+            .pColumnBlocks = pColumnBlocks,
+            .pColumnHeights = reinterpret_cast<const WORD*>(pData + uHeightsOffset),
+        };
+
+        return S_OK;
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: ParseTextHeightMap
+
+      Summary:  Parses a text height map: the width, height and depth
+                and the number of colors, the colors as three floats
+                each, then a block type character and a height between
+                0 and 1 for each column. Column heights are quantized
+                to a number of cubes, and columns of an unknown block
+                type are skipped
+
+      Args:     const CHAR* pText
+                SIZE_T uSize
+                  Text to parse, need not be null-terminated
+                HeightMap& heightMap
+                  Receives the height map
+    -----------------------------------------------------------------F-F*/
+    void ParseTextHeightMap(_In_reads_bytes_(uSize) const CHAR* pText, _In_ SIZE_T uSize, _Out_ HeightMap& heightMap)
+    {
+        TextCursor cursor(pText, uSize);
+
+        UINT aDimension[4] = { 0u, };
+        UINT uDimensionIdx = 0u;
+        while (uDimensionIdx < ARRAYSIZE(aDimension) && cursor.SkipSpace())
+        {
+            if (cursor.ReadNumber(aDimension[uDimensionIdx]))
+            {
+                ++uDimensionIdx;
+            }
+            else
+            {
+                cursor.SkipToken();
+            }
+        }
+
+        heightMap = {
+            .uWidth = aDimension[0],
+            .uHeight = aDimension[1],
+            .uDepth = aDimension[2],
+            .uMaxColumnHeight = 0u,
+            .aColors = std::vector<XMFLOAT3>(),
+            .aColumnBlocks = std::vector<BYTE>(static_cast<size_t>(aDimension[0]) * aDimension[2], EMPTY_BLOCK),
+            .aColumnHeights = std::vector<WORD>(static_cast<size_t>(aDimension[0]) * aDimension[2], 0u),
+        };
+
+        heightMap.aColors.reserve(aDimension[3]);
+        XMFLOAT3 color;
+        while (heightMap.aColors.size() < aDimension[3] && cursor.SkipSpace())
+        {
+            if (cursor.ReadNumber(color.x) && cursor.SkipSpace() &&
+                cursor.ReadNumber(color.y) && cursor.SkipSpace() &&
+                cursor.ReadNumber(color.z))
+            {
+                heightMap.aColors.push_back(color);
+            }
+            else
+            {
+                cursor.SkipToken();
+            }
+        }
+
+        if (heightMap.aColumnBlocks.empty())
+        {
+            return;
+        }
+
+        UINT uDepthIdx = 0u;
+        UINT uWidthIdx = 0u;
+        FLOAT height;
+        while (cursor.SkipSpace())
+        {
+            CHAR voxelType = cursor.ReadChar();
+
+            if (!cursor.SkipSpace())
+            {
+                break;
+            }
+
+            if (!cursor.ReadNumber(height))
+            {
+                cursor.SkipToken();
+            }
+            else if (static_cast<CHAR>(eBlockType::GRASSLAND) <= voxelType && voxelType < static_cast<CHAR>(eBlockType::COUNT))
+            {
+                size_t columnIdx = static_cast<size_t>(uDepthIdx) * heightMap.uWidth + uWidthIdx;
+                heightMap.aColumnBlocks[columnIdx] = static_cast<BYTE>(voxelType);
+                heightMap.aColumnHeights[columnIdx] = QuantizeColumnHeight(heightMap.uHeight, height);
+                heightMap.uMaxColumnHeight = std::max(heightMap.uMaxColumnHeight, static_cast<UINT>(heightMap.aColumnHeights[columnIdx]));
+
+                ++uWidthIdx;
+                if (uWidthIdx >= heightMap.uWidth)
+                {
+                    uWidthIdx -= heightMap.uWidth;
+                    ++uDepthIdx;
+
+                    if (uDepthIdx >= heightMap.uDepth)
+                    {
+                        uDepthIdx -= heightMap.uDepth;
+                    }
+                }
+            }
+        }
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: ViewHeightMap
+
+      Summary:  Returns a view of a parsed height map, valid as long as
+                the height map is not changed
+
+      Args:     const HeightMap& heightMap
+                  Height map to view
+
+      Returns:  HeightMapView
+                  View of the height map
+    -----------------------------------------------------------------F-F*/
+    HeightMapView ViewHeightMap(_In_ const HeightMap& heightMap)
+    {
+        return HeightMapView{
+            .uWidth = heightMap.uWidth,
+            .uHeight = heightMap.uHeight,
+            .uDepth = heightMap.uDepth,
+            .uMaxColumnHeight = heightMap.uMaxColumnHeight,
+            .uNumColors = static_cast<UINT>(heightMap.aColors.size()),
+            .pColors = heightMap.aColors.data(),
+            .pColumnBlocks = heightMap.aColumnBlocks.data(),
+            .pColumnHeights = heightMap.aColumnHeights.data(),
+        };
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: WriteTextHeightMap
+
+      Summary:  Writes a height map in the text format
+                ParseTextHeightMap reads, one column per line. Heights
+                are written at the middle of their cube so they quantize
+                back to the same number of cubes
+
+      Args:     const std::filesystem::path& filePath
+                  File to write
+                const HeightMap& heightMap
+                  Height map to write
+
+      Returns:  HRESULT
+                  Status code
+    -----------------------------------------------------------------F-F*/
+    HRESULT WriteTextHeightMap(_In_ const std::filesystem::path& filePath, _In_ const HeightMap& heightMap)
+    {
+        std::ofstream outputFile(filePath, std::ios::binary | std::ios::trunc);
+        if (!outputFile)
+        {
+            return E_FAIL;
+        }
+
+        std::string text;
+        text.reserve(64u + heightMap.aColors.size() * 48u + heightMap.aColumnBlocks.size() * 16u);
+
+        CHAR szNumber[32];
+        auto appendNumber = [&text, &szNumber](auto value, CHAR separator)
+        {
+            std::to_chars_result result = std::to_chars(szNumber, szNumber + ARRAYSIZE(szNumber), value);
+            text.append(szNumber, result.ptr);
+            text.push_back(separator);
+        };
+
+        appendNumber(heightMap.uWidth, ' ');
+        appendNumber(heightMap.uHeight, ' ');
+        appendNumber(heightMap.uDepth, ' ');
+        appendNumber(static_cast<UINT>(heightMap.aColors.size()), '\n');
+        for (const XMFLOAT3& color : heightMap.aColors)
+        {
+            appendNumber(color.x, ' ');
+            appendNumber(color.y, ' ');
+            appendNumber(color.z, '\n');
+        }
+
+        const FLOAT heightScale = heightMap.uHeight > 0u ? 1.0f / static_cast<FLOAT>(heightMap.uHeight) : 0.0f;
+        for (size_t columnIdx = 0u; columnIdx < heightMap.aColumnBlocks.size(); ++columnIdx)
+        {
+            // Empty columns take the first block type at height 0,
+            // since the parser skips columns of unknown types
+            const BYTE block = heightMap.aColumnBlocks[columnIdx] != EMPTY_BLOCK ? heightMap.aColumnBlocks[columnIdx] : static_cast<BYTE>(eBlockType::GRASSLAND);
+            const WORD uColumnHeight = heightMap.aColumnBlocks[columnIdx] != EMPTY_BLOCK ? heightMap.aColumnHeights[columnIdx] : 0u;
+            text.push_back(static_cast<CHAR>(block));
+            text.push_back(' ');
+            appendNumber(uColumnHeight > 0u ? (static_cast<FLOAT>(uColumnHeight) + 0.5f) * heightScale : 0.0f, '\n');
+        }
+
+        outputFile.write(text.data(), static_cast<std::streamsize>(text.size()));
+        outputFile.close();
+        if (outputFile.fail())
+        {
+            return E_FAIL;
+        }
+
+        return S_OK;
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: WriteBinaryHeightMap
+
+      Summary:  Writes a height map in the binary format
+
+      Args:     const std::filesystem::path& filePath
+                  File to write
+                const HeightMap& heightMap
+                  Height map to write
+
+      Returns:  HRESULT
+                  Status code
+    -----------------------------------------------------------------F-F*/
+    HRESULT WriteBinaryHeightMap(_In_ const std::filesystem::path& filePath, _In_ const HeightMap& heightMap)
+    {
+        std::ofstream outputFile(filePath, std::ios::binary | std::ios::trunc);
+        if (!outputFile)
+        {
+            return E_FAIL;
+        }
+
+        HeightMapHeader header =
+        {
+            .uMagic = HEIGHT_MAP_MAGIC,
+            .uVersion = HEIGHT_MAP_VERSION,
+            .uWidth = heightMap.uWidth,
+            .uHeight = heightMap.uHeight,
+            .uDepth = heightMap.uDepth,
+            .uMaxColumnHeight = heightMap.uMaxColumnHeight,
+            .uNumColors = static_cast<UINT>(heightMap.aColors.size()),
+            .uReserved = 0u,
+        };
+        outputFile.write(reinterpret_cast<const CHAR*>(&header), sizeof(header));
+        outputFile.write(reinterpret_cast<const CHAR*>(heightMap.aColors.data()), static_cast<std::streamsize>(heightMap.aColors.size() * sizeof(XMFLOAT3)));
+        outputFile.write(reinterpret_cast<const CHAR*>(heightMap.aColumnBlocks.data()), static_cast<std::streamsize>(heightMap.aColumnBlocks.size()));
+        if (heightMap.aColumnBlocks.size() % 2u != 0u)
+        {
+            outputFile.put('\0');
+        }
+        outputFile.write(reinterpret_cast<const CHAR*>(heightMap.aColumnHeights.data()), static_cast<std::streamsize>(heightMap.aColumnHeights.size() * sizeof(WORD)));
+
+        outputFile.close();
+        if (outputFile.fail())
+        {
+            return E_FAIL;
+        }
+
+        return S_OK;
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: ConvertHeightMapToBinary
+
+      Summary:  Converts a text height map into the binary format
+
+      Args:     const std::filesystem::path& textFilePath
+                  Text height map to read
+                const std::filesystem::path& binaryFilePath
+                  Binary height map to write
+
+      Returns:  HRESULT
+                  Status code
+    -----------------------------------------------------------------F-F*/
+    HRESULT ConvertHeightMapToBinary(_In_ const std::filesystem::path& textFilePath, _In_ const std::filesystem::path& binaryFilePath)
+    {
+        MappedFile textFile;
+        HRESULT hr = textFile.Open(textFilePath);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        HeightMap heightMap;
+        ParseTextHeightMap(reinterpret_cast<const CHAR*>(textFile.GetData()), textFile.GetSize(), heightMap);
+
+        return WriteBinaryHeightMap(binaryFilePath, heightMap);
+    }
+}
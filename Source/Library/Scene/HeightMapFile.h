@@ -0,0 +1,94 @@
+/*+===================================================================
+  File:      HEIGHTMAPFILE.H
+
+  Summary:   HeightMapFile header file contains declarations of the
+             readers and writer of the height map a scene is loaded
+             from, both the text format and the binary format that is
+             read in place from a mapped file.
+
+  Classes: HeightMapHeader, HeightMap, HeightMapView
+
+  Functions: QuantizeColumnHeight, IsBinaryHeightMap,
+             MapBinaryHeightMap, ParseTextHeightMap, ViewHeightMap,
+             WriteTextHeightMap, WriteBinaryHeightMap,
+             ConvertHeightMapToBinary
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+namespace library
+{
+    // First four bytes of a binary height map, "VXHM"
+    constexpr UINT HEIGHT_MAP_MAGIC = 0x4D485856u;
+    constexpr UINT HEIGHT_MAP_VERSION = 1u;
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   HeightMapHeader
+
+      Summary:  Start of a binary height map. It is followed by
+                uNumColors XMFLOAT3 palette colors, then a block type
+                BYTE for each column, padded to two bytes, then the
+                number of cubes of each column as a WORD. Columns are
+                x fastest then z, and everything is little-endian
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct HeightMapHeader
+    {
+        UINT uMagic;
+        UINT uVersion;
+        UINT uWidth;
+        UINT uHeight;
+        UINT uDepth;
+        UINT uMaxColumnHeight;
+        UINT uNumColors;
+        UINT uReserved;
+    };
+
+    static_assert(sizeof(HeightMapHeader) == 32u);
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   HeightMap
+
+      Summary:  Height map read from text, laid out like the arrays of
+                the binary format
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct HeightMap
+    {
+        UINT uWidth;
+        UINT uHeight;
+        UINT uDepth;
+        UINT uMaxColumnHeight;
+        std::vector<XMFLOAT3> aColors;
+        std::vector<BYTE> aColumnBlocks;
+        std::vector<WORD> aColumnHeights;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   HeightMapView
+
+      Summary:  Height map either in a mapped binary file or in a
+                HeightMap, whichever it was read from
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct HeightMapView
+    {
+        UINT uWidth;
+        UINT uHeight;
+        UINT uDepth;
+        UINT uMaxColumnHeight;
+        UINT uNumColors;
+        const XMFLOAT3* pColors;
+        const BYTE* pColumnBlocks;
+        const WORD* pColumnHeights;
+    };
+
+    WORD QuantizeColumnHeight(_In_ UINT uHeight, _In_ FLOAT height);
+    BOOL IsBinaryHeightMap(_In_reads_bytes_(uSize) const BYTE* pData, _In_ SIZE_T uSize);
+    HRESULT MapBinaryHeightMap(_In_reads_bytes_(uSize) const BYTE* pData, _In_ SIZE_T uSize, _Out_ HeightMapView& view);
+    void ParseTextHeightMap(_In_reads_bytes_(uSize) const CHAR* pText, _In_ SIZE_T uSize, _Out_ HeightMap& heightMap);
+    HeightMapView ViewHeightMap(_In_ const HeightMap& heightMap);
+    HRESULT WriteTextHeightMap(_In_ const std::filesystem::path& filePath, _In_ const HeightMap& heightMap);
+    HRESULT WriteBinaryHeightMap(_In_ const std::filesystem::path& filePath, _In_ const HeightMap& heightMap);
+    HRESULT ConvertHeightMapToBinary(_In_ const std::filesystem::path& textFilePath, _In_ const std::filesystem::path& binaryFilePath);
+}
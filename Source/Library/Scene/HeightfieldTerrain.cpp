@@ -0,0 +1,653 @@
+#include "Scene/HeightfieldTerrain.h"
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HeightfieldTerrain::HeightfieldTerrain
+
+      Summary:  Constructor. Takes the height of every column of the
+                store, the top of its topmost run, and builds the
+                lowest and highest sample of every node of the
+                quadtree, the leaves from their samples and each
+                parent from its children
+
+      Args:     const VoxelColumnStore& store
+                  Store whose columns give the heights, only read while
+                  constructing
+
+      Modifies: [m_uWidth, m_uDepth, m_origin, m_cellSize, m_aHeights,
+                  m_uNumLevels, m_auLevelOffsets, m_aMinHeights,
+                  m_aMaxHeights, m_aLodRanges, m_aMorphStarts,
+                  m_cameraPosition, m_aSelection, m_aVertices,
+                  m_aIndices, m_uVertexCapacity, m_bounds].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HeightfieldTerrain::HeightfieldTerrain(_In_ const VoxelColumnStore& store)
+        : Voxel(std::vector<InstanceData>{ InstanceData{ .anCell = { 0, 0, 0 }, .nBlockType = EMPTY_BLOCK } }, XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f))
+        , m_uWidth(store.GetWidth())
+        , m_uDepth(store.GetDepth())
+        , m_origin(store.GetOrigin())
+        , m_cellSize(store.GetCellSize())
+        , m_aHeights(static_cast<size_t>(store.GetWidth()) * store.GetDepth())
+        , m_uNumLevels(1u)
+        , m_auLevelOffsets()
+        , m_aMinHeights()
+        , m_aMaxHeights()
+        , m_aLodRanges()
+        , m_aMorphStarts()
+        , m_cameraPosition()
+        , m_aSelection()
+        , m_aVertices()
+        , m_aIndices()
+        , m_uVertexCapacity(0u)
+    {
+        // An empty column is a sample at the floor of the world
+        for (UINT z = 0u; z < m_uDepth; ++z)
+        {
+            for (UINT x = 0u; x < m_uWidth; ++x)
+            {
+                const VoxelRun* pRuns = nullptr;
+                const UINT uNumRuns = store.GetColumn(static_cast<INT>(x), static_cast<INT>(z), &pRuns);
+                const UINT uTop = uNumRuns > 0u ? pRuns[uNumRuns - 1u].uEnd : 0u;
+                m_aHeights[static_cast<size_t>(z) * m_uWidth + x] = m_origin.y + static_cast<FLOAT>(uTop) * m_cellSize;
+            }
+        }
+
+        // Levels until the root covers every quad between the samples
+        const UINT uNumQuads = std::max(std::max(m_uWidth, m_uDepth), 2u) - 1u;
+        while ((HEIGHTFIELD_PATCH_SIZE << (m_uNumLevels - 1u)) < uNumQuads)
+        {
+            ++m_uNumLevels;
+        }
+
+        UINT uNumNodes = 0u;
+        m_auLevelOffsets.resize(m_uNumLevels);
+        for (UINT uLevel = 0u; uLevel < m_uNumLevels; ++uLevel)
+        {
+            const UINT uNodesPerSide = 1u << (m_uNumLevels - 1u - uLevel);
+            m_auLevelOffsets[uLevel] = uNumNodes;
+            uNumNodes += uNodesPerSide * uNodesPerSide;
+        }
+        m_aMinHeights.assign(uNumNodes, m_origin.y);
+        m_aMaxHeights.assign(uNumNodes, m_origin.y);
+
+        // A leaf covers the samples on both of its edges, which its
+        // patch reaches
+        const UINT uLeavesPerSide = 1u << (m_uNumLevels - 1u);
+        for (UINT uNodeZ = 0u; uNodeZ < uLeavesPerSide; ++uNodeZ)
+        {
+            for (UINT uNodeX = 0u; uNodeX < uLeavesPerSide; ++uNodeX)
+            {
+                const UINT uFirstX = uNodeX * HEIGHTFIELD_PATCH_SIZE;
+                const UINT uFirstZ = uNodeZ * HEIGHTFIELD_PATCH_SIZE;
+                if (uFirstX >= m_uWidth || uFirstZ >= m_uDepth)
+                {
+                    continue;
+                }
+
+                FLOAT minHeight = m_aHeights[static_cast<size_t>(uFirstZ) * m_uWidth + uFirstX];
+                FLOAT maxHeight = minHeight;
+                for (UINT z = uFirstZ; z <= std::min(uFirstZ + HEIGHTFIELD_PATCH_SIZE, m_uDepth - 1u); ++z)
+                {
+                    for (UINT x = uFirstX; x <= std::min(uFirstX + HEIGHTFIELD_PATCH_SIZE, m_uWidth - 1u); ++x)
+                    {
+                        minHeight = std::min(minHeight, m_aHeights[static_cast<size_t>(z) * m_uWidth + x]);
+                        maxHeight = std::max(maxHeight, m_aHeights[static_cast<size_t>(z) * m_uWidth + x]);
+                    }
+                }
+
+                m_aMinHeights[uNodeZ * uLeavesPerSide + uNodeX] = minHeight;
+                m_aMaxHeights[uNodeZ * uLeavesPerSide + uNodeX] = maxHeight;
+            }
+        }
+
+        for (UINT uLevel = 1u; uLevel < m_uNumLevels; ++uLevel)
+        {
+            const UINT uNodesPerSide = 1u << (m_uNumLevels - 1u - uLevel);
+            const UINT uChildrenPerSide = uNodesPerSide * 2u;
+            for (UINT uNodeZ = 0u; uNodeZ < uNodesPerSide; ++uNodeZ)
+            {
+                for (UINT uNodeX = 0u; uNodeX < uNodesPerSide; ++uNodeX)
+                {
+                    const UINT uNode = m_auLevelOffsets[uLevel] + uNodeZ * uNodesPerSide + uNodeX;
+                    const UINT uFirstChild = m_auLevelOffsets[uLevel - 1u] + uNodeZ * 2u * uChildrenPerSide + uNodeX * 2u;
+                    const UINT auChildren[4] = { uFirstChild, uFirstChild + 1u, uFirstChild + uChildrenPerSide, uFirstChild + uChildrenPerSide + 1u };
+
+                    m_aMinHeights[uNode] = m_aMinHeights[auChildren[0]];
+                    m_aMaxHeights[uNode] = m_aMaxHeights[auChildren[0]];
+                    for (UINT uChild = 1u; uChild < 4u; ++uChild)
+                    {
+                        m_aMinHeights[uNode] = std::min(m_aMinHeights[uNode], m_aMinHeights[auChildren[uChild]]);
+                        m_aMaxHeights[uNode] = std::max(m_aMaxHeights[uNode], m_aMaxHeights[auChildren[uChild]]);
+                    }
+                }
+            }
+        }
+
+        // Each level reaches twice as far as the one before and morphs
+        // over the last part of the way
+        m_aLodRanges.resize(m_uNumLevels);
+        m_aMorphStarts.resize(m_uNumLevels);
+        FLOAT range = HEIGHTFIELD_LEAF_RANGE * static_cast<FLOAT>(HEIGHTFIELD_PATCH_SIZE) * m_cellSize;
+        for (UINT uLevel = 0u; uLevel < m_uNumLevels; ++uLevel)
+        {
+            const FLOAT previousRange = uLevel > 0u ? m_aLodRanges[uLevel - 1u] : 0.0f;
+            m_aLodRanges[uLevel] = range;
+            m_aMorphStarts[uLevel] = previousRange + (range - previousRange) * HEIGHTFIELD_MORPH_START;
+            range *= 2.0f;
+        }
+
+        // The grid of a whole node, then of a quarter node drawn at
+        // the level of its parent, both clockwise seen from above
+        for (UINT uQuads = HEIGHTFIELD_PATCH_SIZE; uQuads >= HEIGHTFIELD_PATCH_SIZE / 2u; uQuads /= 2u)
+        {
+            const UINT uRow = uQuads + 1u;
+            for (UINT k = 0u; k < uQuads; ++k)
+            {
+                for (UINT i = 0u; i < uQuads; ++i)
+                {
+                    const WORD uCorner = static_cast<WORD>(k * uRow + i);
+                    const WORD auQuad[6] =
+                    {
+                        static_cast<WORD>(uCorner + uRow), static_cast<WORD>(uCorner + uRow + 1u), static_cast<WORD>(uCorner + 1u),
+                        static_cast<WORD>(uCorner + uRow), static_cast<WORD>(uCorner + 1u), uCorner,
+                    };
+                    m_aIndices.insert(m_aIndices.end(), std::begin(auQuad), std::end(auQuad));
+                }
+            }
+        }
+
+        m_bounds = getNodeBounds(m_uNumLevels - 1u, 0u, 0u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HeightfieldTerrain::Initialize
+
+      Summary:  Creates the index buffer of the two patch grids and the
+                buffer of the identity instance. The vertex buffer is
+                created by the first Upload, once its size is known
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the buffers
+                ID3D11DeviceContext* pImmediateContext
+                  The Direct3D context to set buffers
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT HeightfieldTerrain::Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext)
+    {
+        UNREFERENCED_PARAMETER(pImmediateContext);
+
+        D3D11_BUFFER_DESC iBufferDesc =
+        {
+            .ByteWidth = static_cast<UINT>(sizeof(WORD)) * GetNumIndices(),
+            .Usage = D3D11_USAGE_DEFAULT,
+            .BindFlags = D3D11_BIND_INDEX_BUFFER,
+            .CPUAccessFlags = 0u,
+            .MiscFlags = 0u,
+            .StructureByteStride = 0u
+        };
+        D3D11_SUBRESOURCE_DATA iInitData =
+        {
+            .pSysMem = getIndices(),
+            .SysMemPitch = 0u,
+            .SysMemSlicePitch = 0u
+        };
+        HRESULT hr = pDevice->CreateBuffer(&iBufferDesc, &iInitData, m_indexBuffer.GetAddressOf());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        return initializeInstance(pDevice);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HeightfieldTerrain::Update
+
+      Summary:  Updates the heightfield every frame
+
+      Args:     FLOAT deltaTime
+                  Elapsed time
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void HeightfieldTerrain::Update(_In_ FLOAT deltaTime)
+    {
+        UNREFERENCED_PARAMETER(deltaTime);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HeightfieldTerrain::SelectNodes
+
+      Summary:  Walks the quadtree from the root and lists the nodes to
+                draw for a camera, along with their bounds as the
+                bounds of the meshes. The root is always drawn where
+                nothing finer is, however far it is
+
+      Args:     const XMFLOAT3& cameraPosition
+                  World position of the camera
+                const FrustumCuller& frustum
+                  Culler holding the planes of the view projection
+                  matrix of the camera
+
+      Modifies: [m_cameraPosition, m_aSelection, m_aMeshBounds].
+
+      Returns:  UINT
+                  Number of nodes selected
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT HeightfieldTerrain::SelectNodes(_In_ const XMFLOAT3& cameraPosition, _In_ const FrustumCuller& frustum)
+    {
+        m_cameraPosition = cameraPosition;
+        m_aSelection.clear();
+        m_aMeshBounds.clear();
+
+        if (m_uWidth == 0u || m_uDepth == 0u)
+        {
+            return 0u;
+        }
+
+        selectNode(frustum, m_uNumLevels - 1u, 0u, 0u, FRUSTUM_ALL_PLANES);
+
+        return static_cast<UINT>(m_aSelection.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HeightfieldTerrain::BuildVertices
+
+      Summary:  Builds the patch of every selected node one after the
+                other, each a mesh of its own drawn with the indices of
+                its grid
+
+      Modifies: [m_aVertices, m_aMeshes].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void HeightfieldTerrain::BuildVertices()
+    {
+        m_aMeshes.resize(m_aSelection.size());
+
+        UINT uNumVertices = 0u;
+        for (SIZE_T i = 0u; i < m_aSelection.size(); ++i)
+        {
+            const UINT uQuads = m_aSelection[i].uSize >> m_aSelection[i].uLevel;
+
+            BasicMeshEntry& mesh = m_aMeshes[i];
+            mesh.uNumIndices = uQuads * uQuads * 6u;
+            mesh.uBaseIndex = uQuads == HEIGHTFIELD_PATCH_SIZE ? 0u : HEIGHTFIELD_PATCH_SIZE * HEIGHTFIELD_PATCH_SIZE * 6u;
+            mesh.uBaseVertex = uNumVertices;
+            mesh.uMaterialIndex = HasTexture() ? 0u : INVALID_MATERIAL;
+
+            uNumVertices += (uQuads + 1u) * (uQuads + 1u);
+        }
+
+        m_aVertices.resize(uNumVertices);
+        for (SIZE_T i = 0u; i < m_aSelection.size(); ++i)
+        {
+            addPatch(m_aSelection[i], m_aVertices.data() + m_aMeshes[i].uBaseVertex);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HeightfieldTerrain::Upload
+
+      Summary:  Writes the patches to the dynamic vertex buffer. The
+                buffer is recreated twice as large as the patches
+                need whenever they outgrow it, so a camera moving
+                about does not recreate it every few frames. If that
+                fails the selection is dropped and nothing is drawn
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the buffer
+                RenderBackend& backend
+                  Backend of the frame to write the buffer through
+
+      Modifies: [m_vertexBuffer, m_uVertexCapacity, m_aSelection,
+                  m_aMeshes, m_aMeshBounds].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT HeightfieldTerrain::Upload(_In_ ID3D11Device* pDevice, _In_ RenderBackend& backend)
+    {
+        if (m_aVertices.empty())
+        {
+            return S_OK;
+        }
+
+        const UINT uNumVertices = GetNumVertices();
+        if (uNumVertices > m_uVertexCapacity)
+        {
+            const UINT uCapacity = std::max(uNumVertices * 2u, m_uVertexCapacity * 2u);
+            D3D11_BUFFER_DESC vBufferDesc =
+            {
+                .ByteWidth = static_cast<UINT>(sizeof(SimpleVertex)) * uCapacity,
+                .Usage = D3D11_USAGE_DYNAMIC,
+                .BindFlags = D3D11_BIND_VERTEX_BUFFER,
+                .CPUAccessFlags = D3D11_CPU_ACCESS_WRITE,
+                .MiscFlags = 0u,
+                .StructureByteStride = 0u
+            };
+
+            m_vertexBuffer.Reset();
+            HRESULT hr = pDevice->CreateBuffer(&vBufferDesc, nullptr, m_vertexBuffer.GetAddressOf());
+            if (FAILED(hr))
+            {
+                m_uVertexCapacity = 0u;
+                m_aSelection.clear();
+                m_aMeshes.clear();
+                m_aMeshBounds.clear();
+                return hr;
+            }
+            m_uVertexCapacity = uCapacity;
+        }
+
+        backend.WriteDynamicBuffer(m_vertexBuffer.Get(), 0u, m_aVertices.data(), uNumVertices * static_cast<UINT>(sizeof(SimpleVertex)), TRUE);
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HeightfieldTerrain::GetSelection
+
+      Summary:  Returns the nodes of the last selection
+
+      Returns:  const std::vector<HeightfieldNode>&
+                  Nodes in the order their meshes are drawn
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const std::vector<HeightfieldNode>& HeightfieldTerrain::GetSelection() const
+    {
+        return m_aSelection;
+    }
+
+    UINT HeightfieldTerrain::GetNumLevels() const
+    {
+        return m_uNumLevels;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HeightfieldTerrain::GetLodRange
+
+      Summary:  Returns the distance from the camera up to which a
+                level is drawn, where its morph into the next level
+                ends
+
+      Args:     UINT uLevel
+                  Level of the quadtree, 0 for the leaves
+
+      Returns:  FLOAT
+                  Distance in world units
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT HeightfieldTerrain::GetLodRange(_In_ UINT uLevel) const
+    {
+        return m_aLodRanges[uLevel];
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HeightfieldTerrain::GetHeight
+
+      Summary:  Interpolates the height of the surface between the four
+                samples around a position, clamped to the edges
+
+      Args:     FLOAT x
+                FLOAT z
+                  Position in samples
+
+      Returns:  FLOAT
+                  World height
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT HeightfieldTerrain::GetHeight(_In_ FLOAT x, _In_ FLOAT z) const
+    {
+        if (m_uWidth == 0u || m_uDepth == 0u)
+        {
+            return m_origin.y;
+        }
+
+        x = std::clamp(x, 0.0f, static_cast<FLOAT>(m_uWidth - 1u));
+        z = std::clamp(z, 0.0f, static_cast<FLOAT>(m_uDepth - 1u));
+
+        const UINT uX0 = static_cast<UINT>(x);
+        const UINT uZ0 = static_cast<UINT>(z);
+        const UINT uX1 = std::min(uX0 + 1u, m_uWidth - 1u);
+        const UINT uZ1 = std::min(uZ0 + 1u, m_uDepth - 1u);
+        const FLOAT fractionX = x - static_cast<FLOAT>(uX0);
+        const FLOAT fractionZ = z - static_cast<FLOAT>(uZ0);
+
+        const FLOAT* pRow0 = m_aHeights.data() + static_cast<size_t>(uZ0) * m_uWidth;
+        const FLOAT* pRow1 = m_aHeights.data() + static_cast<size_t>(uZ1) * m_uWidth;
+        const FLOAT height0 = pRow0[uX0] + (pRow0[uX1] - pRow0[uX0]) * fractionX;
+        const FLOAT height1 = pRow1[uX0] + (pRow1[uX1] - pRow1[uX0]) * fractionX;
+
+        return height0 + (height1 - height0) * fractionZ;
+    }
+
+    UINT HeightfieldTerrain::GetNumVertices() const
+    {
+        return static_cast<UINT>(m_aVertices.size());
+    }
+
+    UINT HeightfieldTerrain::GetNumIndices() const
+    {
+        return static_cast<UINT>(m_aIndices.size());
+    }
+
+    const SimpleVertex* HeightfieldTerrain::getVertices() const
+    {
+        return m_aVertices.data();
+    }
+
+    const WORD* HeightfieldTerrain::getIndices() const
+    {
+        return m_aIndices.data();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HeightfieldTerrain::getNodeBounds
+
+      Summary:  Returns the world box of a node, from its samples that
+                lie in the map and its lowest and highest sample
+
+      Args:     UINT uLevel
+                  Level of the node
+                UINT uX
+                UINT uZ
+                  First sample of the node
+
+      Returns:  BoundingVolume
+                  Box of the node and the sphere around it
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BoundingVolume HeightfieldTerrain::getNodeBounds(_In_ UINT uLevel, _In_ UINT uX, _In_ UINT uZ) const
+    {
+        const UINT uSize = HEIGHTFIELD_PATCH_SIZE << uLevel;
+        const UINT uNodesPerSide = 1u << (m_uNumLevels - 1u - uLevel);
+        const UINT uNode = m_auLevelOffsets[uLevel] + (uZ / uSize) * uNodesPerSide + uX / uSize;
+
+        const FLOAT firstX = m_origin.x + (static_cast<FLOAT>(uX) + 0.5f) * m_cellSize;
+        const FLOAT firstZ = m_origin.z + (static_cast<FLOAT>(uZ) + 0.5f) * m_cellSize;
+        const FLOAT lastX = m_origin.x + (static_cast<FLOAT>(std::min(uX + uSize, std::max(m_uWidth, 1u) - 1u)) + 0.5f) * m_cellSize;
+        const FLOAT lastZ = m_origin.z + (static_cast<FLOAT>(std::min(uZ + uSize, std::max(m_uDepth, 1u) - 1u)) + 0.5f) * m_cellSize;
+
+        BoundingVolume bounds =
+        {
+            .Center = XMFLOAT3((firstX + lastX) * 0.5f, (m_aMinHeights[uNode] + m_aMaxHeights[uNode]) * 0.5f, (firstZ + lastZ) * 0.5f),
+            .Radius = 0.0f,
+            .Extents = XMFLOAT3(std::max(lastX - firstX, 0.0f) * 0.5f, (m_aMaxHeights[uNode] - m_aMinHeights[uNode]) * 0.5f, std::max(lastZ - firstZ, 0.0f) * 0.5f)
+        };
+        bounds.Radius = XMVectorGetX(XMVector3Length(XMLoadFloat3(&bounds.Extents)));
+
+        return bounds;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HeightfieldTerrain::isInRange
+
+      Summary:  Returns whether any point of a box is within the range
+                of a level from the camera of the selection
+
+      Args:     const BoundingVolume& bounds
+                  World box of a node
+                UINT uLevel
+                  Level whose range to test
+
+      Returns:  BOOL
+                  TRUE if the box reaches into the range
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL HeightfieldTerrain::isInRange(_In_ const BoundingVolume& bounds, _In_ UINT uLevel) const
+    {
+        const XMVECTOR center = XMLoadFloat3(&bounds.Center);
+        const XMVECTOR extents = XMLoadFloat3(&bounds.Extents);
+        const XMVECTOR camera = XMLoadFloat3(&m_cameraPosition);
+
+        // Distance from the camera to the nearest point of the box
+        const XMVECTOR outside = XMVectorMax(XMVectorSubtract(XMVectorAbs(XMVectorSubtract(camera, center)), extents), XMVectorZero());
+        const FLOAT range = m_aLodRanges[uLevel];
+
+        return XMVectorGetX(XMVector3LengthSq(outside)) <= range * range;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HeightfieldTerrain::selectNode
+
+      Summary:  Selects a node or the parts of it below. A node outside
+                the map or the frustum needs nothing drawn. One out of
+                the range of its level is left to its parent, which
+                draws it as a quarter at its own coarser level. One
+                with no part in the range of the finer level is drawn
+                whole, and any other is split into its children
+
+      Args:     const FrustumCuller& frustum
+                  Culler holding the planes of the camera
+                UINT uLevel
+                  Level of the node
+                UINT uX
+                UINT uZ
+                  First sample of the node
+                UINT uPlaneMask
+                  Planes the parent of the node was not wholly inside
+
+      Modifies: [m_aSelection, m_aMeshBounds].
+
+      Returns:  BOOL
+                  FALSE if the node is out of the range of its level
+                  and its parent has to draw it
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL HeightfieldTerrain::selectNode(_In_ const FrustumCuller& frustum, _In_ UINT uLevel, _In_ UINT uX, _In_ UINT uZ, _In_ UINT uPlaneMask)
+    {
+        if ((uX > 0u && uX >= m_uWidth - 1u) || (uZ > 0u && uZ >= m_uDepth - 1u))
+        {
+            return TRUE;
+        }
+
+        const BoundingVolume bounds = getNodeBounds(uLevel, uX, uZ);
+        if (!frustum.IsBoxVisible(bounds.Center, bounds.Extents, uPlaneMask))
+        {
+            return TRUE;
+        }
+
+        if (uLevel + 1u < m_uNumLevels && !isInRange(bounds, uLevel))
+        {
+            return FALSE;
+        }
+
+        const UINT uSize = HEIGHTFIELD_PATCH_SIZE << uLevel;
+        if (uLevel == 0u || !isInRange(bounds, uLevel - 1u))
+        {
+            addNode(uX, uZ, uSize, uLevel, bounds);
+            return TRUE;
+        }
+
+        const UINT uHalfSize = uSize / 2u;
+        for (UINT uChild = 0u; uChild < 4u; ++uChild)
+        {
+            const UINT uChildX = uX + (uChild & 1u) * uHalfSize;
+            const UINT uChildZ = uZ + (uChild >> 1u) * uHalfSize;
+            if (!selectNode(frustum, uLevel - 1u, uChildX, uChildZ, uPlaneMask))
+            {
+                addNode(uChildX, uChildZ, uHalfSize, uLevel, getNodeBounds(uLevel - 1u, uChildX, uChildZ));
+            }
+        }
+
+        return TRUE;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HeightfieldTerrain::addNode
+
+      Summary:  Adds a square to the selection and its box to the
+                bounds of the meshes
+
+      Args:     UINT uX
+                UINT uZ
+                  First sample of the square
+                UINT uSize
+                  Edge of the square in samples
+                UINT uLevel
+                  Level the square is drawn at
+                const BoundingVolume& bounds
+                  World box of the square
+
+      Modifies: [m_aSelection, m_aMeshBounds].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void HeightfieldTerrain::addNode(_In_ UINT uX, _In_ UINT uZ, _In_ UINT uSize, _In_ UINT uLevel, _In_ const BoundingVolume& bounds)
+    {
+        m_aSelection.push_back(HeightfieldNode{ .uX = uX, .uZ = uZ, .uSize = uSize, .uLevel = uLevel });
+        m_aMeshBounds.push_back(bounds);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HeightfieldTerrain::addPatch
+
+      Summary:  Builds the vertices of the patch of a node. How far a
+                vertex is morphed follows the distance of its unmorphed
+                position from the camera across the morph of the level.
+                Morphing slides the odd vertices of the level onto their
+                even neighbours, which are the vertices of the next
+                coarser level, so a vertex shared by two patches of
+                either level lands in the same place in both. The
+                height is then interpolated at the morphed position and
+                the normal follows the slope over one vertex spacing
+
+      Args:     const HeightfieldNode& node
+                  Node to build
+                SimpleVertex* pVertices
+                  Receives the vertices, rows along x from the first z
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void HeightfieldTerrain::addPatch(_In_ const HeightfieldNode& node, _Inout_ SimpleVertex* pVertices) const
+    {
+        const UINT uStep = 1u << node.uLevel;
+        const UINT uQuads = node.uSize >> node.uLevel;
+        const FLOAT step = static_cast<FLOAT>(uStep);
+        const FLOAT maxX = static_cast<FLOAT>(m_uWidth - 1u);
+        const FLOAT maxZ = static_cast<FLOAT>(m_uDepth - 1u);
+        const FLOAT morphStart = m_aMorphStarts[node.uLevel];
+        const FLOAT morphScale = 1.0f / (m_aLodRanges[node.uLevel] - morphStart);
+        const XMVECTOR camera = XMLoadFloat3(&m_cameraPosition);
+
+        for (UINT k = 0u; k <= uQuads; ++k)
+        {
+            const UINT uZ = node.uZ + k * uStep;
+            const UINT uSampleZ = std::min(uZ, m_uDepth - 1u);
+            for (UINT i = 0u; i <= uQuads; ++i)
+            {
+                const UINT uX = node.uX + i * uStep;
+                const UINT uSampleX = std::min(uX, m_uWidth - 1u);
+
+                const XMVECTOR position = XMVectorSet(
+                    m_origin.x + (static_cast<FLOAT>(uSampleX) + 0.5f) * m_cellSize,
+                    m_aHeights[static_cast<size_t>(uSampleZ) * m_uWidth + uSampleX],
+                    m_origin.z + (static_cast<FLOAT>(uSampleZ) + 0.5f) * m_cellSize,
+                    0.0f
+                );
+                const FLOAT distance = XMVectorGetX(XMVector3Length(XMVectorSubtract(position, camera)));
+                const FLOAT morph = std::clamp((distance - morphStart) * morphScale, 0.0f, 1.0f);
+
+                const FLOAT x = std::min(static_cast<FLOAT>(uX) - static_cast<FLOAT>((uX / uStep) & 1u) * step * morph, maxX);
+                const FLOAT z = std::min(static_cast<FLOAT>(uZ) - static_cast<FLOAT>((uZ / uStep) & 1u) * step * morph, maxZ);
+
+                const FLOAT slopeX = GetHeight(x - step, z) - GetHeight(x + step, z);
+                const FLOAT slopeZ = GetHeight(x, z - step) - GetHeight(x, z + step);
+
+                SimpleVertex& vertex = pVertices[k * (uQuads + 1u) + i];
+                vertex.Position = XMFLOAT3(m_origin.x + (x + 0.5f) * m_cellSize, GetHeight(x, z), m_origin.z + (z + 0.5f) * m_cellSize);
+                vertex.TexCoord = XMFLOAT2(x, z);
+                XMStoreFloat3(&vertex.Normal, XMVector3Normalize(XMVectorSet(slopeX, 2.0f * step * m_cellSize, slopeZ, 0.0f)));
+            }
+        }
+    }
+}
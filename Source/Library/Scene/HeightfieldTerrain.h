@@ -0,0 +1,163 @@
+/*+===================================================================
+  File:      HEIGHTFIELDTERRAIN.H
+
+  Summary:   HeightfieldTerrain header file contains declarations of
+             the smooth far view of the terrain, a quadtree of patches
+             of the column heights whose level of detail falls off
+             continuously with distance.
+
+  Classes: HeightfieldNode, HeightfieldTerrain
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Renderer/FrustumCuller.h"
+#include "Renderer/RenderBackend.h"
+#include "Scene/Voxel.h"
+#include "Scene/VoxelColumnStore.h"
+
+namespace library
+{
+    // Quads along the edge of the patch of a node, a multiple of four
+    // so the quarter of a node drawn at the level of its parent starts
+    // on an even vertex of that level
+    constexpr UINT HEIGHTFIELD_PATCH_SIZE = 16u;
+
+    // Distance the finest level reaches, in edges of a leaf node. The
+    // nodes of a level must fit well inside the morph of the next one
+    // for the levels to meet without cracks, which takes a little over
+    // two
+    constexpr FLOAT HEIGHTFIELD_LEAF_RANGE = 4.0f;
+
+    // Fraction of the way from the range of the finer level to its own
+    // range where a level starts morphing into the next coarser one
+    constexpr FLOAT HEIGHTFIELD_MORPH_START = 0.7f;
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   HeightfieldNode
+
+      Summary:  Square of the heightfield selected for drawing. uX and
+                uZ are its first sample and uSize its edge in samples.
+                It is drawn with the vertex spacing of level uLevel,
+                2^uLevel samples, which is a whole node of that level
+                or a quarter of one whose other quarters went to finer
+                levels
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct HeightfieldNode
+    {
+        UINT uX;
+        UINT uZ;
+        UINT uSize;
+        UINT uLevel;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    HeightfieldTerrain
+
+      Summary:  One height sample at the top of each column of a voxel
+                store, meshed as a continuous surface rather than as
+                cubes. A quadtree over the samples keeps the lowest and
+                highest sample of each node. Every frame the nodes are
+                selected top down in the manner of CDLOD: a node in
+                view is drawn whole unless part of it is within the
+                range of the finer level, in which case its children
+                are visited and those out of that range are drawn as
+                quarters at its level. Each node is a patch of
+                HEIGHTFIELD_PATCH_SIZE quads whose vertices morph into
+                the grid of the next coarser level as their distance
+                nears the end of the range, so a level meets the next
+                without cracks or popping. The vertices are built on
+                the CPU in world space and written to a dynamic buffer,
+                and the heightfield is drawn as a voxel with one
+                identity instance, one mesh per node, so it takes the
+                voxel shaders and material unchanged. Like the other
+                voxels it needs a material to be drawn per node
+
+      Methods:  Initialize
+                  Creates the index and instance buffers
+                Update
+                  Updates the heightfield every frame
+                SelectNodes
+                  Picks the nodes to draw for a camera
+                BuildVertices
+                  Builds the morphed patches of the selected nodes
+                Upload
+                  Writes the patches to the vertex buffer
+                GetSelection
+                  Returns the nodes of the last selection
+                GetNumLevels
+                  Returns the number of levels of the quadtree
+                GetLodRange
+                  Returns how far a level reaches
+                GetHeight
+                  Returns the height of the surface at a sample
+                  position
+                GetNumVertices
+                  Returns the number of vertices of the patches
+                GetNumIndices
+                  Returns the number of indices of the two patch grids
+                HeightfieldTerrain
+                  Constructor.
+                ~HeightfieldTerrain
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class HeightfieldTerrain final : public Voxel
+    {
+    public:
+        HeightfieldTerrain(_In_ const VoxelColumnStore& store);
+        HeightfieldTerrain(const HeightfieldTerrain& other) = delete;
+        HeightfieldTerrain(HeightfieldTerrain&& other) = delete;
+        HeightfieldTerrain& operator=(const HeightfieldTerrain& other) = delete;
+        HeightfieldTerrain& operator=(HeightfieldTerrain&& other) = delete;
+        ~HeightfieldTerrain() = default;
+
+        virtual HRESULT Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext) override;
+        virtual void Update(_In_ FLOAT deltaTime) override;
+
+        UINT SelectNodes(_In_ const XMFLOAT3& cameraPosition, _In_ const FrustumCuller& frustum);
+        void BuildVertices();
+        HRESULT Upload(_In_ ID3D11Device* pDevice, _In_ RenderBackend& backend);
+
+        const std::vector<HeightfieldNode>& GetSelection() const;
+        UINT GetNumLevels() const;
+        FLOAT GetLodRange(_In_ UINT uLevel) const;
+        FLOAT GetHeight(_In_ FLOAT x, _In_ FLOAT z) const;
+
+        UINT GetNumVertices() const override;
+        UINT GetNumIndices() const override;
+
+    protected:
+        const SimpleVertex* getVertices() const override;
+        const WORD* getIndices() const override;
+
+    private:
+        BoundingVolume getNodeBounds(_In_ UINT uLevel, _In_ UINT uX, _In_ UINT uZ) const;
+        BOOL isInRange(_In_ const BoundingVolume& bounds, _In_ UINT uLevel) const;
+        BOOL selectNode(_In_ const FrustumCuller& frustum, _In_ UINT uLevel, _In_ UINT uX, _In_ UINT uZ, _In_ UINT uPlaneMask);
+        void addNode(_In_ UINT uX, _In_ UINT uZ, _In_ UINT uSize, _In_ UINT uLevel, _In_ const BoundingVolume& bounds);
+        void addPatch(_In_ const HeightfieldNode& node, _Inout_ SimpleVertex* pVertices) const;
+
+    private:
+        UINT m_uWidth;
+        UINT m_uDepth;
+        XMFLOAT3 m_origin;
+        FLOAT m_cellSize;
+        std::vector<FLOAT> m_aHeights;
+
+        UINT m_uNumLevels;
+        std::vector<UINT> m_auLevelOffsets;
+        std::vector<FLOAT> m_aMinHeights;
+        std::vector<FLOAT> m_aMaxHeights;
+        std::vector<FLOAT> m_aLodRanges;
+        std::vector<FLOAT> m_aMorphStarts;
+
+        XMFLOAT3 m_cameraPosition;
+        std::vector<HeightfieldNode> m_aSelection;
+        std::vector<SimpleVertex> m_aVertices;
+        std::vector<WORD> m_aIndices;
+        UINT m_uVertexCapacity;
+    };
+}
@@ -0,0 +1,590 @@
+#include "Scene/Noise.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define NOISE_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+// MSVC emits AVX2 intrinsics in any function
+#define NOISE_TARGET_AVX2
+#else
+#define NOISE_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#else
+#define NOISE_X86 0
+#endif
+
+namespace library
+{
+    namespace
+    {
+        // Lattice values of the noise, indexed by hashing the lattice
+        // coordinates of a point
+        alignas(32) constexpr UINT HASHES[] =
+        {
+            208,34,231,213,32,248,233,56,161,78,24,140,71,48,140,254,245,255,247,247,40,
+            185,248,251,245,28,124,204,204,76,36,1,107,28,234,163,202,224,245,128,167,204,
+            9,92,217,54,239,174,173,102,193,189,190,121,100,108,167,44,43,77,180,204,8,81,
+            70,223,11,38,24,254,210,210,177,32,81,195,243,125,8,169,112,32,97,53,195,13,
+            203,9,47,104,125,117,114,124,165,203,181,235,193,206,70,180,174,0,167,181,41,
+            164,30,116,127,198,245,146,87,224,149,206,57,4,192,210,65,210,129,240,178,105,
+            228,108,245,148,140,40,35,195,38,58,65,207,215,253,65,85,208,76,62,3,237,55,89,
+            232,50,217,64,244,157,199,121,252,90,17,212,203,149,152,140,187,234,177,73,174,
+            193,100,192,143,97,53,145,135,19,103,13,90,135,151,199,91,239,247,33,39,145,
+            101,120,99,3,186,86,99,41,237,203,111,79,220,135,158,42,30,154,120,67,87,167,
+            135,176,183,191,253,115,184,21,233,58,129,233,142,39,128,211,118,137,139,255,
+            114,20,218,113,154,27,127,246,250,1,8,198,250,209,92,222,173,21,88,102,219
+        };
+
+        static_assert(std::size(HASHES) == 256u);
+
+        FLOAT getNoise2(_In_ UINT x, _In_ UINT y)
+        {
+            UINT temp = HASHES[y % 256u];
+
+            return static_cast<FLOAT>(HASHES[(temp + x) % 256u]);
+        }
+
+        FLOAT getNoise3(_In_ UINT x, _In_ UINT y, _In_ UINT z)
+        {
+            UINT temp = HASHES[(HASHES[z % 256u] + y) % 256u];
+
+            return static_cast<FLOAT>(HASHES[(temp + x) % 256u]);
+        }
+
+        FLOAT lerp(_In_ FLOAT x, _In_ FLOAT y, _In_ FLOAT s)
+        {
+            return x + s * (y - x);
+        }
+
+        FLOAT smoothLerp(_In_ FLOAT x, _In_ FLOAT y, _In_ FLOAT s)
+        {
+            return lerp(x, y, s * s * (3.0f - 2.0f * s));
+        }
+
+        FLOAT getNoise2d(_In_ FLOAT x, _In_ FLOAT y)
+        {
+            UINT uX = static_cast<UINT>(x);
+            UINT uY = static_cast<UINT>(y);
+            FLOAT xFrac = x - static_cast<FLOAT>(uX);
+            FLOAT yFrac = y - static_cast<FLOAT>(uY);
+
+            UINT s = static_cast<UINT>(getNoise2(uX, uY));
+            UINT t = static_cast<UINT>(getNoise2(uX + 1u, uY));
+            UINT u = static_cast<UINT>(getNoise2(uX, uY + 1u));
+            UINT v = static_cast<UINT>(getNoise2(uX + 1u, uY + 1u));
+
+            FLOAT low = smoothLerp(static_cast<FLOAT>(s), static_cast<FLOAT>(t), xFrac);
+            FLOAT high = smoothLerp(static_cast<FLOAT>(u), static_cast<FLOAT>(v), xFrac);
+
+            return smoothLerp(low, high, yFrac);
+        }
+
+        FLOAT getNoise3d(_In_ FLOAT x, _In_ FLOAT y, _In_ FLOAT z)
+        {
+            UINT uX = static_cast<UINT>(x);
+            UINT uY = static_cast<UINT>(y);
+            UINT uZ = static_cast<UINT>(z);
+            FLOAT xFrac = x - static_cast<FLOAT>(uX);
+            FLOAT yFrac = y - static_cast<FLOAT>(uY);
+            FLOAT zFrac = z - static_cast<FLOAT>(uZ);
+
+            FLOAT aPlanes[2];
+            for (UINT i = 0u; i < 2u; ++i)
+            {
+                FLOAT low = smoothLerp(getNoise3(uX, uY, uZ + i), getNoise3(uX + 1u, uY, uZ + i), xFrac);
+                FLOAT high = smoothLerp(getNoise3(uX, uY + 1u, uZ + i), getNoise3(uX + 1u, uY + 1u, uZ + i), xFrac);
+                aPlanes[i] = smoothLerp(low, high, yFrac);
+            }
+
+            return smoothLerp(aPlanes[0], aPlanes[1], zFrac);
+        }
+
+        // Sum of the octave weights, what the octave sum is divided by
+        FLOAT getOctaveDivisor(_In_ UINT uDepth)
+        {
+            FLOAT amp = 1.0f;
+            FLOAT div = 0.0f;
+            for (UINT i = 0; i < uDepth; ++i)
+            {
+                div += 256.0f * amp;
+                amp /= 2.0f;
+            }
+
+            return div;
+        }
+
+#if NOISE_X86
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: isAvx2Supported
+
+          Summary:  Returns whether both the processor and the operating
+                    system support AVX2
+        -----------------------------------------------------------------F-F*/
+        BOOL isAvx2Supported()
+        {
+#if defined(_MSC_VER)
+            INT anInfo[4];
+            __cpuid(anInfo, 0);
+            if (anInfo[0] < 7)
+            {
+                return FALSE;
+            }
+
+            // OSXSAVE and AVX, then the YMM state saved by the OS
+            __cpuid(anInfo, 1);
+            if ((anInfo[2] & (1 << 27)) == 0 || (anInfo[2] & (1 << 28)) == 0)
+            {
+                return FALSE;
+            }
+            if ((_xgetbv(0) & 0x6u) != 0x6u)
+            {
+                return FALSE;
+            }
+
+            __cpuidex(anInfo, 7, 0);
+            return (anInfo[1] & (1 << 5)) != 0;
+#else
+            return __builtin_cpu_supports("avx2") ? TRUE : FALSE;
+#endif
+        }
+
+        // The vector versions below repeat the scalar arithmetic
+        // operation for operation, with no fused multiply-adds, so
+        // every lane rounds exactly as the scalar version does
+
+        __m128 smoothLerpSse2(_In_ __m128 x, _In_ __m128 y, _In_ __m128 s)
+        {
+            __m128 weight = _mm_mul_ps(_mm_mul_ps(s, s), _mm_sub_ps(_mm_set1_ps(3.0f), _mm_mul_ps(_mm_set1_ps(2.0f), s)));
+            return _mm_add_ps(x, _mm_mul_ps(weight, _mm_sub_ps(y, x)));
+        }
+
+        __m128 getNoise2dSse2(_In_ __m128 x, _In_ __m128 y)
+        {
+            __m128i nX = _mm_cvttps_epi32(x);
+            __m128i nY = _mm_cvttps_epi32(y);
+            __m128 xFrac = _mm_sub_ps(x, _mm_cvtepi32_ps(nX));
+            __m128 yFrac = _mm_sub_ps(y, _mm_cvtepi32_ps(nY));
+
+            // SSE2 has no gather, so the lattice values are looked up
+            // one lane at a time
+            alignas(16) UINT auX[4];
+            alignas(16) UINT auY[4];
+            _mm_store_si128(reinterpret_cast<__m128i*>(auX), nX);
+            _mm_store_si128(reinterpret_cast<__m128i*>(auY), nY);
+
+            alignas(16) FLOAT aS[4];
+            alignas(16) FLOAT aT[4];
+            alignas(16) FLOAT aU[4];
+            alignas(16) FLOAT aV[4];
+            for (UINT i = 0u; i < 4u; ++i)
+            {
+                aS[i] = getNoise2(auX[i], auY[i]);
+                aT[i] = getNoise2(auX[i] + 1u, auY[i]);
+                aU[i] = getNoise2(auX[i], auY[i] + 1u);
+                aV[i] = getNoise2(auX[i] + 1u, auY[i] + 1u);
+            }
+
+            __m128 low = smoothLerpSse2(_mm_load_ps(aS), _mm_load_ps(aT), xFrac);
+            __m128 high = smoothLerpSse2(_mm_load_ps(aU), _mm_load_ps(aV), xFrac);
+
+            return smoothLerpSse2(low, high, yFrac);
+        }
+
+        void samplePerlin2dSse2(_In_ const FLOAT* pX, _In_ const FLOAT* pY, _In_ FLOAT frequency, _In_ UINT uDepth, _In_ FLOAT div, _Out_ FLOAT* pResults)
+        {
+            __m128 xa = _mm_mul_ps(_mm_loadu_ps(pX), _mm_set1_ps(frequency));
+            __m128 ya = _mm_mul_ps(_mm_loadu_ps(pY), _mm_set1_ps(frequency));
+            FLOAT amp = 1.0f;
+            __m128 fin = _mm_setzero_ps();
+
+            for (UINT i = 0; i < uDepth; ++i)
+            {
+                fin = _mm_add_ps(fin, _mm_mul_ps(getNoise2dSse2(xa, ya), _mm_set1_ps(amp)));
+                amp /= 2.0f;
+                xa = _mm_mul_ps(xa, _mm_set1_ps(2.0f));
+                ya = _mm_mul_ps(ya, _mm_set1_ps(2.0f));
+            }
+
+            _mm_storeu_ps(pResults, _mm_div_ps(fin, _mm_set1_ps(div)));
+        }
+
+        __m128 getNoise3dSse2(_In_ __m128 x, _In_ __m128 y, _In_ __m128 z)
+        {
+            __m128i nX = _mm_cvttps_epi32(x);
+            __m128i nY = _mm_cvttps_epi32(y);
+            __m128i nZ = _mm_cvttps_epi32(z);
+            __m128 xFrac = _mm_sub_ps(x, _mm_cvtepi32_ps(nX));
+            __m128 yFrac = _mm_sub_ps(y, _mm_cvtepi32_ps(nY));
+            __m128 zFrac = _mm_sub_ps(z, _mm_cvtepi32_ps(nZ));
+
+            alignas(16) UINT auX[4];
+            alignas(16) UINT auY[4];
+            alignas(16) UINT auZ[4];
+            _mm_store_si128(reinterpret_cast<__m128i*>(auX), nX);
+            _mm_store_si128(reinterpret_cast<__m128i*>(auY), nY);
+            _mm_store_si128(reinterpret_cast<__m128i*>(auZ), nZ);
+
+            __m128 aPlanes[2];
+            for (UINT uPlane = 0u; uPlane < 2u; ++uPlane)
+            {
+                alignas(16) FLOAT aS[4];
+                alignas(16) FLOAT aT[4];
+                alignas(16) FLOAT aU[4];
+                alignas(16) FLOAT aV[4];
+                for (UINT i = 0u; i < 4u; ++i)
+                {
+                    aS[i] = getNoise3(auX[i], auY[i], auZ[i] + uPlane);
+                    aT[i] = getNoise3(auX[i] + 1u, auY[i], auZ[i] + uPlane);
+                    aU[i] = getNoise3(auX[i], auY[i] + 1u, auZ[i] + uPlane);
+                    aV[i] = getNoise3(auX[i] + 1u, auY[i] + 1u, auZ[i] + uPlane);
+                }
+
+                __m128 low = smoothLerpSse2(_mm_load_ps(aS), _mm_load_ps(aT), xFrac);
+                __m128 high = smoothLerpSse2(_mm_load_ps(aU), _mm_load_ps(aV), xFrac);
+                aPlanes[uPlane] = smoothLerpSse2(low, high, yFrac);
+            }
+
+            return smoothLerpSse2(aPlanes[0], aPlanes[1], zFrac);
+        }
+
+        void samplePerlin3dSse2(_In_ const FLOAT* pX, _In_ const FLOAT* pY, _In_ const FLOAT* pZ, _In_ FLOAT frequency, _In_ UINT uDepth, _In_ FLOAT div, _Out_ FLOAT* pResults)
+        {
+            __m128 xa = _mm_mul_ps(_mm_loadu_ps(pX), _mm_set1_ps(frequency));
+            __m128 ya = _mm_mul_ps(_mm_loadu_ps(pY), _mm_set1_ps(frequency));
+            __m128 za = _mm_mul_ps(_mm_loadu_ps(pZ), _mm_set1_ps(frequency));
+            FLOAT amp = 1.0f;
+            __m128 fin = _mm_setzero_ps();
+
+            for (UINT i = 0; i < uDepth; ++i)
+            {
+                fin = _mm_add_ps(fin, _mm_mul_ps(getNoise3dSse2(xa, ya, za), _mm_set1_ps(amp)));
+                amp /= 2.0f;
+                xa = _mm_mul_ps(xa, _mm_set1_ps(2.0f));
+                ya = _mm_mul_ps(ya, _mm_set1_ps(2.0f));
+                za = _mm_mul_ps(za, _mm_set1_ps(2.0f));
+            }
+
+            _mm_storeu_ps(pResults, _mm_div_ps(fin, _mm_set1_ps(div)));
+        }
+
+        NOISE_TARGET_AVX2 __m256 smoothLerpAvx2(_In_ __m256 x, _In_ __m256 y, _In_ __m256 s)
+        {
+            __m256 weight = _mm256_mul_ps(_mm256_mul_ps(s, s), _mm256_sub_ps(_mm256_set1_ps(3.0f), _mm256_mul_ps(_mm256_set1_ps(2.0f), s)));
+            return _mm256_add_ps(x, _mm256_mul_ps(weight, _mm256_sub_ps(y, x)));
+        }
+
+        NOISE_TARGET_AVX2 __m256 getNoise2Avx2(_In_ __m256i row, _In_ __m256i nX)
+        {
+            const __m256i mask = _mm256_set1_epi32(255);
+            __m256i hash = _mm256_i32gather_epi32(reinterpret_cast<const INT*>(HASHES), _mm256_and_si256(_mm256_add_epi32(row, nX), mask), 4);
+            return _mm256_cvtepi32_ps(hash);
+        }
+
+        NOISE_TARGET_AVX2 __m256 getNoise2dAvx2(_In_ __m256 x, _In_ __m256 y)
+        {
+            const __m256i mask = _mm256_set1_epi32(255);
+            const __m256i one = _mm256_set1_epi32(1);
+
+            __m256i nX = _mm256_cvttps_epi32(x);
+            __m256i nY = _mm256_cvttps_epi32(y);
+            __m256 xFrac = _mm256_sub_ps(x, _mm256_cvtepi32_ps(nX));
+            __m256 yFrac = _mm256_sub_ps(y, _mm256_cvtepi32_ps(nY));
+
+            __m256i row = _mm256_i32gather_epi32(reinterpret_cast<const INT*>(HASHES), _mm256_and_si256(nY, mask), 4);
+            __m256i nextRow = _mm256_i32gather_epi32(reinterpret_cast<const INT*>(HASHES), _mm256_and_si256(_mm256_add_epi32(nY, one), mask), 4);
+            __m256i nextX = _mm256_add_epi32(nX, one);
+
+            __m256 low = smoothLerpAvx2(getNoise2Avx2(row, nX), getNoise2Avx2(row, nextX), xFrac);
+            __m256 high = smoothLerpAvx2(getNoise2Avx2(nextRow, nX), getNoise2Avx2(nextRow, nextX), xFrac);
+
+            return smoothLerpAvx2(low, high, yFrac);
+        }
+
+        NOISE_TARGET_AVX2 void samplePerlin2dAvx2(_In_ const FLOAT* pX, _In_ const FLOAT* pY, _In_ FLOAT frequency, _In_ UINT uDepth, _In_ FLOAT div, _Out_ FLOAT* pResults)
+        {
+            __m256 xa = _mm256_mul_ps(_mm256_loadu_ps(pX), _mm256_set1_ps(frequency));
+            __m256 ya = _mm256_mul_ps(_mm256_loadu_ps(pY), _mm256_set1_ps(frequency));
+            FLOAT amp = 1.0f;
+            __m256 fin = _mm256_setzero_ps();
+
+            for (UINT i = 0; i < uDepth; ++i)
+            {
+                fin = _mm256_add_ps(fin, _mm256_mul_ps(getNoise2dAvx2(xa, ya), _mm256_set1_ps(amp)));
+                amp /= 2.0f;
+                xa = _mm256_mul_ps(xa, _mm256_set1_ps(2.0f));
+                ya = _mm256_mul_ps(ya, _mm256_set1_ps(2.0f));
+            }
+
+            _mm256_storeu_ps(pResults, _mm256_div_ps(fin, _mm256_set1_ps(div)));
+        }
+
+        NOISE_TARGET_AVX2 __m256 getNoise3dAvx2(_In_ __m256 x, _In_ __m256 y, _In_ __m256 z)
+        {
+            const __m256i mask = _mm256_set1_epi32(255);
+            const __m256i one = _mm256_set1_epi32(1);
+
+            __m256i nX = _mm256_cvttps_epi32(x);
+            __m256i nY = _mm256_cvttps_epi32(y);
+            __m256i nZ = _mm256_cvttps_epi32(z);
+            __m256 xFrac = _mm256_sub_ps(x, _mm256_cvtepi32_ps(nX));
+            __m256 yFrac = _mm256_sub_ps(y, _mm256_cvtepi32_ps(nY));
+            __m256 zFrac = _mm256_sub_ps(z, _mm256_cvtepi32_ps(nZ));
+            __m256i nextX = _mm256_add_epi32(nX, one);
+
+            __m256 aPlanes[2];
+            for (INT nPlane = 0; nPlane < 2; ++nPlane)
+            {
+                // The hash of the plane offsets the rows, as the plane
+                // and the row offset the column in two dimensions
+                __m256i plane = _mm256_i32gather_epi32(reinterpret_cast<const INT*>(HASHES), _mm256_and_si256(_mm256_add_epi32(nZ, _mm256_set1_epi32(nPlane)), mask), 4);
+                __m256i row = _mm256_i32gather_epi32(reinterpret_cast<const INT*>(HASHES), _mm256_and_si256(_mm256_add_epi32(plane, nY), mask), 4);
+                __m256i nextRow = _mm256_i32gather_epi32(reinterpret_cast<const INT*>(HASHES), _mm256_and_si256(_mm256_add_epi32(_mm256_add_epi32(plane, nY), one), mask), 4);
+
+                __m256 low = smoothLerpAvx2(getNoise2Avx2(row, nX), getNoise2Avx2(row, nextX), xFrac);
+                __m256 high = smoothLerpAvx2(getNoise2Avx2(nextRow, nX), getNoise2Avx2(nextRow, nextX), xFrac);
+                aPlanes[nPlane] = smoothLerpAvx2(low, high, yFrac);
+            }
+
+            return smoothLerpAvx2(aPlanes[0], aPlanes[1], zFrac);
+        }
+
+        NOISE_TARGET_AVX2 void samplePerlin3dAvx2(_In_ const FLOAT* pX, _In_ const FLOAT* pY, _In_ const FLOAT* pZ, _In_ FLOAT frequency, _In_ UINT uDepth, _In_ FLOAT div, _Out_ FLOAT* pResults)
+        {
+            __m256 xa = _mm256_mul_ps(_mm256_loadu_ps(pX), _mm256_set1_ps(frequency));
+            __m256 ya = _mm256_mul_ps(_mm256_loadu_ps(pY), _mm256_set1_ps(frequency));
+            __m256 za = _mm256_mul_ps(_mm256_loadu_ps(pZ), _mm256_set1_ps(frequency));
+            FLOAT amp = 1.0f;
+            __m256 fin = _mm256_setzero_ps();
+
+            for (UINT i = 0; i < uDepth; ++i)
+            {
+                fin = _mm256_add_ps(fin, _mm256_mul_ps(getNoise3dAvx2(xa, ya, za), _mm256_set1_ps(amp)));
+                amp /= 2.0f;
+                xa = _mm256_mul_ps(xa, _mm256_set1_ps(2.0f));
+                ya = _mm256_mul_ps(ya, _mm256_set1_ps(2.0f));
+                za = _mm256_mul_ps(za, _mm256_set1_ps(2.0f));
+            }
+
+            _mm256_storeu_ps(pResults, _mm256_div_ps(fin, _mm256_set1_ps(div)));
+        }
+#endif
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: GetMaxNoiseLanes
+
+      Summary:  Returns the widest batch sampling this processor runs
+
+      Returns:  eNoiseLanes
+                  AVX2 or SSE2 on x86, SCALAR elsewhere
+    -----------------------------------------------------------------F-F*/
+    eNoiseLanes GetMaxNoiseLanes()
+    {
+#if NOISE_X86
+        static const eNoiseLanes s_maxLanes = isAvx2Supported() ? eNoiseLanes::AVX2 : eNoiseLanes::SSE2;
+        return s_maxLanes;
+#else
+        return eNoiseLanes::SCALAR;
+#endif
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: SamplePerlin2d
+
+      Summary:  Samples uDepth octaves of value noise, each at twice the
+                frequency and half the weight of the one before
+
+      Args:     FLOAT x
+                FLOAT y
+                  Point to sample
+                FLOAT frequency
+                  Frequency of the first octave
+                UINT uDepth
+                  Number of octaves
+
+      Returns:  FLOAT
+                  Noise between 0 and 1
+    -----------------------------------------------------------------F-F*/
+    FLOAT SamplePerlin2d(_In_ FLOAT x, _In_ FLOAT y, _In_ FLOAT frequency, _In_ UINT uDepth)
+    {
+        FLOAT xa = x * frequency;
+        FLOAT ya = y * frequency;
+        FLOAT amp = 1.0f;
+        FLOAT fin = 0.0f;
+        FLOAT div = 0.0f;
+
+        for (UINT i = 0; i < uDepth; ++i)
+        {
+            div += 256.0f * amp;
+            fin += getNoise2d(xa, ya) * amp;
+            amp /= 2.0f;
+            xa *= 2.0f;
+            ya *= 2.0f;
+        }
+
+        return fin / div;
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: SamplePerlin2dBatch
+
+      Summary:  Samples the noise of SamplePerlin2d at arrays of points,
+                a vector of points at a time. Results are bit for bit
+                those of SamplePerlin2d for coordinates times frequency
+                times 2 ^ (uDepth - 1) below 2 ^ 31, where the vector
+                float to integer conversion agrees with the scalar one.
+                Lanes the processor does not support fall back to the
+                widest it does, and the points left over after the last
+                full vector are sampled one at a time
+
+      Args:     const FLOAT* pX
+                const FLOAT* pY
+                  Points to sample
+                UINT uCount
+                  Number of points
+                FLOAT frequency
+                  Frequency of the first octave
+                UINT uDepth
+                  Number of octaves
+                FLOAT* pResults
+                  Receives the noise of each point
+                eNoiseLanes lanes
+                  Points sampled per instruction
+    -----------------------------------------------------------------F-F*/
+    void SamplePerlin2dBatch(
+        _In_reads_(uCount) const FLOAT* pX,
+        _In_reads_(uCount) const FLOAT* pY,
+        _In_ UINT uCount,
+        _In_ FLOAT frequency,
+        _In_ UINT uDepth,
+        _Out_writes_(uCount) FLOAT* pResults,
+        _In_ eNoiseLanes lanes
+    )
+    {
+        lanes = static_cast<eNoiseLanes>(std::min(static_cast<UINT>(lanes), static_cast<UINT>(GetMaxNoiseLanes())));
+
+        UINT i = 0u;
+#if NOISE_X86
+        const FLOAT div = getOctaveDivisor(uDepth);
+        if (lanes == eNoiseLanes::AVX2)
+        {
+            for (; i + 8u <= uCount; i += 8u)
+            {
+                samplePerlin2dAvx2(pX + i, pY + i, frequency, uDepth, div, pResults + i);
+            }
+        }
+        else if (lanes == eNoiseLanes::SSE2)
+        {
+            for (; i + 4u <= uCount; i += 4u)
+            {
+                samplePerlin2dSse2(pX + i, pY + i, frequency, uDepth, div, pResults + i);
+            }
+        }
+#endif
+        for (; i < uCount; ++i)
+        {
+            pResults[i] = SamplePerlin2d(pX[i], pY[i], frequency, uDepth);
+        }
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: SamplePerlin3d
+
+      Summary:  Samples uDepth octaves of value noise in three
+                dimensions, the lattice hashed plane then row then
+                column with the table of SamplePerlin2d
+
+      Args:     FLOAT x
+                FLOAT y
+                FLOAT z
+                  Point to sample
+                FLOAT frequency
+                  Frequency of the first octave
+                UINT uDepth
+                  Number of octaves
+
+      Returns:  FLOAT
+                  Noise between 0 and 1
+    -----------------------------------------------------------------F-F*/
+    FLOAT SamplePerlin3d(_In_ FLOAT x, _In_ FLOAT y, _In_ FLOAT z, _In_ FLOAT frequency, _In_ UINT uDepth)
+    {
+        FLOAT xa = x * frequency;
+        FLOAT ya = y * frequency;
+        FLOAT za = z * frequency;
+        FLOAT amp = 1.0f;
+        FLOAT fin = 0.0f;
+        FLOAT div = 0.0f;
+
+        for (UINT i = 0; i < uDepth; ++i)
+        {
+            div += 256.0f * amp;
+            fin += getNoise3d(xa, ya, za) * amp;
+            amp /= 2.0f;
+            xa *= 2.0f;
+            ya *= 2.0f;
+            za *= 2.0f;
+        }
+
+        return fin / div;
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: SamplePerlin3dBatch
+
+      Summary:  Samples the noise of SamplePerlin3d at arrays of points
+                a vector at a time, bit for bit like SamplePerlin3d
+                under the same conditions as SamplePerlin2dBatch
+
+      Args:     const FLOAT* pX
+                const FLOAT* pY
+                const FLOAT* pZ
+                  Points to sample
+                UINT uCount
+                  Number of points
+                FLOAT frequency
+                  Frequency of the first octave
+                UINT uDepth
+                  Number of octaves
+                FLOAT* pResults
+                  Receives the noise of each point
+                eNoiseLanes lanes
+                  Points sampled per instruction
+    -----------------------------------------------------------------F-F*/
+    void SamplePerlin3dBatch(
+        _In_reads_(uCount) const FLOAT* pX,
+        _In_reads_(uCount) const FLOAT* pY,
+        _In_reads_(uCount) const FLOAT* pZ,
+        _In_ UINT uCount,
+        _In_ FLOAT frequency,
+        _In_ UINT uDepth,
+        _Out_writes_(uCount) FLOAT* pResults,
+        _In_ eNoiseLanes lanes
+    )
+    {
+        lanes = static_cast<eNoiseLanes>(std::min(static_cast<UINT>(lanes), static_cast<UINT>(GetMaxNoiseLanes())));
+
+        UINT i = 0u;
+#if NOISE_X86
+        const FLOAT div = getOctaveDivisor(uDepth);
+        if (lanes == eNoiseLanes::AVX2)
+        {
+            for (; i + 8u <= uCount; i += 8u)
+            {
+                samplePerlin3dAvx2(pX + i, pY + i, pZ + i, frequency, uDepth, div, pResults + i);
+            }
+        }
+        else if (lanes == eNoiseLanes::SSE2)
+        {
+            for (; i + 4u <= uCount; i += 4u)
+            {
+                samplePerlin3dSse2(pX + i, pY + i, pZ + i, frequency, uDepth, div, pResults + i);
+            }
+        }
+#endif
+        for (; i < uCount; ++i)
+        {
+            pResults[i] = SamplePerlin3d(pX[i], pY[i], pZ[i], frequency, uDepth);
+        }
+    }
+}
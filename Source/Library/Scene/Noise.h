@@ -0,0 +1,60 @@
+/*+===================================================================
+  File:      NOISE.H
+
+  Summary:   Noise header file contains declarations of the fractal
+             value noise the terrain is generated from, in two or three
+             dimensions, sampled one point at a time or for arrays of
+             points with SSE2 or AVX2.
+
+  Classes: eNoiseLanes
+
+  Functions: GetMaxNoiseLanes, SamplePerlin2d, SamplePerlin2dBatch,
+             SamplePerlin3d, SamplePerlin3dBatch
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+namespace library
+{
+    /*E+E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E
+      Enum:     eNoiseLanes
+
+      Summary:  Points a batch of noise is sampled at per instruction
+    E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E-E*/
+    enum class eNoiseLanes : UINT
+    {
+        SCALAR = 1u,
+        SSE2 = 4u,
+        AVX2 = 8u,
+    };
+
+    eNoiseLanes GetMaxNoiseLanes();
+
+    FLOAT SamplePerlin2d(_In_ FLOAT x, _In_ FLOAT y, _In_ FLOAT frequency, _In_ UINT uDepth);
+
+    void SamplePerlin2dBatch(
+        _In_reads_(uCount) const FLOAT* pX,
+        _In_reads_(uCount) const FLOAT* pY,
+        _In_ UINT uCount,
+        _In_ FLOAT frequency,
+        _In_ UINT uDepth,
+        _Out_writes_(uCount) FLOAT* pResults,
+        _In_ eNoiseLanes lanes
+    );
+
+    FLOAT SamplePerlin3d(_In_ FLOAT x, _In_ FLOAT y, _In_ FLOAT z, _In_ FLOAT frequency, _In_ UINT uDepth);
+
+    void SamplePerlin3dBatch(
+        _In_reads_(uCount) const FLOAT* pX,
+        _In_reads_(uCount) const FLOAT* pY,
+        _In_reads_(uCount) const FLOAT* pZ,
+        _In_ UINT uCount,
+        _In_ FLOAT frequency,
+        _In_ UINT uDepth,
+        _Out_writes_(uCount) FLOAT* pResults,
+        _In_ eNoiseLanes lanes
+    );
+}
@@ -2,29 +2,99 @@
 
 namespace library
 {
-
-    FLOAT Scene::GetPerlin2d(FLOAT x, FLOAT y, FLOAT frequency, UINT uDepth)
+    namespace
     {
-        FLOAT xa = x * frequency;
-        FLOAT ya = y * frequency;
-        FLOAT amp = 1.0f;
-        FLOAT fin = 0.0f;
-        FLOAT div = 0.0f;
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: removeChunks
+
+          Summary:  Removes streamed chunks from the voxels of a scene
 
-        for (UINT i = 0; i < uDepth; ++i)
+          Args:     std::vector<std::shared_ptr<Voxel>>& voxels
+                      Voxels of the scene
+                    const std::vector<std::shared_ptr<VoxelChunk>>& aChunks
+                      Chunks to remove
+        -----------------------------------------------------------------F-F*/
+        void removeChunks(_Inout_ std::vector<std::shared_ptr<Voxel>>& voxels, _In_ const std::vector<std::shared_ptr<VoxelChunk>>& aChunks)
         {
-            div += 256.0f * amp;
-            fin += getNoise2d(xa, ya) * amp;
-            amp /= 2.0f;
-            xa *= 2.0f;
-            ya *= 2.0f;
+            if (aChunks.empty())
+            {
+                return;
+            }
+
+            std::unordered_set<const Voxel*> chunks;
+            for (const std::shared_ptr<VoxelChunk>& chunk : aChunks)
+            {
+                chunks.insert(chunk.get());
+            }
+
+            std::erase_if(voxels, [&chunks](const std::shared_ptr<Voxel>& voxel)
+                {
+                    return chunks.contains(voxel.get());
+                }
+            );
         }
+    }
+
+    FLOAT Scene::GetPerlin2d(FLOAT x, FLOAT y, FLOAT frequency, UINT uDepth)
+    {
+        return SamplePerlin2d(x, y, frequency, uDepth);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::GetPerlin2dBatch
+
+      Summary:  Samples GetPerlin2d at arrays of points with the widest
+                vectors the processor supports, with the same results
+
+      Args:     const FLOAT* pX
+                const FLOAT* pY
+                  Points to sample
+                UINT uCount
+                  Number of points
+                FLOAT frequency
+                  Frequency of the first octave
+                UINT uDepth
+                  Number of octaves
+                FLOAT* pResults
+                  Receives the noise of each point
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Scene::GetPerlin2dBatch(_In_reads_(uCount) const FLOAT* pX, _In_reads_(uCount) const FLOAT* pY, _In_ UINT uCount, _In_ FLOAT frequency, _In_ UINT uDepth, _Out_writes_(uCount) FLOAT* pResults)
+    {
+        SamplePerlin2dBatch(pX, pY, uCount, frequency, uDepth, pResults, GetMaxNoiseLanes());
+    }
+
+    FLOAT Scene::GetPerlin3d(FLOAT x, FLOAT y, FLOAT z, FLOAT frequency, UINT uDepth)
+    {
+        return SamplePerlin3d(x, y, z, frequency, uDepth);
+    }
 
-        return fin / div;
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::GetPerlin3dBatch
+
+      Summary:  Samples GetPerlin3d at arrays of points with the widest
+                vectors the processor supports, with the same results
+
+      Args:     const FLOAT* pX
+                const FLOAT* pY
+                const FLOAT* pZ
+                  Points to sample
+                UINT uCount
+                  Number of points
+                FLOAT frequency
+                  Frequency of the first octave
+                UINT uDepth
+                  Number of octaves
+                FLOAT* pResults
+                  Receives the noise of each point
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Scene::GetPerlin3dBatch(_In_reads_(uCount) const FLOAT* pX, _In_reads_(uCount) const FLOAT* pY, _In_reads_(uCount) const FLOAT* pZ, _In_ UINT uCount, _In_ FLOAT frequency, _In_ UINT uDepth, _Out_writes_(uCount) FLOAT* pResults)
+    {
+        SamplePerlin3dBatch(pX, pY, pZ, uCount, frequency, uDepth, pResults, GetMaxNoiseLanes());
     }
 
     Scene::Scene(const std::filesystem::path& filePath)
         : m_filePath(filePath)
+        , m_fileName(filePath.wstring())
         , m_voxels()
         , m_renderables()
         , m_models()
@@ -33,128 +103,103 @@ namespace library
         , m_pixelShaders()
         , m_materials()
         , m_skyBox()
+        , m_heightfield()
+        , m_voxelStore()
+        , m_voxelStoreMutex()
+        , m_voxelOccupancy()
+        , m_voxelStreamer()
+        , m_voxelVertexShader()
+        , m_voxelPixelShader()
+        , m_voxelMaterial()
     {
-        std::ifstream inputFile;
-        inputFile.open(m_filePath.string());
-
-        std::string trash;
-        UINT aDimension[4] = { 0u, };
-        UINT uDimensionIdx = 0u;
-        while (!inputFile.eof() && uDimensionIdx < ARRAYSIZE(aDimension))
+        // A binary height map is used in place from the mapping, a text
+        // one is parsed out of it. A file that cannot be opened leaves
+        // the scene empty
+        MappedFile mappedFile;
+        HeightMap parsedHeightMap;
+        HeightMapView heightMap = {};
+        if (SUCCEEDED(mappedFile.Open(m_filePath)))
         {
-            inputFile >> aDimension[uDimensionIdx];
-
-            if (inputFile.fail())
+            if (IsBinaryHeightMap(mappedFile.GetData(), mappedFile.GetSize()))
             {
-                if (inputFile.eof())
+                if (FAILED(MapBinaryHeightMap(mappedFile.GetData(), mappedFile.GetSize(), heightMap)))
                 {
-                    break;
+                    OutputDebugString(L"Scene: corrupt binary height map\n");
                 }
-                inputFile.clear();
-                inputFile >> trash;
             }
             else
             {
-                ++uDimensionIdx;
+                ParseTextHeightMap(reinterpret_cast<const CHAR*>(mappedFile.GetData()), mappedFile.GetSize(), parsedHeightMap);
+                heightMap = ViewHeightMap(parsedHeightMap);
             }
         }
 
-        UINT uColorIdx = 0u;
-        XMFLOAT4 color;
-        while (!inputFile.eof() && uColorIdx < aDimension[3])
-        {
-            inputFile >> color.x >> color.y >> color.z;
-
-            if (inputFile.fail())
-            {
-                if (inputFile.eof())
-                {
-                    break;
-                }
-                inputFile.clear();
-                inputFile >> trash;
-            }
-            else
-            {
-                color.w = 1.0f;
-                m_voxels.push_back(std::make_shared<Voxel>(color));
-                ++uColorIdx;
-            }
-        }
+        loadHeightMap(heightMap);
+    }
 
-        std::vector<std::vector<InstanceData>> aInstanceData;
-        aInstanceData.reserve(m_voxels.size());
-        for (UINT renderableIdx = 0u; renderableIdx < m_voxels.size(); ++renderableIdx)
-        {
-            aInstanceData.push_back(std::vector<InstanceData>());
-            aInstanceData.back().reserve(
-                static_cast<size_t>(aDimension[0]) * static_cast<size_t>(aDimension[1]) * static_cast<size_t>(aDimension[2])
-            );
-        }
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::Scene
 
-        UINT uDepthIdx = 0u;
-        UINT uWidthIdx = 0u;
-        CHAR voxelType;
-        FLOAT height;
-        while (!inputFile.eof())
-        {
-            inputFile >> voxelType >> height;
+      Summary:  Constructor, builds the scene from a height map already
+                in memory, such as a generated one
 
-            if (inputFile.fail())
-            {
-                if (inputFile.eof())
-                {
-                    break;
-                }
-                inputFile.clear();
-                inputFile >> trash;
-            }
-            else if (static_cast<CHAR>(eBlockType::GRASSLAND) <= voxelType && voxelType < static_cast<CHAR>(eBlockType::COUNT))
-            {
-                for (UINT heightIdx = 0; heightIdx < static_cast<UINT>(static_cast<float>(aDimension[1]) * height); ++heightIdx)
-                {
-                    aInstanceData[static_cast<size_t>(voxelType) - static_cast<size_t>(eBlockType::GRASSLAND)].push_back(
-                        InstanceData
-                        {
-                            .Transformation = XMMatrixTranslation(
-                                2.0f * (static_cast<FLOAT>(uWidthIdx) - static_cast<FLOAT>(aDimension[0]) / 2.0f),
-                                2.0f * (static_cast<FLOAT>(heightIdx) - static_cast<FLOAT>(aDimension[1])) + (static_cast<FLOAT>(aDimension[1]) * 0.75f),
-                                2.0f * (static_cast<FLOAT>(uDepthIdx) - static_cast<FLOAT>(aDimension[2]) / 2.0f)
-                                )
-                        }
-                    );
-                }
-                ++uWidthIdx;
-                if (uWidthIdx >= aDimension[0])
-                {
-                    uWidthIdx -= aDimension[0];
-                    ++uDepthIdx;
+      Args:     const HeightMap& heightMap
+                  Height map of the voxels
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    Scene::Scene(_In_ const HeightMap& heightMap)
+        : m_filePath()
+        , m_fileName()
+        , m_voxels()
+        , m_renderables()
+        , m_models()
+        , m_aPointLights{ nullptr }
+        , m_vertexShaders()
+        , m_pixelShaders()
+        , m_materials()
+        , m_skyBox()
+        , m_heightfield()
+        , m_voxelStore()
+        , m_voxelStoreMutex()
+        , m_voxelOccupancy()
+        , m_voxelStreamer()
+        , m_voxelVertexShader()
+        , m_voxelPixelShader()
+        , m_voxelMaterial()
+    {
+        loadHeightMap(ViewHeightMap(heightMap));
+    }
 
-                    if (uDepthIdx >= aDimension[2])
-                    {
-                        uDepthIdx -= aDimension[2];
-                    }
-                }
-            }
-        }
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::Scene
 
-        inputFile.close();
+      Summary:  Constructor, builds the scene from blocks already in a
+                store, such as terrain generated from a density field
+                with caves and overhangs no height map can hold
 
-        UINT uVoxelIdx = 0u;
-        auto it = m_voxels.begin();
-        while (it != m_voxels.end())
-        {
-            if (aInstanceData[uVoxelIdx].size() <= 0)
-            {
-                it = m_voxels.erase(it);
-            }
-            else
-            {
-                (*it)->SetInstanceData(std::move(aInstanceData[uVoxelIdx]));
-                ++it;
-            }
-            ++uVoxelIdx;
-        }
+      Args:     std::unique_ptr<VoxelColumnStore> voxelStore
+                  Store of the voxels, which the scene takes over
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    Scene::Scene(_In_ std::unique_ptr<VoxelColumnStore> voxelStore)
+        : m_filePath()
+        , m_fileName()
+        , m_voxels()
+        , m_renderables()
+        , m_models()
+        , m_aPointLights{ nullptr }
+        , m_vertexShaders()
+        , m_pixelShaders()
+        , m_materials()
+        , m_skyBox()
+        , m_heightfield()
+        , m_voxelStore(std::move(voxelStore))
+        , m_voxelStoreMutex()
+        , m_voxelOccupancy()
+        , m_voxelStreamer()
+        , m_voxelVertexShader()
+        , m_voxelPixelShader()
+        , m_voxelMaterial()
+    {
+        loadVoxelStore();
     }
 
     HRESULT Scene::Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext)
@@ -230,6 +275,244 @@ namespace library
         return S_OK;
     }
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::StreamVoxels
+
+      Summary:  Moves the resident voxel chunks along with the camera.
+                Chunks that finished loading get the voxel shaders and
+                material and their buffers, and join the voxels; the
+                released ones leave the voxels, which frees their
+                buffers once the last frame drawing them is done. A
+                chunk whose buffers cannot be created does not stop
+                the others; its column is released with all of its
+                chunks and requested again by a later call
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the buffers
+                ID3D11DeviceContext* pImmediateContext
+                  The Direct3D context to set buffers
+                const XMFLOAT3& cameraPosition
+                  World position of the camera
+                BOOL bWait
+                  Whether to block until the chunks around the camera
+                  are all loaded
+
+      Modifies: [m_voxels].
+
+      Returns:  HRESULT
+                  Status code of the last chunk that failed, S_OK if
+                  none did
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Scene::StreamVoxels(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext, _In_ const XMFLOAT3& cameraPosition, _In_ BOOL bWait)
+    {
+        if (!m_voxelStreamer)
+        {
+            return S_OK;
+        }
+
+        std::vector<std::shared_ptr<VoxelChunk>> aLoadedChunks;
+        std::vector<std::shared_ptr<VoxelChunk>> aUnloadedChunks;
+        m_voxelStreamer->Update(cameraPosition, bWait, aLoadedChunks, aUnloadedChunks);
+
+        removeChunks(m_voxels, aUnloadedChunks);
+
+        HRESULT hrResult = S_OK;
+        std::vector<std::shared_ptr<VoxelChunk>> aFailedChunks;
+        for (std::shared_ptr<VoxelChunk>& chunk : aLoadedChunks)
+        {
+            if (m_voxelVertexShader)
+            {
+                chunk->SetVertexShader(m_voxelVertexShader);
+            }
+            if (m_voxelPixelShader)
+            {
+                chunk->SetPixelShader(m_voxelPixelShader);
+            }
+            if (m_voxelMaterial)
+            {
+                chunk->AddMaterial(m_voxelMaterial);
+            }
+
+            HRESULT hr = chunk->Initialize(pDevice, pImmediateContext);
+            if (FAILED(hr))
+            {
+                hrResult = hr;
+                aFailedChunks.push_back(chunk);
+                continue;
+            }
+
+            m_voxels.push_back(std::move(chunk));
+        }
+
+        if (!aFailedChunks.empty())
+        {
+            m_voxelStreamer->ReleaseColumnsOfChunks(aFailedChunks, aUnloadedChunks);
+            removeChunks(m_voxels, aUnloadedChunks);
+        }
+
+        return hrResult;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::CullOccludedVoxels
+
+      Summary:  Hides the streamed chunks the camera cannot see through
+                the open cells of the world, so they issue no draw this
+                frame
+
+      Args:     const XMFLOAT3& cameraPosition
+                  World position of the camera
+                const FrustumCuller& frustum
+                  Culler holding the planes of the camera frustum
+
+      Returns:  UINT
+                  Number of chunks hidden, 0 if the scene streams no
+                  chunks
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT Scene::CullOccludedVoxels(_In_ const XMFLOAT3& cameraPosition, _In_ const FrustumCuller& frustum)
+    {
+        if (!m_voxelStreamer)
+        {
+            return 0u;
+        }
+
+        return m_voxelStreamer->CullOccludedChunks(cameraPosition, frustum);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::SetBlock
+
+      Summary:  Puts a block in a cell of the voxel grid. The chunks
+                that read the cell are remeshed by the next
+                StreamVoxels, nothing else is rebuilt
+
+      Args:     INT nX
+                INT nY
+                INT nZ
+                  Cell of the voxel grid
+                eBlockType blockType
+                  Block to put in the cell
+
+      Returns:  HRESULT
+                  Status code, E_INVALIDARG outside the grid
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Scene::SetBlock(_In_ INT nX, _In_ INT nY, _In_ INT nZ, _In_ eBlockType blockType)
+    {
+        return editBlock(nX, nY, nZ, static_cast<BYTE>(blockType));
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::ClearBlock
+
+      Summary:  Empties a cell of the voxel grid. The chunks that read
+                the cell are remeshed by the next StreamVoxels
+
+      Args:     INT nX
+                INT nY
+                INT nZ
+                  Cell of the voxel grid
+
+      Returns:  HRESULT
+                  Status code, E_INVALIDARG outside the grid
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Scene::ClearBlock(_In_ INT nX, _In_ INT nY, _In_ INT nZ)
+    {
+        return editBlock(nX, nY, nZ, EMPTY_BLOCK);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::SaveVoxelRegions
+
+      Summary:  Saves the blocks of the scene, edits included, as region
+                files. ReadVoxelRegions loads them back into a store a
+                scene can be built from
+
+      Args:     const std::filesystem::path& directoryPath
+                  Directory to write the regions to
+                ThreadPool* pThreadPool
+                  Pool to code the chunk columns on, or nullptr to
+                  code them on the calling thread
+
+      Returns:  HRESULT
+                  Status code, E_FAIL if the scene has no voxel store
+                  or a file cannot be written
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Scene::SaveVoxelRegions(_In_ const std::filesystem::path& directoryPath, _In_opt_ ThreadPool* pThreadPool)
+    {
+        if (!m_voxelStore)
+        {
+            return E_FAIL;
+        }
+
+        std::shared_lock<std::shared_mutex> lock(m_voxelStoreMutex);
+        return WriteVoxelRegions(directoryPath, *m_voxelStore, pThreadPool);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::RaycastVoxels
+
+      Summary:  Finds the first block along a ray, for picking and
+                line of sight
+
+      Args:     const VoxelRay& ray
+                  Ray in world space
+                VoxelRayHit& hit
+                  Set to the block that was hit, its cell, the face
+                  the ray entered through and the distance to it
+
+      Returns:  BOOL
+                  TRUE if a block is within the distance of the ray
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL Scene::RaycastVoxels(_In_ const VoxelRay& ray, _Out_ VoxelRayHit& hit) const
+    {
+        if (!m_voxelOccupancy)
+        {
+            hit = VoxelRayHit{ .bHit = FALSE, .Block = EMPTY_BLOCK, .anCell = { 0, 0, 0 }, .anNormal = { 0, 0, 0 }, .Distance = 0.0f };
+            return FALSE;
+        }
+
+        if (m_voxelOccupancy->Raycast(ray, hit))
+        {
+            hit.Block = m_voxelStore->GetBlock(hit.anCell[0], hit.anCell[1], hit.anCell[2]);
+        }
+
+        return hit.bHit;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::RaycastVoxelsBatch
+
+      Summary:  Casts many rays across a thread pool. No block may be
+                edited until it returns
+
+      Args:     const VoxelRay* pRays
+                  Rays in world space
+                UINT uCount
+                  Number of rays
+                VoxelRayHit* pHits
+                  Set to the hit of each ray
+                ThreadPool* pThreadPool
+                  Pool to split the rays across, or nullptr to cast
+                  them on the calling thread
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Scene::RaycastVoxelsBatch(_In_reads_(uCount) const VoxelRay* pRays, _In_ UINT uCount, _Out_writes_(uCount) VoxelRayHit* pHits, _In_opt_ ThreadPool* pThreadPool) const
+    {
+        if (!m_voxelOccupancy)
+        {
+            std::fill(pHits, pHits + uCount, VoxelRayHit{ .bHit = FALSE, .Block = EMPTY_BLOCK, .anCell = { 0, 0, 0 }, .anNormal = { 0, 0, 0 }, .Distance = 0.0f });
+            return;
+        }
+
+        m_voxelOccupancy->RaycastBatch(pRays, uCount, pHits, pThreadPool);
+        for (UINT i = 0u; i < uCount; ++i)
+        {
+            if (pHits[i].bHit)
+            {
+                pHits[i].Block = m_voxelStore->GetBlock(pHits[i].anCell[0], pHits[i].anCell[1], pHits[i].anCell[2]);
+            }
+        }
+    }
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Scene::AddRenderable
 
@@ -336,6 +619,47 @@ namespace library
         return hr;
     }
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::AddHeightfield
+
+      Summary:  Adds the heightfield, which joins the voxels and takes
+                the voxel shaders and material like the chunks do. The
+                renderer selects its nodes for the camera every frame
+
+      Args:     const std::shared_ptr<HeightfieldTerrain>& heightfield
+                  Heightfield to draw
+
+      Modifies: [m_heightfield, m_voxels].
+
+      Returns:  HRESULT
+                  Status code, E_INVALIDARG for no heightfield
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Scene::AddHeightfield(_In_ const std::shared_ptr<HeightfieldTerrain>& heightfield)
+    {
+        if (heightfield == nullptr)
+        {
+            return E_INVALIDARG;
+        }
+
+        if (m_voxelVertexShader)
+        {
+            heightfield->SetVertexShader(m_voxelVertexShader);
+        }
+        if (m_voxelPixelShader)
+        {
+            heightfield->SetPixelShader(m_voxelPixelShader);
+        }
+        if (m_voxelMaterial)
+        {
+            heightfield->AddMaterial(m_voxelMaterial);
+        }
+
+        m_heightfield = heightfield;
+        m_voxels.push_back(heightfield);
+
+        return S_OK;
+    }
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Renderer::AddVertexShader
 
@@ -477,7 +801,49 @@ namespace library
 
     PCWSTR Scene::GetFileName() const
     {
-        return m_filePath.c_str();
+        return m_fileName.c_str();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::GetVoxelStreamer
+
+      Summary:  Returns the streamer of the voxel chunks, whose level
+                of detail statistics tell what each ring costs
+
+      Returns:  const VoxelChunkStreamer*
+                  Streamer, nullptr if the scene has no height map
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const VoxelChunkStreamer* Scene::GetVoxelStreamer() const
+    {
+        return m_voxelStreamer.get();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::GetVoxelStore
+
+      Summary:  Returns the run-length columns every block of the
+                scene is kept in, whose memory statistics tell what
+                the world costs
+
+      Returns:  const VoxelColumnStore*
+                  Store, nullptr if the scene has no height map
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const VoxelColumnStore* Scene::GetVoxelStore() const
+    {
+        return m_voxelStore.get();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::GetVoxelOccupancy
+
+      Summary:  Returns the occupancy bits rays are cast against
+
+      Returns:  const VoxelOccupancyGrid*
+                  Occupancy, nullptr if the scene has no height map
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const VoxelOccupancyGrid* Scene::GetVoxelOccupancy() const
+    {
+        return m_voxelOccupancy.get();
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -580,9 +946,10 @@ namespace library
             return E_FAIL;
         }
 
+        m_voxelVertexShader = m_vertexShaders[pszVertexShaderName];
         for (std::shared_ptr<Voxel>& voxel : m_voxels)
         {
-            voxel->SetVertexShader(m_vertexShaders[pszVertexShaderName]);
+            voxel->SetVertexShader(m_voxelVertexShader);
         }
 
         return S_OK;
@@ -610,9 +977,10 @@ namespace library
             return E_FAIL;
         }
 
+        m_voxelPixelShader = m_pixelShaders[pszPixelShaderName];
         for (std::shared_ptr<Voxel>& voxel : m_voxels)
         {
-            voxel->SetPixelShader(m_pixelShaders[pszPixelShaderName]);
+            voxel->SetPixelShader(m_voxelPixelShader);
         }
 
         return S_OK;
@@ -625,62 +993,187 @@ namespace library
             return E_FAIL;
         }
 
+        m_voxelMaterial = m_materials[pszMaterialName];
         for (std::shared_ptr<Voxel>& voxel : m_voxels)
         {
-            voxel->AddMaterial(m_materials[pszMaterialName]);
+            voxel->AddMaterial(m_voxelMaterial);
         }
 
         return S_OK;
     }
 
-    FLOAT Scene::getNoise2(UINT x, UINT y)
-    {
-        UINT temp = ms_aHashes[y % 256u];
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::GetSkyBox
 
-        return static_cast<FLOAT>(ms_aHashes[(temp + x) % 256u]);
-    }
+      Summary:  Returns a sky box
 
-    FLOAT Scene::getNoise2d(FLOAT x, FLOAT y)
-    {
-        UINT uX = static_cast<UINT>(x);
-        UINT uY = static_cast<UINT>(y);
-        FLOAT xFrac = x - static_cast<FLOAT>(uX);
-        FLOAT yFrac = y - static_cast<FLOAT>(uY);
+      Returns:  std::shared_ptr<Skybox>&
+                  Sky box
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    /*--------------------------------------------------------------------
+      TODO: Scene::GetSkyBox definition (remove the comment)
+    --------------------------------------------------------------------*/
+     std::shared_ptr<Skybox>& Scene::GetSkyBox()
+     {
+         return m_skyBox;
+     }
 
-        UINT s = static_cast<UINT>(getNoise2(uX, uY));
-        UINT t = static_cast<UINT>(getNoise2(uX + 1u, uY));
-        UINT u = static_cast<UINT>(getNoise2(uX, uY + 1u));
-        UINT v = static_cast<UINT>(getNoise2(uX + 1u, uY + 1u));
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::GetHeightfield
 
-        FLOAT low = smoothLerp(static_cast<FLOAT>(s), static_cast<FLOAT>(t), xFrac);
-        FLOAT high = smoothLerp(static_cast<FLOAT>(u), static_cast<FLOAT>(v), xFrac);
+      Summary:  Returns the heightfield
 
-        return smoothLerp(low, high, yFrac);
+      Returns:  std::shared_ptr<HeightfieldTerrain>&
+                  The heightfield, or nullptr if none was added
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    std::shared_ptr<HeightfieldTerrain>& Scene::GetHeightfield()
+    {
+        return m_heightfield;
     }
 
-    FLOAT Scene::lerp(FLOAT x, FLOAT y, FLOAT s)
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::editBlock
+
+      Summary:  Writes a cell of the voxel store while no column is
+                being read out of it, then marks the chunks that read
+                the cell. Writing the cell it already holds changes
+                nothing
+
+      Args:     INT nX
+                INT nY
+                INT nZ
+                  Cell of the voxel store
+                BYTE block
+                  EMPTY_BLOCK or an eBlockType value
+
+      Modifies: [m_voxelStore, m_voxelOccupancy, m_voxelStreamer].
+
+      Returns:  HRESULT
+                  Status code, E_INVALIDARG outside the grid
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Scene::editBlock(_In_ INT nX, _In_ INT nY, _In_ INT nZ, _In_ BYTE block)
     {
-        return x + s * (y - x);
+        if (!m_voxelStore
+            || nX < 0 || nY < 0 || nZ < 0
+            || static_cast<UINT>(nX) >= m_voxelStore->GetWidth() || static_cast<UINT>(nY) >= m_voxelStore->GetHeight() || static_cast<UINT>(nZ) >= m_voxelStore->GetDepth())
+        {
+            return E_INVALIDARG;
+        }
+
+        if (m_voxelStore->GetBlock(nX, nY, nZ) == block)
+        {
+            return S_OK;
+        }
+
+        {
+            std::unique_lock<std::shared_mutex> lock(m_voxelStoreMutex);
+            m_voxelStore->SetBlock(static_cast<UINT>(nX), static_cast<UINT>(nY), static_cast<UINT>(nZ), block);
+        }
+        m_voxelOccupancy->SetOccupied(static_cast<UINT>(nX), static_cast<UINT>(nY), static_cast<UINT>(nZ), block != EMPTY_BLOCK);
+        m_voxelStreamer->InvalidateCell(nX, nY, nZ);
+
+        return S_OK;
     }
 
-    FLOAT Scene::smoothLerp(FLOAT x, FLOAT y, FLOAT s)
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::loadHeightMap
+
+      Summary:  Turns the columns of a height map into the runs of the
+                voxel store and loads the store
+
+      Args:     const HeightMapView& heightMap
+                  Height map of the voxels
+
+      Modifies: [m_voxelStore].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Scene::loadHeightMap(_In_ const HeightMapView& heightMap)
     {
-        return lerp(x, y, s * s * (3.0f - 2.0f * s));
+        // Cell (x, y, z) is where the cube of height step y of column
+        // (x, z) used to be instanced
+        m_voxelStore = std::make_unique<VoxelColumnStore>(
+            heightMap.uWidth,
+            heightMap.uMaxColumnHeight,
+            heightMap.uDepth,
+            XMFLOAT3(
+                -static_cast<FLOAT>(heightMap.uWidth) - 1.0f,
+                -2.0f * static_cast<FLOAT>(heightMap.uHeight) + static_cast<FLOAT>(heightMap.uHeight) * 0.75f - 1.0f,
+                -static_cast<FLOAT>(heightMap.uDepth) - 1.0f
+            )
+        );
+
+        // A height map column is a single run, which always fits the
+        // slot of its column, so rows are set in parallel
+        ThreadPool threadPool;
+        threadPool.ParallelFor(heightMap.uDepth, [this, &heightMap](UINT z)
+        {
+            for (UINT x = 0u; x < heightMap.uWidth; ++x)
+            {
+                size_t columnIdx = static_cast<size_t>(z) * heightMap.uWidth + x;
+                UINT uColumnHeight = std::min(static_cast<UINT>(heightMap.pColumnHeights[columnIdx]), heightMap.uMaxColumnHeight);
+                if (uColumnHeight > 0u && heightMap.pColumnBlocks[columnIdx] != EMPTY_BLOCK)
+                {
+                    VoxelRun run = { .uEnd = static_cast<WORD>(uColumnHeight), .Block = heightMap.pColumnBlocks[columnIdx], .Reserved = 0u };
+                    m_voxelStore->SetColumn(x, z, &run, 1u);
+                }
+            }
+        });
+
+        loadVoxelStore();
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-      Method:   Scene::GetSkyBox
+      Method:   Scene::loadVoxelStore
 
-      Summary:  Returns a sky box
+      Summary:  Sets the occupancy bits rays are cast against from the
+                voxel store and starts streaming chunks out of it
 
-      Returns:  std::shared_ptr<Skybox>&
-                  Sky box
+      Modifies: [m_voxelOccupancy, m_voxelStreamer].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    /*--------------------------------------------------------------------
-      TODO: Scene::GetSkyBox definition (remove the comment)
-    --------------------------------------------------------------------*/
-     std::shared_ptr<Skybox>& Scene::GetSkyBox()
-     {
-         return m_skyBox;
-     }
-}
\ No newline at end of file
+    void Scene::loadVoxelStore()
+    {
+        ThreadPool threadPool;
+        m_voxelOccupancy = std::make_unique<VoxelOccupancyGrid>(
+            m_voxelStore->GetWidth(),
+            m_voxelStore->GetHeight(),
+            m_voxelStore->GetDepth(),
+            m_voxelStore->GetOrigin(),
+            m_voxelStore->GetCellSize()
+        );
+        m_voxelOccupancy->Build(*m_voxelStore, &threadPool);
+
+        // Chunks are meshed around the camera as it moves, expanding
+        // the runs of their columns while no edit is writing them
+        const VoxelColumnStore* pStore = m_voxelStore.get();
+        std::shared_mutex* pStoreMutex = &m_voxelStoreMutex;
+        m_voxelStreamer = std::make_unique<VoxelChunkStreamer>(
+            [pStore, pStoreMutex](INT nFirstX, INT nFirstZ, VoxelGrid& column)
+            {
+                std::shared_lock<std::shared_mutex> lock(*pStoreMutex);
+                for (UINT k = 0u; k < column.GetDepth(); ++k)
+                {
+                    for (UINT i = 0u; i < column.GetWidth(); ++i)
+                    {
+                        const VoxelRun* pRuns = nullptr;
+                        UINT uNumRuns = pStore->GetColumn(nFirstX + static_cast<INT>(i), nFirstZ + static_cast<INT>(k), &pRuns);
+
+                        UINT uStart = 0u;
+                        for (UINT r = 0u; r < uNumRuns; ++r)
+                        {
+                            UINT uEnd = std::min(static_cast<UINT>(pRuns[r].uEnd), column.GetHeight());
+                            if (pRuns[r].Block != EMPTY_BLOCK)
+                            {
+                                for (UINT y = uStart; y < uEnd; ++y)
+                                {
+                                    column.SetBlock(i, y, k, pRuns[r].Block);
+                                }
+                            }
+                            uStart = uEnd;
+                        }
+                    }
+                }
+            },
+            m_voxelStore->GetHeight(),
+            m_voxelStore->GetOrigin()
+        );
+    }
+}
@@ -14,11 +14,22 @@
 #include "Common.h"
 
 #include <fstream>
+#include <shared_mutex>
 
 #include "Model/Model.h"
 #include "Light/PointLight.h"
+#include "Platform/MappedFile.h"
 #include "Renderer/Renderable.h"
+#include "Scene/HeightfieldTerrain.h"
+#include "Scene/HeightMapFile.h"
+#include "Scene/Noise.h"
 #include "Scene/Voxel.h"
+#include "Scene/VoxelChunk.h"
+#include "Scene/VoxelChunkStreamer.h"
+#include "Scene/VoxelColumnStore.h"
+#include "Scene/VoxelGrid.h"
+#include "Scene/VoxelOccupancyGrid.h"
+#include "Scene/VoxelRegionFile.h"
 #include "Renderer/Skybox.h"
 
 
@@ -28,9 +39,14 @@ namespace library
     {
     public:
         static FLOAT GetPerlin2d(FLOAT x, FLOAT y, FLOAT frequency, UINT uDepth);
+        static void GetPerlin2dBatch(_In_reads_(uCount) const FLOAT* pX, _In_reads_(uCount) const FLOAT* pY, _In_ UINT uCount, _In_ FLOAT frequency, _In_ UINT uDepth, _Out_writes_(uCount) FLOAT* pResults);
+        static FLOAT GetPerlin3d(FLOAT x, FLOAT y, FLOAT z, FLOAT frequency, UINT uDepth);
+        static void GetPerlin3dBatch(_In_reads_(uCount) const FLOAT* pX, _In_reads_(uCount) const FLOAT* pY, _In_reads_(uCount) const FLOAT* pZ, _In_ UINT uCount, _In_ FLOAT frequency, _In_ UINT uDepth, _Out_writes_(uCount) FLOAT* pResults);
 
         Scene() = delete;
         Scene(const std::filesystem::path& filePath);
+        Scene(_In_ const HeightMap& heightMap);
+        Scene(_In_ std::unique_ptr<VoxelColumnStore> voxelStore);
         Scene(const Scene& other) = delete;
         Scene(Scene&& other) = delete;
         Scene& operator=(const Scene& other) = delete;
@@ -38,6 +54,13 @@ namespace library
         virtual ~Scene() = default;
 
         virtual HRESULT Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext);
+        HRESULT StreamVoxels(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext, _In_ const XMFLOAT3& cameraPosition, _In_ BOOL bWait);
+        UINT CullOccludedVoxels(_In_ const XMFLOAT3& cameraPosition, _In_ const FrustumCuller& frustum);
+        HRESULT SetBlock(_In_ INT nX, _In_ INT nY, _In_ INT nZ, _In_ eBlockType blockType);
+        HRESULT ClearBlock(_In_ INT nX, _In_ INT nY, _In_ INT nZ);
+        HRESULT SaveVoxelRegions(_In_ const std::filesystem::path& directoryPath, _In_opt_ ThreadPool* pThreadPool);
+        BOOL RaycastVoxels(_In_ const VoxelRay& ray, _Out_ VoxelRayHit& hit) const;
+        void RaycastVoxelsBatch(_In_reads_(uCount) const VoxelRay* pRays, _In_ UINT uCount, _Out_writes_(uCount) VoxelRayHit* pHits, _In_opt_ ThreadPool* pThreadPool) const;
 
         HRESULT AddVoxel(_In_ const std::shared_ptr<Voxel>& voxel);
         HRESULT AddRenderable(_In_ PCWSTR pszRenderableName, _In_ const std::shared_ptr<Renderable>& renderable);
@@ -47,6 +70,7 @@ namespace library
         HRESULT AddPixelShader(_In_ PCWSTR pszPixelShaderName, _In_ const std::shared_ptr<PixelShader>& pixelShader);
         HRESULT AddMaterial(_In_ const std::shared_ptr<Material>& material);
         HRESULT AddSkyBox(_In_ const std::shared_ptr<Skybox>& skybox);
+        HRESULT AddHeightfield(_In_ const std::shared_ptr<HeightfieldTerrain>& heightfield);
 
         void Update(_In_ FLOAT deltaTime);
 
@@ -58,10 +82,14 @@ namespace library
         std::unordered_map<std::wstring, std::shared_ptr<PixelShader>>& GetPixelShaders();
         std::unordered_map<std::wstring, std::shared_ptr<Material>>& GetMaterials();
         std::shared_ptr<Skybox>& GetSkyBox();
+        std::shared_ptr<HeightfieldTerrain>& GetHeightfield();
 
 
         const std::filesystem::path& GetFilePath() const;
         PCWSTR GetFileName() const;
+        const VoxelChunkStreamer* GetVoxelStreamer() const;
+        const VoxelColumnStore* GetVoxelStore() const;
+        const VoxelOccupancyGrid* GetVoxelOccupancy() const;
 
         HRESULT SetVertexShaderOfRenderable(_In_ PCWSTR pszRenderableName, _In_ PCWSTR pszVertexShaderName);
         HRESULT SetPixelShaderOfRenderable(_In_ PCWSTR pszRenderableName, _In_ PCWSTR pszPixelShaderName);
@@ -75,30 +103,13 @@ namespace library
 
 
     private:
-        static FLOAT getNoise2(UINT x, UINT y);
-        static FLOAT getNoise2d(FLOAT x, FLOAT y);
-        static FLOAT lerp(FLOAT x, FLOAT y, FLOAT s);
-        static FLOAT smoothLerp(FLOAT x, FLOAT y, FLOAT s);
-
-    private:
-        static constexpr const UINT ms_aHashes[] =
-        {
-            208,34,231,213,32,248,233,56,161,78,24,140,71,48,140,254,245,255,247,247,40,
-            185,248,251,245,28,124,204,204,76,36,1,107,28,234,163,202,224,245,128,167,204,
-            9,92,217,54,239,174,173,102,193,189,190,121,100,108,167,44,43,77,180,204,8,81,
-            70,223,11,38,24,254,210,210,177,32,81,195,243,125,8,169,112,32,97,53,195,13,
-            203,9,47,104,125,117,114,124,165,203,181,235,193,206,70,180,174,0,167,181,41,
-            164,30,116,127,198,245,146,87,224,149,206,57,4,192,210,65,210,129,240,178,105,
-            228,108,245,148,140,40,35,195,38,58,65,207,215,253,65,85,208,76,62,3,237,55,89,
-            232,50,217,64,244,157,199,121,252,90,17,212,203,149,152,140,187,234,177,73,174,
-            193,100,192,143,97,53,145,135,19,103,13,90,135,151,199,91,239,247,33,39,145,
-            101,120,99,3,186,86,99,41,237,203,111,79,220,135,158,42,30,154,120,67,87,167,
-            135,176,183,191,253,115,184,21,233,58,129,233,142,39,128,211,118,137,139,255,
-            114,20,218,113,154,27,127,246,250,1,8,198,250,209,92,222,173,21,88,102,219
-        };
+        void loadHeightMap(_In_ const HeightMapView& heightMap);
+        void loadVoxelStore();
+        HRESULT editBlock(_In_ INT nX, _In_ INT nY, _In_ INT nZ, _In_ BYTE block);
 
     private:
         std::filesystem::path m_filePath;
+        std::wstring m_fileName;
         std::vector<std::shared_ptr<Voxel>> m_voxels;
         std::unordered_map<std::wstring, std::shared_ptr<Renderable>> m_renderables;
         std::unordered_map<std::wstring, std::shared_ptr<Model>> m_models;
@@ -107,5 +118,13 @@ namespace library
         std::unordered_map<std::wstring, std::shared_ptr<PixelShader>> m_pixelShaders;
         std::unordered_map<std::wstring, std::shared_ptr<Material>> m_materials;
         std::shared_ptr<Skybox> m_skyBox;
+        std::shared_ptr<HeightfieldTerrain> m_heightfield;
+        std::unique_ptr<VoxelColumnStore> m_voxelStore;
+        std::shared_mutex m_voxelStoreMutex;
+        std::unique_ptr<VoxelOccupancyGrid> m_voxelOccupancy;
+        std::unique_ptr<VoxelChunkStreamer> m_voxelStreamer;
+        std::shared_ptr<VertexShader> m_voxelVertexShader;
+        std::shared_ptr<PixelShader> m_voxelPixelShader;
+        std::shared_ptr<Material> m_voxelMaterial;
     };
 }
\ No newline at end of file
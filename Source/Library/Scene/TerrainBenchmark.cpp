@@ -0,0 +1,708 @@
+#include "Scene/TerrainBenchmark.h"
+
+#include "Platform/Benchmark.h"
+#include "Platform/MappedFile.h"
+
+namespace library
+{
+    namespace
+    {
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: fillStoreFromHeightMap
+
+          Summary:  Sets every column of a store to the one run of its
+                    height map column, the way a scene loads a height
+                    map
+
+          Args:     const HeightMap& heightMap
+                      Height map to read
+                    VoxelColumnStore& store
+                      Empty store of the size of the height map
+        -----------------------------------------------------------------F-F*/
+        void fillStoreFromHeightMap(_In_ const HeightMap& heightMap, _Inout_ VoxelColumnStore& store)
+        {
+            for (UINT z = 0u; z < heightMap.uDepth; ++z)
+            {
+                for (UINT x = 0u; x < heightMap.uWidth; ++x)
+                {
+                    const size_t columnIdx = static_cast<size_t>(z) * heightMap.uWidth + x;
+                    const UINT uColumnHeight = std::min(static_cast<UINT>(heightMap.aColumnHeights[columnIdx]), heightMap.uHeight);
+                    if (uColumnHeight > 0u && heightMap.aColumnBlocks[columnIdx] != EMPTY_BLOCK)
+                    {
+                        const VoxelRun run = { .uEnd = static_cast<WORD>(uColumnHeight), .Block = heightMap.aColumnBlocks[columnIdx], .Reserved = 0u };
+                        store.SetColumn(x, z, &run, 1u);
+                    }
+                }
+            }
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: getDirectorySize
+
+          Summary:  Adds up the sizes of the files in a directory
+
+          Args:     const std::filesystem::path& directoryPath
+                      Directory to measure
+
+          Returns:  UINT64
+                      Bytes of its files
+        -----------------------------------------------------------------F-F*/
+        UINT64 getDirectorySize(_In_ const std::filesystem::path& directoryPath)
+        {
+            UINT64 uSize = 0u;
+            std::error_code error;
+            for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(directoryPath, error))
+            {
+                if (entry.is_regular_file())
+                {
+                    uSize += entry.file_size();
+                }
+            }
+
+            return uSize;
+        }
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: BenchmarkTerrainGenerator
+
+      Summary:  Generates a height map on 1, 2, 4... threads up to the
+                number of hardware threads and reports the columns
+                generated per second of each run to the debug output
+
+      Args:     UINT uWidth
+                UINT uDepth
+                  Columns of the generated map, 1024x1024 for the
+                  reference numbers
+                UINT uNumRuns
+                  Number of timed runs per thread count
+                std::vector<TerrainBenchmarkResult>& results
+                  Receives one result per thread count
+
+      Returns:  HRESULT
+                  Status code, E_INVALIDARG if the map is empty or no
+                  run is requested
+    -----------------------------------------------------------------F-F*/
+    HRESULT BenchmarkTerrainGenerator(_In_ UINT uWidth, _In_ UINT uDepth, _In_ UINT uNumRuns, _Out_ std::vector<TerrainBenchmarkResult>& results)
+    {
+        results.clear();
+
+        if (uWidth == 0u || uDepth == 0u || uNumRuns == 0u)
+        {
+            return E_INVALIDARG;
+        }
+
+        TerrainGenerator generator(uWidth, 64u, uDepth, 1u);
+
+        for (UINT uNumThreads : GetBenchmarkThreadCounts())
+        {
+            generator.SetNumThreads(uNumThreads);
+
+            const FLOAT seconds = TimeBenchmarkRuns(uNumRuns, [&generator]() { generator.Generate(); });
+
+            const FLOAT numCells = static_cast<FLOAT>(uWidth) * static_cast<FLOAT>(uDepth) * static_cast<FLOAT>(uNumRuns);
+            TerrainBenchmarkResult result =
+            {
+                .uNumThreads = generator.GetNumThreads(),
+                .uNumRuns = uNumRuns,
+                .CellsPerSecond = GetBenchmarkRate(numCells, seconds),
+                .MillisecondsPerRun = seconds * 1000.0f / static_cast<FLOAT>(uNumRuns)
+            };
+            results.push_back(result);
+
+            ReportBenchmark(
+                L"terrain generator  threads %2u  %12.0f cells/s  %8.2f ms/run  %ux%u\n",
+                result.uNumThreads,
+                result.CellsPerSecond,
+                result.MillisecondsPerRun,
+                uWidth,
+                uDepth
+            );
+        }
+
+        return S_OK;
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: BenchmarkNoise
+
+      Summary:  Samples four octaves of noise at a row of points with
+                each vector width the processor supports, scalar first,
+                and reports the samples per second of each to the debug
+                output
+
+      Args:     UINT uNumSamples
+                  Points sampled per run
+                UINT uNumRuns
+                  Number of timed runs per vector width
+                std::vector<NoiseBenchmarkResult>& results
+                  Receives one result per vector width
+
+      Returns:  HRESULT
+                  Status code, E_INVALIDARG if no sample is requested
+    -----------------------------------------------------------------F-F*/
+    HRESULT BenchmarkNoise(_In_ UINT uNumSamples, _In_ UINT uNumRuns, _Out_ std::vector<NoiseBenchmarkResult>& results)
+    {
+        results.clear();
+
+        if (uNumSamples == 0u || uNumRuns == 0u)
+        {
+            return E_INVALIDARG;
+        }
+
+        std::vector<FLOAT> aX(uNumSamples);
+        std::vector<FLOAT> aY(uNumSamples, 37.5f);
+        std::vector<FLOAT> aResults(uNumSamples);
+        for (UINT i = 0u; i < uNumSamples; ++i)
+        {
+            aX[i] = static_cast<FLOAT>(i) * 0.37f;
+        }
+
+        const eNoiseLanes aLanes[] = { eNoiseLanes::SCALAR, eNoiseLanes::SSE2, eNoiseLanes::AVX2 };
+        for (eNoiseLanes lanes : aLanes)
+        {
+            if (static_cast<UINT>(lanes) > static_cast<UINT>(GetMaxNoiseLanes()))
+            {
+                break;
+            }
+
+            const FLOAT seconds = TimeBenchmarkRuns(
+                uNumRuns,
+                [&aX, &aY, &aResults, uNumSamples, lanes]()
+                {
+                    SamplePerlin2dBatch(aX.data(), aY.data(), uNumSamples, 0.1f, 4u, aResults.data(), lanes);
+                }
+            );
+
+            const FLOAT numSamples = static_cast<FLOAT>(uNumSamples) * static_cast<FLOAT>(uNumRuns);
+            NoiseBenchmarkResult result =
+            {
+                .Lanes = lanes,
+                .uNumSamples = uNumSamples,
+                .SamplesPerSecond = GetBenchmarkRate(numSamples, seconds),
+                .NanosecondsPerSample = seconds * 1.0e9f / numSamples
+            };
+            results.push_back(result);
+
+            ReportBenchmark(
+                L"noise  lanes %u  %12.0f samples/s  %8.2f ns/sample\n",
+                static_cast<UINT>(result.Lanes),
+                result.SamplesPerSecond,
+                result.NanosecondsPerSample
+            );
+        }
+
+        return S_OK;
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: BenchmarkDensityTerrain
+
+      Summary:  Fills a voxel store from the density field on 1, 2,
+                4... threads up to the number of hardware threads and
+                reports the voxels generated per second of each run,
+                noise sampling and run encoding included, to the debug
+                output
+
+      Args:     UINT uWidth
+                UINT uHeight
+                UINT uDepth
+                  Cells of the generated world, 512x64x512 for the
+                  reference numbers
+                UINT uNumRuns
+                  Number of timed runs per thread count
+                std::vector<DensityBenchmarkResult>& results
+                  Receives one result per thread count
+
+      Returns:  HRESULT
+                  Status code, E_INVALIDARG if the world is empty or no
+                  run is requested
+    -----------------------------------------------------------------F-F*/
+    HRESULT BenchmarkDensityTerrain(_In_ UINT uWidth, _In_ UINT uHeight, _In_ UINT uDepth, _In_ UINT uNumRuns, _Out_ std::vector<DensityBenchmarkResult>& results)
+    {
+        results.clear();
+
+        if (uWidth == 0u || uHeight == 0u || uHeight > 0xFFFFu || uDepth == 0u || uNumRuns == 0u)
+        {
+            return E_INVALIDARG;
+        }
+
+        VoxelColumnStore store(uWidth, uHeight, uDepth, XMFLOAT3(0.0f, 0.0f, 0.0f));
+        DensityTerrainGenerator generator(1u);
+
+        for (UINT uNumThreads : GetBenchmarkThreadCounts())
+        {
+            generator.SetNumThreads(uNumThreads);
+
+            // The untimed run also grows the slots of the store
+            const FLOAT seconds = TimeBenchmarkRuns(uNumRuns, [&generator, &store]() { generator.Generate(store); });
+
+            const FLOAT numVoxels = static_cast<FLOAT>(uWidth) * static_cast<FLOAT>(uHeight) * static_cast<FLOAT>(uDepth) * static_cast<FLOAT>(uNumRuns);
+            DensityBenchmarkResult result =
+            {
+                .uNumThreads = generator.GetNumThreads(),
+                .uNumRuns = uNumRuns,
+                .VoxelsPerSecond = GetBenchmarkRate(numVoxels, seconds),
+                .MillisecondsPerRun = seconds * 1000.0f / static_cast<FLOAT>(uNumRuns)
+            };
+            results.push_back(result);
+
+            ReportBenchmark(
+                L"density terrain  threads %2u  %12.0f voxels/s  %8.2f ms/run  %ux%ux%u\n",
+                result.uNumThreads,
+                result.VoxelsPerSecond,
+                result.MillisecondsPerRun,
+                uWidth,
+                uHeight,
+                uDepth
+            );
+        }
+
+        return S_OK;
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: BenchmarkVoxelRaycasts
+
+      Summary:  Casts a batch of rays from above the grid down to
+                random cells on 1, 2, 4... threads up to the number of
+                hardware threads and reports the rays cast per second
+                of each to the debug output. Half of the rays come in
+                steep and half at a grazing angle, which crosses many
+                more cells before it hits
+
+      Args:     const VoxelOccupancyGrid& occupancy
+                  Grid to cast the rays against
+                UINT uNumRays
+                  Rays per batch
+                UINT uNumRuns
+                  Number of timed batches per thread count
+                std::vector<VoxelRaycastBenchmarkResult>& results
+                  Receives one result per thread count
+
+      Returns:  HRESULT
+                  Status code, E_INVALIDARG if the grid is empty or no
+                  ray is requested
+    -----------------------------------------------------------------F-F*/
+    HRESULT BenchmarkVoxelRaycasts(_In_ const VoxelOccupancyGrid& occupancy, _In_ UINT uNumRays, _In_ UINT uNumRuns, _Out_ std::vector<VoxelRaycastBenchmarkResult>& results)
+    {
+        results.clear();
+
+        if (occupancy.GetWidth() == 0u || occupancy.GetHeight() == 0u || occupancy.GetDepth() == 0u || uNumRays == 0u || uNumRuns == 0u)
+        {
+            return E_INVALIDARG;
+        }
+
+        const XMFLOAT3& origin = occupancy.GetOrigin();
+        const FLOAT cellSize = occupancy.GetCellSize();
+        const FLOAT aSize[3] =
+        {
+            static_cast<FLOAT>(occupancy.GetWidth()) * cellSize,
+            static_cast<FLOAT>(occupancy.GetHeight()) * cellSize,
+            static_cast<FLOAT>(occupancy.GetDepth()) * cellSize
+        };
+
+        // The same rays for every thread count
+        UINT uSeed = 12345u;
+        auto random = [&uSeed]()
+        {
+            uSeed = uSeed * 1664525u + 1013904223u;
+            return static_cast<FLOAT>(uSeed >> 8u) / 16777216.0f;
+        };
+
+        std::vector<VoxelRay> aRays(uNumRays);
+        for (UINT i = 0u; i < uNumRays; ++i)
+        {
+            const XMFLOAT3 target(origin.x + random() * aSize[0], origin.y, origin.z + random() * aSize[2]);
+            const FLOAT spread = (i % 2u == 0u ? 0.25f : 4.0f) * aSize[1];
+            const XMFLOAT3 start(target.x + (random() - 0.5f) * 2.0f * spread, origin.y + aSize[1], target.z + (random() - 0.5f) * 2.0f * spread);
+
+            aRays[i] = VoxelRay
+            {
+                .Origin = start,
+                .Direction = XMFLOAT3(target.x - start.x, target.y - start.y, target.z - start.z),
+                .MaxDistance = aSize[0] + aSize[1] + aSize[2]
+            };
+        }
+        std::vector<VoxelRayHit> aHits(uNumRays);
+
+        for (UINT uNumThreads : GetBenchmarkThreadCounts())
+        {
+            ThreadPool threadPool(uNumThreads);
+
+            const FLOAT seconds = TimeBenchmarkRuns(
+                uNumRuns,
+                [&occupancy, &aRays, &aHits, &threadPool, uNumRays]()
+                {
+                    occupancy.RaycastBatch(aRays.data(), uNumRays, aHits.data(), &threadPool);
+                }
+            );
+
+            const FLOAT numRays = static_cast<FLOAT>(uNumRays) * static_cast<FLOAT>(uNumRuns);
+            VoxelRaycastBenchmarkResult result =
+            {
+                .uNumThreads = threadPool.GetNumThreads(),
+                .uNumRays = uNumRays,
+                .uNumHits = static_cast<UINT>(std::count_if(aHits.begin(), aHits.end(), [](const VoxelRayHit& hit) { return hit.bHit; })),
+                .RaysPerSecond = GetBenchmarkRate(numRays, seconds),
+                .NanosecondsPerRay = seconds * 1.0e9f / numRays
+            };
+            results.push_back(result);
+
+            ReportBenchmark(
+                L"voxel raycasts  threads %2u  %12.0f rays/s  %8.1f ns/ray  hits %u/%u\n",
+                result.uNumThreads,
+                result.RaysPerSecond,
+                result.NanosecondsPerRay,
+                result.uNumHits,
+                result.uNumRays
+            );
+        }
+
+        return S_OK;
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: BenchmarkHeightfieldSelection
+
+      Summary:  Selects the nodes of a heightfield for a set of views
+                and builds their patches, timing the two stages apart,
+                and reports the average of each to the debug output.
+                The views look out from above the surface in every
+                direction, slightly down, with the projection of the
+                renderer, so most of them see far into the terrain
+
+      Args:     HeightfieldTerrain& heightfield
+                  Heightfield to select the nodes of
+                UINT uNumViews
+                  Number of views per run
+                UINT uNumRuns
+                  Number of timed runs over the views
+                HeightfieldBenchmarkResult& result
+                  Receives the averages
+
+      Returns:  HRESULT
+                  Status code, E_INVALIDARG if no view or no run is
+                  requested
+    -----------------------------------------------------------------F-F*/
+    HRESULT BenchmarkHeightfieldSelection(_In_ HeightfieldTerrain& heightfield, _In_ UINT uNumViews, _In_ UINT uNumRuns, _Out_ HeightfieldBenchmarkResult& result)
+    {
+        result = HeightfieldBenchmarkResult{ .uNumViews = uNumViews, .uNumRuns = uNumRuns };
+
+        if (uNumViews == 0u || uNumRuns == 0u)
+        {
+            return E_INVALIDARG;
+        }
+
+        // The same views every run
+        UINT uSeed = 12345u;
+        auto random = [&uSeed]()
+        {
+            uSeed = uSeed * 1664525u + 1013904223u;
+            return static_cast<FLOAT>(uSeed >> 8u) / 16777216.0f;
+        };
+
+        const BoundingVolume& bounds = heightfield.GetBounds();
+        const XMMATRIX projection = XMMatrixPerspectiveFovLH(XM_PIDIV4, 16.0f / 9.0f, 0.01f, 1000.0f);
+        std::vector<XMFLOAT3> aEyes(uNumViews);
+        std::vector<XMFLOAT4X4> aViewProjections(uNumViews);
+        for (UINT i = 0u; i < uNumViews; ++i)
+        {
+            const FLOAT x = bounds.Center.x + (random() - 0.5f) * 2.0f * bounds.Extents.x;
+            const FLOAT z = bounds.Center.z + (random() - 0.5f) * 2.0f * bounds.Extents.z;
+            const FLOAT yaw = random() * XM_2PI;
+            aEyes[i] = XMFLOAT3(x, bounds.Center.y + bounds.Extents.y + 4.0f + random() * 32.0f, z);
+
+            const XMVECTOR eye = XMLoadFloat3(&aEyes[i]);
+            const XMVECTOR direction = XMVectorSet(cosf(yaw), -0.3f, sinf(yaw), 0.0f);
+            XMStoreFloat4x4(&aViewProjections[i], XMMatrixLookToLH(eye, direction, XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f)) * projection);
+        }
+
+        // Warm up the caches before timing
+        FrustumCuller frustum;
+        frustum.SetFrustum(XMLoadFloat4x4(&aViewProjections[0]));
+        heightfield.SelectNodes(aEyes[0], frustum);
+        heightfield.BuildVertices();
+
+        FLOAT selectingSeconds = 0.0f;
+        FLOAT buildingSeconds = 0.0f;
+        UINT64 uNumNodes = 0u;
+        UINT64 uNumVertices = 0u;
+        for (UINT uRun = 0u; uRun < uNumRuns; ++uRun)
+        {
+            for (UINT i = 0u; i < uNumViews; ++i)
+            {
+                frustum.SetFrustum(XMLoadFloat4x4(&aViewProjections[i]));
+
+                selectingSeconds += TimeBenchmarkRun([&]() { uNumNodes += heightfield.SelectNodes(aEyes[i], frustum); });
+                buildingSeconds += TimeBenchmarkRun([&heightfield]() { heightfield.BuildVertices(); });
+                uNumVertices += heightfield.GetNumVertices();
+            }
+        }
+
+        const FLOAT numSelections = static_cast<FLOAT>(uNumViews) * static_cast<FLOAT>(uNumRuns);
+        result.NodesPerView = static_cast<FLOAT>(uNumNodes) / numSelections;
+        result.VerticesPerView = static_cast<FLOAT>(uNumVertices) / numSelections;
+        result.SelectionsPerSecond = GetBenchmarkRate(numSelections, selectingSeconds);
+        result.MicrosecondsPerSelection = selectingSeconds * 1.0e6f / numSelections;
+        result.MicrosecondsPerBuild = buildingSeconds * 1.0e6f / numSelections;
+
+        ReportBenchmark(
+            L"heightfield  levels %u  %8.1f nodes/view  %10.0f vertices/view  %8.2f us/select  %8.1f us/build\n",
+            heightfield.GetNumLevels(),
+            result.NodesPerView,
+            result.VerticesPerView,
+            result.MicrosecondsPerSelection,
+            result.MicrosecondsPerBuild
+        );
+
+        return S_OK;
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: BenchmarkTerrainErosion
+
+      Summary:  Erodes copies of a generated height map on 1, 2, 4...
+                threads up to the number of hardware threads, timing
+                the droplets and the thermal iterations apart, and
+                reports the droplets and iterations per second of each
+                thread count to the debug output
+
+      Args:     UINT uWidth
+                UINT uDepth
+                  Columns of the generated map, 1024x1024 for the
+                  reference numbers
+                UINT uNumDroplets
+                  Droplets per run
+                UINT uNumThermalIterations
+                  Thermal iterations per run
+                UINT uNumRuns
+                  Number of timed runs per thread count
+                std::vector<ErosionBenchmarkResult>& results
+                  Receives one result per thread count
+
+      Returns:  HRESULT
+                  Status code, E_INVALIDARG if the map is empty, has
+                  nothing to erode or no run is requested
+    -----------------------------------------------------------------F-F*/
+    HRESULT BenchmarkTerrainErosion(_In_ UINT uWidth, _In_ UINT uDepth, _In_ UINT uNumDroplets, _In_ UINT uNumThermalIterations, _In_ UINT uNumRuns, _Out_ std::vector<ErosionBenchmarkResult>& results)
+    {
+        results.clear();
+
+        if (uWidth < 2u || uDepth < 2u || (uNumDroplets == 0u && uNumThermalIterations == 0u) || uNumRuns == 0u)
+        {
+            return E_INVALIDARG;
+        }
+
+        constexpr UINT VERTICAL_SCALE = 64u;
+        TerrainGenerator generator(uWidth, VERTICAL_SCALE, uDepth);
+        generator.Generate();
+
+        TerrainEroder eroder(uWidth, uDepth, static_cast<FLOAT>(VERTICAL_SCALE));
+        std::vector<FLOAT> aHeights;
+
+        for (UINT uNumThreads : GetBenchmarkThreadCounts())
+        {
+            ThreadPool threadPool(uNumThreads);
+
+            // Warm up the threads and caches before timing
+            aHeights = generator.GetHeights();
+            eroder.ErodeHydraulic(aHeights, uNumDroplets, 0u, &threadPool);
+            eroder.ErodeThermal(aHeights, uNumThermalIterations, &threadPool);
+
+            FLOAT hydraulicSeconds = 0.0f;
+            FLOAT thermalSeconds = 0.0f;
+            for (UINT i = 0u; i < uNumRuns; ++i)
+            {
+                aHeights = generator.GetHeights();
+
+                hydraulicSeconds += TimeBenchmarkRun([&, i]() { eroder.ErodeHydraulic(aHeights, uNumDroplets, i, &threadPool); });
+                thermalSeconds += TimeBenchmarkRun([&]() { eroder.ErodeThermal(aHeights, uNumThermalIterations, &threadPool); });
+            }
+
+            const FLOAT numRuns = static_cast<FLOAT>(uNumRuns);
+            ErosionBenchmarkResult result =
+            {
+                .uNumThreads = threadPool.GetNumThreads(),
+                .uNumRuns = uNumRuns,
+                .DropletsPerSecond = GetBenchmarkRate(static_cast<FLOAT>(uNumDroplets) * numRuns, hydraulicSeconds),
+                .ThermalIterationsPerSecond = GetBenchmarkRate(static_cast<FLOAT>(uNumThermalIterations) * numRuns, thermalSeconds),
+                .MillisecondsPerRun = (hydraulicSeconds + thermalSeconds) * 1000.0f / numRuns
+            };
+            results.push_back(result);
+
+            ReportBenchmark(
+                L"terrain erosion  threads %2u  %12.0f droplets/s  %8.1f thermal iterations/s  %8.2f ms/run  %ux%u\n",
+                result.uNumThreads,
+                result.DropletsPerSecond,
+                result.ThermalIterationsPerSecond,
+                result.MillisecondsPerRun,
+                uWidth,
+                uDepth
+            );
+        }
+
+        return S_OK;
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: BenchmarkVoxelFiles
+
+      Summary:  Saves and loads a generated height map world as a text
+                height map and as region files, and reports the size
+                on disk and the columns saved and loaded per second of
+                each format to the debug output. Loading the text
+                parses it and fills a store, loading the regions maps
+                and decodes them into a store, and the regions are
+                timed on 1, 2, 4... threads up to the number of
+                hardware threads. The world is a height map so both
+                formats hold the same blocks; the regions would also
+                hold the caves and edits the text cannot
+
+      Args:     const std::filesystem::path& directoryPath
+                  Scratch directory to write the files to, created if
+                  needed
+                UINT uWidth
+                UINT uDepth
+                  Columns of the generated map, 1024x1024 for the
+                  reference numbers
+                UINT uNumRuns
+                  Number of timed runs per format and thread count
+                std::vector<VoxelFileBenchmarkResult>& results
+                  Receives the text result, then one region result per
+                  thread count
+
+      Returns:  HRESULT
+                  Status code, E_INVALIDARG if the map is empty or no
+                  run is requested
+    -----------------------------------------------------------------F-F*/
+    HRESULT BenchmarkVoxelFiles(_In_ const std::filesystem::path& directoryPath, _In_ UINT uWidth, _In_ UINT uDepth, _In_ UINT uNumRuns, _Out_ std::vector<VoxelFileBenchmarkResult>& results)
+    {
+        results.clear();
+
+        if (uWidth == 0u || uDepth == 0u || uNumRuns == 0u)
+        {
+            return E_INVALIDARG;
+        }
+
+        constexpr UINT HEIGHT = 64u;
+        TerrainGenerator generator(uWidth, HEIGHT, uDepth);
+        generator.Generate();
+        const HeightMap& heightMap = generator.GetHeightMap();
+
+        VoxelColumnStore store(uWidth, HEIGHT, uDepth, XMFLOAT3(0.0f, 0.0f, 0.0f));
+        fillStoreFromHeightMap(heightMap, store);
+
+        std::error_code error;
+        std::filesystem::create_directories(directoryPath, error);
+        const std::filesystem::path textFilePath = directoryPath / L"HeightMap.txt";
+        const std::filesystem::path regionDirectoryPath = directoryPath / L"Regions";
+
+        const FLOAT numColumns = static_cast<FLOAT>(uWidth) * static_cast<FLOAT>(uDepth) * static_cast<FLOAT>(uNumRuns);
+        auto reportResult = [uWidth, uDepth](const VoxelFileBenchmarkResult& result)
+        {
+            ReportBenchmark(
+                L"voxel files  %-6ls threads %2u  %10llu bytes  %12.0f columns/s saved  %12.0f columns/s loaded  %8.2f ms/save  %8.2f ms/load  %ux%u\n",
+                result.bText ? L"text" : L"region",
+                result.uNumThreads,
+                result.uFileBytes,
+                result.ColumnsSavedPerSecond,
+                result.ColumnsLoadedPerSecond,
+                result.MillisecondsPerSave,
+                result.MillisecondsPerLoad,
+                uWidth,
+                uDepth
+            );
+        };
+
+        {
+            FLOAT saveSeconds = 0.0f;
+            FLOAT loadSeconds = 0.0f;
+            for (UINT i = 0u; i < uNumRuns; ++i)
+            {
+                HRESULT hr = S_OK;
+                saveSeconds += TimeBenchmarkRun([&]() { hr = WriteTextHeightMap(textFilePath, heightMap); });
+                if (FAILED(hr))
+                {
+                    return hr;
+                }
+
+                // Declared out here so freeing them is not timed
+                MappedFile textFile;
+                HeightMap loadedHeightMap;
+                std::unique_ptr<VoxelColumnStore> loadedStore;
+                loadSeconds += TimeBenchmarkRun(
+                    [&]()
+                    {
+                        hr = textFile.Open(textFilePath);
+                        if (FAILED(hr))
+                        {
+                            return;
+                        }
+                        ParseTextHeightMap(reinterpret_cast<const CHAR*>(textFile.GetData()), textFile.GetSize(), loadedHeightMap);
+                        loadedStore = std::make_unique<VoxelColumnStore>(loadedHeightMap.uWidth, loadedHeightMap.uHeight, loadedHeightMap.uDepth, XMFLOAT3(0.0f, 0.0f, 0.0f));
+                        fillStoreFromHeightMap(loadedHeightMap, *loadedStore);
+                    }
+                );
+                if (FAILED(hr))
+                {
+                    return hr;
+                }
+            }
+
+            const VoxelFileBenchmarkResult result =
+            {
+                .bText = TRUE,
+                .uNumThreads = 1u,
+                .uNumRuns = uNumRuns,
+                .uFileBytes = static_cast<UINT64>(std::filesystem::file_size(textFilePath, error)),
+                .ColumnsSavedPerSecond = GetBenchmarkRate(numColumns, saveSeconds),
+                .ColumnsLoadedPerSecond = GetBenchmarkRate(numColumns, loadSeconds),
+                .MillisecondsPerSave = saveSeconds * 1000.0f / static_cast<FLOAT>(uNumRuns),
+                .MillisecondsPerLoad = loadSeconds * 1000.0f / static_cast<FLOAT>(uNumRuns)
+            };
+            results.push_back(result);
+            reportResult(result);
+        }
+
+        for (UINT uNumThreads : GetBenchmarkThreadCounts())
+        {
+            ThreadPool threadPool(uNumThreads);
+
+            FLOAT saveSeconds = 0.0f;
+            FLOAT loadSeconds = 0.0f;
+            for (UINT i = 0u; i < uNumRuns; ++i)
+            {
+                HRESULT hr = S_OK;
+                saveSeconds += TimeBenchmarkRun([&]() { hr = WriteVoxelRegions(regionDirectoryPath, store, &threadPool); });
+                if (FAILED(hr))
+                {
+                    return hr;
+                }
+
+                std::unique_ptr<VoxelColumnStore> loadedStore;
+                loadSeconds += TimeBenchmarkRun([&]() { hr = ReadVoxelRegions(regionDirectoryPath, &threadPool, loadedStore); });
+                if (FAILED(hr))
+                {
+                    return hr;
+                }
+            }
+
+            const VoxelFileBenchmarkResult result =
+            {
+                .bText = FALSE,
+                .uNumThreads = threadPool.GetNumThreads(),
+                .uNumRuns = uNumRuns,
+                .uFileBytes = getDirectorySize(regionDirectoryPath),
+                .ColumnsSavedPerSecond = GetBenchmarkRate(numColumns, saveSeconds),
+                .ColumnsLoadedPerSecond = GetBenchmarkRate(numColumns, loadSeconds),
+                .MillisecondsPerSave = saveSeconds * 1000.0f / static_cast<FLOAT>(uNumRuns),
+                .MillisecondsPerLoad = loadSeconds * 1000.0f / static_cast<FLOAT>(uNumRuns)
+            };
+            results.push_back(result);
+            reportResult(result);
+        }
+
+        return S_OK;
+    }
+}
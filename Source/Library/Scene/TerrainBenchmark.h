@@ -0,0 +1,155 @@
+/*+===================================================================
+  File:      TERRAINBENCHMARK.H
+
+  Summary:   TerrainBenchmark header file contains declarations of the
+             functions that measure how fast the terrain generator
+             fills height maps as the number of threads grows, and how
+             fast the noise it samples is at each vector width, how
+             many voxels per second the density generator fills, how
+             many rays per second are cast against the terrain, how
+             long the heightfield takes to select its nodes, how fast
+             the heights erode as the number of threads grows and how
+             fast and small region files are next to text height maps.
+
+  Classes: TerrainBenchmarkResult, NoiseBenchmarkResult,
+           DensityBenchmarkResult, VoxelRaycastBenchmarkResult,
+           HeightfieldBenchmarkResult, ErosionBenchmarkResult,
+           VoxelFileBenchmarkResult
+
+  Functions: BenchmarkTerrainGenerator, BenchmarkNoise,
+             BenchmarkDensityTerrain, BenchmarkVoxelRaycasts,
+             BenchmarkHeightfieldSelection, BenchmarkTerrainErosion,
+             BenchmarkVoxelFiles
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Scene/DensityTerrainGenerator.h"
+#include "Scene/HeightfieldTerrain.h"
+#include "Scene/Noise.h"
+#include "Scene/TerrainEroder.h"
+#include "Scene/TerrainGenerator.h"
+#include "Scene/VoxelOccupancyGrid.h"
+#include "Scene/VoxelRegionFile.h"
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   TerrainBenchmarkResult
+
+      Summary:  Throughput of the terrain generator with one thread
+                count
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct TerrainBenchmarkResult
+    {
+        UINT uNumThreads;
+        UINT uNumRuns;
+        FLOAT CellsPerSecond;
+        FLOAT MillisecondsPerRun;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   NoiseBenchmarkResult
+
+      Summary:  Throughput of batch noise sampling with one vector
+                width
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct NoiseBenchmarkResult
+    {
+        eNoiseLanes Lanes;
+        UINT uNumSamples;
+        FLOAT SamplesPerSecond;
+        FLOAT NanosecondsPerSample;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   DensityBenchmarkResult
+
+      Summary:  Throughput of the density generator with one thread
+                count
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct DensityBenchmarkResult
+    {
+        UINT uNumThreads;
+        UINT uNumRuns;
+        FLOAT VoxelsPerSecond;
+        FLOAT MillisecondsPerRun;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   VoxelRaycastBenchmarkResult
+
+      Summary:  Throughput of batched raycasts with one thread count
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct VoxelRaycastBenchmarkResult
+    {
+        UINT uNumThreads;
+        UINT uNumRays;
+        UINT uNumHits;
+        FLOAT RaysPerSecond;
+        FLOAT NanosecondsPerRay;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   HeightfieldBenchmarkResult
+
+      Summary:  Cost of selecting the nodes of the heightfield for a
+                view and of building their patches, averaged over the
+                views
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct HeightfieldBenchmarkResult
+    {
+        UINT uNumViews;
+        UINT uNumRuns;
+        FLOAT NodesPerView;
+        FLOAT VerticesPerView;
+        FLOAT SelectionsPerSecond;
+        FLOAT MicrosecondsPerSelection;
+        FLOAT MicrosecondsPerBuild;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   ErosionBenchmarkResult
+
+      Summary:  Throughput of hydraulic and thermal erosion with one
+                thread count
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct ErosionBenchmarkResult
+    {
+        UINT uNumThreads;
+        UINT uNumRuns;
+        FLOAT DropletsPerSecond;
+        FLOAT ThermalIterationsPerSecond;
+        FLOAT MillisecondsPerRun;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   VoxelFileBenchmarkResult
+
+      Summary:  Size on disk and save and load throughput of one file
+                format with one thread count. The text format is saved
+                and loaded on one thread only
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct VoxelFileBenchmarkResult
+    {
+        BOOL bText;
+        UINT uNumThreads;
+        UINT uNumRuns;
+        UINT64 uFileBytes;
+        FLOAT ColumnsSavedPerSecond;
+        FLOAT ColumnsLoadedPerSecond;
+        FLOAT MillisecondsPerSave;
+        FLOAT MillisecondsPerLoad;
+    };
+
+    HRESULT BenchmarkTerrainGenerator(_In_ UINT uWidth, _In_ UINT uDepth, _In_ UINT uNumRuns, _Out_ std::vector<TerrainBenchmarkResult>& results);
+    HRESULT BenchmarkNoise(_In_ UINT uNumSamples, _In_ UINT uNumRuns, _Out_ std::vector<NoiseBenchmarkResult>& results);
+    HRESULT BenchmarkDensityTerrain(_In_ UINT uWidth, _In_ UINT uHeight, _In_ UINT uDepth, _In_ UINT uNumRuns, _Out_ std::vector<DensityBenchmarkResult>& results);
+    HRESULT BenchmarkVoxelRaycasts(_In_ const VoxelOccupancyGrid& occupancy, _In_ UINT uNumRays, _In_ UINT uNumRuns, _Out_ std::vector<VoxelRaycastBenchmarkResult>& results);
+    HRESULT BenchmarkHeightfieldSelection(_In_ HeightfieldTerrain& heightfield, _In_ UINT uNumViews, _In_ UINT uNumRuns, _Out_ HeightfieldBenchmarkResult& result);
+    HRESULT BenchmarkTerrainErosion(_In_ UINT uWidth, _In_ UINT uDepth, _In_ UINT uNumDroplets, _In_ UINT uNumThermalIterations, _In_ UINT uNumRuns, _Out_ std::vector<ErosionBenchmarkResult>& results);
+    HRESULT BenchmarkVoxelFiles(_In_ const std::filesystem::path& directoryPath, _In_ UINT uWidth, _In_ UINT uDepth, _In_ UINT uNumRuns, _Out_ std::vector<VoxelFileBenchmarkResult>& results);
+}
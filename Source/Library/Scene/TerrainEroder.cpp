@@ -0,0 +1,465 @@
+#include "Scene/TerrainEroder.h"
+
+namespace library
+{
+    namespace
+    {
+        // How much of its direction a droplet keeps each step, the rest
+        // turning it down the slope under it
+        constexpr FLOAT DROPLET_INERTIA = 0.05f;
+
+        // Sediment a droplet can carry per cube it falls, per speed and
+        // water, and the least it can carry on flat ground, in cubes
+        constexpr FLOAT DROPLET_CAPACITY = 1.0f;
+        constexpr FLOAT DROPLET_MIN_CAPACITY = 0.01f;
+
+        // Fractions of the sediment above capacity dropped and of the
+        // room below capacity picked up per step
+        constexpr FLOAT DROPLET_DEPOSIT_RATE = 0.3f;
+        constexpr FLOAT DROPLET_ERODE_RATE = 0.3f;
+
+        // Fraction of its water a droplet loses per step, and how much
+        // falling a cube speeds it up
+        constexpr FLOAT DROPLET_EVAPORATION = 0.01f;
+        constexpr FLOAT DROPLET_GRAVITY = 4.0f;
+
+        // Steps before a droplet dries up, at one column per step
+        constexpr UINT DROPLET_LIFETIME = 30u;
+
+        // Columns around a droplet it erodes, weighted by closeness
+        constexpr INT DROPLET_BRUSH_RADIUS = 3;
+
+        // Steepest slope that holds, in cubes of height per column, and
+        // the fraction of the height above it that slides per iteration
+        // to each lower neighbour, an eighth at most for the iteration
+        // to stay stable with four neighbours
+        constexpr FLOAT THERMAL_TALUS = 1.0f;
+        constexpr FLOAT THERMAL_RATE = 0.1f;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainEroder::TerrainEroder
+
+      Summary:  Constructor. Builds the brush of the droplets
+
+      Args:     UINT uWidth
+                UINT uDepth
+                  Columns along x and z
+                FLOAT verticalScale
+                  Cubes of a column of height 1, which the droplets and
+                  the talus are measured in
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    TerrainEroder::TerrainEroder(_In_ UINT uWidth, _In_ UINT uDepth, _In_ FLOAT verticalScale)
+        : m_uWidth(uWidth)
+        , m_uDepth(uDepth)
+        , m_verticalScale(std::max(verticalScale, 1.0f))
+        , m_talus(THERMAL_TALUS / m_verticalScale)
+        , m_anBrushOffsetsX()
+        , m_anBrushOffsetsZ()
+        , m_aBrushWeights()
+        , m_aScratch()
+    {
+        FLOAT weightSum = 0.0f;
+        for (INT nZ = -DROPLET_BRUSH_RADIUS; nZ <= DROPLET_BRUSH_RADIUS; ++nZ)
+        {
+            for (INT nX = -DROPLET_BRUSH_RADIUS; nX <= DROPLET_BRUSH_RADIUS; ++nX)
+            {
+                const FLOAT weight = static_cast<FLOAT>(DROPLET_BRUSH_RADIUS) - std::sqrt(static_cast<FLOAT>(nX * nX + nZ * nZ));
+                if (weight > 0.0f)
+                {
+                    m_anBrushOffsetsX.push_back(nX);
+                    m_anBrushOffsetsZ.push_back(nZ);
+                    m_aBrushWeights.push_back(weight);
+                    weightSum += weight;
+                }
+            }
+        }
+
+        for (FLOAT& weight : m_aBrushWeights)
+        {
+            weight /= weightSum;
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainEroder::ErodeHydraulic
+
+      Summary:  Runs droplets over the heights, each tile taking its
+                share of them by area. The four colors of tiles run
+                one after the other and the tiles of a color in
+                parallel
+
+      Args:     std::vector<FLOAT>& aHeights
+                  Heights to erode, uWidth x uDepth
+                UINT uNumDroplets
+                  Droplets over the whole map
+                UINT uSeed
+                  Seed the seed of each tile is derived from
+                ThreadPool* pThreadPool
+                  Pool to split the tiles of a color across, or
+                  nullptr to run them on the calling thread
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TerrainEroder::ErodeHydraulic(_Inout_ std::vector<FLOAT>& aHeights, _In_ UINT uNumDroplets, _In_ UINT uSeed, _In_opt_ ThreadPool* pThreadPool) const
+    {
+        assert(aHeights.size() == static_cast<size_t>(m_uWidth) * m_uDepth);
+
+        if (m_uWidth < 2u || m_uDepth < 2u || uNumDroplets == 0u)
+        {
+            return;
+        }
+
+        const UINT uTilesX = (m_uWidth + TERRAIN_EROSION_TILE_SIZE - 1u) / TERRAIN_EROSION_TILE_SIZE;
+        const UINT uTilesZ = (m_uDepth + TERRAIN_EROSION_TILE_SIZE - 1u) / TERRAIN_EROSION_TILE_SIZE;
+        const UINT64 uNumCells = static_cast<UINT64>(m_uWidth) * m_uDepth;
+
+        for (UINT uColor = 0u; uColor < 4u; ++uColor)
+        {
+            const UINT uFirstX = uColor & 1u;
+            const UINT uFirstZ = uColor >> 1u;
+            const UINT uColorTilesX = (uTilesX - uFirstX + 1u) / 2u;
+            const UINT uColorTilesZ = uTilesZ > uFirstZ ? (uTilesZ - uFirstZ + 1u) / 2u : 0u;
+
+            auto erodeColorTile = [&, uFirstX, uFirstZ, uColorTilesX](UINT uTask)
+            {
+                const UINT uTileX = uFirstX + (uTask % uColorTilesX) * 2u;
+                const UINT uTileZ = uFirstZ + (uTask / uColorTilesX) * 2u;
+
+                // The cells before a tile, row of tiles by row of tiles,
+                // give its share of the droplets without rounding drift
+                const UINT64 uRowHeight = std::min(TERRAIN_EROSION_TILE_SIZE, m_uDepth - uTileZ * TERRAIN_EROSION_TILE_SIZE);
+                const UINT64 uTileWidth = std::min(TERRAIN_EROSION_TILE_SIZE, m_uWidth - uTileX * TERRAIN_EROSION_TILE_SIZE);
+                const UINT64 uCellsBefore = static_cast<UINT64>(uTileZ) * TERRAIN_EROSION_TILE_SIZE * m_uWidth + uRowHeight * uTileX * TERRAIN_EROSION_TILE_SIZE;
+                const UINT uNumTileDroplets = static_cast<UINT>(
+                    (uNumDroplets * (uCellsBefore + uRowHeight * uTileWidth)) / uNumCells - (uNumDroplets * uCellsBefore) / uNumCells
+                );
+
+                erodeTile(aHeights.data(), uTileX, uTileZ, uNumTileDroplets, uSeed ^ ((uTileZ * uTilesX + uTileX + 1u) * 2654435761u));
+            };
+
+            const UINT uNumTasks = uColorTilesX * uColorTilesZ;
+            if (pThreadPool != nullptr)
+            {
+                pThreadPool->ParallelFor(uNumTasks, erodeColorTile);
+            }
+            else
+            {
+                for (UINT uTask = 0u; uTask < uNumTasks; ++uTask)
+                {
+                    erodeColorTile(uTask);
+                }
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainEroder::ErodeThermal
+
+      Summary:  Runs iterations of thermal erosion, each one reading the
+                heights and writing the scratch field, which are then
+                swapped
+
+      Args:     std::vector<FLOAT>& aHeights
+                  Heights to erode, uWidth x uDepth
+                UINT uNumIterations
+                  Number of iterations
+                ThreadPool* pThreadPool
+                  Pool to split the rows across, or nullptr to relax
+                  them on the calling thread
+
+      Modifies: [m_aScratch].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TerrainEroder::ErodeThermal(_Inout_ std::vector<FLOAT>& aHeights, _In_ UINT uNumIterations, _In_opt_ ThreadPool* pThreadPool)
+    {
+        assert(aHeights.size() == static_cast<size_t>(m_uWidth) * m_uDepth);
+
+        if (m_uWidth == 0u || m_uDepth == 0u)
+        {
+            return;
+        }
+
+        m_aScratch.resize(aHeights.size());
+
+        const UINT uNumTasks = (m_uDepth + TERRAIN_THERMAL_ROWS_PER_TASK - 1u) / TERRAIN_THERMAL_ROWS_PER_TASK;
+        for (UINT i = 0u; i < uNumIterations; ++i)
+        {
+            auto relaxTask = [this, &aHeights](UINT uTask)
+            {
+                relaxRows(aHeights.data(), m_aScratch.data(), uTask * TERRAIN_THERMAL_ROWS_PER_TASK, std::min((uTask + 1u) * TERRAIN_THERMAL_ROWS_PER_TASK, m_uDepth));
+            };
+
+            if (pThreadPool != nullptr)
+            {
+                pThreadPool->ParallelFor(uNumTasks, relaxTask);
+            }
+            else
+            {
+                for (UINT uTask = 0u; uTask < uNumTasks; ++uTask)
+                {
+                    relaxTask(uTask);
+                }
+            }
+
+            aHeights.swap(m_aScratch);
+        }
+    }
+
+    UINT TerrainEroder::GetWidth() const
+    {
+        return m_uWidth;
+    }
+
+    UINT TerrainEroder::GetDepth() const
+    {
+        return m_uDepth;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainEroder::erodeTile
+
+      Summary:  Runs the droplets of a tile. A droplet starts anywhere
+                in the tile and stops once its brush would leave the
+                tile grown by half a tile on each side, which keeps it
+                clear of every other tile of the color
+
+      Args:     FLOAT* pHeights
+                  Heights to erode
+                UINT uTileX
+                UINT uTileZ
+                  Tile to drop water on
+                UINT uNumDroplets
+                  Droplets of the tile
+                UINT uSeed
+                  Seed of the tile
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TerrainEroder::erodeTile(_Inout_ FLOAT* pHeights, _In_ UINT uTileX, _In_ UINT uTileZ, _In_ UINT uNumDroplets, _In_ UINT uSeed) const
+    {
+        auto random = [&uSeed]()
+        {
+            uSeed = uSeed * 1664525u + 1013904223u;
+            return static_cast<FLOAT>(uSeed >> 8u) / 16777216.0f;
+        };
+
+        constexpr INT HALF_TILE = static_cast<INT>(TERRAIN_EROSION_TILE_SIZE / 2u);
+        const INT nTileX = static_cast<INT>(uTileX * TERRAIN_EROSION_TILE_SIZE);
+        const INT nTileZ = static_cast<INT>(uTileZ * TERRAIN_EROSION_TILE_SIZE);
+        const INT nWidth = static_cast<INT>(m_uWidth);
+        const INT nDepth = static_cast<INT>(m_uDepth);
+
+        // Cells whose brush and bilinear corners stay in the grown
+        // tile and in the map
+        const INT nMinX = std::max(nTileX - HALF_TILE + DROPLET_BRUSH_RADIUS, 0);
+        const INT nMinZ = std::max(nTileZ - HALF_TILE + DROPLET_BRUSH_RADIUS, 0);
+        const INT nMaxX = std::min(nTileX + static_cast<INT>(TERRAIN_EROSION_TILE_SIZE) + HALF_TILE - DROPLET_BRUSH_RADIUS - 1, nWidth - 1);
+        const INT nMaxZ = std::min(nTileZ + static_cast<INT>(TERRAIN_EROSION_TILE_SIZE) + HALF_TILE - DROPLET_BRUSH_RADIUS - 1, nDepth - 1);
+
+        const FLOAT spawnWidth = static_cast<FLOAT>(std::min(nTileX + static_cast<INT>(TERRAIN_EROSION_TILE_SIZE), nWidth - 1) - nTileX);
+        const FLOAT spawnDepth = static_cast<FLOAT>(std::min(nTileZ + static_cast<INT>(TERRAIN_EROSION_TILE_SIZE), nDepth - 1) - nTileZ);
+        if (spawnWidth <= 0.0f || spawnDepth <= 0.0f)
+        {
+            return;
+        }
+
+        const UINT uBrushSize = static_cast<UINT>(m_aBrushWeights.size());
+        for (UINT uDroplet = 0u; uDroplet < uNumDroplets; ++uDroplet)
+        {
+            FLOAT x = static_cast<FLOAT>(nTileX) + random() * spawnWidth;
+            FLOAT z = static_cast<FLOAT>(nTileZ) + random() * spawnDepth;
+            FLOAT directionX = 0.0f;
+            FLOAT directionZ = 0.0f;
+            FLOAT speed = 1.0f;
+            FLOAT water = 1.0f;
+            FLOAT sediment = 0.0f;
+
+            for (UINT uStep = 0u; uStep < DROPLET_LIFETIME; ++uStep)
+            {
+                const INT nX = static_cast<INT>(x);
+                const INT nZ = static_cast<INT>(z);
+                if (nX < nMinX || nX >= nMaxX || nZ < nMinZ || nZ >= nMaxZ)
+                {
+                    break;
+                }
+                const FLOAT offsetX = x - static_cast<FLOAT>(nX);
+                const FLOAT offsetZ = z - static_cast<FLOAT>(nZ);
+
+                FLOAT gradientX = 0.0f;
+                FLOAT gradientZ = 0.0f;
+                const FLOAT height = sampleHeight(pHeights, x, z, gradientX, gradientZ);
+
+                directionX = directionX * DROPLET_INERTIA - gradientX * (1.0f - DROPLET_INERTIA);
+                directionZ = directionZ * DROPLET_INERTIA - gradientZ * (1.0f - DROPLET_INERTIA);
+                const FLOAT length = std::sqrt(directionX * directionX + directionZ * directionZ);
+                if (length <= 0.0f)
+                {
+                    break;
+                }
+                directionX /= length;
+                directionZ /= length;
+                x += directionX;
+                z += directionZ;
+
+                const INT nNextX = static_cast<INT>(std::floor(x));
+                const INT nNextZ = static_cast<INT>(std::floor(z));
+                if (nNextX < nMinX || nNextX >= nMaxX || nNextZ < nMinZ || nNextZ >= nMaxZ)
+                {
+                    break;
+                }
+
+                FLOAT nextGradientX = 0.0f;
+                FLOAT nextGradientZ = 0.0f;
+                const FLOAT heightChange = (sampleHeight(pHeights, x, z, nextGradientX, nextGradientZ) - height) * m_verticalScale;
+                const FLOAT capacity = std::max(-heightChange * speed * water * DROPLET_CAPACITY, DROPLET_MIN_CAPACITY);
+
+                FLOAT* pCell = pHeights + static_cast<size_t>(nZ) * m_uWidth + nX;
+                if (sediment > capacity || heightChange > 0.0f)
+                {
+                    // Uphill the droplet fills the pit behind it, at
+                    // most as high as where it came from
+                    const FLOAT deposit = heightChange > 0.0f ? std::min(heightChange, sediment) : (sediment - capacity) * DROPLET_DEPOSIT_RATE;
+                    sediment -= deposit;
+
+                    const FLOAT depositHeight = deposit / m_verticalScale;
+                    pCell[0] += depositHeight * (1.0f - offsetX) * (1.0f - offsetZ);
+                    pCell[1] += depositHeight * offsetX * (1.0f - offsetZ);
+                    pCell[m_uWidth] += depositHeight * (1.0f - offsetX) * offsetZ;
+                    pCell[m_uWidth + 1u] += depositHeight * offsetX * offsetZ;
+                }
+                else
+                {
+                    // Never dig deeper than the drop, which would leave
+                    // a pit under the droplet
+                    const FLOAT erosionHeight = std::min((capacity - sediment) * DROPLET_ERODE_RATE, -heightChange) / m_verticalScale;
+                    for (UINT i = 0u; i < uBrushSize; ++i)
+                    {
+                        const INT nBrushX = nX + m_anBrushOffsetsX[i];
+                        const INT nBrushZ = nZ + m_anBrushOffsetsZ[i];
+                        if (nBrushX < 0 || nBrushX >= nWidth || nBrushZ < 0 || nBrushZ >= nDepth)
+                        {
+                            continue;
+                        }
+
+                        FLOAT& brushHeight = pHeights[static_cast<size_t>(nBrushZ) * m_uWidth + nBrushX];
+                        const FLOAT removed = std::min(erosionHeight * m_aBrushWeights[i], brushHeight);
+                        brushHeight -= removed;
+                        sediment += removed * m_verticalScale;
+                    }
+                }
+
+                speed = std::sqrt(std::max(speed * speed - heightChange * DROPLET_GRAVITY, 0.0f));
+                water *= 1.0f - DROPLET_EVAPORATION;
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainEroder::sampleHeight
+
+      Summary:  Interpolates the height and its gradient between the
+                four columns around a point
+
+      Args:     const FLOAT* pHeights
+                  Heights to sample
+                FLOAT x
+                FLOAT z
+                  Point in columns, at least one column inside the far
+                  edges
+                FLOAT& gradientX
+                FLOAT& gradientZ
+                  Receive the change of height per column
+
+      Returns:  FLOAT
+                  Height at the point
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT TerrainEroder::sampleHeight(_In_ const FLOAT* pHeights, _In_ FLOAT x, _In_ FLOAT z, _Out_ FLOAT& gradientX, _Out_ FLOAT& gradientZ) const
+    {
+        const UINT uX = static_cast<UINT>(x);
+        const UINT uZ = static_cast<UINT>(z);
+        const FLOAT offsetX = x - static_cast<FLOAT>(uX);
+        const FLOAT offsetZ = z - static_cast<FLOAT>(uZ);
+
+        const FLOAT* pCell = pHeights + static_cast<size_t>(uZ) * m_uWidth + uX;
+        const FLOAT height00 = pCell[0];
+        const FLOAT height10 = pCell[1];
+        const FLOAT height01 = pCell[m_uWidth];
+        const FLOAT height11 = pCell[m_uWidth + 1u];
+
+        gradientX = (height10 - height00) * (1.0f - offsetZ) + (height11 - height01) * offsetZ;
+        gradientZ = (height01 - height00) * (1.0f - offsetX) + (height11 - height10) * offsetX;
+
+        return height00 * (1.0f - offsetX) * (1.0f - offsetZ) + height10 * offsetX * (1.0f - offsetZ) + height01 * (1.0f - offsetX) * offsetZ + height11 * offsetX * offsetZ;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainEroder::relaxRows
+
+      Summary:  Moves THERMAL_RATE of every height difference above the
+                talus between a column and its four neighbours from the
+                higher to the lower one. Each pair is seen the same way
+                from both columns so no height is lost. The columns
+                inside the left and right edges are done four at a time
+                with vector instructions, the edges, where a missing
+                neighbour stands in for itself, one at a time
+
+      Args:     const FLOAT* pSource
+                  Heights of the previous iteration
+                FLOAT* pDestination
+                  Receives the heights of this iteration
+                UINT uFirstZ
+                UINT uLastZ
+                  Rows [uFirstZ, uLastZ) to relax
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TerrainEroder::relaxRows(_In_ const FLOAT* pSource, _Out_ FLOAT* pDestination, _In_ UINT uFirstZ, _In_ UINT uLastZ) const
+    {
+        const FLOAT talus = m_talus;
+        auto excess = [talus](FLOAT difference)
+        {
+            return difference - std::clamp(difference, -talus, talus);
+        };
+
+        const XMVECTOR talusVector = XMVectorReplicate(talus);
+        const XMVECTOR negativeTalusVector = XMVectorReplicate(-talus);
+        const XMVECTOR rateVector = XMVectorReplicate(THERMAL_RATE);
+        auto excessVector = [talusVector, negativeTalusVector](XMVECTOR difference)
+        {
+            return XMVectorSubtract(difference, XMVectorMax(XMVectorMin(difference, talusVector), negativeTalusVector));
+        };
+
+        for (UINT z = uFirstZ; z < uLastZ; ++z)
+        {
+            const FLOAT* pRow = pSource + static_cast<size_t>(z) * m_uWidth;
+            const FLOAT* pUp = pSource + static_cast<size_t>(z > 0u ? z - 1u : z) * m_uWidth;
+            const FLOAT* pDown = pSource + static_cast<size_t>(z + 1u < m_uDepth ? z + 1u : z) * m_uWidth;
+            FLOAT* pOut = pDestination + static_cast<size_t>(z) * m_uWidth;
+
+            auto relaxColumn = [&](UINT x)
+            {
+                const FLOAT height = pRow[x];
+                const FLOAT left = pRow[x > 0u ? x - 1u : x];
+                const FLOAT right = pRow[x + 1u < m_uWidth ? x + 1u : x];
+                pOut[x] = height + THERMAL_RATE * (excess(left - height) + excess(right - height) + excess(pUp[x] - height) + excess(pDown[x] - height));
+            };
+
+            relaxColumn(0u);
+
+            UINT x = 1u;
+            for (; x + 4u < m_uWidth; x += 4u)
+            {
+                const XMVECTOR height = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(pRow + x));
+                const XMVECTOR left = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(pRow + x - 1u));
+                const XMVECTOR right = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(pRow + x + 1u));
+                const XMVECTOR up = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(pUp + x));
+                const XMVECTOR down = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(pDown + x));
+
+                XMVECTOR flow = excessVector(XMVectorSubtract(left, height));
+                flow = XMVectorAdd(flow, excessVector(XMVectorSubtract(right, height)));
+                flow = XMVectorAdd(flow, excessVector(XMVectorSubtract(up, height)));
+                flow = XMVectorAdd(flow, excessVector(XMVectorSubtract(down, height)));
+                XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(pOut + x), XMVectorMultiplyAdd(flow, rateVector, height));
+            }
+
+            for (; x < m_uWidth; ++x)
+            {
+                relaxColumn(x);
+            }
+        }
+    }
+}
@@ -0,0 +1,92 @@
+/*+===================================================================
+  File:      TERRAINERODER.H
+
+  Summary:   TerrainEroder header file contains declarations of the
+             erosion pass run over the heights of a generated map,
+             droplets of water carrying sediment downhill and material
+             sliding off slopes steeper than the angle of repose.
+
+  Classes: TerrainEroder
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Platform/ThreadPool.h"
+
+namespace library
+{
+    // Columns along each edge of a tile of droplets. A droplet never
+    // leaves its tile by more than half a tile, so the tiles of one
+    // color of the 2x2 coloring never touch the same column
+    constexpr UINT TERRAIN_EROSION_TILE_SIZE = 64u;
+
+    // Rows relaxed by one task of a thermal iteration
+    constexpr UINT TERRAIN_THERMAL_ROWS_PER_TASK = 16u;
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    TerrainEroder
+
+      Summary:  Erodes a field of heights in [0, 1], x fastest then z.
+                Hydraulic erosion drops water at random columns and
+                follows each droplet downhill, measuring what it falls
+                and carries in cubes, picking up sediment
+                where it speeds up and dropping it where it slows, so
+                valleys cut into the slopes and fill at their feet. The
+                map is split into tiles colored like a 2x2
+                checkerboard, the tiles of one color running in
+                parallel without locks since their droplets cannot
+                reach the same column, each from its own seed so the
+                result does not depend on the number of threads.
+                Thermal erosion moves the part of every height
+                difference between neighbours above the talus from the
+                higher to the lower column, all columns at once from
+                the heights of the previous iteration, four columns per
+                instruction
+
+      Methods:  ErodeHydraulic
+                  Runs droplets over the heights
+                ErodeThermal
+                  Runs iterations of thermal erosion
+                GetWidth
+                GetDepth
+                  Return the number of columns along an axis
+                TerrainEroder
+                  Constructor.
+                ~TerrainEroder
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class TerrainEroder final
+    {
+    public:
+        TerrainEroder(_In_ UINT uWidth, _In_ UINT uDepth, _In_ FLOAT verticalScale);
+        TerrainEroder(const TerrainEroder& other) = delete;
+        TerrainEroder(TerrainEroder&& other) = delete;
+        TerrainEroder& operator=(const TerrainEroder& other) = delete;
+        TerrainEroder& operator=(TerrainEroder&& other) = delete;
+        ~TerrainEroder() = default;
+
+        void ErodeHydraulic(_Inout_ std::vector<FLOAT>& aHeights, _In_ UINT uNumDroplets, _In_ UINT uSeed, _In_opt_ ThreadPool* pThreadPool) const;
+        void ErodeThermal(_Inout_ std::vector<FLOAT>& aHeights, _In_ UINT uNumIterations, _In_opt_ ThreadPool* pThreadPool);
+
+        UINT GetWidth() const;
+        UINT GetDepth() const;
+
+    private:
+        void erodeTile(_Inout_ FLOAT* pHeights, _In_ UINT uTileX, _In_ UINT uTileZ, _In_ UINT uNumDroplets, _In_ UINT uSeed) const;
+        FLOAT sampleHeight(_In_ const FLOAT* pHeights, _In_ FLOAT x, _In_ FLOAT z, _Out_ FLOAT& gradientX, _Out_ FLOAT& gradientZ) const;
+        void relaxRows(_In_ const FLOAT* pSource, _Out_ FLOAT* pDestination, _In_ UINT uFirstZ, _In_ UINT uLastZ) const;
+
+    private:
+        UINT m_uWidth;
+        UINT m_uDepth;
+        FLOAT m_verticalScale;
+        FLOAT m_talus;
+        std::vector<INT> m_anBrushOffsetsX;
+        std::vector<INT> m_anBrushOffsetsZ;
+        std::vector<FLOAT> m_aBrushWeights;
+        std::vector<FLOAT> m_aScratch;
+    };
+}
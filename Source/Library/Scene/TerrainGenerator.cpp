@@ -0,0 +1,372 @@
+#include "Scene/TerrainGenerator.h"
+
+#include "Scene/Noise.h"
+#include "Scene/VoxelGrid.h"
+
+namespace library
+{
+    namespace
+    {
+        // Octaves summed for a field, each sampling the noise at twice
+        // the frequency and half the weight of the one before
+        constexpr FLOAT OCTAVE_FREQUENCIES[] = { 1.0f, 2.0f, 4.0f, 8.0f };
+
+        // Seed of the droplets of Erode, fixed so a map erodes the same
+        // every time
+        constexpr UINT EROSION_SEED = 0x5EEDu;
+
+        constexpr XMFLOAT3 BIOME_COLORS[] =
+        {
+            XMFLOAT3(0.0f,      0.666f, 0.0f),      // GRASSLAND
+            XMFLOAT3(1.0f,      1.0f,   1.0f),      // SNOW
+            XMFLOAT3(0.0f,      0.0f,   0.666f),    // OCEAN
+            XMFLOAT3(1.0f,      0.666f, 0.0f),      // SAND
+            XMFLOAT3(0.666f,    0.0f,   0.0f),      // SCORCHED
+            XMFLOAT3(0.956f,    0.643f, 0.376f),    // BARE
+            XMFLOAT3(0.941f,    0.0f,   1.0f),      // TUNDRA
+            XMFLOAT3(0.803f,    0.521f, 0.247f),    // TEMPERATE_DESERT
+            XMFLOAT3(0.42f,     0.556f, 0.137f),    // SHRUBLAND
+            XMFLOAT3(0.0f,      0.392f, 0.0f),      // TAIGA
+            XMFLOAT3(1.0f,      0.55f,  0.0f),      // TEMPERATE_DECIDUOUS_FOREST
+            XMFLOAT3(0.0f,      0.5f,   0.0f),      // TEMPERATE_RAIN_FOREST
+            XMFLOAT3(0.956f,    0.643f, 0.376f),    // SUBTROPICAL_DESERT
+            XMFLOAT3(0.133f,    0.545f, 0.133f),    // TROPICAL_SEASONAL_FOREST
+            XMFLOAT3(0.15f,     0.372f, 0.15f),     // TROPICAL_RAIN_FOREST
+        };
+
+        /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+          Struct:   BiomeRule
+
+          Summary:  Biome of the moisture below MaxMoisture in a height
+                    band
+        S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+        struct BiomeRule
+        {
+            FLOAT MaxMoisture;
+            eBlockType BlockType;
+        };
+
+        constexpr UINT NUM_BIOME_RULES = 4u;
+
+        // Rules of each height band from the lowest band up, checked in
+        // order. The last rule of a band takes any moisture left
+        constexpr BiomeRule BIOME_TABLE[][NUM_BIOME_RULES] =
+        {
+            // Below 0.1
+            {
+                { 0.0f,  eBlockType::OCEAN },
+                { 0.0f,  eBlockType::OCEAN },
+                { 0.0f,  eBlockType::OCEAN },
+                { 0.0f,  eBlockType::OCEAN },
+            },
+            // Below 0.12
+            {
+                { 0.0f,  eBlockType::SAND },
+                { 0.0f,  eBlockType::SAND },
+                { 0.0f,  eBlockType::SAND },
+                { 0.0f,  eBlockType::SAND },
+            },
+            // Up to 0.3
+            {
+                { 0.16f, eBlockType::SUBTROPICAL_DESERT },
+                { 0.33f, eBlockType::GRASSLAND },
+                { 0.66f, eBlockType::TROPICAL_SEASONAL_FOREST },
+                { 0.0f,  eBlockType::TROPICAL_RAIN_FOREST },
+            },
+            // Up to 0.6
+            {
+                { 0.16f, eBlockType::TEMPERATE_DESERT },
+                { 0.5f,  eBlockType::GRASSLAND },
+                { 0.83f, eBlockType::TEMPERATE_DECIDUOUS_FOREST },
+                { 0.0f,  eBlockType::TEMPERATE_RAIN_FOREST },
+            },
+            // Up to 0.8
+            {
+                { 0.33f, eBlockType::TEMPERATE_DESERT },
+                { 0.66f, eBlockType::SHRUBLAND },
+                { 0.66f, eBlockType::SHRUBLAND },
+                { 0.0f,  eBlockType::TAIGA },
+            },
+            // Above 0.8
+            {
+                { 0.1f,  eBlockType::SCORCHED },
+                { 0.2f,  eBlockType::BARE },
+                { 0.5f,  eBlockType::TUNDRA },
+                { 0.0f,  eBlockType::SNOW },
+            },
+        };
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: getHeightBand
+
+          Summary:  Returns the row of BIOME_TABLE of a height
+        -----------------------------------------------------------------F-F*/
+        UINT getHeightBand(_In_ FLOAT height)
+        {
+            if (height < 0.1f)
+            {
+                return 0u;
+            }
+            if (height < 0.12f)
+            {
+                return 1u;
+            }
+            if (height > 0.8f)
+            {
+                return 5u;
+            }
+            if (height > 0.6f)
+            {
+                return 4u;
+            }
+            if (height > 0.3f)
+            {
+                return 3u;
+            }
+            return 2u;
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainGenerator::TerrainGenerator
+
+      Summary:  Constructor
+
+      Args:     UINT uWidth
+                UINT uHeight
+                UINT uDepth
+                  Columns along x and z, and the cubes of a column of
+                  height 1
+                UINT uNumThreads
+                  Number of threads, 0 for one per hardware thread
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    TerrainGenerator::TerrainGenerator(_In_ UINT uWidth, _In_ UINT uHeight, _In_ UINT uDepth, _In_ UINT uNumThreads)
+        : m_aHeights(static_cast<size_t>(uWidth) * uDepth, 0.0f)
+        , m_aMoistures(static_cast<size_t>(uWidth) * uDepth, 0.0f)
+        , m_heightMap{
+            .uWidth = uWidth,
+            .uHeight = uHeight,
+            .uDepth = uDepth,
+            .uMaxColumnHeight = 0u,
+            .aColors = std::vector<XMFLOAT3>(std::begin(BIOME_COLORS), std::end(BIOME_COLORS)),
+            .aColumnBlocks = std::vector<BYTE>(static_cast<size_t>(uWidth) * uDepth, EMPTY_BLOCK),
+            .aColumnHeights = std::vector<WORD>(static_cast<size_t>(uWidth) * uDepth, 0u),
+        }
+        , m_threadPool(std::make_unique<ThreadPool>(uNumThreads))
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainGenerator::Generate
+
+      Summary:  Generates the fields and the height map, blocks of
+                TERRAIN_ROWS_PER_TASK rows at a time in parallel
+
+      Modifies: [m_aHeights, m_aMoistures, m_heightMap].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TerrainGenerator::Generate()
+    {
+        const UINT uNumTasks = (m_heightMap.uDepth + TERRAIN_ROWS_PER_TASK - 1u) / TERRAIN_ROWS_PER_TASK;
+        m_threadPool->ParallelFor(uNumTasks, [this](UINT uTask)
+        {
+            generateRows(uTask * TERRAIN_ROWS_PER_TASK, std::min((uTask + 1u) * TERRAIN_ROWS_PER_TASK, m_heightMap.uDepth));
+        });
+
+        updateMaxColumnHeight();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainGenerator::Erode
+
+      Summary:  Runs droplets and then thermal erosion over the
+                generated heights on the thread pool, and classifies
+                and quantizes the columns again from the eroded heights
+                and the moisture they were generated with
+
+      Args:     UINT uNumDroplets
+                  Droplets over the whole map, about one per column
+                  carves visible valleys
+                UINT uNumThermalIterations
+                  Iterations of thermal erosion after the droplets
+
+      Modifies: [m_aHeights, m_heightMap].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TerrainGenerator::Erode(_In_ UINT uNumDroplets, _In_ UINT uNumThermalIterations)
+    {
+        TerrainEroder eroder(m_heightMap.uWidth, m_heightMap.uDepth, static_cast<FLOAT>(m_heightMap.uHeight));
+        eroder.ErodeHydraulic(m_aHeights, uNumDroplets, EROSION_SEED, m_threadPool.get());
+        eroder.ErodeThermal(m_aHeights, uNumThermalIterations, m_threadPool.get());
+
+        const UINT uNumTasks = (m_heightMap.uDepth + TERRAIN_ROWS_PER_TASK - 1u) / TERRAIN_ROWS_PER_TASK;
+        m_threadPool->ParallelFor(uNumTasks, [this](UINT uTask)
+        {
+            classifyRows(uTask * TERRAIN_ROWS_PER_TASK, std::min((uTask + 1u) * TERRAIN_ROWS_PER_TASK, m_heightMap.uDepth));
+        });
+
+        updateMaxColumnHeight();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainGenerator::ClassifyBiome
+
+      Summary:  Looks the biome up from the height band and the moisture
+
+      Args:     FLOAT height
+                FLOAT moisture
+                  Fields of the column
+
+      Returns:  eBlockType
+                  Block type of the column
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    eBlockType TerrainGenerator::ClassifyBiome(_In_ FLOAT height, _In_ FLOAT moisture)
+    {
+        const BiomeRule (&aRules)[NUM_BIOME_RULES] = BIOME_TABLE[getHeightBand(height)];
+        for (UINT i = 0u; i < NUM_BIOME_RULES - 1u; ++i)
+        {
+            if (moisture < aRules[i].MaxMoisture)
+            {
+                return aRules[i].BlockType;
+            }
+        }
+
+        return aRules[NUM_BIOME_RULES - 1u].BlockType;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainGenerator::SetNumThreads
+
+      Summary:  Replaces the thread pool
+
+      Args:     UINT uNumThreads
+                  Number of threads, 0 for one per hardware thread
+
+      Modifies: [m_threadPool].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TerrainGenerator::SetNumThreads(_In_ UINT uNumThreads)
+    {
+        m_threadPool.reset();
+        m_threadPool = std::make_unique<ThreadPool>(uNumThreads);
+    }
+
+    UINT TerrainGenerator::GetNumThreads() const
+    {
+        return m_threadPool->GetNumThreads();
+    }
+
+    const std::vector<FLOAT>& TerrainGenerator::GetHeights() const
+    {
+        return m_aHeights;
+    }
+
+    const std::vector<FLOAT>& TerrainGenerator::GetMoistures() const
+    {
+        return m_aMoistures;
+    }
+
+    const HeightMap& TerrainGenerator::GetHeightMap() const
+    {
+        return m_heightMap;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainGenerator::generateRows
+
+      Summary:  Generates the columns of a block of rows
+
+      Args:     UINT uFirstZ
+                UINT uLastZ
+                  Rows [uFirstZ, uLastZ) to generate
+
+      Modifies: [m_aHeights, m_aMoistures, m_heightMap].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TerrainGenerator::generateRows(_In_ UINT uFirstZ, _In_ UINT uLastZ)
+    {
+        const UINT uWidth = m_heightMap.uWidth;
+        const eNoiseLanes lanes = GetMaxNoiseLanes();
+
+        std::vector<FLOAT> aX(uWidth);
+        std::vector<FLOAT> aZ(uWidth);
+        std::vector<FLOAT> aNoise(uWidth);
+        std::vector<FLOAT> aValues(uWidth);
+
+        for (UINT z = uFirstZ; z < uLastZ; ++z)
+        {
+            // Each octave of a row is sampled as one batch, and the
+            // octaves are summed in the same order per column as one
+            // column at a time would
+            std::fill(aValues.begin(), aValues.end(), 0.0f);
+            FLOAT frequencySum = 0.0f;
+            for (FLOAT frequency : OCTAVE_FREQUENCIES)
+            {
+                frequencySum += 1.0f / frequency;
+                for (UINT x = 0u; x < uWidth; ++x)
+                {
+                    aX[x] = frequency * static_cast<FLOAT>(x);
+                }
+                std::fill(aZ.begin(), aZ.end(), frequency * static_cast<FLOAT>(z));
+
+                SamplePerlin2dBatch(aX.data(), aZ.data(), uWidth, 0.1f, 4u, aNoise.data(), lanes);
+                for (UINT x = 0u; x < uWidth; ++x)
+                {
+                    aValues[x] += aNoise[x] / frequency;
+                }
+            }
+
+            for (UINT x = 0u; x < uWidth; ++x)
+            {
+                size_t columnIdx = static_cast<size_t>(z) * uWidth + x;
+
+                FLOAT height = std::pow(aValues[x] / frequencySum * 1.2f, 1.25f);
+                assert(height >= 0.0f);
+
+                // Moisture samples the same noise as height, as the
+                // generator always has, so it is not sampled twice
+                FLOAT moisture = height;
+
+                m_aHeights[columnIdx] = height;
+                m_aMoistures[columnIdx] = moisture;
+            }
+        }
+
+        classifyRows(uFirstZ, uLastZ);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainGenerator::classifyRows
+
+      Summary:  Looks up the biome and quantizes the height of the
+                columns of a block of rows from their fields
+
+      Args:     UINT uFirstZ
+                UINT uLastZ
+                  Rows [uFirstZ, uLastZ) to classify
+
+      Modifies: [m_heightMap].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TerrainGenerator::classifyRows(_In_ UINT uFirstZ, _In_ UINT uLastZ)
+    {
+        const size_t uFirst = static_cast<size_t>(uFirstZ) * m_heightMap.uWidth;
+        const size_t uLast = static_cast<size_t>(uLastZ) * m_heightMap.uWidth;
+        for (size_t columnIdx = uFirst; columnIdx < uLast; ++columnIdx)
+        {
+            m_heightMap.aColumnBlocks[columnIdx] = static_cast<BYTE>(ClassifyBiome(m_aHeights[columnIdx], m_aMoistures[columnIdx]));
+            m_heightMap.aColumnHeights[columnIdx] = QuantizeColumnHeight(m_heightMap.uHeight, m_aHeights[columnIdx]);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainGenerator::updateMaxColumnHeight
+
+      Summary:  Finds the tallest column of the height map
+
+      Modifies: [m_heightMap].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TerrainGenerator::updateMaxColumnHeight()
+    {
+        m_heightMap.uMaxColumnHeight = 0u;
+        for (WORD columnHeight : m_heightMap.aColumnHeights)
+        {
+            m_heightMap.uMaxColumnHeight = std::max(m_heightMap.uMaxColumnHeight, static_cast<UINT>(columnHeight));
+        }
+    }
+}
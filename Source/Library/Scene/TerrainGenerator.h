@@ -0,0 +1,88 @@
+/*+===================================================================
+  File:      TERRAINGENERATOR.H
+
+  Summary:   TerrainGenerator header file contains declarations of the
+             generator that fills the height, moisture and biome fields
+             of a procedural height map in parallel, erodes it and
+             hands it to a scene without going through a file.
+
+  Classes: TerrainGenerator
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Platform/ThreadPool.h"
+#include "Scene/HeightMapFile.h"
+#include "Scene/TerrainEroder.h"
+
+namespace library
+{
+    // Rows of cells generated by one task of the parallel loop
+    constexpr UINT TERRAIN_ROWS_PER_TASK = 8u;
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    TerrainGenerator
+
+      Summary:  Samples fractal Perlin noise for the height and moisture
+                of every column, then looks the biome of the column up
+                from its height band and moisture. Blocks of rows are
+                generated on a thread pool, each writing only its own
+                rows of the fields. The heights can then be eroded on
+                the same pool, which classifies the biomes again
+
+      Methods:  Generate
+                  Fills the fields and the height map
+                Erode
+                  Erodes the heights and updates the height map
+                ClassifyBiome
+                  Returns the block type of a height and moisture
+                SetNumThreads
+                  Replaces the thread pool
+                GetNumThreads
+                  Returns the number of threads generating rows
+                GetHeights / GetMoistures
+                  Return the fields, x fastest then z
+                GetHeightMap
+                  Returns the height map to build a scene from
+                TerrainGenerator
+                  Constructor.
+                ~TerrainGenerator
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class TerrainGenerator final
+    {
+    public:
+        TerrainGenerator(_In_ UINT uWidth, _In_ UINT uHeight, _In_ UINT uDepth, _In_ UINT uNumThreads = 0u);
+        TerrainGenerator(const TerrainGenerator& other) = delete;
+        TerrainGenerator(TerrainGenerator&& other) = delete;
+        TerrainGenerator& operator=(const TerrainGenerator& other) = delete;
+        TerrainGenerator& operator=(TerrainGenerator&& other) = delete;
+        ~TerrainGenerator() = default;
+
+        void Generate();
+        void Erode(_In_ UINT uNumDroplets, _In_ UINT uNumThermalIterations);
+
+        static eBlockType ClassifyBiome(_In_ FLOAT height, _In_ FLOAT moisture);
+
+        void SetNumThreads(_In_ UINT uNumThreads);
+        UINT GetNumThreads() const;
+
+        const std::vector<FLOAT>& GetHeights() const;
+        const std::vector<FLOAT>& GetMoistures() const;
+        const HeightMap& GetHeightMap() const;
+
+    private:
+        void generateRows(_In_ UINT uFirstZ, _In_ UINT uLastZ);
+        void classifyRows(_In_ UINT uFirstZ, _In_ UINT uLastZ);
+        void updateMaxColumnHeight();
+
+    private:
+        std::vector<FLOAT> m_aHeights;
+        std::vector<FLOAT> m_aMoistures;
+        HeightMap m_heightMap;
+        std::unique_ptr<ThreadPool> m_threadPool;
+    };
+}
@@ -14,6 +14,7 @@ namespace library
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     Voxel::Voxel(_In_ const XMFLOAT4& outputColor)
         : InstancedRenderable(outputColor)
+        , m_bOccluded(FALSE)
     {}
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -29,6 +30,7 @@ namespace library
 
     Voxel::Voxel(_In_ std::vector<InstanceData>&& aInstanceData, _In_ const XMFLOAT4& outputColor)
         : InstancedRenderable(std::move(aInstanceData), outputColor)
+        , m_bOccluded(FALSE)
     {}
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -113,6 +115,36 @@ namespace library
         return NUM_INDICES;
     }
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Voxel::IsOccluded
+
+      Summary:  Returns whether the voxel was found hidden from the
+                camera behind other voxels, in which case it is not
+                drawn at all
+
+      Returns:  BOOL
+                  TRUE if the voxel is hidden
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL Voxel::IsOccluded() const
+    {
+        return m_bOccluded;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Voxel::SetOccluded
+
+      Summary:  Marks the voxel hidden from the camera or not
+
+      Args:     BOOL bOccluded
+                  Whether the voxel is hidden
+
+      Modifies: [m_bOccluded].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Voxel::SetOccluded(_In_ BOOL bOccluded)
+    {
+        m_bOccluded = bOccluded;
+    }
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Voxel::getVertices
 
@@ -23,7 +23,11 @@ namespace library
 
       Summary:  Base class for renderable 3d cube object
 
-      Methods:  Voxel
+      Methods:  IsOccluded
+                  Returns whether the voxel is hidden from the camera
+                SetOccluded
+                  Marks the voxel hidden or not for the next frame
+                Voxel
                   Constructor.
                 ~Voxel
                   Destructor.
@@ -45,6 +49,9 @@ namespace library
         UINT GetNumVertices() const override;
         UINT GetNumIndices() const override;
 
+        BOOL IsOccluded() const;
+        void SetOccluded(_In_ BOOL bOccluded);
+
     protected:
         const SimpleVertex* getVertices() const override;
         const WORD* getIndices() const override;
@@ -104,5 +111,8 @@ namespace library
             23,20,22
         };
         static constexpr const UINT NUM_INDICES = 36u;
+
+    private:
+        BOOL m_bOccluded;
     };
 }
\ No newline at end of file
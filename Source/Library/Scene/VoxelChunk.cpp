@@ -0,0 +1,604 @@
+#include "Scene/VoxelChunk.h"
+
+#include "Texture/Material.h"
+
+namespace library
+{
+    namespace
+    {
+        // Light reaching a face corner with 0 to 3 of its neighbours
+        // open, carried as the length of the vertex normal
+        constexpr FLOAT AMBIENT_OCCLUSION[4] = { 0.4f, 0.6f, 0.8f, 1.0f };
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: getAmbientOcclusion
+
+          Summary:  Finds how open the four corners of a face are from
+                    the two cells beside each corner and the one
+                    diagonal to it in the layer the face looks into. A
+                    corner between two solid sides is fully closed
+                    whatever the diagonal holds
+
+          Args:     const VoxelGrid& grid
+                      Grid holding the cells around the face
+                    const INT (&anNeighbor)[3]
+                      Cell the face looks into
+                    UINT uU
+                    UINT uV
+                      Axes the face spans
+
+          Returns:  BYTE
+                      Openness 0 to 3 of corner k in bits 2k and 2k + 1,
+                      corners running along u then v
+        -----------------------------------------------------------------F-F*/
+        BYTE getAmbientOcclusion(_In_ const VoxelGrid& grid, _In_ const INT (&anNeighbor)[3], _In_ UINT uU, _In_ UINT uV)
+        {
+            static constexpr const INT CORNER_U[4] = { -1, 1, 1, -1 };
+            static constexpr const INT CORNER_V[4] = { -1, -1, 1, 1 };
+
+            auto isSolid = [&grid, &anNeighbor, uU, uV](INT nU, INT nV)
+            {
+                INT anCell[3] = { anNeighbor[0], anNeighbor[1], anNeighbor[2] };
+                anCell[uU] += nU;
+                anCell[uV] += nV;
+                return grid.GetBlock(anCell[0], anCell[1], anCell[2]) != EMPTY_BLOCK ? 1u : 0u;
+            };
+
+            BYTE ambientOcclusion = 0u;
+            for (UINT k = 0u; k < 4u; ++k)
+            {
+                UINT uSideU = isSolid(CORNER_U[k], 0);
+                UINT uSideV = isSolid(0, CORNER_V[k]);
+                UINT uOpen = uSideU == 1u && uSideV == 1u ? 0u : 3u - uSideU - uSideV - isSolid(CORNER_U[k], CORNER_V[k]);
+                ambientOcclusion |= static_cast<BYTE>(uOpen << (2u * k));
+            }
+
+            return ambientOcclusion;
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: getTexCoordAxes
+
+          Summary:  Picks the grid axes a face's texture coordinates
+                    follow, so the texture stands upright on the sides
+                    like on the faces of Voxel
+
+          Args:     UINT uAxis
+                      Axis the face points along
+                    UINT& uS
+                    UINT& uT
+                      Axes of the u and v texture coordinates
+                    FLOAT& tSign
+                      -1 if v runs down the world y axis
+        -----------------------------------------------------------------F-F*/
+        void getTexCoordAxes(_In_ UINT uAxis, _Out_ UINT& uS, _Out_ UINT& uT, _Out_ FLOAT& tSign)
+        {
+            switch (uAxis)
+            {
+            case 0u:
+                uS = 2u;
+                uT = 1u;
+                tSign = -1.0f;
+                break;
+            case 1u:
+                uS = 0u;
+                uT = 2u;
+                tSign = 1.0f;
+                break;
+            default:
+                uS = 0u;
+                uT = 1u;
+                tSign = -1.0f;
+                break;
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunk::VoxelChunk
+
+      Summary:  Constructor
+
+      Args:     INT nChunkX
+                INT nChunkY
+                INT nChunkZ
+                  Chunk coordinates, the first cell of the chunk in
+                  the world is VOXEL_CHUNK_SIZE times these
+                UINT uLod
+                  Level of detail, the cells of the chunk are 2^uLod
+                  blocks on a side so its y counts chunks of those
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    VoxelChunk::VoxelChunk(_In_ INT nChunkX, _In_ INT nChunkY, _In_ INT nChunkZ, _In_ UINT uLod)
+        : Voxel(std::vector<InstanceData>{ InstanceData{ .anCell = { 0, 0, 0 }, .nBlockType = EMPTY_BLOCK } }, XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f))
+        , m_anChunk{ nChunkX, nChunkY, nChunkZ }
+        , m_uLod(uLod)
+        , m_aVertices()
+        , m_aIndices()
+        , m_auVisibility()
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunk::Initialize
+
+      Summary:  Creates the buffers of the mesh built by Mesh
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the buffers
+                ID3D11DeviceContext* pImmediateContext
+                  The Direct3D context to set buffers
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT VoxelChunk::Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext)
+    {
+        BasicMeshEntry basicMeshEntry;
+        basicMeshEntry.uNumIndices = GetNumIndices();
+
+        m_aMeshes.push_back(basicMeshEntry);
+
+        HRESULT hr = initialize(pDevice, pImmediateContext);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        hr = initializeInstance(pDevice);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        if (HasTexture() > 0)
+        {
+            hr = SetMaterialOfMesh(0, 0);
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+        }
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunk::Update
+
+      Summary:  Updates the chunk every frame
+
+      Args:     FLOAT deltaTime
+                  Elapsed time
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelChunk::Update(_In_ FLOAT deltaTime)
+    {
+        UNREFERENCED_PARAMETER(deltaTime);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunk::Mesh
+
+      Summary:  Sweeps every layer of the chunk along each axis in both
+                directions. A layer is reduced to a mask of the blocks
+                whose face in that direction borders an empty cell,
+                neighbouring chunks included, and the mask is covered
+                by rectangles of one block type, each grown as wide as
+                it goes and then as tall as whole rows allow. The
+                ambient occlusion of the corners of each face is baked
+                into the mask too, and faces only merge along an axis
+                their corners do not change along, so a rectangle
+                shades exactly like the faces it covers. The visibility
+                of each cube of VOXEL_CHUNK_SIZE blocks in the chunk is
+                found last. Only reads the grid, so chunks can be
+                meshed in parallel
+
+      Args:     const VoxelGrid& grid
+                  Grid holding the cells of the chunk and the cells
+                  bordering it
+                const INT (&anFirstCell)[3]
+                  Cell of the grid where the chunk starts
+
+      Modifies: [m_aVertices, m_aIndices, m_auVisibility].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelChunk::Mesh(_In_ const VoxelGrid& grid, _In_ const INT (&anFirstCell)[3])
+    {
+        m_aVertices.clear();
+        m_aIndices.clear();
+
+        const UINT auGridSize[3] = { grid.GetWidth(), grid.GetHeight(), grid.GetDepth() };
+        const INT* anBase = anFirstCell;
+        UINT auSize[3];
+        for (UINT i = 0u; i < 3u; ++i)
+        {
+            auSize[i] = std::min(VOXEL_CHUNK_SIZE, auGridSize[i] - std::min(auGridSize[i], static_cast<UINT>(anBase[i])));
+        }
+
+        // Block in the low byte and corner openness in the high byte
+        WORD aMask[VOXEL_CHUNK_SIZE * VOXEL_CHUNK_SIZE];
+        for (UINT uAxis = 0u; uAxis < 3u; ++uAxis)
+        {
+            const UINT uU = (uAxis + 1u) % 3u;
+            const UINT uV = (uAxis + 2u) % 3u;
+
+            for (UINT uDirection = 0u; uDirection < 2u; ++uDirection)
+            {
+                const BOOL bPositive = uDirection == 1u;
+
+                for (UINT uLayer = 0u; uLayer < auSize[uAxis]; ++uLayer)
+                {
+                    INT anCell[3];
+                    INT anNeighbor[3];
+                    anCell[uAxis] = anBase[uAxis] + static_cast<INT>(uLayer);
+                    anNeighbor[uAxis] = anCell[uAxis] + (bPositive ? 1 : -1);
+
+                    BOOL bAnyFace = FALSE;
+                    for (UINT j = 0u; j < auSize[uV]; ++j)
+                    {
+                        anCell[uV] = anNeighbor[uV] = anBase[uV] + static_cast<INT>(j);
+                        for (UINT i = 0u; i < auSize[uU]; ++i)
+                        {
+                            anCell[uU] = anNeighbor[uU] = anBase[uU] + static_cast<INT>(i);
+
+                            BYTE block = grid.GetBlock(anCell[0], anCell[1], anCell[2]);
+                            if (block == EMPTY_BLOCK || grid.GetBlock(anNeighbor[0], anNeighbor[1], anNeighbor[2]) != EMPTY_BLOCK)
+                            {
+                                aMask[j * VOXEL_CHUNK_SIZE + i] = EMPTY_BLOCK;
+                                continue;
+                            }
+                            aMask[j * VOXEL_CHUNK_SIZE + i] = static_cast<WORD>(block | (getAmbientOcclusion(grid, anNeighbor, uU, uV) << 8u));
+                            bAnyFace = TRUE;
+                        }
+                    }
+
+                    if (!bAnyFace)
+                    {
+                        continue;
+                    }
+
+                    // Faces lie on the far side of the layer when they point forward
+                    INT anCorner[3];
+                    anCorner[uAxis] = anCell[uAxis] + (bPositive ? 1 : 0);
+
+                    for (UINT j = 0u; j < auSize[uV]; ++j)
+                    {
+                        for (UINT i = 0u; i < auSize[uU];)
+                        {
+                            const WORD face = aMask[j * VOXEL_CHUNK_SIZE + i];
+                            if (face == EMPTY_BLOCK)
+                            {
+                                ++i;
+                                continue;
+                            }
+
+                            // Faces only merge along an axis their shading
+                            // is constant along, which a larger rectangle
+                            // would otherwise stretch
+                            const BYTE ambientOcclusion = static_cast<BYTE>(face >> 8u);
+                            const UINT auOpen[4] = { ambientOcclusion & 3u, (ambientOcclusion >> 2u) & 3u, (ambientOcclusion >> 4u) & 3u, (ambientOcclusion >> 6u) & 3u };
+                            const BOOL bMergeU = auOpen[0] == auOpen[1] && auOpen[3] == auOpen[2];
+                            const BOOL bMergeV = auOpen[0] == auOpen[3] && auOpen[1] == auOpen[2];
+
+                            UINT uWidth = 1u;
+                            while (bMergeU && i + uWidth < auSize[uU] && aMask[j * VOXEL_CHUNK_SIZE + i + uWidth] == face)
+                            {
+                                ++uWidth;
+                            }
+
+                            UINT uHeight = 1u;
+                            for (; bMergeV && j + uHeight < auSize[uV]; ++uHeight)
+                            {
+                                const WORD* pRow = aMask + (j + uHeight) * VOXEL_CHUNK_SIZE + i;
+                                if (std::any_of(pRow, pRow + uWidth, [face](WORD other) { return other != face; }))
+                                {
+                                    break;
+                                }
+                            }
+
+                            anCorner[uU] = anBase[uU] + static_cast<INT>(i);
+                            anCorner[uV] = anBase[uV] + static_cast<INT>(j);
+                            addQuad(grid, anCorner, uAxis, bPositive, uWidth, uHeight, ambientOcclusion);
+
+                            for (UINT uRow = 0u; uRow < uHeight; ++uRow)
+                            {
+                                std::fill_n(aMask + (j + uRow) * VOXEL_CHUNK_SIZE + i, uWidth, static_cast<WORD>(EMPTY_BLOCK));
+                            }
+                            i += uWidth;
+                        }
+                    }
+                }
+            }
+        }
+
+        // A coarser chunk is as wide as a full detail one but 2^lod
+        // times as tall, so it stacks that many cubes
+        const UINT uEdge = VOXEL_CHUNK_SIZE >> m_uLod;
+        m_auVisibility.resize(1u << m_uLod);
+        for (UINT uCube = 0u; uCube < m_auVisibility.size(); ++uCube)
+        {
+            const INT anCubeCell[3] = { anBase[0], anBase[1] + static_cast<INT>(uCube * uEdge), anBase[2] };
+            m_auVisibility[uCube] = computeVisibility(grid, anCubeCell, uEdge);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunk::computeVisibility
+
+      Summary:  Floods each connected set of empty cells of a cube and
+                connects every pair of faces of the cube the set
+                touches. Cells above the grid are empty, so the sky
+                joins the faces of the top cube
+
+      Args:     const VoxelGrid& grid
+                  Grid holding the cells of the chunk
+                const INT (&anFirstCell)[3]
+                  Cell of the grid where the cube starts
+                UINT uEdge
+                  Cells along each edge of the cube
+
+      Returns:  UINT64
+                  Bit 6 * a + b set when faces a and b see each other
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT64 VoxelChunk::computeVisibility(_In_ const VoxelGrid& grid, _In_ const INT (&anFirstCell)[3], _In_ UINT uEdge) const
+    {
+        const UINT uNumCells = uEdge * uEdge * uEdge;
+
+        // Cells are x fastest, then z, then y, and stay set while open
+        // and not yet flooded
+        std::vector<BYTE> aOpen(uNumCells);
+        UINT uNumOpen = 0u;
+        for (UINT y = 0u; y < uEdge; ++y)
+        {
+            for (UINT z = 0u; z < uEdge; ++z)
+            {
+                for (UINT x = 0u; x < uEdge; ++x)
+                {
+                    const BOOL bOpen = grid.GetBlock(anFirstCell[0] + static_cast<INT>(x), anFirstCell[1] + static_cast<INT>(y), anFirstCell[2] + static_cast<INT>(z)) == EMPTY_BLOCK;
+                    aOpen[(y * uEdge + z) * uEdge + x] = bOpen ? 1u : 0u;
+                    uNumOpen += bOpen ? 1u : 0u;
+                }
+            }
+        }
+
+        if (uNumOpen == 0u)
+        {
+            return 0u;
+        }
+        if (uNumOpen == uNumCells)
+        {
+            return VOXEL_CHUNK_ALL_FACES_CONNECTED;
+        }
+
+        UINT64 uVisibility = 0u;
+        std::vector<UINT> auStack;
+        for (UINT uSeed = 0u; uSeed < uNumCells; ++uSeed)
+        {
+            if (aOpen[uSeed] == 0u)
+            {
+                continue;
+            }
+
+            aOpen[uSeed] = 0u;
+            auStack.push_back(uSeed);
+
+            UINT uFaces = 0u;
+            while (!auStack.empty())
+            {
+                const UINT uCell = auStack.back();
+                auStack.pop_back();
+
+                const UINT auCell[3] = { uCell % uEdge, uCell / (uEdge * uEdge), (uCell / uEdge) % uEdge };
+                const UINT auStride[3] = { 1u, uEdge * uEdge, uEdge };
+                for (UINT uAxis = 0u; uAxis < 3u; ++uAxis)
+                {
+                    if (auCell[uAxis] == 0u)
+                    {
+                        uFaces |= 1u << (2u * uAxis);
+                    }
+                    else if (aOpen[uCell - auStride[uAxis]] != 0u)
+                    {
+                        aOpen[uCell - auStride[uAxis]] = 0u;
+                        auStack.push_back(uCell - auStride[uAxis]);
+                    }
+
+                    if (auCell[uAxis] == uEdge - 1u)
+                    {
+                        uFaces |= 1u << (2u * uAxis + 1u);
+                    }
+                    else if (aOpen[uCell + auStride[uAxis]] != 0u)
+                    {
+                        aOpen[uCell + auStride[uAxis]] = 0u;
+                        auStack.push_back(uCell + auStride[uAxis]);
+                    }
+                }
+            }
+
+            for (UINT uFace = 0u; uFace < VOXEL_CHUNK_NUM_FACES; ++uFace)
+            {
+                if ((uFaces >> uFace) & 1u)
+                {
+                    uVisibility |= static_cast<UINT64>(uFaces) << (uFace * VOXEL_CHUNK_NUM_FACES);
+                }
+            }
+        }
+
+        return uVisibility;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunk::addQuad
+
+      Summary:  Appends a merged rectangle as four vertices and two
+                clockwise triangles seen from the side it faces. The
+                texture repeats once per cell. The normal of each
+                vertex is scaled by the light reaching its corner, and
+                the rectangle is split along the diagonal of the more
+                open corners so a dark corner stays in one triangle
+
+      Args:     const VoxelGrid& grid
+                  Grid that places the cells in the world
+                const INT (&anCorner)[3]
+                  Lattice point of the first corner
+                UINT uAxis
+                  Axis the rectangle faces along
+                BOOL bPositive
+                  Whether it faces the positive direction of the axis
+                UINT uWidth
+                UINT uHeight
+                  Blocks covered along the next two axes
+                BYTE ambientOcclusion
+                  Openness 0 to 3 of corner k in bits 2k and 2k + 1
+
+      Modifies: [m_aVertices, m_aIndices].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelChunk::addQuad(_In_ const VoxelGrid& grid, _In_ const INT (&anCorner)[3], _In_ UINT uAxis, _In_ BOOL bPositive, _In_ UINT uWidth, _In_ UINT uHeight, _In_ BYTE ambientOcclusion)
+    {
+        const UINT uU = (uAxis + 1u) % 3u;
+        const UINT uV = (uAxis + 2u) % 3u;
+
+        UINT uS;
+        UINT uT;
+        FLOAT tSign;
+        getTexCoordAxes(uAxis, uS, uT, tSign);
+
+        FLOAT aNormal[3] = { 0.0f, 0.0f, 0.0f };
+        aNormal[uAxis] = bPositive ? 1.0f : -1.0f;
+
+        const FLOAT aOrigin[3] = { grid.GetOrigin().x, grid.GetOrigin().y, grid.GetOrigin().z };
+        const FLOAT cellSize = grid.GetCellSize();
+        const UINT auOffsetU[4] = { 0u, uWidth, uWidth, 0u };
+        const UINT auOffsetV[4] = { 0u, 0u, uHeight, uHeight };
+
+        UINT auOpen[4];
+        const WORD uBaseVertex = static_cast<WORD>(m_aVertices.size());
+        for (UINT k = 0u; k < 4u; ++k)
+        {
+            auOpen[k] = (ambientOcclusion >> (2u * k)) & 3u;
+            const FLOAT light = AMBIENT_OCCLUSION[auOpen[k]];
+
+            INT anLattice[3] = { anCorner[0], anCorner[1], anCorner[2] };
+            anLattice[uU] += static_cast<INT>(auOffsetU[k]);
+            anLattice[uV] += static_cast<INT>(auOffsetV[k]);
+
+            m_aVertices.push_back(
+                SimpleVertex
+                {
+                    .Position = XMFLOAT3(
+                        aOrigin[0] + cellSize * static_cast<FLOAT>(anLattice[0]),
+                        aOrigin[1] + cellSize * static_cast<FLOAT>(anLattice[1]),
+                        aOrigin[2] + cellSize * static_cast<FLOAT>(anLattice[2])
+                    ),
+                    .TexCoord = XMFLOAT2(static_cast<FLOAT>(anLattice[uS]), tSign * static_cast<FLOAT>(anLattice[uT])),
+                    .Normal = XMFLOAT3(light * aNormal[0], light * aNormal[1], light * aNormal[2])
+                }
+            );
+        }
+
+        // Corners run along u then v, so 0 1 2 is clockwise seen from
+        // the positive side of the axis
+        static constexpr const WORD FORWARD[] = { 0, 1, 2, 0, 2, 3 };
+        static constexpr const WORD BACKWARD[] = { 0, 2, 1, 0, 3, 2 };
+        static constexpr const WORD FLIPPED_FORWARD[] = { 0, 1, 3, 1, 2, 3 };
+        static constexpr const WORD FLIPPED_BACKWARD[] = { 0, 3, 1, 1, 3, 2 };
+
+        const BOOL bFlip = auOpen[0] + auOpen[2] < auOpen[1] + auOpen[3];
+        const WORD* pIndices = bFlip ? (bPositive ? FLIPPED_FORWARD : FLIPPED_BACKWARD) : (bPositive ? FORWARD : BACKWARD);
+        for (UINT k = 0u; k < 6u; ++k)
+        {
+            m_aIndices.push_back(static_cast<WORD>(uBaseVertex + pIndices[k]));
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunk::GetNumQuads
+
+      Summary:  Returns the number of merged rectangles in the mesh
+
+      Returns:  UINT
+                  Number of rectangles
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT VoxelChunk::GetNumQuads() const
+    {
+        return static_cast<UINT>(m_aVertices.size() / 4u);
+    }
+
+    INT VoxelChunk::GetChunkX() const
+    {
+        return m_anChunk[0];
+    }
+
+    INT VoxelChunk::GetChunkY() const
+    {
+        return m_anChunk[1];
+    }
+
+    INT VoxelChunk::GetChunkZ() const
+    {
+        return m_anChunk[2];
+    }
+
+    UINT VoxelChunk::GetLod() const
+    {
+        return m_uLod;
+    }
+
+    UINT VoxelChunk::GetNumVisibilityCubes() const
+    {
+        return static_cast<UINT>(m_auVisibility.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunk::GetVisibility
+
+      Summary:  Returns which faces of a cube of the chunk see each
+                other through its open cells
+
+      Args:     UINT uCube
+                  Cube counted from the bottom of the chunk
+
+      Returns:  UINT64
+                  Bit 6 * a + b set when faces a and b see each other
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT64 VoxelChunk::GetVisibility(_In_ UINT uCube) const
+    {
+        return m_auVisibility[uCube];
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunk::AreFacesConnected
+
+      Summary:  Returns whether two faces of a cube see each other
+
+      Args:     UINT64 uVisibility
+                  Visibility of the cube
+                UINT uFace
+                UINT uOtherFace
+                  Faces, 2 * axis + 1 for the positive side of an axis
+
+      Returns:  BOOL
+                  TRUE if an open path joins the faces
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL VoxelChunk::AreFacesConnected(_In_ UINT64 uVisibility, _In_ UINT uFace, _In_ UINT uOtherFace)
+    {
+        return (uVisibility >> (uFace * VOXEL_CHUNK_NUM_FACES + uOtherFace)) & 1u ? TRUE : FALSE;
+    }
+
+    UINT VoxelChunk::GetNumVertices() const
+    {
+        return static_cast<UINT>(m_aVertices.size());
+    }
+
+    UINT VoxelChunk::GetNumIndices() const
+    {
+        return static_cast<UINT>(m_aIndices.size());
+    }
+
+    const SimpleVertex* VoxelChunk::getVertices() const
+    {
+        return m_aVertices.data();
+    }
+
+    const WORD* VoxelChunk::getIndices() const
+    {
+        return m_aIndices.data();
+    }
+}
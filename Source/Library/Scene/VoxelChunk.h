@@ -0,0 +1,125 @@
+/*+===================================================================
+  File:      VOXELCHUNK.H
+
+  Summary:   VoxelChunk header file contains declarations of the
+             greedy meshed chunk of a voxel grid, drawn in place of one
+             cube instance per block.
+
+  Classes: VoxelChunk
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Scene/Voxel.h"
+#include "Scene/VoxelGrid.h"
+
+namespace library
+{
+    // Cells along each edge of a chunk. A chunk of alternating blocks
+    // stays below the 65536 vertices WORD indices can address
+    constexpr UINT VOXEL_CHUNK_SIZE = 16u;
+
+    // Faces of a chunk, 2 * axis for the negative side of an axis and
+    // 2 * axis + 1 for the positive side
+    constexpr UINT VOXEL_CHUNK_NUM_FACES = 6u;
+
+    // Visibility of a cube every face of which sees every other, bit
+    // 6 * a + b telling whether faces a and b are joined by open cells
+    constexpr UINT64 VOXEL_CHUNK_ALL_FACES_CONNECTED = (UINT64(1) << (VOXEL_CHUNK_NUM_FACES * VOXEL_CHUNK_NUM_FACES)) - 1u;
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    VoxelChunk
+
+      Summary:  Mesh of the faces of a VOXEL_CHUNK_SIZE cube of cells
+                that border an empty cell. Coplanar faces of the same
+                block type are merged into the largest rectangles the
+                greedy sweep finds, so a flat surface costs two
+                triangles rather than two per block. Each vertex
+                carries the ambient occlusion of its corner as the
+                length of its normal. The vertices are
+                in world space and the chunk is drawn as a voxel with
+                one identity instance, so it takes the voxel shaders
+                and material unchanged. Its world matrix is identity
+                too, so the renderer culls the chunk and orders it by
+                depth from the bounds of its vertices, not from its
+                origin. Meshing also floods the open
+                cells of each cube of VOXEL_CHUNK_SIZE blocks the chunk
+                covers and records which of its faces can see each
+                other through them, which the streamer walks to cull
+                the chunks no line of sight from the camera reaches
+
+      Methods:  Initialize
+                  Creates the buffers of the mesh
+                Update
+                  Updates the chunk every frame
+                Mesh
+                  Builds the mesh from the cells of a grid
+                GetChunkX / GetChunkY / GetChunkZ
+                  Return the chunk coordinates
+                GetLod
+                  Returns the level of detail the chunk was meshed at
+                GetNumVisibilityCubes
+                  Returns the number of cubes of VOXEL_CHUNK_SIZE
+                  blocks stacked in the chunk
+                GetVisibility
+                  Returns which faces of a cube see each other
+                AreFacesConnected
+                  Returns whether two faces of a cube see each other
+                GetNumQuads
+                  Returns the number of merged rectangles
+                GetNumVertices
+                  Returns the number of vertices
+                GetNumIndices
+                  Returns the number of indices
+                VoxelChunk
+                  Constructor.
+                ~VoxelChunk
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class VoxelChunk : public Voxel
+    {
+    public:
+        VoxelChunk(_In_ INT nChunkX, _In_ INT nChunkY, _In_ INT nChunkZ, _In_ UINT uLod = 0u);
+        VoxelChunk(const VoxelChunk& other) = delete;
+        VoxelChunk(VoxelChunk&& other) = delete;
+        VoxelChunk& operator=(const VoxelChunk& other) = delete;
+        VoxelChunk& operator=(VoxelChunk&& other) = delete;
+        ~VoxelChunk() = default;
+
+        virtual HRESULT Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext) override;
+        virtual void Update(_In_ FLOAT deltaTime) override;
+
+        void Mesh(_In_ const VoxelGrid& grid, _In_ const INT (&anFirstCell)[3]);
+
+        INT GetChunkX() const;
+        INT GetChunkY() const;
+        INT GetChunkZ() const;
+        UINT GetLod() const;
+        UINT GetNumVisibilityCubes() const;
+        UINT64 GetVisibility(_In_ UINT uCube) const;
+
+        static BOOL AreFacesConnected(_In_ UINT64 uVisibility, _In_ UINT uFace, _In_ UINT uOtherFace);
+
+        UINT GetNumQuads() const;
+        UINT GetNumVertices() const override;
+        UINT GetNumIndices() const override;
+
+    protected:
+        const SimpleVertex* getVertices() const override;
+        const WORD* getIndices() const override;
+
+    private:
+        UINT64 computeVisibility(_In_ const VoxelGrid& grid, _In_ const INT (&anFirstCell)[3], _In_ UINT uEdge) const;
+        void addQuad(_In_ const VoxelGrid& grid, _In_ const INT (&anCorner)[3], _In_ UINT uAxis, _In_ BOOL bPositive, _In_ UINT uWidth, _In_ UINT uHeight, _In_ BYTE ambientOcclusion);
+
+    private:
+        INT m_anChunk[3];
+        UINT m_uLod;
+        std::vector<SimpleVertex> m_aVertices;
+        std::vector<WORD> m_aIndices;
+        std::vector<UINT64> m_auVisibility;
+    };
+}
@@ -0,0 +1,1027 @@
+#include "Scene/VoxelChunkStreamer.h"
+
+namespace library
+{
+    namespace
+    {
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: getChunkOfPosition
+
+          Summary:  Finds the chunk a world coordinate lies in along one
+                    axis, rounding down for positions below the origin
+
+          Args:     FLOAT position
+                      World coordinate
+                    FLOAT origin
+                      World coordinate of the corner of cell 0
+
+          Returns:  INT
+                      Chunk coordinate
+        -----------------------------------------------------------------F-F*/
+        INT getChunkOfPosition(_In_ FLOAT position, _In_ FLOAT origin)
+        {
+            return static_cast<INT>(floorf((position - origin) / (BLOCK_SIZE * static_cast<FLOAT>(VOXEL_CHUNK_SIZE))));
+        }
+
+        // Chunk coordinate step across each face, 2 * axis for the
+        // negative side of an axis
+        constexpr INT FACE_OFFSETS[VOXEL_CHUNK_NUM_FACES][3] =
+        {
+            { -1, 0, 0 }, { 1, 0, 0 },
+            { 0, -1, 0 }, { 0, 1, 0 },
+            { 0, 0, -1 }, { 0, 0, 1 },
+        };
+
+        /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+          Struct:   VisibilityStep
+
+          Summary:  Cube reached by the culling walk, the face it was
+                    entered through, VOXEL_CHUNK_NUM_FACES for the cube
+                    of the camera, and the faces every step so far left
+                    through
+        S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+        struct VisibilityStep
+        {
+            INT anCube[3];
+            UINT uEntryFace;
+            UINT uDirections;
+        };
+
+        INT getDistanceSquared(_In_ const std::pair<INT, INT>& column, _In_ INT nCenterX, _In_ INT nCenterZ)
+        {
+            INT nX = column.first - nCenterX;
+            INT nZ = column.second - nCenterZ;
+
+            return nX * nX + nZ * nZ;
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: getLodOfDistance
+
+          Summary:  Counts the rings a distance is at or beyond
+
+          Args:     FLOAT distance
+                      Chunks from the camera
+
+          Returns:  UINT
+                      Level of detail
+        -----------------------------------------------------------------F-F*/
+        UINT getLodOfDistance(_In_ FLOAT distance)
+        {
+            UINT uLod = 0u;
+            while (uLod < VOXEL_NUM_LODS - 1u && distance >= VOXEL_LOD_RING_RADII[uLod])
+            {
+                ++uLod;
+            }
+
+            return uLod;
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: downsampleColumn
+
+          Summary:  Sets each cell of a coarse grid to the most common
+                    block of the cube of fine cells it covers, ties
+                    going to the lower block type. A cell is empty only
+                    when its whole cube is, so the coarse surface never
+                    sinks below the fine one and leaves no holes next
+                    to finer columns
+
+          Args:     const VoxelGrid& column
+                      Fine grid
+                    UINT uFactor
+                      Fine cells along each edge of a coarse cell
+                    VoxelGrid& coarseColumn
+                      Grid uFactor times coarser to fill
+        -----------------------------------------------------------------F-F*/
+        void downsampleColumn(_In_ const VoxelGrid& column, _In_ UINT uFactor, _Inout_ VoxelGrid& coarseColumn)
+        {
+            UINT auCounts[256] = {};
+            std::vector<BYTE> aSeenBlocks;
+            aSeenBlocks.reserve(8u);
+
+            for (UINT y = 0u; y < coarseColumn.GetHeight(); ++y)
+            {
+                for (UINT k = 0u; k < coarseColumn.GetDepth(); ++k)
+                {
+                    for (UINT i = 0u; i < coarseColumn.GetWidth(); ++i)
+                    {
+                        for (UINT uY = y * uFactor; uY < (y + 1u) * uFactor; ++uY)
+                        {
+                            for (UINT uZ = k * uFactor; uZ < (k + 1u) * uFactor; ++uZ)
+                            {
+                                for (UINT uX = i * uFactor; uX < (i + 1u) * uFactor; ++uX)
+                                {
+                                    BYTE block = column.GetBlock(static_cast<INT>(uX), static_cast<INT>(uY), static_cast<INT>(uZ));
+                                    if (block != EMPTY_BLOCK && auCounts[block]++ == 0u)
+                                    {
+                                        aSeenBlocks.push_back(block);
+                                    }
+                                }
+                            }
+                        }
+
+                        if (aSeenBlocks.empty())
+                        {
+                            continue;
+                        }
+
+                        BYTE representative = aSeenBlocks[0];
+                        for (BYTE block : aSeenBlocks)
+                        {
+                            if (auCounts[block] > auCounts[representative] || (auCounts[block] == auCounts[representative] && block < representative))
+                            {
+                                representative = block;
+                            }
+                        }
+                        for (BYTE block : aSeenBlocks)
+                        {
+                            auCounts[block] = 0u;
+                        }
+                        aSeenBlocks.clear();
+
+                        coarseColumn.SetBlock(i, y, k, representative);
+                    }
+                }
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkStreamer::VoxelChunkStreamer
+
+      Summary:  Constructor. Starts the loader thread
+
+      Args:     VoxelColumnSource source
+                  Fills the cells of a column
+                UINT uHeight
+                  Number of cells in a column, bottom to top
+                const XMFLOAT3& origin
+                  World position of the corner of world cell (0, 0, 0)
+                UINT uRadius
+                  Chunks from the camera to keep resident
+
+      Modifies: [m_source, m_uHeight, m_origin, m_uRadius, m_loader,
+                  m_uNextTicket, m_uNumInFlight, m_bStop].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    VoxelChunkStreamer::VoxelChunkStreamer(_In_ VoxelColumnSource source, _In_ UINT uHeight, _In_ const XMFLOAT3& origin, _In_ UINT uRadius)
+        : m_source(std::move(source))
+        , m_uHeight(uHeight)
+        , m_origin(origin)
+        , m_uRadius(uRadius)
+        , m_residentColumns()
+        , m_loadingColumns()
+        , m_dirtyChunks()
+        , m_uNextTicket(0u)
+        , m_abVisited()
+        , m_occlusionStatistics{ .uNumChunks = 0u, .uNumVisitedCubes = 0u, .uNumCulledChunks = 0u }
+        , m_threadPool()
+        , m_loader()
+        , m_mutex()
+        , m_wakeCondition()
+        , m_doneCondition()
+        , m_aRequests()
+        , m_aLoadedColumns()
+        , m_uNumInFlight(0u)
+        , m_bStop(FALSE)
+    {
+        m_loader = std::thread(&VoxelChunkStreamer::loaderMain, this);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkStreamer::~VoxelChunkStreamer
+
+      Summary:  Destructor. Stops the loader thread once the batch it
+                is loading is done
+
+      Modifies: [m_bStop, m_loader].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    VoxelChunkStreamer::~VoxelChunkStreamer()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_bStop = TRUE;
+        }
+        m_wakeCondition.notify_all();
+
+        m_loader.join();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkStreamer::Update
+
+      Summary:  Releases the columns more than one chunk beyond the
+                radius and stops requests for them, then requests the
+                columns inside the radius that are neither loaded nor
+                loading, nearest first, along with the loaded ones that
+                moved to another level of detail. Edited chunks of full
+                detail columns are remeshed right away, coarser columns
+                are requested again. Finally takes a few finished
+                columns, or waits for every request and takes all of
+                them. A remeshed column replaces its old chunks. The
+                caller creates the buffers of the loaded chunks and
+                stops drawing the unloaded ones
+
+      Args:     const XMFLOAT3& cameraPosition
+                  World position of the camera
+                BOOL bWait
+                  Whether to block until every requested column is
+                  loaded, for the first frame
+                std::vector<std::shared_ptr<VoxelChunk>>& aLoadedChunks
+                  Set to the chunks that became resident
+                std::vector<std::shared_ptr<VoxelChunk>>& aUnloadedChunks
+                  Set to the chunks that were released
+
+      Modifies: [m_residentColumns, m_loadingColumns, m_dirtyChunks,
+                  m_uNextTicket, m_aRequests, m_aLoadedColumns].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelChunkStreamer::Update(
+        _In_ const XMFLOAT3& cameraPosition,
+        _In_ BOOL bWait,
+        _Out_ std::vector<std::shared_ptr<VoxelChunk>>& aLoadedChunks,
+        _Out_ std::vector<std::shared_ptr<VoxelChunk>>& aUnloadedChunks
+    )
+    {
+        aLoadedChunks.clear();
+        aUnloadedChunks.clear();
+
+        const INT nCenterX = getChunkOfPosition(cameraPosition.x, m_origin.x);
+        const INT nCenterZ = getChunkOfPosition(cameraPosition.z, m_origin.z);
+        const INT nLoadRadius = static_cast<INT>(m_uRadius);
+        const INT nUnloadRadiusSquared = (nLoadRadius + 1) * (nLoadRadius + 1);
+
+        // Levels of detail go by the distance to the middle of a column
+        // in chunks, which changes smoothly as the camera moves
+        const FLOAT chunkSize = BLOCK_SIZE * static_cast<FLOAT>(VOXEL_CHUNK_SIZE);
+        const FLOAT cameraX = (cameraPosition.x - m_origin.x) / chunkSize;
+        const FLOAT cameraZ = (cameraPosition.z - m_origin.z) / chunkSize;
+
+        for (auto it = m_residentColumns.begin(); it != m_residentColumns.end();)
+        {
+            if (getDistanceSquared(it->first, nCenterX, nCenterZ) > nUnloadRadiusSquared)
+            {
+                aUnloadedChunks.insert(aUnloadedChunks.end(), it->second.aChunks.begin(), it->second.aChunks.end());
+                it = m_residentColumns.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        // Columns still in the queue are not loaded at all, ones already
+        // taken by the loader are dropped when they come back
+        std::erase_if(m_loadingColumns, [nCenterX, nCenterZ, nUnloadRadiusSquared](const std::pair<const std::pair<INT, INT>, ColumnRequest>& column)
+            {
+                return getDistanceSquared(column.first, nCenterX, nCenterZ) > nUnloadRadiusSquared;
+            }
+        );
+
+        // Edited columns that were not resident are requested below
+        // like any other
+        std::vector<ColumnRequest> aNewRequests;
+        for (const auto& [key, chunkYs] : m_dirtyChunks)
+        {
+            auto resident = m_residentColumns.find(key);
+            if (resident == m_residentColumns.end())
+            {
+                continue;
+            }
+
+            if (resident->second.uLod == 0u)
+            {
+                remeshChunks(resident->second, chunkYs, aLoadedChunks, aUnloadedChunks);
+            }
+            else
+            {
+                aNewRequests.push_back(ColumnRequest{ .Key = key, .uLod = resident->second.uLod, .uTicket = m_uNextTicket++ });
+                m_loadingColumns[key] = aNewRequests.back();
+            }
+        }
+        m_dirtyChunks.clear();
+
+        for (INT nZ = nCenterZ - nLoadRadius; nZ <= nCenterZ + nLoadRadius; ++nZ)
+        {
+            for (INT nX = nCenterX - nLoadRadius; nX <= nCenterX + nLoadRadius; ++nX)
+            {
+                std::pair<INT, INT> column(nX, nZ);
+                if (getDistanceSquared(column, nCenterX, nCenterZ) > nLoadRadius * nLoadRadius || m_loadingColumns.contains(column))
+                {
+                    continue;
+                }
+
+                const FLOAT distance = hypotf(static_cast<FLOAT>(nX) + 0.5f - cameraX, static_cast<FLOAT>(nZ) + 0.5f - cameraZ);
+
+                UINT uLod;
+                auto resident = m_residentColumns.find(column);
+                if (resident == m_residentColumns.end())
+                {
+                    uLod = getLodOfDistance(distance);
+                }
+                else
+                {
+                    uLod = SelectLod(distance, resident->second.uLod);
+                    if (uLod == resident->second.uLod)
+                    {
+                        continue;
+                    }
+                }
+
+                aNewRequests.push_back(ColumnRequest{ .Key = column, .uLod = uLod, .uTicket = m_uNextTicket++ });
+                m_loadingColumns[column] = aNewRequests.back();
+            }
+        }
+        std::sort(aNewRequests.begin(), aNewRequests.end(), [nCenterX, nCenterZ](const ColumnRequest& a, const ColumnRequest& b)
+            {
+                return getDistanceSquared(a.Key, nCenterX, nCenterZ) < getDistanceSquared(b.Key, nCenterX, nCenterZ);
+            }
+        );
+
+        std::vector<LoadedColumn> aLoadedColumns;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+
+            std::erase_if(m_aRequests, [this](const ColumnRequest& request)
+                {
+                    auto loading = m_loadingColumns.find(request.Key);
+                    return loading == m_loadingColumns.end() || loading->second.uTicket != request.uTicket;
+                }
+            );
+            m_aRequests.insert(m_aRequests.end(), aNewRequests.begin(), aNewRequests.end());
+            m_wakeCondition.notify_one();
+
+            if (bWait)
+            {
+                m_doneCondition.wait(lock, [this] { return m_aRequests.empty() && m_uNumInFlight == 0u; });
+            }
+
+            size_t numTaken = bWait ? m_aLoadedColumns.size() : std::min<size_t>(m_aLoadedColumns.size(), VOXEL_COLUMN_UPLOADS_PER_UPDATE);
+            aLoadedColumns.insert(aLoadedColumns.end(), std::make_move_iterator(m_aLoadedColumns.begin()), std::make_move_iterator(m_aLoadedColumns.begin() + numTaken));
+            m_aLoadedColumns.erase(m_aLoadedColumns.begin(), m_aLoadedColumns.begin() + numTaken);
+        }
+
+        for (LoadedColumn& column : aLoadedColumns)
+        {
+            auto loading = m_loadingColumns.find(column.Key);
+            if (loading == m_loadingColumns.end() || loading->second.uTicket != column.uTicket)
+            {
+                continue;
+            }
+            m_loadingColumns.erase(loading);
+
+            auto resident = m_residentColumns.find(column.Key);
+            if (resident != m_residentColumns.end())
+            {
+                aUnloadedChunks.insert(aUnloadedChunks.end(), resident->second.aChunks.begin(), resident->second.aChunks.end());
+            }
+
+            aLoadedChunks.insert(aLoadedChunks.end(), column.aChunks.begin(), column.aChunks.end());
+            m_residentColumns[column.Key] = std::move(column);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkStreamer::InvalidateCell
+
+      Summary:  Marks the chunks that read a cell after it was edited,
+                its own and the ones across any chunk face it touches,
+                whose border holds it. A load in flight for one of
+                their columns read the cells before the edit, so it is
+                dropped and the column is requested again. Called on
+                the updating thread
+
+      Args:     INT nX
+                INT nY
+                INT nZ
+                  World cell that was edited
+
+      Modifies: [m_loadingColumns, m_dirtyChunks].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelChunkStreamer::InvalidateCell(_In_ INT nX, _In_ INT nY, _In_ INT nZ)
+    {
+        const INT nChunkSize = static_cast<INT>(VOXEL_CHUNK_SIZE);
+        const INT anCell[3] = { nX, nY, nZ };
+
+        INT anFirstChunk[3];
+        INT anLastChunk[3];
+        for (UINT i = 0u; i < 3u; ++i)
+        {
+            const INT nChunk = anCell[i] >= 0 ? anCell[i] / nChunkSize : (anCell[i] + 1) / nChunkSize - 1;
+            const INT nOffset = anCell[i] - nChunk * nChunkSize;
+            anFirstChunk[i] = nOffset == 0 ? nChunk - 1 : nChunk;
+            anLastChunk[i] = nOffset == nChunkSize - 1 ? nChunk + 1 : nChunk;
+        }
+
+        for (INT nChunkZ = anFirstChunk[2]; nChunkZ <= anLastChunk[2]; ++nChunkZ)
+        {
+            for (INT nChunkX = anFirstChunk[0]; nChunkX <= anLastChunk[0]; ++nChunkX)
+            {
+                const std::pair<INT, INT> key(nChunkX, nChunkZ);
+                m_loadingColumns.erase(key);
+
+                std::set<INT>& chunkYs = m_dirtyChunks[key];
+                for (INT nChunkY = std::max(anFirstChunk[1], 0); nChunkY <= anLastChunk[1]; ++nChunkY)
+                {
+                    chunkYs.insert(nChunkY);
+                }
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkStreamer::ReleaseColumnsOfChunks
+
+      Summary:  Releases the resident columns holding any of the given
+                chunks, for chunks handed back by Update whose buffers
+                could not be created. The columns are no longer
+                resident, so the next Update requests them again
+                instead of leaving holes. Called on the updating thread
+
+      Args:     const std::vector<std::shared_ptr<VoxelChunk>>& aChunks
+                  Chunks that could not be made drawable
+                std::vector<std::shared_ptr<VoxelChunk>>& aUnloadedChunks
+                  Set to every chunk of the released columns, which the
+                  caller stops drawing
+
+      Modifies: [m_residentColumns].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelChunkStreamer::ReleaseColumnsOfChunks(_In_ const std::vector<std::shared_ptr<VoxelChunk>>& aChunks, _Out_ std::vector<std::shared_ptr<VoxelChunk>>& aUnloadedChunks)
+    {
+        aUnloadedChunks.clear();
+
+        std::unordered_set<const VoxelChunk*> chunks;
+        for (const std::shared_ptr<VoxelChunk>& chunk : aChunks)
+        {
+            chunks.insert(chunk.get());
+        }
+
+        std::erase_if(m_residentColumns, [&chunks, &aUnloadedChunks](const std::pair<const std::pair<INT, INT>, LoadedColumn>& column)
+            {
+                const BOOL bFailed = std::any_of(column.second.aChunks.begin(), column.second.aChunks.end(), [&chunks](const std::shared_ptr<VoxelChunk>& chunk)
+                    {
+                        return chunks.contains(chunk.get());
+                    }
+                );
+                if (bFailed)
+                {
+                    aUnloadedChunks.insert(aUnloadedChunks.end(), column.second.aChunks.begin(), column.second.aChunks.end());
+                }
+                return bFailed;
+            }
+        );
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkStreamer::GetNumResidentColumns
+
+      Summary:  Returns the number of loaded columns, empty ones
+                included
+
+      Returns:  UINT
+                  Number of columns
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT VoxelChunkStreamer::GetNumResidentColumns() const
+    {
+        return static_cast<UINT>(m_residentColumns.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkStreamer::GetLodStatistics
+
+      Summary:  Adds up the resident columns of each level of detail
+
+      Args:     VoxelLodStatistics (&aStatistics)[VOXEL_NUM_LODS]
+                  Set to the columns, instances and triangles of each
+                  level
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelChunkStreamer::GetLodStatistics(_Out_ VoxelLodStatistics (&aStatistics)[VOXEL_NUM_LODS]) const
+    {
+        std::fill(std::begin(aStatistics), std::end(aStatistics), VoxelLodStatistics{ .uNumColumns = 0u, .uNumInstances = 0u, .uNumTriangles = 0u });
+
+        for (const auto& [key, column] : m_residentColumns)
+        {
+            VoxelLodStatistics& statistics = aStatistics[column.uLod];
+            ++statistics.uNumColumns;
+            for (const std::shared_ptr<VoxelChunk>& chunk : column.aChunks)
+            {
+                ++statistics.uNumInstances;
+                statistics.uNumTriangles += chunk->GetNumIndices() / 3u;
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkStreamer::ReportLodStatistics
+
+      Summary:  Writes the columns, instances and triangles of each
+                level of detail ring to the debug output
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelChunkStreamer::ReportLodStatistics() const
+    {
+        VoxelLodStatistics aStatistics[VOXEL_NUM_LODS];
+        GetLodStatistics(aStatistics);
+
+        for (UINT uLod = 0u; uLod < VOXEL_NUM_LODS; ++uLod)
+        {
+            WCHAR szMessage[256];
+            swprintf_s(
+                szMessage,
+                L"voxel lod %u  cell %2u  columns %5u  instances %6u  triangles %9u\n",
+                uLod,
+                1u << uLod,
+                aStatistics[uLod].uNumColumns,
+                aStatistics[uLod].uNumInstances,
+                aStatistics[uLod].uNumTriangles
+            );
+            OutputDebugString(szMessage);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkStreamer::CullOccludedChunks
+
+      Summary:  Hides every resident chunk, then walks the cubes of
+                VOXEL_CHUNK_SIZE blocks breadth first from the cube of
+                the camera and shows the chunks of the cubes it
+                reaches. A step leaves a cube through a face only when
+                open cells join it to the face the cube was entered
+                through, never goes back against a direction taken
+                before, so the walk only bends away from the camera,
+                and only enters cubes in the frustum. The cubes of
+                columns still loading and a layer of sky above the
+                world are open, and a cube is visited once for each
+                face it is entered through. Chunks no open path from
+                the camera reaches stay hidden. With the camera outside
+                the resident columns every chunk is shown
+
+      Args:     const XMFLOAT3& cameraPosition
+                  World position of the camera
+                const FrustumCuller& frustum
+                  Culler holding the planes of the camera frustum
+
+      Modifies: [m_abVisited, m_occlusionStatistics].
+
+      Returns:  UINT
+                  Number of chunks hidden
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT VoxelChunkStreamer::CullOccludedChunks(_In_ const XMFLOAT3& cameraPosition, _In_ const FrustumCuller& frustum)
+    {
+        m_occlusionStatistics = VoxelOcclusionStatistics{ .uNumChunks = 0u, .uNumVisitedCubes = 0u, .uNumCulledChunks = 0u };
+        if (m_residentColumns.empty())
+        {
+            return 0u;
+        }
+
+        INT anMin[3] = { m_residentColumns.begin()->first.first, 0, m_residentColumns.begin()->first.second };
+        INT anMax[3] = { anMin[0], static_cast<INT>(getNumLayers()), anMin[2] };
+        for (const auto& [key, column] : m_residentColumns)
+        {
+            anMin[0] = std::min(anMin[0], key.first);
+            anMax[0] = std::max(anMax[0], key.first);
+            anMin[2] = std::min(anMin[2], key.second);
+            anMax[2] = std::max(anMax[2], key.second);
+        }
+
+        const INT nSizeX = anMax[0] - anMin[0] + 1;
+        const INT nSizeY = anMax[1] + 1;
+        const INT nSizeZ = anMax[2] - anMin[2] + 1;
+        std::vector<LoadedColumn*> apColumns(static_cast<size_t>(nSizeX * nSizeZ), nullptr);
+        for (auto& [key, column] : m_residentColumns)
+        {
+            apColumns[(key.second - anMin[2]) * nSizeX + key.first - anMin[0]] = &column;
+            for (const std::shared_ptr<VoxelChunk>& chunk : column.aChunks)
+            {
+                chunk->SetOccluded(TRUE);
+            }
+            m_occlusionStatistics.uNumChunks += static_cast<UINT>(column.aChunks.size());
+        }
+
+        // The sky layer stands for everything above the world, and the
+        // bottom layer for everything below it
+        const INT anCamera[3] =
+        {
+            getChunkOfPosition(cameraPosition.x, m_origin.x),
+            std::clamp(getChunkOfPosition(cameraPosition.y, m_origin.y), 0, anMax[1]),
+            getChunkOfPosition(cameraPosition.z, m_origin.z),
+        };
+        if (anCamera[0] < anMin[0] || anCamera[0] > anMax[0] || anCamera[2] < anMin[2] || anCamera[2] > anMax[2])
+        {
+            for (auto& [key, column] : m_residentColumns)
+            {
+                for (const std::shared_ptr<VoxelChunk>& chunk : column.aChunks)
+                {
+                    chunk->SetOccluded(FALSE);
+                }
+            }
+            return 0u;
+        }
+
+        // One bit for each face a cube was entered through and one for
+        // the cube of the camera
+        m_abVisited.assign(static_cast<size_t>(nSizeX * nSizeY * nSizeZ), 0u);
+        auto getCubeIndex = [nSizeX, nSizeY, &anMin](const INT (&anCube)[3])
+        {
+            return static_cast<size_t>(((anCube[2] - anMin[2]) * nSizeY + anCube[1]) * nSizeX + anCube[0] - anMin[0]);
+        };
+
+        const FLOAT cubeSize = BLOCK_SIZE * static_cast<FLOAT>(VOXEL_CHUNK_SIZE);
+        const XMFLOAT3 extents(0.5f * cubeSize, 0.5f * cubeSize, 0.5f * cubeSize);
+        const FLOAT aOrigin[3] = { m_origin.x, m_origin.y, m_origin.z };
+
+        std::vector<VisibilityStep> aQueue;
+        aQueue.push_back(VisibilityStep{ .anCube = { anCamera[0], anCamera[1], anCamera[2] }, .uEntryFace = VOXEL_CHUNK_NUM_FACES, .uDirections = 0u });
+        m_abVisited[getCubeIndex(aQueue.back().anCube)] = 1u << VOXEL_CHUNK_NUM_FACES;
+        m_occlusionStatistics.uNumVisitedCubes = 1u;
+
+        UINT uNumShownChunks = 0u;
+        for (size_t head = 0u; head < aQueue.size(); ++head)
+        {
+            const VisibilityStep step = aQueue[head];
+
+            UINT64 uVisibility = VOXEL_CHUNK_ALL_FACES_CONNECTED;
+            const LoadedColumn* pColumn = apColumns[(step.anCube[2] - anMin[2]) * nSizeX + step.anCube[0] - anMin[0]];
+            if (pColumn != nullptr && step.anCube[1] < anMax[1])
+            {
+                uVisibility = pColumn->auVisibility[step.anCube[1]];
+
+                const INT nChunkY = step.anCube[1] >> pColumn->uLod;
+                auto it = std::lower_bound(pColumn->aChunks.begin(), pColumn->aChunks.end(), nChunkY, [](const std::shared_ptr<VoxelChunk>& other, INT nY)
+                    {
+                        return other->GetChunkY() < nY;
+                    }
+                );
+                if (it != pColumn->aChunks.end() && (*it)->GetChunkY() == nChunkY && (*it)->IsOccluded())
+                {
+                    (*it)->SetOccluded(FALSE);
+                    ++uNumShownChunks;
+                }
+            }
+
+            for (UINT uFace = 0u; uFace < VOXEL_CHUNK_NUM_FACES; ++uFace)
+            {
+                if ((step.uDirections >> (uFace ^ 1u)) & 1u)
+                {
+                    continue;
+                }
+                if (step.uEntryFace < VOXEL_CHUNK_NUM_FACES && !VoxelChunk::AreFacesConnected(uVisibility, step.uEntryFace, uFace))
+                {
+                    continue;
+                }
+
+                VisibilityStep next = { .anCube = { step.anCube[0], step.anCube[1], step.anCube[2] }, .uEntryFace = uFace ^ 1u, .uDirections = step.uDirections | (1u << uFace) };
+                BOOL bInside = TRUE;
+                XMFLOAT3 center;
+                FLOAT* pCenter = &center.x;
+                for (UINT uAxis = 0u; uAxis < 3u; ++uAxis)
+                {
+                    next.anCube[uAxis] += FACE_OFFSETS[uFace][uAxis];
+                    bInside = bInside && next.anCube[uAxis] >= anMin[uAxis] && next.anCube[uAxis] <= anMax[uAxis];
+                    pCenter[uAxis] = aOrigin[uAxis] + cubeSize * (static_cast<FLOAT>(next.anCube[uAxis]) + 0.5f);
+                }
+                if (!bInside)
+                {
+                    continue;
+                }
+
+                BYTE& nextVisited = m_abVisited[getCubeIndex(next.anCube)];
+                if ((nextVisited >> next.uEntryFace) & 1u)
+                {
+                    continue;
+                }
+
+                UINT uPlaneMask = FRUSTUM_ALL_PLANES;
+                if (!frustum.IsBoxVisible(center, extents, uPlaneMask))
+                {
+                    continue;
+                }
+
+                if (nextVisited == 0u)
+                {
+                    ++m_occlusionStatistics.uNumVisitedCubes;
+                }
+                nextVisited |= static_cast<BYTE>(1u << next.uEntryFace);
+                aQueue.push_back(next);
+            }
+        }
+
+        m_occlusionStatistics.uNumCulledChunks = m_occlusionStatistics.uNumChunks - uNumShownChunks;
+
+        return m_occlusionStatistics.uNumCulledChunks;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkStreamer::GetOcclusionStatistics
+
+      Summary:  Returns the chunks, the cubes visited and the chunks
+                hidden by the last culling walk
+
+      Returns:  const VoxelOcclusionStatistics&
+                  Statistics of the last walk
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const VoxelOcclusionStatistics& VoxelChunkStreamer::GetOcclusionStatistics() const
+    {
+        return m_occlusionStatistics;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkStreamer::ReportOcclusionStatistics
+
+      Summary:  Writes the statistics of the last culling walk to the
+                debug output
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelChunkStreamer::ReportOcclusionStatistics() const
+    {
+        WCHAR szMessage[256];
+        swprintf_s(
+            szMessage,
+            L"voxel occlusion  chunks %6u  cubes visited %6u  chunks culled %6u\n",
+            m_occlusionStatistics.uNumChunks,
+            m_occlusionStatistics.uNumVisitedCubes,
+            m_occlusionStatistics.uNumCulledChunks
+        );
+        OutputDebugString(szMessage);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkStreamer::SelectLod
+
+      Summary:  Picks the level of detail of a column. It only turns
+                coarser once the column is the hysteresis margin past
+                the ring it crossed, and finer once it is the margin
+                inside it, otherwise it keeps its level
+
+      Args:     FLOAT distance
+                  Chunks from the camera to the middle of the column
+                UINT uCurrentLod
+                  Level the column is meshed at
+
+      Returns:  UINT
+                  Level of detail to mesh the column at
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT VoxelChunkStreamer::SelectLod(_In_ FLOAT distance, _In_ UINT uCurrentLod)
+    {
+        UINT uCoarserLod = getLodOfDistance(distance - VOXEL_LOD_HYSTERESIS);
+        if (uCoarserLod > uCurrentLod)
+        {
+            return uCoarserLod;
+        }
+
+        UINT uFinerLod = getLodOfDistance(distance + VOXEL_LOD_HYSTERESIS);
+        if (uFinerLod < uCurrentLod)
+        {
+            return uFinerLod;
+        }
+
+        return uCurrentLod;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkStreamer::loaderMain
+
+      Summary:  Loop of the loader thread. Takes every queued request
+                at once and loads the batch across the pool
+
+      Modifies: [m_aRequests, m_aLoadedColumns, m_uNumInFlight].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelChunkStreamer::loaderMain()
+    {
+        for (;;)
+        {
+            std::vector<ColumnRequest> aBatch;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_wakeCondition.wait(lock, [this] { return m_bStop || !m_aRequests.empty(); });
+                if (m_bStop)
+                {
+                    return;
+                }
+
+                aBatch.swap(m_aRequests);
+                m_uNumInFlight = static_cast<UINT>(aBatch.size());
+            }
+
+            std::vector<LoadedColumn> aColumns(aBatch.size());
+            m_threadPool.ParallelFor(static_cast<UINT>(aBatch.size()), [this, &aBatch, &aColumns](UINT uColumnIdx)
+                {
+                    aColumns[uColumnIdx] = loadColumn(aBatch[uColumnIdx]);
+                }
+            );
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_aLoadedColumns.insert(m_aLoadedColumns.end(), std::make_move_iterator(aColumns.begin()), std::make_move_iterator(aColumns.end()));
+                m_uNumInFlight = 0u;
+            }
+            m_doneCondition.notify_all();
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkStreamer::fillColumn
+
+      Summary:  Creates the grid of a column and fills it from the
+                source
+
+      Args:     const std::pair<INT, INT>& key
+                  Chunk x and z of the column
+                UINT uBorder
+                  Cells bordering the column to fill on each side
+
+      Returns:  std::unique_ptr<VoxelGrid>
+                  Filled column
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    std::unique_ptr<VoxelGrid> VoxelChunkStreamer::fillColumn(_In_ const std::pair<INT, INT>& key, _In_ UINT uBorder) const
+    {
+        const INT nFirstX = key.first * static_cast<INT>(VOXEL_CHUNK_SIZE) - static_cast<INT>(uBorder);
+        const INT nFirstZ = key.second * static_cast<INT>(VOXEL_CHUNK_SIZE) - static_cast<INT>(uBorder);
+
+        std::unique_ptr<VoxelGrid> column = std::make_unique<VoxelGrid>(
+            VOXEL_CHUNK_SIZE + 2u * uBorder,
+            m_uHeight,
+            VOXEL_CHUNK_SIZE + 2u * uBorder,
+            XMFLOAT3(
+                m_origin.x + BLOCK_SIZE * static_cast<FLOAT>(nFirstX),
+                m_origin.y,
+                m_origin.z + BLOCK_SIZE * static_cast<FLOAT>(nFirstZ)
+            )
+        );
+        m_source(nFirstX, nFirstZ, *column);
+
+        return column;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkStreamer::getNumLayers
+
+      Summary:  Returns the number of cubes of VOXEL_CHUNK_SIZE blocks
+                stacked in a column, the last one cut off by the top of
+                the world
+
+      Returns:  UINT
+                  Number of cubes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT VoxelChunkStreamer::getNumLayers() const
+    {
+        return (m_uHeight + VOXEL_CHUNK_SIZE - 1u) / VOXEL_CHUNK_SIZE;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkStreamer::storeVisibility
+
+      Summary:  Copies the visibility of the cubes of a chunk into its
+                column. A chunk of level n stacks 2^n cubes, the ones
+                above the world left out
+
+      Args:     LoadedColumn& column
+                  Column of the chunk
+                const VoxelChunk& chunk
+                  Meshed chunk, empty or not
+
+      Modifies: [column].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelChunkStreamer::storeVisibility(_Inout_ LoadedColumn& column, _In_ const VoxelChunk& chunk) const
+    {
+        const UINT uFirstLayer = static_cast<UINT>(chunk.GetChunkY()) << chunk.GetLod();
+        for (UINT uCube = 0u; uCube < chunk.GetNumVisibilityCubes() && uFirstLayer + uCube < column.auVisibility.size(); ++uCube)
+        {
+            column.auVisibility[uFirstLayer + uCube] = chunk.GetVisibility(uCube);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkStreamer::remeshChunks
+
+      Summary:  Meshes some chunks of a resident full detail column
+                again from fresh cells. Each new chunk takes the place
+                of the old one, so only the edited chunks get new
+                buffers however large the column or the world is
+
+      Args:     LoadedColumn& column
+                  Resident column
+                const std::set<INT>& chunkYs
+                  Chunk y of the chunks to remesh
+                std::vector<std::shared_ptr<VoxelChunk>>& aLoadedChunks
+                  Appended the new chunks
+                std::vector<std::shared_ptr<VoxelChunk>>& aUnloadedChunks
+                  Appended the chunks they replace
+
+      Modifies: [column].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelChunkStreamer::remeshChunks(
+        _Inout_ LoadedColumn& column,
+        _In_ const std::set<INT>& chunkYs,
+        _Inout_ std::vector<std::shared_ptr<VoxelChunk>>& aLoadedChunks,
+        _Inout_ std::vector<std::shared_ptr<VoxelChunk>>& aUnloadedChunks
+    ) const
+    {
+        std::unique_ptr<VoxelGrid> grid = fillColumn(column.Key, 1u);
+
+        for (INT nChunkY : chunkYs)
+        {
+            const UINT uFirstY = static_cast<UINT>(nChunkY) * VOXEL_CHUNK_SIZE;
+            if (uFirstY >= m_uHeight)
+            {
+                continue;
+            }
+
+            std::shared_ptr<VoxelChunk> chunk = std::make_shared<VoxelChunk>(column.Key.first, nChunkY, column.Key.second);
+            const INT anFirstCell[3] = { 1, static_cast<INT>(uFirstY), 1 };
+            chunk->Mesh(*grid, anFirstCell);
+            storeVisibility(column, *chunk);
+
+            // Chunks are kept bottom to top, empty ones left out
+            auto it = std::lower_bound(column.aChunks.begin(), column.aChunks.end(), nChunkY, [](const std::shared_ptr<VoxelChunk>& other, INT nY)
+                {
+                    return other->GetChunkY() < nY;
+                }
+            );
+            const BOOL bReplaces = it != column.aChunks.end() && (*it)->GetChunkY() == nChunkY;
+            if (bReplaces)
+            {
+                aUnloadedChunks.push_back(*it);
+            }
+
+            if (chunk->GetNumIndices() == 0u)
+            {
+                if (bReplaces)
+                {
+                    column.aChunks.erase(it);
+                }
+                continue;
+            }
+
+            aLoadedChunks.push_back(chunk);
+            if (bReplaces)
+            {
+                *it = std::move(chunk);
+            }
+            else
+            {
+                column.aChunks.insert(it, std::move(chunk));
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkStreamer::loadColumn
+
+      Summary:  Fills a column from the source and meshes each of its
+                chunks. The full level is filled with its border so
+                the faces between columns are culled. A coarser level
+                is downsampled from the column alone, which leaves the
+                sides of the column exposed as skirts that cover the
+                steps to neighbours of another level. Does not touch
+                the device, the buffers are created on the updating
+                thread
+
+      Args:     const ColumnRequest& request
+                  Chunk x and z of the column and its level of detail
+
+      Returns:  LoadedColumn
+                  Chunks of the column that have faces and the
+                  visibility of all of its cubes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    VoxelChunkStreamer::LoadedColumn VoxelChunkStreamer::loadColumn(_In_ const ColumnRequest& request) const
+    {
+        std::unique_ptr<VoxelGrid> column = fillColumn(request.Key, request.uLod == 0u ? 1u : 0u);
+
+        LoadedColumn loaded = { .Key = request.Key, .uLod = request.uLod, .uTicket = request.uTicket, .aChunks = std::vector<std::shared_ptr<VoxelChunk>>(), .auVisibility = std::vector<UINT64>() };
+
+        loaded.auVisibility.assign(getNumLayers(), 0u);
+
+        auto meshColumn = [this, &request, &loaded](const VoxelGrid& grid, INT nFirstCell)
+        {
+            for (UINT uFirstY = 0u; uFirstY < grid.GetHeight(); uFirstY += VOXEL_CHUNK_SIZE)
+            {
+                std::shared_ptr<VoxelChunk> chunk = std::make_shared<VoxelChunk>(request.Key.first, static_cast<INT>(uFirstY / VOXEL_CHUNK_SIZE), request.Key.second, request.uLod);
+
+                const INT anFirstCell[3] = { nFirstCell, static_cast<INT>(uFirstY), nFirstCell };
+                chunk->Mesh(grid, anFirstCell);
+                storeVisibility(loaded, *chunk);
+                if (chunk->GetNumIndices() > 0u)
+                {
+                    loaded.aChunks.push_back(std::move(chunk));
+                }
+            }
+        };
+
+        if (request.uLod == 0u)
+        {
+            meshColumn(*column, 1);
+            return loaded;
+        }
+
+        const UINT uFactor = 1u << request.uLod;
+        VoxelGrid coarseColumn(
+            VOXEL_CHUNK_SIZE / uFactor,
+            (m_uHeight + uFactor - 1u) / uFactor,
+            VOXEL_CHUNK_SIZE / uFactor,
+            column->GetOrigin(),
+            BLOCK_SIZE * static_cast<FLOAT>(uFactor)
+        );
+        downsampleColumn(*column, uFactor, coarseColumn);
+        meshColumn(coarseColumn, 0);
+
+        return loaded;
+    }
+}
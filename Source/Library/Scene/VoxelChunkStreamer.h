@@ -0,0 +1,251 @@
+/*+===================================================================
+  File:      VOXELCHUNKSTREAMER.H
+
+  Summary:   VoxelChunkStreamer header file contains declarations of
+             the streamer that keeps the voxel chunks around the
+             camera resident, meshing them on background threads at a
+             level of detail that falls with distance and releasing the
+             ones the camera has left behind.
+
+  Classes: VoxelLodStatistics, VoxelOcclusionStatistics,
+           VoxelChunkStreamer
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include <map>
+#include <set>
+
+#include "Platform/ThreadPool.h"
+#include "Renderer/FrustumCuller.h"
+#include "Scene/VoxelChunk.h"
+#include "Scene/VoxelGrid.h"
+
+namespace library
+{
+    // Columns of chunks within this many chunks of the camera are kept
+    // resident, and are released once they are one chunk further
+    constexpr UINT VOXEL_STREAMING_RADIUS = 16u;
+
+    // Levels of detail a column is meshed at. The cells of level n are
+    // 2^n blocks on a side
+    constexpr UINT VOXEL_NUM_LODS = 4u;
+
+    // Chunks from the camera where each level but the last ends
+    constexpr FLOAT VOXEL_LOD_RING_RADII[VOXEL_NUM_LODS - 1u] = { 4.0f, 8.0f, 12.0f };
+
+    // Chunks a column has to pass a ring by before it changes level, so
+    // a camera moving back and forth across a ring does not remesh it
+    constexpr FLOAT VOXEL_LOD_HYSTERESIS = 1.0f;
+
+    static_assert(VOXEL_CHUNK_SIZE % (1u << (VOXEL_NUM_LODS - 1u)) == 0u, "The coarsest cells must tile a chunk");
+
+    // Columns whose buffers are created in one update, so a burst of
+    // finished columns is spread across frames
+    constexpr UINT VOXEL_COLUMN_UPLOADS_PER_UPDATE = 4u;
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: VoxelColumnSource
+
+      Summary:  Fills the cells of a column of chunks. The cell
+                (i, y, k) of the column grid is world cell (nFirstX +
+                i, y, nFirstZ + k). The grid is VOXEL_CHUNK_SIZE + 2
+                cells wide and deep when the cells bordering the column
+                are needed too, and VOXEL_CHUNK_SIZE when they are not.
+                Called on background threads, several columns at a time
+
+      Args:     INT nFirstX
+                INT nFirstZ
+                  World cell of the first cell of the grid
+                VoxelGrid& column
+                  Empty grid to set the blocks of
+    -----------------------------------------------------------------F-F*/
+    typedef std::function<void(_In_ INT nFirstX, _In_ INT nFirstZ, _Inout_ VoxelGrid& column)> VoxelColumnSource;
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   VoxelLodStatistics
+
+      Summary:  Resident columns of one level of detail and what they
+                cost to draw. Every chunk is one instance of one draw
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct VoxelLodStatistics
+    {
+        UINT uNumColumns;
+        UINT uNumInstances;
+        UINT uNumTriangles;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   VoxelOcclusionStatistics
+
+      Summary:  What the last walk of the chunk visibility graph saw.
+                A cube is one VOXEL_CHUNK_SIZE cube of blocks of the
+                walk, and a culled chunk is one the walk did not reach,
+                either hidden behind solid cells or out of view
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct VoxelOcclusionStatistics
+    {
+        UINT uNumChunks;
+        UINT uNumVisitedCubes;
+        UINT uNumCulledChunks;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    VoxelChunkStreamer
+
+      Summary:  Streams the world one column of chunks at a time. Each
+                update requests the columns within the radius around
+                the camera, nearest first, from a loader thread that
+                fills and meshes a batch of them in parallel on its
+                pool. Finished columns come back to the calling thread,
+                which creates their buffers, and columns beyond the
+                radius are dropped along with their buffers. Edited
+                cells only remesh the chunks that read them. Only the
+                columns near the camera are ever held, so memory stays
+                the same however large the world is. Columns further
+                out are meshed from coarser cells, each the most common
+                block of the 2^n cube of blocks it covers, and are
+                remeshed when the camera has moved past the hysteresis
+                margin of a ring. Each column keeps which faces of each
+                of its cubes of VOXEL_CHUNK_SIZE blocks see each other,
+                empty chunks included, and every frame the cubes are
+                walked breadth first from the camera to hide the
+                chunks no line of sight reaches
+
+      Methods:  Update
+                  Requests and releases columns around the camera and
+                  hands back the chunks that finished loading
+                InvalidateCell
+                  Marks the chunks that read a cell to be remeshed
+                ReleaseColumnsOfChunks
+                  Releases the columns holding some chunks so they
+                  are requested again
+                GetNumResidentColumns
+                  Returns the number of loaded columns
+                GetLodStatistics
+                  Returns the columns, instances and triangles of each
+                  level of detail
+                ReportLodStatistics
+                  Writes the statistics of each level to the debug
+                  output
+                CullOccludedChunks
+                  Hides the chunks the camera cannot see through open
+                  cells
+                GetOcclusionStatistics
+                  Returns what the last culling walk saw
+                ReportOcclusionStatistics
+                  Writes the culling statistics to the debug output
+                SelectLod
+                  Returns the level of detail of a column at a
+                  distance
+                VoxelChunkStreamer
+                  Constructor.
+                ~VoxelChunkStreamer
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class VoxelChunkStreamer final
+    {
+    public:
+        VoxelChunkStreamer(_In_ VoxelColumnSource source, _In_ UINT uHeight, _In_ const XMFLOAT3& origin, _In_ UINT uRadius = VOXEL_STREAMING_RADIUS);
+        VoxelChunkStreamer(const VoxelChunkStreamer& other) = delete;
+        VoxelChunkStreamer(VoxelChunkStreamer&& other) = delete;
+        VoxelChunkStreamer& operator=(const VoxelChunkStreamer& other) = delete;
+        VoxelChunkStreamer& operator=(VoxelChunkStreamer&& other) = delete;
+        ~VoxelChunkStreamer();
+
+        void Update(
+            _In_ const XMFLOAT3& cameraPosition,
+            _In_ BOOL bWait,
+            _Out_ std::vector<std::shared_ptr<VoxelChunk>>& aLoadedChunks,
+            _Out_ std::vector<std::shared_ptr<VoxelChunk>>& aUnloadedChunks
+        );
+
+        void InvalidateCell(_In_ INT nX, _In_ INT nY, _In_ INT nZ);
+        void ReleaseColumnsOfChunks(_In_ const std::vector<std::shared_ptr<VoxelChunk>>& aChunks, _Out_ std::vector<std::shared_ptr<VoxelChunk>>& aUnloadedChunks);
+
+        UINT GetNumResidentColumns() const;
+        void GetLodStatistics(_Out_ VoxelLodStatistics (&aStatistics)[VOXEL_NUM_LODS]) const;
+        void ReportLodStatistics() const;
+
+        UINT CullOccludedChunks(_In_ const XMFLOAT3& cameraPosition, _In_ const FrustumCuller& frustum);
+        const VoxelOcclusionStatistics& GetOcclusionStatistics() const;
+        void ReportOcclusionStatistics() const;
+
+        static UINT SelectLod(_In_ FLOAT distance, _In_ UINT uCurrentLod);
+
+    private:
+        /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+          Struct:   ColumnRequest
+
+          Summary:  Column to load and the level of detail to mesh it
+                    at. The ticket tells a request apart from an earlier
+                    one for the same column whose cells have changed
+        S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+        struct ColumnRequest
+        {
+            std::pair<INT, INT> Key;
+            UINT uLod;
+            UINT uTicket;
+        };
+
+        /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+          Struct:   LoadedColumn
+
+          Summary:  Non-empty chunks of a column, bottom to top, and the
+                    visibility of each of its cubes of VOXEL_CHUNK_SIZE
+                    blocks, bottom to top
+        S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+        struct LoadedColumn
+        {
+            std::pair<INT, INT> Key;
+            UINT uLod;
+            UINT uTicket;
+            std::vector<std::shared_ptr<VoxelChunk>> aChunks;
+            std::vector<UINT64> auVisibility;
+        };
+
+        void loaderMain();
+        LoadedColumn loadColumn(_In_ const ColumnRequest& request) const;
+        void remeshChunks(
+            _Inout_ LoadedColumn& column,
+            _In_ const std::set<INT>& chunkYs,
+            _Inout_ std::vector<std::shared_ptr<VoxelChunk>>& aLoadedChunks,
+            _Inout_ std::vector<std::shared_ptr<VoxelChunk>>& aUnloadedChunks
+        ) const;
+        std::unique_ptr<VoxelGrid> fillColumn(_In_ const std::pair<INT, INT>& key, _In_ UINT uBorder) const;
+        UINT getNumLayers() const;
+        void storeVisibility(_Inout_ LoadedColumn& column, _In_ const VoxelChunk& chunk) const;
+
+    private:
+        VoxelColumnSource m_source;
+        UINT m_uHeight;
+        XMFLOAT3 m_origin;
+        UINT m_uRadius;
+
+        // Columns by chunk x and z, the loading ones with the request
+        // whose result is waited for, and the chunk y of the chunks
+        // whose cells were edited
+        std::map<std::pair<INT, INT>, LoadedColumn> m_residentColumns;
+        std::map<std::pair<INT, INT>, ColumnRequest> m_loadingColumns;
+        std::map<std::pair<INT, INT>, std::set<INT>> m_dirtyChunks;
+        UINT m_uNextTicket;
+
+        // Cubes reached by the last culling walk, over the resident
+        // columns and one layer of sky above them
+        std::vector<BYTE> m_abVisited;
+        VoxelOcclusionStatistics m_occlusionStatistics;
+
+        ThreadPool m_threadPool;
+        std::thread m_loader;
+        std::mutex m_mutex;
+        std::condition_variable m_wakeCondition;
+        std::condition_variable m_doneCondition;
+        std::vector<ColumnRequest> m_aRequests;
+        std::vector<LoadedColumn> m_aLoadedColumns;
+        UINT m_uNumInFlight;
+        BOOL m_bStop;
+    };
+}
@@ -0,0 +1,353 @@
+#include "Scene/VoxelColumnStore.h"
+
+namespace library
+{
+    namespace
+    {
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: appendRun
+
+          Summary:  Appends cells of a block to the runs of a column,
+                    growing the top run when it holds the same block
+
+          Args:     std::vector<VoxelRun>& aRuns
+                      Runs of the column so far
+                    BYTE block
+                      Block of the cells
+                    UINT uEnd
+                      Height the cells reach up to
+        -----------------------------------------------------------------F-F*/
+        void appendRun(_Inout_ std::vector<VoxelRun>& aRuns, _In_ BYTE block, _In_ UINT uEnd)
+        {
+            if (!aRuns.empty() && aRuns.back().Block == block)
+            {
+                aRuns.back().uEnd = static_cast<WORD>(uEnd);
+                return;
+            }
+            aRuns.push_back(VoxelRun{ .uEnd = static_cast<WORD>(uEnd), .Block = block, .Reserved = 0u });
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelColumnStore::VoxelColumnStore
+
+      Summary:  Constructor, every column starts empty with a slot of
+                VOXEL_COLUMN_INITIAL_RUNS runs next to the slots of its
+                neighbours
+
+      Args:     UINT uWidth
+                UINT uHeight
+                UINT uDepth
+                  Number of cells along x, y and z
+                const XMFLOAT3& origin
+                  World position of the corner of cell (0, 0, 0)
+                FLOAT cellSize
+                  Edge of a cell in world units
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    VoxelColumnStore::VoxelColumnStore(_In_ UINT uWidth, _In_ UINT uHeight, _In_ UINT uDepth, _In_ const XMFLOAT3& origin, _In_ FLOAT cellSize)
+        : m_uWidth(uWidth)
+        , m_uHeight(uHeight)
+        , m_uDepth(uDepth)
+        , m_origin(origin)
+        , m_cellSize(cellSize)
+        , m_aColumns(static_cast<size_t>(uWidth) * uDepth)
+        , m_aRuns(static_cast<size_t>(uWidth) * uDepth * VOXEL_COLUMN_INITIAL_RUNS)
+        , m_uNumAbandonedRuns(0u)
+    {
+        assert(uHeight <= VOXEL_COLUMN_MAX_HEIGHT);
+
+        for (size_t i = 0u; i < m_aColumns.size(); ++i)
+        {
+            m_aColumns[i] = ColumnSlot{ .uFirstRun = static_cast<UINT>(i * VOXEL_COLUMN_INITIAL_RUNS), .uNumRuns = 0u, .uCapacity = static_cast<WORD>(VOXEL_COLUMN_INITIAL_RUNS) };
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelColumnStore::GetBlock
+
+      Summary:  Returns the block of a cell. Cells outside the store
+                read as empty, like those of a voxel grid
+
+      Args:     INT nX
+                INT nY
+                INT nZ
+                  Cell coordinates, may be outside the store
+
+      Returns:  BYTE
+                  Block of the cell
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BYTE VoxelColumnStore::GetBlock(_In_ INT nX, _In_ INT nY, _In_ INT nZ) const
+    {
+        if (nY < 0)
+        {
+            return EMPTY_BLOCK;
+        }
+
+        const VoxelRun* pRuns = nullptr;
+        UINT uNumRuns = GetColumn(nX, nZ, &pRuns);
+        for (UINT i = 0u; i < uNumRuns; ++i)
+        {
+            if (static_cast<UINT>(nY) < pRuns[i].uEnd)
+            {
+                return pRuns[i].Block;
+            }
+        }
+
+        return EMPTY_BLOCK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelColumnStore::SetBlock
+
+      Summary:  Sets the block of a cell by splitting the run it is in
+                and merging what is left with the runs around it
+
+      Args:     UINT uX
+                UINT uY
+                UINT uZ
+                  Cell coordinates, inside the store
+                BYTE block
+                  EMPTY_BLOCK or an eBlockType value
+
+      Modifies: [m_aColumns, m_aRuns, m_uNumAbandonedRuns].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelColumnStore::SetBlock(_In_ UINT uX, _In_ UINT uY, _In_ UINT uZ, _In_ BYTE block)
+    {
+        assert(uX < m_uWidth && uY < m_uHeight && uZ < m_uDepth);
+
+        const VoxelRun* pRuns = nullptr;
+        UINT uNumRuns = GetColumn(static_cast<INT>(uX), static_cast<INT>(uZ), &pRuns);
+
+        std::vector<VoxelRun> aRuns;
+        aRuns.reserve(uNumRuns + 2u);
+
+        UINT uStart = 0u;
+        for (UINT i = 0u; i < uNumRuns; ++i)
+        {
+            if (uY >= uStart && uY < pRuns[i].uEnd)
+            {
+                if (uY > uStart)
+                {
+                    appendRun(aRuns, pRuns[i].Block, uY);
+                }
+                appendRun(aRuns, block, uY + 1u);
+                if (pRuns[i].uEnd > uY + 1u)
+                {
+                    appendRun(aRuns, pRuns[i].Block, pRuns[i].uEnd);
+                }
+            }
+            else
+            {
+                appendRun(aRuns, pRuns[i].Block, pRuns[i].uEnd);
+            }
+            uStart = pRuns[i].uEnd;
+        }
+        if (uY >= uStart)
+        {
+            if (uY > uStart)
+            {
+                appendRun(aRuns, EMPTY_BLOCK, uY);
+            }
+            appendRun(aRuns, block, uY + 1u);
+        }
+
+        while (!aRuns.empty() && aRuns.back().Block == EMPTY_BLOCK)
+        {
+            aRuns.pop_back();
+        }
+
+        SetColumn(uX, uZ, aRuns.data(), static_cast<UINT>(aRuns.size()));
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelColumnStore::SetColumn
+
+      Summary:  Replaces the runs of a column. Runs that fit the slot of
+                the column are written in place, so columns of at most
+                VOXEL_COLUMN_INITIAL_RUNS runs may be set from several
+                threads at once. Otherwise the column moves to a new
+                slot at the end of the run array
+
+      Args:     UINT uX
+                UINT uZ
+                  Column coordinates, inside the store
+                const VoxelRun* pRuns
+                  Runs bottom to top, ending at or below the height of
+                  the store and with no empty run on top
+                UINT uNumRuns
+                  Number of runs
+
+      Modifies: [m_aColumns, m_aRuns, m_uNumAbandonedRuns].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelColumnStore::SetColumn(_In_ UINT uX, _In_ UINT uZ, _In_reads_(uNumRuns) const VoxelRun* pRuns, _In_ UINT uNumRuns)
+    {
+        assert(uX < m_uWidth && uZ < m_uDepth);
+        assert(uNumRuns == 0u || (pRuns[uNumRuns - 1u].uEnd <= m_uHeight && pRuns[uNumRuns - 1u].Block != EMPTY_BLOCK));
+
+        ColumnSlot& column = m_aColumns[static_cast<size_t>(uZ) * m_uWidth + uX];
+        if (uNumRuns > column.uCapacity)
+        {
+            m_uNumAbandonedRuns += column.uCapacity;
+
+            UINT uCapacity = std::max<UINT>(column.uCapacity, 1u);
+            while (uCapacity < uNumRuns)
+            {
+                uCapacity *= 2u;
+            }
+            column.uFirstRun = static_cast<UINT>(m_aRuns.size());
+            column.uCapacity = static_cast<WORD>(std::min<UINT>(uCapacity, 0xFFFFu));
+            m_aRuns.resize(m_aRuns.size() + column.uCapacity);
+        }
+
+        std::copy(pRuns, pRuns + uNumRuns, m_aRuns.begin() + column.uFirstRun);
+        column.uNumRuns = static_cast<WORD>(uNumRuns);
+
+        if (m_uNumAbandonedRuns > m_aRuns.size() / 2u)
+        {
+            compact();
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelColumnStore::GetColumn
+
+      Summary:  Returns the runs of a column, valid until the next
+                edit of the store
+
+      Args:     INT nX
+                INT nZ
+                  Column coordinates, may be outside the store
+                const VoxelRun** ppRuns
+                  Set to the runs bottom to top, nullptr outside
+
+      Returns:  UINT
+                  Number of runs, 0 for an empty column
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT VoxelColumnStore::GetColumn(_In_ INT nX, _In_ INT nZ, _Outptr_ const VoxelRun** ppRuns) const
+    {
+        if (nX < 0 || nZ < 0 || static_cast<UINT>(nX) >= m_uWidth || static_cast<UINT>(nZ) >= m_uDepth)
+        {
+            *ppRuns = nullptr;
+            return 0u;
+        }
+
+        const ColumnSlot& column = m_aColumns[static_cast<size_t>(nZ) * m_uWidth + static_cast<size_t>(nX)];
+        *ppRuns = m_aRuns.data() + column.uFirstRun;
+        return column.uNumRuns;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelColumnStore::GetMemoryStatistics
+
+      Summary:  Counts the solid cells and the bytes they take in the
+                store, including the slots of the columns and the
+                runs abandoned by columns that moved, in a dense grid
+                of one byte per cell and as one 8 byte instance each
+
+      Returns:  VoxelMemoryStatistics
+                  Counts and bytes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    VoxelMemoryStatistics VoxelColumnStore::GetMemoryStatistics() const
+    {
+        VoxelMemoryStatistics statistics =
+        {
+            .uNumSolidCells = 0u,
+            .uNumRuns = 0u,
+            .uStoreBytes = static_cast<UINT64>(m_aColumns.capacity()) * sizeof(ColumnSlot) + static_cast<UINT64>(m_aRuns.capacity()) * sizeof(VoxelRun),
+            .uDenseGridBytes = static_cast<UINT64>(m_uWidth) * m_uHeight * m_uDepth,
+            .uInstanceBytes = 0u,
+        };
+
+        for (const ColumnSlot& column : m_aColumns)
+        {
+            UINT uStart = 0u;
+            for (UINT i = 0u; i < column.uNumRuns; ++i)
+            {
+                const VoxelRun& run = m_aRuns[column.uFirstRun + i];
+                if (run.Block != EMPTY_BLOCK)
+                {
+                    statistics.uNumSolidCells += run.uEnd - uStart;
+                }
+                uStart = run.uEnd;
+            }
+            statistics.uNumRuns += column.uNumRuns;
+        }
+        statistics.uInstanceBytes = statistics.uNumSolidCells * sizeof(InstanceData);
+
+        return statistics;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelColumnStore::ReportMemoryStatistics
+
+      Summary:  Writes the bytes per million solid cells of the store,
+                of a dense grid and of instancing every cell to the
+                debug output
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelColumnStore::ReportMemoryStatistics() const
+    {
+        VoxelMemoryStatistics statistics = GetMemoryStatistics();
+        double millions = std::max(static_cast<double>(statistics.uNumSolidCells) / 1000000.0, 1e-6);
+
+        WCHAR szReport[256];
+        swprintf_s(
+            szReport,
+            L"Voxel memory: %llu solid cells in %llu runs, per million cells store %.2f MB, dense grid %.2f MB, instances %.2f MB\n",
+            statistics.uNumSolidCells,
+            statistics.uNumRuns,
+            static_cast<double>(statistics.uStoreBytes) / millions / 1048576.0,
+            static_cast<double>(statistics.uDenseGridBytes) / millions / 1048576.0,
+            static_cast<double>(statistics.uInstanceBytes) / millions / 1048576.0
+        );
+        OutputDebugString(szReport);
+    }
+
+    UINT VoxelColumnStore::GetWidth() const
+    {
+        return m_uWidth;
+    }
+
+    UINT VoxelColumnStore::GetHeight() const
+    {
+        return m_uHeight;
+    }
+
+    UINT VoxelColumnStore::GetDepth() const
+    {
+        return m_uDepth;
+    }
+
+    const XMFLOAT3& VoxelColumnStore::GetOrigin() const
+    {
+        return m_origin;
+    }
+
+    FLOAT VoxelColumnStore::GetCellSize() const
+    {
+        return m_cellSize;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelColumnStore::compact
+
+      Summary:  Lays the slots out again in column order, dropping the
+                ones abandoned by columns that moved
+
+      Modifies: [m_aColumns, m_aRuns, m_uNumAbandonedRuns].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelColumnStore::compact()
+    {
+        std::vector<VoxelRun> aRuns;
+        aRuns.reserve(m_aRuns.size() - m_uNumAbandonedRuns);
+
+        for (ColumnSlot& column : m_aColumns)
+        {
+            UINT uFirstRun = static_cast<UINT>(aRuns.size());
+            aRuns.insert(aRuns.end(), m_aRuns.begin() + column.uFirstRun, m_aRuns.begin() + column.uFirstRun + column.uCapacity);
+            column.uFirstRun = uFirstRun;
+        }
+
+        m_aRuns = std::move(aRuns);
+        m_uNumAbandonedRuns = 0u;
+    }
+}
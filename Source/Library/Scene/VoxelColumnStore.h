@@ -0,0 +1,150 @@
+/*+===================================================================
+  File:      VOXELCOLUMNSTORE.H
+
+  Summary:   VoxelColumnStore header file contains declarations of the
+             run-length encoded columns the blocks of a scene are kept
+             in, whose size follows the surface of the world rather
+             than its volume.
+
+  Classes: VoxelRun, VoxelMemoryStatistics, VoxelColumnStore
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Renderer/DataTypes.h"
+#include "Scene/VoxelGrid.h"
+
+namespace library
+{
+    // Runs every column has room for before it is first moved, enough
+    // for the one run of a height map column and one edit on top
+    constexpr UINT VOXEL_COLUMN_INITIAL_RUNS = 2u;
+
+    // Tallest column a store holds, as the ends of runs are WORDs
+    constexpr UINT VOXEL_COLUMN_MAX_HEIGHT = 0xFFFFu;
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   VoxelRun
+
+      Summary:  Cells of one block stacked in a column, from the end of
+                the run below, or the bottom, up to but not including
+                uEnd
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct VoxelRun
+    {
+        WORD uEnd;
+        BYTE Block;
+        BYTE Reserved;
+    };
+
+    static_assert(sizeof(VoxelRun) == 4u);
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   VoxelMemoryStatistics
+
+      Summary:  Bytes the blocks take in the store next to what the
+                same blocks take as a dense grid of one byte per cell
+                and as one instance per solid cell
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct VoxelMemoryStatistics
+    {
+        UINT64 uNumSolidCells;
+        UINT64 uNumRuns;
+        UINT64 uStoreBytes;
+        UINT64 uDenseGridBytes;
+        UINT64 uInstanceBytes;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    VoxelColumnStore
+
+      Summary:  Width x depth columns of runs, bottom to top. Empty
+                cells between runs are a run of EMPTY_BLOCK and the
+                empty cells above the top run are not stored, so a
+                height map column is a single run. The runs of every
+                column sit in one array, each column owning a slot of
+                some capacity. A column that outgrows its slot moves
+                to a slot twice as large at the end, and the array is
+                compacted once the abandoned slots are half of it, so
+                an edit costs the runs of one column
+
+      Methods:  GetBlock
+                  Returns the block of a cell, EMPTY_BLOCK outside
+                SetBlock
+                  Sets the block of a cell
+                SetColumn
+                  Replaces the runs of a column
+                GetColumn
+                  Returns the runs of a column
+                GetMemoryStatistics
+                  Returns the bytes of the store and of the dense
+                  alternatives
+                ReportMemoryStatistics
+                  Writes them to the debug output
+                GetWidth
+                GetHeight
+                GetDepth
+                  Return the number of cells along an axis
+                GetOrigin
+                  Returns the world position of the corner of cell
+                  (0, 0, 0)
+                GetCellSize
+                  Returns the edge of a cell in world units
+                VoxelColumnStore
+                  Constructor.
+                ~VoxelColumnStore
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class VoxelColumnStore final
+    {
+    public:
+        VoxelColumnStore(_In_ UINT uWidth, _In_ UINT uHeight, _In_ UINT uDepth, _In_ const XMFLOAT3& origin, _In_ FLOAT cellSize = BLOCK_SIZE);
+        VoxelColumnStore(const VoxelColumnStore& other) = delete;
+        VoxelColumnStore(VoxelColumnStore&& other) = delete;
+        VoxelColumnStore& operator=(const VoxelColumnStore& other) = delete;
+        VoxelColumnStore& operator=(VoxelColumnStore&& other) = delete;
+        ~VoxelColumnStore() = default;
+
+        BYTE GetBlock(_In_ INT nX, _In_ INT nY, _In_ INT nZ) const;
+        void SetBlock(_In_ UINT uX, _In_ UINT uY, _In_ UINT uZ, _In_ BYTE block);
+        void SetColumn(_In_ UINT uX, _In_ UINT uZ, _In_reads_(uNumRuns) const VoxelRun* pRuns, _In_ UINT uNumRuns);
+        UINT GetColumn(_In_ INT nX, _In_ INT nZ, _Outptr_ const VoxelRun** ppRuns) const;
+
+        VoxelMemoryStatistics GetMemoryStatistics() const;
+        void ReportMemoryStatistics() const;
+
+        UINT GetWidth() const;
+        UINT GetHeight() const;
+        UINT GetDepth() const;
+        const XMFLOAT3& GetOrigin() const;
+        FLOAT GetCellSize() const;
+
+    private:
+        /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+          Struct:   ColumnSlot
+
+          Summary:  Where the runs of a column are in the run array
+        S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+        struct ColumnSlot
+        {
+            UINT uFirstRun;
+            WORD uNumRuns;
+            WORD uCapacity;
+        };
+
+        void compact();
+
+    private:
+        UINT m_uWidth;
+        UINT m_uHeight;
+        UINT m_uDepth;
+        XMFLOAT3 m_origin;
+        FLOAT m_cellSize;
+        std::vector<ColumnSlot> m_aColumns;
+        std::vector<VoxelRun> m_aRuns;
+        UINT m_uNumAbandonedRuns;
+    };
+}
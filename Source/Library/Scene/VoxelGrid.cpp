@@ -0,0 +1,99 @@
+#include "Scene/VoxelGrid.h"
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelGrid::VoxelGrid
+
+      Summary:  Constructor, every cell starts empty
+
+      Args:     UINT uWidth
+                UINT uHeight
+                UINT uDepth
+                  Number of cells along x, y and z
+                const XMFLOAT3& origin
+                  World position of the corner of cell (0, 0, 0)
+                FLOAT cellSize
+                  Edge of a cell in world units
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    VoxelGrid::VoxelGrid(_In_ UINT uWidth, _In_ UINT uHeight, _In_ UINT uDepth, _In_ const XMFLOAT3& origin, _In_ FLOAT cellSize)
+        : m_uWidth(uWidth)
+        , m_uHeight(uHeight)
+        , m_uDepth(uDepth)
+        , m_origin(origin)
+        , m_cellSize(cellSize)
+        , m_aBlocks(static_cast<size_t>(uWidth) * static_cast<size_t>(uHeight) * static_cast<size_t>(uDepth), EMPTY_BLOCK)
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelGrid::GetBlock
+
+      Summary:  Returns the block of a cell. Cells outside the grid
+                read as empty, so the faces on its border are exposed
+
+      Args:     INT nX
+                INT nY
+                INT nZ
+                  Cell coordinates, may be outside the grid
+
+      Returns:  BYTE
+                  Block of the cell
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BYTE VoxelGrid::GetBlock(_In_ INT nX, _In_ INT nY, _In_ INT nZ) const
+    {
+        if (nX < 0 || nY < 0 || nZ < 0
+            || static_cast<UINT>(nX) >= m_uWidth || static_cast<UINT>(nY) >= m_uHeight || static_cast<UINT>(nZ) >= m_uDepth)
+        {
+            return EMPTY_BLOCK;
+        }
+
+        return m_aBlocks[(static_cast<size_t>(nY) * m_uDepth + static_cast<size_t>(nZ)) * m_uWidth + static_cast<size_t>(nX)];
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelGrid::SetBlock
+
+      Summary:  Sets the block of a cell
+
+      Args:     UINT uX
+                UINT uY
+                UINT uZ
+                  Cell coordinates, inside the grid
+                BYTE block
+                  EMPTY_BLOCK or an eBlockType value
+
+      Modifies: [m_aBlocks].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelGrid::SetBlock(_In_ UINT uX, _In_ UINT uY, _In_ UINT uZ, _In_ BYTE block)
+    {
+        assert(uX < m_uWidth && uY < m_uHeight && uZ < m_uDepth);
+
+        m_aBlocks[(static_cast<size_t>(uY) * m_uDepth + static_cast<size_t>(uZ)) * m_uWidth + static_cast<size_t>(uX)] = block;
+    }
+
+    UINT VoxelGrid::GetWidth() const
+    {
+        return m_uWidth;
+    }
+
+    UINT VoxelGrid::GetHeight() const
+    {
+        return m_uHeight;
+    }
+
+    UINT VoxelGrid::GetDepth() const
+    {
+        return m_uDepth;
+    }
+
+    const XMFLOAT3& VoxelGrid::GetOrigin() const
+    {
+        return m_origin;
+    }
+
+    FLOAT VoxelGrid::GetCellSize() const
+    {
+        return m_cellSize;
+    }
+}
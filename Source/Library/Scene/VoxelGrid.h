@@ -0,0 +1,80 @@
+/*+===================================================================
+  File:      VOXELGRID.H
+
+  Summary:   VoxelGrid header file contains declarations of the dense
+             block grid a scene is loaded into, which the chunk mesher
+             reads to find the exposed faces.
+
+  Classes: VoxelGrid
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+namespace library
+{
+    // Value of a cell that holds no block
+    constexpr BYTE EMPTY_BLOCK = 0u;
+
+    // Edge of a cube in world units, matching the -1 to 1 cube of Voxel
+    constexpr FLOAT BLOCK_SIZE = 2.0f;
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    VoxelGrid
+
+      Summary:  Width x height x depth cells, one byte each, x fastest
+                then z then y so that a horizontal layer is contiguous.
+                A cell holds EMPTY_BLOCK or an eBlockType value. Cell
+                (x, y, z) covers the cube from Origin + CellSize *
+                (x, y, z) to one CellSize further on every axis. The
+                cells are BLOCK_SIZE unless the grid is a coarser level
+                of detail
+
+      Methods:  GetBlock
+                  Returns the block of a cell, EMPTY_BLOCK outside
+                SetBlock
+                  Sets the block of a cell
+                GetWidth
+                GetHeight
+                GetDepth
+                  Return the number of cells along an axis
+                GetOrigin
+                  Returns the world position of the corner of cell
+                  (0, 0, 0)
+                GetCellSize
+                  Returns the edge of a cell in world units
+                VoxelGrid
+                  Constructor.
+                ~VoxelGrid
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class VoxelGrid final
+    {
+    public:
+        VoxelGrid(_In_ UINT uWidth, _In_ UINT uHeight, _In_ UINT uDepth, _In_ const XMFLOAT3& origin, _In_ FLOAT cellSize = BLOCK_SIZE);
+        VoxelGrid(const VoxelGrid& other) = delete;
+        VoxelGrid(VoxelGrid&& other) = delete;
+        VoxelGrid& operator=(const VoxelGrid& other) = delete;
+        VoxelGrid& operator=(VoxelGrid&& other) = delete;
+        ~VoxelGrid() = default;
+
+        BYTE GetBlock(_In_ INT nX, _In_ INT nY, _In_ INT nZ) const;
+        void SetBlock(_In_ UINT uX, _In_ UINT uY, _In_ UINT uZ, _In_ BYTE block);
+
+        UINT GetWidth() const;
+        UINT GetHeight() const;
+        UINT GetDepth() const;
+        const XMFLOAT3& GetOrigin() const;
+        FLOAT GetCellSize() const;
+
+    private:
+        UINT m_uWidth;
+        UINT m_uHeight;
+        UINT m_uDepth;
+        XMFLOAT3 m_origin;
+        FLOAT m_cellSize;
+        std::vector<BYTE> m_aBlocks;
+    };
+}
@@ -0,0 +1,418 @@
+#include "Scene/VoxelOccupancyGrid.h"
+
+#include <limits>
+
+namespace library
+{
+    namespace
+    {
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: getBitIndex
+
+          Summary:  Finds the bit of a cell in the word of its brick,
+                    x fastest then z then y like the voxel grid
+
+          Args:     UINT uX
+                    UINT uY
+                    UINT uZ
+                      Cell coordinates
+
+          Returns:  UINT
+                      Bit of the cell
+        -----------------------------------------------------------------F-F*/
+        UINT getBitIndex(_In_ UINT uX, _In_ UINT uY, _In_ UINT uZ)
+        {
+            constexpr UINT B = VOXEL_OCCUPANCY_BRICK_SIZE;
+            return ((uY % B) * B + (uZ % B)) * B + (uX % B);
+        }
+
+        UINT getMinAxis(_In_ const FLOAT (&aValues)[3])
+        {
+            if (aValues[0] < aValues[1])
+            {
+                return aValues[0] < aValues[2] ? 0u : 2u;
+            }
+            return aValues[1] < aValues[2] ? 1u : 2u;
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelOccupancyGrid::VoxelOccupancyGrid
+
+      Summary:  Constructor, every cell starts empty
+
+      Args:     UINT uWidth
+                UINT uHeight
+                UINT uDepth
+                  Number of cells along x, y and z
+                const XMFLOAT3& origin
+                  World position of the corner of cell (0, 0, 0)
+                FLOAT cellSize
+                  Edge of a cell in world units
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    VoxelOccupancyGrid::VoxelOccupancyGrid(_In_ UINT uWidth, _In_ UINT uHeight, _In_ UINT uDepth, _In_ const XMFLOAT3& origin, _In_ FLOAT cellSize)
+        : m_auSize{ uWidth, uHeight, uDepth }
+        , m_auNumBricks{
+            (uWidth + VOXEL_OCCUPANCY_BRICK_SIZE - 1u) / VOXEL_OCCUPANCY_BRICK_SIZE,
+            (uHeight + VOXEL_OCCUPANCY_BRICK_SIZE - 1u) / VOXEL_OCCUPANCY_BRICK_SIZE,
+            (uDepth + VOXEL_OCCUPANCY_BRICK_SIZE - 1u) / VOXEL_OCCUPANCY_BRICK_SIZE
+        }
+        , m_origin(origin)
+        , m_cellSize(cellSize)
+        , m_aBricks(static_cast<size_t>(m_auNumBricks[0]) * m_auNumBricks[1] * m_auNumBricks[2], 0u)
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelOccupancyGrid::Build
+
+      Summary:  Sets the bit of every cell that holds a block, walking
+                the runs of the columns rather than every cell. Each
+                row of bricks along x is filled by one task, so no two
+                tasks write the same word
+
+      Args:     const VoxelColumnStore& store
+                  Store of the same size to read the runs of
+                ThreadPool* pThreadPool
+                  Pool to split the rows across, or nullptr to fill
+                  them on the calling thread
+
+      Modifies: [m_aBricks].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelOccupancyGrid::Build(_In_ const VoxelColumnStore& store, _In_opt_ ThreadPool* pThreadPool)
+    {
+        assert(store.GetWidth() == m_auSize[0] && store.GetHeight() == m_auSize[1] && store.GetDepth() == m_auSize[2]);
+
+        std::fill(m_aBricks.begin(), m_aBricks.end(), 0u);
+
+        auto fillRow = [this, &store](UINT uBrickZ)
+        {
+            const UINT uLastZ = std::min((uBrickZ + 1u) * VOXEL_OCCUPANCY_BRICK_SIZE, m_auSize[2]);
+            for (UINT z = uBrickZ * VOXEL_OCCUPANCY_BRICK_SIZE; z < uLastZ; ++z)
+            {
+                for (UINT x = 0u; x < m_auSize[0]; ++x)
+                {
+                    const VoxelRun* pRuns = nullptr;
+                    UINT uNumRuns = store.GetColumn(static_cast<INT>(x), static_cast<INT>(z), &pRuns);
+
+                    UINT uStart = 0u;
+                    for (UINT i = 0u; i < uNumRuns; ++i)
+                    {
+                        if (pRuns[i].Block != EMPTY_BLOCK)
+                        {
+                            for (UINT y = uStart; y < pRuns[i].uEnd; ++y)
+                            {
+                                m_aBricks[getBrickIndex(x / VOXEL_OCCUPANCY_BRICK_SIZE, y / VOXEL_OCCUPANCY_BRICK_SIZE, uBrickZ)] |= UINT64(1) << getBitIndex(x, y, z);
+                            }
+                        }
+                        uStart = pRuns[i].uEnd;
+                    }
+                }
+            }
+        };
+
+        if (pThreadPool != nullptr)
+        {
+            pThreadPool->ParallelFor(m_auNumBricks[2], fillRow);
+        }
+        else
+        {
+            for (UINT uBrickZ = 0u; uBrickZ < m_auNumBricks[2]; ++uBrickZ)
+            {
+                fillRow(uBrickZ);
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelOccupancyGrid::SetOccupied
+
+      Summary:  Sets or clears the bit of a cell, for an edited block
+
+      Args:     UINT uX
+                UINT uY
+                UINT uZ
+                  Cell coordinates, inside the grid
+                BOOL bOccupied
+                  Whether the cell holds a block
+
+      Modifies: [m_aBricks].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelOccupancyGrid::SetOccupied(_In_ UINT uX, _In_ UINT uY, _In_ UINT uZ, _In_ BOOL bOccupied)
+    {
+        assert(uX < m_auSize[0] && uY < m_auSize[1] && uZ < m_auSize[2]);
+
+        UINT64& brick = m_aBricks[getBrickIndex(uX / VOXEL_OCCUPANCY_BRICK_SIZE, uY / VOXEL_OCCUPANCY_BRICK_SIZE, uZ / VOXEL_OCCUPANCY_BRICK_SIZE)];
+        const UINT64 bit = UINT64(1) << getBitIndex(uX, uY, uZ);
+        brick = bOccupied ? (brick | bit) : (brick & ~bit);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelOccupancyGrid::IsOccupied
+
+      Summary:  Returns whether a cell holds a block, cells outside the
+                grid are empty
+
+      Args:     INT nX
+                INT nY
+                INT nZ
+                  Cell coordinates, may be outside the grid
+
+      Returns:  BOOL
+                  TRUE if the cell is solid
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL VoxelOccupancyGrid::IsOccupied(_In_ INT nX, _In_ INT nY, _In_ INT nZ) const
+    {
+        if (nX < 0 || nY < 0 || nZ < 0
+            || static_cast<UINT>(nX) >= m_auSize[0] || static_cast<UINT>(nY) >= m_auSize[1] || static_cast<UINT>(nZ) >= m_auSize[2])
+        {
+            return FALSE;
+        }
+
+        const UINT64 brick = m_aBricks[getBrickIndex(
+            static_cast<UINT>(nX) / VOXEL_OCCUPANCY_BRICK_SIZE,
+            static_cast<UINT>(nY) / VOXEL_OCCUPANCY_BRICK_SIZE,
+            static_cast<UINT>(nZ) / VOXEL_OCCUPANCY_BRICK_SIZE
+        )];
+        return (brick >> getBitIndex(static_cast<UINT>(nX), static_cast<UINT>(nY), static_cast<UINT>(nZ))) & 1u ? TRUE : FALSE;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelOccupancyGrid::Raycast
+
+      Summary:  Clips the ray to the grid, then steps from brick to
+                brick, each time to whichever face of the brick the
+                ray leaves through first. In a brick that is not empty
+                it steps from cell to cell the same way until it finds
+                a solid one or leaves the brick. The distances to the
+                next faces are advanced by a fixed step per crossing.
+                The cell distances are measured from the ray origin
+                again in every brick, so their rounding error builds up
+                over at most one brick; the brick distances build it
+                up along the whole ray
+
+      Args:     const VoxelRay& ray
+                  Ray in world space
+                VoxelRayHit& hit
+                  Set to the first solid cell along the ray. Its block
+                  is left empty, the grid only knows the cell is solid
+
+      Returns:  BOOL
+                  TRUE if a solid cell is within the distance of the ray
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL VoxelOccupancyGrid::Raycast(_In_ const VoxelRay& ray, _Out_ VoxelRayHit& hit) const
+    {
+        hit = VoxelRayHit{ .bHit = FALSE, .Block = EMPTY_BLOCK, .anCell = { 0, 0, 0 }, .anNormal = { 0, 0, 0 }, .Distance = 0.0f };
+
+        const FLOAT length = sqrtf(ray.Direction.x * ray.Direction.x + ray.Direction.y * ray.Direction.y + ray.Direction.z * ray.Direction.z);
+        if (!(length > 0.0f) || m_aBricks.empty())
+        {
+            return FALSE;
+        }
+
+        // Work in cells, where the ray still moves one unit per unit
+        const FLOAT aOrigin[3] =
+        {
+            (ray.Origin.x - m_origin.x) / m_cellSize,
+            (ray.Origin.y - m_origin.y) / m_cellSize,
+            (ray.Origin.z - m_origin.z) / m_cellSize
+        };
+        const FLOAT aDirection[3] = { ray.Direction.x / length, ray.Direction.y / length, ray.Direction.z / length };
+        const FLOAT infinity = std::numeric_limits<FLOAT>::infinity();
+
+        FLOAT tEnter = 0.0f;
+        FLOAT tExit = ray.MaxDistance / m_cellSize;
+        INT nAxis = -1;
+        for (UINT i = 0u; i < 3u; ++i)
+        {
+            const FLOAT size = static_cast<FLOAT>(m_auSize[i]);
+            if (aDirection[i] == 0.0f)
+            {
+                if (aOrigin[i] < 0.0f || aOrigin[i] >= size)
+                {
+                    return FALSE;
+                }
+                continue;
+            }
+
+            FLOAT tNear = -aOrigin[i] / aDirection[i];
+            FLOAT tFar = (size - aOrigin[i]) / aDirection[i];
+            if (tNear > tFar)
+            {
+                std::swap(tNear, tFar);
+            }
+            if (tNear > tEnter)
+            {
+                tEnter = tNear;
+                nAxis = static_cast<INT>(i);
+            }
+            tExit = std::min(tExit, tFar);
+        }
+        if (tEnter > tExit)
+        {
+            return FALSE;
+        }
+
+        constexpr FLOAT BRICK_SIZE = static_cast<FLOAT>(VOXEL_OCCUPANCY_BRICK_SIZE);
+        INT anStep[3];
+        INT anBrick[3];
+        FLOAT aBrickMax[3];
+        FLOAT aBrickDelta[3];
+        FLOAT aCellDelta[3];
+        for (UINT i = 0u; i < 3u; ++i)
+        {
+            anStep[i] = aDirection[i] > 0.0f ? 1 : (aDirection[i] < 0.0f ? -1 : 0);
+
+            const INT nBrick = static_cast<INT>(floorf((aOrigin[i] + aDirection[i] * tEnter) / BRICK_SIZE));
+            anBrick[i] = std::clamp(nBrick, 0, static_cast<INT>(m_auNumBricks[i]) - 1);
+
+            if (anStep[i] == 0)
+            {
+                aBrickMax[i] = aBrickDelta[i] = aCellDelta[i] = infinity;
+                continue;
+            }
+            aBrickMax[i] = (static_cast<FLOAT>(anBrick[i] + (anStep[i] > 0 ? 1 : 0)) * BRICK_SIZE - aOrigin[i]) / aDirection[i];
+            aBrickDelta[i] = BRICK_SIZE / fabsf(aDirection[i]);
+            aCellDelta[i] = 1.0f / fabsf(aDirection[i]);
+        }
+
+        FLOAT t = tEnter;
+        for (;;)
+        {
+            const UINT64 brick = m_aBricks[getBrickIndex(static_cast<UINT>(anBrick[0]), static_cast<UINT>(anBrick[1]), static_cast<UINT>(anBrick[2]))];
+            if (brick != 0u)
+            {
+                const FLOAT tBrickExit = std::min(aBrickMax[getMinAxis(aBrickMax)], tExit);
+
+                INT anFirst[3];
+                INT anLast[3];
+                INT anCell[3];
+                FLOAT aCellMax[3];
+                for (UINT i = 0u; i < 3u; ++i)
+                {
+                    anFirst[i] = anBrick[i] * static_cast<INT>(VOXEL_OCCUPANCY_BRICK_SIZE);
+                    anLast[i] = std::min(anFirst[i] + static_cast<INT>(VOXEL_OCCUPANCY_BRICK_SIZE), static_cast<INT>(m_auSize[i])) - 1;
+                    anCell[i] = std::clamp(static_cast<INT>(floorf(aOrigin[i] + aDirection[i] * t)), anFirst[i], anLast[i]);
+                    aCellMax[i] = anStep[i] == 0 ? infinity : (static_cast<FLOAT>(anCell[i] + (anStep[i] > 0 ? 1 : 0)) - aOrigin[i]) / aDirection[i];
+                }
+
+                FLOAT tCell = t;
+                INT nCellAxis = nAxis;
+                for (;;)
+                {
+                    if ((brick >> getBitIndex(static_cast<UINT>(anCell[0]), static_cast<UINT>(anCell[1]), static_cast<UINT>(anCell[2]))) & 1u)
+                    {
+                        hit.bHit = TRUE;
+                        std::copy(std::begin(anCell), std::end(anCell), hit.anCell);
+                        if (nCellAxis >= 0)
+                        {
+                            hit.anNormal[nCellAxis] = -anStep[nCellAxis];
+                        }
+                        hit.Distance = tCell * m_cellSize;
+                        return TRUE;
+                    }
+
+                    const UINT uNext = getMinAxis(aCellMax);
+                    if (aCellMax[uNext] > tBrickExit)
+                    {
+                        break;
+                    }
+                    tCell = aCellMax[uNext];
+                    anCell[uNext] += anStep[uNext];
+                    if (anCell[uNext] < anFirst[uNext] || anCell[uNext] > anLast[uNext])
+                    {
+                        break;
+                    }
+                    aCellMax[uNext] += aCellDelta[uNext];
+                    nCellAxis = static_cast<INT>(uNext);
+                }
+            }
+
+            const UINT uNext = getMinAxis(aBrickMax);
+            if (aBrickMax[uNext] > tExit)
+            {
+                return FALSE;
+            }
+            t = aBrickMax[uNext];
+            anBrick[uNext] += anStep[uNext];
+            if (anBrick[uNext] < 0 || anBrick[uNext] >= static_cast<INT>(m_auNumBricks[uNext]))
+            {
+                return FALSE;
+            }
+            aBrickMax[uNext] += aBrickDelta[uNext];
+            nAxis = static_cast<INT>(uNext);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelOccupancyGrid::RaycastBatch
+
+      Summary:  Casts rays in tasks of VOXEL_RAYS_PER_TASK across a
+                thread pool. The grid is only read, so it must not be
+                edited until the batch returns
+
+      Args:     const VoxelRay* pRays
+                  Rays to cast
+                UINT uCount
+                  Number of rays
+                VoxelRayHit* pHits
+                  Set to the hit of each ray
+                ThreadPool* pThreadPool
+                  Pool to split the rays across, or nullptr to cast
+                  them on the calling thread
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelOccupancyGrid::RaycastBatch(_In_reads_(uCount) const VoxelRay* pRays, _In_ UINT uCount, _Out_writes_(uCount) VoxelRayHit* pHits, _In_opt_ ThreadPool* pThreadPool) const
+    {
+        const UINT uNumTasks = (uCount + VOXEL_RAYS_PER_TASK - 1u) / VOXEL_RAYS_PER_TASK;
+        auto castTask = [this, pRays, uCount, pHits](UINT uTask)
+        {
+            const UINT uEnd = std::min((uTask + 1u) * VOXEL_RAYS_PER_TASK, uCount);
+            for (UINT i = uTask * VOXEL_RAYS_PER_TASK; i < uEnd; ++i)
+            {
+                Raycast(pRays[i], pHits[i]);
+            }
+        };
+
+        if (pThreadPool != nullptr && uNumTasks > 1u)
+        {
+            pThreadPool->ParallelFor(uNumTasks, castTask);
+        }
+        else
+        {
+            for (UINT uTask = 0u; uTask < uNumTasks; ++uTask)
+            {
+                castTask(uTask);
+            }
+        }
+    }
+
+    UINT VoxelOccupancyGrid::GetWidth() const
+    {
+        return m_auSize[0];
+    }
+
+    UINT VoxelOccupancyGrid::GetHeight() const
+    {
+        return m_auSize[1];
+    }
+
+    UINT VoxelOccupancyGrid::GetDepth() const
+    {
+        return m_auSize[2];
+    }
+
+    const XMFLOAT3& VoxelOccupancyGrid::GetOrigin() const
+    {
+        return m_origin;
+    }
+
+    FLOAT VoxelOccupancyGrid::GetCellSize() const
+    {
+        return m_cellSize;
+    }
+
+    size_t VoxelOccupancyGrid::getBrickIndex(_In_ UINT uBrickX, _In_ UINT uBrickY, _In_ UINT uBrickZ) const
+    {
+        return (static_cast<size_t>(uBrickY) * m_auNumBricks[2] + uBrickZ) * m_auNumBricks[0] + uBrickX;
+    }
+}
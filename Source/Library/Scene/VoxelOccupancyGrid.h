@@ -0,0 +1,123 @@
+/*+===================================================================
+  File:      VOXELOCCUPANCYGRID.H
+
+  Summary:   VoxelOccupancyGrid header file contains declarations of
+             the bit grid of the solid cells of the voxel world, which
+             rays are cast against for picking and line of sight.
+
+  Classes: VoxelRay, VoxelRayHit, VoxelOccupancyGrid
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Platform/ThreadPool.h"
+#include "Scene/VoxelColumnStore.h"
+
+namespace library
+{
+    // Cells along each edge of a brick, whose 64 cells are one word
+    constexpr UINT VOXEL_OCCUPANCY_BRICK_SIZE = 4u;
+
+    // Rays cast by one task of a batch
+    constexpr UINT VOXEL_RAYS_PER_TASK = 256u;
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   VoxelRay
+
+      Summary:  Ray in world space. The direction need not be unit
+                length, MaxDistance is in world units along it
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct VoxelRay
+    {
+        XMFLOAT3 Origin;
+        XMFLOAT3 Direction;
+        FLOAT MaxDistance;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   VoxelRayHit
+
+      Summary:  First solid cell a ray enters, the outward normal of
+                the face it enters through, zero when the ray starts
+                inside the cell, and the world distance to that face
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct VoxelRayHit
+    {
+        BOOL bHit;
+        BYTE Block;
+        INT anCell[3];
+        INT anNormal[3];
+        FLOAT Distance;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    VoxelOccupancyGrid
+
+      Summary:  One bit per cell of a voxel grid, set for the solid
+                ones and packed into bricks of 4x4x4 cells so a brick
+                is a single word. A ray walks the bricks with the
+                Amanatides-Woo traversal and only walks the cells of
+                the bricks that are not empty, so the open air above
+                the terrain costs one step per brick
+
+      Methods:  Build
+                  Sets the bits from the runs of a column store
+                SetOccupied
+                  Sets or clears the bit of a cell
+                IsOccupied
+                  Returns whether a cell is solid
+                Raycast
+                  Finds the first solid cell along a ray
+                RaycastBatch
+                  Casts many rays across a thread pool
+                GetWidth
+                GetHeight
+                GetDepth
+                  Return the number of cells along an axis
+                GetOrigin
+                  Returns the world position of the corner of cell
+                  (0, 0, 0)
+                GetCellSize
+                  Returns the edge of a cell in world units
+                VoxelOccupancyGrid
+                  Constructor.
+                ~VoxelOccupancyGrid
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class VoxelOccupancyGrid final
+    {
+    public:
+        VoxelOccupancyGrid(_In_ UINT uWidth, _In_ UINT uHeight, _In_ UINT uDepth, _In_ const XMFLOAT3& origin, _In_ FLOAT cellSize = BLOCK_SIZE);
+        VoxelOccupancyGrid(const VoxelOccupancyGrid& other) = delete;
+        VoxelOccupancyGrid(VoxelOccupancyGrid&& other) = delete;
+        VoxelOccupancyGrid& operator=(const VoxelOccupancyGrid& other) = delete;
+        VoxelOccupancyGrid& operator=(VoxelOccupancyGrid&& other) = delete;
+        ~VoxelOccupancyGrid() = default;
+
+        void Build(_In_ const VoxelColumnStore& store, _In_opt_ ThreadPool* pThreadPool);
+        void SetOccupied(_In_ UINT uX, _In_ UINT uY, _In_ UINT uZ, _In_ BOOL bOccupied);
+        BOOL IsOccupied(_In_ INT nX, _In_ INT nY, _In_ INT nZ) const;
+
+        BOOL Raycast(_In_ const VoxelRay& ray, _Out_ VoxelRayHit& hit) const;
+        void RaycastBatch(_In_reads_(uCount) const VoxelRay* pRays, _In_ UINT uCount, _Out_writes_(uCount) VoxelRayHit* pHits, _In_opt_ ThreadPool* pThreadPool) const;
+
+        UINT GetWidth() const;
+        UINT GetHeight() const;
+        UINT GetDepth() const;
+        const XMFLOAT3& GetOrigin() const;
+        FLOAT GetCellSize() const;
+
+    private:
+        size_t getBrickIndex(_In_ UINT uBrickX, _In_ UINT uBrickY, _In_ UINT uBrickZ) const;
+
+    private:
+        UINT m_auSize[3];
+        UINT m_auNumBricks[3];
+        XMFLOAT3 m_origin;
+        FLOAT m_cellSize;
+        std::vector<UINT64> m_aBricks;
+    };
+}
@@ -0,0 +1,635 @@
+#include "Scene/VoxelRegionFile.h"
+
+#include <cmath>
+#include <fstream>
+#include <set>
+
+namespace library
+{
+    namespace
+    {
+        // Extension of region files, which a directory is searched for
+        constexpr const WCHAR REGION_FILE_EXTENSION[] = L".vxr";
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: getNumRegions
+
+          Summary:  Returns the number of regions along an axis of a
+                    world
+
+          Args:     UINT uNumCells
+                      Cells of the world along the axis
+
+          Returns:  UINT
+                      Number of regions covering the cells
+        -----------------------------------------------------------------F-F*/
+        UINT getNumRegions(_In_ UINT uNumCells)
+        {
+            constexpr UINT64 REGION_CELLS = static_cast<UINT64>(VOXEL_REGION_SIZE) * VOXEL_CHUNK_SIZE;
+            return static_cast<UINT>((static_cast<UINT64>(uNumCells) + REGION_CELLS - 1u) / REGION_CELLS);
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: isStoredBlock
+
+          Summary:  Returns whether a byte is a block a store may hold,
+                    EMPTY_BLOCK or an eBlockType value
+
+          Args:     BYTE block
+                      Byte to check
+
+          Returns:  BOOL
+                      TRUE if the byte is a block
+        -----------------------------------------------------------------F-F*/
+        BOOL isStoredBlock(_In_ BYTE block)
+        {
+            return block == EMPTY_BLOCK
+                || (static_cast<BYTE>(eBlockType::GRASSLAND) <= block && block < static_cast<BYTE>(eBlockType::COUNT));
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: appendVarint
+
+          Summary:  Appends a value as a LEB128 varint, seven bits per
+                    byte low bits first, the high bit set on every byte
+                    but the last
+
+          Args:     UINT uValue
+                      Value to code
+                    std::vector<BYTE>& aBytes
+                      Appended the bytes of the value
+        -----------------------------------------------------------------F-F*/
+        void appendVarint(_In_ UINT uValue, _Inout_ std::vector<BYTE>& aBytes)
+        {
+            while (uValue >= 0x80u)
+            {
+                aBytes.push_back(static_cast<BYTE>(uValue | 0x80u));
+                uValue >>= 7u;
+            }
+            aBytes.push_back(static_cast<BYTE>(uValue));
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: readVarint
+
+          Summary:  Reads a LEB128 varint of at most 32 bits
+
+          Args:     const BYTE*& pCurrent
+                      First byte of the varint, moved past it
+                    const BYTE* pEnd
+                      End of the data
+                    UINT& uValue
+                      Receives the value
+
+          Returns:  BOOL
+                      FALSE if the data ends inside the varint or it
+                      does not fit 32 bits
+        -----------------------------------------------------------------F-F*/
+        BOOL readVarint(_Inout_ const BYTE*& pCurrent, _In_ const BYTE* pEnd, _Out_ UINT& uValue)
+        {
+            uValue = 0u;
+            for (UINT uShift = 0u; uShift < 32u; uShift += 7u)
+            {
+                if (pCurrent >= pEnd)
+                {
+                    return FALSE;
+                }
+
+                const BYTE byte = *pCurrent++;
+                uValue |= static_cast<UINT>(byte & 0x7Fu) << uShift;
+                if ((byte & 0x80u) == 0u)
+                {
+                    return TRUE;
+                }
+            }
+
+            return FALSE;
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: encodeChunk
+
+          Summary:  Codes the columns of one chunk column of a store
+                    with a palette of the blocks they hold and
+                    run-length varints
+
+          Args:     const VoxelColumnStore& store
+                      Store to read the columns from
+                    UINT uChunkX
+                    UINT uChunkZ
+                      Chunk column of the world
+                    std::vector<BYTE>& aBytes
+                      Set to the code, left empty when the chunk column
+                      has no runs
+        -----------------------------------------------------------------F-F*/
+        void encodeChunk(_In_ const VoxelColumnStore& store, _In_ UINT uChunkX, _In_ UINT uChunkZ, _Out_ std::vector<BYTE>& aBytes)
+        {
+            aBytes.clear();
+
+            const UINT uFirstX = uChunkX * VOXEL_CHUNK_SIZE;
+            const UINT uFirstZ = uChunkZ * VOXEL_CHUNK_SIZE;
+            const VoxelRun* apRuns[VOXEL_REGION_CHUNK_COLUMNS];
+            UINT auNumRuns[VOXEL_REGION_CHUNK_COLUMNS];
+
+            // Blocks take palette indices in the order they first appear
+            BYTE auPaletteIndices[256];
+            std::fill(std::begin(auPaletteIndices), std::end(auPaletteIndices), BYTE(0xFFu));
+            std::vector<BYTE> aPalette;
+            for (UINT uColumn = 0u; uColumn < VOXEL_REGION_CHUNK_COLUMNS; ++uColumn)
+            {
+                const INT nX = static_cast<INT>(uFirstX + uColumn % VOXEL_CHUNK_SIZE);
+                const INT nZ = static_cast<INT>(uFirstZ + uColumn / VOXEL_CHUNK_SIZE);
+                auNumRuns[uColumn] = store.GetColumn(nX, nZ, &apRuns[uColumn]);
+                for (UINT uRun = 0u; uRun < auNumRuns[uColumn]; ++uRun)
+                {
+                    const BYTE block = apRuns[uColumn][uRun].Block;
+                    if (auPaletteIndices[block] == 0xFFu)
+                    {
+                        auPaletteIndices[block] = static_cast<BYTE>(aPalette.size());
+                        aPalette.push_back(block);
+                    }
+                }
+            }
+
+            if (aPalette.empty())
+            {
+                return;
+            }
+
+            aBytes.push_back(static_cast<BYTE>(aPalette.size() - 1u));
+            aBytes.insert(aBytes.end(), aPalette.begin(), aPalette.end());
+
+            const UINT uPaletteSize = static_cast<UINT>(aPalette.size());
+            for (UINT uColumn = 0u; uColumn < VOXEL_REGION_CHUNK_COLUMNS; ++uColumn)
+            {
+                appendVarint(auNumRuns[uColumn], aBytes);
+
+                UINT uStart = 0u;
+                for (UINT uRun = 0u; uRun < auNumRuns[uColumn]; ++uRun)
+                {
+                    const VoxelRun& run = apRuns[uColumn][uRun];
+                    appendVarint((run.uEnd - uStart) * uPaletteSize + auPaletteIndices[run.Block], aBytes);
+                    uStart = run.uEnd;
+                }
+            }
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: parallelFor
+
+          Summary:  Runs the iterations of a loop on a pool, or on the
+                    calling thread without one
+
+          Args:     ThreadPool* pThreadPool
+                      Pool to run the loop on, or nullptr
+                    UINT uCount
+                      Number of iterations
+                    const std::function<void(UINT)>& function
+                      Body of the loop
+        -----------------------------------------------------------------F-F*/
+        void parallelFor(_In_opt_ ThreadPool* pThreadPool, _In_ UINT uCount, _In_ const std::function<void(UINT)>& function)
+        {
+            if (pThreadPool != nullptr)
+            {
+                pThreadPool->ParallelFor(uCount, function);
+            }
+            else
+            {
+                for (UINT i = 0u; i < uCount; ++i)
+                {
+                    function(i);
+                }
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelRegionFile::VoxelRegionFile
+
+      Summary:  Constructor
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    VoxelRegionFile::VoxelRegionFile()
+        : m_file()
+        , m_header()
+        , m_pEntries(nullptr)
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelRegionFile::Open
+
+      Summary:  Maps a region file and checks that its header is of
+                this version and describes a world a store can hold
+                with the region inside it, and that every entry of its
+                table lies within the file, so chunk columns are read
+                without checking the table again
+
+      Args:     const std::filesystem::path& filePath
+                  Region file to map
+
+      Modifies: [m_file, m_header, m_pEntries].
+
+      Returns:  HRESULT
+                  Status code, E_FAIL if the file is not a region file
+                  of this version, its header is out of range or it is
+                  cut short
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT VoxelRegionFile::Open(_In_ const std::filesystem::path& filePath)
+    {
+        m_header = {};
+        m_pEntries = nullptr;
+
+        HRESULT hr = m_file.Open(filePath);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        const SIZE_T uSize = m_file.GetSize();
+        constexpr SIZE_T TABLE_END = sizeof(VoxelRegionHeader) + VOXEL_REGION_SIZE * VOXEL_REGION_SIZE * sizeof(VoxelRegionChunkEntry);
+        if (uSize < TABLE_END)
+        {
+            m_file.Close();
+            return E_FAIL;
+        }
+
+        memcpy(&m_header, m_file.GetData(), sizeof(m_header));
+        if (m_header.uMagic != VOXEL_REGION_MAGIC || m_header.uVersion != VOXEL_REGION_VERSION
+            || m_header.uHeight > VOXEL_COLUMN_MAX_HEIGHT || !(m_header.CellSize > 0.0f) || !std::isfinite(m_header.CellSize)
+            || m_header.nRegionX < 0 || static_cast<UINT>(m_header.nRegionX) >= getNumRegions(m_header.uWidth)
+            || m_header.nRegionZ < 0 || static_cast<UINT>(m_header.nRegionZ) >= getNumRegions(m_header.uDepth))
+        {
+            m_file.Close();
+            return E_FAIL;
+        }
+
+        const VoxelRegionChunkEntry* pEntries = reinterpret_cast<const VoxelRegionChunkEntry*>(m_file.GetData() + sizeof(VoxelRegionHeader));
+        for (UINT uEntry = 0u; uEntry < VOXEL_REGION_SIZE * VOXEL_REGION_SIZE; ++uEntry)
+        {
+            if (pEntries[uEntry].uSize > 0u
+                && (pEntries[uEntry].uOffset < TABLE_END || static_cast<UINT64>(pEntries[uEntry].uOffset) + pEntries[uEntry].uSize > uSize))
+            {
+                m_file.Close();
+                return E_FAIL;
+            }
+        }
+        m_pEntries = pEntries;
+
+        return S_OK;
+    }
+
+    const VoxelRegionHeader& VoxelRegionFile::GetHeader() const
+    {
+        return m_header;
+    }
+
+    SIZE_T VoxelRegionFile::GetSize() const
+    {
+        return m_file.GetSize();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelRegionFile::HasChunk
+
+      Summary:  Returns whether a chunk column of the region has any
+                runs stored
+
+      Args:     UINT uLocalX
+                UINT uLocalZ
+                  Chunk column within the region
+
+      Returns:  BOOL
+                  TRUE if the chunk column has a code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL VoxelRegionFile::HasChunk(_In_ UINT uLocalX, _In_ UINT uLocalZ) const
+    {
+        return m_pEntries != nullptr && uLocalX < VOXEL_REGION_SIZE && uLocalZ < VOXEL_REGION_SIZE
+            && m_pEntries[uLocalZ * VOXEL_REGION_SIZE + uLocalX].uSize > 0u;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelRegionFile::ReadChunk
+
+      Summary:  Decodes the columns of a chunk column into runs for
+                VoxelColumnStore::SetColumn. Only reads the view, so
+                chunk columns can be read in parallel
+
+      Args:     UINT uLocalX
+                UINT uLocalZ
+                  Chunk column within the region
+                std::vector<VoxelRun>& aRuns
+                  Set to the runs of every column one after the other,
+                  x fastest then z
+                UINT* puNumRuns
+                  Receives the number of runs of each column
+
+      Returns:  HRESULT
+                  Status code, E_FAIL if the code is corrupt, holds a
+                  byte that is not a block, an empty run or an empty
+                  block on top of a column, or a run reaches above the
+                  world
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT VoxelRegionFile::ReadChunk(_In_ UINT uLocalX, _In_ UINT uLocalZ, _Out_ std::vector<VoxelRun>& aRuns, _Out_writes_(VOXEL_REGION_CHUNK_COLUMNS) UINT* puNumRuns) const
+    {
+        aRuns.clear();
+        std::fill(puNumRuns, puNumRuns + VOXEL_REGION_CHUNK_COLUMNS, 0u);
+
+        if (!HasChunk(uLocalX, uLocalZ))
+        {
+            return S_OK;
+        }
+
+        const VoxelRegionChunkEntry& entry = m_pEntries[uLocalZ * VOXEL_REGION_SIZE + uLocalX];
+        const BYTE* pCurrent = m_file.GetData() + entry.uOffset;
+        const BYTE* pEnd = pCurrent + entry.uSize;
+
+        const UINT uPaletteSize = *pCurrent++ + 1u;
+        if (static_cast<SIZE_T>(pEnd - pCurrent) < uPaletteSize)
+        {
+            return E_FAIL;
+        }
+        const BYTE* pPalette = pCurrent;
+        pCurrent += uPaletteSize;
+        if (!std::all_of(pPalette, pCurrent, isStoredBlock))
+        {
+            return E_FAIL;
+        }
+
+        const UINT uHeight = m_header.uHeight;
+        for (UINT uColumn = 0u; uColumn < VOXEL_REGION_CHUNK_COLUMNS; ++uColumn)
+        {
+            UINT uNumRuns;
+            if (!readVarint(pCurrent, pEnd, uNumRuns) || uNumRuns > uHeight)
+            {
+                return E_FAIL;
+            }
+
+            UINT uEnd = 0u;
+            for (UINT uRun = 0u; uRun < uNumRuns; ++uRun)
+            {
+                UINT uCode;
+                if (!readVarint(pCurrent, pEnd, uCode))
+                {
+                    return E_FAIL;
+                }
+
+                const UINT uLength = uCode / uPaletteSize;
+                uEnd += uLength;
+                if (uLength == 0u || uEnd > uHeight)
+                {
+                    return E_FAIL;
+                }
+                aRuns.push_back(VoxelRun{ .uEnd = static_cast<WORD>(uEnd), .Block = pPalette[uCode % uPaletteSize], .Reserved = 0u });
+            }
+            if (uNumRuns > 0u && aRuns.back().Block == EMPTY_BLOCK)
+            {
+                return E_FAIL;
+            }
+            puNumRuns[uColumn] = uNumRuns;
+        }
+
+        return S_OK;
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: GetVoxelRegionFileName
+
+      Summary:  Returns the name of the file of a region, r.x.z.vxr
+
+      Args:     INT nRegionX
+                INT nRegionZ
+                  Region coordinates, in VOXEL_REGION_SIZE chunk
+                  columns
+
+      Returns:  std::filesystem::path
+                  File name of the region
+    -----------------------------------------------------------------F-F*/
+    std::filesystem::path GetVoxelRegionFileName(_In_ INT nRegionX, _In_ INT nRegionZ)
+    {
+        return std::filesystem::path(L"r." + std::to_wstring(nRegionX) + L"." + std::to_wstring(nRegionZ) + REGION_FILE_EXTENSION);
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: WriteVoxelRegions
+
+      Summary:  Saves every block of a store as region files in a
+                directory, creating it if needed. The chunk columns of
+                a region are coded in parallel and written after its
+                table, in table order
+
+      Args:     const std::filesystem::path& directoryPath
+                  Directory to write the regions to
+                const VoxelColumnStore& store
+                  Store to save, not changed while it is written
+                ThreadPool* pThreadPool
+                  Pool to code the chunk columns on, or nullptr to
+                  code them on the calling thread
+
+      Returns:  HRESULT
+                  Status code, E_FAIL if a file cannot be written
+    -----------------------------------------------------------------F-F*/
+    HRESULT WriteVoxelRegions(_In_ const std::filesystem::path& directoryPath, _In_ const VoxelColumnStore& store, _In_opt_ ThreadPool* pThreadPool)
+    {
+        std::error_code error;
+        std::filesystem::create_directories(directoryPath, error);
+        if (error)
+        {
+            return E_FAIL;
+        }
+
+        const UINT uNumChunksX = (store.GetWidth() + VOXEL_CHUNK_SIZE - 1u) / VOXEL_CHUNK_SIZE;
+        const UINT uNumChunksZ = (store.GetDepth() + VOXEL_CHUNK_SIZE - 1u) / VOXEL_CHUNK_SIZE;
+        const UINT uNumRegionsX = (uNumChunksX + VOXEL_REGION_SIZE - 1u) / VOXEL_REGION_SIZE;
+        const UINT uNumRegionsZ = (uNumChunksZ + VOXEL_REGION_SIZE - 1u) / VOXEL_REGION_SIZE;
+
+        std::vector<std::vector<BYTE>> aChunkBytes(VOXEL_REGION_SIZE * VOXEL_REGION_SIZE);
+        for (UINT uRegionZ = 0u; uRegionZ < uNumRegionsZ; ++uRegionZ)
+        {
+            for (UINT uRegionX = 0u; uRegionX < uNumRegionsX; ++uRegionX)
+            {
+                parallelFor(pThreadPool, VOXEL_REGION_SIZE * VOXEL_REGION_SIZE, [&store, &aChunkBytes, uRegionX, uRegionZ, uNumChunksX, uNumChunksZ](UINT uEntry)
+                    {
+                        const UINT uChunkX = uRegionX * VOXEL_REGION_SIZE + uEntry % VOXEL_REGION_SIZE;
+                        const UINT uChunkZ = uRegionZ * VOXEL_REGION_SIZE + uEntry / VOXEL_REGION_SIZE;
+                        if (uChunkX < uNumChunksX && uChunkZ < uNumChunksZ)
+                        {
+                            encodeChunk(store, uChunkX, uChunkZ, aChunkBytes[uEntry]);
+                        }
+                        else
+                        {
+                            aChunkBytes[uEntry].clear();
+                        }
+                    }
+                );
+
+                VoxelRegionHeader header =
+                {
+                    .uMagic = VOXEL_REGION_MAGIC,
+                    .uVersion = VOXEL_REGION_VERSION,
+                    .nRegionX = static_cast<INT>(uRegionX),
+                    .nRegionZ = static_cast<INT>(uRegionZ),
+                    .uWidth = store.GetWidth(),
+                    .uHeight = store.GetHeight(),
+                    .uDepth = store.GetDepth(),
+                    .Origin = store.GetOrigin(),
+                    .CellSize = store.GetCellSize(),
+                    .uReserved = 0u,
+                };
+
+                VoxelRegionChunkEntry aEntries[VOXEL_REGION_SIZE * VOXEL_REGION_SIZE];
+                UINT64 uOffset = sizeof(header) + sizeof(aEntries);
+                for (UINT uEntry = 0u; uEntry < VOXEL_REGION_SIZE * VOXEL_REGION_SIZE; ++uEntry)
+                {
+                    aEntries[uEntry] = VoxelRegionChunkEntry{ .uOffset = static_cast<UINT>(uOffset), .uSize = static_cast<UINT>(aChunkBytes[uEntry].size()) };
+                    uOffset += aChunkBytes[uEntry].size();
+                }
+                if (uOffset > UINT_MAX)
+                {
+                    return E_FAIL;
+                }
+
+                std::ofstream outputFile(directoryPath / GetVoxelRegionFileName(header.nRegionX, header.nRegionZ), std::ios::binary | std::ios::trunc);
+                if (!outputFile)
+                {
+                    return E_FAIL;
+                }
+
+                outputFile.write(reinterpret_cast<const CHAR*>(&header), sizeof(header));
+                outputFile.write(reinterpret_cast<const CHAR*>(aEntries), sizeof(aEntries));
+                for (const std::vector<BYTE>& aBytes : aChunkBytes)
+                {
+                    outputFile.write(reinterpret_cast<const CHAR*>(aBytes.data()), static_cast<std::streamsize>(aBytes.size()));
+                }
+
+                outputFile.close();
+                if (outputFile.fail())
+                {
+                    return E_FAIL;
+                }
+            }
+        }
+
+        return S_OK;
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: ReadVoxelRegions
+
+      Summary:  Loads a world saved by WriteVoxelRegions. Every region
+                file of the directory is mapped, the store is created
+                from their headers, and the chunk columns of all of
+                them are decoded in parallel, straight from the views,
+                and set into the store under a lock, as a column that
+                outgrows its slot moves the runs of the store
+
+      Args:     const std::filesystem::path& directoryPath
+                  Directory the regions were written to
+                ThreadPool* pThreadPool
+                  Pool to decode the chunk columns on, or nullptr to
+                  decode them on the calling thread
+                std::unique_ptr<VoxelColumnStore>& store
+                  Set to the loaded store, or nullptr on failure
+
+      Returns:  HRESULT
+                  Status code, E_FAIL if the directory holds no region
+                  files, the regions are of different worlds, one is
+                  missing or repeated, or one is corrupt
+    -----------------------------------------------------------------F-F*/
+    HRESULT ReadVoxelRegions(_In_ const std::filesystem::path& directoryPath, _In_opt_ ThreadPool* pThreadPool, _Out_ std::unique_ptr<VoxelColumnStore>& store)
+    {
+        store.reset();
+
+        std::vector<std::unique_ptr<VoxelRegionFile>> aRegions;
+        std::error_code error;
+        for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(directoryPath, error))
+        {
+            if (!entry.is_regular_file() || entry.path().extension() != REGION_FILE_EXTENSION)
+            {
+                continue;
+            }
+
+            std::unique_ptr<VoxelRegionFile> region = std::make_unique<VoxelRegionFile>();
+            HRESULT hr = region->Open(entry.path());
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+            aRegions.push_back(std::move(region));
+        }
+        if (error || aRegions.empty())
+        {
+            return E_FAIL;
+        }
+
+        // Every region of the world is written even when it is empty,
+        // so the files bound the size of the store the headers ask for
+        const VoxelRegionHeader& world = aRegions.front()->GetHeader();
+        if (static_cast<UINT64>(getNumRegions(world.uWidth)) * getNumRegions(world.uDepth) != aRegions.size())
+        {
+            return E_FAIL;
+        }
+
+        std::set<std::pair<INT, INT>> regionKeys;
+        for (const std::unique_ptr<VoxelRegionFile>& region : aRegions)
+        {
+            const VoxelRegionHeader& header = region->GetHeader();
+            if (header.uWidth != world.uWidth || header.uHeight != world.uHeight || header.uDepth != world.uDepth
+                || header.Origin.x != world.Origin.x || header.Origin.y != world.Origin.y || header.Origin.z != world.Origin.z
+                || header.CellSize != world.CellSize
+                || !regionKeys.emplace(header.nRegionX, header.nRegionZ).second)
+            {
+                return E_FAIL;
+            }
+        }
+
+        std::unique_ptr<VoxelColumnStore> loadedStore = std::make_unique<VoxelColumnStore>(world.uWidth, world.uHeight, world.uDepth, world.Origin, world.CellSize);
+        std::mutex storeMutex;
+        std::atomic<BOOL> bFailed(FALSE);
+
+        constexpr UINT CHUNKS_PER_REGION = VOXEL_REGION_SIZE * VOXEL_REGION_SIZE;
+        parallelFor(pThreadPool, static_cast<UINT>(aRegions.size()) * CHUNKS_PER_REGION, [&aRegions, &loadedStore, &storeMutex, &bFailed](UINT uTask)
+            {
+                const VoxelRegionFile& region = *aRegions[uTask / CHUNKS_PER_REGION];
+                const UINT uLocalX = uTask % VOXEL_REGION_SIZE;
+                const UINT uLocalZ = (uTask % CHUNKS_PER_REGION) / VOXEL_REGION_SIZE;
+                if (!region.HasChunk(uLocalX, uLocalZ))
+                {
+                    return;
+                }
+
+                std::vector<VoxelRun> aRuns;
+                UINT auNumRuns[VOXEL_REGION_CHUNK_COLUMNS];
+                if (FAILED(region.ReadChunk(uLocalX, uLocalZ, aRuns, auNumRuns)))
+                {
+                    bFailed = TRUE;
+                    return;
+                }
+
+                const UINT uFirstX = (static_cast<UINT>(region.GetHeader().nRegionX) * VOXEL_REGION_SIZE + uLocalX) * VOXEL_CHUNK_SIZE;
+                const UINT uFirstZ = (static_cast<UINT>(region.GetHeader().nRegionZ) * VOXEL_REGION_SIZE + uLocalZ) * VOXEL_CHUNK_SIZE;
+
+                std::lock_guard<std::mutex> lock(storeMutex);
+                const VoxelRun* pRuns = aRuns.data();
+                for (UINT uColumn = 0u; uColumn < VOXEL_REGION_CHUNK_COLUMNS; ++uColumn)
+                {
+                    const UINT uX = uFirstX + uColumn % VOXEL_CHUNK_SIZE;
+                    const UINT uZ = uFirstZ + uColumn / VOXEL_CHUNK_SIZE;
+                    if (auNumRuns[uColumn] > 0u && uX < loadedStore->GetWidth() && uZ < loadedStore->GetDepth())
+                    {
+                        loadedStore->SetColumn(uX, uZ, pRuns, auNumRuns[uColumn]);
+                    }
+                    pRuns += auNumRuns[uColumn];
+                }
+            }
+        );
+
+        if (bFailed)
+        {
+            return E_FAIL;
+        }
+
+        store = std::move(loadedStore);
+
+        return S_OK;
+    }
+}
@@ -0,0 +1,137 @@
+/*+===================================================================
+  File:      VOXELREGIONFILE.H
+
+  Summary:   VoxelRegionFile header file contains declarations of the
+             binary format voxel worlds are saved in, square regions of
+             chunk columns in one file each, every chunk column coded
+             on its own behind a table of offsets so it is read in
+             place from the mapped file without the others.
+
+  Classes: VoxelRegionHeader, VoxelRegionChunkEntry, VoxelRegionFile
+
+  Functions: GetVoxelRegionFileName, WriteVoxelRegions,
+             ReadVoxelRegions
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Platform/MappedFile.h"
+#include "Platform/ThreadPool.h"
+#include "Scene/VoxelChunk.h"
+#include "Scene/VoxelColumnStore.h"
+
+namespace library
+{
+    // First four bytes of a region file, "VXRG"
+    constexpr UINT VOXEL_REGION_MAGIC = 0x47525856u;
+    constexpr UINT VOXEL_REGION_VERSION = 1u;
+
+    // Chunk columns along each edge of a region, so a region covers
+    // 512x512 columns of the world
+    constexpr UINT VOXEL_REGION_SIZE = 32u;
+
+    // Columns of the world in one chunk column of a region
+    constexpr UINT VOXEL_REGION_CHUNK_COLUMNS = VOXEL_CHUNK_SIZE * VOXEL_CHUNK_SIZE;
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   VoxelRegionHeader
+
+      Summary:  Start of a region file. Every region of a world repeats
+                the size and placement of the whole world, so any one
+                of them is enough to create the store. It is followed
+                by a VoxelRegionChunkEntry for each chunk column of the
+                region, x fastest then z, and the coded chunk columns.
+                Everything is little-endian
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct VoxelRegionHeader
+    {
+        UINT uMagic;
+        UINT uVersion;
+        INT nRegionX;
+        INT nRegionZ;
+        UINT uWidth;
+        UINT uHeight;
+        UINT uDepth;
+        XMFLOAT3 Origin;
+        FLOAT CellSize;
+        UINT uReserved;
+    };
+
+    static_assert(sizeof(VoxelRegionHeader) == 48u);
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   VoxelRegionChunkEntry
+
+      Summary:  Where the code of a chunk column starts in the file and
+                how many bytes it takes. A chunk column with no solid
+                cells or outside the world takes none.
+
+                The code is the number of palette entries less one as
+                a BYTE, the blocks of the palette, then for each column
+                of the chunk column, x fastest then z, its number of
+                runs and each run bottom to top as LEB128 varints. A run is
+                coded as its length in cells times the number of
+                palette entries plus the index of its block, so the
+                short runs of a chunk with few blocks take one byte
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct VoxelRegionChunkEntry
+    {
+        UINT uOffset;
+        UINT uSize;
+    };
+
+    static_assert(sizeof(VoxelRegionChunkEntry) == 8u);
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    VoxelRegionFile
+
+      Summary:  Region file mapped read-only. The header and the table
+                are checked once when it is opened, and each chunk
+                column is decoded straight out of the view, so threads
+                read different chunk columns of the same file at once
+
+      Methods:  Open
+                  Maps a region file and checks its table
+                GetHeader
+                  Returns the header of the region
+                GetSize
+                  Returns the size of the file in bytes
+                HasChunk
+                  Returns whether a chunk column has any solid cells
+                ReadChunk
+                  Decodes the runs of the columns of a chunk column
+                VoxelRegionFile
+                  Constructor.
+                ~VoxelRegionFile
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class VoxelRegionFile final
+    {
+    public:
+        VoxelRegionFile();
+        VoxelRegionFile(const VoxelRegionFile& other) = delete;
+        VoxelRegionFile(VoxelRegionFile&& other) = delete;
+        VoxelRegionFile& operator=(const VoxelRegionFile& other) = delete;
+        VoxelRegionFile& operator=(VoxelRegionFile&& other) = delete;
+        ~VoxelRegionFile() = default;
+
+        HRESULT Open(_In_ const std::filesystem::path& filePath);
+
+        const VoxelRegionHeader& GetHeader() const;
+        SIZE_T GetSize() const;
+        BOOL HasChunk(_In_ UINT uLocalX, _In_ UINT uLocalZ) const;
+        HRESULT ReadChunk(_In_ UINT uLocalX, _In_ UINT uLocalZ, _Out_ std::vector<VoxelRun>& aRuns, _Out_writes_(VOXEL_REGION_CHUNK_COLUMNS) UINT* puNumRuns) const;
+
+    private:
+        MappedFile m_file;
+        VoxelRegionHeader m_header;
+        const VoxelRegionChunkEntry* m_pEntries;
+    };
+
+    std::filesystem::path GetVoxelRegionFileName(_In_ INT nRegionX, _In_ INT nRegionZ);
+    HRESULT WriteVoxelRegions(_In_ const std::filesystem::path& directoryPath, _In_ const VoxelColumnStore& store, _In_opt_ ThreadPool* pThreadPool);
+    HRESULT ReadVoxelRegions(_In_ const std::filesystem::path& directoryPath, _In_opt_ ThreadPool* pThreadPool, _Out_ std::unique_ptr<VoxelColumnStore>& store);
+}
@@ -52,6 +52,7 @@ namespace library
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     HRESULT Shader::compile(_Outptr_ ID3DBlob** ppOutBlob)
     {
+#if defined(_WIN32)
         HRESULT hr = S_OK;
 
         DWORD dwShaderFlags = D3DCOMPILE_ENABLE_STRICTNESS;
@@ -78,5 +79,20 @@ namespace library
             return hr;
         }
         return S_OK;
+#else
+        // There is no HLSL compiler off Windows. The blob names the shader
+        // instead, "<file name>:<entry point>", which the null device
+        // keeps and the software backend maps to its C++ port
+        const std::string name = std::filesystem::path(m_pszFileName).filename().string() + ':' + m_pszEntryPoint;
+
+        HRESULT hr = D3DCreateBlob(name.size(), ppOutBlob);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+        memcpy((*ppOutBlob)->GetBufferPointer(), name.data(), name.size());
+
+        return S_OK;
+#endif
     }
 }
@@ -0,0 +1,702 @@
+#include "Shader/SoftwareShaders.h"
+
+#include "Renderer/DataTypes.h"
+
+namespace library
+{
+    namespace
+    {
+        // Constants shared with PhongShaders.fxh
+        constexpr FLOAT NEAR_PLANE = 0.01f;
+        constexpr FLOAT FAR_PLANE = 1000.0f;
+        constexpr FLOAT SHADOW_BIAS = 0.001f;
+        constexpr FLOAT SHININESS = 20.0f;
+
+        /*E+E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E
+          Enum:     ePhongVarying
+
+          Summary:  Offsets of the PS_INPUT / PS_PHONG_INPUT fields of
+                    VoxelShaders.fxh and PhongShaders.fxh in the varyings
+        E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E-E*/
+        enum ePhongVarying : UINT
+        {
+            PHONG_TEXCOORD = 0u,
+            PHONG_NORMAL = 2u,
+            PHONG_WORLD_POSITION = 5u,
+            PHONG_TANGENT = 8u,
+            PHONG_BITANGENT = 11u,
+            PHONG_LIGHT_VIEW_POSITION = 14u,
+            PHONG_VOXEL_OCCLUSION = 14u,
+            PHONG_VOXEL_COUNT = 15u,
+            PHONG_COUNT = 18u,
+        };
+
+        /*E+E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E
+          Enum:     eSkinningVarying
+
+          Summary:  Offsets of the PS_PHONG_INPUT fields of
+                    SkinningShaders.fxh in the varyings
+        E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E-E*/
+        enum eSkinningVarying : UINT
+        {
+            SKINNING_NORMAL = 0u,
+            SKINNING_WORLD_POSITION = 3u,
+            SKINNING_TEXCOORD = 6u,
+            SKINNING_COUNT = 8u,
+        };
+
+        /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+          Function: loadConstantMatrix
+
+          Summary:  Loads a matrix of a constant buffer. The renderer
+                    uploads transposed matrices, so the matrix is
+                    transposed back to match mul(v, M) in HLSL
+
+          Args:     const BYTE* pConstantBuffer
+                      Constant buffer contents
+                    SIZE_T uOffset
+                      Offset of the matrix in bytes
+
+          Returns:  XMMATRIX
+                      Matrix to transform row vectors with
+        -----------------------------------------------------------------F-F*/
+        XMMATRIX loadConstantMatrix(_In_ const BYTE* pConstantBuffer, _In_ SIZE_T uOffset)
+        {
+            XMFLOAT4X4 matrix;
+            memcpy(&matrix, pConstantBuffer + uOffset, sizeof(matrix));
+
+            return XMMatrixTranspose(XMLoadFloat4x4(&matrix));
+        }
+
+        XMVECTOR loadConstantVector(_In_ const BYTE* pConstantBuffer, _In_ SIZE_T uOffset)
+        {
+            XMFLOAT4 vector;
+            memcpy(&vector, pConstantBuffer + uOffset, sizeof(vector));
+
+            return XMLoadFloat4(&vector);
+        }
+
+        BOOL loadConstantBool(_In_ const BYTE* pConstantBuffer, _In_ SIZE_T uOffset)
+        {
+            BOOL value;
+            memcpy(&value, pConstantBuffer + uOffset, sizeof(value));
+
+            return value;
+        }
+
+        XMVECTOR loadElement2(_In_ const BYTE* pElement, _In_ SIZE_T uOffset)
+        {
+            XMFLOAT2 vector;
+            memcpy(&vector, pElement + uOffset, sizeof(vector));
+
+            return XMLoadFloat2(&vector);
+        }
+
+        XMVECTOR loadElement3(_In_ const BYTE* pElement, _In_ SIZE_T uOffset)
+        {
+            XMFLOAT3 vector;
+            memcpy(&vector, pElement + uOffset, sizeof(vector));
+
+            return XMLoadFloat3(&vector);
+        }
+
+        XMVECTOR loadPosition(_In_ const SoftwareVertexInput& input)
+        {
+            return XMVectorSetW(loadElement3(input.apElements[0], offsetof(SimpleVertex, Position)), 1.0f);
+        }
+
+        XMMATRIX loadInstanceTransform(_In_ const SoftwareVertexInput& input)
+        {
+            InstanceData instance;
+            memcpy(&instance, input.apElements[SOFTWARE_INSTANCE_SLOT], sizeof(instance));
+
+            return GetInstanceTransform(instance);
+        }
+
+        void storeVaryings(_Out_writes_(uCount) FLOAT* pVaryings, _In_ FXMVECTOR value, _In_ UINT uCount)
+        {
+            XMFLOAT4 stored;
+            XMStoreFloat4(&stored, value);
+            memcpy(pVaryings, &stored, uCount * sizeof(FLOAT));
+        }
+
+        XMVECTOR loadVaryings(_In_reads_(uCount) const FLOAT* pVaryings, _In_ UINT uCount)
+        {
+            XMFLOAT4 loaded(0.0f, 0.0f, 0.0f, 0.0f);
+            memcpy(&loaded, pVaryings, uCount * sizeof(FLOAT));
+
+            return XMLoadFloat4(&loaded);
+        }
+
+        XMVECTOR transformDirection(_In_ FXMVECTOR direction, _In_ CXMMATRIX matrix)
+        {
+            return XMVector4Transform(XMVectorSetW(direction, 0.0f), matrix);
+        }
+
+        XMVECTOR projectToClipSpace(_In_ const SoftwareShaderResources& resources, _In_ FXMVECTOR worldPosition)
+        {
+            XMMATRIX view = loadConstantMatrix(resources.apConstantBuffers[0], offsetof(CBChangeOnCameraMovement, View));
+            XMMATRIX projection = loadConstantMatrix(resources.apConstantBuffers[1], offsetof(CBChangeOnResize, Projection));
+
+            return XMVector4Transform(XMVector4Transform(worldPosition, view), projection);
+        }
+
+        XMVECTOR sampleSlot(_In_ const SoftwareShaderResources& resources, _In_ UINT uSlot, _In_ const FLOAT* pTexCoord)
+        {
+            return SampleTexture(resources.aTextures[uSlot], resources.aSamplers[uSlot], pTexCoord[0], pTexCoord[1]);
+        }
+
+        FLOAT linearizeDepth(_In_ FLOAT depth)
+        {
+            FLOAT z = depth * 2.0f - 1.0f;
+            return ((2.0f * NEAR_PLANE * FAR_PLANE) / (FAR_PLANE + NEAR_PLANE - z * (FAR_PLANE - NEAR_PLANE))) / FAR_PLANE;
+        }
+
+        /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+          Function: applyNormalMap
+
+          Summary:  Perturbs the normal with the normal map bound at t1,
+                    as PSVoxel and PSPhong do
+
+          Args:     const SoftwareShaderResources& resources
+                      Resources of the pixel shader
+                    const FLOAT* pVaryings
+                      Interpolated PS_INPUT
+                    FXMVECTOR normal
+                      Normalized interpolated normal
+
+          Returns:  XMVECTOR
+                      Normal to light the pixel with
+        -----------------------------------------------------------------F-F*/
+        XMVECTOR applyNormalMap(_In_ const SoftwareShaderResources& resources, _In_ const FLOAT* pVaryings, _In_ FXMVECTOR normal)
+        {
+            if (!loadConstantBool(resources.apConstantBuffers[2], offsetof(CBChangesEveryFrame, HasNormalMap)))
+            {
+                return normal;
+            }
+
+            XMVECTOR bumpMap = sampleSlot(resources, 1u, pVaryings + PHONG_TEXCOORD) * 2.0f - XMVectorReplicate(1.0f);
+            XMVECTOR bumpNormal = XMVectorSplatX(bumpMap) * loadVaryings(pVaryings + PHONG_TANGENT, 3u)
+                + XMVectorSplatY(bumpMap) * loadVaryings(pVaryings + PHONG_BITANGENT, 3u)
+                + XMVectorSplatZ(bumpMap) * normal;
+
+            return XMVector3Normalize(bumpNormal);
+        }
+
+        XMVECTOR ambientOfLights(_In_ const BYTE* pLights)
+        {
+            XMVECTOR ambient = XMVectorZero();
+            for (UINT i = 0u; i < NUM_LIGHTS; ++i)
+            {
+                ambient += XMVectorReplicate(0.1f) * loadConstantVector(pLights, offsetof(CBLights, LightColors) + i * sizeof(XMFLOAT4));
+            }
+
+            return ambient;
+        }
+
+        XMVECTOR diffuseOfLights(_In_ const BYTE* pLights, _In_ FXMVECTOR normal, _In_ FXMVECTOR worldPosition)
+        {
+            XMVECTOR diffuse = XMVectorZero();
+            for (UINT i = 0u; i < NUM_LIGHTS; ++i)
+            {
+                XMVECTOR lightPosition = loadConstantVector(pLights, offsetof(CBLights, LightPositions) + i * sizeof(XMFLOAT4));
+                XMVECTOR lightColor = loadConstantVector(pLights, offsetof(CBLights, LightColors) + i * sizeof(XMFLOAT4));
+                XMVECTOR lightDirection = XMVector3Normalize(lightPosition - worldPosition);
+
+                diffuse += XMVectorSaturate(XMVector3Dot(normal, lightDirection)) * lightColor;
+            }
+
+            return diffuse;
+        }
+
+        XMVECTOR specularOfLights(_In_ const BYTE* pLights, _In_ FXMVECTOR normal, _In_ FXMVECTOR worldPosition, _In_ FXMVECTOR viewDirection)
+        {
+            XMVECTOR specular = XMVectorZero();
+            for (UINT i = 0u; i < NUM_LIGHTS; ++i)
+            {
+                XMVECTOR lightPosition = loadConstantVector(pLights, offsetof(CBLights, LightPositions) + i * sizeof(XMFLOAT4));
+                XMVECTOR lightColor = loadConstantVector(pLights, offsetof(CBLights, LightColors) + i * sizeof(XMFLOAT4));
+                XMVECTOR lightDirection = XMVector3Normalize(lightPosition - worldPosition);
+                XMVECTOR reflectDirection = XMVector3Reflect(-lightDirection, normal);
+                FLOAT highlight = std::pow(XMVectorGetX(XMVectorSaturate(XMVector3Dot(reflectDirection, viewDirection))), SHININESS);
+
+                specular += XMVectorReplicate(highlight) * lightColor;
+            }
+
+            return specular;
+        }
+
+        /*--------------------------------------------------------------------
+          VoxelShaders.fxh
+        --------------------------------------------------------------------*/
+        void vsVoxel(_In_ const SoftwareShaderResources& resources, _In_ const SoftwareVertexInput& input, _Out_ SoftwareVertexOutput& output)
+        {
+            const BYTE* pFrame = resources.apConstantBuffers[2];
+            XMMATRIX transform = loadInstanceTransform(input);
+            XMMATRIX world = loadConstantMatrix(pFrame, offsetof(CBChangesEveryFrame, World));
+
+            XMVECTOR worldPosition = XMVector4Transform(XMVector4Transform(loadPosition(input), transform), world);
+            XMStoreFloat4(&output.Position, projectToClipSpace(resources, worldPosition));
+
+            XMVECTOR objectNormal = loadElement3(input.apElements[0], offsetof(SimpleVertex, Normal));
+            XMVECTOR normal = transformDirection(transformDirection(objectNormal, transform), world);
+            XMVECTOR tangent = XMVectorZero();
+            XMVECTOR bitangent = XMVectorZero();
+            if (loadConstantBool(pFrame, offsetof(CBChangesEveryFrame, HasNormalMap)))
+            {
+                tangent = XMVector3Normalize(transformDirection(loadElement3(input.apElements[1], offsetof(NormalData, Tangent)), world));
+                bitangent = XMVector3Normalize(transformDirection(loadElement3(input.apElements[1], offsetof(NormalData, Bitangent)), world));
+            }
+
+            storeVaryings(output.aVaryings + PHONG_TEXCOORD, loadElement2(input.apElements[0], offsetof(SimpleVertex, TexCoord)), 2u);
+            storeVaryings(output.aVaryings + PHONG_NORMAL, normal, 3u);
+            storeVaryings(output.aVaryings + PHONG_WORLD_POSITION, worldPosition, 3u);
+            storeVaryings(output.aVaryings + PHONG_TANGENT, tangent, 3u);
+            storeVaryings(output.aVaryings + PHONG_BITANGENT, bitangent, 3u);
+            storeVaryings(output.aVaryings + PHONG_VOXEL_OCCLUSION, XMVector3Length(objectNormal), 1u);
+        }
+
+        XMVECTOR psVoxel(_In_ const SoftwareShaderResources& resources, _In_ const FLOAT* pVaryings)
+        {
+            const BYTE* pLights = resources.apConstantBuffers[3];
+            XMVECTOR normal = applyNormalMap(resources, pVaryings, XMVector3Normalize(loadVaryings(pVaryings + PHONG_NORMAL, 3u)));
+            XMVECTOR worldPosition = loadVaryings(pVaryings + PHONG_WORLD_POSITION, 3u);
+
+            XMVECTOR lighting = (ambientOfLights(pLights) + diffuseOfLights(pLights, normal, worldPosition)) * XMVectorReplicate(pVaryings[PHONG_VOXEL_OCCLUSION]);
+
+            return XMVectorSetW(lighting, 1.0f) * sampleSlot(resources, 0u, pVaryings + PHONG_TEXCOORD);
+        }
+
+        /*--------------------------------------------------------------------
+          PhongShaders.fxh
+        --------------------------------------------------------------------*/
+        void vsPhong(_In_ const SoftwareShaderResources& resources, _In_ const SoftwareVertexInput& input, _Out_ SoftwareVertexOutput& output)
+        {
+            const BYTE* pFrame = resources.apConstantBuffers[2];
+            const BYTE* pLights = resources.apConstantBuffers[3];
+            XMMATRIX world = loadConstantMatrix(pFrame, offsetof(CBChangesEveryFrame, World));
+
+            XMVECTOR worldPosition = XMVector4Transform(loadPosition(input), world);
+            XMStoreFloat4(&output.Position, projectToClipSpace(resources, worldPosition));
+
+            XMVECTOR normal = transformDirection(loadElement3(input.apElements[0], offsetof(SimpleVertex, Normal)), world);
+            XMVECTOR tangent = XMVectorZero();
+            XMVECTOR bitangent = XMVectorZero();
+            if (loadConstantBool(pFrame, offsetof(CBChangesEveryFrame, HasNormalMap)))
+            {
+                tangent = XMVector3Normalize(transformDirection(loadElement3(input.apElements[1], offsetof(NormalData, Tangent)), world));
+                bitangent = XMVector3Normalize(transformDirection(loadElement3(input.apElements[1], offsetof(NormalData, Bitangent)), world));
+            }
+
+            XMVECTOR lightViewPosition = XMVector4Transform(worldPosition, loadConstantMatrix(pLights, offsetof(CBLights, LightViews)));
+            lightViewPosition = XMVector4Transform(lightViewPosition, loadConstantMatrix(pLights, offsetof(CBLights, LightProjections)));
+
+            storeVaryings(output.aVaryings + PHONG_TEXCOORD, loadElement2(input.apElements[0], offsetof(SimpleVertex, TexCoord)), 2u);
+            storeVaryings(output.aVaryings + PHONG_NORMAL, normal, 3u);
+            storeVaryings(output.aVaryings + PHONG_WORLD_POSITION, worldPosition, 3u);
+            storeVaryings(output.aVaryings + PHONG_TANGENT, tangent, 3u);
+            storeVaryings(output.aVaryings + PHONG_BITANGENT, bitangent, 3u);
+            storeVaryings(output.aVaryings + PHONG_LIGHT_VIEW_POSITION, lightViewPosition, 4u);
+        }
+
+        XMVECTOR psPhong(_In_ const SoftwareShaderResources& resources, _In_ const FLOAT* pVaryings)
+        {
+            const BYTE* pLights = resources.apConstantBuffers[3];
+            XMVECTOR normal = applyNormalMap(resources, pVaryings, XMVector3Normalize(loadVaryings(pVaryings + PHONG_NORMAL, 3u)));
+            XMVECTOR worldPosition = loadVaryings(pVaryings + PHONG_WORLD_POSITION, 3u);
+
+            XMVECTOR color = sampleSlot(resources, 0u, pVaryings + PHONG_TEXCOORD);
+            XMVECTOR ambient = XMVectorReplicate(0.1f) * color;
+
+            // Compare with the closest depth from the shadow map
+            const FLOAT* pLightViewPosition = pVaryings + PHONG_LIGHT_VIEW_POSITION;
+            FLOAT depthTexCoord[2] =
+            {
+                pLightViewPosition[0] / pLightViewPosition[3] / 2.0f + 0.5f,
+                pLightViewPosition[1] / pLightViewPosition[3] / 2.0f + 0.5f
+            };
+            FLOAT closestDepth = linearizeDepth(XMVectorGetX(sampleSlot(resources, 2u, depthTexCoord)));
+            FLOAT currentDepth = linearizeDepth(pLightViewPosition[2] / pLightViewPosition[3]);
+
+            if (currentDepth > closestDepth + SHADOW_BIAS)
+            {
+                return XMVectorSetW(ambient, 1.0f);
+            }
+
+            XMVECTOR viewDirection = XMVector3Normalize(loadConstantVector(resources.apConstantBuffers[0], offsetof(CBChangeOnCameraMovement, CameraPosition)) - worldPosition);
+            XMVECTOR lighting = ambient + ambientOfLights(pLights)
+                + diffuseOfLights(pLights, normal, worldPosition)
+                + specularOfLights(pLights, normal, worldPosition, viewDirection);
+
+            return XMVectorSetW(lighting, 1.0f) * color;
+        }
+
+        void vsLightCube(_In_ const SoftwareShaderResources& resources, _In_ const SoftwareVertexInput& input, _Out_ SoftwareVertexOutput& output)
+        {
+            XMMATRIX world = loadConstantMatrix(resources.apConstantBuffers[2], offsetof(CBChangesEveryFrame, World));
+
+            XMStoreFloat4(&output.Position, projectToClipSpace(resources, XMVector4Transform(loadPosition(input), world)));
+        }
+
+        XMVECTOR psLightCube(_In_ const SoftwareShaderResources& resources, _In_ const FLOAT* pVaryings)
+        {
+            UNREFERENCED_PARAMETER(pVaryings);
+
+            return loadConstantVector(resources.apConstantBuffers[2], offsetof(CBChangesEveryFrame, OutputColor));
+        }
+
+        /*--------------------------------------------------------------------
+          SkinningShaders.fxh
+        --------------------------------------------------------------------*/
+        void vsSkinning(_In_ const SoftwareShaderResources& resources, _In_ const SoftwareVertexInput& input, _Out_ SoftwareVertexOutput& output)
+        {
+            const BYTE* pSkinning = resources.apConstantBuffers[4];
+            XMUINT4 boneIndices;
+            XMFLOAT4 boneWeights;
+            memcpy(&boneIndices, input.apElements[3] + offsetof(AnimationData, aBoneIndices), sizeof(boneIndices));
+            memcpy(&boneWeights, input.apElements[3] + offsetof(AnimationData, aBoneWeights), sizeof(boneWeights));
+
+            const UINT auIndices[4] = { boneIndices.x, boneIndices.y, boneIndices.z, boneIndices.w };
+            const FLOAT aWeights[4] = { boneWeights.x, boneWeights.y, boneWeights.z, boneWeights.w };
+            XMMATRIX skinTransform = XMMATRIX(XMVectorZero(), XMVectorZero(), XMVectorZero(), XMVectorZero());
+            for (UINT i = 0u; i < 4u; ++i)
+            {
+                XMMATRIX bone = loadConstantMatrix(pSkinning, offsetof(CBSkinning, BoneTransforms) + std::min(auIndices[i], MAX_NUM_BONES - 1u) * sizeof(XMMATRIX));
+                for (UINT row = 0u; row < 4u; ++row)
+                {
+                    skinTransform.r[row] += bone.r[row] * aWeights[i];
+                }
+            }
+
+            XMMATRIX world = loadConstantMatrix(resources.apConstantBuffers[2], offsetof(CBChangesEveryFrame, World));
+            XMVECTOR position = loadPosition(input);
+
+            XMStoreFloat4(&output.Position, projectToClipSpace(resources, XMVector4Transform(XMVector4Transform(position, skinTransform), world)));
+
+            XMVECTOR normal = XMVector3Normalize(transformDirection(loadElement3(input.apElements[0], offsetof(SimpleVertex, Normal)), skinTransform));
+            normal = XMVector3Normalize(transformDirection(normal, world));
+
+            // The shader computes the world position without skinning
+            storeVaryings(output.aVaryings + SKINNING_NORMAL, normal, 3u);
+            storeVaryings(output.aVaryings + SKINNING_WORLD_POSITION, XMVector4Transform(position, world), 3u);
+            storeVaryings(output.aVaryings + SKINNING_TEXCOORD, loadElement2(input.apElements[0], offsetof(SimpleVertex, TexCoord)), 2u);
+        }
+
+        XMVECTOR psSkinning(_In_ const SoftwareShaderResources& resources, _In_ const FLOAT* pVaryings)
+        {
+            const BYTE* pLights = resources.apConstantBuffers[3];
+            XMVECTOR normal = loadVaryings(pVaryings + SKINNING_NORMAL, 3u);
+            XMVECTOR worldPosition = loadVaryings(pVaryings + SKINNING_WORLD_POSITION, 3u);
+            XMVECTOR viewDirection = XMVector3Normalize(loadConstantVector(resources.apConstantBuffers[0], offsetof(CBChangeOnCameraMovement, CameraPosition)) - worldPosition);
+
+            XMVECTOR lighting = XMVectorSet(0.2f, 0.2f, 0.0f, 0.0f)
+                + diffuseOfLights(pLights, normal, worldPosition)
+                + specularOfLights(pLights, normal, worldPosition, viewDirection);
+
+            return XMVectorSetW(lighting * sampleSlot(resources, 0u, pVaryings + SKINNING_TEXCOORD), 1.0f);
+        }
+
+        /*--------------------------------------------------------------------
+          ShadowShaders.fxh
+        --------------------------------------------------------------------*/
+        void vsShadow(_In_ const SoftwareShaderResources& resources, _In_ const SoftwareVertexInput& input, _Out_ SoftwareVertexOutput& output)
+        {
+            const BYTE* pShadow = resources.apConstantBuffers[0];
+            XMVECTOR position = loadPosition(input);
+            if (loadConstantBool(pShadow, offsetof(CBShadowMatrix, IsVoxel)))
+            {
+                position = XMVector4Transform(position, loadInstanceTransform(input));
+            }
+
+            position = XMVector4Transform(position, loadConstantMatrix(pShadow, offsetof(CBShadowMatrix, World)));
+            position = XMVector4Transform(position, loadConstantMatrix(pShadow, offsetof(CBShadowMatrix, View)));
+            position = XMVector4Transform(position, loadConstantMatrix(pShadow, offsetof(CBShadowMatrix, Projection)));
+
+            XMStoreFloat4(&output.Position, position);
+
+            // Only DepthPosition.zw are read by the pixel shader
+            output.aVaryings[0] = output.Position.z;
+            output.aVaryings[1] = output.Position.w;
+        }
+
+        XMVECTOR psShadow(_In_ const SoftwareShaderResources& resources, _In_ const FLOAT* pVaryings)
+        {
+            UNREFERENCED_PARAMETER(resources);
+
+            FLOAT depthValue = pVaryings[0] / pVaryings[1];
+
+            return XMVectorSet(depthValue, depthValue, depthValue, 1.0f);
+        }
+
+        /*--------------------------------------------------------------------
+          CubeMap.fxh
+        --------------------------------------------------------------------*/
+        void vsCubeMap(_In_ const SoftwareShaderResources& resources, _In_ const SoftwareVertexInput& input, _Out_ SoftwareVertexOutput& output)
+        {
+            XMMATRIX world = loadConstantMatrix(resources.apConstantBuffers[2], offsetof(CBChangesEveryFrame, World));
+            XMVECTOR position = loadPosition(input);
+
+            XMStoreFloat4(&output.Position, projectToClipSpace(resources, XMVector4Transform(position, world)));
+            storeVaryings(output.aVaryings, position, 3u);
+        }
+
+        XMVECTOR psCubeMap(_In_ const SoftwareShaderResources& resources, _In_ const FLOAT* pVaryings)
+        {
+            return SampleTextureCube(resources.aTextures[0], resources.aSamplers[0], loadVaryings(pVaryings, 3u));
+        }
+
+        const SoftwareVertexShader s_aVertexShaders[] =
+        {
+            { .pszName = "VoxelShaders.fxh:VSVoxel", .pFunction = vsVoxel, .uNumVaryings = PHONG_VOXEL_COUNT },
+            { .pszName = "PhongShaders.fxh:VSPhong", .pFunction = vsPhong, .uNumVaryings = PHONG_COUNT },
+            { .pszName = "PhongShaders.fxh:VSLightCube", .pFunction = vsLightCube, .uNumVaryings = 0u },
+            { .pszName = "SkinningShaders.fxh:VSPhong", .pFunction = vsSkinning, .uNumVaryings = SKINNING_COUNT },
+            { .pszName = "ShadowShaders.fxh:VSShadow", .pFunction = vsShadow, .uNumVaryings = 2u },
+            { .pszName = "CubeMap.fxh:VSCubeMap", .pFunction = vsCubeMap, .uNumVaryings = 3u },
+        };
+
+        const SoftwarePixelShader s_aPixelShaders[] =
+        {
+            { .pszName = "VoxelShaders.fxh:PSVoxel", .pFunction = psVoxel },
+            { .pszName = "PhongShaders.fxh:PSPhong", .pFunction = psPhong },
+            { .pszName = "PhongShaders.fxh:PSLightCube", .pFunction = psLightCube },
+            { .pszName = "SkinningShaders.fxh:PSPhong", .pFunction = psSkinning },
+            { .pszName = "ShadowShaders.fxh:PSShadow", .pFunction = psShadow },
+            { .pszName = "CubeMap.fxh:PSCubeMap", .pFunction = psCubeMap },
+        };
+
+        /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+          Function: loadTexel
+
+          Summary:  Reads a texel and converts it to floating point
+
+          Args:     const SoftwareTexture& texture
+                      Texture to read
+                    UINT uX
+                    UINT uY
+                      Texel coordinates, inside the texture
+                    UINT uArraySlice
+                      Array slice, inside the texture
+
+          Returns:  XMVECTOR
+                      RGBA value of the texel, zero for formats that
+                      cannot be sampled
+        -----------------------------------------------------------------F-F*/
+        XMVECTOR loadTexel(_In_ const SoftwareTexture& texture, _In_ UINT uX, _In_ UINT uY, _In_ UINT uArraySlice)
+        {
+            const BYTE* pRow = texture.pData + (static_cast<SIZE_T>(uArraySlice) * texture.uHeight + uY) * texture.uRowPitch;
+
+            switch (texture.Format)
+            {
+            case DXGI_FORMAT_R8G8B8A8_UNORM:
+            {
+                const BYTE* pTexel = pRow + uX * 4u;
+                return XMVectorSet(pTexel[0], pTexel[1], pTexel[2], pTexel[3]) * (1.0f / 255.0f);
+            }
+            case DXGI_FORMAT_B8G8R8A8_UNORM:
+            {
+                const BYTE* pTexel = pRow + uX * 4u;
+                return XMVectorSet(pTexel[2], pTexel[1], pTexel[0], pTexel[3]) * (1.0f / 255.0f);
+            }
+            case DXGI_FORMAT_R32G32B32A32_FLOAT:
+            {
+                XMFLOAT4 texel;
+                memcpy(&texel, pRow + uX * sizeof(XMFLOAT4), sizeof(texel));
+                return XMLoadFloat4(&texel);
+            }
+            case DXGI_FORMAT_R32_FLOAT:
+            {
+                FLOAT texel;
+                memcpy(&texel, pRow + uX * sizeof(FLOAT), sizeof(texel));
+                return XMVectorSet(texel, 0.0f, 0.0f, 1.0f);
+            }
+            default:
+                return XMVectorZero();
+            }
+        }
+
+        UINT addressTexel(_In_ INT nCoordinate, _In_ UINT uSize, _In_ BOOL bClamp)
+        {
+            if (bClamp)
+            {
+                return static_cast<UINT>(std::clamp(nCoordinate, 0, static_cast<INT>(uSize) - 1));
+            }
+
+            INT nWrapped = nCoordinate % static_cast<INT>(uSize);
+            return static_cast<UINT>(nWrapped < 0 ? nWrapped + static_cast<INT>(uSize) : nWrapped);
+        }
+    }
+
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: SampleTexture
+
+      Summary:  Samples the top mip of a texture
+
+      Args:     const SoftwareTexture& texture
+                  Texture to sample, zero if it has no data
+                const SoftwareSampler& sampler
+                  Filter and addressing mode
+                FLOAT u
+                FLOAT v
+                  Normalized texture coordinates
+                UINT uArraySlice
+                  Array slice to sample
+
+      Returns:  XMVECTOR
+                  Filtered RGBA value
+    -----------------------------------------------------------------F-F*/
+    XMVECTOR SampleTexture(_In_ const SoftwareTexture& texture, _In_ const SoftwareSampler& sampler, _In_ FLOAT u, _In_ FLOAT v, _In_ UINT uArraySlice)
+    {
+        if (!texture.pData || texture.uWidth == 0u || texture.uHeight == 0u)
+        {
+            return XMVectorZero();
+        }
+
+        uArraySlice = std::min(uArraySlice, texture.uArraySize - 1u);
+
+        FLOAT x = u * static_cast<FLOAT>(texture.uWidth);
+        FLOAT y = v * static_cast<FLOAT>(texture.uHeight);
+        if (!(std::isfinite(x) && std::isfinite(y)))
+        {
+            return XMVectorZero();
+        }
+
+        if (sampler.bPoint)
+        {
+            return loadTexel(texture,
+                addressTexel(static_cast<INT>(std::floor(x)), texture.uWidth, sampler.bClamp),
+                addressTexel(static_cast<INT>(std::floor(y)), texture.uHeight, sampler.bClamp),
+                uArraySlice);
+        }
+
+        // Bilinear between the four closest texel centers
+        x -= 0.5f;
+        y -= 0.5f;
+        FLOAT left = std::floor(x);
+        FLOAT top = std::floor(y);
+        FLOAT fractionX = x - left;
+        FLOAT fractionY = y - top;
+
+        UINT uX0 = addressTexel(static_cast<INT>(left), texture.uWidth, sampler.bClamp);
+        UINT uX1 = addressTexel(static_cast<INT>(left) + 1, texture.uWidth, sampler.bClamp);
+        UINT uY0 = addressTexel(static_cast<INT>(top), texture.uHeight, sampler.bClamp);
+        UINT uY1 = addressTexel(static_cast<INT>(top) + 1, texture.uHeight, sampler.bClamp);
+
+        XMVECTOR upper = XMVectorLerp(loadTexel(texture, uX0, uY0, uArraySlice), loadTexel(texture, uX1, uY0, uArraySlice), fractionX);
+        XMVECTOR lower = XMVectorLerp(loadTexel(texture, uX0, uY1, uArraySlice), loadTexel(texture, uX1, uY1, uArraySlice), fractionX);
+
+        return XMVectorLerp(upper, lower, fractionY);
+    }
+
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: SampleTextureCube
+
+      Summary:  Samples a cube map in the given direction. The face is
+                picked by the major axis, following the Direct3D face
+                order +X, -X, +Y, -Y, +Z, -Z
+
+      Args:     const SoftwareTexture& texture
+                  Cube map to sample
+                const SoftwareSampler& sampler
+                  Filter mode; faces are always clamped
+                FXMVECTOR direction
+                  Direction to sample in, not normalized
+
+      Returns:  XMVECTOR
+                  Filtered RGBA value
+    -----------------------------------------------------------------F-F*/
+    XMVECTOR SampleTextureCube(_In_ const SoftwareTexture& texture, _In_ const SoftwareSampler& sampler, _In_ FXMVECTOR direction)
+    {
+        XMFLOAT3 r;
+        XMStoreFloat3(&r, direction);
+        FLOAT absX = std::fabs(r.x);
+        FLOAT absY = std::fabs(r.y);
+        FLOAT absZ = std::fabs(r.z);
+
+        UINT uFace;
+        FLOAT major, s, t;
+        if (absX >= absY && absX >= absZ)
+        {
+            uFace = r.x >= 0.0f ? 0u : 1u;
+            major = absX;
+            s = r.x >= 0.0f ? -r.z : r.z;
+            t = -r.y;
+        }
+        else if (absY >= absZ)
+        {
+            uFace = r.y >= 0.0f ? 2u : 3u;
+            major = absY;
+            s = r.x;
+            t = r.y >= 0.0f ? r.z : -r.z;
+        }
+        else
+        {
+            uFace = r.z >= 0.0f ? 4u : 5u;
+            major = absZ;
+            s = r.z >= 0.0f ? r.x : -r.x;
+            t = -r.y;
+        }
+
+        if (major == 0.0f)
+        {
+            return XMVectorZero();
+        }
+
+        SoftwareSampler faceSampler = sampler;
+        faceSampler.bClamp = TRUE;
+
+        return SampleTexture(texture, faceSampler, (s / major + 1.0f) * 0.5f, (t / major + 1.0f) * 0.5f, uFace);
+    }
+
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: FindSoftwareVertexShader
+
+      Summary:  Looks up the C++ port of a vertex shader
+
+      Args:     std::string_view name
+                  "<file name>:<entry point>" of the HLSL shader
+
+      Returns:  const SoftwareVertexShader*
+                  The port, nullptr if the shader has none
+    -----------------------------------------------------------------F-F*/
+    const SoftwareVertexShader* FindSoftwareVertexShader(_In_ std::string_view name)
+    {
+        for (const SoftwareVertexShader& shader : s_aVertexShaders)
+        {
+            if (name == shader.pszName)
+            {
+                return &shader;
+            }
+        }
+
+        return nullptr;
+    }
+
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: FindSoftwarePixelShader
+
+      Summary:  Looks up the C++ port of a pixel shader
+
+      Args:     std::string_view name
+                  "<file name>:<entry point>" of the HLSL shader
+
+      Returns:  const SoftwarePixelShader*
+                  The port, nullptr if the shader has none
+    -----------------------------------------------------------------F-F*/
+    const SoftwarePixelShader* FindSoftwarePixelShader(_In_ std::string_view name)
+    {
+        for (const SoftwarePixelShader& shader : s_aPixelShaders)
+        {
+            if (name == shader.pszName)
+            {
+                return &shader;
+            }
+        }
+
+        return nullptr;
+    }
+}
@@ -0,0 +1,132 @@
+/*+===================================================================
+  File:      SOFTWARESHADERS.H
+
+  Summary:   SoftwareShaders header file contains declarations of the
+             C++ ports of the game shaders run by the software render
+             backend, and of the texture sampling they use.
+
+  Classes: SoftwareTexture, SoftwareSampler, SoftwareShaderResources,
+           SoftwareVertexInput, SoftwareVertexOutput,
+           SoftwareVertexShader, SoftwarePixelShader
+
+  Functions: SampleTexture, SampleTextureCube,
+             FindSoftwareVertexShader, FindSoftwarePixelShader
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include <string_view>
+
+namespace library
+{
+    constexpr UINT SOFTWARE_MAX_VARYINGS = 20u;
+    constexpr UINT SOFTWARE_MAX_VERTEX_BUFFERS = 4u;
+    constexpr UINT SOFTWARE_MAX_CONSTANT_BUFFERS = 8u;
+    constexpr UINT SOFTWARE_MAX_SHADER_RESOURCES = 8u;
+
+    // Vertex buffer slot the renderer binds its per-instance data to
+    constexpr UINT SOFTWARE_INSTANCE_SLOT = 2u;
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   SoftwareTexture
+
+      Summary:  Top mip of a texture in system memory. Cube maps store
+                their six faces as consecutive array slices
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct SoftwareTexture
+    {
+        const BYTE* pData;
+        UINT uWidth;
+        UINT uHeight;
+        UINT uRowPitch;
+        UINT uArraySize;
+        DXGI_FORMAT Format;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   SoftwareSampler
+
+      Summary:  Filter and addressing mode of a sampler state. Every
+                filter other than point sampling is bilinear
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct SoftwareSampler
+    {
+        BOOL bPoint;
+        BOOL bClamp;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   SoftwareShaderResources
+
+      Summary:  Constant buffers, textures and samplers bound to a
+                shader stage. Unbound constant buffers read as zero and
+                unbound textures sample as zero
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct SoftwareShaderResources
+    {
+        const BYTE* apConstantBuffers[SOFTWARE_MAX_CONSTANT_BUFFERS];
+        SoftwareTexture aTextures[SOFTWARE_MAX_SHADER_RESOURCES];
+        SoftwareSampler aSamplers[SOFTWARE_MAX_SHADER_RESOURCES];
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   SoftwareVertexInput
+
+      Summary:  Element of every vertex buffer slot fetched for one
+                vertex. The instance slot points at the element of the
+                current instance
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct SoftwareVertexInput
+    {
+        const BYTE* apElements[SOFTWARE_MAX_VERTEX_BUFFERS];
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   SoftwareVertexOutput
+
+      Summary:  Clip space position and the attributes a vertex shader
+                passes to the pixel shader
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct SoftwareVertexOutput
+    {
+        XMFLOAT4 Position;
+        FLOAT aVaryings[SOFTWARE_MAX_VARYINGS];
+    };
+
+    typedef void (*SoftwareVertexShaderFunction)(_In_ const SoftwareShaderResources& resources, _In_ const SoftwareVertexInput& input, _Out_ SoftwareVertexOutput& output);
+    typedef XMVECTOR (*SoftwarePixelShaderFunction)(_In_ const SoftwareShaderResources& resources, _In_reads_(SOFTWARE_MAX_VARYINGS) const FLOAT* pVaryings);
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   SoftwareVertexShader
+
+      Summary:  C++ port of a vertex shader, named after the file and
+                entry point of the HLSL it replaces
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct SoftwareVertexShader
+    {
+        PCSTR pszName;
+        SoftwareVertexShaderFunction pFunction;
+        UINT uNumVaryings;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   SoftwarePixelShader
+
+      Summary:  C++ port of a pixel shader, named after the file and
+                entry point of the HLSL it replaces
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct SoftwarePixelShader
+    {
+        PCSTR pszName;
+        SoftwarePixelShaderFunction pFunction;
+    };
+
+    XMVECTOR SampleTexture(_In_ const SoftwareTexture& texture, _In_ const SoftwareSampler& sampler, _In_ FLOAT u, _In_ FLOAT v, _In_ UINT uArraySlice = 0u);
+    XMVECTOR SampleTextureCube(_In_ const SoftwareTexture& texture, _In_ const SoftwareSampler& sampler, _In_ FXMVECTOR direction);
+
+    const SoftwareVertexShader* FindSoftwareVertexShader(_In_ std::string_view name);
+    const SoftwarePixelShader* FindSoftwarePixelShader(_In_ std::string_view name);
+}
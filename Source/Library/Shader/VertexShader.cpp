@@ -60,7 +60,7 @@ namespace library
 
         // Define and create the input layout
         // Define the input layout, Vertex position in object space.
-        // The instance data is a tranfromation matrix, thus it requires four input elements
+        // The instance data is a packed cell and block type, one input element
         D3D11_INPUT_ELEMENT_DESC layout[] =
         {
                // 0th input slot for SimpleVertex
@@ -71,10 +71,7 @@ namespace library
                {"TANGENT", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 0, D3D11_INPUT_PER_VERTEX_DATA, 0},
                {"BITANGENT", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 12, D3D11_INPUT_PER_VERTEX_DATA, 0 },
                // 2th input slot for InstanceData
-               { "INSTANCE_TRANSFORM", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 2, 0, D3D11_INPUT_PER_INSTANCE_DATA, 1}, //offset ٽ 
-               { "INSTANCE_TRANSFORM", 1, DXGI_FORMAT_R32G32B32A32_FLOAT, 2, 16, D3D11_INPUT_PER_INSTANCE_DATA, 1},
-               { "INSTANCE_TRANSFORM", 2, DXGI_FORMAT_R32G32B32A32_FLOAT, 2, 32, D3D11_INPUT_PER_INSTANCE_DATA, 1},
-               { "INSTANCE_TRANSFORM", 3, DXGI_FORMAT_R32G32B32A32_FLOAT, 2, 48, D3D11_INPUT_PER_INSTANCE_DATA, 1},
+               { "INSTANCE_CELL", 0, DXGI_FORMAT_R16G16B16A16_SINT, 2, 0, D3D11_INPUT_PER_INSTANCE_DATA, 1},
         };
         UINT numElements = ARRAYSIZE(layout);
 
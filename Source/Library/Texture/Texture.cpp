@@ -1,7 +1,9 @@
 #include "Texture.h"
 
+#if defined(_WIN32)
 #include "Texture/WICTextureLoader.h"
 #include "Texture/DDSTextureLoader.h"
+#endif
 
 namespace library
 {
@@ -46,6 +48,7 @@ namespace library
         //it will load the image file to the texture resource view
         HRESULT hr = S_OK;
 
+#if defined(_WIN32)
         hr = CreateWICTextureFromFile(pDevice, pImmediateContext, m_filePath.c_str(), nullptr, m_textureRV.GetAddressOf());
         if (FAILED(hr))
         {
@@ -58,6 +61,44 @@ namespace library
                 return hr;
             }
         }
+#else
+        UNREFERENCED_PARAMETER(pImmediateContext);
+
+        // WIC and DDS decoding are Windows only; headless builds bind a
+        // 1x1 white texel so every material keeps a valid view
+        const UINT uWhite = 0xffffffffu;
+        D3D11_TEXTURE2D_DESC textureDesc =
+        {
+            .Width = 1u,
+            .Height = 1u,
+            .MipLevels = 1u,
+            .ArraySize = 1u,
+            .Format = DXGI_FORMAT_R8G8B8A8_UNORM,
+            .SampleDesc = {.Count = 1u, .Quality = 0u },
+            .Usage = D3D11_USAGE_DEFAULT,
+            .BindFlags = D3D11_BIND_SHADER_RESOURCE,
+            .CPUAccessFlags = 0u,
+            .MiscFlags = 0u
+        };
+        D3D11_SUBRESOURCE_DATA initData =
+        {
+            .pSysMem = &uWhite,
+            .SysMemPitch = sizeof(uWhite),
+            .SysMemSlicePitch = 0u
+        };
+        ComPtr<ID3D11Texture2D> texture;
+        hr = pDevice->CreateTexture2D(&textureDesc, &initData, texture.GetAddressOf());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        hr = pDevice->CreateShaderResourceView(texture.Get(), nullptr, m_textureRV.GetAddressOf());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+#endif
 
         // Create the Trilinear Wrap
         if (!s_samplers[static_cast<size_t>(eTextureSamplerType::TRILINEAR_WRAP)].Get()) //Check whether the sampler type objects are nullptr
@@ -0,0 +1,273 @@
+/*+===================================================================
+  File:      MODELTESTS.CPP
+
+  Summary:   Checks that posing a model from its flattened skeleton
+             gives the same bone transforms as the recursive walk of
+             the node hierarchy it replaces, on a rig with animated
+             and still joints, bones and plain nodes, over frames that
+             wrap the animation.
+
+  Classes:   PoseTestModel
+
+  Functions: main
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#include "Common.h"
+
+#include <random>
+
+#include "assimp/scene.h"
+
+#include "Model/Model.h"
+
+using namespace library;
+
+namespace
+{
+    // Joints of the rig, every NODE_ANIM_STRIDE-th animated and every
+    // BONE_STRIDE-th driving a bone
+    constexpr UINT NUM_JOINTS = 40u;
+    constexpr UINT NODE_ANIM_STRIDE = 2u;
+    constexpr UINT BONE_STRIDE = 3u;
+
+    // Keys of each channel, spread over the animation
+    constexpr UINT NUM_KEYS = 3u;
+    constexpr double DURATION_TICKS = 10.0;
+    constexpr double TICKS_PER_SECOND = 25.0;
+
+    // Frames compared, long enough to wrap the animation several times
+    constexpr UINT NUM_FRAMES = 200u;
+    constexpr FLOAT FRAME_SECONDS = 0.013f;
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    PoseTestModel
+
+      Summary:  Model built from a scene in memory instead of a file,
+                which also poses itself the way the recursive walk did
+                to compare against
+
+      Methods:  PoseTestModel
+                  Constructor
+                Load
+                  Sets the scene and bones and flattens the skeleton
+                GetAnimationTimeTicks
+                  Returns the animation time the last update posed
+                PoseRecursively
+                  Calculates the bone transforms by walking the nodes
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class PoseTestModel final : public Model
+    {
+    public:
+        PoseTestModel()
+            : Model(L"PoseTestModel")
+        {
+        }
+
+        /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+          Method:   PoseTestModel::Load
+
+          Summary:  Sets the scene and the offset of each named bone,
+                    then flattens the skeleton as loading a file does
+
+          Args:     const aiScene* pScene
+                      Scene with a node hierarchy and one animation
+                    const std::vector<std::pair<std::string, XMMATRIX>>& aBones
+                      Name and offset matrix of each bone
+
+          Modifies: [m_pScene, m_boneNameToIndexMap, m_aBoneInfo,
+                     m_aJoints, m_aGlobalTransforms].
+        M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+        void Load(_In_ const aiScene* pScene, _In_ const std::vector<std::pair<std::string, XMMATRIX>>& aBones)
+        {
+            m_pScene = pScene;
+            for (const auto& [name, offset] : aBones)
+            {
+                m_boneNameToIndexMap[name] = static_cast<UINT>(m_aBoneInfo.size());
+                m_aBoneInfo.push_back(BoneInfo(offset));
+            }
+            buildSkeleton(pScene);
+        }
+
+        /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+          Method:   PoseTestModel::GetAnimationTimeTicks
+
+          Summary:  Returns the animation time Update posed at, worked
+                    out the same way Update does
+
+          Returns:  FLOAT
+        M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+        FLOAT GetAnimationTimeTicks() const
+        {
+            const aiAnimation* pAnimation = m_pScene->mAnimations[0];
+            FLOAT ticksPerSecond = static_cast<FLOAT>(pAnimation->mTicksPerSecond != 0.0 ? pAnimation->mTicksPerSecond : 25.0f);
+            return fmod(m_timeSinceLoaded * ticksPerSecond, static_cast<FLOAT>(pAnimation->mDuration));
+        }
+
+        /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+          Method:   PoseTestModel::PoseRecursively
+
+          Summary:  Calculates the bone transforms of a node and its
+                    children, looking up the channel and the bone of
+                    every node by name as the walk before the flattened
+                    skeleton did
+
+          Args:     FLOAT animationTimeTicks
+                      Animation time
+                    const aiNode* pNode
+                      Node to pose
+                    const XMMATRIX& parentTransform
+                      Global transform of the parent of the node
+                    std::vector<XMMATRIX>& aOutTransforms
+                      Final transform of each bone
+
+          Modifies: [aOutTransforms].
+        M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+        void PoseRecursively(_In_ FLOAT animationTimeTicks, _In_ const aiNode* pNode, _In_ const XMMATRIX& parentTransform, _Inout_ std::vector<XMMATRIX>& aOutTransforms)
+        {
+            // aiMatrix4x4 is row major with the translation in the last
+            // column, XMMATRIX keeps it in the last row
+            XMMATRIX NodeTransform = XMMatrixTranspose(XMLoadFloat4x4(reinterpret_cast<const XMFLOAT4X4*>(&pNode->mTransformation)));
+            const aiNodeAnim* pNodeAnim = findNodeAnimOrNull(m_pScene->mAnimations[0], pNode->mName.C_Str());
+            if (pNodeAnim)
+            {
+                XMFLOAT3 scaling = XMFLOAT3();
+                interpolateScaling(scaling, animationTimeTicks, pNodeAnim);
+                XMVECTOR rotation = XMVECTOR();
+                interpolateRotation(rotation, animationTimeTicks, pNodeAnim);
+                XMFLOAT3 translation = XMFLOAT3();
+                interpolatePosition(translation, animationTimeTicks, pNodeAnim);
+
+                NodeTransform = XMMatrixScaling(scaling.x, scaling.y, scaling.z) * XMMatrixRotationQuaternion(rotation) * XMMatrixTranslation(translation.x, translation.y, translation.z);
+            }
+
+            XMMATRIX globalTransformation = NodeTransform * parentTransform;
+
+            const auto it = m_boneNameToIndexMap.find(pNode->mName.C_Str());
+            if (it != m_boneNameToIndexMap.end())
+            {
+                aOutTransforms[it->second] = m_aBoneInfo[it->second].OffsetMatrix * globalTransformation * m_globalInverseTransform;
+            }
+
+            for (UINT i = 0u; i < pNode->mNumChildren; ++i)
+            {
+                PoseRecursively(animationTimeTicks, pNode->mChildren[i], globalTransformation, aOutTransforms);
+            }
+        }
+    };
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: getJointName
+
+      Summary:  Returns the name of the node and channel of a joint
+
+      Args:     UINT uJoint
+                  Index of the joint
+
+      Returns:  std::string
+    -----------------------------------------------------------------F-F*/
+    std::string getJointName(_In_ UINT uJoint)
+    {
+        return "Joint" + std::to_string(uJoint);
+    }
+}
+
+int main()
+{
+    std::mt19937 generator(0x5EEDu);
+    std::uniform_real_distribution<FLOAT> offset(-1.0f, 1.0f);
+
+    // Each joint hangs off a random earlier one, so the rig has chains
+    // as well as nodes with many children
+    std::unique_ptr<aiScene> pScene = std::make_unique<aiScene>();
+    std::vector<aiNode*> apNodes;
+    for (UINT i = 0u; i < NUM_JOINTS; ++i)
+    {
+        aiNode* pNode = new aiNode(getJointName(i));
+        pNode->mTransformation.a4 = offset(generator);
+        pNode->mTransformation.b4 = offset(generator);
+        pNode->mTransformation.c4 = offset(generator);
+        if (i == 0u)
+        {
+            pScene->mRootNode = pNode;
+        }
+        else
+        {
+            apNodes[generator() % i]->addChildren(1u, &pNode);
+        }
+        apNodes.push_back(pNode);
+    }
+
+    // Channels in shuffled order, so finding them by name matters
+    std::vector<aiNodeAnim*> apChannels;
+    for (UINT i = 0u; i < NUM_JOINTS; i += NODE_ANIM_STRIDE)
+    {
+        aiNodeAnim* pChannel = new aiNodeAnim();
+        pChannel->mNodeName.Set(getJointName(i));
+        pChannel->mNumPositionKeys = NUM_KEYS;
+        pChannel->mPositionKeys = new aiVectorKey[NUM_KEYS];
+        pChannel->mNumRotationKeys = NUM_KEYS;
+        pChannel->mRotationKeys = new aiQuatKey[NUM_KEYS];
+        pChannel->mNumScalingKeys = NUM_KEYS;
+        pChannel->mScalingKeys = new aiVectorKey[NUM_KEYS];
+        for (UINT k = 0u; k < NUM_KEYS; ++k)
+        {
+            const double time = DURATION_TICKS * k / (NUM_KEYS - 1u);
+            pChannel->mPositionKeys[k] = aiVectorKey(time, aiVector3D(offset(generator), offset(generator), offset(generator)));
+            pChannel->mRotationKeys[k] = aiQuatKey(time, aiQuaternion(aiVector3D(offset(generator), offset(generator), 1.0f).Normalize(), offset(generator)));
+            pChannel->mScalingKeys[k] = aiVectorKey(time, aiVector3D(1.0f + 0.25f * offset(generator), 1.0f, 1.0f));
+        }
+        apChannels.push_back(pChannel);
+    }
+    std::shuffle(apChannels.begin(), apChannels.end(), generator);
+
+    aiAnimation* pAnimation = new aiAnimation();
+    pAnimation->mDuration = DURATION_TICKS;
+    pAnimation->mTicksPerSecond = TICKS_PER_SECOND;
+    pAnimation->mNumChannels = static_cast<UINT>(apChannels.size());
+    pAnimation->mChannels = new aiNodeAnim*[apChannels.size()];
+    std::copy(apChannels.begin(), apChannels.end(), pAnimation->mChannels);
+    pScene->mNumAnimations = 1u;
+    pScene->mAnimations = new aiAnimation*[1]{ pAnimation };
+
+    std::vector<std::pair<std::string, XMMATRIX>> aBones;
+    for (UINT i = 1u; i < NUM_JOINTS; i += BONE_STRIDE)
+    {
+        aBones.emplace_back(getJointName(i), XMMatrixTranslation(offset(generator), offset(generator), offset(generator)));
+    }
+
+    PoseTestModel model;
+    model.Load(pScene.get(), aBones);
+
+    std::vector<XMMATRIX> aExpected(aBones.size());
+    UINT uNumMismatches = 0u;
+    for (UINT uFrame = 0u; uFrame < NUM_FRAMES; ++uFrame)
+    {
+        model.Update(FRAME_SECONDS);
+        model.PoseRecursively(model.GetAnimationTimeTicks(), pScene->mRootNode, XMMatrixIdentity(), aExpected);
+
+        const std::vector<XMMATRIX>& aActual = model.GetBoneTransforms();
+        for (size_t uBone = 0u; uBone < aExpected.size(); ++uBone)
+        {
+            XMFLOAT4X4 expected;
+            XMFLOAT4X4 actual;
+            XMStoreFloat4x4(&expected, aExpected[uBone]);
+            XMStoreFloat4x4(&actual, aActual[uBone]);
+            if (!std::equal(&expected.m[0][0], &expected.m[0][0] + 16, &actual.m[0][0]))
+            {
+                if (uNumMismatches++ == 0u)
+                {
+                    WCHAR szMessage[256];
+                    swprintf_s(szMessage, L"pose  frame %u  bone %zu  differs from the recursive walk\n", uFrame, uBone);
+                    OutputDebugString(szMessage);
+                }
+            }
+        }
+    }
+
+    WCHAR szMessage[256];
+    swprintf_s(szMessage, L"pose  joints %u  bones %zu  frames %u  mismatches %u\n", NUM_JOINTS, aBones.size(), NUM_FRAMES, uNumMismatches);
+    OutputDebugString(szMessage);
+
+    return uNumMismatches == 0u ? 0 : 1;
+}
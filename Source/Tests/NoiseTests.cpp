@@ -0,0 +1,155 @@
+/*+===================================================================
+  File:      NOISETESTS.CPP
+
+  Summary:   Checks that the batched noise samplers give the same bits
+             as the scalar ones for every lane width the processor
+             runs, at batch sizes that leave every length of tail.
+
+  Functions: main
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#include "Common.h"
+
+#include <bit>
+#include <random>
+
+#include "Scene/Noise.h"
+
+using namespace library;
+
+namespace
+{
+    // Points of the largest batch, not a multiple of the widest lanes
+    // so it ends in a tail
+    constexpr UINT NUM_POINTS = 1027u;
+
+    // Frequencies and octaves the generators sample with
+    constexpr FLOAT FREQUENCIES[] = { 0.01f, 0.0625f, 1.0f, 3.7f };
+    constexpr UINT MAX_DEPTH = 8u;
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: countMismatches
+
+      Summary:  Counts the results of a batch whose bits differ from
+                the scalar results, and reports the first one
+
+      Args:     PCWSTR pszName
+                  Name of the sampler
+                eNoiseLanes lanes
+                  Lanes the batch ran with
+                const std::vector<FLOAT>& aExpected
+                const std::vector<FLOAT>& aActual
+                  Scalar and batch results
+                UINT uCount
+                  Number of results to compare
+
+      Returns:  UINT
+                  Number of differing results
+    -----------------------------------------------------------------F-F*/
+    UINT countMismatches(_In_ PCWSTR pszName, _In_ eNoiseLanes lanes, _In_ const std::vector<FLOAT>& aExpected, _In_ const std::vector<FLOAT>& aActual, _In_ UINT uCount)
+    {
+        UINT uNumMismatches = 0u;
+        for (UINT i = 0u; i < uCount; ++i)
+        {
+            if (std::bit_cast<UINT>(aExpected[i]) == std::bit_cast<UINT>(aActual[i]))
+            {
+                continue;
+            }
+
+            if (uNumMismatches++ == 0u)
+            {
+                WCHAR szMessage[256];
+                swprintf_s(
+                    szMessage,
+                    L"%ls  lanes %u  count %u  point %u  scalar %.9g  batch %.9g\n",
+                    pszName,
+                    static_cast<UINT>(lanes),
+                    uCount,
+                    i,
+                    aExpected[i],
+                    aActual[i]
+                );
+                OutputDebugString(szMessage);
+            }
+        }
+        return uNumMismatches;
+    }
+}
+
+int main()
+{
+    std::mt19937 generator(0x5EEDu);
+    // The batches match the scalar samplers where coordinates times
+    // frequency times 2 ^ (uDepth - 1) are non-negative and below 2 ^ 31,
+    // which covers every point the generators sample
+    std::uniform_real_distribution<FLOAT> coordinate(0.0f, 4096.0f);
+
+    std::vector<FLOAT> aX(NUM_POINTS);
+    std::vector<FLOAT> aY(NUM_POINTS);
+    std::vector<FLOAT> aZ(NUM_POINTS);
+    for (UINT i = 0u; i < NUM_POINTS; ++i)
+    {
+        aX[i] = coordinate(generator);
+        aY[i] = coordinate(generator);
+        aZ[i] = coordinate(generator);
+    }
+
+    std::vector<eNoiseLanes> aLanes = { eNoiseLanes::SCALAR };
+    if (GetMaxNoiseLanes() != eNoiseLanes::SCALAR)
+    {
+        aLanes.push_back(eNoiseLanes::SSE2);
+    }
+    if (GetMaxNoiseLanes() == eNoiseLanes::AVX2)
+    {
+        aLanes.push_back(eNoiseLanes::AVX2);
+    }
+
+    std::vector<FLOAT> aExpected(NUM_POINTS);
+    std::vector<FLOAT> aActual(NUM_POINTS);
+    UINT uNumMismatches = 0u;
+    UINT uNumChecks = 0u;
+    for (FLOAT frequency : FREQUENCIES)
+    {
+        for (UINT uDepth = 1u; uDepth <= MAX_DEPTH; ++uDepth)
+        {
+            for (UINT i = 0u; i < NUM_POINTS; ++i)
+            {
+                aExpected[i] = SamplePerlin2d(aX[i], aY[i], frequency, uDepth);
+            }
+            for (eNoiseLanes lanes : aLanes)
+            {
+                for (UINT uCount = 1u; uCount <= 17u; ++uCount)
+                {
+                    SamplePerlin2dBatch(aX.data(), aY.data(), uCount, frequency, uDepth, aActual.data(), lanes);
+                    uNumMismatches += countMismatches(L"SamplePerlin2dBatch", lanes, aExpected, aActual, uCount);
+                }
+                SamplePerlin2dBatch(aX.data(), aY.data(), NUM_POINTS, frequency, uDepth, aActual.data(), lanes);
+                uNumMismatches += countMismatches(L"SamplePerlin2dBatch", lanes, aExpected, aActual, NUM_POINTS);
+                ++uNumChecks;
+            }
+
+            for (UINT i = 0u; i < NUM_POINTS; ++i)
+            {
+                aExpected[i] = SamplePerlin3d(aX[i], aY[i], aZ[i], frequency, uDepth);
+            }
+            for (eNoiseLanes lanes : aLanes)
+            {
+                for (UINT uCount = 1u; uCount <= 17u; ++uCount)
+                {
+                    SamplePerlin3dBatch(aX.data(), aY.data(), aZ.data(), uCount, frequency, uDepth, aActual.data(), lanes);
+                    uNumMismatches += countMismatches(L"SamplePerlin3dBatch", lanes, aExpected, aActual, uCount);
+                }
+                SamplePerlin3dBatch(aX.data(), aY.data(), aZ.data(), NUM_POINTS, frequency, uDepth, aActual.data(), lanes);
+                uNumMismatches += countMismatches(L"SamplePerlin3dBatch", lanes, aExpected, aActual, NUM_POINTS);
+                ++uNumChecks;
+            }
+        }
+    }
+
+    WCHAR szMessage[256];
+    swprintf_s(szMessage, L"noise  widest lanes %u  batches %u  mismatches %u\n", static_cast<UINT>(GetMaxNoiseLanes()), uNumChecks, uNumMismatches);
+    OutputDebugString(szMessage);
+
+    return uNumMismatches == 0u ? 0 : 1;
+}
@@ -0,0 +1,200 @@
+/*+===================================================================
+  File:      VOXELREGIONFILETESTS.CPP
+
+  Summary:   Checks that a voxel world saved as region files loads
+             back block for block, serially and on a pool, and that
+             damaged region files fail to load instead of building a
+             broken store.
+
+  Functions: main
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#include "Common.h"
+
+#include <fstream>
+
+#include "Platform/ThreadPool.h"
+#include "Scene/DensityTerrainGenerator.h"
+#include "Scene/VoxelRegionFile.h"
+
+using namespace library;
+
+namespace
+{
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: countDifferentColumns
+
+      Summary:  Counts the columns whose runs differ between two stores
+                of the same size
+
+      Args:     const VoxelColumnStore& expected
+                const VoxelColumnStore& actual
+                  Stores to compare
+
+      Returns:  UINT
+                  Number of differing columns
+    -----------------------------------------------------------------F-F*/
+    UINT countDifferentColumns(_In_ const VoxelColumnStore& expected, _In_ const VoxelColumnStore& actual)
+    {
+        UINT uNumDifferent = 0u;
+        for (UINT uZ = 0u; uZ < expected.GetDepth(); ++uZ)
+        {
+            for (UINT uX = 0u; uX < expected.GetWidth(); ++uX)
+            {
+                const VoxelRun* pExpected = nullptr;
+                const VoxelRun* pActual = nullptr;
+                const UINT uNumExpected = expected.GetColumn(static_cast<INT>(uX), static_cast<INT>(uZ), &pExpected);
+                const UINT uNumActual = actual.GetColumn(static_cast<INT>(uX), static_cast<INT>(uZ), &pActual);
+
+                BOOL bSame = uNumExpected == uNumActual;
+                for (UINT i = 0u; bSame && i < uNumExpected; ++i)
+                {
+                    bSame = pExpected[i].uEnd == pActual[i].uEnd && pExpected[i].Block == pActual[i].Block;
+                }
+                uNumDifferent += bSame ? 0u : 1u;
+            }
+        }
+        return uNumDifferent;
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: patchFile
+
+      Summary:  Overwrites bytes of a file in place
+
+      Args:     const std::filesystem::path& filePath
+                  File to change
+                UINT uOffset
+                  First byte to overwrite
+                const void* pData
+                UINT uSize
+                  Bytes to write
+    -----------------------------------------------------------------F-F*/
+    void patchFile(_In_ const std::filesystem::path& filePath, _In_ UINT uOffset, _In_reads_bytes_(uSize) const void* pData, _In_ UINT uSize)
+    {
+        std::fstream file(filePath, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(uOffset);
+        file.write(static_cast<const CHAR*>(pData), uSize);
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: report
+
+      Summary:  Writes the outcome of a check to the debug output
+
+      Args:     PCWSTR pszCheck
+                  Name of the check
+                BOOL bPassed
+                  Whether it passed
+
+      Returns:  BOOL
+                  bPassed
+    -----------------------------------------------------------------F-F*/
+    BOOL report(_In_ PCWSTR pszCheck, _In_ BOOL bPassed)
+    {
+        WCHAR szMessage[256];
+        swprintf_s(szMessage, L"voxel regions  %-28ls %ls\n", pszCheck, bPassed ? L"ok" : L"FAILED");
+        OutputDebugString(szMessage);
+        return bPassed;
+    }
+}
+
+int main()
+{
+    // Not a multiple of a region on either axis, so the last regions
+    // are partly outside the world
+    VoxelColumnStore store(600u, 64u, 500u, XMFLOAT3(-1.0f, -2.0f, -3.0f));
+    {
+        DensityTerrainGenerator generator;
+        generator.Generate(store);
+    }
+    store.SetBlock(5u, 63u, 5u, static_cast<BYTE>(eBlockType::SNOW));
+    store.SetBlock(599u, 0u, 499u, EMPTY_BLOCK);
+
+    const std::filesystem::path directoryPath = std::filesystem::temp_directory_path() / L"VoxelRegionFileTests";
+    std::filesystem::remove_all(directoryPath);
+
+    ThreadPool threadPool;
+    BOOL bPassed = report(L"write", SUCCEEDED(WriteVoxelRegions(directoryPath, store, &threadPool)));
+
+    for (ThreadPool* pThreadPool : { static_cast<ThreadPool*>(nullptr), &threadPool })
+    {
+        std::unique_ptr<VoxelColumnStore> loadedStore;
+        const BOOL bRead = SUCCEEDED(ReadVoxelRegions(directoryPath, pThreadPool, loadedStore));
+        const BOOL bSame = bRead
+            && loadedStore->GetWidth() == store.GetWidth()
+            && loadedStore->GetHeight() == store.GetHeight()
+            && loadedStore->GetDepth() == store.GetDepth()
+            && memcmp(&loadedStore->GetOrigin(), &store.GetOrigin(), sizeof(XMFLOAT3)) == 0
+            && loadedStore->GetCellSize() == store.GetCellSize()
+            && countDifferentColumns(store, *loadedStore) == 0u;
+        bPassed &= report(pThreadPool ? L"round trip on a pool" : L"round trip serially", bSame);
+    }
+
+    // Each damaged copy must fail to load
+    const std::filesystem::path regionPath = directoryPath / GetVoxelRegionFileName(1, 0);
+    auto expectFailure = [&](PCWSTR pszCheck, auto damage)
+    {
+        std::filesystem::remove_all(directoryPath);
+        WriteVoxelRegions(directoryPath, store, nullptr);
+        damage();
+
+        std::unique_ptr<VoxelColumnStore> loadedStore;
+        return report(pszCheck, ReadVoxelRegions(directoryPath, nullptr, loadedStore) == E_FAIL && !loadedStore);
+    };
+
+    bPassed &= expectFailure(L"truncated file", [&]()
+        {
+            std::filesystem::resize_file(regionPath, std::filesystem::file_size(regionPath) - 10u);
+        }
+    );
+    bPassed &= expectFailure(L"missing region", [&]()
+        {
+            std::filesystem::remove(regionPath);
+        }
+    );
+    bPassed &= expectFailure(L"huge world", [&]()
+        {
+            const UINT auSize[] = { 0x7FFFFFFFu, 64u, 0x7FFFFFFFu };
+            for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(directoryPath))
+            {
+                patchFile(entry.path(), offsetof(VoxelRegionHeader, uWidth), auSize, sizeof(auSize));
+            }
+        }
+    );
+    bPassed &= expectFailure(L"height above a store", [&]()
+        {
+            const UINT uHeight = VOXEL_COLUMN_MAX_HEIGHT + 1u;
+            patchFile(regionPath, offsetof(VoxelRegionHeader, uHeight), &uHeight, sizeof(uHeight));
+        }
+    );
+    bPassed &= expectFailure(L"zero cell size", [&]()
+        {
+            const FLOAT cellSize = 0.0f;
+            patchFile(regionPath, offsetof(VoxelRegionHeader, CellSize), &cellSize, sizeof(cellSize));
+        }
+    );
+    bPassed &= expectFailure(L"region outside the world", [&]()
+        {
+            const INT nRegionX = 2;
+            patchFile(regionPath, offsetof(VoxelRegionHeader, nRegionX), &nRegionX, sizeof(nRegionX));
+        }
+    );
+    bPassed &= expectFailure(L"block outside the palette", [&]()
+        {
+            VoxelRegionChunkEntry entry = {};
+            {
+                std::ifstream file(regionPath, std::ios::binary);
+                file.seekg(sizeof(VoxelRegionHeader));
+                file.read(reinterpret_cast<CHAR*>(&entry), sizeof(entry));
+            }
+            const BYTE block = static_cast<BYTE>(eBlockType::COUNT);
+            patchFile(regionPath, entry.uOffset + 1u, &block, sizeof(block));
+        }
+    );
+
+    std::filesystem::remove_all(directoryPath);
+
+    return bPassed ? 0 : 1;
+}